@@ -23,6 +23,7 @@
 #include <random>
 #include <vector>
 
+#include <absl/strings/str_cat.h>
 #include <sole.hpp>
 
 #include "src/carnot/carnot.h"
@@ -42,6 +43,7 @@ namespace carnot {
 namespace exec {
 
 using table_store::Table;
+using table_store::schema::RowBatch;
 using table_store::schema::RowDescriptor;
 
 constexpr char kGroupByNoneQuery[] = R"pxl(
@@ -65,6 +67,65 @@ df = df.groupby(['col0', 'col1']).agg(sum=('col2', px.sum))
 px.display(df, '$0')
 )pxl";
 
+constexpr char kGroupByOneAllBuiltinsQuery[] = R"pxl(
+import px
+df = px.DataFrame(table='test_table', select=['col0', 'col1'])
+df = df.groupby('col0').agg(
+  sum=('col1', px.sum),
+  count=('col1', px.count),
+  mean=('col1', px.mean),
+  min=('col1', px.min),
+  max=('col1', px.max),
+)
+px.display(df, '$0')
+)pxl";
+
+// The number of rows and the batch size of the tables used by the group cardinality benchmarks.
+constexpr int64_t kCardinalityBenchNumRows = 4 * 1024 * 1024;
+constexpr int64_t kCardinalityBenchBatchSize = 64 * 1024;
+
+// Creates a table with a group column (col0) that has exactly num_groups distinct values (each
+// group appears at least once) and a uniformly distributed int64 value column (col1).
+std::shared_ptr<Table> CreateGroupCardinalityTable(int64_t num_groups, bool string_groups) {
+  types::DataType group_type = string_groups ? types::DataType::STRING : types::DataType::INT64;
+  std::vector<types::DataType> col_types = {group_type, types::DataType::INT64};
+  RowDescriptor rd(col_types);
+  auto table = std::make_shared<Table>(
+      "test_table", table_store::schema::Relation(col_types, {"col0", "col1"}),
+      /* max_table_size */ 8LL * 1024 * 1024 * 1024);
+
+  std::mt19937 rng(37);
+  std::uniform_int_distribution<int64_t> group_dist(0, num_groups - 1);
+  std::uniform_int_distribution<int64_t> value_dist(0, 1000 * 1000);
+
+  for (int64_t offset = 0; offset < kCardinalityBenchNumRows;
+       offset += kCardinalityBenchBatchSize) {
+    std::vector<int64_t> group_ids(kCardinalityBenchBatchSize);
+    std::vector<types::Int64Value> values(kCardinalityBenchBatchSize);
+    for (int64_t i = 0; i < kCardinalityBenchBatchSize; ++i) {
+      int64_t row = offset + i;
+      group_ids[i] = row < num_groups ? row : group_dist(rng);
+      values[i] = value_dist(rng);
+    }
+
+    RowBatch rb(rd, kCardinalityBenchBatchSize);
+    if (string_groups) {
+      std::vector<types::StringValue> groups;
+      groups.reserve(group_ids.size());
+      for (auto id : group_ids) {
+        groups.emplace_back(absl::StrCat("px-sock-shop/carts-7d8b6c5d9f-", id));
+      }
+      PX_CHECK_OK(rb.AddColumn(types::ToArrow(groups, arrow::default_memory_pool())));
+    } else {
+      std::vector<types::Int64Value> groups(group_ids.begin(), group_ids.end());
+      PX_CHECK_OK(rb.AddColumn(types::ToArrow(groups, arrow::default_memory_pool())));
+    }
+    PX_CHECK_OK(rb.AddColumn(types::ToArrow(values, arrow::default_memory_pool())));
+    PX_CHECK_OK(table->WriteRowBatch(rb));
+  }
+  return table;
+}
+
 std::unique_ptr<Carnot> SetUpCarnot(std::shared_ptr<table_store::TableStore> table_store,
                                     LocalGRPCResultSinkServer* server) {
   auto func_registry = std::make_unique<px::carnot::udf::Registry>("default_registry");
@@ -130,6 +191,32 @@ void BM_Query_Int(benchmark::State& state, std::vector<types::DataType> types,
   BM_Query(state, types, distribution_types, query, num_batches, default_params, default_params);
 }
 
+// Measures rows/sec of a blocking group by as the number of groups grows. state.range(0) is the
+// number of groups.
+// NOLINTNEXTLINE : runtime/references.
+void BM_GroupByCardinality(benchmark::State& state, const std::string& query,
+                           bool string_groups) {
+  auto table_store = std::make_shared<table_store::TableStore>();
+  auto server = LocalGRPCResultSinkServer();
+
+  auto carnot = SetUpCarnot(table_store, &server);
+  table_store->AddTable("test_table", CreateGroupCardinalityTable(state.range(0), string_groups));
+
+  int i = 0;
+  for (auto _ : state) {
+    auto query_with_table_name = absl::Substitute(query, "results_" + std::to_string(i));
+    auto res = carnot->ExecuteQuery(query_with_table_name, sole::uuid4(), CurrentTimeNS());
+    if (!res.ok()) {
+      LOG(FATAL) << "Aggregate benchmark query did not execute successfully.";
+    }
+    server.ResetQueryResults();
+    ++i;
+  }
+
+  state.SetItemsProcessed(state.iterations() * kCardinalityBenchNumRows);
+  state.counters["groups"] = state.range(0);
+}
+
 const std::unique_ptr<const datagen::DistributionParams> sample_selection_params =
     std::make_unique<const datagen::ZipfianParams>(2, 2, 999);
 const std::unique_ptr<const datagen::DistributionParams> sample_length_params =
@@ -198,6 +285,26 @@ BENCHMARK_CAPTURE(BM_Query_Int, eval_group_by_one_exponential_int,
     ->RangeMultiplier(2)
     ->Range(1, 1 << 16);
 
+// Group cardinality tests. Items/sec is the number of input rows aggregated per second.
+BENCHMARK_CAPTURE(BM_GroupByCardinality, int_group_sum, kGroupByOneQuery, false)
+    ->Arg(1000)
+    ->Arg(100 * 1000)
+    ->Arg(1000 * 1000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_GroupByCardinality, int_group_all_builtins, kGroupByOneAllBuiltinsQuery,
+                  false)
+    ->Arg(1000)
+    ->Arg(100 * 1000)
+    ->Arg(1000 * 1000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_GroupByCardinality, string_group_sum, kGroupByOneQuery, true)
+    ->Arg(1000)
+    ->Arg(100 * 1000)
+    ->Arg(1000 * 1000)
+    ->Unit(benchmark::kMillisecond);
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
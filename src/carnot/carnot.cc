@@ -176,6 +176,8 @@ Status CarnotImpl::RegisterUDFsInPlanFragment(exec::ExecState* exec_state, plan:
       .OnMemorySource(no_op)
       .OnUnion(no_op)
       .OnJoin(no_op)
+      .OnRolling(no_op)
+      .OnSort(no_op)
       .OnGRPCSource(no_op)
       .OnGRPCSink(no_op)
       .OnUDTFSource(no_op)
@@ -339,6 +341,8 @@ Status CarnotImpl::ExecutePlan(const planpb::Plan& logical_plan, const sole::uui
   if (metadata_state) {
     exec_state->set_metadata_state(metadata_state);
   }
+  exec_state->set_row_batch_encoding(logical_plan.plan_options().row_batch_encoding(),
+                                     logical_plan.plan_options().compress_row_batches());
 
   PX_RETURN_IF_ERROR(RegisterUDFs(exec_state.get(), &plan));
 
@@ -357,7 +361,9 @@ Status CarnotImpl::ExecutePlan(const planpb::Plan& logical_plan, const sole::uui
           .OnPlanFragment([&](auto* pf) {
             auto exec_graph = exec::ExecutionGraph();
             PX_RETURN_IF_ERROR(exec_graph.Init(schema.get(), plan_state.get(), exec_state.get(), pf,
-                                               /* collect_exec_node_stats */ analyze));
+                                               /* collect_exec_node_stats */ analyze,
+                                               exec::kDefaultConsecutiveGenerateCallsPerSource,
+                                               logical_plan.plan_options().exec_threads()));
             PX_RETURN_IF_ERROR(exec_graph.Execute());
 
             // We must get this while exec_graph is alive. ExecutionGraph destructor calls
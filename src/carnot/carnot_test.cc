@@ -193,6 +193,38 @@ px.display(df, 'test_output'))pxl";
       types::ToArrow(col1_in2, arrow::default_memory_pool())));
 }
 
+TEST_F(CarnotTest, map_after_filter_skips_filtered_rows) {
+  // Most of the rows survive the filter, so its output is passed on with a selection vector.
+  table_store::schema::Relation rel({types::DataType::INT64, types::DataType::INT64}, {"a", "b"});
+  auto table = table_store::Table::Create("divisors", rel);
+  auto rb = table_store::schema::RowBatch(table_store::schema::RowDescriptor(rel.col_types()), 5);
+  std::vector<types::Int64Value> a = {7, 9, 14, 10, 23};
+  std::vector<types::Int64Value> b = {2, 0, 4, 0, 5};
+  ASSERT_OK(rb.AddColumn(types::ToArrow(a, arrow::default_memory_pool())));
+  ASSERT_OK(rb.AddColumn(types::ToArrow(b, arrow::default_memory_pool())));
+  ASSERT_OK(table->WriteRowBatch(rb));
+  table_store_->AddTable("divisors", table);
+
+  // Evaluating % or px.bin on the rows with b == 0 would divide by zero.
+  auto query = R"pxl(
+import px
+df = px.DataFrame(table='divisors', select=['a', 'b'])
+df = df[df.b != 0]
+df.mod = df.a % df.b
+df.binned = px.bin(df.a, df.b)
+px.display(df[['mod', 'binned']], 'div_output'))pxl";
+  ASSERT_OK(carnot_->ExecuteQuery(query, sole::uuid4(), 0));
+
+  auto output_batches = result_server_->query_results("div_output");
+  ASSERT_EQ(2, output_batches.size());
+  std::vector<types::Int64Value> mod = {1, 2, 3};
+  std::vector<types::Int64Value> binned = {6, 12, 20};
+  EXPECT_TRUE(
+      output_batches[1].ColumnAt(0)->Equals(types::ToArrow(mod, arrow::default_memory_pool())));
+  EXPECT_TRUE(
+      output_batches[1].ColumnAt(1)->Equals(types::ToArrow(binned, arrow::default_memory_pool())));
+}
+
 TEST_F(CarnotTest, range_test_multiple_rbs) {
   auto query = R"pxl(
 import px
@@ -0,0 +1,863 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <google/protobuf/text_format.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "src/carnot/carnot.h"
+#include "src/carnot/exec/local_grpc_result_server.h"
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/funcs/funcs.h"
+#include "src/common/testing/testing.h"
+#include "src/table_store/table_store.h"
+
+namespace px {
+namespace carnot {
+
+using exec::CarnotTestUtils;
+
+// Reads "table" and hash partitions it on col2 across kelvin0 and kelvin1. $0 is the id of the
+// GRPC source on each Kelvin that reads from this PEM.
+constexpr char kPEMPlanTmpl[] = R"proto(
+dag {
+  nodes {
+    id: 1
+  }
+}
+nodes {
+  id: 1
+  dag {
+    nodes {
+      id: 1
+      sorted_children: 2
+    }
+    nodes {
+      id: 2
+      sorted_parents: 1
+    }
+  }
+  nodes {
+    id: 1
+    op {
+      op_type: MEMORY_SOURCE_OPERATOR
+      mem_source_op {
+        name: "table"
+        column_idxs: 0
+        column_types: FLOAT64
+        column_names: "col1"
+        column_idxs: 1
+        column_types: INT64
+        column_names: "col2"
+      }
+    }
+  }
+  nodes {
+    id: 2
+    op {
+      op_type: GRPC_SINK_OPERATOR
+      grpc_sink_op {
+        partitioned {
+          key_column_indexes: 1
+          partitions {
+            address: "kelvin0"
+            grpc_source_id: $0
+            connection_options {
+              ssl_targetname: "kelvin0"
+            }
+          }
+          partitions {
+            address: "kelvin1"
+            grpc_source_id: $0
+            connection_options {
+              ssl_targetname: "kelvin1"
+            }
+          }
+        }
+      }
+    }
+  }
+}
+)proto";
+
+// Unions the partitions from both PEMs and sums col1 by col2. $0 is the dag entry for the agg, $1
+// holds the operators after the agg, and $2 holds any extra execution status destinations.
+constexpr char kKelvinPlanTmpl[] = R"proto(
+$2
+dag {
+  nodes {
+    id: 1
+  }
+}
+nodes {
+  id: 1
+  dag {
+    nodes {
+      id: 1
+      sorted_children: 3
+    }
+    nodes {
+      id: 2
+      sorted_children: 3
+    }
+    nodes {
+      id: 3
+      sorted_children: 4
+      sorted_parents: 1
+      sorted_parents: 2
+    }
+    $0
+  }
+  nodes {
+    id: 1
+    op {
+      op_type: GRPC_SOURCE_OPERATOR
+      grpc_source_op {
+        column_types: FLOAT64
+        column_types: INT64
+        column_names: "col1"
+        column_names: "col2"
+      }
+    }
+  }
+  nodes {
+    id: 2
+    op {
+      op_type: GRPC_SOURCE_OPERATOR
+      grpc_source_op {
+        column_types: FLOAT64
+        column_types: INT64
+        column_names: "col1"
+        column_names: "col2"
+      }
+    }
+  }
+  nodes {
+    id: 3
+    op {
+      op_type: UNION_OPERATOR
+      union_op {
+        column_names: "col1"
+        column_names: "col2"
+        column_mappings {
+          column_indexes: 0
+          column_indexes: 1
+        }
+        column_mappings {
+          column_indexes: 0
+          column_indexes: 1
+        }
+      }
+    }
+  }
+  nodes {
+    id: 4
+    op {
+      op_type: AGGREGATE_OPERATOR
+      agg_op {
+        windowed: false
+        values {
+          name: "sum"
+          args {
+            column {
+              node: 3
+              index: 0
+            }
+          }
+          args_data_types: FLOAT64
+        }
+        groups {
+          node: 3
+          index: 1
+        }
+        group_names: "col2"
+        value_names: "sum"
+      }
+    }
+  }
+  $1
+}
+)proto";
+
+// Kelvin1 sends its partition of the aggregate to kelvin0.
+constexpr char kShuffleKelvinDAG[] = R"proto(
+    nodes {
+      id: 4
+      sorted_children: 5
+      sorted_parents: 3
+    }
+    nodes {
+      id: 5
+      sorted_parents: 4
+    }
+)proto";
+
+constexpr char kShuffleKelvinOps[] = R"proto(
+  nodes {
+    id: 5
+    op {
+      op_type: GRPC_SINK_OPERATOR
+      grpc_sink_op {
+        address: "kelvin0"
+        grpc_source_id: 5
+        connection_options {
+          ssl_targetname: "kelvin0"
+        }
+      }
+    }
+  }
+)proto";
+
+// Kelvin0 unions its partition of the aggregate with kelvin1's and sends the result out.
+constexpr char kGatherKelvinDAG[] = R"proto(
+    nodes {
+      id: 4
+      sorted_children: 6
+      sorted_parents: 3
+    }
+    nodes {
+      id: 5
+      sorted_children: 6
+    }
+    nodes {
+      id: 6
+      sorted_children: 7
+      sorted_parents: 4
+      sorted_parents: 5
+    }
+    nodes {
+      id: 7
+      sorted_parents: 6
+    }
+)proto";
+
+constexpr char kGatherKelvinOps[] = R"proto(
+  nodes {
+    id: 5
+    op {
+      op_type: GRPC_SOURCE_OPERATOR
+      grpc_source_op {
+        column_types: INT64
+        column_types: FLOAT64
+        column_names: "col2"
+        column_names: "sum"
+      }
+    }
+  }
+  nodes {
+    id: 6
+    op {
+      op_type: UNION_OPERATOR
+      union_op {
+        column_names: "col2"
+        column_names: "sum"
+        column_mappings {
+          column_indexes: 0
+          column_indexes: 1
+        }
+        column_mappings {
+          column_indexes: 0
+          column_indexes: 1
+        }
+      }
+    }
+  }
+  nodes {
+    id: 7
+    op {
+      op_type: GRPC_SINK_OPERATOR
+      grpc_sink_op {
+        address: "result_addr"
+        output_table {
+          table_name: "out"
+          column_names: "col2"
+          column_names: "sum"
+          column_types: INT64
+          column_types: FLOAT64
+        }
+        connection_options {
+          ssl_targetname: "result_ssltarget"
+        }
+      }
+    }
+  }
+)proto";
+
+constexpr char kGatherExecutionStatusDestinations[] = R"proto(
+execution_status_destinations {
+  grpc_address: "result_addr"
+  ssl_targetname: "result_ssltarget"
+}
+)proto";
+
+// Reads "table" and "right_table", and hash partitions each of them on its join key across kelvin0
+// and kelvin1. The key is col2, the second column, of "table" and key, the first column, of
+// "right_table", so the two sinks hash different column indexes. $0 and $1 are the ids of the GRPC
+// sources on each Kelvin that read the left and the right side from this PEM.
+constexpr char kJoinPEMPlanTmpl[] = R"proto(
+dag {
+  nodes {
+    id: 1
+  }
+}
+nodes {
+  id: 1
+  dag {
+    nodes {
+      id: 1
+      sorted_children: 2
+    }
+    nodes {
+      id: 2
+      sorted_parents: 1
+    }
+    nodes {
+      id: 3
+      sorted_children: 4
+    }
+    nodes {
+      id: 4
+      sorted_parents: 3
+    }
+  }
+  nodes {
+    id: 1
+    op {
+      op_type: MEMORY_SOURCE_OPERATOR
+      mem_source_op {
+        name: "table"
+        column_idxs: 0
+        column_types: FLOAT64
+        column_names: "col1"
+        column_idxs: 1
+        column_types: INT64
+        column_names: "col2"
+      }
+    }
+  }
+  nodes {
+    id: 2
+    op {
+      op_type: GRPC_SINK_OPERATOR
+      grpc_sink_op {
+        partitioned {
+          key_column_indexes: 1
+          partitions {
+            address: "kelvin0"
+            grpc_source_id: $0
+            connection_options {
+              ssl_targetname: "kelvin0"
+            }
+          }
+          partitions {
+            address: "kelvin1"
+            grpc_source_id: $0
+            connection_options {
+              ssl_targetname: "kelvin1"
+            }
+          }
+        }
+      }
+    }
+  }
+  nodes {
+    id: 3
+    op {
+      op_type: MEMORY_SOURCE_OPERATOR
+      mem_source_op {
+        name: "right_table"
+        column_idxs: 0
+        column_types: INT64
+        column_names: "key"
+        column_idxs: 1
+        column_types: FLOAT64
+        column_names: "value"
+      }
+    }
+  }
+  nodes {
+    id: 4
+    op {
+      op_type: GRPC_SINK_OPERATOR
+      grpc_sink_op {
+        partitioned {
+          key_column_indexes: 0
+          partitions {
+            address: "kelvin0"
+            grpc_source_id: $1
+            connection_options {
+              ssl_targetname: "kelvin0"
+            }
+          }
+          partitions {
+            address: "kelvin1"
+            grpc_source_id: $1
+            connection_options {
+              ssl_targetname: "kelvin1"
+            }
+          }
+        }
+      }
+    }
+  }
+}
+)proto";
+
+// Unions the left and the right partitions from both PEMs and joins them on col2 == key. $0 is the
+// dag entry for the join, $1 holds the operators after the join, and $2 holds any extra execution
+// status destinations.
+constexpr char kJoinKelvinPlanTmpl[] = R"proto(
+$2
+dag {
+  nodes {
+    id: 1
+  }
+}
+nodes {
+  id: 1
+  dag {
+    nodes {
+      id: 1
+      sorted_children: 5
+    }
+    nodes {
+      id: 2
+      sorted_children: 5
+    }
+    nodes {
+      id: 3
+      sorted_children: 6
+    }
+    nodes {
+      id: 4
+      sorted_children: 6
+    }
+    nodes {
+      id: 5
+      sorted_children: 7
+      sorted_parents: 1
+      sorted_parents: 2
+    }
+    nodes {
+      id: 6
+      sorted_children: 7
+      sorted_parents: 3
+      sorted_parents: 4
+    }
+    $0
+  }
+  nodes {
+    id: 1
+    op {
+      op_type: GRPC_SOURCE_OPERATOR
+      grpc_source_op {
+        column_types: FLOAT64
+        column_types: INT64
+        column_names: "col1"
+        column_names: "col2"
+      }
+    }
+  }
+  nodes {
+    id: 2
+    op {
+      op_type: GRPC_SOURCE_OPERATOR
+      grpc_source_op {
+        column_types: FLOAT64
+        column_types: INT64
+        column_names: "col1"
+        column_names: "col2"
+      }
+    }
+  }
+  nodes {
+    id: 3
+    op {
+      op_type: GRPC_SOURCE_OPERATOR
+      grpc_source_op {
+        column_types: INT64
+        column_types: FLOAT64
+        column_names: "key"
+        column_names: "value"
+      }
+    }
+  }
+  nodes {
+    id: 4
+    op {
+      op_type: GRPC_SOURCE_OPERATOR
+      grpc_source_op {
+        column_types: INT64
+        column_types: FLOAT64
+        column_names: "key"
+        column_names: "value"
+      }
+    }
+  }
+  nodes {
+    id: 5
+    op {
+      op_type: UNION_OPERATOR
+      union_op {
+        column_names: "col1"
+        column_names: "col2"
+        column_mappings {
+          column_indexes: 0
+          column_indexes: 1
+        }
+        column_mappings {
+          column_indexes: 0
+          column_indexes: 1
+        }
+      }
+    }
+  }
+  nodes {
+    id: 6
+    op {
+      op_type: UNION_OPERATOR
+      union_op {
+        column_names: "key"
+        column_names: "value"
+        column_mappings {
+          column_indexes: 0
+          column_indexes: 1
+        }
+        column_mappings {
+          column_indexes: 0
+          column_indexes: 1
+        }
+      }
+    }
+  }
+  nodes {
+    id: 7
+    op {
+      op_type: JOIN_OPERATOR
+      join_op {
+        type: INNER
+        equality_conditions {
+          left_column_index: 1
+          right_column_index: 0
+        }
+        output_columns {
+          parent_index: 0
+          column_index: 1
+        }
+        output_columns {
+          parent_index: 0
+          column_index: 0
+        }
+        output_columns {
+          parent_index: 1
+          column_index: 1
+        }
+        column_names: "col2"
+        column_names: "col1"
+        column_names: "value"
+        rows_per_batch: 10
+      }
+    }
+  }
+  $1
+}
+)proto";
+
+// Kelvin1 sends its partition of the join to kelvin0.
+constexpr char kJoinShuffleKelvinDAG[] = R"proto(
+    nodes {
+      id: 7
+      sorted_children: 8
+      sorted_parents: 5
+      sorted_parents: 6
+    }
+    nodes {
+      id: 8
+      sorted_parents: 7
+    }
+)proto";
+
+constexpr char kJoinShuffleKelvinOps[] = R"proto(
+  nodes {
+    id: 8
+    op {
+      op_type: GRPC_SINK_OPERATOR
+      grpc_sink_op {
+        address: "kelvin0"
+        grpc_source_id: 8
+        connection_options {
+          ssl_targetname: "kelvin0"
+        }
+      }
+    }
+  }
+)proto";
+
+// Kelvin0 unions its partition of the join with kelvin1's and sends the result out.
+constexpr char kJoinGatherKelvinDAG[] = R"proto(
+    nodes {
+      id: 7
+      sorted_children: 9
+      sorted_parents: 5
+      sorted_parents: 6
+    }
+    nodes {
+      id: 8
+      sorted_children: 9
+    }
+    nodes {
+      id: 9
+      sorted_children: 10
+      sorted_parents: 7
+      sorted_parents: 8
+    }
+    nodes {
+      id: 10
+      sorted_parents: 9
+    }
+)proto";
+
+constexpr char kJoinGatherKelvinOps[] = R"proto(
+  nodes {
+    id: 8
+    op {
+      op_type: GRPC_SOURCE_OPERATOR
+      grpc_source_op {
+        column_types: INT64
+        column_types: FLOAT64
+        column_types: FLOAT64
+        column_names: "col2"
+        column_names: "col1"
+        column_names: "value"
+      }
+    }
+  }
+  nodes {
+    id: 9
+    op {
+      op_type: UNION_OPERATOR
+      union_op {
+        column_names: "col2"
+        column_names: "col1"
+        column_names: "value"
+        column_mappings {
+          column_indexes: 0
+          column_indexes: 1
+          column_indexes: 2
+        }
+        column_mappings {
+          column_indexes: 0
+          column_indexes: 1
+          column_indexes: 2
+        }
+      }
+    }
+  }
+  nodes {
+    id: 10
+    op {
+      op_type: GRPC_SINK_OPERATOR
+      grpc_sink_op {
+        address: "result_addr"
+        output_table {
+          table_name: "out"
+          column_names: "col2"
+          column_names: "col1"
+          column_names: "value"
+          column_types: INT64
+          column_types: FLOAT64
+          column_types: FLOAT64
+        }
+        connection_options {
+          ssl_targetname: "result_ssltarget"
+        }
+      }
+    }
+  }
+)proto";
+
+// Runs two PEMs and two Kelvins in process. Every Carnot serves its router on its own in process
+// GRPC server, so the GRPC sinks of one Carnot write to the GRPC sources of another.
+class ShuffleTest : public ::testing::Test {
+ protected:
+  struct Instance {
+    exec::GRPCRouter* router;
+    std::unique_ptr<Carnot> carnot;
+    // Declared after the Carnot so that it is destroyed before the router it serves.
+    std::unique_ptr<grpc::Server> server;
+  };
+
+  void SetUp() override {
+    Test::SetUp();
+    result_server_ = std::make_unique<exec::LocalGRPCResultSinkServer>();
+    for (const std::string& name : {"pem0", "pem1", "kelvin0", "kelvin1"}) {
+      instances_[name] = CreateInstance(name.find("pem") == 0);
+    }
+  }
+
+  void TearDown() override {
+    // The servers reference the routers, which are owned by the Carnots.
+    for (auto& [name, instance] : instances_) {
+      instance.server->Shutdown();
+    }
+  }
+
+  // Keyed on its first column, unlike the test table, which is keyed on its second.
+  static std::shared_ptr<table_store::Table> RightTable() {
+    table_store::schema::Relation rel({types::DataType::INT64, types::DataType::FLOAT64},
+                                      {"key", "value"});
+    auto table = table_store::Table::Create("right_table", rel);
+    auto rb = table_store::schema::RowBatch(table_store::schema::RowDescriptor(rel.col_types()), 4);
+    std::vector<types::Int64Value> keys = {2, 3, 4, 6};
+    std::vector<types::Float64Value> values = {20.0, 30.0, 40.0, 60.0};
+    PX_CHECK_OK(rb.AddColumn(types::ToArrow(keys, arrow::default_memory_pool())));
+    PX_CHECK_OK(rb.AddColumn(types::ToArrow(values, arrow::default_memory_pool())));
+    PX_CHECK_OK(table->WriteRowBatch(rb));
+    return table;
+  }
+
+  Instance CreateInstance(bool has_data) {
+    Instance instance;
+    auto table_store = std::make_shared<table_store::TableStore>();
+    if (has_data) {
+      table_store->AddTable("table", CarnotTestUtils::TestTable());
+      table_store->AddTable("right_table", RightTable());
+    }
+    auto func_registry = std::make_unique<px::carnot::udf::Registry>("default_registry");
+    funcs::RegisterFuncsOrDie(func_registry.get());
+    auto clients_config = std::make_unique<Carnot::ClientsConfig>(Carnot::ClientsConfig{
+        [this](const std::string& address, const std::string&)
+            -> std::unique_ptr<carnotpb::ResultSinkService::StubInterface> {
+          auto it = instances_.find(address);
+          if (it == instances_.end()) {
+            return result_server_->StubGenerator(address);
+          }
+          grpc::ChannelArguments args;
+          return carnotpb::ResultSinkService::NewStub(
+              it->second.server->InProcessChannel(args));
+        },
+        [](grpc::ClientContext*) {},
+    });
+    auto server_config = std::make_unique<Carnot::ServerConfig>();
+    server_config->grpc_server_creds = grpc::InsecureServerCredentials();
+    server_config->grpc_server_port = 0;
+    instance.router = &server_config->grpc_router;
+
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials());
+    builder.RegisterService(instance.router);
+    instance.server = builder.BuildAndStart();
+
+    instance.carnot = Carnot::Create(sole::uuid4(), std::move(func_registry), table_store,
+                                     std::move(clients_config), std::move(server_config))
+                          .ConsumeValueOrDie();
+    return instance;
+  }
+
+  Status ExecutePlan(const std::string& name, const std::string& plan_str,
+                     const sole::uuid& query_id) {
+    planpb::Plan plan;
+    if (!google::protobuf::TextFormat::MergeFromString(plan_str, &plan)) {
+      return error::InvalidArgument("Failed to parse plan for $0", name);
+    }
+    return instances_[name].carnot->ExecutePlan(plan, query_id);
+  }
+
+  std::unique_ptr<exec::LocalGRPCResultSinkServer> result_server_;
+  absl::flat_hash_map<std::string, Instance> instances_;
+};
+
+TEST_F(ShuffleTest, partitioned_agg) {
+  sole::uuid query_id = sole::uuid4();
+  // The GRPC routers hold on to the data of queries that haven't started yet, so the Carnots can
+  // run one after another in the order of the plan.
+  ASSERT_OK(ExecutePlan("pem0", absl::Substitute(kPEMPlanTmpl, 1), query_id));
+  ASSERT_OK(ExecutePlan("pem1", absl::Substitute(kPEMPlanTmpl, 2), query_id));
+  ASSERT_OK(ExecutePlan(
+      "kelvin1", absl::Substitute(kKelvinPlanTmpl, kShuffleKelvinDAG, kShuffleKelvinOps, ""),
+      query_id));
+  ASSERT_OK(ExecutePlan("kelvin0",
+                        absl::Substitute(kKelvinPlanTmpl, kGatherKelvinDAG, kGatherKelvinOps,
+                                         kGatherExecutionStatusDestinations),
+                        query_id));
+
+  EXPECT_TRUE(result_server_->exec_errors().empty());
+  EXPECT_THAT(result_server_->output_tables(), ::testing::UnorderedElementsAre("out"));
+
+  // Each key is aggregated on exactly one Kelvin, so it shows up once in the output with the sum
+  // of the rows from both PEMs.
+  std::map<int64_t, double> sums;
+  for (const auto& rb : result_server_->query_results("out")) {
+    auto keys = std::static_pointer_cast<arrow::Int64Array>(rb.ColumnAt(0));
+    auto values = std::static_pointer_cast<arrow::DoubleArray>(rb.ColumnAt(1));
+    for (int64_t i = 0; i < rb.num_rows(); ++i) {
+      EXPECT_EQ(sums.count(keys->Value(i)), 0) << keys->Value(i);
+      sums[keys->Value(i)] = values->Value(i);
+    }
+  }
+  ASSERT_EQ(sums.size(), 5);
+  EXPECT_DOUBLE_EQ(sums[1], 1.0);
+  EXPECT_DOUBLE_EQ(sums[2], 2.4);
+  EXPECT_DOUBLE_EQ(sums[3], 10.6);
+  EXPECT_DOUBLE_EQ(sums[5], 0.2);
+  EXPECT_DOUBLE_EQ(sums[6], 10.2);
+}
+
+TEST_F(ShuffleTest, partitioned_join_with_different_key_names) {
+  sole::uuid query_id = sole::uuid4();
+  ASSERT_OK(ExecutePlan("pem0", absl::Substitute(kJoinPEMPlanTmpl, 1, 3), query_id));
+  ASSERT_OK(ExecutePlan("pem1", absl::Substitute(kJoinPEMPlanTmpl, 2, 4), query_id));
+  ASSERT_OK(ExecutePlan(
+      "kelvin1",
+      absl::Substitute(kJoinKelvinPlanTmpl, kJoinShuffleKelvinDAG, kJoinShuffleKelvinOps, ""),
+      query_id));
+  ASSERT_OK(ExecutePlan("kelvin0",
+                        absl::Substitute(kJoinKelvinPlanTmpl, kJoinGatherKelvinDAG,
+                                         kJoinGatherKelvinOps, kGatherExecutionStatusDestinations),
+                        query_id));
+
+  EXPECT_TRUE(result_server_->exec_errors().empty());
+  EXPECT_THAT(result_server_->output_tables(), ::testing::UnorderedElementsAre("out"));
+
+  // Both PEMs hold both tables, so every key that is on both sides joins 2 left rows with 2 right
+  // rows. That only happens if the two sides send the key to the same Kelvin.
+  const std::map<int64_t, double> left_values = {{2, 1.2}, {3, 5.3}, {6, 5.1}};
+  std::map<int64_t, int64_t> counts;
+  for (const auto& rb : result_server_->query_results("out")) {
+    auto keys = std::static_pointer_cast<arrow::Int64Array>(rb.ColumnAt(0));
+    auto col1 = std::static_pointer_cast<arrow::DoubleArray>(rb.ColumnAt(1));
+    auto values = std::static_pointer_cast<arrow::DoubleArray>(rb.ColumnAt(2));
+    for (int64_t i = 0; i < rb.num_rows(); ++i) {
+      int64_t key = keys->Value(i);
+      ASSERT_EQ(left_values.count(key), 1) << key;
+      EXPECT_DOUBLE_EQ(col1->Value(i), left_values.at(key));
+      EXPECT_DOUBLE_EQ(values->Value(i), 10.0 * key);
+      ++counts[key];
+    }
+  }
+  EXPECT_THAT(counts, ::testing::UnorderedElementsAre(::testing::Pair(2, 4), ::testing::Pair(3, 4),
+                                                      ::testing::Pair(6, 4)));
+}
+
+}  // namespace carnot
+}  // namespace px
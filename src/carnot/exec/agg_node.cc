@@ -23,6 +23,9 @@
 #include <arrow/status.h>
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
 
 #include <magic_enum.hpp>
 
@@ -78,6 +81,31 @@ void ExtractToColumnWrapper(const std::vector<GroupArgs>& group_args,
   }
 }
 
+// The partial aggregates of a group are serialized one after the other into a single string,
+// each preceded by its size. The size is written in host byte order, since the aggregates are
+// merged by the same build of Carnot that serialized them.
+void AppendSerializedUDA(std::string_view serialized_uda, std::string* out) {
+  uint64_t size = serialized_uda.size();
+  out->append(reinterpret_cast<const char*>(&size), sizeof(size));
+  out->append(serialized_uda);
+}
+
+// Removes the first partial aggregate from serialized and returns it.
+StatusOr<std::string_view> ConsumeSerializedUDA(std::string_view* serialized) {
+  uint64_t size;
+  if (serialized->size() < sizeof(size)) {
+    return error::InvalidArgument("Truncated partial aggregate");
+  }
+  std::memcpy(&size, serialized->data(), sizeof(size));
+  serialized->remove_prefix(sizeof(size));
+  if (serialized->size() < size) {
+    return error::InvalidArgument("Truncated partial aggregate");
+  }
+  std::string_view serialized_uda = serialized->substr(0, size);
+  serialized->remove_prefix(size);
+  return serialized_uda;
+}
+
 }  // namespace
 
 std::string AggNode::DebugStringImpl() {
@@ -105,10 +133,24 @@ Status AggNode::InitImpl(const plan::Operator& plan_node) {
     }
   }
 
-  size_t output_size = plan_node_->values().size() + plan_node_->groups().size();
+  // A partial aggregate outputs all of its values in a single column of serialized partial
+  // aggregates, which is the last input column of the aggregate that finalizes them.
+  size_t num_value_cols = plan_node_->partial_agg() ? 1 : plan_node_->values().size();
+  size_t output_size = num_value_cols + plan_node_->groups().size();
   if (output_size != output_descriptor_->size()) {
     return error::InvalidArgument("Output size mismatch in aggregate");
   }
+  if (plan_node_->finalize_results()) {
+    if (input_descriptor_->size() != plan_node_->groups().size() + 1 ||
+        input_descriptor_->type(input_descriptor_->size() - 1) != types::STRING) {
+      return error::InvalidArgument(
+          "Finalizing aggregate expects the groups and the serialized partial aggregates as input");
+    }
+  }
+
+  for (size_t i = plan_node_->groups().size(); i < output_descriptor_->size(); ++i) {
+    value_data_types_.emplace_back(output_descriptor_->type(i));
+  }
 
   if (HasNoGroups()) {
     return Status::OK();
@@ -127,13 +169,11 @@ Status AggNode::InitImpl(const plan::Operator& plan_node) {
     group_data_types_.emplace_back(input_descriptor_->type(group.idx));
   }
 
-  auto values_size = plan_node_->values().size();
-  for (size_t i = 0; i < values_size; ++i) {
-    auto values_idx = i + groups_size;
-    DCHECK(values_idx < output_descriptor_->size());
-    value_data_types_.emplace_back(output_descriptor_->type(values_idx));
+  // The arguments of the values of a finalizing aggregate refer to the input of the partial
+  // aggregates, so no input columns are stored for them.
+  if (plan_node_->finalize_results()) {
+    return Status::OK();
   }
-
   return CreateColumnMapping();
 }
 
@@ -145,8 +185,13 @@ Status AggNode::PrepareImpl(ExecState* exec_state) {
 Status AggNode::OpenImpl(ExecState* exec_state) {
   if (HasNoGroups()) {
     PX_RETURN_IF_ERROR(CreateUDAInfoValues(&udas_no_groups_, exec_state));
+    return Status::OK();
   }
-  return Status::OK();
+  // The vectorized aggregates can't be serialized or merged from partial aggregates.
+  if (plan_node_->partial_agg() || plan_node_->finalize_results()) {
+    return Status::OK();
+  }
+  return MaybeCreateVectorizedAgg(exec_state);
 }
 
 Status AggNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
@@ -161,10 +206,56 @@ Status AggNode::CloseImpl(ExecState*) {
   group_args_chunk_.clear();
   group_args_pool_.Clear();
   udas_pool_.Clear();
+  vectorized_agg_.reset();
 
   return Status::OK();
 }
 
+Status AggNode::MergeFrom(ExecState* exec_state, AggNode* other) {
+  DCHECK(!plan_node_->windowed());
+  if (HasNoGroups()) {
+    for (size_t i = 0; i < udas_no_groups_.size(); ++i) {
+      const auto& uda_info = udas_no_groups_[i];
+      PX_RETURN_IF_ERROR(uda_info.def->Merge(
+          uda_info.uda.get(), other->udas_no_groups_[i].uda.get(), function_ctx_.get()));
+    }
+    return Status::OK();
+  }
+
+  if (vectorized_agg_ != nullptr) {
+    DCHECK(other->vectorized_agg_ != nullptr);
+    return vectorized_agg_->MergeFrom(exec_state->exec_mem_pool(), other->vectorized_agg_.get());
+  }
+
+  for (const auto& [other_rt, other_val] : other->agg_hash_map_) {
+    // Fold the values the other node still has buffered into its UDAs before merging them.
+    PX_RETURN_IF_ERROR(other->EvaluateAggHashValue(exec_state, other_val));
+    AggHashValue* val = nullptr;
+    auto it = agg_hash_map_.find(other_rt);
+    if (it == agg_hash_map_.end()) {
+      // The group keys are owned by the other node, so they are copied into a RowTuple of ours.
+      RowTuple* rt = CreateGroupArgsRowTuple();
+      // FixedSizeValueUnion isn't copy assignable, so the values are copied as bytes, the same way
+      // RowTuple compares and hashes them.
+      DCHECK_EQ(rt->fixed_values.size(), other_rt->fixed_values.size());
+      std::memcpy(reinterpret_cast<uint8_t*>(rt->fixed_values.data()),
+                  reinterpret_cast<const uint8_t*>(other_rt->fixed_values.data()),
+                  sizeof(types::FixedSizeValueUnion) * rt->fixed_values.size());
+      rt->variable_values = other_rt->variable_values;
+      val = CreateAggHashValue(exec_state);
+      agg_hash_map_[rt] = val;
+    } else {
+      val = it->second;
+    }
+    for (size_t i = 0; i < val->udas.size(); ++i) {
+      const auto& uda_info = val->udas[i];
+      PX_RETURN_IF_ERROR(uda_info.def->Merge(uda_info.uda.get(), other_val->udas[i].uda.get(),
+                                             function_ctx_.get()));
+    }
+  }
+  return Status::OK();
+}
+
 bool AggNode::ReadyToEmitBatches(const RowBatch& rb) const {
   return rb.eos() || (rb.eow() && plan_node_->windowed());
 }
@@ -175,26 +266,38 @@ Status AggNode::ClearAggState(ExecState* exec_state) {
     PX_RETURN_IF_ERROR(CreateUDAInfoValues(&udas_no_groups_, exec_state));
   }
   agg_hash_map_.clear();
+  if (vectorized_agg_ != nullptr) {
+    vectorized_agg_->Clear();
+  }
   return Status::OK();
 }
 
 Status AggNode::AggregateGroupByNone(ExecState* exec_state, const RowBatch& rb) {
   auto values = plan_node_->values();
-  for (size_t i = 0; i < values.size(); ++i) {
-    PX_RETURN_IF_ERROR(
-        EvaluateSingleExpressionNoGroups(exec_state, udas_no_groups_[i], values[i].get(), rb));
+  if (plan_node_->finalize_results()) {
+    auto serialized_col = rb.ColumnAt(rb.num_columns() - 1).get();
+    for (int64_t row = 0; row < rb.num_rows(); ++row) {
+      PX_RETURN_IF_ERROR(MergeSerializedUDAs(
+          exec_state, types::GetStringViewFromArrowArray(serialized_col, row), udas_no_groups_));
+    }
+  } else {
+    for (size_t i = 0; i < values.size(); ++i) {
+      PX_RETURN_IF_ERROR(
+          EvaluateSingleExpressionNoGroups(exec_state, udas_no_groups_[i], values[i].get(), rb));
+    }
   }
 
   if (ReadyToEmitBatches(rb)) {
     RowBatch output_rb(*output_descriptor_, 1);
-    for (size_t i = 0; i < values.size(); ++i) {
-      const auto& uda_info = udas_no_groups_[i];
-      auto builder = types::MakeArrowBuilder(uda_info.def->finalize_return_type(),
-                                             exec_state->exec_mem_pool());
-      PX_RETURN_IF_ERROR(
-          uda_info.def->FinalizeArrow(uda_info.uda.get(), function_ctx_.get(), builder.get()));
+    std::vector<std::unique_ptr<arrow::ArrayBuilder>> value_builders;
+    for (const auto& value_data_type : value_data_types_) {
+      value_builders.push_back(
+          types::MakeArrowBuilder(value_data_type, exec_state->exec_mem_pool()));
+    }
+    PX_RETURN_IF_ERROR(AppendValues(udas_no_groups_, value_builders));
+    for (const auto& value_builder : value_builders) {
       SharedArray out_col;
-      PX_RETURN_IF_ERROR(builder->Finish(&out_col));
+      PX_RETURN_IF_ERROR(value_builder->Finish(&out_col));
       PX_RETURN_IF_ERROR(output_rb.AddColumn(out_col));
     }
     output_rb.set_eow(rb.eow());
@@ -325,11 +428,7 @@ Status AggNode::ConvertAggHashMapToRowBatch(ExecState* exec_state, RowBatch* out
     }
     // Actually Finalize the UDA based on the column wrapper chunks.
     PX_RETURN_IF_ERROR(EvaluateAggHashValue(exec_state, val));
-    for (size_t i = 0; i < val->udas.size(); ++i) {
-      const auto& uda_info = val->udas[i];
-      PX_RETURN_IF_ERROR(uda_info.def->FinalizeArrow(uda_info.uda.get(), function_ctx_.get(),
-                                                     value_builders[i].get()));
-    }
+    PX_RETURN_IF_ERROR(AppendValues(val->udas, value_builders));
   }
 
   for (const auto& group_builder : group_builders) {
@@ -348,6 +447,9 @@ Status AggNode::ConvertAggHashMapToRowBatch(ExecState* exec_state, RowBatch* out
 }
 
 Status AggNode::AggregateGroupByClause(ExecState* exec_state, const RowBatch& rb) {
+  if (vectorized_agg_ != nullptr) {
+    return AggregateGroupByClauseVectorized(exec_state, rb);
+  }
   // Extracts the row tuples (column wise).
   // TODO(zasgar): PL-455 - Chunk this so we don't create a crazy number of row tuples if the batch
   // is large. The process is as follows:
@@ -358,7 +460,14 @@ Status AggNode::AggregateGroupByClause(ExecState* exec_state, const RowBatch& rb
   // 5. If it's the last batch then emit the values.
   PX_RETURN_IF_ERROR(ExtractRowTupleForBatch(rb));
   PX_RETURN_IF_ERROR(HashRowBatch(exec_state, rb));
-  if (plan_node_->values().size() > 0) {
+  if (plan_node_->finalize_results()) {
+    auto serialized_col = rb.ColumnAt(rb.num_columns() - 1).get();
+    for (int64_t row = 0; row < rb.num_rows(); ++row) {
+      PX_RETURN_IF_ERROR(
+          MergeSerializedUDAs(exec_state, types::GetStringViewFromArrowArray(serialized_col, row),
+                              group_args_chunk_[row].av->udas));
+    }
+  } else if (plan_node_->values().size() > 0) {
     PX_RETURN_IF_ERROR(EvaluatePartialAggregates(exec_state, rb.num_rows()));
   }
   PX_RETURN_IF_ERROR(ResetGroupArgs());
@@ -373,6 +482,30 @@ Status AggNode::AggregateGroupByClause(ExecState* exec_state, const RowBatch& rb
   return Status::OK();
 }
 
+Status AggNode::AggregateGroupByClauseVectorized(ExecState* exec_state, const RowBatch& rb) {
+  std::vector<const arrow::Array*> group_cols;
+  group_cols.reserve(plan_node_->groups().size());
+  for (const auto& group : plan_node_->groups()) {
+    group_cols.push_back(rb.ColumnAt(group.idx).get());
+  }
+  std::vector<const arrow::Array*> agg_args;
+  agg_args.reserve(vectorized_agg_arg_cols_.size());
+  for (const auto& col_idx : vectorized_agg_arg_cols_) {
+    agg_args.push_back(rb.ColumnAt(col_idx).get());
+  }
+  PX_RETURN_IF_ERROR(vectorized_agg_->ConsumeBatch(group_cols, agg_args, rb.num_rows()));
+
+  if (ReadyToEmitBatches(rb)) {
+    RowBatch output_rb(*output_descriptor_, vectorized_agg_->NumGroups());
+    PX_RETURN_IF_ERROR(vectorized_agg_->ToRowBatch(exec_state->exec_mem_pool(), &output_rb));
+    output_rb.set_eow(rb.eow());
+    output_rb.set_eos(rb.eos());
+    PX_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, output_rb));
+    PX_RETURN_IF_ERROR(ClearAggState(exec_state));
+  }
+  return Status::OK();
+}
+
 StatusOr<types::DataType> AggNode::GetTypeOfDep(const plan::ScalarExpression& expr) const {
   // Agg exprs can only be of type col, or  const.
   switch (expr.ExpressionType()) {
@@ -431,6 +564,10 @@ Status AggNode::EvaluateSingleExpressionNoGroups(ExecState* exec_state, const UD
 }
 
 Status AggNode::EvaluateAggHashValue(ExecState* exec_state, AggHashValue* val) {
+  // The UDAs of a finalizing aggregate are merged from partial aggregates, without stored values.
+  if (val->agg_cols.empty()) {
+    return Status::OK();
+  }
   size_t values_size = plan_node_->values().size();
   for (size_t i = 0; i < values_size; ++i) {
     const auto& uda_info = val->udas[i];
@@ -514,16 +651,47 @@ AggHashValue* AggNode::CreateAggHashValue(ExecState* exec_state) {
   return val;
 }
 
+Status AggNode::MaybeCreateVectorizedAgg(ExecState* exec_state) {
+  std::vector<std::unique_ptr<VectorizedAggregate>> aggregates;
+  std::vector<int64_t> arg_cols;
+  for (const auto& value : plan_node_->values()) {
+    // Only single column UDAs without init args have a vectorized implementation.
+    if (!value->init_arguments().empty() || value->arg_deps().size() != 1 ||
+        value->arg_deps()[0]->ExpressionType() != plan::Expression::kColumn) {
+      return Status::OK();
+    }
+    auto col_idx = static_cast<const plan::Column*>(value->arg_deps()[0].get())->Index();
+    auto def = exec_state->GetUDADefinition(value->uda_id());
+    if (def == nullptr) {
+      return Status::OK();
+    }
+    auto agg = VectorizedAggregate::Make(def->vectorized_kind(), input_descriptor_->type(col_idx),
+                                         def->finalize_return_type());
+    if (agg == nullptr) {
+      return Status::OK();
+    }
+    aggregates.push_back(std::move(agg));
+    arg_cols.push_back(col_idx);
+  }
+  vectorized_agg_arg_cols_ = std::move(arg_cols);
+  vectorized_agg_ =
+      std::make_unique<VectorizedAggHashTable>(group_data_types_, std::move(aggregates));
+  return Status::OK();
+}
+
 Status AggNode::CreateUDAInfoValues(std::vector<UDAInfo>* val, ExecState* exec_state) {
   CHECK(val != nullptr);
   CHECK_EQ(val->size(), 0ULL);
 
   for (const auto& value : plan_node_->values()) {
-    std::vector<types::DataType> types;
-    types.reserve(value->Deps().size());
-    for (auto* dep : value->Deps()) {
-      PX_ASSIGN_OR_RETURN(auto type, GetTypeOfDep(*dep));
-      types.push_back(type);
+    // The arguments of a finalizing aggregate aren't columns of its input.
+    if (!plan_node_->finalize_results()) {
+      std::vector<types::DataType> types;
+      types.reserve(value->Deps().size());
+      for (auto* dep : value->Deps()) {
+        PX_ASSIGN_OR_RETURN(auto type, GetTypeOfDep(*dep));
+        types.push_back(type);
+      }
     }
     auto def = exec_state->GetUDADefinition(value->uda_id());
     auto uda = def->Make();
@@ -540,6 +708,45 @@ Status AggNode::CreateUDAInfoValues(std::vector<UDAInfo>* val, ExecState* exec_s
   return Status::OK();
 }
 
+Status AggNode::AppendValues(const std::vector<UDAInfo>& udas,
+                             const std::vector<std::unique_ptr<arrow::ArrayBuilder>>& builders) {
+  if (!plan_node_->partial_agg()) {
+    for (const auto& [i, uda_info] : Enumerate(udas)) {
+      PX_RETURN_IF_ERROR(
+          uda_info.def->FinalizeArrow(uda_info.uda.get(), function_ctx_.get(), builders[i].get()));
+    }
+    return Status::OK();
+  }
+  std::string serialized;
+  for (const auto& uda_info : udas) {
+    PX_ASSIGN_OR_RETURN(auto serialized_uda,
+                        uda_info.def->Serialize(uda_info.uda.get(), function_ctx_.get()));
+    AppendSerializedUDA(serialized_uda, &serialized);
+  }
+  DCHECK_EQ(builders.size(), 1U);
+  PX_RETURN_IF_ERROR(static_cast<arrow::StringBuilder*>(builders[0].get())->Append(serialized));
+  return Status::OK();
+}
+
+Status AggNode::MergeSerializedUDAs(ExecState* exec_state, std::string_view serialized,
+                                    const std::vector<UDAInfo>& udas) {
+  // Each partial aggregate is deserialized into a new UDA, which is merged like the UDAs of the
+  // pipelines in MergeFrom().
+  std::vector<UDAInfo> partial_udas;
+  PX_RETURN_IF_ERROR(CreateUDAInfoValues(&partial_udas, exec_state));
+  for (const auto& [i, uda_info] : Enumerate(udas)) {
+    PX_ASSIGN_OR_RETURN(std::string_view serialized_uda, ConsumeSerializedUDA(&serialized));
+    udf::UDA* partial_uda = partial_udas[i].uda.get();
+    PX_RETURN_IF_ERROR(uda_info.def->Deserialize(partial_uda, function_ctx_.get(),
+                                                 types::StringValue(serialized_uda)));
+    PX_RETURN_IF_ERROR(uda_info.def->Merge(uda_info.uda.get(), partial_uda, function_ctx_.get()));
+  }
+  if (!serialized.empty()) {
+    return error::InvalidArgument("Partial aggregate has $0 trailing bytes", serialized.size());
+  }
+  return Status::OK();
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -21,6 +21,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -28,6 +29,7 @@
 #include "src/carnot/exec/exec_state.h"
 #include "src/carnot/exec/expression_evaluator.h"
 #include "src/carnot/exec/row_tuple.h"
+#include "src/carnot/exec/vectorized_agg.h"
 #include "src/carnot/plan/operators.h"
 #include "src/carnot/plan/scalar_expression.h"
 #include "src/carnot/udf/base.h"
@@ -70,9 +72,18 @@ class AggNode : public ProcessingNode {
   AggNode() = default;
   virtual ~AggNode() = default;
 
+  /**
+   * Merges the aggregate state of other, which must run the same aggregate operator, into this
+   * node. This is used to combine the partial aggregates of the copies of a pipeline that ran on
+   * separate threads, before the end of stream reaches this node.
+   */
+  Status MergeFrom(ExecState* exec_state, AggNode* other);
+
  protected:
   Status AggregateGroupByNone(ExecState* exec_state, const table_store::schema::RowBatch& rb);
   Status AggregateGroupByClause(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+  Status AggregateGroupByClauseVectorized(ExecState* exec_state,
+                                          const table_store::schema::RowBatch& rb);
 
   std::string DebugStringImpl() override;
   Status InitImpl(const plan::Operator& plan_node) override;
@@ -131,6 +142,12 @@ class AggNode : public ProcessingNode {
   // This vector holds pointers to the row_tuples which are managed by the group_args_pool_.
 
   std::vector<GroupArgs> group_args_chunk_;
+
+  // When all of the aggregate expressions are builtin UDAs that have a columnar implementation,
+  // the groups are aggregated with the vectorized hash table instead of the RowTuple based one.
+  std::unique_ptr<VectorizedAggHashTable> vectorized_agg_;
+  // The input column index of the argument to each aggregate expression.
+  std::vector<int64_t> vectorized_agg_arg_cols_;
   // END: Variables specific to GroupBy Agg.
 
   // Creates a mapping between plan cols and stored cols (see above comment).
@@ -149,6 +166,16 @@ class AggNode : public ProcessingNode {
   }
 
   Status CreateUDAInfoValues(std::vector<UDAInfo>* val, ExecState* exec_state);
+  // Appends the results of the UDAs of a group to the value builders, or, for a partial
+  // aggregate, their serialized partial aggregates to the single value builder.
+  Status AppendValues(const std::vector<UDAInfo>& udas,
+                      const std::vector<std::unique_ptr<arrow::ArrayBuilder>>& builders);
+  // Merges the partial aggregates serialized by AppendValues() into the UDAs of a group.
+  Status MergeSerializedUDAs(ExecState* exec_state, std::string_view serialized,
+                             const std::vector<UDAInfo>& udas);
+  // Sets up vectorized_agg_ if every aggregate expression can be run vectorized, otherwise it is
+  // left as nullptr and the generic UDA path is used.
+  Status MaybeCreateVectorizedAgg(ExecState* exec_state);
 };
 
 }  // namespace exec
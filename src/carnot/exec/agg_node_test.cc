@@ -19,6 +19,8 @@
 #include "src/carnot/exec/agg_node.h"
 
 #include <algorithm>
+#include <cstring>
+#include <string>
 
 #include <google/protobuf/text_format.h>
 #include <gtest/gtest.h>
@@ -48,6 +50,13 @@ class MinSumUDA : public udf::UDA {
   }
   void Merge(udf::FunctionContext*, const MinSumUDA& other) { sum_ = sum_.val + other.sum_.val; }
   types::Int64Value Finalize(udf::FunctionContext*) { return sum_; }
+  types::StringValue Serialize(udf::FunctionContext*) {
+    return types::StringValue(reinterpret_cast<const char*>(&sum_.val), sizeof(sum_.val));
+  }
+  Status Deserialize(udf::FunctionContext*, const types::StringValue& data) {
+    std::memcpy(&sum_.val, data.data(), sizeof(sum_.val));
+    return Status::OK();
+  }
 
  protected:
   types::Int64Value sum_ = 0;
@@ -71,6 +80,20 @@ class MinSumWithInitUDA : public udf::UDA {
   types::Int64Value sum_ = 0;
 };
 
+// Same semantics as the builtin sum, so it declares the vectorized kind, which lets AggNode use the
+// vectorized aggregate.
+class SumUDA : public udf::UDA {
+ public:
+  static constexpr udf::VectorizedUDAKind kVectorizedKind = udf::VectorizedUDAKind::kSum;
+
+  void Update(udf::FunctionContext*, types::Int64Value arg) { sum_ = sum_.val + arg.val; }
+  void Merge(udf::FunctionContext*, const SumUDA& other) { sum_ = sum_.val + other.sum_.val; }
+  types::Int64Value Finalize(udf::FunctionContext*) { return sum_; }
+
+ protected:
+  types::Int64Value sum_ = 0;
+};
+
 constexpr char kBlockingNoGroupAgg[] = R"(
 op_type: AGGREGATE_OPERATOR
 agg_op {
@@ -201,6 +224,28 @@ agg_op {
   value_names: "value1"
 })";
 
+constexpr char kBlockingSingleGroupSumAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "sum"
+    args {
+      column {
+        node:0
+        index: 1
+      }
+    }
+    id: 2
+  }
+  groups {
+     node: 0
+     index: 0
+  }
+  group_names: "g1"
+  value_names: "value1"
+})";
+
 constexpr char kSingleGroupNoValues[] = R"(
 op_type: AGGREGATE_OPERATOR
 agg_op {
@@ -270,6 +315,118 @@ agg_op {
   value_names: "value1"
 })";
 
+constexpr char kPartialNoGroupAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "minsum"
+    args {
+      column {
+        node:0
+        index: 0
+      }
+    }
+    args {
+      column {
+        node:0
+        index: 1
+      }
+    }
+  }
+  value_names: "value1"
+  partial_agg: true
+})";
+
+constexpr char kPartialSingleGroupAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "minsum"
+    args {
+      column {
+        node:0
+        index: 0
+      }
+    }
+    args {
+      column {
+        node:0
+        index: 1
+      }
+    }
+  }
+  groups {
+     node: 0
+     index: 0
+  }
+  group_names: "g1"
+  value_names: "value1"
+  partial_agg: true
+})";
+
+// The arguments of the values refer to the input of the partial aggregates, not to the input of
+// the finalizing aggregate, which only has the groups and the serialized partial aggregates.
+constexpr char kFinalizeNoGroupAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "minsum"
+    args {
+      column {
+        node:0
+        index: 2
+      }
+    }
+    args {
+      column {
+        node:0
+        index: 3
+      }
+    }
+  }
+  value_names: "value1"
+  finalize_results: true
+})";
+
+constexpr char kFinalizeSingleGroupAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "minsum"
+    args {
+      column {
+        node:0
+        index: 2
+      }
+    }
+    args {
+      column {
+        node:0
+        index: 3
+      }
+    }
+  }
+  groups {
+     node: 0
+     index: 0
+  }
+  group_names: "g1"
+  value_names: "value1"
+  finalize_results: true
+})";
+
+// The serialized partial aggregate of a single MinSumUDA with the given sum.
+types::StringValue SerializedMinSum(int64_t sum) {
+  uint64_t size = sizeof(sum);
+  std::string serialized(reinterpret_cast<const char*>(&size), sizeof(size));
+  serialized.append(reinterpret_cast<const char*>(&sum), sizeof(sum));
+  return serialized;
+}
+
 std::unique_ptr<ExecState> MakeTestExecState(udf::Registry* registry) {
   auto table_store = std::make_shared<table_store::TableStore>();
   return std::make_unique<ExecState>(registry, table_store, MockResultSinkStubGenerator,
@@ -289,11 +446,13 @@ class AggNodeTest : public ::testing::Test {
     func_registry_ = std::make_unique<udf::Registry>("test");
     EXPECT_TRUE(func_registry_->Register<MinSumUDA>("minsum").ok());
     EXPECT_TRUE(func_registry_->Register<MinSumWithInitUDA>("minsum_w_init").ok());
+    EXPECT_TRUE(func_registry_->Register<SumUDA>("sum").ok());
 
     exec_state_ = MakeTestExecState(func_registry_.get());
     EXPECT_OK(exec_state_->AddUDA(0, "minsum",
                                   std::vector<types::DataType>({types::INT64, types::INT64})));
     EXPECT_OK(exec_state_->AddUDA(1, "minsum_w_init", {types::INT64, types::INT64, types::INT64}));
+    EXPECT_OK(exec_state_->AddUDA(2, "sum", {types::INT64}));
   }
 
  protected:
@@ -446,6 +605,39 @@ TEST_F(AggNodeTest, multiple_groups_with_string_blocking) {
       .Close();
 }
 
+TEST_F(AggNodeTest, single_group_vectorized_blocking) {
+  auto plan_node = PlanNodeFromPbtxt(kBlockingSingleGroupSumAgg);
+  RowDescriptor input_rd({types::DataType::STRING, types::DataType::INT64});
+
+  RowDescriptor output_rd({types::DataType::STRING, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::StringValue>({"abc", "def", "abc", "fgh"})
+                       .AddColumn<types::Int64Value>({2, 1, 3, 1})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 0, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::StringValue>({})
+                       .AddColumn<types::Int64Value>({})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, true, true)
+                       .AddColumn<types::StringValue>({"ijk", "abc", "abc", "def"})
+                       .AddColumn<types::Int64Value>({1, 2, 3, 3})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 4, true, true)
+                          .AddColumn<types::StringValue>({"abc", "def", "fgh", "ijk"})
+                          .AddColumn<types::Int64Value>({10, 4, 1, 1})
+                          .get(),
+                      false)
+      .Close();
+}
+
 TEST_F(AggNodeTest, no_groups_windowed) {
   auto plan_node = PlanNodeFromPbtxt(kWindowedNoGroupAgg);
   RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
@@ -611,6 +803,130 @@ TEST_F(AggNodeTest, single_group_blocking_init_args) {
       .Close();
 }
 
+TEST_F(AggNodeTest, partial_no_groups_blocking) {
+  auto plan_node = PlanNodeFromPbtxt(kPartialNoGroupAgg);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd({types::DataType::STRING});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, true, true)
+                       .AddColumn<types::Int64Value>({1, 2, 3, 4})
+                       .AddColumn<types::Int64Value>({2, 5, 6, 8})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, true, true)
+                          .AddColumn<types::StringValue>({SerializedMinSum(10)})
+                          .get(),
+                      false)
+      .Close();
+}
+
+TEST_F(AggNodeTest, partial_single_group_blocking) {
+  auto plan_node = PlanNodeFromPbtxt(kPartialSingleGroupAgg);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::STRING});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Int64Value>({1, 1, 2, 2})
+                       .AddColumn<types::Int64Value>({2, 3, 3, 1})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, true, true)
+                       .AddColumn<types::Int64Value>({3, 1})
+                       .AddColumn<types::Int64Value>({5, 1})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 3, true, true)
+                          .AddColumn<types::Int64Value>({1, 2, 3})
+                          .AddColumn<types::StringValue>(
+                              {SerializedMinSum(3), SerializedMinSum(3), SerializedMinSum(3)})
+                          .get(),
+                      false)
+      .Close();
+}
+
+TEST_F(AggNodeTest, finalize_no_groups_blocking) {
+  auto plan_node = PlanNodeFromPbtxt(kFinalizeNoGroupAgg);
+  RowDescriptor input_rd({types::DataType::STRING});
+
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  // The partial aggregates of two agents.
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 1, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::StringValue>({SerializedMinSum(10)})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 1, true, true)
+                       .AddColumn<types::StringValue>({SerializedMinSum(13)})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, true, true)
+                          .AddColumn<types::Int64Value>({Int64Value(23)})
+                          .get(),
+                      false)
+      .Close();
+}
+
+TEST_F(AggNodeTest, finalize_single_group_blocking) {
+  auto plan_node = PlanNodeFromPbtxt(kFinalizeSingleGroupAgg);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::STRING});
+
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  // The partial aggregates of two agents, which both have group 2.
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Int64Value>({1, 2})
+                       .AddColumn<types::StringValue>({SerializedMinSum(2), SerializedMinSum(3)})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, true, true)
+                       .AddColumn<types::Int64Value>({2, 3})
+                       .AddColumn<types::StringValue>({SerializedMinSum(4), SerializedMinSum(5)})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 3, true, true)
+                          .AddColumn<types::Int64Value>({1, 2, 3})
+                          .AddColumn<types::Int64Value>({2, 7, 5})
+                          .get(),
+                      false)
+      .Close();
+}
+
+TEST_F(AggNodeTest, finalize_truncated_partial_agg) {
+  auto plan_node = PlanNodeFromPbtxt(kFinalizeNoGroupAgg);
+  RowDescriptor input_rd({types::DataType::STRING});
+
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  std::string truncated = SerializedMinSum(10);
+  truncated.pop_back();
+  EXPECT_NOT_OK(tester.node()->ConsumeNext(exec_state_.get(),
+                                           RowBatchBuilder(input_rd, 1, true, true)
+                                               .AddColumn<types::StringValue>({truncated})
+                                               .get(),
+                                           0));
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -35,6 +35,9 @@
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/type_utils.h"
 
+DEFINE_bool(carnot_radix_join, gflags::BoolFromEnv("PL_CARNOT_RADIX_JOIN", false),
+            "Use the radix partitioned hash table for the build side of equijoins.");
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -112,6 +115,11 @@ Status EquijoinNode::InitImpl(const plan::Operator& plan_node) {
     selected_spec.output_col_indices.emplace_back(i);
   }
 
+  if (FLAGS_carnot_radix_join) {
+    radix_table_ =
+        std::make_unique<RadixJoinHashTable>(key_data_types_, build_spec_.input_col_types);
+  }
+
   return Status::OK();
 }
 
@@ -138,6 +146,7 @@ Status EquijoinNode::CloseImpl(ExecState* /*exec_state*/) {
   build_buffer_.clear();
   probed_keys_.clear();
   key_values_pool_.Clear();
+  radix_table_.reset();
   return Status::OK();
 }
 
@@ -327,13 +336,15 @@ Status EquijoinNode::FlushChunkedRows(ExecState* exec_state) {
 Status EquijoinNode::MatchBuildValuesAndFlush(ExecState* exec_state,
                                               std::vector<types::SharedColumnWrapper>* wrapper,
                                               std::shared_ptr<RowBatch> probe_rb,
-                                              int64_t probe_rb_row, int64_t matching_bb_rows) {
+                                              int64_t probe_rb_row, int64_t matching_bb_rows,
+                                              int64_t bb_row_offset) {
   int64_t bb_rows_left = matching_bb_rows;
 
   while (bb_rows_left > 0) {
     auto available = output_rows_per_batch_ - (column_builders_[0]->length() + queued_rows_);
     auto chunk_rows = std::min(bb_rows_left, available);
-    OutputChunk c{probe_rb, wrapper, chunk_rows, matching_bb_rows - bb_rows_left, probe_rb_row};
+    OutputChunk c{probe_rb, wrapper, chunk_rows,
+                  bb_row_offset + matching_bb_rows - bb_rows_left, probe_rb_row};
     chunks_.emplace_back(c);
     queued_rows_ += chunk_rows;
     bb_rows_left -= chunk_rows;
@@ -346,26 +357,58 @@ Status EquijoinNode::MatchBuildValuesAndFlush(ExecState* exec_state,
   return Status::OK();
 }
 
-Status EquijoinNode::DoProbe(ExecState* exec_state, const table_store::schema::RowBatch& rb) {
-  if (rb.eos()) {
-    probe_eos_ = true;
-  }
-
+Status EquijoinNode::MatchProbeRows(const table_store::schema::RowBatch& rb) {
   PX_RETURN_IF_ERROR(ExtractJoinKeysForBatch(rb, true));
 
-  if (rb.num_rows() > static_cast<int64_t>(probe_wrappers_chunk_.size())) {
-    probe_wrappers_chunk_.resize(rb.num_rows());
-  }
-
   for (auto row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
     auto it = build_buffer_.find(join_keys_chunk_[row_idx]);
     if (it != build_buffer_.end()) {
-      probe_wrappers_chunk_[row_idx] = it->second;
+      probe_matches_[row_idx] = {it->second, 0, build_buffer_rows_[it->first]};
       probed_keys_.insert(it->first);
     } else {
-      probe_wrappers_chunk_[row_idx] = nullptr;
+      probe_matches_[row_idx] = {nullptr, 0, 0};
     }
   }
+  return Status::OK();
+}
+
+Status EquijoinNode::MatchProbeRowsRadix(const table_store::schema::RowBatch& rb) {
+  key_cols_.clear();
+  for (auto key_idx : probe_spec_.key_indices) {
+    key_cols_.push_back(rb.ColumnAt(key_idx).get());
+  }
+  radix_table_->ProbeBatch(key_cols_, rb.num_rows());
+
+  const auto& partitions = radix_table_->probe_partitions();
+  const auto& key_ids = radix_table_->probe_key_ids();
+  for (auto row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+    auto key_id = key_ids[row_idx];
+    if (key_id == RadixJoinHashTable::kNoMatch) {
+      probe_matches_[row_idx] = {nullptr, 0, 0};
+      continue;
+    }
+    auto partition = partitions[row_idx];
+    radix_table_->MarkMatched(partition, key_id);
+    probe_matches_[row_idx] = {radix_table_->Payload(partition),
+                               radix_table_->KeyRowsStart(partition, key_id),
+                               radix_table_->KeyNumRows(partition, key_id)};
+  }
+  return Status::OK();
+}
+
+Status EquijoinNode::DoProbe(ExecState* exec_state, const table_store::schema::RowBatch& rb) {
+  if (rb.eos()) {
+    probe_eos_ = true;
+  }
+
+  if (rb.num_rows() > static_cast<int64_t>(probe_matches_.size())) {
+    probe_matches_.resize(rb.num_rows());
+  }
+  if (radix_table_ != nullptr) {
+    PX_RETURN_IF_ERROR(MatchProbeRowsRadix(rb));
+  } else {
+    PX_RETURN_IF_ERROR(MatchProbeRows(rb));
+  }
 
   auto rb_ptr = std::make_shared<RowBatch>(rb);
 
@@ -374,7 +417,8 @@ Status EquijoinNode::DoProbe(ExecState* exec_state, const table_store::schema::R
       PX_RETURN_IF_ERROR(FlushChunkedRows(exec_state));
     }
 
-    if (probe_wrappers_chunk_[row_idx] == nullptr) {
+    const auto& match = probe_matches_[row_idx];
+    if (match.wrappers_ptr == nullptr) {
       if (probe_spec_.emit_unmatched_rows) {
         OutputChunk c{rb_ptr, nullptr, 1, 0, row_idx};
         chunks_.emplace_back(c);
@@ -383,9 +427,8 @@ Status EquijoinNode::DoProbe(ExecState* exec_state, const table_store::schema::R
       continue;
     }
 
-    PX_RETURN_IF_ERROR(MatchBuildValuesAndFlush(exec_state, probe_wrappers_chunk_[row_idx], rb_ptr,
-                                                row_idx,
-                                                build_buffer_rows_[join_keys_chunk_[row_idx]]));
+    PX_RETURN_IF_ERROR(MatchBuildValuesAndFlush(exec_state, match.wrappers_ptr, rb_ptr, row_idx,
+                                                match.num_rows, match.bb_row_idx));
   }
 
   if (probe_eos_ && queued_rows_ > 0) {
@@ -401,7 +444,25 @@ Status EquijoinNode::EmitUnmatchedBuildRows(ExecState* exec_state) {
       continue;
     }
     PX_RETURN_IF_ERROR(MatchBuildValuesAndFlush(exec_state, it->second, nullptr, 0,
-                                                build_buffer_rows_[it->first]));
+                                                build_buffer_rows_[it->first], 0));
+  }
+
+  if (queued_rows_ > 0) {
+    PX_RETURN_IF_ERROR(FlushChunkedRows(exec_state));
+  }
+  return Status::OK();
+}
+
+Status EquijoinNode::EmitUnmatchedBuildRowsRadix(ExecState* exec_state) {
+  for (size_t p = 0; p < RadixJoinHashTable::kNumPartitions; ++p) {
+    for (uint32_t key_id = 0; key_id < radix_table_->NumKeys(p); ++key_id) {
+      if (radix_table_->IsMatched(p, key_id)) {
+        continue;
+      }
+      PX_RETURN_IF_ERROR(MatchBuildValuesAndFlush(
+          exec_state, radix_table_->Payload(p), nullptr, 0, radix_table_->KeyNumRows(p, key_id),
+          radix_table_->KeyRowsStart(p, key_id)));
+    }
   }
 
   if (queued_rows_ > 0) {
@@ -410,14 +471,34 @@ Status EquijoinNode::EmitUnmatchedBuildRows(ExecState* exec_state) {
   return Status::OK();
 }
 
+Status EquijoinNode::ConsumeBuildBatchRadix(const table_store::schema::RowBatch& rb) {
+  key_cols_.clear();
+  for (auto key_idx : build_spec_.key_indices) {
+    key_cols_.push_back(rb.ColumnAt(key_idx).get());
+  }
+  payload_cols_.clear();
+  for (auto col_idx : build_spec_.input_col_indices) {
+    payload_cols_.push_back(rb.ColumnAt(col_idx).get());
+  }
+  PX_RETURN_IF_ERROR(radix_table_->AddBuildBatch(key_cols_, payload_cols_, rb.num_rows()));
+  if (build_eos_) {
+    radix_table_->FinalizeBuild();
+  }
+  return Status::OK();
+}
+
 Status EquijoinNode::ConsumeBuildBatch(ExecState* exec_state,
                                        const table_store::schema::RowBatch& rb) {
   if (rb.eos()) {
     build_eos_ = true;
   }
 
-  PX_RETURN_IF_ERROR(ExtractJoinKeysForBatch(rb, false));
-  PX_RETURN_IF_ERROR(HashRowBatch(rb));
+  if (radix_table_ != nullptr) {
+    PX_RETURN_IF_ERROR(ConsumeBuildBatchRadix(rb));
+  } else {
+    PX_RETURN_IF_ERROR(ExtractJoinKeysForBatch(rb, false));
+    PX_RETURN_IF_ERROR(HashRowBatch(rb));
+  }
 
   if (build_eos_) {
     while (probe_batches_.size()) {
@@ -449,7 +530,8 @@ Status EquijoinNode::ConsumeNextImpl(ExecState* exec_state, const table_store::s
 
   if (build_eos_ && probe_eos_) {
     if (build_spec_.emit_unmatched_rows) {
-      PX_RETURN_IF_ERROR(EmitUnmatchedBuildRows(exec_state));
+      PX_RETURN_IF_ERROR(radix_table_ != nullptr ? EmitUnmatchedBuildRowsRadix(exec_state)
+                                                 : EmitUnmatchedBuildRows(exec_state));
     }
 
     if (column_builders_[0]->length()) {
@@ -30,6 +30,7 @@
 
 #include "src/carnot/exec/exec_node.h"
 #include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/radix_join.h"
 #include "src/carnot/exec/row_tuple.h"
 #include "src/carnot/plan/operators.h"
 #include "src/common/base/base.h"
@@ -39,6 +40,8 @@
 #include "src/shared/types/types.h"
 #include "src/table_store/table_store.h"
 
+DECLARE_bool(carnot_radix_join);
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -81,13 +84,19 @@ class EquijoinNode : public ProcessingNode {
   Status HashRowBatch(const table_store::schema::RowBatch& rb);
 
   Status DoProbe(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+  // Fills probe_matches_ with the build rows that match each row of the probe batch.
+  Status MatchProbeRows(const table_store::schema::RowBatch& rb);
+  Status MatchProbeRowsRadix(const table_store::schema::RowBatch& rb);
   Status MatchBuildValuesAndFlush(ExecState* exec_state,
                                   std::vector<types::SharedColumnWrapper>* wrapper,
                                   std::shared_ptr<table_store::schema::RowBatch> probe_rb,
-                                  int64_t probe_rb_row_idx, int64_t matching_bb_rows);
+                                  int64_t probe_rb_row_idx, int64_t matching_bb_rows,
+                                  int64_t bb_row_offset);
   Status EmitUnmatchedBuildRows(ExecState* exec_state);
+  Status EmitUnmatchedBuildRowsRadix(ExecState* exec_state);
   Status NextOutputBatch(ExecState* exec_state);
   Status ConsumeBuildBatch(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+  Status ConsumeBuildBatchRadix(const table_store::schema::RowBatch& rb);
   Status ConsumeProbeBatch(ExecState* exec_state, const table_store::schema::RowBatch& rb);
 
   bool build_eos_ = false;
@@ -138,9 +147,14 @@ class EquijoinNode : public ProcessingNode {
   // Chunk of data to use when performing the build stage of the join.
   std::vector<std::vector<types::SharedColumnWrapper>*> build_wrappers_chunk_;
 
-  // Chunk of data to use when performing the probe stage of the join.
-  // This will store build table data from `build_buffer_`.
-  std::vector<std::vector<types::SharedColumnWrapper>*> probe_wrappers_chunk_;
+  // The build rows matching each row of the current probe batch: rows
+  // [bb_row_idx, bb_row_idx + num_rows) of wrappers_ptr, or nullptr if there are none.
+  struct ProbeMatch {
+    std::vector<types::SharedColumnWrapper>* wrappers_ptr;
+    int64_t bb_row_idx;
+    int64_t num_rows;
+  };
+  std::vector<ProbeMatch> probe_matches_;
   AbslRowTupleHashMap<std::vector<types::SharedColumnWrapper>*> build_buffer_;
   // Store the number of rows that match a given set of keys for the build buffer.
   // This is necessary to store in addition to the values in `build_buffer_` in
@@ -151,6 +165,12 @@ class EquijoinNode : public ProcessingNode {
   // keep track of which ones they were.
   AbslRowTupleHashSet probed_keys_;
 
+  // When running in radix mode (--carnot_radix_join), the build side is stored in the radix
+  // table instead of build_buffer_.
+  std::unique_ptr<RadixJoinHashTable> radix_table_;
+  std::vector<const arrow::Array*> key_cols_;
+  std::vector<arrow::Array*> payload_cols_;
+
   // Handle on the most recent RowBatch (in case it's the final one).
   std::unique_ptr<table_store::schema::RowBatch> pending_output_batch_;
 
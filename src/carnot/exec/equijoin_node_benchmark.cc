@@ -0,0 +1,171 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <google/protobuf/text_format.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <absl/random/zipf_distribution.h>
+#include <absl/strings/substitute.h>
+#include <sole.hpp>
+
+#include "src/carnot/exec/equijoin_node.h"
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/carnot/planpb/test_proto.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/types.h"
+
+using px::carnot::exec::EquijoinNode;
+using px::carnot::exec::MockMetricsStubGenerator;
+using px::carnot::exec::MockResultSinkStubGenerator;
+using px::carnot::exec::MockTraceStubGenerator;
+using px::carnot::exec::RowBatchBuilder;
+using px::table_store::schema::RowBatch;
+using px::table_store::schema::RowDescriptor;
+using px::types::DataType;
+
+namespace {
+
+constexpr int64_t kBatchSize = 1024;
+constexpr int64_t kProbeRows = 256 * 1024;
+
+// Joins [key, payload] (left/build) with [key, payload] (right/probe) on key.
+constexpr char kJoinOp[] = R"(
+  type: INNER
+  equality_conditions {
+    left_column_index: 0
+    right_column_index: 0
+  }
+  output_columns: {
+    parent_index: 0
+    column_index: 1
+  }
+  output_columns: {
+    parent_index: 1
+    column_index: 1
+  }
+  column_names: "build_val"
+  column_names: "probe_val"
+)";
+
+enum class KeySkew { kUniform = 0, kZipf = 1 };
+
+std::vector<RowBatch> MakeBatches(const RowDescriptor& rd, const std::vector<int64_t>& keys) {
+  std::vector<RowBatch> batches;
+  for (size_t start = 0; start < keys.size(); start += kBatchSize) {
+    size_t end = std::min(keys.size(), start + kBatchSize);
+    std::vector<px::types::Int64Value> key_col(keys.begin() + start, keys.begin() + end);
+    std::vector<px::types::Float64Value> val_col(key_col.size(), 1.0);
+    bool eos = end == keys.size();
+    batches.push_back(RowBatchBuilder(rd, key_col.size(), eos, eos)
+                          .AddColumn<px::types::Int64Value>(key_col)
+                          .AddColumn<px::types::Float64Value>(val_col)
+                          .get());
+  }
+  return batches;
+}
+
+// The build side has build_rows rows. With uniform keys every build key is distinct, with zipf
+// keys there are build_rows / 16 distinct keys and a handful of them cover most of the rows.
+// Half of the probe rows have a key that is missing from the build side.
+void MakeJoinInput(int64_t build_rows, KeySkew skew, const RowDescriptor& rd,
+                   std::vector<RowBatch>* build_batches, std::vector<RowBatch>* probe_batches) {
+  std::mt19937_64 rng(42);
+  std::vector<int64_t> build_keys(build_rows);
+  int64_t num_keys = build_rows;
+  if (skew == KeySkew::kUniform) {
+    std::iota(build_keys.begin(), build_keys.end(), 0);
+    std::shuffle(build_keys.begin(), build_keys.end(), rng);
+  } else {
+    num_keys = std::max<int64_t>(1, build_rows / 16);
+    absl::zipf_distribution<int64_t> dist(num_keys - 1);
+    std::generate(build_keys.begin(), build_keys.end(), [&] { return dist(rng); });
+  }
+
+  std::uniform_int_distribution<int64_t> probe_dist(0, 2 * num_keys - 1);
+  std::vector<int64_t> probe_keys(kProbeRows);
+  std::generate(probe_keys.begin(), probe_keys.end(), [&] { return probe_dist(rng); });
+
+  *build_batches = MakeBatches(rd, build_keys);
+  *probe_batches = MakeBatches(rd, probe_keys);
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE : runtime/references.
+void BM_Equijoin(benchmark::State& state) {
+  int64_t build_rows = state.range(0);
+  auto skew = static_cast<KeySkew>(state.range(1));
+  FLAGS_carnot_radix_join = state.range(2);
+
+  auto func_registry = std::make_unique<px::carnot::udf::Registry>("test_registry");
+  auto table_store = std::make_shared<px::table_store::TableStore>();
+  auto exec_state = std::make_unique<px::carnot::exec::ExecState>(
+      func_registry.get(), table_store, MockResultSinkStubGenerator, MockMetricsStubGenerator,
+      MockTraceStubGenerator, sole::uuid4(), nullptr);
+
+  px::carnot::planpb::Operator op_pb;
+  CHECK(google::protobuf::TextFormat::MergeFromString(
+      absl::Substitute(px::carnot::planpb::testutils::kOperatorProtoTmpl, "JOIN_OPERATOR",
+                       "join_op", kJoinOp),
+      &op_pb));
+  auto plan_node = px::carnot::plan::JoinOperator::FromProto(op_pb, 1);
+
+  RowDescriptor input_rd({DataType::INT64, DataType::FLOAT64});
+  RowDescriptor output_rd({DataType::FLOAT64, DataType::FLOAT64});
+  std::vector<RowBatch> build_batches;
+  std::vector<RowBatch> probe_batches;
+  MakeJoinInput(build_rows, skew, input_rd, &build_batches, &probe_batches);
+
+  for (auto _ : state) {
+    EquijoinNode node;
+    PX_CHECK_OK(node.Init(*plan_node, output_rd, {input_rd, input_rd}));
+    PX_CHECK_OK(node.Prepare(exec_state.get()));
+    PX_CHECK_OK(node.Open(exec_state.get()));
+    for (const auto& rb : build_batches) {
+      PX_CHECK_OK(node.ConsumeNext(exec_state.get(), rb, 0));
+    }
+    for (const auto& rb : probe_batches) {
+      PX_CHECK_OK(node.ConsumeNext(exec_state.get(), rb, 1));
+    }
+    PX_CHECK_OK(node.Close(exec_state.get()));
+  }
+  state.SetItemsProcessed(state.iterations() * (build_rows + kProbeRows));
+}
+
+static void JoinArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t build_rows : {10 * 1000, 1000 * 1000, 4 * 1000 * 1000}) {
+    for (int64_t skew : {0, 1}) {
+      for (int64_t radix : {0, 1}) {
+        b->Args({build_rows, skew, radix});
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_Equijoin)
+    ->ArgNames({"build_rows", "zipf_keys", "radix"})
+    ->Apply(JoinArgs)
+    ->Unit(benchmark::kMillisecond);
@@ -46,20 +46,24 @@ using udf::FunctionContext;
 // 3) non-time ordered full outer join (all batches from build first)
 // 4) non-time ordered no matches inner join
 // 5) non-time ordered many matches per key inner join
+// Each case runs with both the default and the radix partitioned build side.
 
-class JoinNodeTest : public ::testing::Test {
+class JoinNodeTest : public ::testing::TestWithParam<bool> {
  public:
   JoinNodeTest() {
+    FLAGS_carnot_radix_join = GetParam();
     func_registry_ = std::make_unique<udf::Registry>("test_registry");
     auto table_store = std::make_shared<table_store::TableStore>();
     exec_state_ = std::make_unique<ExecState>(func_registry_.get(), table_store,
                                               MockResultSinkStubGenerator, MockMetricsStubGenerator,
                                               MockTraceStubGenerator, sole::uuid4(), nullptr);
   }
+  ~JoinNodeTest() { FLAGS_carnot_radix_join = radix_join_flag_; }
 
  protected:
   std::unique_ptr<ExecState> exec_state_;
   std::unique_ptr<udf::Registry> func_registry_;
+  bool radix_join_flag_ = FLAGS_carnot_radix_join;
 };
 
 std::unique_ptr<plan::Operator> PlanNodeFromPbtxt(const std::string& pbtxt) {
@@ -70,7 +74,7 @@ std::unique_ptr<plan::Operator> PlanNodeFromPbtxt(const std::string& pbtxt) {
   return plan::JoinOperator::FromProto(op_pb, 1);
 }
 
-TEST_F(JoinNodeTest, ordered_inner_join) {
+TEST_P(JoinNodeTest, ordered_inner_join) {
   // time_ from right table, all batches from probe (right) first.
   // Left table input: [left_0:Int, left_1:Float]
   // Right table input: [time_:Time64Ns, right_1:Int]
@@ -151,7 +155,7 @@ TEST_F(JoinNodeTest, ordered_inner_join) {
       .Close();
 }
 
-TEST_F(JoinNodeTest, ordered_left_join) {
+TEST_P(JoinNodeTest, ordered_left_join) {
   // time_ from left (probe) table, batches interleaved
   // Left table input: [time_:Time64Ns, left_1:Int]
   // Right table input: [right_0:Int, right_1:Float]
@@ -238,7 +242,7 @@ TEST_F(JoinNodeTest, ordered_left_join) {
       .Close();
 }
 
-TEST_F(JoinNodeTest, unordered_full_outer_join) {
+TEST_P(JoinNodeTest, unordered_full_outer_join) {
   // All batches from build first
   // Left table input: [left_0:String, left_1:Int64]
   // Right table input: [right_0:Int64, right_1:String]
@@ -320,7 +324,7 @@ TEST_F(JoinNodeTest, unordered_full_outer_join) {
       .Close();
 }
 
-TEST_F(JoinNodeTest, unordered_no_left_columns) {
+TEST_P(JoinNodeTest, unordered_no_left_columns) {
   // All batches from build first
   // Left table input: [left_0:String, left_1:Int64]
   // Right table input: [right_0:Int64, right_1:String]
@@ -394,7 +398,7 @@ TEST_F(JoinNodeTest, unordered_no_left_columns) {
       .Close();
 }
 
-TEST_F(JoinNodeTest, unordered_no_right_columns) {
+TEST_P(JoinNodeTest, unordered_no_right_columns) {
   // All batches from build first
   // Left table input: [left_0:String, left_1:Int64]
   // Right table input: [right_0:Int64, right_1:String]
@@ -461,7 +465,7 @@ TEST_F(JoinNodeTest, unordered_no_right_columns) {
       .Close();
 }
 
-TEST_F(JoinNodeTest, unordered_no_matches) {
+TEST_P(JoinNodeTest, unordered_no_matches) {
   // Left table input: [left_0:String, left_1:Int64]
   // Right table input: [right_0:Int64, right_1:String]
   // Output table: [left_1:Int, right_1:String, right_0:Int64]
@@ -525,7 +529,7 @@ TEST_F(JoinNodeTest, unordered_no_matches) {
       .Close();
 }
 
-TEST_F(JoinNodeTest, zero_row_row_batch_right) {
+TEST_P(JoinNodeTest, zero_row_row_batch_right) {
   // Left table input: [left_0:String, left_1:Int64]
   // Right table input: [right_0:Int64, right_1:String]
   // Output table: [left_1:Int, right_1:String, right_0:Int64]
@@ -589,7 +593,7 @@ TEST_F(JoinNodeTest, zero_row_row_batch_right) {
       .Close();
 }
 
-TEST_F(JoinNodeTest, unordered_many_matches) {
+TEST_P(JoinNodeTest, unordered_many_matches) {
   // Left table input: [left_0:Time, left_1:Int64]
   // Right table input: [right_0:Int64, right_1:Time]
   // Output table: [left_1:Int, right_1(time):Time, right_0:Int64]
@@ -686,6 +690,8 @@ TEST_F(JoinNodeTest, unordered_many_matches) {
       .Close();
 }
 
+INSTANTIATE_TEST_SUITE_P(RadixJoin, JoinNodeTest, ::testing::Bool());
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -36,6 +36,8 @@
 #include "src/carnot/exec/memory_sink_node.h"
 #include "src/carnot/exec/memory_source_node.h"
 #include "src/carnot/exec/otel_export_sink_node.h"
+#include "src/carnot/exec/rolling_node.h"
+#include "src/carnot/exec/sort_node.h"
 #include "src/carnot/exec/udtf_source_node.h"
 #include "src/carnot/exec/union_node.h"
 #include "src/carnot/plan/operators.h"
@@ -52,13 +54,15 @@ using table_store::schema::RowDescriptor;
 Status ExecutionGraph::Init(table_store::schema::Schema* schema, plan::PlanState* plan_state,
                             ExecState* exec_state, plan::PlanFragment* pf,
                             bool collect_exec_node_stats,
-                            int32_t consecutive_generate_calls_per_source) {
+                            int32_t consecutive_generate_calls_per_source,
+                            int32_t exec_threads) {
   plan_state_ = plan_state;
   schema_ = schema;
   pf_ = pf;
   exec_state_ = exec_state;
   collect_exec_node_stats_ = collect_exec_node_stats;
   consecutive_generate_calls_per_source_ = consecutive_generate_calls_per_source;
+  exec_threads_ = exec_threads;
 
   std::unordered_map<int64_t, ExecNode*> nodes;
   std::unordered_map<int64_t, RowDescriptor> descriptors;
@@ -87,6 +91,12 @@ Status ExecutionGraph::Init(table_store::schema::Schema* schema, plan::PlanState
       .OnJoin([&](auto& node) {
         return OnOperatorImpl<plan::JoinOperator, EquijoinNode>(node, &descriptors);
       })
+      .OnRolling([&](auto& node) {
+        return OnOperatorImpl<plan::RollingOperator, RollingNode>(node, &descriptors);
+      })
+      .OnSort([&](auto& node) {
+        return OnOperatorImpl<plan::SortOperator, SortNode>(node, &descriptors);
+      })
       .OnGRPCSource([&](auto& node) {
         auto s = OnOperatorImpl<plan::GRPCSourceOperator, GRPCSourceNode>(node, &descriptors);
         PX_RETURN_IF_ERROR(s);
@@ -288,6 +298,74 @@ Status ExecutionGraph::ExecuteSources() {
   return Status::OK();
 }
 
+Status ExecutionGraph::CreateParallelPipelines() {
+  for (int64_t source_id : sources_) {
+    const auto* source_op = pf_->nodes().at(source_id).get();
+    if (source_op->op_type() != planpb::MEMORY_SOURCE_OPERATOR ||
+        static_cast<const plan::MemorySourceOperator*>(source_op)->streaming()) {
+      continue;
+    }
+
+    // Every node of the pipeline must be the only child of its parent, and vice versa, so that
+    // no other node sees the batches in a different order than it would with a single thread.
+    std::vector<int64_t> pipeline;
+    bool ends_in_blocking_agg = false;
+    int64_t node_id = source_id;
+    while (!ends_in_blocking_agg) {
+      auto children = pf_->dag().DependenciesOf(node_id);
+      if (children.size() != 1 || pf_->dag().ParentsOf(children[0]).size() != 1) {
+        break;
+      }
+      node_id = children[0];
+      const auto* op = pf_->nodes().at(node_id).get();
+      if (op->op_type() == planpb::AGGREGATE_OPERATOR) {
+        if (static_cast<const plan::AggregateOperator*>(op)->windowed()) {
+          break;
+        }
+        ends_in_blocking_agg = true;
+      } else if (op->op_type() != planpb::MAP_OPERATOR &&
+                 op->op_type() != planpb::FILTER_OPERATOR) {
+        break;
+      }
+      pipeline.push_back(node_id);
+    }
+    if (!ends_in_blocking_agg) {
+      continue;
+    }
+
+    std::vector<std::vector<ExecNode*>> replicas(exec_threads_);
+    for (auto& replica : replicas) {
+      for (int64_t id : pipeline) {
+        PX_ASSIGN_OR_RETURN(ExecNode * node, node_factories_.at(id)());
+        if (!replica.empty()) {
+          replica.back()->AddChild(node, 0);
+        }
+        replica.push_back(node);
+        replica_nodes_.emplace_back(id, node);
+      }
+      for (auto* node : replica) {
+        PX_RETURN_IF_ERROR(node->Prepare(exec_state_));
+        PX_RETURN_IF_ERROR(node->Open(exec_state_));
+      }
+    }
+    parallel_pipelines_.push_back(std::make_unique<ParallelPipeline>(
+        source_id, static_cast<MemorySourceNode*>(nodes_.at(source_id)),
+        static_cast<AggNode*>(nodes_.at(pipeline.back())), std::move(replicas)));
+  }
+  return Status::OK();
+}
+
+Status ExecutionGraph::ExecuteParallelPipelines() {
+  if (exec_threads_ <= 1) {
+    return Status::OK();
+  }
+  PX_RETURN_IF_ERROR(CreateParallelPipelines());
+  for (const auto& pipeline : parallel_pipelines_) {
+    PX_RETURN_IF_ERROR(pipeline->Execute(exec_state_));
+  }
+  return Status::OK();
+}
+
 /**
  * Execute the graph starting at all of the sources.
  * @return a status of whether execution succeeded.
@@ -309,9 +387,17 @@ Status ExecutionGraph::Execute() {
 
   // We don't PX_RETURN_IF_ERROR here because we want to make sure we close all of our
   // nodes, even if there was an error during execution.
-  Status source_status = ExecuteSources();
+  // The sources of the parallel pipelines have sent their end of stream once these are done, so
+  // ExecuteSources only runs the remaining sources.
+  Status source_status = ExecuteParallelPipelines();
+  if (source_status.ok()) {
+    source_status = ExecuteSources();
+  }
   Status close_status = Status::OK();
 
+  for (const auto& [id, replica] : replica_nodes_) {
+    nodes.push_back(replica);
+  }
   for (auto node : nodes) {
     auto s = node->Close(exec_state_);
     if (!s.ok()) {
@@ -323,6 +409,10 @@ Status ExecutionGraph::Execute() {
       close_status = s;
     }
   }
+  // This comes after Close, so that the extra info the copies add when closed is merged too.
+  for (const auto& [id, replica] : replica_nodes_) {
+    nodes_.at(id)->stats()->Merge(*replica->stats());
+  }
 
   if (!source_status.ok()) {
     return source_status;
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <condition_variable>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -32,6 +33,7 @@
 #include "src/carnot/exec/exec_node.h"
 #include "src/carnot/exec/exec_state.h"
 #include "src/carnot/exec/memory_source_node.h"
+#include "src/carnot/exec/parallel_pipeline.h"
 #include "src/carnot/plan/plan_fragment.h"
 #include "src/carnot/plan/plan_state.h"
 #include "src/common/base/base.h"
@@ -51,6 +53,7 @@ struct ExecutionStats {
 constexpr std::chrono::milliseconds kDefaultYieldTimeoutMS{1000};
 constexpr std::chrono::milliseconds kDefaultUpstreamResultConnectionTimeout{5000};
 constexpr int32_t kDefaultConsecutiveGenerateCallsPerSource = 10;
+constexpr int32_t kDefaultExecThreads = 1;
 using SystemTimePoint = std::chrono::time_point<std::chrono::system_clock>;
 
 /**
@@ -83,16 +86,25 @@ class ExecutionGraph {
    * @param collect_exec_node_stats Whether or not to collect exec node stats.
    * @param consecutive_generate_calls_per_source how many times in a row to call GenerateNext
    * before switching to another available source.
+   * @param exec_threads The number of threads used to run the pipelines that can be run in
+   * parallel (see ParallelPipeline). With 1, everything runs on the calling thread.
    * @return The status of whether initialization succeeded.
    */
   Status Init(table_store::schema::Schema* schema, plan::PlanState* plan_state,
               ExecState* exec_state, plan::PlanFragment* pf, bool collect_exec_node_stats,
-              int32_t consecutive_generate_calls_per_source);
+              int32_t consecutive_generate_calls_per_source, int32_t exec_threads);
+
+  Status Init(table_store::schema::Schema* schema, plan::PlanState* plan_state,
+              ExecState* exec_state, plan::PlanFragment* pf, bool collect_exec_node_stats,
+              int32_t consecutive_generate_calls_per_source) {
+    return Init(schema, plan_state, exec_state, pf, collect_exec_node_stats,
+                consecutive_generate_calls_per_source, kDefaultExecThreads);
+  }
 
   Status Init(table_store::schema::Schema* schema, plan::PlanState* plan_state,
               ExecState* exec_state, plan::PlanFragment* pf, bool collect_exec_node_stats) {
     return Init(schema, plan_state, exec_state, pf, collect_exec_node_stats,
-                kDefaultConsecutiveGenerateCallsPerSource);
+                kDefaultConsecutiveGenerateCallsPerSource, kDefaultExecThreads);
   }
 
   ~ExecutionGraph() {
@@ -195,6 +207,17 @@ class ExecutionGraph {
 
     AddNode(node.id(), execNode);
 
+    if (exec_threads_ > 1) {
+      // Keep a way to make more copies of the node, for the pipelines that run in parallel.
+      node_factories_[node.id()] = [this, node, output_descriptor,
+                                    input_descriptors]() -> StatusOr<ExecNode*> {
+        auto replica = pool_.Add(new TNode());
+        PX_RETURN_IF_ERROR(replica->Init(node, output_descriptor, input_descriptors,
+                                         collect_exec_node_stats_));
+        return replica;
+      };
+    }
+
     // Update parents' children.
     for (size_t i = 0; i < parents.size(); ++i) {
       auto parent = nodes_.find(parents[i]);
@@ -209,6 +232,14 @@ class ExecutionGraph {
 
   Status ExecuteSources();
 
+  /**
+   * Finds the pipelines that start at a non-streaming MemorySource, go through Map and Filter
+   * nodes only, and end at a blocking Agg, and creates a copy of their nodes for each thread.
+   */
+  Status CreateParallelPipelines();
+  // Runs each of the parallel pipelines to completion, before the rest of the sources run.
+  Status ExecuteParallelPipelines();
+
   ExecState* exec_state_;
   ObjectPool pool_{"exec_graph_pool"};
   table_store::schema::Schema* schema_;
@@ -234,6 +265,15 @@ class ExecutionGraph {
   // (Doesn't apply if there is only one active source.)
   int32_t consecutive_generate_calls_per_source_ = kDefaultConsecutiveGenerateCallsPerSource;
 
+  // How many threads the parallel pipelines use.
+  int32_t exec_threads_ = kDefaultExecThreads;
+  // Makes a new, initialized, copy of the node with the given id. Only set when exec_threads_ > 1.
+  std::unordered_map<int64_t, std::function<StatusOr<ExecNode*>()>> node_factories_;
+  std::vector<std::unique_ptr<ParallelPipeline>> parallel_pipelines_;
+  // The copies of the nodes made for the parallel pipelines, with the id of the node they copy.
+  // Their stats are merged into the stats of that node once the query is done.
+  std::vector<std::pair<int64_t, ExecNode*>> replica_nodes_;
+
   // Whether or not the graph should continue executing or wait for more work to do.
   bool continue_ = false;
   std::mutex execution_mutex_;
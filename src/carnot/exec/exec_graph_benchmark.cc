@@ -0,0 +1,146 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <google/protobuf/text_format.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <absl/strings/substitute.h>
+#include <sole.hpp>
+
+#include "src/carnot/exec/exec_graph.h"
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/plan/plan_fragment.h"
+#include "src/carnot/plan/plan_state.h"
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/carnot/planpb/test_proto.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/types.h"
+
+using px::carnot::exec::ExecutionGraph;
+using px::carnot::exec::MockMetricsStubGenerator;
+using px::carnot::exec::MockResultSinkStubGenerator;
+using px::carnot::exec::MockTraceStubGenerator;
+using px::table_store::Table;
+using px::table_store::schema::Relation;
+using px::table_store::schema::RowBatch;
+using px::table_store::schema::RowDescriptor;
+using px::types::DataType;
+
+namespace {
+
+constexpr int64_t kBatchSize = 1024;
+constexpr int64_t kNumRows = 4 * 1024 * 1024;
+constexpr int64_t kNumKeys = 1024;
+
+class SumUDA : public px::carnot::udf::UDA {
+ public:
+  void Update(px::carnot::udf::FunctionContext*, px::types::Int64Value arg) {
+    sum_ = sum_.val + arg.val;
+  }
+  void Merge(px::carnot::udf::FunctionContext*, const SumUDA& other) {
+    sum_ = sum_.val + other.sum_.val;
+  }
+  px::types::Int64Value Finalize(px::carnot::udf::FunctionContext*) { return sum_; }
+
+ protected:
+  px::types::Int64Value sum_ = 0;
+};
+
+std::shared_ptr<Table> MakeNumbersTable(const Relation& rel) {
+  auto table = Table::Create("numbers", rel);
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<int64_t> key_dist(0, kNumKeys - 1);
+  for (int64_t start = 0; start < kNumRows; start += kBatchSize) {
+    std::vector<px::types::Int64Value> keys;
+    std::vector<px::types::Int64Value> vals;
+    for (int64_t i = start; i < start + kBatchSize; ++i) {
+      keys.emplace_back(key_dist(rng));
+      vals.emplace_back(i);
+    }
+    RowBatch rb(RowDescriptor(rel.col_types()), kBatchSize);
+    PX_CHECK_OK(rb.AddColumn(px::types::ToArrow(keys, arrow::default_memory_pool())));
+    PX_CHECK_OK(rb.AddColumn(px::types::ToArrow(vals, arrow::default_memory_pool())));
+    PX_CHECK_OK(table->WriteRowBatch(rb));
+  }
+  return table;
+}
+
+}  // namespace
+
+// Source -> Map -> blocking Agg -> Sink over kNumRows rows, with state.range(0) exec threads.
+// state.range(1) picks the vectorized sum (1) or the UDA path (0) for the aggregate.
+// NOLINTNEXTLINE : runtime/references.
+void BM_ExecuteMapAgg(benchmark::State& state) {
+  int32_t exec_threads = state.range(0);
+  std::string uda_name = state.range(1) ? "sum" : "slow_sum";
+
+  auto func_registry = std::make_unique<px::carnot::udf::Registry>("test_registry");
+  func_registry->RegisterOrDie<SumUDA>("sum");
+  func_registry->RegisterOrDie<SumUDA>("slow_sum");
+
+  px::carnot::planpb::PlanFragment pf_pb;
+  CHECK(google::protobuf::TextFormat::MergeFromString(
+      absl::Substitute(px::carnot::planpb::testutils::kMapAggPlanFragmentTmpl, uda_name),
+      &pf_pb));
+  px::carnot::plan::PlanFragment plan_fragment(1);
+  PX_CHECK_OK(plan_fragment.Init(pf_pb));
+
+  Relation rel({DataType::INT64, DataType::INT64}, {"key", "val"});
+  auto table = MakeNumbersTable(rel);
+
+  for (auto _ : state) {
+    auto table_store = std::make_shared<px::table_store::TableStore>();
+    table_store->AddTable("numbers", table);
+    auto exec_state = std::make_unique<px::carnot::exec::ExecState>(
+        func_registry.get(), table_store, MockResultSinkStubGenerator, MockMetricsStubGenerator,
+        MockTraceStubGenerator, sole::uuid4(), nullptr);
+    PX_CHECK_OK(exec_state->AddUDA(0, uda_name, {DataType::INT64}));
+    auto plan_state = std::make_unique<px::carnot::plan::PlanState>(func_registry.get());
+    px::table_store::schema::Schema schema;
+    schema.AddRelation(1, rel);
+
+    ExecutionGraph exec_graph;
+    PX_CHECK_OK(exec_graph.Init(&schema, plan_state.get(), exec_state.get(), &plan_fragment,
+                                /* collect_exec_node_stats */ false,
+                                px::carnot::exec::kDefaultConsecutiveGenerateCallsPerSource,
+                                exec_threads));
+    PX_CHECK_OK(exec_graph.Execute());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+static void MapAggArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t vectorized : {0, 1}) {
+    for (int64_t threads : {1, 2, 4, 8, 16}) {
+      b->Args({threads, vectorized});
+    }
+  }
+}
+
+BENCHMARK(BM_ExecuteMapAgg)
+    ->ArgNames({"threads", "vectorized"})
+    ->Apply(MapAggArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
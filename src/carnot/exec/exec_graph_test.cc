@@ -20,6 +20,7 @@
 
 #include <arrow/array.h>
 #include <arrow/memory_pool.h>
+#include <map>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -208,6 +209,91 @@ std::vector<std::tuple<int32_t>> calls_to_execute = {
 INSTANTIATE_TEST_SUITE_P(ExecGraphExecuteTestSuite, ExecGraphExecuteTest,
                          ::testing::ValuesIn(calls_to_execute));
 
+class SumUDA : public udf::UDA {
+ public:
+  void Update(udf::FunctionContext*, types::Int64Value arg) { sum_ = sum_.val + arg.val; }
+  void Merge(udf::FunctionContext*, const SumUDA& other) { sum_ = sum_.val + other.sum_.val; }
+  types::Int64Value Finalize(udf::FunctionContext*) { return sum_; }
+
+ protected:
+  types::Int64Value sum_ = 0;
+};
+
+// Runs kMapAggPlanFragmentTmpl with the given number of exec threads, and with a UDA name that
+// either has a vectorized implementation ("sum") or only goes through the UDA ("slow_sum").
+class ParallelExecGraphTest
+    : public BaseExecGraphTest,
+      public ::testing::WithParamInterface<std::tuple<int32_t, std::string>> {};
+
+TEST_P(ParallelExecGraphTest, map_agg) {
+  auto [exec_threads, uda_name] = GetParam();
+  SetUpExecState();
+  func_registry_->RegisterOrDie<SumUDA>("sum");
+  func_registry_->RegisterOrDie<SumUDA>("slow_sum");
+
+  planpb::PlanFragment pf_pb;
+  ASSERT_TRUE(TextFormat::MergeFromString(
+      absl::Substitute(planpb::testutils::kMapAggPlanFragmentTmpl, uda_name), &pf_pb));
+  ASSERT_OK(plan_fragment_->Init(pf_pb));
+  auto plan_state = std::make_unique<plan::PlanState>(func_registry_.get());
+
+  table_store::schema::Relation rel({types::DataType::INT64, types::DataType::INT64},
+                                    {"key", "val"});
+  auto schema = std::make_shared<table_store::schema::Schema>();
+  schema->AddRelation(1, rel);
+  auto table = Table::Create("numbers", rel);
+
+  constexpr int64_t kNumBatches = 32;
+  constexpr int64_t kBatchSize = 100;
+  constexpr int64_t kNumKeys = 7;
+  std::map<int64_t, int64_t> expected;
+  for (int64_t batch = 0; batch < kNumBatches; ++batch) {
+    std::vector<types::Int64Value> keys;
+    std::vector<types::Int64Value> vals;
+    for (int64_t i = batch * kBatchSize; i < (batch + 1) * kBatchSize; ++i) {
+      keys.push_back(i % kNumKeys);
+      vals.push_back(i);
+      expected[i % kNumKeys] += i;
+    }
+    auto rb = RowBatch(RowDescriptor(rel.col_types()), kBatchSize);
+    EXPECT_OK(rb.AddColumn(types::ToArrow(keys, arrow::default_memory_pool())));
+    EXPECT_OK(rb.AddColumn(types::ToArrow(vals, arrow::default_memory_pool())));
+    EXPECT_OK(table->WriteRowBatch(rb));
+  }
+  exec_state_->table_store()->AddTable("numbers", table);
+  EXPECT_OK(exec_state_->AddUDA(0, uda_name, {types::DataType::INT64}));
+
+  ExecutionGraph e;
+  ASSERT_OK(e.Init(schema.get(), plan_state.get(), exec_state_.get(), plan_fragment_.get(),
+                   /* collect_exec_node_stats */ true, kDefaultConsecutiveGenerateCallsPerSource,
+                   exec_threads));
+  ASSERT_OK(e.Execute());
+
+  // The stats of the copies of the map and agg nodes are merged into the original nodes.
+  for (int64_t node_id : {2, 3}) {
+    ASSERT_OK_AND_ASSIGN(ExecNode * node, e.node(node_id));
+    EXPECT_EQ(kNumBatches * kBatchSize, node->stats()->rows_input);
+  }
+
+  std::map<int64_t, int64_t> actual;
+  table_store::Table::Cursor cursor(exec_state_->table_store()->GetTable("output"));
+  while (!cursor.Done()) {
+    auto rb = cursor.GetNextRowBatch({0, 1}).ConsumeValueOrDie();
+    for (int64_t i = 0; i < rb->num_rows(); ++i) {
+      auto key = types::GetValueFromArrowArray<types::DataType::INT64>(rb->ColumnAt(0).get(), i);
+      auto sum = types::GetValueFromArrowArray<types::DataType::INT64>(rb->ColumnAt(1).get(), i);
+      EXPECT_EQ(0, actual.count(key));
+      actual[key] = sum;
+    }
+  }
+  EXPECT_EQ(expected, actual);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ParallelExecGraphTestSuite, ParallelExecGraphTest,
+    ::testing::Combine(::testing::Values(1, 2, 4),
+                       ::testing::Values(std::string("sum"), std::string("slow_sum"))));
+
 TEST_F(ExecGraphTest, execute_time) {
   planpb::PlanFragment pf_pb;
   ASSERT_TRUE(TextFormat::MergeFromString(planpb::testutils::kLinearPlanFragment, &pf_pb));
@@ -99,8 +99,36 @@ struct ExecNodeStats {
     extra_info[key] = value;
   }
 
-  int64_t ChildExecTime() const { return children_timer.ElapsedTime_us() * 1000; }
-  int64_t TotalExecTime() const { return total_timer.ElapsedTime_us() * 1000; }
+  /**
+   * Adds the stats of a copy of this node that ran on another thread (see ParallelPipeline). The
+   * times add up to the time spent in the node across all the threads.
+   */
+  void Merge(const ExecNodeStats& other) {
+    if (!collect_exec_stats) {
+      return;
+    }
+    bytes_input += other.bytes_input;
+    rows_input += other.rows_input;
+    batches_input += other.batches_input;
+    bytes_output += other.bytes_output;
+    rows_output += other.rows_output;
+    batches_output += other.batches_output;
+    merged_total_time_ns += other.TotalExecTime();
+    merged_children_time_ns += other.ChildExecTime();
+    for (const auto& [key, value] : other.extra_metrics) {
+      extra_metrics[key] += value;
+    }
+    for (const auto& [key, value] : other.extra_info) {
+      extra_info.try_emplace(key, value);
+    }
+  }
+
+  int64_t ChildExecTime() const {
+    return children_timer.ElapsedTime_us() * 1000 + merged_children_time_ns;
+  }
+  int64_t TotalExecTime() const {
+    return total_timer.ElapsedTime_us() * 1000 + merged_total_time_ns;
+  }
   int64_t SelfExecTime() const { return TotalExecTime() - ChildExecTime(); }
 
   // Total bytes input to this exec node.
@@ -119,6 +147,9 @@ struct ExecNodeStats {
   ElapsedTimer total_timer;
   // Total timer for the children of the ndoe.
   ElapsedTimer children_timer;
+  // The times of the copies of the node that were merged into these stats.
+  int64_t merged_total_time_ns = 0;
+  int64_t merged_children_time_ns = 0;
   // Flag to determine whether to collect stats or not.
   bool collect_exec_stats;
 
@@ -204,7 +235,9 @@ class ExecNode {
    * Consume the next row batch. This function is only valid for Sink and Processing
    * Nodes.
    *
-   * This needs to be careful to forward the output batch to all children.
+   * This needs to be careful to forward the output batch to all children. Row batches with a
+   * selection vector are compacted first, unless the node consumes selections (see
+   * ConsumesSelections()).
    *
    * @param exec_state The execution state.
    * @param rb The input row batch.
@@ -218,6 +251,10 @@ class ExecNode {
       return error::Internal(
           "ConsumeNext received row batch with end of stream set but not end of window.");
     }
+    if (rb.has_selection() && !ConsumesSelections()) {
+      PX_ASSIGN_OR_RETURN(auto compacted_rb, rb.Compact(exec_state->exec_mem_pool()));
+      return ConsumeNext(exec_state, *compacted_rb, parent_index);
+    }
     stats_->AddInputStats(rb);
     stats_->ResumeTotalTimer();
     PX_RETURN_IF_ERROR(ConsumeNextImpl(exec_state, rb, parent_index));
@@ -313,6 +350,10 @@ class ExecNode {
   virtual Status ConsumeNextImpl(ExecState*, const table_store::schema::RowBatch&, size_t) {
     return error::Unimplemented("Implement in derived class (if sink or processing)");
   }
+
+  // Whether ConsumeNextImpl handles row batches with a selection vector. Nodes that don't only
+  // see compacted row batches, which is what keeps selections from crossing sinks.
+  virtual bool ConsumesSelections() const { return false; }
   bool is_closed() { return is_closed_; }
 
   std::unique_ptr<table_store::schema::RowDescriptor> output_descriptor_;
@@ -31,6 +31,7 @@
 #include "src/carnot/carnotpb/carnot.pb.h"
 #include "src/carnot/exec/exec_metrics.h"
 #include "src/carnot/exec/grpc_router.h"
+#include "src/carnot/planpb/plan.pb.h"
 #include "src/carnot/udf/model_pool.h"
 #include "src/carnot/udf/registry.h"
 #include "src/common/base/base.h"
@@ -158,13 +159,21 @@ class ExecState {
     return raw;
   }
 
-  udf::ScalarUDFDefinition* GetScalarUDFDefinition(int64_t id) { return id_to_scalar_udf_map_[id]; }
+  // The lookups don't modify the maps, so that the copies of a ParallelPipeline can call them from
+  // several threads at once.
+  udf::ScalarUDFDefinition* GetScalarUDFDefinition(int64_t id) const {
+    auto it = id_to_scalar_udf_map_.find(id);
+    return it == id_to_scalar_udf_map_.end() ? nullptr : it->second;
+  }
 
   std::map<int64_t, udf::ScalarUDFDefinition*> id_to_scalar_udf_map() {
     return id_to_scalar_udf_map_;
   }
 
-  udf::UDADefinition* GetUDADefinition(int64_t id) { return id_to_uda_map_[id]; }
+  udf::UDADefinition* GetUDADefinition(int64_t id) const {
+    auto it = id_to_uda_map_.find(id);
+    return it == id_to_uda_map_.end() ? nullptr : it->second;
+  }
 
   std::unique_ptr<udf::FunctionContext> CreateFunctionContext() {
     auto ctx = std::make_unique<udf::FunctionContext>(metadata_state_, model_pool_);
@@ -195,6 +204,14 @@ class ExecState {
 
   GRPCRouter* grpc_router() { return grpc_router_; }
 
+  // How the GRPC sinks of the query encode the row batches they send to other Carnot instances.
+  planpb::RowBatchEncoding row_batch_encoding() const { return row_batch_encoding_; }
+  bool compress_row_batches() const { return compress_row_batches_; }
+  void set_row_batch_encoding(planpb::RowBatchEncoding encoding, bool compress) {
+    row_batch_encoding_ = encoding;
+    compress_row_batches_ = compress;
+  }
+
   void AddAuthToGRPCClientContext(grpc::ClientContext* ctx) {
     CHECK(add_auth_to_grpc_client_context_func_);
     add_auth_to_grpc_client_context_func_(ctx);
@@ -206,6 +223,8 @@ class ExecState {
   udf::Registry* func_registry_;
   std::shared_ptr<table_store::TableStore> table_store_;
   std::shared_ptr<const md::AgentMetadataState> metadata_state_;
+  planpb::RowBatchEncoding row_batch_encoding_ = planpb::ROW_BATCH_ENCODING_PROTO;
+  bool compress_row_batches_ = false;
   const ResultSinkStubGenerator stub_generator_;
   const MetricsStubGenerator metrics_stub_generator_;
   const TraceStubGenerator trace_stub_generator_;
@@ -37,6 +37,10 @@
 #include "src/shared/types/types.h"
 #include "src/shared/types/typespb/wrapper/types_pb_wrapper.h"
 
+DEFINE_bool(carnot_udf_exec_batch, gflags::BoolFromEnv("PL_CARNOT_UDF_EXEC_BATCH", true),
+            "Evaluate scalar UDFs that implement ExecBatch a batch at a time, instead of calling "
+            "Exec for every record.");
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -194,7 +198,7 @@ VectorNativeScalarExpressionEvaluator::EvaluateSingleExpression(
   CHECK(exec_state != nullptr);
   CHECK_GT(input.num_columns(), 0);
 
-  size_t num_rows = input.num_rows();
+  size_t num_rows = input.num_column_rows();
 
   // Path for scalar funcs an their dependencies to get evaluated.
   // The Arrow arrays are converted to type erased column wrappers
@@ -233,7 +237,12 @@ VectorNativeScalarExpressionEvaluator::EvaluateSingleExpression(
         }
         auto output = types::ColumnWrapper::Make(def->exec_return_type(), num_rows);
         // TODO(zasgar): need a better way to handle errors.
-        PX_CHECK_OK(def->ExecBatch(udf, function_ctx_, raw_children, output.get(), num_rows));
+        if (FLAGS_carnot_udf_exec_batch && def->has_exec_udf_batch()) {
+          PX_CHECK_OK(
+              def->ExecUDFBatch(udf, function_ctx_, raw_children, output.get(), num_rows));
+        } else {
+          PX_CHECK_OK(def->ExecBatch(udf, function_ctx_, raw_children, output.get(), num_rows));
+        }
         return output;
       });
 
@@ -247,7 +256,7 @@ Status VectorNativeScalarExpressionEvaluator::EvaluateSingleExpression(
   CHECK(output != nullptr);
   CHECK_GT(input.num_columns(), 0);
 
-  size_t num_rows = input.num_rows();
+  size_t num_rows = input.num_column_rows();
 
   // Since this evaluator uses vectors internally and the inputs/outputs
   // always have to be arrow::arrays, we just evaluate the case where the
@@ -292,7 +301,7 @@ Status ArrowNativeScalarExpressionEvaluator::Close(ExecState*) {
 Status exec::ArrowNativeScalarExpressionEvaluator::EvaluateSingleExpression(
     exec::ExecState* exec_state, const RowBatch& input, const plan::ScalarExpression& expr,
     RowBatch* output) {
-  size_t num_rows = input.num_rows();
+  size_t num_rows = input.num_column_rows();
   plan::ExpressionWalker<std::shared_ptr<arrow::Array>> walker;
   walker.OnScalarValue(
       [&](const plan::ScalarValue& val, const std::vector<std::shared_ptr<arrow::Array>>& children)
@@ -34,6 +34,8 @@
 #include "src/shared/types/column_wrapper.h"
 #include "src/table_store/table_store.h"
 
+DECLARE_bool(carnot_udf_exec_batch);
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -67,11 +67,20 @@ using px::types::ToArrow;
 class AddUDF : public ScalarUDF {
  public:
   Int64Value Exec(FunctionContext*, Int64Value v1, Int64Value v2) { return v1.val + v2.val; }
+  void ExecBatch(FunctionContext*, size_t count, const Int64Value* v1, const Int64Value* v2,
+                 Int64Value* out) {
+    px::carnot::udf::BinaryBatch<int64_t>(count, v1, v2, out,
+                                          [](auto x, auto y) { return x + y; });
+  }
 };
 
+// exec_batch picks whether the vector native evaluator calls AddUDF::ExecBatch once per batch, or
+// AddUDF::Exec for every record.
 // NOLINTNEXTLINE : runtime/references.
 void BM_ScalarExpressionTwoCols(benchmark::State& state,
-                                const ScalarExpressionEvaluatorType& eval_type, const char* pbtxt) {
+                                const ScalarExpressionEvaluatorType& eval_type, const char* pbtxt,
+                                bool exec_batch = true) {
+  FLAGS_carnot_udf_exec_batch = exec_batch;
   px::carnot::planpb::ScalarExpression se_pb;
   size_t data_size = state.range(0);
 
@@ -149,3 +158,18 @@ BENCHMARK_CAPTURE(BM_ScalarExpressionTwoCols, two_cols_simple_add_vector,
                   ScalarExpressionEvaluatorType::kVectorNative, kAddScalarFuncNestedPbtxt)
     ->RangeMultiplier(2)
     ->Range(1, 1 << 16);
+BENCHMARK_CAPTURE(BM_ScalarExpressionTwoCols, two_cols_add_nested_native_per_record,
+                  ScalarExpressionEvaluatorType::kVectorNative, kAddScalarFuncNestedPbtxt,
+                  /* exec_batch */ false)
+    ->RangeMultiplier(2)
+    ->Range(1, 1 << 16);
+BENCHMARK_CAPTURE(BM_ScalarExpressionTwoCols, two_cols_simple_add_native_per_record,
+                  ScalarExpressionEvaluatorType::kVectorNative, kAddScalarFuncPbtxt,
+                  /* exec_batch */ false)
+    ->RangeMultiplier(2)
+    ->Range(1, 1 << 16);
+BENCHMARK_CAPTURE(BM_ScalarExpressionTwoCols, two_cols_simple_add_native_exec_batch,
+                  ScalarExpressionEvaluatorType::kVectorNative, kAddScalarFuncPbtxt,
+                  /* exec_batch */ true)
+    ->RangeMultiplier(2)
+    ->Range(1, 1 << 16);
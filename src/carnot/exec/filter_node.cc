@@ -39,6 +39,11 @@
 #include "src/shared/types/types.h"
 #include "src/shared/types/typespb/wrapper/types_pb_wrapper.h"
 
+DEFINE_bool(carnot_filter_selection_vectors,
+            gflags::BoolFromEnv("PL_CARNOT_FILTER_SELECTION_VECTORS", true),
+            "Pass the rows that survive a filter downstream as a selection vector over the input "
+            "columns, instead of copying them into new columns.");
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -75,63 +80,17 @@ Status FilterNode::CloseImpl(ExecState* exec_state) {
   return Status::OK();
 }
 
-template <types::DataType T>
-Status PredicateCopyValues(const types::BoolValueColumnWrapper& pred, const arrow::Array* input_col,
-                           RowBatch* output_rb) {
-  DCHECK_EQ(pred.Size(), static_cast<size_t>(input_col->length()));
-  size_t num_output_records = output_rb->num_rows();
-  size_t num_input_records = input_col->length();
-  auto output_col_builder_generic = MakeArrowBuilder(T, arrow::default_memory_pool());
-  auto* output_col_builder = static_cast<typename types::DataTypeTraits<T>::arrow_builder_type*>(
-      output_col_builder_generic.get());
-  PX_RETURN_IF_ERROR(output_col_builder->Reserve(num_output_records));
-  for (size_t idx = 0; idx < num_input_records; ++idx) {
-    if (udf::UnWrap(pred[idx])) {
-      output_col_builder->UnsafeAppend(types::GetValueFromArrowArray<T>(input_col, idx));
-    }
-  }
-  std::shared_ptr<arrow::Array> output_array;
-  PX_RETURN_IF_ERROR(output_col_builder->Finish(&output_array));
-  PX_RETURN_IF_ERROR(output_rb->AddColumn(output_array));
-  return Status::OK();
-}
-
-template <>
-Status PredicateCopyValues<types::STRING>(const types::BoolValueColumnWrapper& pred,
-                                          const arrow::Array* input_col, RowBatch* output_rb) {
-  DCHECK_EQ(pred.Size(), static_cast<size_t>(input_col->length()));
-  size_t num_output_records = output_rb->num_rows();
-  size_t num_input_records = input_col->length();
-  size_t reserved =
-      100;  // This can be an arbritrary number, since we do exponential doubling below.
-  size_t total_size = 0;
-
-  auto output_col_builder_generic = MakeArrowBuilder(types::STRING, arrow::default_memory_pool());
-  auto* output_col_builder = static_cast<types::DataTypeTraits<types::STRING>::arrow_builder_type*>(
-      output_col_builder_generic.get());
-
-  PX_RETURN_IF_ERROR(output_col_builder->Reserve(num_output_records));
-  PX_RETURN_IF_ERROR(output_col_builder->ReserveData(reserved));
-  for (size_t idx = 0; idx < num_input_records; ++idx) {
-    if (udf::UnWrap(pred[idx])) {
-      auto res = types::GetValueFromArrowArray<types::STRING>(input_col, idx);
-      total_size += res.size();
-      while (total_size >= reserved) {
-        reserved *= 2;
-      }
-      PX_RETURN_IF_ERROR(output_col_builder->ReserveData(reserved));
-      output_col_builder->UnsafeAppend(std::move(res));
-    }
+Status FilterNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
+  // A predicate that calls functions only runs on the rows that previous filters kept, since the
+  // rows they dropped can hold values the functions can't take.
+  if (rb.has_selection() &&
+      plan_node_->expression()->ExpressionType() == plan::Expression::kFunc) {
+    PX_ASSIGN_OR_RETURN(auto compacted_rb, rb.Compact(exec_state->exec_mem_pool()));
+    return ConsumeNextImpl(exec_state, *compacted_rb, 0);
   }
-  std::shared_ptr<arrow::Array> output_array;
-  PX_RETURN_IF_ERROR(output_col_builder->Finish(&output_array));
-  PX_RETURN_IF_ERROR(output_rb->AddColumn(output_array));
-  return Status::OK();
-}
 
-Status FilterNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
-  // Current implementation does not merge across row batches, we should
-  // consider this for cases where the filter has really low selectivity.
+  // Otherwise the predicate is a column, which is read over the whole columns of the row batch. The
+  // rows that were already dropped are skipped when the selection is computed.
   PX_ASSIGN_OR_RETURN(auto pred_col, evaluator_->EvaluateSingleExpression(
                                          exec_state, rb, *plan_node_->expression()));
 
@@ -140,32 +99,40 @@ Status FilterNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, si
 
   const types::BoolValueColumnWrapper& pred_col_wrapper =
       *static_cast<types::BoolValueColumnWrapper*>(pred_col.get());
-  size_t num_pred = pred_col_wrapper.Size();
-
-  DCHECK_EQ(static_cast<size_t>(rb.num_rows()), num_pred);
-
-  // Find out how many of them returned true;
-  size_t num_output_records = 0;
-  for (size_t i = 0; i < num_pred; ++i) {
-    if (pred_col_wrapper[i].val) {
-      ++num_output_records;
+  DCHECK_EQ(static_cast<size_t>(rb.num_column_rows()), pred_col_wrapper.Size());
+
+  // Intersect the predicate with the selection of the input.
+  auto selection = std::make_shared<std::vector<int64_t>>();
+  selection->reserve(rb.num_rows());
+  if (rb.has_selection()) {
+    for (int64_t idx : *rb.selection()) {
+      if (pred_col_wrapper[idx].val) {
+        selection->push_back(idx);
+      }
+    }
+  } else {
+    for (int64_t idx = 0; idx < rb.num_column_rows(); ++idx) {
+      if (pred_col_wrapper[idx].val) {
+        selection->push_back(idx);
+      }
     }
   }
 
-  RowBatch output_rb(*output_descriptor_, num_output_records);
+  RowBatch output_rb(*output_descriptor_, rb.num_column_rows());
   DCHECK_EQ(output_descriptor_->size(), plan_node_->selected_cols().size());
-
-  for (const auto& [output_col_idx, input_col_idx] : Enumerate(plan_node_->selected_cols())) {
-    auto input_col = rb.ColumnAt(input_col_idx);
-    auto col_type = output_descriptor_->type(output_col_idx);
-#define TYPE_CASE(_dt_) \
-  PX_RETURN_IF_ERROR(PredicateCopyValues<_dt_>(pred_col_wrapper, input_col.get(), &output_rb));
-    PX_SWITCH_FOREACH_DATATYPE(col_type, TYPE_CASE);
-#undef TYPE_CASE
+  for (int64_t input_col_idx : plan_node_->selected_cols()) {
+    PX_RETURN_IF_ERROR(output_rb.AddColumn(rb.ColumnAt(input_col_idx)));
   }
-
   output_rb.set_eow(rb.eow());
   output_rb.set_eos(rb.eos());
+  if (static_cast<int64_t>(selection->size()) != rb.num_column_rows()) {
+    PX_RETURN_IF_ERROR(output_rb.SetSelection(std::move(selection)));
+  }
+
+  if (!FLAGS_carnot_filter_selection_vectors) {
+    PX_ASSIGN_OR_RETURN(auto compacted_rb, output_rb.Compact(exec_state->exec_mem_pool()));
+    return SendRowBatchToChildren(exec_state, *compacted_rb);
+  }
   PX_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, output_rb));
   return Status::OK();
 }
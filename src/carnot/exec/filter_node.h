@@ -32,6 +32,8 @@
 #include "src/common/base/status.h"
 #include "src/table_store/table_store.h"
 
+DECLARE_bool(carnot_filter_selection_vectors);
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -49,6 +51,7 @@ class FilterNode : public ProcessingNode {
   Status CloseImpl(ExecState* exec_state) override;
   Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
                          size_t parent_index) override;
+  bool ConsumesSelections() const override { return FLAGS_carnot_filter_selection_vectors; }
 
  private:
   std::unique_ptr<VectorNativeScalarExpressionEvaluator> evaluator_;
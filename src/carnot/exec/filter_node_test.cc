@@ -187,6 +187,35 @@ TEST_F(FilterNodeTest, zero_row_row_batch) {
       .Close();
 }
 
+TEST_F(FilterNodeTest, input_selection) {
+  auto op_proto = planpb::testutils::CreateTestFilterTwoCols();
+  plan_node_ = plan::FilterOperator::FromProto(op_proto, /*id*/ 1);
+
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64, types::DataType::STRING});
+  RowDescriptor output_rd(
+      {types::DataType::INT64, types::DataType::INT64, types::DataType::STRING});
+
+  // A row batch that already went through a filter which dropped the first row.
+  auto input_rb = RowBatchBuilder(input_rd, 4, /*eow*/ true, /*eos*/ true)
+                      .AddColumn<types::Int64Value>({1, 1, 3, 1})
+                      .AddColumn<types::Int64Value>({1, 3, 6, 9})
+                      .AddColumn<types::StringValue>({"ABC", "DEF", "HELLO", "WORLD"})
+                      .get();
+  ASSERT_OK(input_rb.SetSelection(
+      std::make_shared<const std::vector<int64_t>>(std::vector<int64_t>{1, 2, 3})));
+
+  auto tester = exec::ExecNodeTester<FilterNode, plan::FilterOperator>(
+      *plan_node_, output_rd, {input_rd}, exec_state_.get());
+  // The mock child doesn't consume selections, so it gets the compacted row batch.
+  tester.ConsumeNext(input_rb, 0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, true, true)
+                          .AddColumn<types::Int64Value>({1, 1})
+                          .AddColumn<types::Int64Value>({3, 9})
+                          .AddColumn<types::StringValue>({"DEF", "WORLD"})
+                          .get())
+      .Close();
+}
+
 TEST_F(FilterNodeTest, string_pred) {
   auto op_proto = planpb::testutils::CreateTestFilterTwoColsString();
   plan_node_ = plan::FilterOperator::FromProto(op_proto, /*id*/ 1);
@@ -46,6 +46,13 @@ namespace exec {
 // Forward declaration needed to break circular dependency.
 class GRPCSourceNode;
 
+// Returns whether the request holds a row batch, in either of the row batch encodings.
+inline bool HasRowBatch(const carnotpb::TransferResultChunkRequest& req) {
+  return req.has_query_result() &&
+         req.query_result().result_contents_case() !=
+             carnotpb::TransferResultChunkRequest::SinkResult::RESULT_CONTENTS_NOT_SET;
+}
+
 /**
  * GRPCRouter tracks incoming Kelvin connections and routes them to the appropriate Carnot source
  * node.
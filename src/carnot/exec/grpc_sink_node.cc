@@ -19,16 +19,22 @@
 #include "src/carnot/exec/grpc_sink_node.h"
 
 #include <chrono>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <absl/numeric/int128.h>
 #include <absl/strings/substitute.h>
+#include <farmhash.h>
 
 #include "src/carnot/carnotpb/carnot.pb.h"
 #include "src/carnot/planpb/plan.pb.h"
+#include "src/common/base/hash_utils.h"
 #include "src/common/base/macros.h"
 #include "src/common/uuid/uuid_utils.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/type_utils.h"
 #include "src/table_store/table_store.h"
 
 namespace px {
@@ -38,27 +44,67 @@ namespace exec {
 using table_store::schema::RowBatch;
 using table_store::schema::RowDescriptor;
 
+namespace {
+
+// Differs from the seed of the aggregate hash tables, so that the rows a Kelvin receives don't all
+// land in a fraction of the slots of its hash tables.
+constexpr uint64_t kPartitionHashSeed = 0xc3a5c85c97cb3127ULL;
+
+inline uint64_t HashValue(bool val) { return static_cast<uint64_t>(val); }
+inline uint64_t HashValue(int64_t val) { return static_cast<uint64_t>(val); }
+inline uint64_t HashValue(double val) {
+  uint64_t bits;
+  std::memcpy(&bits, &val, sizeof(bits));
+  return bits;
+}
+inline uint64_t HashValue(absl::uint128 val) {
+  return HashCombine(absl::Uint128Low64(val), absl::Uint128High64(val));
+}
+
+// The hash must not depend on the process, since every PEM has to send a given key to the same
+// Kelvin.
+template <types::DataType DT>
+void HashColumn(const arrow::Array* arr, uint64_t* hashes) {
+  int64_t num_rows = arr->length();
+  if constexpr (DT == types::STRING) {
+    for (int64_t i = 0; i < num_rows; ++i) {
+      auto val = types::GetStringViewFromArrowArray(arr, i);
+      hashes[i] = HashCombine(hashes[i], ::util::Fingerprint64(val.data(), val.size()));
+    }
+  } else {
+    auto typed_arr = static_cast<const typename types::DataTypeTraits<DT>::arrow_array_type*>(arr);
+    for (int64_t i = 0; i < num_rows; ++i) {
+      typename types::DataTypeTraits<DT>::value_type val = typed_arr->Value(i);
+      hashes[i] = HashCombine(hashes[i], HashValue(val.val));
+    }
+  }
+}
+
+}  // namespace
+
 std::string GRPCSinkNode::DebugStringImpl() {
   std::string destination;
   if (plan_node_->has_table_name()) {
     destination = absl::Substitute("table_name: $0", plan_node_->table_name());
   } else if (plan_node_->has_grpc_source_id()) {
     destination = absl::Substitute("source_id: $0", plan_node_->grpc_source_id());
+  } else if (plan_node_->has_partitions()) {
+    destination = absl::Substitute("partitions: $0", plan_node_->partitions().size());
   }
   return absl::Substitute("Exec::GRPCSinkNode: {address: $0, $1, output: $2}",
                           plan_node_->address(), destination, input_descriptor_->DebugString());
 }
 
-StatusOr<carnotpb::TransferResultChunkRequest> RequestWithMetadata(
-    plan::GRPCSinkOperator* plan_node, ExecState* exec_state) {
+StatusOr<carnotpb::TransferResultChunkRequest> GRPCSinkNode::RequestWithMetadata(
+    const Destination& dest, ExecState* exec_state) {
   carnotpb::TransferResultChunkRequest req;
   // Set the metadata for the RowBatch (where it should go).
-  req.set_address(plan_node->address());
+  req.set_address(dest.address);
 
-  if (plan_node->has_grpc_source_id()) {
-    req.mutable_query_result()->set_grpc_source_id(plan_node->grpc_source_id());
-  } else if (plan_node->has_table_name()) {
-    req.mutable_query_result()->set_table_name(plan_node->table_name());
+  if (plan_node_->has_grpc_source_id() || plan_node_->has_partitions()) {
+    req.mutable_query_result()->set_grpc_source_id(dest.grpc_source_id);
+  } else if (plan_node_->has_table_name()) {
+    req.mutable_query_result()->set_table_name(plan_node_->table_name());
   } else {
     return error::Internal("GRPCSink has neither source ID nor table name set.");
   }
@@ -73,19 +119,21 @@ Status GRPCSinkNode::OptionallyCheckConnection(ExecState* exec_state) {
   }
 
   auto time_now = std::chrono::system_clock::now();
-  auto since_last_flush =
-      std::chrono::duration_cast<std::chrono::milliseconds>(time_now - last_send_time_);
-  bool recheck_connection = since_last_flush > connection_check_timeout_;
-  if (!recheck_connection) {
-    return Status::OK();
-  }
+  for (auto& dest : destinations_) {
+    auto since_last_flush =
+        std::chrono::duration_cast<std::chrono::milliseconds>(time_now - dest.last_send_time);
+    bool recheck_connection = since_last_flush > connection_check_timeout_;
+    if (!recheck_connection) {
+      continue;
+    }
 
-  PX_ASSIGN_OR_RETURN(auto req, RequestWithMetadata(plan_node_.get(), exec_state));
-  PX_ASSIGN_OR_RETURN(auto rb,
-                      RowBatch::WithZeroRows(*input_descriptor_, /* eow */ false, /* eos */ false));
-  PX_RETURN_IF_ERROR(rb->ToProto(req.mutable_query_result()->mutable_row_batch()));
+    PX_ASSIGN_OR_RETURN(auto req, RequestWithMetadata(dest, exec_state));
+    PX_ASSIGN_OR_RETURN(
+        auto rb, RowBatch::WithZeroRows(*input_descriptor_, /* eow */ false, /* eos */ false));
+    PX_RETURN_IF_ERROR(rb->ToProto(req.mutable_query_result()->mutable_row_batch()));
 
-  PX_RETURN_IF_ERROR(TryWriteRequest(exec_state, req));
+    PX_RETURN_IF_ERROR(TryWriteRequest(exec_state, &dest, req));
+  }
   return Status::OK();
 }
 
@@ -99,98 +147,135 @@ Status GRPCSinkNode::InitImpl(const plan::Operator& plan_node) {
   input_descriptor_ = std::make_unique<RowDescriptor>(input_descriptors_[0]);
   const auto* sink_plan_node = static_cast<const plan::GRPCSinkOperator*>(&plan_node);
   plan_node_ = std::make_unique<plan::GRPCSinkOperator>(*sink_plan_node);
+
+  if (!plan_node_->has_partitions()) {
+    destinations_.resize(1);
+    destinations_[0].address = plan_node_->address();
+    destinations_[0].ssl_targetname = plan_node_->ssl_targetname();
+    destinations_[0].grpc_source_id = plan_node_->grpc_source_id();
+    return Status::OK();
+  }
+
+  for (int64_t col_idx : plan_node_->partition_key_column_indexes()) {
+    if (col_idx < 0 || col_idx >= static_cast<int64_t>(input_descriptor_->size())) {
+      return error::InvalidArgument("GRPCSink partition key column $0 is out of range [0, $1)",
+                                    col_idx, input_descriptor_->size());
+    }
+  }
+  destinations_.resize(plan_node_->partitions().size());
+  for (const auto& [i, partition] : Enumerate(plan_node_->partitions())) {
+    destinations_[i].address = partition.address();
+    destinations_[i].ssl_targetname = partition.connection_options().ssl_targetname();
+    destinations_[i].grpc_source_id = partition.grpc_source_id();
+  }
   return Status::OK();
 }
 
-Status GRPCSinkNode::PrepareImpl(ExecState*) { return Status::OK(); }
+Status GRPCSinkNode::PrepareImpl(ExecState* exec_state) {
+  // Results sent to external services, such as the query broker, always use the proto encoding.
+  if (plan_node_->has_grpc_source_id() || plan_node_->has_partitions()) {
+    columnar_encoding_ = exec_state->row_batch_encoding() == planpb::ROW_BATCH_ENCODING_COLUMNAR;
+    compress_ = exec_state->compress_row_batches();
+  }
+  return Status::OK();
+}
 
-Status GRPCSinkNode::StartConnection(ExecState* exec_state) {
-  return StartConnectionWithRetries(exec_state, kGRPCRetries);
+Status GRPCSinkNode::StartConnection(ExecState* exec_state, Destination* dest) {
+  return StartConnectionWithRetries(exec_state, dest, kGRPCRetries);
 }
 
-Status GRPCSinkNode::StartConnectionWithRetries(ExecState* exec_state, size_t n_retries) {
+Status GRPCSinkNode::StartConnectionWithRetries(ExecState* exec_state, Destination* dest,
+                                                size_t n_retries) {
   if (n_retries == 0) {
     cancelled_ = true;
     return error::Cancelled(
         "GRPCSinkNode $0 error: unable to write TransferResultChunkRequest on stream start"
         "to remote address $1 for query $2",
-        plan_node_->id(), plan_node_->address(), exec_state->query_id().str());
+        plan_node_->id(), dest->address, exec_state->query_id().str());
   }
 
-  stub_ = exec_state->ResultSinkServiceStub(plan_node_->address(), plan_node_->ssl_targetname());
+  dest->stub = exec_state->ResultSinkServiceStub(dest->address, dest->ssl_targetname);
 
-  context_ = std::make_unique<grpc::ClientContext>();
+  dest->context = std::make_unique<grpc::ClientContext>();
   // When we are sending the results to an external service, such as the query broker,
   // add authentication to the client context.
   if (plan_node_->has_table_name()) {
     // Adding auth to GRPC client.
-    exec_state->AddAuthToGRPCClientContext(context_.get());
+    exec_state->AddAuthToGRPCClientContext(dest->context.get());
+  }
+  if (compress_) {
+    dest->context->set_compression_algorithm(GRPC_COMPRESS_GZIP);
   }
 
-  response_.Clear();
-  writer_ = stub_->TransferResultChunk(context_.get(), &response_);
+  dest->response.Clear();
+  dest->writer = dest->stub->TransferResultChunk(dest->context.get(), &dest->response);
 
-  PX_ASSIGN_OR_RETURN(auto req, RequestWithMetadata(plan_node_.get(), exec_state));
+  PX_ASSIGN_OR_RETURN(auto req, RequestWithMetadata(*dest, exec_state));
   // If this is not the first connection we've made then we send a 0-row rb instead of an
   // initiate_result_stream request.
   PX_ASSIGN_OR_RETURN(auto rb,
                       RowBatch::WithZeroRows(*input_descriptor_, /* eow */ false, /* eos */ false));
   PX_RETURN_IF_ERROR(rb->ToProto(req.mutable_query_result()->mutable_row_batch()));
 
-  if (!writer_->Write(req)) {
-    return StartConnectionWithRetries(exec_state, n_retries - 1);
+  if (!dest->writer->Write(req)) {
+    return StartConnectionWithRetries(exec_state, dest, n_retries - 1);
   }
 
-  last_send_time_ = std::chrono::system_clock::now();
+  dest->last_send_time = std::chrono::system_clock::now();
   return Status::OK();
 }
 
-Status GRPCSinkNode::CancelledByServer(ExecState* exec_state) {
+Status GRPCSinkNode::CancelledByServer(ExecState* exec_state, const Destination& dest) {
   cancelled_ = true;
   return error::Cancelled(
       "GRPCSinkNode $0 of query $1 could not write result to address: $2, stream closed by "
       "server",
-      plan_node_->id(), exec_state->query_id().str(), plan_node_->address());
+      plan_node_->id(), exec_state->query_id().str(), dest.address);
 }
 
-Status GRPCSinkNode::TryWriteRequest(ExecState* exec_state,
+Status GRPCSinkNode::TryWriteRequest(ExecState* exec_state, Destination* dest,
                                      const carnotpb::TransferResultChunkRequest& req) {
-  if (writer_->Write(req)) {
-    last_send_time_ = std::chrono::system_clock::now();
+  if (dest->writer->Write(req)) {
+    dest->last_send_time = std::chrono::system_clock::now();
     return Status::OK();
   }
 
   // We need to determine if the server sent a response (i.e. server closed connection) or if the
   // connection just died.
-  writer_->WritesDone();
-  auto s = writer_->Finish();
+  dest->writer->WritesDone();
+  auto s = dest->writer->Finish();
   // If the Finish call was successful, then the server closed the connection and sent a response,
   // in which case we shouldn't try to reconnect. If there's an error from the server side
   // other than a RST_STREAM, we also shouldn't retry.
   if (s.ok() || s.error_code() != grpc::StatusCode::INTERNAL ||
       !absl::StrContains(s.error_message(), "RST_STREAM")) {
-    return CancelledByServer(exec_state);
+    return CancelledByServer(exec_state, *dest);
   }
   // Otherwise, the connection was probably cancelled due to a timeout or other transient failure,
   // so we can try to restart the connection.
-  PX_RETURN_IF_ERROR(StartConnection(exec_state));
+  PX_RETURN_IF_ERROR(StartConnection(exec_state, dest));
 
   // Try again to write the request on the new connection.
-  if (!writer_->Write(req)) {
-    return CancelledByServer(exec_state);
+  if (!dest->writer->Write(req)) {
+    return CancelledByServer(exec_state, *dest);
   }
-  last_send_time_ = std::chrono::system_clock::now();
+  dest->last_send_time = std::chrono::system_clock::now();
   return Status::OK();
 }
 
-Status GRPCSinkNode::OpenImpl(ExecState* exec_state) { return StartConnection(exec_state); }
+Status GRPCSinkNode::OpenImpl(ExecState* exec_state) {
+  for (auto& dest : destinations_) {
+    PX_RETURN_IF_ERROR(StartConnection(exec_state, &dest));
+  }
+  return Status::OK();
+}
 
-Status GRPCSinkNode::CloseWriter(ExecState* exec_state) {
-  if (writer_ == nullptr) {
+Status GRPCSinkNode::CloseWriter(ExecState* exec_state, Destination* dest) {
+  if (dest->writer == nullptr) {
     return Status::OK();
   }
-  writer_->WritesDone();
-  auto s = writer_->Finish();
+  dest->writer->WritesDone();
+  auto s = dest->writer->Finish();
   if (!s.ok()) {
     LOG(ERROR) << absl::Substitute(
         "GRPCSinkNode $0 in query $1: Error calling Finish on stream, message: $2",
@@ -204,10 +289,12 @@ Status GRPCSinkNode::CloseImpl(ExecState* exec_state) {
     return Status::OK();
   }
 
-  if (writer_ != nullptr) {
-    LOG(INFO) << absl::Substitute("Closing GRPCSinkNode $0 in query $1 before receiving EOS",
-                                  plan_node_->id(), exec_state->query_id().str());
-    PX_RETURN_IF_ERROR(CloseWriter(exec_state));
+  for (auto& dest : destinations_) {
+    if (dest.writer != nullptr) {
+      LOG(INFO) << absl::Substitute("Closing GRPCSinkNode $0 in query $1 before receiving EOS",
+                                    plan_node_->id(), exec_state->query_id().str());
+      PX_RETURN_IF_ERROR(CloseWriter(exec_state, &dest));
+    }
   }
 
   return Status::OK();
@@ -274,7 +361,7 @@ std::vector<int64_t> GRPCSinkNode::SplitBatchSizes(bool has_string_col,
 }
 
 Status GRPCSinkNode::SplitAndSendBatch(ExecState* exec_state, const RowBatch& rb,
-                                       size_t parent_idx) {
+                                       Destination* dest) {
   // Calculate the individual row sizes for all the string columns.
   std::vector<int64_t> string_col_row_sizes(rb.num_rows(), 0);
   // All other columns share the same size across all rows.
@@ -290,7 +377,7 @@ Status GRPCSinkNode::SplitAndSendBatch(ExecState* exec_state, const RowBatch& rb
   for (size_t idx = 0; idx < new_batches_num_rows.size() - 1; ++idx) {
     auto num_rows = new_batches_num_rows[idx];
     PX_ASSIGN_OR_RETURN(std::unique_ptr<RowBatch> output_rb, rb.Slice(batch_idx, num_rows));
-    PX_RETURN_IF_ERROR(ConsumeNextImplNoSplit(exec_state, *output_rb, parent_idx));
+    PX_RETURN_IF_ERROR(ConsumeNextImplNoSplit(exec_state, *output_rb, dest));
     batch_idx += num_rows;
   }
 
@@ -299,35 +386,94 @@ Status GRPCSinkNode::SplitAndSendBatch(ExecState* exec_state, const RowBatch& rb
                       rb.Slice(batch_idx, rb.num_rows() - batch_idx));
   output_rb->set_eos(rb.eos());
   output_rb->set_eow(rb.eow());
-  return ConsumeNextImplNoSplit(exec_state, *output_rb, parent_idx);
+  return ConsumeNextImplNoSplit(exec_state, *output_rb, dest);
+}
+
+StatusOr<std::vector<std::unique_ptr<RowBatch>>> GRPCSinkNode::PartitionBatch(
+    ExecState* exec_state, const RowBatch& rb) {
+  DCHECK(!rb.has_selection());
+  int64_t num_rows = rb.num_rows();
+  partition_hashes_.assign(num_rows, kPartitionHashSeed);
+  for (int64_t col_idx : plan_node_->partition_key_column_indexes()) {
+    const arrow::Array* col = rb.ColumnAt(col_idx).get();
+#define TYPE_CASE(_dt_) HashColumn<_dt_>(col, partition_hashes_.data())
+    PX_SWITCH_FOREACH_DATATYPE(rb.desc().type(col_idx), TYPE_CASE);
+#undef TYPE_CASE
+  }
+
+  size_t num_partitions = destinations_.size();
+  std::vector<std::vector<int64_t>> selections(num_partitions);
+  for (int64_t row = 0; row < num_rows; ++row) {
+    selections[partition_hashes_[row] % num_partitions].push_back(row);
+  }
+
+  std::vector<std::unique_ptr<RowBatch>> partitions(num_partitions);
+  for (size_t i = 0; i < num_partitions; ++i) {
+    if (selections[i].empty() && !rb.eow() && !rb.eos()) {
+      continue;
+    }
+    if (selections[i].size() == static_cast<size_t>(num_rows)) {
+      partitions[i] = std::make_unique<RowBatch>(rb);
+      continue;
+    }
+    RowBatch selected = rb;
+    PX_RETURN_IF_ERROR(selected.SetSelection(
+        std::make_shared<const std::vector<int64_t>>(std::move(selections[i]))));
+    PX_ASSIGN_OR_RETURN(partitions[i], selected.Compact(exec_state->exec_mem_pool()));
+  }
+  return partitions;
 }
 
-Status GRPCSinkNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t parent_idx) {
+Status GRPCSinkNode::SendBatch(ExecState* exec_state, const RowBatch& rb, Destination* dest) {
   if (rb.NumBytes() > (max_batch_size_ * batch_size_factor_)) {
-    return SplitAndSendBatch(exec_state, rb, parent_idx);
+    return SplitAndSendBatch(exec_state, rb, dest);
   }
-  return ConsumeNextImplNoSplit(exec_state, rb, parent_idx);
+  return ConsumeNextImplNoSplit(exec_state, rb, dest);
 }
 
-Status GRPCSinkNode::ConsumeNextImplNoSplit(ExecState* exec_state, const RowBatch& rb, size_t) {
-  PX_ASSIGN_OR_RETURN(auto req, RequestWithMetadata(plan_node_.get(), exec_state));
+Status GRPCSinkNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
+  if (!plan_node_->has_partitions()) {
+    PX_RETURN_IF_ERROR(SendBatch(exec_state, rb, &destinations_[0]));
+  } else {
+    PX_ASSIGN_OR_RETURN(auto partitions, PartitionBatch(exec_state, rb));
+    for (const auto& [i, partition_rb] : Enumerate(partitions)) {
+      if (partition_rb != nullptr) {
+        PX_RETURN_IF_ERROR(SendBatch(exec_state, *partition_rb, &destinations_[i]));
+      }
+    }
+  }
+  if (rb.eos()) {
+    sent_eos_ = true;
+  }
+  return Status::OK();
+}
+
+Status GRPCSinkNode::ConsumeNextImplNoSplit(ExecState* exec_state, const RowBatch& rb,
+                                            Destination* dest) {
+  PX_ASSIGN_OR_RETURN(auto req, RequestWithMetadata(*dest, exec_state));
   // Serialize the RowBatch.
-  PX_RETURN_IF_ERROR(rb.ToProto(req.mutable_query_result()->mutable_row_batch()));
+  if (columnar_encoding_) {
+    PX_RETURN_IF_ERROR(
+        rb.ToColumnarProto(req.mutable_query_result()->mutable_columnar_row_batch()));
+  } else {
+    PX_RETURN_IF_ERROR(rb.ToProto(req.mutable_query_result()->mutable_row_batch()));
+  }
 
-  PX_RETURN_IF_ERROR(TryWriteRequest(exec_state, req));
+  PX_RETURN_IF_ERROR(TryWriteRequest(exec_state, dest, req));
 
   if (!rb.eos()) {
     return Status::OK();
   }
 
-  PX_RETURN_IF_ERROR(CloseWriter(exec_state));
-  sent_eos_ = true;
+  PX_RETURN_IF_ERROR(CloseWriter(exec_state, dest));
+  // The writer is finished, CloseImpl must not finish it again if another destination fails.
+  dest->writer.reset();
 
-  return response_.success()
+  return dest->response.success()
              ? Status::OK()
              : error::Internal(absl::Substitute(
                    "GRPCSinkNode $0 encountered error sending stream to address $1, message: $2",
-                   plan_node_->id(), plan_node_->address(), response_.message()));
+                   plan_node_->id(), dest->address, dest->response.message()));
 }
 
 }  // namespace exec
@@ -65,10 +65,25 @@ class GRPCSinkNode : public SinkNode {
     connection_check_timeout_ = timeout;
   }
   const std::chrono::time_point<std::chrono::system_clock>& testing_last_send_time() const {
-    return last_send_time_;
+    return destinations_[0].last_send_time;
   }
 
  protected:
+  // A stream to one of the GRPC services that the sink sends row batches to. Sinks have a single
+  // destination, unless they hash partition their input across several GRPC sources.
+  struct Destination {
+    std::string address;
+    std::string ssl_targetname;
+    // The GRPC source that receives the row batches. Unused when sending an output table.
+    int64_t grpc_source_id = 0;
+
+    std::unique_ptr<grpc::ClientContext> context;
+    carnotpb::TransferResultChunkResponse response;
+    carnotpb::ResultSinkService::StubInterface* stub = nullptr;
+    std::unique_ptr<grpc::ClientWriterInterface<carnotpb::TransferResultChunkRequest>> writer;
+    std::chrono::time_point<std::chrono::system_clock> last_send_time;
+  };
+
   std::string DebugStringImpl() override;
   Status InitImpl(const plan::Operator& plan_node) override;
   Status PrepareImpl(ExecState* exec_state) override;
@@ -76,37 +91,53 @@ class GRPCSinkNode : public SinkNode {
   Status CloseImpl(ExecState* exec_state) override;
   Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
                          size_t parent_index) override;
+  Status SendBatch(ExecState* exec_state, const table_store::schema::RowBatch& rb,
+                   Destination* dest);
   Status ConsumeNextImplNoSplit(ExecState* exec_state, const table_store::schema::RowBatch& rb,
-                                size_t parent_index);
+                                Destination* dest);
   Status SplitAndSendBatch(ExecState* exec_state, const table_store::schema::RowBatch& rb,
-                           size_t parent_index);
+                           Destination* dest);
   std::vector<int64_t> SplitBatchSizes(bool has_string_col,
                                        const std::vector<int64_t>& string_col_row_sizes,
                                        int64_t other_col_row_size) const;
 
+  /**
+   * Splits the rows of the row batch across the destinations by the hash of their key columns.
+   * Every partition keeps the eow and eos of the input, so empty partitions are only returned
+   * as nullptr when neither is set.
+   */
+  StatusOr<std::vector<std::unique_ptr<table_store::schema::RowBatch>>> PartitionBatch(
+      ExecState* exec_state, const table_store::schema::RowBatch& rb);
+
  private:
-  Status CloseWriter(ExecState* exec_state);
-  Status StartConnection(ExecState* exec_state);
-  Status StartConnectionWithRetries(ExecState* exec_state, size_t n_retries);
-  Status CancelledByServer(ExecState* exec_state);
-  Status TryWriteRequest(ExecState* exec_state, const carnotpb::TransferResultChunkRequest& req);
+  StatusOr<carnotpb::TransferResultChunkRequest> RequestWithMetadata(const Destination& dest,
+                                                                     ExecState* exec_state);
+  Status CloseWriter(ExecState* exec_state, Destination* dest);
+  Status StartConnection(ExecState* exec_state, Destination* dest);
+  Status StartConnectionWithRetries(ExecState* exec_state, Destination* dest, size_t n_retries);
+  Status CancelledByServer(ExecState* exec_state, const Destination& dest);
+  Status TryWriteRequest(ExecState* exec_state, Destination* dest,
+                         const carnotpb::TransferResultChunkRequest& req);
 
   bool cancelled_ = false;
 
-  std::unique_ptr<grpc::ClientContext> context_;
-  carnotpb::TransferResultChunkResponse response_;
-
-  carnotpb::ResultSinkService::StubInterface* stub_;
-  std::unique_ptr<grpc::ClientWriterInterface<carnotpb::TransferResultChunkRequest>> writer_;
+  std::vector<Destination> destinations_;
 
   std::unique_ptr<plan::GRPCSinkOperator> plan_node_;
   std::unique_ptr<table_store::schema::RowDescriptor> input_descriptor_;
 
   std::chrono::milliseconds connection_check_timeout_ = kDefaultConnectionCheckTimeoutMS;
-  std::chrono::time_point<std::chrono::system_clock> last_send_time_;
 
   size_t max_batch_size_;
   float batch_size_factor_;
+
+  // Whether row batches are sent as ColumnarRowBatchData instead of RowBatchData, and whether the
+  // stream is compressed. Both are only used when sending to another Carnot instance.
+  bool columnar_encoding_ = false;
+  bool compress_ = false;
+
+  // Scratch space for PartitionBatch.
+  std::vector<uint64_t> partition_hashes_;
 };
 
 }  // namespace exec
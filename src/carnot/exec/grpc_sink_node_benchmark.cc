@@ -16,6 +16,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -103,4 +105,96 @@ void BM_GRPCSinkNodeSplitting(benchmark::State& state) {
   }
 }
 
+// A batch like the ones PEMs send to Kelvin for http_events: a time, a UPID, a few ints and
+// short strings.
+RowBatch MakeMixedRowBatch(int64_t num_rows) {
+  RowDescriptor rd({DataType::TIME64NS, DataType::UINT128, DataType::INT64, DataType::INT64,
+                    DataType::FLOAT64, DataType::STRING, DataType::STRING});
+  std::vector<px::types::Time64NSValue> times(num_rows);
+  std::vector<px::types::UInt128Value> upids(num_rows);
+  std::vector<px::types::Int64Value> statuses(num_rows);
+  std::vector<px::types::Int64Value> sizes(num_rows);
+  std::vector<px::types::Float64Value> latencies(num_rows);
+  std::vector<px::types::StringValue> paths(num_rows);
+  std::vector<px::types::StringValue> bodies(num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    times[i] = 1'600'000'000'000'000'000 + i * 1000;
+    upids[i] = px::types::UInt128Value(i % 100, i % 37);
+    statuses[i] = 200 + 100 * (i % 4);
+    sizes[i] = i % 4096;
+    latencies[i] = 0.25 * i;
+    paths[i] = absl::StrCat("/api/v1/items/", i % 1000);
+    bodies[i] = std::string(64 + i % 64, 'b');
+  }
+  return px::carnot::exec::RowBatchBuilder(rd, num_rows, /*eow*/ false, /*eos*/ false)
+      .AddColumn<px::types::Time64NSValue>(times)
+      .AddColumn<px::types::UInt128Value>(upids)
+      .AddColumn<px::types::Int64Value>(statuses)
+      .AddColumn<px::types::Int64Value>(sizes)
+      .AddColumn<px::types::Float64Value>(latencies)
+      .AddColumn<px::types::StringValue>(paths)
+      .AddColumn<px::types::StringValue>(bodies)
+      .get();
+}
+
+// Encodes the batch the way GRPCSinkNode sends it, with the columnar encoding if columnar is set.
+TransferResultChunkRequest EncodeRowBatch(const RowBatch& rb, bool columnar) {
+  TransferResultChunkRequest req;
+  req.mutable_query_result()->set_grpc_source_id(1);
+  if (columnar) {
+    PX_CHECK_OK(rb.ToColumnarProto(req.mutable_query_result()->mutable_columnar_row_batch()));
+  } else {
+    PX_CHECK_OK(rb.ToProto(req.mutable_query_result()->mutable_row_batch()));
+  }
+  return req;
+}
+
+// The first argument is whether to use the columnar encoding, the second the number of rows.
+// NOLINTNEXTLINE : runtime/references.
+void BM_EncodeRowBatch(benchmark::State& state) {
+  bool columnar = state.range(0);
+  auto rb = MakeMixedRowBatch(state.range(1));
+  std::string wire_bytes;
+  for (auto _ : state) {
+    auto req = EncodeRowBatch(rb, columnar);
+    req.SerializeToString(&wire_bytes);
+    benchmark::DoNotOptimize(wire_bytes);
+  }
+  state.SetBytesProcessed(state.iterations() * rb.NumBytes());
+  state.counters["WireBytes"] = wire_bytes.size();
+}
+
+// NOLINTNEXTLINE : runtime/references.
+void BM_DecodeRowBatch(benchmark::State& state) {
+  bool columnar = state.range(0);
+  auto rb = MakeMixedRowBatch(state.range(1));
+  std::string wire_bytes;
+  EncodeRowBatch(rb, columnar).SerializeToString(&wire_bytes);
+  for (auto _ : state) {
+    // Parse and decode as GRPCRouter and GRPCSourceNode do.
+    auto req = std::make_shared<TransferResultChunkRequest>();
+    CHECK(req->ParseFromString(wire_bytes));
+    std::unique_ptr<RowBatch> output_rb;
+    if (columnar) {
+      output_rb = RowBatch::FromColumnarProto(req->query_result().columnar_row_batch(), req)
+                      .ConsumeValueOrDie();
+    } else {
+      output_rb = RowBatch::FromProto(req->query_result().row_batch()).ConsumeValueOrDie();
+    }
+    benchmark::DoNotOptimize(output_rb);
+  }
+  state.SetBytesProcessed(state.iterations() * rb.NumBytes());
+  state.counters["WireBytes"] = wire_bytes.size();
+}
+
 BENCHMARK(BM_GRPCSinkNodeSplitting)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EncodeRowBatch)
+    ->Args({false, 1024})
+    ->Args({true, 1024})
+    ->Args({false, 8192})
+    ->Args({true, 8192});
+BENCHMARK(BM_DecodeRowBatch)
+    ->Args({false, 1024})
+    ->Args({true, 1024})
+    ->Args({false, 8192})
+    ->Args({true, 8192});
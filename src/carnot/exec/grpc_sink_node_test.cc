@@ -18,9 +18,12 @@
 
 #include "src/carnot/exec/grpc_sink_node.h"
 
+#include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
+#include <absl/container/flat_hash_map.h>
 #include <grpcpp/test/mock_stream.h>
 #include <gtest/gtest.h>
 #include <sole.hpp>
@@ -217,6 +220,58 @@ TEST_F(GRPCSinkNodeTest, internal_result) {
   EXPECT_FALSE(add_metadata_called_);
 }
 
+TEST_F(GRPCSinkNodeTest, internal_result_columnar) {
+  exec_state_->set_row_batch_encoding(planpb::ROW_BATCH_ENCODING_COLUMNAR, /* compress */ false);
+  auto op_proto = planpb::testutils::CreateTestGRPCSink1PB();
+  auto plan_node = std::make_unique<plan::GRPCSinkOperator>(1);
+  auto s = plan_node->Init(op_proto.grpc_sink_op());
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::STRING});
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::STRING});
+
+  TransferResultChunkResponse resp;
+  resp.set_success(true);
+
+  std::vector<TransferResultChunkRequest> actual_protos(4);
+  auto writer = new grpc::testing::MockClientWriter<TransferResultChunkRequest>();
+  EXPECT_CALL(*writer, Write(_, _))
+      .Times(4)
+      .WillOnce(DoAll(SaveArg<0>(&actual_protos[0]), Return(true)))
+      .WillOnce(DoAll(SaveArg<0>(&actual_protos[1]), Return(true)))
+      .WillOnce(DoAll(SaveArg<0>(&actual_protos[2]), Return(true)))
+      .WillOnce(DoAll(SaveArg<0>(&actual_protos[3]), Return(true)));
+  EXPECT_CALL(*writer, WritesDone());
+  EXPECT_CALL(*writer, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*mock_, TransferResultChunkRaw(_, _))
+      .WillOnce(DoAll(SetArgPointee<1>(resp), Return(writer)));
+
+  auto tester = exec::ExecNodeTester<GRPCSinkNode, plan::GRPCSinkOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  std::vector<std::string> expected_batches;
+  for (auto i = 0; i < 3; ++i) {
+    std::vector<types::Int64Value> int_data(i, i);
+    std::vector<types::StringValue> string_data(i, absl::StrCat("value", i));
+    auto rb = RowBatchBuilder(output_rd, i, /*eow*/ i == 2, /*eos*/ i == 2)
+                  .AddColumn<types::Int64Value>(int_data)
+                  .AddColumn<types::StringValue>(string_data)
+                  .get();
+    expected_batches.push_back(rb.DebugString());
+    tester.ConsumeNext(rb, 5, 0);
+  }
+  tester.Close();
+
+  // The connection is still initiated with an empty proto row batch.
+  EXPECT_TRUE(actual_protos[0].query_result().has_row_batch());
+  for (auto i = 0; i < 3; ++i) {
+    const auto& result = actual_protos[i + 1].query_result();
+    EXPECT_EQ(0, result.grpc_source_id());
+    ASSERT_TRUE(result.has_columnar_row_batch());
+    ASSERT_OK_AND_ASSIGN(auto rb,
+                         RowBatch::FromColumnarProto(result.columnar_row_batch(), nullptr));
+    EXPECT_EQ(expected_batches[i], rb->DebugString());
+  }
+}
+
 constexpr char kExpectedExternal0RowResult[] = R"proto(
 address: "localhost:1234"
 query_id {
@@ -763,6 +818,104 @@ TEST_F(GRPCSinkNodeTest, check_connection_after_eos) {
   tester.Close();
 }
 
+class GRPCSinkNodePartitionTest : public ::testing::Test {
+ public:
+  GRPCSinkNodePartitionTest() {
+    func_registry_ = std::make_unique<udf::Registry>("test_registry");
+    auto table_store = std::make_shared<table_store::TableStore>();
+    for (const auto& address : {"kelvin0:1234", "kelvin1:1234"}) {
+      mocks_[address] = std::make_unique<MockResultSinkServiceStub>();
+      mock_ptrs_[address] = mocks_[address].get();
+    }
+
+    exec_state_ = std::make_unique<ExecState>(
+        func_registry_.get(), table_store,
+        [this](const std::string& address,
+               const std::string&) -> std::unique_ptr<ResultSinkService::StubInterface> {
+          return std::move(mocks_[address]);
+        },
+        MockMetricsStubGenerator, MockTraceStubGenerator, sole::uuid4(), nullptr, nullptr);
+  }
+
+ protected:
+  // Returns the requests written to the mocked stream to the address.
+  std::vector<TransferResultChunkRequest>* ExpectStream(const std::string& address) {
+    TransferResultChunkResponse resp;
+    resp.set_success(true);
+    auto writer = new grpc::testing::MockClientWriter<TransferResultChunkRequest>();
+    auto* reqs = &requests_[address];
+    EXPECT_CALL(*writer, Write(_, _))
+        .WillRepeatedly(Invoke([reqs](const TransferResultChunkRequest& req, grpc::WriteOptions) {
+          reqs->push_back(req);
+          return true;
+        }));
+    EXPECT_CALL(*writer, WritesDone()).WillOnce(Return(true));
+    EXPECT_CALL(*writer, Finish()).WillOnce(Return(grpc::Status::OK));
+    EXPECT_CALL(*mock_ptrs_[address], TransferResultChunkRaw(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(resp), Return(writer)));
+    return reqs;
+  }
+
+  std::unique_ptr<ExecState> exec_state_;
+  std::unique_ptr<udf::Registry> func_registry_;
+  absl::flat_hash_map<std::string, std::unique_ptr<MockResultSinkServiceStub>> mocks_;
+  absl::flat_hash_map<std::string, MockResultSinkServiceStub*> mock_ptrs_;
+  absl::flat_hash_map<std::string, std::vector<TransferResultChunkRequest>> requests_;
+};
+
+TEST_F(GRPCSinkNodePartitionTest, hash_partitions_rows_by_key) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSinkPartitionedPB();
+  auto plan_node = std::make_unique<plan::GRPCSinkOperator>(1);
+  ASSERT_OK(plan_node->Init(op_proto.grpc_sink_op()));
+  RowDescriptor rd({types::DataType::STRING, types::DataType::INT64});
+
+  auto kelvin0_reqs = ExpectStream("kelvin0:1234");
+  auto kelvin1_reqs = ExpectStream("kelvin1:1234");
+
+  auto tester =
+      exec::ExecNodeTester<GRPCSinkNode, plan::GRPCSinkOperator>(*plan_node, rd, {rd},
+                                                                 exec_state_.get());
+  std::vector<types::StringValue> keys = {"a", "b", "c", "d", "e", "f", "g", "h"};
+  for (int64_t i = 0; i < 2; ++i) {
+    std::vector<types::Int64Value> values(keys.size(), i);
+    auto rb = RowBatchBuilder(rd, keys.size(), /*eow*/ i == 1, /*eos*/ i == 1)
+                  .AddColumn<types::StringValue>(keys)
+                  .AddColumn<types::Int64Value>(values)
+                  .get();
+    tester.ConsumeNext(rb, 0, 0);
+  }
+  tester.Close();
+
+  // Every key goes to a single partition, the same one for both batches.
+  absl::flat_hash_map<std::string, std::string> key_to_address;
+  absl::flat_hash_map<std::string, int64_t> key_counts;
+  for (const auto& [address, source_id, reqs] :
+       {std::make_tuple("kelvin0:1234", 1, kelvin0_reqs),
+        std::make_tuple("kelvin1:1234", 2, kelvin1_reqs)}) {
+    ASSERT_GE(reqs->size(), 2UL);
+    EXPECT_TRUE(reqs->back().query_result().row_batch().eos());
+    for (const auto& req : *reqs) {
+      EXPECT_EQ(address, req.address());
+      EXPECT_EQ(source_id, req.query_result().grpc_source_id());
+      auto rb = RowBatch::FromProto(req.query_result().row_batch()).ConsumeValueOrDie();
+      if (rb->num_rows() == 0) {
+        continue;
+      }
+      auto key_col = std::static_pointer_cast<arrow::StringArray>(rb->ColumnAt(0));
+      for (int64_t i = 0; i < rb->num_rows(); ++i) {
+        std::string key = key_col->GetString(i);
+        auto [it, inserted] = key_to_address.try_emplace(key, address);
+        EXPECT_EQ(it->second, address) << key;
+        ++key_counts[key];
+      }
+    }
+  }
+  EXPECT_EQ(keys.size(), key_counts.size());
+  for (const auto& [key, count] : key_counts) {
+    EXPECT_EQ(2, count) << key;
+  }
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
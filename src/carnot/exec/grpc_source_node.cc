@@ -18,6 +18,7 @@
 
 #include "src/carnot/exec/grpc_source_node.h"
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -72,12 +73,19 @@ Status GRPCSourceNode::PopRowBatch() {
         "Called GRPCSourceNode::OptionallyPopRowBatch but there was no available row batch in the "
         "queue.");
   }
-  if (!rb_request->has_query_result() || !rb_request->query_result().has_row_batch()) {
+  if (!HasRowBatch(*rb_request)) {
     return error::Internal(
         "GRPCSourceNode::PopRowBatch expected TransferResultChunkRequest to have RowBatch "
         "message.");
   }
 
+  if (rb_request->query_result().has_columnar_row_batch()) {
+    // The columns of the row batch point into the request, which they keep alive.
+    std::shared_ptr<const carnotpb::TransferResultChunkRequest> request = std::move(rb_request);
+    PX_ASSIGN_OR_RETURN(
+        rb_, RowBatch::FromColumnarProto(request->query_result().columnar_row_batch(), request));
+    return Status::OK();
+  }
   PX_ASSIGN_OR_RETURN(rb_, RowBatch::FromProto(rb_request->query_result().row_batch()));
   return Status::OK();
 }
@@ -87,6 +87,39 @@ TEST_F(GRPCSourceNodeTest, basic) {
   EXPECT_FALSE(tester.node()->HasBatchesRemaining());
 }
 
+TEST_F(GRPCSourceNodeTest, columnar_row_batches) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSource1PB();
+  std::unique_ptr<plan::Operator> plan_node = plan::GRPCSourceOperator::FromProto(op_proto, 1);
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::STRING});
+
+  auto tester = exec::ExecNodeTester<GRPCSourceNode, plan::GRPCSourceOperator>(
+      *plan_node, output_rd, std::vector<RowDescriptor>({}), exec_state_.get());
+
+  // Both encodings can be received on the same stream.
+  for (auto i = 0; i < 3; ++i) {
+    std::vector<types::Int64Value> int_data(i, i);
+    std::vector<types::StringValue> string_data(i, absl::StrCat("value", i));
+    auto rb = RowBatchBuilder(output_rd, i, /*eow*/ i == 2, /*eos*/ i == 2)
+                  .AddColumn<types::Int64Value>(int_data)
+                  .AddColumn<types::StringValue>(string_data)
+                  .get();
+
+    auto rb_wrapper = std::make_unique<carnotpb::TransferResultChunkRequest>();
+    if (i % 2 == 0) {
+      EXPECT_OK(
+          rb.ToColumnarProto(rb_wrapper->mutable_query_result()->mutable_columnar_row_batch()));
+    } else {
+      EXPECT_OK(rb.ToProto(rb_wrapper->mutable_query_result()->mutable_row_batch()));
+    }
+    EXPECT_OK(tester.node()->EnqueueRowBatch(std::move(rb_wrapper)));
+
+    EXPECT_TRUE(tester.node()->NextBatchReady());
+    tester.GenerateNextResult().ExpectRowBatch(rb);
+  }
+
+  EXPECT_FALSE(tester.node()->HasBatchesRemaining());
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -42,6 +42,9 @@ Status MapNode::InitImpl(const plan::Operator& plan_node) {
   const auto* map_plan_node = static_cast<const plan::MapOperator*>(&plan_node);
   // copy the plan node to local object;
   plan_node_ = std::make_unique<plan::MapOperator>(*map_plan_node);
+  for (const auto& expr : plan_node_->expressions()) {
+    calls_funcs_ |= expr->ExpressionType() == plan::Expression::kFunc;
+  }
   return Status::OK();
 }
 Status MapNode::PrepareImpl(ExecState* exec_state) {
@@ -61,8 +64,18 @@ Status MapNode::CloseImpl(ExecState* exec_state) {
   return Status::OK();
 }
 Status MapNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
-  RowBatch output_rb(*output_descriptor_, rb.num_rows());
+  // Functions only run on the selected rows. The rows that a filter dropped can hold values the
+  // function can't take, e.g. the zero divisors of `df[df.b != 0]` followed by `df.a % df.b`.
+  if (rb.has_selection() && calls_funcs_) {
+    PX_ASSIGN_OR_RETURN(auto compacted_rb, rb.Compact(exec_state->exec_mem_pool()));
+    return ConsumeNextImpl(exec_state, *compacted_rb, 0);
+  }
+
+  // Columns and constants are evaluated over the whole columns, and the output keeps the selection
+  // of the input.
+  RowBatch output_rb(*output_descriptor_, rb.num_column_rows());
   PX_RETURN_IF_ERROR(evaluator_->Evaluate(exec_state, rb, &output_rb));
+  PX_RETURN_IF_ERROR(output_rb.SetSelection(rb.selection()));
   output_rb.set_eow(rb.eow());
   output_rb.set_eos(rb.eos());
   PX_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, output_rb));
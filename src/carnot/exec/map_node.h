@@ -49,11 +49,15 @@ class MapNode : public ProcessingNode {
   Status CloseImpl(ExecState* exec_state) override;
   Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
                          size_t parent_index) override;
+  bool ConsumesSelections() const override { return true; }
 
  private:
   std::unique_ptr<ExpressionEvaluator> evaluator_;
   std::unique_ptr<plan::MapOperator> plan_node_;
   std::unique_ptr<udf::FunctionContext> function_ctx_;
+  // Whether any of the expressions calls a function, rather than only selecting columns and
+  // constants.
+  bool calls_funcs_ = false;
 };
 
 }  // namespace exec
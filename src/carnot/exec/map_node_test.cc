@@ -51,6 +51,16 @@ class AddUDF : public udf::ScalarUDF {
   }
 };
 
+// AddUDF, counting the rows that it is evaluated on.
+class CountingAddUDF : public udf::ScalarUDF {
+ public:
+  types::Int64Value Exec(FunctionContext*, types::Int64Value v1, types::Int64Value v2) {
+    ++num_calls;
+    return v1.val + v2.val;
+  }
+  static inline int64_t num_calls = 0;
+};
+
 class MapNodeTest : public ::testing::Test {
  public:
   MapNodeTest() {
@@ -99,6 +109,51 @@ TEST_F(MapNodeTest, basic) {
       .Close();
 }
 
+TEST_F(MapNodeTest, input_selection) {
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  auto input_rb = RowBatchBuilder(input_rd, 4, /*eow*/ true, /*eos*/ true)
+                      .AddColumn<types::Int64Value>({1, 2, 3, 4})
+                      .AddColumn<types::Int64Value>({1, 3, 6, 9})
+                      .get();
+  ASSERT_OK(input_rb.SetSelection(
+      std::make_shared<const std::vector<int64_t>>(std::vector<int64_t>{0, 3})));
+
+  auto tester = exec::ExecNodeTester<MapNode, plan::MapOperator>(*plan_node_, output_rd, {},
+                                                                 exec_state_.get());
+  tester.ConsumeNext(input_rb, 0)
+      .ExpectRowBatch(
+          RowBatchBuilder(output_rd, 2, true, true).AddColumn<types::Int64Value>({2, 13}).get())
+      .Close();
+}
+
+TEST_F(MapNodeTest, functions_only_run_on_selected_rows) {
+  ASSERT_OK(func_registry_->Register<CountingAddUDF>("counting_add"));
+  ASSERT_OK(exec_state_->AddScalarUDF(
+      0, "counting_add",
+      std::vector<types::DataType>({types::DataType::INT64, types::DataType::INT64})));
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  auto input_rb = RowBatchBuilder(input_rd, 4, /*eow*/ true, /*eos*/ true)
+                      .AddColumn<types::Int64Value>({1, 2, 3, 4})
+                      .AddColumn<types::Int64Value>({1, 3, 6, 9})
+                      .get();
+  ASSERT_OK(input_rb.SetSelection(
+      std::make_shared<const std::vector<int64_t>>(std::vector<int64_t>{0, 2, 3})));
+
+  // Only the selected rows are evaluated, even though most of the rows are selected.
+  CountingAddUDF::num_calls = 0;
+  auto tester = exec::ExecNodeTester<MapNode, plan::MapOperator>(*plan_node_, output_rd, {},
+                                                                 exec_state_.get());
+  tester.ConsumeNext(input_rb, 0)
+      .ExpectRowBatch(
+          RowBatchBuilder(output_rd, 3, true, true).AddColumn<types::Int64Value>({2, 9, 13}).get())
+      .Close();
+  EXPECT_EQ(3, CountingAddUDF::num_calls);
+}
+
 TEST_F(MapNodeTest, zero_row_row_batch) {
   RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
   RowDescriptor output_rd({types::DataType::INT64});
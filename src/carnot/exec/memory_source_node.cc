@@ -19,15 +19,28 @@
 #include "src/carnot/exec/memory_source_node.h"
 #include "src/table_store/table/table.h"
 
+#include <algorithm>
+#include <iterator>
 #include <limits>
 #include <string>
 #include <vector>
 
+#include <absl/strings/str_cat.h>
 #include <absl/strings/substitute.h>
 
+#include "src/carnot/exec/thread_pool.h"
 #include "src/carnot/planpb/plan.pb.h"
 #include "src/common/base/base.h"
 
+DEFINE_int32(carnot_memory_source_read_batches,
+             gflags::Int32FromEnv("PL_CARNOT_MEMORY_SOURCE_READ_BATCHES", 16),
+             "The number of batches that a MemorySourceNode reads from a tablet at once, under a "
+             "single acquisition of the table locks.");
+DEFINE_int32(carnot_memory_source_tablet_threads,
+             gflags::Int32FromEnv("PL_CARNOT_MEMORY_SOURCE_TABLET_THREADS", 4),
+             "The maximum number of threads that a MemorySourceNode reading several tablets reads "
+             "them with.");
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -52,15 +65,8 @@ Status MemorySourceNode::InitImpl(const plan::Operator& plan_node) {
 Status MemorySourceNode::PrepareImpl(ExecState*) { return Status::OK(); }
 
 Status MemorySourceNode::OpenImpl(ExecState* exec_state) {
-  table_ = exec_state->table_store()->GetTable(plan_node_->TableName(), plan_node_->Tablet());
-  DCHECK(table_ != nullptr);
-
   streaming_ = plan_node_->streaming();
 
-  if (table_ == nullptr) {
-    return error::NotFound("Table '$0' not found", plan_node_->TableName());
-  }
-
   StartSpec start_spec;
   if (plan_node_->HasStartTime()) {
     start_spec.type = StartSpec::StartType::StartAtTime;
@@ -85,30 +91,118 @@ Status MemorySourceNode::OpenImpl(ExecState* exec_state) {
       stop_spec.type = StopSpec::StopType::CurrentEndOfTable;
     }
   }
-  cursor_ = std::make_unique<Table::Cursor>(table_, start_spec, stop_spec);
+
+  for (const auto& tablet : plan_node_->Tablets()) {
+    Table* table = exec_state->table_store()->GetTable(plan_node_->TableName(), tablet);
+    DCHECK(table != nullptr);
+    if (table == nullptr) {
+      return error::NotFound("Table '$0' not found", plan_node_->TableName());
+    }
+    TabletScan scan;
+    scan.table = table;
+    scan.cursor =
+        std::make_unique<Table::Cursor>(table, start_spec, stop_spec, plan_node_->predicates());
+    scans_.push_back(std::move(scan));
+  }
 
   return Status::OK();
 }
 
 Status MemorySourceNode::CloseImpl(ExecState*) {
   stats()->AddExtraInfo("streaming", streaming_ ? "true" : "false");
+  if (!scans_.empty()) {
+    int64_t batches_skipped = 0;
+    for (const auto& scan : scans_) {
+      batches_skipped += scan.cursor->batches_skipped();
+    }
+    stats()->AddExtraInfo("batches_skipped", absl::StrCat(batches_skipped));
+  }
+  if (scans_.size() > 1) {
+    stats()->AddExtraInfo("tablets", absl::StrCat(scans_.size()));
+  }
+  if (morsels_ > 0) {
+    stats()->AddExtraInfo("morsels", absl::StrCat(morsels_));
+  }
   return Status::OK();
 }
 
-StatusOr<std::unique_ptr<RowBatch>> MemorySourceNode::GetNextRowBatch(ExecState*) {
-  DCHECK(table_ != nullptr);
-
-  if (!cursor_->NextBatchReady()) {
-    // If the NextBatch is not ready, but the cursor is not yet exhausted, then we need to output
-    // 0-row row batches, while we wait for more data to be added. This currently only occurs in the
-    // case of an infinite stream. In the future, it should also occur when a stop time is set in
-    // the future, but this is not yet supported by Table.
-    // If the cursor is exhausted, then we return a 0-row row batch with eow=eos=true.
-    return RowBatch::WithZeroRows(*output_descriptor_, /* eow */ cursor_->Done(),
-                                  /* eos */ cursor_->Done());
+Status MemorySourceNode::ReadAhead() {
+  std::vector<TabletScan*> to_read;
+  for (auto& scan : scans_) {
+    if (scan.batches.empty() && !scan.cursor->Done()) {
+      to_read.push_back(&scan);
+    }
+  }
+  const auto cols = plan_node_->Columns();
+  auto read = [&cols](TabletScan* scan) -> Status {
+    PX_ASSIGN_OR_RETURN(auto batches, scan->cursor->GetNextRowBatches(
+                                          cols, FLAGS_carnot_memory_source_read_batches));
+    std::move(batches.begin(), batches.end(), std::back_inserter(scan->batches));
+    return Status::OK();
+  };
+
+  size_t num_threads = std::min<size_t>(
+      to_read.size(), std::max(1, FLAGS_carnot_memory_source_tablet_threads));
+  if (num_threads <= 1) {
+    for (auto* scan : to_read) {
+      PX_RETURN_IF_ERROR(read(scan));
+    }
+    return Status::OK();
   }
 
-  PX_ASSIGN_OR_RETURN(auto row_batch, cursor_->GetNextRowBatch(plan_node_->Columns()));
+  // Each thread reads every num_threads-th tablet. The cursors and buffers of different tablets
+  // are independent, and the tables synchronize their own readers.
+  std::vector<Status> statuses(num_threads);
+  ThreadPool::Default()->ParallelFor(num_threads, [&](int i) {
+    for (size_t j = i; j < to_read.size() && statuses[i].ok(); j += num_threads) {
+      statuses[i] = read(to_read[j]);
+    }
+  });
+  for (const auto& s : statuses) {
+    PX_RETURN_IF_ERROR(s);
+  }
+  return Status::OK();
+}
+
+std::unique_ptr<RowBatch> MemorySourceNode::PopBatch() {
+  for (size_t i = 0; i < scans_.size(); ++i) {
+    size_t idx = (next_scan_ + i) % scans_.size();
+    auto& batches = scans_[idx].batches;
+    if (!batches.empty()) {
+      auto row_batch = std::move(batches.front());
+      batches.pop_front();
+      next_scan_ = (idx + 1) % scans_.size();
+      return row_batch;
+    }
+  }
+  return nullptr;
+}
+
+bool MemorySourceNode::HasBufferedBatches() const {
+  return std::any_of(scans_.begin(), scans_.end(),
+                     [](const TabletScan& scan) { return !scan.batches.empty(); });
+}
+
+bool MemorySourceNode::CursorsDone() {
+  return std::all_of(scans_.begin(), scans_.end(),
+                     [](TabletScan& scan) { return scan.cursor->Done(); });
+}
+
+StatusOr<std::unique_ptr<RowBatch>> MemorySourceNode::GetNextRowBatch(ExecState*) {
+  DCHECK(!scans_.empty());
+
+  if (!HasBufferedBatches()) {
+    PX_RETURN_IF_ERROR(ReadAhead());
+  }
+  auto row_batch = PopBatch();
+  if (row_batch == nullptr) {
+    // If no batch is ready, but the cursors are not yet exhausted, then we need to output 0-row
+    // row batches, while we wait for more data to be added. This currently only occurs in the
+    // case of an infinite stream, or of a stop time in the future.
+    // If the cursors are exhausted, then we return a 0-row row batch with eow=eos=true.
+    bool done = CursorsDone();
+    return RowBatch::WithZeroRows(*output_descriptor_, /* eow */ done, /* eos */ done);
+  }
 
   rows_processed_ += row_batch->num_rows();
   bytes_processed_ += row_batch->NumBytes();
@@ -116,20 +210,41 @@ StatusOr<std::unique_ptr<RowBatch>> MemorySourceNode::GetNextRowBatch(ExecState*
   // If infinite stream is set, we don't send Eow or Eos. Infinite streams therefore never cause
   // HasBatchesRemaining to be false. Instead the outer loop that calls GenerateNext() is
   // responsible for managing whether we continue the stream or end it.
-  if (cursor_->Done()) {
+  if (!HasBufferedBatches() && CursorsDone()) {
     row_batch->set_eow(true);
     row_batch->set_eos(true);
   }
   return row_batch;
 }
 
+StatusOr<std::unique_ptr<RowBatch>> MemorySourceNode::NextMorsel() {
+  DCHECK(!scans_.empty());
+  DCHECK(!streaming_);
+  std::lock_guard<std::mutex> lock(morsel_mutex_);
+  if (!HasBufferedBatches()) {
+    PX_RETURN_IF_ERROR(ReadAhead());
+  }
+  auto row_batch = PopBatch();
+  if (row_batch == nullptr) {
+    return row_batch;
+  }
+  rows_processed_ += row_batch->num_rows();
+  bytes_processed_ += row_batch->NumBytes();
+  ++morsels_;
+  return row_batch;
+}
+
 Status MemorySourceNode::GenerateNextImpl(ExecState* exec_state) {
   PX_ASSIGN_OR_RETURN(auto row_batch, GetNextRowBatch(exec_state));
   PX_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, *row_batch));
   return Status::OK();
 }
 
-bool MemorySourceNode::InfiniteStreamNextBatchReady() { return cursor_->NextBatchReady(); }
+bool MemorySourceNode::InfiniteStreamNextBatchReady() {
+  return HasBufferedBatches() ||
+         std::any_of(scans_.begin(), scans_.end(),
+                     [](TabletScan& scan) { return scan.cursor->NextBatchReady(); });
+}
 
 bool MemorySourceNode::NextBatchReady() {
   // Next batch is ready if we haven't seen an eow and if it's an infinite_stream that has batches
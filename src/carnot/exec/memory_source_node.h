@@ -19,7 +19,9 @@
 #pragma once
 
 #include <stdint.h>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -46,6 +48,14 @@ class MemorySourceNode : public SourceNode {
 
   bool NextBatchReady() override;
 
+  /**
+   * Returns the next batch of the table, or nullptr once the table has been read up to the stop
+   * time. Unlike GenerateNext, this can be called from several threads at once, which is used to
+   * split the scan into morsels that are processed in parallel (see ParallelPipeline). The batches
+   * never have eow or eos set, the caller has to send the end of stream once it is done.
+   */
+  StatusOr<std::unique_ptr<RowBatch>> NextMorsel();
+
  protected:
   std::string DebugStringImpl() override;
   Status InitImpl(const plan::Operator& plan_node) override;
@@ -55,15 +65,35 @@ class MemorySourceNode : public SourceNode {
   Status GenerateNextImpl(ExecState* exec_state) override;
 
  private:
+  // The scan of one tablet of the table.
+  struct TabletScan {
+    table_store::Table* table = nullptr;
+    std::unique_ptr<Table::Cursor> cursor;
+    // Batches read ahead from the cursor that haven't been output yet.
+    std::deque<std::unique_ptr<RowBatch>> batches;
+  };
+
   StatusOr<std::unique_ptr<RowBatch>> GetNextRowBatch(ExecState* exec_state);
+  // Reads the next batches of every tablet that has none left, on several threads of the shared
+  // ThreadPool if there are several such tablets.
+  Status ReadAhead();
+  // Returns the next batch that was read ahead, taking the tablets in turns, or nullptr if there
+  // is none.
+  std::unique_ptr<RowBatch> PopBatch();
+  bool HasBufferedBatches() const;
+  bool CursorsDone();
   bool InfiniteStreamNextBatchReady();
   // Whether this memory source will stream future results.
   bool streaming_ = false;
 
-  std::unique_ptr<Table::Cursor> cursor_;
+  std::vector<TabletScan> scans_;
+  // The tablet that PopBatch() looks at first.
+  size_t next_scan_ = 0;
+  // Guards the scans and the processed counters while morsels are being handed out.
+  std::mutex morsel_mutex_;
+  int64_t morsels_ = 0;
 
   std::unique_ptr<plan::MemorySourceOperator> plan_node_;
-  table_store::Table* table_ = nullptr;
 };
 
 }  // namespace exec
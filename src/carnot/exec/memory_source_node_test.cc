@@ -327,6 +327,46 @@ TEST_F(MemorySourceNodeTabletTest, multiple_tablet_test) {
   EXPECT_EQ(0, tester.node()->BytesProcessed());
 }
 
+// Test that a memory source node reading several tablets interleaves their batches.
+TEST_F(MemorySourceNodeTabletTest, several_tablets_test) {
+  types::TabletID other_tablet_id = "456";
+  std::shared_ptr<Table> other_tablet = Table::Create(table_name_, rel);
+  auto rb = RowBatch(RowDescriptor(rel.col_types()), 2);
+  std::vector<types::BoolValue> col1_in = {true, true};
+  std::vector<types::Time64NSValue> col2_in = {10, 11};
+  EXPECT_OK(rb.AddColumn(types::ToArrow(col1_in, arrow::default_memory_pool())));
+  EXPECT_OK(rb.AddColumn(types::ToArrow(col2_in, arrow::default_memory_pool())));
+  EXPECT_OK(other_tablet->WriteRowBatch(rb));
+  exec_state_->table_store()->AddTable(other_tablet, table_name_, table_id_, other_tablet_id);
+
+  auto op_proto =
+      planpb::testutils::CreateTestSourceWithTablets1PB(absl::Substitute("\"$0\"", tablet_id_));
+  op_proto.mutable_mem_source_op()->add_tablets(tablet_id_);
+  op_proto.mutable_mem_source_op()->add_tablets(other_tablet_id);
+  std::unique_ptr<plan::Operator> plan_node = plan::MemorySourceOperator::FromProto(op_proto, 1);
+  RowDescriptor output_rd({types::DataType::TIME64NS});
+
+  auto tester = exec::ExecNodeTester<MemorySourceNode, plan::MemorySourceOperator>(
+      *plan_node, output_rd, std::vector<RowDescriptor>({}), exec_state_.get());
+  EXPECT_TRUE(tester.node()->HasBatchesRemaining());
+  tester.GenerateNextResult().ExpectRowBatch(
+      RowBatchBuilder(output_rd, 3, /*eow*/ false, /*eos*/ false)
+          .AddColumn<types::Time64NSValue>({1, 2, 3})
+          .get());
+  tester.GenerateNextResult().ExpectRowBatch(
+      RowBatchBuilder(output_rd, 2, /*eow*/ false, /*eos*/ false)
+          .AddColumn<types::Time64NSValue>({10, 11})
+          .get());
+  EXPECT_TRUE(tester.node()->HasBatchesRemaining());
+  tester.GenerateNextResult().ExpectRowBatch(
+      RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ true)
+          .AddColumn<types::Time64NSValue>({5, 6})
+          .get());
+  EXPECT_FALSE(tester.node()->HasBatchesRemaining());
+  tester.Close();
+  EXPECT_EQ(7, tester.node()->RowsProcessed());
+}
+
 using MemorySourceNodeTabletDeathTest = MemorySourceNodeTabletTest;
 TEST_F(MemorySourceNodeTabletDeathTest, missing_tablet_fails) {
   types::TabletID non_existant_tablet_value = "223";
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/parallel_pipeline.h"
+
+#include "src/carnot/exec/thread_pool.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+Status ParallelPipeline::RunThread(ExecState* exec_state, ExecNode* head) {
+  while (!cancelled_) {
+    auto morsel_or_s = source_->NextMorsel();
+    if (!morsel_or_s.ok()) {
+      cancelled_ = true;
+      return morsel_or_s.status();
+    }
+    auto morsel = morsel_or_s.ConsumeValueOrDie();
+    if (morsel == nullptr) {
+      return Status::OK();
+    }
+    auto s = head->ConsumeNext(exec_state, *morsel, 0);
+    if (!s.ok()) {
+      cancelled_ = true;
+      return s;
+    }
+  }
+  return Status::OK();
+}
+
+Status ParallelPipeline::Execute(ExecState* exec_state) {
+  std::vector<Status> statuses(replicas_.size());
+  ThreadPool::Default()->ParallelFor(replicas_.size(), [&](int i) {
+    statuses[i] = RunThread(exec_state, replicas_[i][0]);
+  });
+  for (const auto& s : statuses) {
+    PX_RETURN_IF_ERROR(s);
+  }
+
+  for (const auto& replica : replicas_) {
+    PX_RETURN_IF_ERROR(agg_->MergeFrom(exec_state, static_cast<AggNode*>(replica.back())));
+  }
+  exec_state->SetCurrentSource(source_id_);
+  return source_->SendEndOfStream(exec_state);
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "src/carnot/exec/agg_node.h"
+#include "src/carnot/exec/exec_node.h"
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/memory_source_node.h"
+#include "src/common/base/base.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * ParallelPipeline runs a MemorySourceNode, and the Map and Filter nodes between it and a blocking
+ * AggNode, on several threads.
+ *
+ * The scan is split into morsels of one table batch each. Every thread has its own copy of the
+ * Map, Filter and Agg nodes of the pipeline, and pulls the next morsel from the source as soon as
+ * it is done with the previous one, so the threads stay busy even when some morsels take longer
+ * than others. Once the source is exhausted, the partial aggregates of the copies are merged into
+ * the original AggNode and the end of stream is sent down the original pipeline, which makes the
+ * AggNode emit its result to the rest of the graph as usual.
+ *
+ * The copies run on the process-wide ThreadPool. Each copy has its own UDF instances and
+ * FunctionContexts, since they are created when the copy is prepared and opened, so the only state
+ * that the threads share is the source and the ExecState, which they only read from.
+ */
+class ParallelPipeline {
+ public:
+  /**
+   * @param source_id The id of the source node.
+   * @param source The source of the pipeline.
+   * @param agg The original AggNode at the end of the pipeline.
+   * @param replicas The nodes of each thread's copy of the pipeline, in order from the child of the
+   * source to the copy of the AggNode. All of them must be prepared and opened.
+   */
+  ParallelPipeline(int64_t source_id, MemorySourceNode* source, AggNode* agg,
+                   std::vector<std::vector<ExecNode*>> replicas)
+      : source_id_(source_id), source_(source), agg_(agg), replicas_(std::move(replicas)) {}
+
+  /**
+   * Runs the pipeline until the source is exhausted, then merges the partial aggregates and sends
+   * the end of stream.
+   */
+  Status Execute(ExecState* exec_state);
+
+  int64_t source_id() const { return source_id_; }
+  size_t num_threads() const { return replicas_.size(); }
+
+ private:
+  Status RunThread(ExecState* exec_state, ExecNode* head);
+
+  int64_t source_id_;
+  MemorySourceNode* source_;
+  AggNode* agg_;
+  std::vector<std::vector<ExecNode*>> replicas_;
+  // Set when one of the threads fails, so that the others stop early.
+  std::atomic<bool> cancelled_ = false;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
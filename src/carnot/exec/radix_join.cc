@@ -0,0 +1,325 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/radix_join.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "src/shared/types/type_utils.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+namespace {
+
+constexpr uint64_t kHashSeed = 0x9ae16a3b2f90404fULL;
+constexpr int kPartitionShift = 64 - RadixJoinHashTable::kRadixBits;
+constexpr size_t kMinPartitionSlots = 64;
+// Bloom filter blocks are picked with bits [20, 40) of the hash and the bits within a block
+// with bits [40, 58), so that neither overlaps the partition bits.
+constexpr int kBloomBlockShift = 20;
+constexpr size_t kMaxBloomBlocks = 1 << 20;
+constexpr int kBloomBitShift = 40;
+
+inline uint32_t PartitionOf(uint64_t hash) {
+  return static_cast<uint32_t>(hash >> kPartitionShift);
+}
+
+inline uint64_t BloomBits(uint64_t hash) {
+  uint64_t bits = hash >> kBloomBitShift;
+  return (1ULL << (bits & 63)) | (1ULL << ((bits >> 6) & 63)) | (1ULL << ((bits >> 12) & 63));
+}
+
+template <types::DataType DT>
+void AppendRowsToWrapper(types::ColumnWrapper* wrapper, arrow::Array* arr, const uint32_t* rows,
+                         size_t num_rows) {
+  for (size_t i = 0; i < num_rows; ++i) {
+    types::ExtractValueToColumnWrapper<DT>(wrapper, arr, rows[i]);
+  }
+}
+
+}  // namespace
+
+RadixJoinHashTable::RadixJoinHashTable(const std::vector<types::DataType>& key_types,
+                                       const std::vector<types::DataType>& payload_types)
+    : key_types_(key_types), payload_types_(payload_types), partitions_(kNumPartitions) {
+  for (auto& partition : partitions_) {
+    for (const auto& dt : key_types_) {
+      partition.keys.push_back(GroupKeyColumn::Make(dt));
+      DCHECK(partition.keys.back() != nullptr);
+    }
+    for (const auto& dt : payload_types_) {
+      partition.payload.push_back(types::ColumnWrapper::Make(dt, 0));
+    }
+  }
+  partition_offsets_.resize(kNumPartitions + 1);
+}
+
+void RadixJoinHashTable::ReservePartition(Partition* partition, size_t num_new_keys) {
+  size_t needed = 2 * (partition->num_keys + num_new_keys);
+  if (needed <= partition->slots.size()) {
+    return;
+  }
+  size_t new_size = std::max(kMinPartitionSlots, partition->slots.size());
+  while (new_size < needed) {
+    new_size *= 2;
+  }
+
+  std::vector<Slot> old_slots(new_size, Slot{0, kNoMatch});
+  old_slots.swap(partition->slots);
+  partition->slot_mask = new_size - 1;
+  for (const auto& slot : old_slots) {
+    if (slot.key_id == kNoMatch) {
+      continue;
+    }
+    uint64_t pos = slot.hash & partition->slot_mask;
+    while (partition->slots[pos].key_id != kNoMatch) {
+      pos = (pos + 1) & partition->slot_mask;
+    }
+    partition->slots[pos] = slot;
+  }
+}
+
+void RadixJoinHashTable::HashRows(const std::vector<const arrow::Array*>& key_cols,
+                                  int64_t num_rows) {
+  DCHECK_EQ(key_cols.size(), key_types_.size());
+  hashes_.assign(num_rows, kHashSeed);
+  for (size_t i = 0; i < key_cols.size(); ++i) {
+    partitions_[0].keys[i]->HashBatch(key_cols[i], hashes_.data());
+  }
+  key_ids_.assign(num_rows, kNoMatch);
+  probe_pos_.resize(num_rows);
+}
+
+void RadixJoinHashTable::PartitionRows() {
+  std::fill(partition_offsets_.begin(), partition_offsets_.end(), 0);
+  for (uint32_t row : rows_) {
+    ++partition_offsets_[PartitionOf(hashes_[row]) + 1];
+  }
+  std::partial_sum(partition_offsets_.begin(), partition_offsets_.end(),
+                   partition_offsets_.begin());
+
+  partitioned_rows_.resize(rows_.size());
+  partition_cursors_.assign(partition_offsets_.begin(), partition_offsets_.end() - 1);
+  for (uint32_t row : rows_) {
+    partitioned_rows_[partition_cursors_[PartitionOf(hashes_[row])]++] = row;
+  }
+}
+
+void RadixJoinHashTable::FindKeys(Partition* partition,
+                                  const std::vector<const arrow::Array*>& key_cols,
+                                  const uint32_t* rows, size_t num_rows, bool insert) {
+  pending_.assign(rows, rows + num_rows);
+  for (uint32_t row : pending_) {
+    probe_pos_[row] = hashes_[row] & partition->slot_mask;
+  }
+
+  while (!pending_.empty()) {
+    to_compare_.clear();
+    for (uint32_t row : pending_) {
+      uint64_t hash = hashes_[row];
+      uint64_t pos = probe_pos_[row];
+      while (true) {
+        Slot& slot = partition->slots[pos];
+        if (slot.key_id == kNoMatch) {
+          if (insert) {
+            uint32_t key_id = partition->num_keys++;
+            for (size_t i = 0; i < key_cols.size(); ++i) {
+              partition->keys[i]->Append(key_cols[i], row);
+            }
+            slot = {hash, key_id};
+            key_ids_[row] = key_id;
+          } else {
+            key_ids_[row] = kNoMatch;
+          }
+          break;
+        }
+        if (slot.hash == hash) {
+          key_ids_[row] = slot.key_id;
+          probe_pos_[row] = pos;
+          to_compare_.push_back(row);
+          break;
+        }
+        pos = (pos + 1) & partition->slot_mask;
+      }
+    }
+
+    matches_.assign(to_compare_.size(), 1);
+    for (size_t i = 0; i < key_cols.size(); ++i) {
+      partition->keys[i]->CompareBatch(key_cols[i], key_ids_.data(), to_compare_.data(),
+                                       to_compare_.size(), matches_.data());
+    }
+
+    // Rows that had a hash collision continue probing from the next slot.
+    pending_.clear();
+    for (size_t i = 0; i < to_compare_.size(); ++i) {
+      if (!matches_[i]) {
+        uint32_t row = to_compare_[i];
+        probe_pos_[row] = (probe_pos_[row] + 1) & partition->slot_mask;
+        pending_.push_back(row);
+      }
+    }
+  }
+}
+
+Status RadixJoinHashTable::AddBuildBatch(const std::vector<const arrow::Array*>& key_cols,
+                                         const std::vector<arrow::Array*>& payload_cols,
+                                         int64_t num_rows) {
+  DCHECK(!finalized_);
+  DCHECK_EQ(payload_cols.size(), payload_types_.size());
+  if (num_rows == 0) {
+    return Status::OK();
+  }
+  if (num_build_rows_ + num_rows >= kNoMatch) {
+    return error::ResourceUnavailable("Too many build rows for the radix join: $0",
+                                      num_build_rows_ + num_rows);
+  }
+
+  HashRows(key_cols, num_rows);
+  rows_.resize(num_rows);
+  std::iota(rows_.begin(), rows_.end(), 0);
+  PartitionRows();
+
+  for (size_t p = 0; p < kNumPartitions; ++p) {
+    const uint32_t* rows = partitioned_rows_.data() + partition_offsets_[p];
+    size_t partition_rows = partition_offsets_[p + 1] - partition_offsets_[p];
+    if (partition_rows == 0) {
+      continue;
+    }
+    Partition& partition = partitions_[p];
+    ReservePartition(&partition, partition_rows);
+    FindKeys(&partition, key_cols, rows, partition_rows, /* insert */ true);
+
+    partition.key_counts.resize(partition.num_keys);
+    for (size_t i = 0; i < partition_rows; ++i) {
+      uint32_t key_id = key_ids_[rows[i]];
+      partition.row_key_ids.push_back(key_id);
+      ++partition.key_counts[key_id];
+    }
+    for (size_t i = 0; i < payload_cols.size(); ++i) {
+#define TYPE_CASE(_dt_)                                                                        \
+  AppendRowsToWrapper<_dt_>(partition.payload[i].get(), payload_cols[i], rows, partition_rows)
+      PX_SWITCH_FOREACH_DATATYPE(payload_types_[i], TYPE_CASE);
+#undef TYPE_CASE
+    }
+  }
+  num_build_rows_ += num_rows;
+  return Status::OK();
+}
+
+void RadixJoinHashTable::FinalizeBuild() {
+  DCHECK(!finalized_);
+  finalized_ = true;
+
+  std::vector<size_t> order;
+  std::vector<int64_t> cursors;
+  for (auto& partition : partitions_) {
+    partition.key_offsets.resize(partition.num_keys + 1);
+    partition.key_offsets[0] = 0;
+    std::partial_sum(partition.key_counts.begin(), partition.key_counts.end(),
+                     partition.key_offsets.begin() + 1);
+    partition.matched.assign(partition.num_keys, 0);
+
+    // Stable counting sort of the payload rows by key id.
+    cursors.assign(partition.key_offsets.begin(), partition.key_offsets.end() - 1);
+    order.resize(partition.row_key_ids.size());
+    for (size_t row = 0; row < partition.row_key_ids.size(); ++row) {
+      order[cursors[partition.row_key_ids[row]]++] = row;
+    }
+    for (auto& col : partition.payload) {
+      col = col->MoveIndexes(order);
+    }
+
+    std::vector<uint32_t>().swap(partition.row_key_ids);
+    std::vector<int64_t>().swap(partition.key_counts);
+  }
+  BuildBloomFilter();
+}
+
+void RadixJoinHashTable::BuildBloomFilter() {
+  size_t num_keys = 0;
+  for (const auto& partition : partitions_) {
+    num_keys += partition.num_keys;
+  }
+  // Aim for 16 bits per key, which keeps the false positive rate at a couple of percent.
+  size_t num_blocks = 1;
+  while (num_blocks < kMaxBloomBlocks && num_blocks * 4 < num_keys) {
+    num_blocks *= 2;
+  }
+  bloom_.assign(num_blocks, 0);
+  bloom_mask_ = num_blocks - 1;
+  for (const auto& partition : partitions_) {
+    for (const auto& slot : partition.slots) {
+      if (slot.key_id != kNoMatch) {
+        bloom_[(slot.hash >> kBloomBlockShift) & bloom_mask_] |= BloomBits(slot.hash);
+      }
+    }
+  }
+}
+
+bool RadixJoinHashTable::BloomMayContain(uint64_t hash) const {
+  uint64_t bits = BloomBits(hash);
+  return (bloom_[(hash >> kBloomBlockShift) & bloom_mask_] & bits) == bits;
+}
+
+void RadixJoinHashTable::ProbeBatch(const std::vector<const arrow::Array*>& key_cols,
+                                    int64_t num_rows) {
+  DCHECK(finalized_);
+  HashRows(key_cols, num_rows);
+  probe_partitions_.resize(num_rows);
+
+  rows_.clear();
+  for (int64_t row = 0; row < num_rows; ++row) {
+    probe_partitions_[row] = PartitionOf(hashes_[row]);
+    if (BloomMayContain(hashes_[row])) {
+      rows_.push_back(row);
+    }
+  }
+  PartitionRows();
+
+  for (size_t p = 0; p < kNumPartitions; ++p) {
+    size_t partition_rows = partition_offsets_[p + 1] - partition_offsets_[p];
+    if (partition_rows == 0 || partitions_[p].num_keys == 0) {
+      continue;
+    }
+    FindKeys(&partitions_[p], key_cols, partitioned_rows_.data() + partition_offsets_[p],
+             partition_rows, /* insert */ false);
+  }
+}
+
+int64_t RadixJoinHashTable::Bytes() const {
+  int64_t bytes = bloom_.capacity() * sizeof(uint64_t);
+  for (const auto& partition : partitions_) {
+    bytes += partition.slots.capacity() * sizeof(Slot);
+    bytes += partition.key_offsets.capacity() * sizeof(int64_t);
+    for (const auto& key : partition.keys) {
+      bytes += key->Bytes();
+    }
+    for (const auto& col : partition.payload) {
+      bytes += col->Bytes();
+    }
+  }
+  return bytes;
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
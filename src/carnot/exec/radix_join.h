@@ -0,0 +1,165 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <arrow/array.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "src/carnot/exec/vectorized_agg.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/column_wrapper.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * RadixJoinHashTable holds the build side of a radix partitioned equijoin.
+ *
+ * Build rows are split into partitions by the top bits of the key hash. Each partition has its
+ * own small open addressing table that maps keys to dense key ids, and its own payload columns.
+ * Once the build side is complete, the payload of each partition is reordered so that all the
+ * rows of a key are contiguous, which means that a match is just a [start, start + num_rows)
+ * range in the partition's payload.
+ *
+ * Probing is done a batch at a time:
+ * 1. Hash the key columns of the batch one column at a time.
+ * 2. Drop the rows that the bloom filter rules out.
+ * 3. Group the remaining rows by partition and look them up one partition at a time, so that
+ *    the working set of each lookup is a single partition table.
+ */
+class RadixJoinHashTable {
+ public:
+  static constexpr int kRadixBits = 6;
+  static constexpr size_t kNumPartitions = 1 << kRadixBits;
+  static constexpr uint32_t kNoMatch = std::numeric_limits<uint32_t>::max();
+
+  RadixJoinHashTable(const std::vector<types::DataType>& key_types,
+                     const std::vector<types::DataType>& payload_types);
+
+  /**
+   * Adds a batch of build rows.
+   * @param key_cols the join key columns, in the same order as the key types.
+   * @param payload_cols the build columns that are outputted by the join.
+   * @param num_rows the number of rows in the batch.
+   */
+  Status AddBuildBatch(const std::vector<const arrow::Array*>& key_cols,
+                       const std::vector<arrow::Array*>& payload_cols, int64_t num_rows);
+
+  /**
+   * Lays out the payload of every partition contiguously by key and builds the bloom filter.
+   * Must be called once all the build rows have been added and before probing.
+   */
+  void FinalizeBuild();
+
+  /**
+   * Looks up the keys of a batch of probe rows. Afterwards, probe_key_ids()[i] holds the id of
+   * the matching key in partition probe_partitions()[i], or kNoMatch.
+   */
+  void ProbeBatch(const std::vector<const arrow::Array*>& key_cols, int64_t num_rows);
+
+  const std::vector<uint32_t>& probe_partitions() const { return probe_partitions_; }
+  const std::vector<uint32_t>& probe_key_ids() const { return key_ids_; }
+
+  size_t NumKeys(size_t partition) const { return partitions_[partition].num_keys; }
+  int64_t KeyRowsStart(size_t partition, uint32_t key_id) const {
+    return partitions_[partition].key_offsets[key_id];
+  }
+  int64_t KeyNumRows(size_t partition, uint32_t key_id) const {
+    const auto& offsets = partitions_[partition].key_offsets;
+    return offsets[key_id + 1] - offsets[key_id];
+  }
+  std::vector<types::SharedColumnWrapper>* Payload(size_t partition) {
+    return &partitions_[partition].payload;
+  }
+
+  // Tracks which keys were probed, for joins that emit the unmatched build rows.
+  void MarkMatched(size_t partition, uint32_t key_id) {
+    partitions_[partition].matched[key_id] = 1;
+  }
+  bool IsMatched(size_t partition, uint32_t key_id) const {
+    return partitions_[partition].matched[key_id];
+  }
+
+  int64_t NumBuildRows() const { return num_build_rows_; }
+  int64_t Bytes() const;
+
+ private:
+  struct Slot {
+    uint64_t hash;
+    uint32_t key_id;
+  };
+
+  struct Partition {
+    std::vector<std::unique_ptr<GroupKeyColumn>> keys;
+    std::vector<Slot> slots;
+    uint64_t slot_mask = 0;
+    size_t num_keys = 0;
+
+    // While building, the key id of each payload row and the number of rows of each key.
+    std::vector<uint32_t> row_key_ids;
+    std::vector<int64_t> key_counts;
+    // Once the build is finalized, the rows of key k are [key_offsets[k], key_offsets[k + 1]).
+    std::vector<int64_t> key_offsets;
+    std::vector<types::SharedColumnWrapper> payload;
+    std::vector<uint8_t> matched;
+  };
+
+  void ReservePartition(Partition* partition, size_t num_new_keys);
+  void HashRows(const std::vector<const arrow::Array*>& key_cols, int64_t num_rows);
+  // Stable counting sort of rows_ by partition into partitioned_rows_.
+  void PartitionRows();
+  // Sets key_ids_ of the given rows, inserting the keys that are missing if insert is set.
+  void FindKeys(Partition* partition, const std::vector<const arrow::Array*>& key_cols,
+                const uint32_t* rows, size_t num_rows, bool insert);
+  void BuildBloomFilter();
+  bool BloomMayContain(uint64_t hash) const;
+
+  std::vector<types::DataType> key_types_;
+  std::vector<types::DataType> payload_types_;
+  std::vector<Partition> partitions_;
+  int64_t num_build_rows_ = 0;
+  bool finalized_ = false;
+
+  // Blocked bloom filter over the build key hashes, one 64 bit word per block.
+  std::vector<uint64_t> bloom_;
+  uint64_t bloom_mask_ = 0;
+
+  // Scratch space reused across batches.
+  std::vector<uint64_t> hashes_;
+  std::vector<uint32_t> key_ids_;
+  std::vector<uint32_t> probe_partitions_;
+  std::vector<uint32_t> rows_;
+  std::vector<uint32_t> partitioned_rows_;
+  std::vector<size_t> partition_offsets_;
+  std::vector<size_t> partition_cursors_;
+  std::vector<uint64_t> probe_pos_;
+  std::vector<uint32_t> pending_;
+  std::vector<uint32_t> to_compare_;
+  std::vector<uint8_t> matches_;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
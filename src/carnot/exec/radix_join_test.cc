@@ -0,0 +1,130 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/radix_join.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+template <typename TValue>
+std::shared_ptr<arrow::Array> MakeArray(const std::vector<TValue>& vals) {
+  return types::ToArrow(vals, arrow::default_memory_pool());
+}
+
+// Returns the payload values of the build rows that match probe row idx.
+std::vector<int64_t> MatchedValues(RadixJoinHashTable* table, int64_t idx) {
+  std::vector<int64_t> out;
+  auto key_id = table->probe_key_ids()[idx];
+  if (key_id == RadixJoinHashTable::kNoMatch) {
+    return out;
+  }
+  auto partition = table->probe_partitions()[idx];
+  auto start = table->KeyRowsStart(partition, key_id);
+  const auto& col = table->Payload(partition)->at(0);
+  for (int64_t i = 0; i < table->KeyNumRows(partition, key_id); ++i) {
+    out.push_back(col->Get<types::Int64Value>(start + i).val);
+  }
+  return out;
+}
+
+TEST(RadixJoinHashTableTest, rows_are_grouped_by_key) {
+  RadixJoinHashTable table({types::STRING, types::INT64}, {types::INT64});
+
+  auto svc1 = MakeArray<types::StringValue>({"a", "b", "a", "a"});
+  auto code1 = MakeArray<types::Int64Value>({200, 200, 500, 200});
+  auto vals1 = MakeArray<types::Int64Value>({1, 2, 3, 4});
+  ASSERT_OK(table.AddBuildBatch({svc1.get(), code1.get()}, {vals1.get()}, 4));
+
+  auto svc2 = MakeArray<types::StringValue>({"b", "a"});
+  auto code2 = MakeArray<types::Int64Value>({200, 200});
+  auto vals2 = MakeArray<types::Int64Value>({5, 6});
+  ASSERT_OK(table.AddBuildBatch({svc2.get(), code2.get()}, {vals2.get()}, 2));
+  table.FinalizeBuild();
+  EXPECT_EQ(6, table.NumBuildRows());
+
+  auto probe_svc = MakeArray<types::StringValue>({"a", "c", "b", "a", "a"});
+  auto probe_code = MakeArray<types::Int64Value>({200, 200, 200, 500, 404});
+  table.ProbeBatch({probe_svc.get(), probe_code.get()}, 5);
+
+  // The build rows of a key keep the order they were added in.
+  EXPECT_EQ(std::vector<int64_t>({1, 4, 6}), MatchedValues(&table, 0));
+  EXPECT_EQ(std::vector<int64_t>(), MatchedValues(&table, 1));
+  EXPECT_EQ(std::vector<int64_t>({2, 5}), MatchedValues(&table, 2));
+  EXPECT_EQ(std::vector<int64_t>({3}), MatchedValues(&table, 3));
+  EXPECT_EQ(std::vector<int64_t>(), MatchedValues(&table, 4));
+}
+
+TEST(RadixJoinHashTableTest, many_keys) {
+  constexpr int64_t kNumKeys = 50000;
+  RadixJoinHashTable table({types::INT64}, {types::INT64});
+
+  std::vector<types::Int64Value> keys;
+  std::vector<types::Int64Value> vals;
+  for (int64_t i = 0; i < kNumKeys; ++i) {
+    keys.emplace_back(i * 7919);
+    vals.emplace_back(i);
+  }
+  auto keys_arr = MakeArray(keys);
+  auto vals_arr = MakeArray(vals);
+  ASSERT_OK(table.AddBuildBatch({keys_arr.get()}, {vals_arr.get()}, kNumKeys));
+  table.FinalizeBuild();
+
+  size_t num_keys = 0;
+  for (size_t p = 0; p < RadixJoinHashTable::kNumPartitions; ++p) {
+    num_keys += table.NumKeys(p);
+  }
+  EXPECT_EQ(static_cast<size_t>(kNumKeys), num_keys);
+
+  // Every other probe key is missing from the build side.
+  std::vector<types::Int64Value> probe_keys;
+  for (int64_t i = 0; i < kNumKeys; ++i) {
+    probe_keys.emplace_back(i % 2 == 0 ? i * 7919 : i * 7919 + 1);
+  }
+  auto probe_arr = MakeArray(probe_keys);
+  table.ProbeBatch({probe_arr.get()}, kNumKeys);
+  for (int64_t i = 0; i < kNumKeys; ++i) {
+    if (i % 2 == 0) {
+      EXPECT_EQ(std::vector<int64_t>({i}), MatchedValues(&table, i));
+    } else {
+      EXPECT_EQ(RadixJoinHashTable::kNoMatch, table.probe_key_ids()[i]);
+    }
+  }
+}
+
+TEST(RadixJoinHashTableTest, empty_build) {
+  RadixJoinHashTable table({types::INT64}, {});
+  table.FinalizeBuild();
+
+  auto probe_arr = MakeArray<types::Int64Value>({1, 2, 3});
+  table.ProbeBatch({probe_arr.get()}, 3);
+  EXPECT_EQ(std::vector<uint32_t>(3, RadixJoinHashTable::kNoMatch), table.probe_key_ids());
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,359 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/rolling_node.h"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include <absl/strings/substitute.h>
+#include <magic_enum.hpp>
+
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/type_utils.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+
+namespace {
+
+// The number of groups before the expired groups are first pruned.
+constexpr size_t kMinGroupsToPrune = 1024;
+
+template <types::DataType DT>
+typename types::DataTypeTraits<DT>::native_type ValueAt(const arrow::Array* arr, int64_t row) {
+  return static_cast<const typename types::DataTypeTraits<DT>::arrow_array_type*>(arr)->Value(row);
+}
+
+// Keeps the values in the window along with their running sum, which is updated as values enter
+// and leave the window.
+template <types::DataType DT, bool kMean>
+class SumWindow final : public RollingWindow {
+  using T = typename types::DataTypeTraits<DT>::native_type;
+
+ public:
+  void Add(int64_t time, const arrow::Array* arg, int64_t row) override {
+    T val = ValueAt<DT>(arg, row);
+    entries_.emplace_back(time, val);
+    sum_ += val;
+  }
+
+  void Evict(int64_t cutoff) override {
+    while (!entries_.empty() && entries_.front().first <= cutoff) {
+      sum_ -= entries_.front().second;
+      entries_.pop_front();
+    }
+    // Don't carry floating point error over to the next values in the group.
+    if (entries_.empty()) {
+      sum_ = 0;
+    }
+  }
+
+  void UnsafeAppend(arrow::ArrayBuilder* builder) const override {
+    if constexpr (kMean) {
+      static_cast<arrow::DoubleBuilder*>(builder)->UnsafeAppend(static_cast<double>(sum_) /
+                                                                entries_.size());
+    } else {
+      static_cast<typename types::DataTypeTraits<DT>::arrow_builder_type*>(builder)->UnsafeAppend(
+          sum_);
+    }
+  }
+
+ private:
+  std::deque<std::pair<int64_t, T>> entries_;
+  T sum_ = 0;
+};
+
+class CountWindow final : public RollingWindow {
+ public:
+  void Add(int64_t time, const arrow::Array*, int64_t) override { times_.push_back(time); }
+
+  void Evict(int64_t cutoff) override {
+    while (!times_.empty() && times_.front() <= cutoff) {
+      times_.pop_front();
+    }
+  }
+
+  void UnsafeAppend(arrow::ArrayBuilder* builder) const override {
+    static_cast<arrow::Int64Builder*>(builder)->UnsafeAppend(times_.size());
+  }
+
+ private:
+  std::deque<int64_t> times_;
+};
+
+// Keeps a monotonic queue of the values in the window: a value is dropped as soon as a later value
+// is at least as extreme, since it can't be the extremum of any window that is still to come. The
+// front of the queue is the extremum of the current window.
+template <types::DataType DT, bool kMax>
+class ExtremumWindow final : public RollingWindow {
+  using T = typename types::DataTypeTraits<DT>::native_type;
+
+ public:
+  void Add(int64_t time, const arrow::Array* arg, int64_t row) override {
+    T val = ValueAt<DT>(arg, row);
+    while (!entries_.empty() &&
+           (kMax ? entries_.back().second <= val : entries_.back().second >= val)) {
+      entries_.pop_back();
+    }
+    entries_.emplace_back(time, val);
+  }
+
+  void Evict(int64_t cutoff) override {
+    while (!entries_.empty() && entries_.front().first <= cutoff) {
+      entries_.pop_front();
+    }
+  }
+
+  void UnsafeAppend(arrow::ArrayBuilder* builder) const override {
+    DCHECK(!entries_.empty());
+    static_cast<typename types::DataTypeTraits<DT>::arrow_builder_type*>(builder)->UnsafeAppend(
+        entries_.front().second);
+  }
+
+ private:
+  std::deque<std::pair<int64_t, T>> entries_;
+};
+
+template <template <types::DataType> class TWindow>
+StatusOr<std::unique_ptr<RollingWindow>> CreateWindow(types::DataType arg_type) {
+  switch (arg_type) {
+    case types::INT64:
+      return std::unique_ptr<RollingWindow>(new TWindow<types::INT64>());
+    case types::FLOAT64:
+      return std::unique_ptr<RollingWindow>(new TWindow<types::FLOAT64>());
+    case types::TIME64NS:
+      return std::unique_ptr<RollingWindow>(new TWindow<types::TIME64NS>());
+    default:
+      return error::InvalidArgument("Unsupported rolling window type $0",
+                                    types::ToString(arg_type));
+  }
+}
+
+template <types::DataType DT>
+using RollingSum = SumWindow<DT, false>;
+template <types::DataType DT>
+using RollingMean = SumWindow<DT, true>;
+template <types::DataType DT>
+using RollingMin = ExtremumWindow<DT, false>;
+template <types::DataType DT>
+using RollingMax = ExtremumWindow<DT, true>;
+
+const int64_t* WindowTimes(const arrow::Array* col) {
+  if (col->type_id() == arrow::Type::TIME64) {
+    return static_cast<const arrow::Time64Array*>(col)->raw_values();
+  }
+  return static_cast<const arrow::Int64Array*>(col)->raw_values();
+}
+
+}  // namespace
+
+StatusOr<std::unique_ptr<RollingWindow>> RollingWindow::Create(
+    planpb::RollingOperator::Function function, types::DataType arg_type) {
+  // Checks that the function supports arg_type.
+  PX_RETURN_IF_ERROR(plan::RollingOperator::ValueDataType(function, arg_type));
+  switch (function) {
+    case planpb::RollingOperator::COUNT:
+      return std::unique_ptr<RollingWindow>(new CountWindow());
+    case planpb::RollingOperator::SUM:
+      return CreateWindow<RollingSum>(arg_type);
+    case planpb::RollingOperator::MEAN:
+      return CreateWindow<RollingMean>(arg_type);
+    case planpb::RollingOperator::MIN:
+      return CreateWindow<RollingMin>(arg_type);
+    case planpb::RollingOperator::MAX:
+      return CreateWindow<RollingMax>(arg_type);
+    default:
+      return error::InvalidArgument("Unknown rolling function $0",
+                                    magic_enum::enum_name(function));
+  }
+}
+
+std::string RollingNode::DebugStringImpl() {
+  return absl::Substitute("Exec::RollingNode<$0>", plan_node_->DebugString());
+}
+
+Status RollingNode::InitImpl(const plan::Operator& plan_node) {
+  CHECK(plan_node.op_type() == planpb::OperatorType::ROLLING_OPERATOR);
+  const auto* rolling_plan_node = static_cast<const plan::RollingOperator*>(&plan_node);
+  // copy the plan node to local object;
+  plan_node_ = std::make_unique<plan::RollingOperator>(*rolling_plan_node);
+
+  DCHECK_EQ(input_descriptors_.size(), 1U);
+  const auto& input_descriptor = input_descriptors_[0];
+  for (int64_t col_idx : plan_node_->groups()) {
+    group_data_types_.push_back(input_descriptor.type(col_idx));
+  }
+  for (const auto& value : plan_node_->values()) {
+    types::DataType arg_type = value.function() == planpb::RollingOperator::COUNT
+                                   ? types::INT64
+                                   : input_descriptor.type(value.arg().index());
+    PX_ASSIGN_OR_RETURN(auto value_type,
+                        plan::RollingOperator::ValueDataType(value.function(), arg_type));
+    arg_data_types_.push_back(arg_type);
+    value_data_types_.push_back(value_type);
+  }
+  return Status::OK();
+}
+
+Status RollingNode::PrepareImpl(ExecState* /*exec_state*/) { return Status::OK(); }
+
+Status RollingNode::OpenImpl(ExecState* /*exec_state*/) {
+  lookup_key_ = std::make_unique<RowTuple>(&group_data_types_);
+  if (plan_node_->groups().empty()) {
+    PX_ASSIGN_OR_RETURN(no_groups_state_, CreateGroupState(nullptr));
+  }
+  return Status::OK();
+}
+
+Status RollingNode::CloseImpl(ExecState* /*exec_state*/) {
+  groups_.clear();
+  dropped_groups_.clear();
+  no_groups_state_.reset();
+  return Status::OK();
+}
+
+StatusOr<std::unique_ptr<RollingNode::GroupState>> RollingNode::CreateGroupState(
+    std::unique_ptr<RowTuple> key) {
+  auto state = std::make_unique<GroupState>();
+  state->key = std::move(key);
+  state->last_time = std::numeric_limits<int64_t>::min();
+  for (const auto& [i, value] : Enumerate(plan_node_->values())) {
+    PX_ASSIGN_OR_RETURN(auto window, RollingWindow::Create(value.function(), arg_data_types_[i]));
+    state->windows.push_back(std::move(window));
+  }
+  return state;
+}
+
+StatusOr<RollingNode::GroupState*> RollingNode::FindOrCreateGroup(const RowBatch& rb, int64_t row,
+                                                                  int64_t time) {
+  if (no_groups_state_ != nullptr) {
+    return no_groups_state_.get();
+  }
+  lookup_key_->Reset();
+  for (const auto& [i, col_idx] : Enumerate(plan_node_->groups())) {
+    auto col = rb.ColumnAt(col_idx).get();
+#define TYPE_CASE(_dt_) ExtractIntoRowTuple<_dt_>(lookup_key_.get(), col, i, row);
+    PX_SWITCH_FOREACH_DATATYPE(group_data_types_[i], TYPE_CASE);
+#undef TYPE_CASE
+  }
+  auto it = groups_.find(lookup_key_.get());
+  if (it != groups_.end()) {
+    return it->second.get();
+  }
+  // A group that was dropped starts over from empty windows, unless the window of the row
+  // reaches back to the rows that were dropped with it.
+  std::unique_ptr<RowTuple> key;
+  int64_t last_time = std::numeric_limits<int64_t>::min();
+  auto dropped_it = dropped_groups_.find(lookup_key_.get());
+  if (dropped_it != dropped_groups_.end()) {
+    last_time = dropped_it->second->last_time;
+    if (last_time > time - plan_node_->window_size()) {
+      return error::InvalidArgument(
+          "Rolling window input is not ordered on the window column: got a row at $0 whose window "
+          "includes rows of its group that were dropped, the last of which was at $1",
+          time, last_time);
+    }
+    key = std::move(dropped_it->second->key);
+    dropped_groups_.erase(dropped_it);
+  } else {
+    key = std::move(lookup_key_);
+    lookup_key_ = std::make_unique<RowTuple>(&group_data_types_);
+  }
+  RowTuple* key_ptr = key.get();
+  PX_ASSIGN_OR_RETURN(auto state, CreateGroupState(std::move(key)));
+  state->last_time = last_time;
+  GroupState* state_ptr = state.get();
+  groups_.emplace(key_ptr, std::move(state));
+  return state_ptr;
+}
+
+void RollingNode::PruneExpiredGroups() {
+  int64_t cutoff = max_time_ - plan_node_->window_size();
+  for (auto it = groups_.begin(); it != groups_.end();) {
+    if (it->second->last_time <= cutoff) {
+      std::unique_ptr<GroupState> state = std::move(it->second);
+      groups_.erase(it++);
+      state->windows = {};
+      RowTuple* key = state->key.get();
+      dropped_groups_.emplace(key, std::move(state));
+    } else {
+      ++it;
+    }
+  }
+  num_groups_after_prune_ = groups_.size();
+}
+
+Status RollingNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
+  int64_t num_rows = rb.num_rows();
+  int64_t window_size = plan_node_->window_size();
+  const int64_t* times = WindowTimes(rb.ColumnAt(plan_node_->window_col()).get());
+
+  std::vector<const arrow::Array*> args;
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> builders;
+  for (const auto& [i, value] : Enumerate(plan_node_->values())) {
+    args.push_back(value.function() == planpb::RollingOperator::COUNT
+                       ? nullptr
+                       : rb.ColumnAt(value.arg().index()).get());
+    builders.push_back(types::MakeArrowBuilder(value_data_types_[i], exec_state->exec_mem_pool()));
+    PX_RETURN_IF_ERROR(builders.back()->Reserve(num_rows));
+  }
+
+  for (int64_t row = 0; row < num_rows; ++row) {
+    int64_t time = times[row];
+    PX_ASSIGN_OR_RETURN(GroupState * group, FindOrCreateGroup(rb, row, time));
+    int64_t cutoff = time - window_size;
+    group->last_time = std::max(group->last_time, time);
+    input_ordered_ &= time >= max_time_;
+    max_time_ = std::max(max_time_, time);
+    for (const auto& [i, window] : Enumerate(group->windows)) {
+      window->Add(time, args[i], row);
+      window->Evict(cutoff);
+      window->UnsafeAppend(builders[i].get());
+    }
+  }
+
+  // The window and group columns pass through, since every input row has an output row.
+  RowBatch output_rb(*output_descriptor_, num_rows);
+  PX_RETURN_IF_ERROR(output_rb.AddColumn(rb.ColumnAt(plan_node_->window_col())));
+  for (int64_t col_idx : plan_node_->groups()) {
+    PX_RETURN_IF_ERROR(output_rb.AddColumn(rb.ColumnAt(col_idx)));
+  }
+  for (const auto& builder : builders) {
+    std::shared_ptr<arrow::Array> arr;
+    PX_RETURN_IF_ERROR(builder->Finish(&arr));
+    PX_RETURN_IF_ERROR(output_rb.AddColumn(arr));
+  }
+  output_rb.set_eow(rb.eow());
+  output_rb.set_eos(rb.eos());
+
+  if (input_ordered_ &&
+      groups_.size() >= 2 * std::max(num_groups_after_prune_, kMinGroupsToPrune)) {
+    PruneExpiredGroups();
+  }
+  return SendRowBatchToChildren(exec_state, output_rb);
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
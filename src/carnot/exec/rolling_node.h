@@ -0,0 +1,137 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/array.h>
+#include <arrow/builder.h>
+
+#include "src/carnot/exec/exec_node.h"
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/row_tuple.h"
+#include "src/carnot/plan/operators.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/types.h"
+#include "src/table_store/table_store.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * The sliding window of one rolling value in one group.
+ */
+class RollingWindow {
+ public:
+  virtual ~RollingWindow() = default;
+
+  /**
+   * Adds the value in the given row of arg, whose window column is time, to the window.
+   */
+  virtual void Add(int64_t time, const arrow::Array* arg, int64_t row) = 0;
+
+  /**
+   * Removes the values whose window column is <= cutoff from the window.
+   */
+  virtual void Evict(int64_t cutoff) = 0;
+
+  /**
+   * Appends the aggregate of the window to builder, which must have room for it.
+   */
+  virtual void UnsafeAppend(arrow::ArrayBuilder* builder) const = 0;
+
+  static StatusOr<std::unique_ptr<RollingWindow>> Create(
+      planpb::RollingOperator::Function function, types::DataType arg_type);
+};
+
+/**
+ * RollingNode computes sliding window aggregates over a stream. Each input row batch produces an
+ * output row batch with one row per input row, which holds the aggregates of the rows of its group
+ * within the window that ends at the row. The state of the windows is kept across row batches, so
+ * the aggregates are updated incrementally as the stream advances instead of being recomputed for
+ * every window. Sums and counts keep the values in their window in a queue, while minimums and
+ * maximums keep a monotonic queue of the values that can still become the extremum.
+ *
+ * The input must be ordered on the window column within each group. The windows of the groups
+ * whose windows have ended are dropped, which additionally requires the input to be ordered across
+ * groups, since the next row of a group can otherwise still fall into its last window. A row that
+ * goes back in time turns the pruning off for the rest of the stream. Only the key and the last
+ * time of a dropped group are kept, so that a later row of the group whose window reaches back to
+ * the dropped rows fails the query rather than computing its window from an empty state, while
+ * rows of new groups are accepted at any time.
+ */
+class RollingNode : public ProcessingNode {
+ public:
+  RollingNode() = default;
+  virtual ~RollingNode() = default;
+
+ protected:
+  std::string DebugStringImpl() override;
+  Status InitImpl(const plan::Operator& plan_node) override;
+  Status PrepareImpl(ExecState* exec_state) override;
+  Status OpenImpl(ExecState* exec_state) override;
+  Status CloseImpl(ExecState* exec_state) override;
+  Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
+                         size_t parent_index) override;
+
+ private:
+  struct GroupState {
+    // The key of the group in groups_, owned here so that the group can be erased.
+    std::unique_ptr<RowTuple> key;
+    // The window column of the last row added to the group.
+    int64_t last_time = 0;
+    std::vector<std::unique_ptr<RollingWindow>> windows;
+  };
+
+  StatusOr<std::unique_ptr<GroupState>> CreateGroupState(std::unique_ptr<RowTuple> key);
+  // Returns the state of the group of the given row, whose window column is time, creating it if
+  // needed.
+  StatusOr<GroupState*> FindOrCreateGroup(const table_store::schema::RowBatch& rb, int64_t row,
+                                          int64_t time);
+  // Moves the groups whose windows are empty as of max_time_ to dropped_groups_.
+  void PruneExpiredGroups();
+
+  std::unique_ptr<plan::RollingOperator> plan_node_;
+  std::vector<types::DataType> group_data_types_;
+  std::vector<types::DataType> arg_data_types_;
+  std::vector<types::DataType> value_data_types_;
+
+  AbslRowTupleHashMap<std::unique_ptr<GroupState>> groups_;
+  // The groups that were pruned, without their windows.
+  AbslRowTupleHashMap<std::unique_ptr<GroupState>> dropped_groups_;
+  // Used instead of groups_ when the operator has no groups.
+  std::unique_ptr<GroupState> no_groups_state_;
+  // The key that the next row is looked up with. It moves into the group state when the row
+  // starts a new group.
+  std::unique_ptr<RowTuple> lookup_key_;
+  // The largest window column seen so far.
+  int64_t max_time_ = std::numeric_limits<int64_t>::min();
+  // The number of groups after the last pruning, used to prune whenever the groups double.
+  size_t num_groups_after_prune_ = 0;
+  // Whether every row so far came at or after the rows before it, which pruning relies on.
+  bool input_ordered_ = true;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,258 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/rolling_node.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <sole.hpp>
+
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/planpb/test_proto.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/base/base.h"
+#include "src/common/testing/testing.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+using table_store::schema::RowDescriptor;
+using types::Float64Value;
+using types::Int64Value;
+using types::StringValue;
+using types::Time64NSValue;
+
+class RollingNodeTest : public ::testing::Test {
+ public:
+  RollingNodeTest() {
+    func_registry_ = std::make_unique<udf::Registry>("test_registry");
+    auto table_store = std::make_shared<table_store::TableStore>();
+    exec_state_ = std::make_unique<ExecState>(func_registry_.get(), table_store,
+                                              MockResultSinkStubGenerator, MockMetricsStubGenerator,
+                                              MockTraceStubGenerator, sole::uuid4(), nullptr);
+  }
+
+ protected:
+  // A batch with a row of value 1 at the given time for each of the groups.
+  RowBatch GroupsAt(const std::vector<std::string>& groups, int64_t time) {
+    int64_t num_rows = groups.size();
+    return RowBatchBuilder(input_rd_, num_rows, /*eow*/ false, /*eos*/ false)
+        .AddColumn<Time64NSValue>(std::vector<Time64NSValue>(num_rows, time))
+        .AddColumn<StringValue>(std::vector<StringValue>(groups.begin(), groups.end()))
+        .AddColumn<Int64Value>(std::vector<Int64Value>(num_rows, 1))
+        .get();
+  }
+
+  // The output of GroupsAt, where the window of each group holds counts[i] rows.
+  RowBatch WindowsOfOnes(const std::vector<std::string>& groups, int64_t time,
+                         const std::vector<int64_t>& counts) {
+    int64_t num_rows = groups.size();
+    std::vector<Int64Value> count_values(counts.begin(), counts.end());
+    return RowBatchBuilder(output_rd_, num_rows, /*eow*/ false, /*eos*/ false)
+        .AddColumn<Time64NSValue>(std::vector<Time64NSValue>(num_rows, time))
+        .AddColumn<StringValue>(std::vector<StringValue>(groups.begin(), groups.end()))
+        .AddColumn<Int64Value>(count_values)
+        .AddColumn<Int64Value>(count_values)
+        .AddColumn<Float64Value>(std::vector<Float64Value>(num_rows, 1))
+        .AddColumn<Int64Value>(std::vector<Int64Value>(num_rows, 1))
+        .AddColumn<Int64Value>(std::vector<Int64Value>(num_rows, 1))
+        .get();
+  }
+
+  static std::vector<std::string> GroupNames(const std::string& prefix, int64_t num_groups) {
+    std::vector<std::string> groups;
+    for (int64_t i = 0; i < num_groups; ++i) {
+      groups.push_back(absl::StrCat(prefix, i));
+    }
+    return groups;
+  }
+
+  RowDescriptor input_rd_{{types::TIME64NS, types::STRING, types::INT64}};
+  RowDescriptor output_rd_{{types::TIME64NS, types::STRING, types::INT64, types::INT64,
+                            types::FLOAT64, types::INT64, types::INT64}};
+  std::unique_ptr<ExecState> exec_state_;
+  std::unique_ptr<udf::Registry> func_registry_;
+};
+
+TEST_F(RollingNodeTest, grouped_windows_across_batches) {
+  auto plan_node = plan::RollingOperator::FromProto(planpb::testutils::CreateTestRolling1PB(), 1);
+  RowDescriptor output_rd({types::TIME64NS, types::STRING, types::INT64, types::INT64,
+                           types::FLOAT64, types::INT64, types::INT64});
+
+  auto tester = exec::ExecNodeTester<RollingNode, plan::RollingOperator>(
+      *plan_node, output_rd, {input_rd_}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Time64NSValue>({1, 2, 5, 11})
+                       .AddColumn<StringValue>({"a", "b", "a", "a"})
+                       .AddColumn<Int64Value>({3, 7, 1, 4})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 4, false, false)
+                          .AddColumn<Time64NSValue>({1, 2, 5, 11})
+                          .AddColumn<StringValue>({"a", "b", "a", "a"})
+                          .AddColumn<Int64Value>({3, 7, 4, 5})
+                          .AddColumn<Int64Value>({1, 1, 2, 2})
+                          .AddColumn<Float64Value>({3, 7, 2, 2.5})
+                          .AddColumn<Int64Value>({3, 7, 1, 1})
+                          .AddColumn<Int64Value>({3, 7, 3, 4})
+                          .get())
+      // The windows of the second batch include the rows of the first one.
+      .ConsumeNext(RowBatchBuilder(input_rd_, 3, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Time64NSValue>({12, 16, 30})
+                       .AddColumn<StringValue>({"b", "a", "a"})
+                       .AddColumn<Int64Value>({2, 9, 5})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 3, true, true)
+                          .AddColumn<Time64NSValue>({12, 16, 30})
+                          .AddColumn<StringValue>({"b", "a", "a"})
+                          .AddColumn<Int64Value>({2, 13, 5})
+                          .AddColumn<Int64Value>({1, 2, 1})
+                          .AddColumn<Float64Value>({2, 6.5, 5})
+                          .AddColumn<Int64Value>({2, 4, 5})
+                          .AddColumn<Int64Value>({2, 9, 5})
+                          .get())
+      .Close();
+}
+
+TEST_F(RollingNodeTest, no_groups) {
+  auto op_proto = planpb::testutils::CreateTestRolling1PB();
+  op_proto.mutable_rolling_op()->clear_groups();
+  op_proto.mutable_rolling_op()->clear_group_names();
+  op_proto.mutable_rolling_op()->set_window_size(3);
+  auto plan_node = plan::RollingOperator::FromProto(op_proto, 1);
+  RowDescriptor output_rd(
+      {types::TIME64NS, types::INT64, types::INT64, types::FLOAT64, types::INT64, types::INT64});
+
+  // The minimum and maximum have to fall back to older values as the extremes leave the window.
+  auto tester = exec::ExecNodeTester<RollingNode, plan::RollingOperator>(
+      *plan_node, output_rd, {input_rd_}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_, 5, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Time64NSValue>({0, 1, 2, 3, 4})
+                       .AddColumn<StringValue>({"a", "b", "c", "d", "e"})
+                       .AddColumn<Int64Value>({5, 3, 4, 1, 2})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 5, true, true)
+                          .AddColumn<Time64NSValue>({0, 1, 2, 3, 4})
+                          .AddColumn<Int64Value>({5, 8, 12, 8, 7})
+                          .AddColumn<Int64Value>({1, 2, 3, 3, 3})
+                          .AddColumn<Float64Value>({5, 4, 4, 8.0 / 3, 7.0 / 3})
+                          .AddColumn<Int64Value>({5, 3, 3, 1, 1})
+                          .AddColumn<Int64Value>({5, 5, 5, 4, 4})
+                          .get())
+      .Close();
+}
+
+// Enough groups for the node to prune the ones whose windows have ended.
+constexpr int64_t kNumGroups = 1024;
+
+TEST_F(RollingNodeTest, prunes_expired_groups) {
+  auto plan_node = plan::RollingOperator::FromProto(planpb::testutils::CreateTestRolling1PB(), 1);
+  auto old_groups = GroupNames("old", kNumGroups);
+  auto new_groups = GroupNames("new", kNumGroups);
+
+  auto tester = exec::ExecNodeTester<RollingNode, plan::RollingOperator>(
+      *plan_node, output_rd_, {input_rd_}, exec_state_.get());
+  tester.ConsumeNext(GroupsAt(old_groups, 1), 0)
+      .ExpectRowBatch(WindowsOfOnes(old_groups, 1, std::vector<int64_t>(kNumGroups, 1)))
+      // The windows of the old groups have ended by 20, so they are dropped after this batch.
+      .ConsumeNext(GroupsAt(new_groups, 20), 0)
+      .ExpectRowBatch(WindowsOfOnes(new_groups, 20, std::vector<int64_t>(kNumGroups, 1)))
+      .ConsumeNext(GroupsAt({"old0", "new0"}, 25), 0)
+      .ExpectRowBatch(WindowsOfOnes({"old0", "new0"}, 25, {1, 2}))
+      .Close();
+}
+
+TEST_F(RollingNodeTest, out_of_order_input_keeps_groups) {
+  auto plan_node = plan::RollingOperator::FromProto(planpb::testutils::CreateTestRolling1PB(), 1);
+  auto ahead_groups = GroupNames("ahead", kNumGroups);
+  auto behind_groups = GroupNames("behind", kNumGroups);
+
+  // Two sources that are each ordered, but interleaved. The groups of the source that lags behind
+  // must keep their windows even though the other source is far ahead.
+  auto tester = exec::ExecNodeTester<RollingNode, plan::RollingOperator>(
+      *plan_node, output_rd_, {input_rd_}, exec_state_.get());
+  tester.ConsumeNext(GroupsAt(ahead_groups, 1000), 0)
+      .ExpectRowBatch(WindowsOfOnes(ahead_groups, 1000, std::vector<int64_t>(kNumGroups, 1)))
+      .ConsumeNext(GroupsAt(behind_groups, 10), 0)
+      .ExpectRowBatch(WindowsOfOnes(behind_groups, 10, std::vector<int64_t>(kNumGroups, 1)))
+      .ConsumeNext(GroupsAt({"behind0"}, 15), 0)
+      .ExpectRowBatch(WindowsOfOnes({"behind0"}, 15, {2}))
+      .ConsumeNext(GroupsAt({"ahead0"}, 1005), 0)
+      .ExpectRowBatch(WindowsOfOnes({"ahead0"}, 1005, {2}))
+      .Close();
+}
+
+TEST_F(RollingNodeTest, out_of_order_row_of_pruned_group) {
+  auto plan_node = plan::RollingOperator::FromProto(planpb::testutils::CreateTestRolling1PB(), 1);
+  auto behind_groups = GroupNames("behind", kNumGroups);
+  auto ahead_groups = GroupNames("ahead", kNumGroups);
+
+  auto tester = exec::ExecNodeTester<RollingNode, plan::RollingOperator>(
+      *plan_node, output_rd_, {input_rd_}, exec_state_.get());
+  tester.ConsumeNext(GroupsAt(behind_groups, 10), 0)
+      .ExpectRowBatch(WindowsOfOnes(behind_groups, 10, std::vector<int64_t>(kNumGroups, 1)))
+      // The input looks ordered so far, so the groups that are behind are dropped.
+      .ConsumeNext(GroupsAt(ahead_groups, 1000), 0)
+      .ExpectRowBatch(WindowsOfOnes(ahead_groups, 1000, std::vector<int64_t>(kNumGroups, 1)));
+  // The window of the next row includes the dropped row at 10, so it can't be computed.
+  EXPECT_NOT_OK(tester.node()->ConsumeNext(exec_state_.get(), GroupsAt({"behind0"}, 15), 0));
+}
+
+TEST_F(RollingNodeTest, late_row_of_new_group_after_pruning) {
+  auto plan_node = plan::RollingOperator::FromProto(planpb::testutils::CreateTestRolling1PB(), 1);
+  auto behind_groups = GroupNames("behind", kNumGroups);
+  auto ahead_groups = GroupNames("ahead", kNumGroups);
+
+  auto tester = exec::ExecNodeTester<RollingNode, plan::RollingOperator>(
+      *plan_node, output_rd_, {input_rd_}, exec_state_.get());
+  tester.ConsumeNext(GroupsAt(behind_groups, 10), 0)
+      .ExpectRowBatch(WindowsOfOnes(behind_groups, 10, std::vector<int64_t>(kNumGroups, 1)))
+      .ConsumeNext(GroupsAt(ahead_groups, 1000), 0)
+      .ExpectRowBatch(WindowsOfOnes(ahead_groups, 1000, std::vector<int64_t>(kNumGroups, 1)))
+      // A group that didn't exist when the others were dropped may start at any time.
+      .ConsumeNext(GroupsAt({"late"}, 15), 0)
+      .ExpectRowBatch(WindowsOfOnes({"late"}, 15, {1}))
+      .ConsumeNext(GroupsAt({"late"}, 16), 0)
+      .ExpectRowBatch(WindowsOfOnes({"late"}, 16, {2}))
+      // A dropped group whose window doesn't reach back to its dropped rows starts over.
+      .ConsumeNext(GroupsAt({"behind0"}, 1000), 0)
+      .ExpectRowBatch(WindowsOfOnes({"behind0"}, 1000, {1}))
+      .Close();
+}
+
+TEST(RollingWindowTest, unsupported_type) {
+  EXPECT_NOT_OK(RollingWindow::Create(planpb::RollingOperator::SUM, types::STRING));
+  EXPECT_NOT_OK(RollingWindow::Create(planpb::RollingOperator::MEAN, types::TIME64NS));
+  EXPECT_OK(RollingWindow::Create(planpb::RollingOperator::MAX, types::TIME64NS));
+  EXPECT_OK(RollingWindow::Create(planpb::RollingOperator::COUNT, types::STRING));
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
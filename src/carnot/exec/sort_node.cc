@@ -0,0 +1,296 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/sort_node.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <absl/strings/substitute.h>
+
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/type_utils.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+
+namespace {
+
+// The top-k chunks are compacted once they hold this many times as many rows as the heap, and at
+// least kMinRowsToCompact rows, so that the cost of gathering is amortized over many batches.
+constexpr int64_t kCompactionFactor = 4;
+constexpr int64_t kMinRowsToCompact = 64 * 1024;
+
+// Strings are read as views so that comparing and gathering them doesn't copy.
+template <types::DataType DT>
+auto ValueAt(const arrow::Array* arr, int64_t row) {
+  if constexpr (DT == types::STRING) {
+    return types::GetStringViewFromArrowArray(arr, row);
+  } else {
+    using ArrowArrayType = typename types::DataTypeTraits<DT>::arrow_array_type;
+    typename types::DataTypeTraits<DT>::value_type val =
+        static_cast<const ArrowArrayType*>(arr)->Value(row);
+    return val.val;
+  }
+}
+
+// NaNs order after all the other values in both directions and equal to each other, since they
+// don't compare with the < operator.
+template <types::DataType DT, bool kAscending>
+int CompareColumn(const arrow::Array* lhs, int64_t lhs_row, const arrow::Array* rhs,
+                  int64_t rhs_row) {
+  auto lhs_val = ValueAt<DT>(lhs, lhs_row);
+  auto rhs_val = ValueAt<DT>(rhs, rhs_row);
+  if constexpr (std::is_floating_point_v<decltype(lhs_val)>) {
+    bool lhs_nan = std::isnan(lhs_val);
+    bool rhs_nan = std::isnan(rhs_val);
+    if (lhs_nan || rhs_nan) {
+      return static_cast<int>(lhs_nan) - static_cast<int>(rhs_nan);
+    }
+  }
+  int cmp = 0;
+  if (lhs_val < rhs_val) {
+    cmp = -1;
+  } else if (rhs_val < lhs_val) {
+    cmp = 1;
+  }
+  return kAscending ? cmp : -cmp;
+}
+
+}  // namespace
+
+std::string SortNode::DebugStringImpl() {
+  return absl::Substitute("Exec::SortNode<$0>", plan_node_->DebugString());
+}
+
+Status SortNode::InitImpl(const plan::Operator& plan_node) {
+  CHECK(plan_node.op_type() == planpb::OperatorType::SORT_OPERATOR);
+  const auto* sort_plan_node = static_cast<const plan::SortOperator*>(&plan_node);
+  // copy the plan node to local object;
+  plan_node_ = std::make_unique<plan::SortOperator>(*sort_plan_node);
+
+  const auto& input_desc = input_descriptors_[0];
+  retained_cols_.assign(input_desc.size(), false);
+  for (const auto& sort_col : plan_node_->sort_columns()) {
+    SortKey key{sort_col.column().index(), nullptr};
+#define TYPE_CASE(_dt_)                                                            \
+  key.compare = sort_col.ascending() ? &CompareColumn<_dt_, /* kAscending */ true> \
+                                     : &CompareColumn<_dt_, /* kAscending */ false>
+    PX_SWITCH_FOREACH_DATATYPE(input_desc.type(key.col_idx), TYPE_CASE);
+#undef TYPE_CASE
+    sort_keys_.push_back(key);
+    retained_cols_[key.col_idx] = true;
+  }
+  for (int64_t col_idx : plan_node_->selected_cols()) {
+    retained_cols_[col_idx] = true;
+  }
+  return Status::OK();
+}
+
+Status SortNode::PrepareImpl(ExecState* /*exec_state*/) { return Status::OK(); }
+
+Status SortNode::OpenImpl(ExecState* /*exec_state*/) { return Status::OK(); }
+
+Status SortNode::CloseImpl(ExecState* /*exec_state*/) {
+  chunks_.clear();
+  rows_.clear();
+  retained_rows_ = 0;
+  return Status::OK();
+}
+
+bool SortNode::Before(const RowRef& lhs, const RowRef& rhs) const {
+  const Chunk& lhs_chunk = chunks_[lhs.chunk];
+  const Chunk& rhs_chunk = chunks_[rhs.chunk];
+  for (const SortKey& key : sort_keys_) {
+    int cmp = key.compare(lhs_chunk[key.col_idx].get(), lhs.row, rhs_chunk[key.col_idx].get(),
+                          rhs.row);
+    if (cmp != 0) {
+      return cmp < 0;
+    }
+  }
+  return lhs.seq < rhs.seq;
+}
+
+SortNode::Chunk SortNode::MakeChunk(const RowBatch& rb) const {
+  Chunk chunk(retained_cols_.size());
+  for (size_t col_idx = 0; col_idx < retained_cols_.size(); ++col_idx) {
+    if (retained_cols_[col_idx]) {
+      chunk[col_idx] = rb.ColumnAt(col_idx);
+    }
+  }
+  return chunk;
+}
+
+void SortNode::ConsumeAll(const RowBatch& rb) {
+  auto chunk_idx = static_cast<int32_t>(chunks_.size());
+  chunks_.push_back(MakeChunk(rb));
+  rows_.reserve(rows_.size() + rb.num_rows());
+  for (int32_t row = 0; row < rb.num_rows(); ++row) {
+    rows_.push_back({chunk_idx, row, next_seq_++});
+  }
+  retained_rows_ += rb.num_rows();
+}
+
+void SortNode::ConsumeTopK(const RowBatch& rb) {
+  auto limit = static_cast<size_t>(plan_node_->limit());
+  auto chunk_idx = static_cast<int32_t>(chunks_.size());
+  chunks_.push_back(MakeChunk(rb));
+  // The heap orders rows by Before, so its top is the row that sorts last.
+  auto before = [this](const RowRef& lhs, const RowRef& rhs) { return Before(lhs, rhs); };
+
+  bool chunk_used = false;
+  for (int32_t row = 0; row < rb.num_rows(); ++row) {
+    RowRef ref{chunk_idx, row, next_seq_++};
+    if (rows_.size() < limit) {
+      rows_.push_back(ref);
+      std::push_heap(rows_.begin(), rows_.end(), before);
+      chunk_used = true;
+      continue;
+    }
+    if (!Before(ref, rows_.front())) {
+      continue;
+    }
+    std::pop_heap(rows_.begin(), rows_.end(), before);
+    rows_.back() = ref;
+    std::push_heap(rows_.begin(), rows_.end(), before);
+    chunk_used = true;
+  }
+
+  if (!chunk_used) {
+    chunks_.pop_back();
+    return;
+  }
+  retained_rows_ += rb.num_rows();
+}
+
+template <types::DataType DT>
+void SortNode::UnsafeAppendValues(const std::vector<RowRef>& rows, int64_t col_idx,
+                                  arrow::ArrayBuilder* builder) const {
+  auto* typed_builder =
+      static_cast<typename types::DataTypeTraits<DT>::arrow_builder_type*>(builder);
+  for (const RowRef& ref : rows) {
+    auto val = ValueAt<DT>(chunks_[ref.chunk][col_idx].get(), ref.row);
+    if constexpr (DT == types::STRING) {
+      typed_builder->UnsafeAppend(val.data(), static_cast<int32_t>(val.size()));
+    } else {
+      typed_builder->UnsafeAppend(val);
+    }
+  }
+}
+
+StatusOr<std::shared_ptr<arrow::Array>> SortNode::Gather(arrow::MemoryPool* mem_pool,
+                                                         const std::vector<RowRef>& rows,
+                                                         int64_t col_idx) const {
+  auto data_type = input_descriptors_[0].type(col_idx);
+  auto builder = types::MakeArrowBuilder(data_type, mem_pool);
+  PX_RETURN_IF_ERROR(builder->Reserve(rows.size()));
+  if (data_type == types::STRING) {
+    int64_t data_size = 0;
+    for (const RowRef& ref : rows) {
+      data_size += types::GetStringViewFromArrowArray(chunks_[ref.chunk][col_idx].get(), ref.row)
+                       .size();
+    }
+    PX_RETURN_IF_ERROR(static_cast<arrow::StringBuilder*>(builder.get())->ReserveData(data_size));
+  }
+#define TYPE_CASE(_dt_) UnsafeAppendValues<_dt_>(rows, col_idx, builder.get())
+  PX_SWITCH_FOREACH_DATATYPE(data_type, TYPE_CASE);
+#undef TYPE_CASE
+
+  std::shared_ptr<arrow::Array> out;
+  PX_RETURN_IF_ERROR(builder->Finish(&out));
+  return out;
+}
+
+Status SortNode::Compact(arrow::MemoryPool* mem_pool) {
+  Chunk compacted(retained_cols_.size());
+  for (size_t col_idx = 0; col_idx < retained_cols_.size(); ++col_idx) {
+    if (retained_cols_[col_idx]) {
+      PX_ASSIGN_OR_RETURN(compacted[col_idx], Gather(mem_pool, rows_, col_idx));
+    }
+  }
+  chunks_.clear();
+  chunks_.push_back(std::move(compacted));
+  // The heap keeps its order, since the rows keep their values and sequence numbers.
+  for (size_t i = 0; i < rows_.size(); ++i) {
+    rows_[i].chunk = 0;
+    rows_[i].row = static_cast<int32_t>(i);
+  }
+  retained_rows_ = rows_.size();
+  return Status::OK();
+}
+
+Status SortNode::Flush(ExecState* exec_state) {
+  auto before = [this](const RowRef& lhs, const RowRef& rhs) { return Before(lhs, rhs); };
+  if (plan_node_->limit() > 0) {
+    std::sort_heap(rows_.begin(), rows_.end(), before);
+  } else {
+    std::sort(rows_.begin(), rows_.end(), before);
+  }
+
+  if (rows_.empty()) {
+    PX_ASSIGN_OR_RETURN(auto rb, RowBatch::WithZeroRows(*output_descriptor_, /*eow*/ true,
+                                                        /*eos*/ true));
+    return SendRowBatchToChildren(exec_state, *rb);
+  }
+
+  for (size_t start = 0; start < rows_.size(); start += kDefaultSortRowBatchSize) {
+    size_t end = std::min(rows_.size(), start + kDefaultSortRowBatchSize);
+    std::vector<RowRef> batch_rows(rows_.begin() + start, rows_.begin() + end);
+    RowBatch output_rb(*output_descriptor_, batch_rows.size());
+    DCHECK_EQ(output_descriptor_->size(), plan_node_->selected_cols().size());
+    for (int64_t input_col_idx : plan_node_->selected_cols()) {
+      PX_ASSIGN_OR_RETURN(auto col,
+                          Gather(exec_state->exec_mem_pool(), batch_rows, input_col_idx));
+      PX_RETURN_IF_ERROR(output_rb.AddColumn(col));
+    }
+    output_rb.set_eow(end == rows_.size());
+    output_rb.set_eos(end == rows_.size());
+    PX_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, output_rb));
+  }
+  return Status::OK();
+}
+
+Status SortNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
+  int64_t limit = plan_node_->limit();
+  if (limit > 0) {
+    ConsumeTopK(rb);
+    if (chunks_.size() > 1 &&
+        retained_rows_ >= std::max(kMinRowsToCompact, kCompactionFactor * limit)) {
+      PX_RETURN_IF_ERROR(Compact(exec_state->exec_mem_pool()));
+    }
+  } else {
+    ConsumeAll(rb);
+  }
+
+  if (rb.eos()) {
+    return Flush(exec_state);
+  }
+  return Status::OK();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
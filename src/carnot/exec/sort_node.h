@@ -0,0 +1,122 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <arrow/array.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/carnot/exec/exec_node.h"
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/plan/operators.h"
+#include "src/common/base/base.h"
+#include "src/common/base/status.h"
+#include "src/table_store/table_store.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+constexpr size_t kDefaultSortRowBatchSize = 1024;
+
+/**
+ * SortNode buffers its input until the end of the stream, then outputs it ordered by the sort
+ * columns. Input batches are kept as is and only references to their rows are sorted, so the
+ * output columns are gathered once, in order, when the node flushes.
+ *
+ * When the plan has a limit k, the node computes a top-k instead: a bounded heap holds the k rows
+ * that sort first so far, with the row that sorts last at the top, and each input row only has to
+ * be compared against the top. Batches that contribute no rows to the heap are dropped right away,
+ * and the retained batches are compacted into a single batch of the heap rows once they hold many
+ * more rows than k, which bounds the memory of the node by O(k).
+ *
+ * Rows that compare equal keep the order in which they were consumed. NaNs sort last in either
+ * direction.
+ */
+class SortNode : public ProcessingNode {
+ public:
+  SortNode() = default;
+  virtual ~SortNode() = default;
+
+ protected:
+  std::string DebugStringImpl() override;
+  Status InitImpl(const plan::Operator& plan_node) override;
+  Status PrepareImpl(ExecState* exec_state) override;
+  Status OpenImpl(ExecState* exec_state) override;
+  Status CloseImpl(ExecState* exec_state) override;
+  Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
+                         size_t parent_index) override;
+
+ private:
+  // Returns negative, zero or positive if the row at (lhs, lhs_row) orders before, equal to or
+  // after the row at (rhs, rhs_row) in a single column, in the direction of the sort key.
+  using CompareFn = int (*)(const arrow::Array* lhs, int64_t lhs_row, const arrow::Array* rhs,
+                            int64_t rhs_row);
+
+  struct SortKey {
+    int64_t col_idx;
+    CompareFn compare;
+  };
+
+  // A reference to a row of one of the retained chunks. seq is the position of the row in the
+  // input, which breaks ties between rows with equal sort keys.
+  struct RowRef {
+    int32_t chunk;
+    int32_t row;
+    int64_t seq;
+  };
+
+  // The columns of a retained input batch, indexed by input column. Columns that are neither
+  // sorted on nor output are not kept.
+  using Chunk = std::vector<std::shared_ptr<arrow::Array>>;
+
+  // Returns true if lhs orders strictly before rhs.
+  bool Before(const RowRef& lhs, const RowRef& rhs) const;
+
+  void ConsumeAll(const table_store::schema::RowBatch& rb);
+  void ConsumeTopK(const table_store::schema::RowBatch& rb);
+  Chunk MakeChunk(const table_store::schema::RowBatch& rb) const;
+
+  // Gathers the given rows of the input column col_idx into a single array.
+  StatusOr<std::shared_ptr<arrow::Array>> Gather(arrow::MemoryPool* mem_pool,
+                                                 const std::vector<RowRef>& rows,
+                                                 int64_t col_idx) const;
+  template <types::DataType DT>
+  void UnsafeAppendValues(const std::vector<RowRef>& rows, int64_t col_idx,
+                          arrow::ArrayBuilder* builder) const;
+  // Replaces the retained chunks with a single chunk that holds only the rows in the heap.
+  Status Compact(arrow::MemoryPool* mem_pool);
+  Status Flush(ExecState* exec_state);
+
+  std::unique_ptr<plan::SortOperator> plan_node_;
+  std::vector<SortKey> sort_keys_;
+  // Whether each input column has to be retained.
+  std::vector<bool> retained_cols_;
+
+  std::vector<Chunk> chunks_;
+  int64_t retained_rows_ = 0;
+  // All the consumed rows when sorting the whole input, or the heap of the top rows otherwise.
+  std::vector<RowRef> rows_;
+  int64_t next_seq_ = 0;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <sole.hpp>
+
+#include "src/carnot/exec/sort_node.h"
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/types.h"
+
+using px::carnot::exec::MockMetricsStubGenerator;
+using px::carnot::exec::MockResultSinkStubGenerator;
+using px::carnot::exec::MockTraceStubGenerator;
+using px::carnot::exec::RowBatchBuilder;
+using px::carnot::exec::SortNode;
+using px::table_store::schema::RowBatch;
+using px::table_store::schema::RowDescriptor;
+using px::types::DataType;
+
+namespace {
+
+constexpr int64_t kBatchSize = 1024;
+constexpr int64_t kNumRows = 10 * 1000 * 1000;
+
+enum class InputOrder : int64_t {
+  kRandom = 0,
+  // Every row sorts before all of the rows that came before it, so each one enters the heap.
+  kWorstCase = 1,
+};
+
+// Makes [id, latency] batches, where the ids are the row numbers.
+std::vector<RowBatch> MakeInput(const RowDescriptor& rd, InputOrder order) {
+  std::vector<double> latencies(kNumRows);
+  std::iota(latencies.begin(), latencies.end(), 0.0);
+  if (order == InputOrder::kRandom) {
+    std::mt19937_64 rng(42);
+    std::shuffle(latencies.begin(), latencies.end(), rng);
+  }
+
+  std::vector<RowBatch> batches;
+  for (int64_t start = 0; start < kNumRows; start += kBatchSize) {
+    int64_t end = std::min(kNumRows, start + kBatchSize);
+    std::vector<px::types::Int64Value> ids;
+    std::vector<px::types::Float64Value> batch_latencies;
+    for (int64_t i = start; i < end; ++i) {
+      ids.push_back(i);
+      batch_latencies.push_back(latencies[i]);
+    }
+    bool eos = end == kNumRows;
+    batches.push_back(RowBatchBuilder(rd, end - start, eos, eos)
+                          .AddColumn<px::types::Int64Value>(ids)
+                          .AddColumn<px::types::Float64Value>(batch_latencies)
+                          .get());
+  }
+  return batches;
+}
+
+}  // namespace
+
+// Computes the k slowest rows by latency. k = 0 sorts the whole input instead.
+// NOLINTNEXTLINE : runtime/references.
+void BM_TopK(benchmark::State& state) {
+  int64_t k = state.range(0);
+  auto order = static_cast<InputOrder>(state.range(1));
+
+  auto func_registry = std::make_unique<px::carnot::udf::Registry>("test_registry");
+  auto table_store = std::make_shared<px::table_store::TableStore>();
+  auto exec_state = std::make_unique<px::carnot::exec::ExecState>(
+      func_registry.get(), table_store, MockResultSinkStubGenerator, MockMetricsStubGenerator,
+      MockTraceStubGenerator, sole::uuid4(), nullptr);
+
+  // Orders by latency descending and outputs both columns.
+  px::carnot::planpb::Operator op_pb;
+  op_pb.set_op_type(px::carnot::planpb::SORT_OPERATOR);
+  auto* sort_pb = op_pb.mutable_sort_op();
+  auto* sort_col = sort_pb->add_sort_columns();
+  sort_col->mutable_column()->set_index(1);
+  sort_col->set_ascending(false);
+  sort_pb->add_columns()->set_index(0);
+  sort_pb->add_columns()->set_index(1);
+  sort_pb->set_limit(k);
+  auto plan_node = px::carnot::plan::SortOperator::FromProto(op_pb, 1);
+
+  RowDescriptor rd({DataType::INT64, DataType::FLOAT64});
+  auto batches = MakeInput(rd, order);
+
+  for (auto _ : state) {
+    SortNode node;
+    PX_CHECK_OK(node.Init(*plan_node, rd, {rd}));
+    PX_CHECK_OK(node.Prepare(exec_state.get()));
+    PX_CHECK_OK(node.Open(exec_state.get()));
+    for (const auto& rb : batches) {
+      PX_CHECK_OK(node.ConsumeNext(exec_state.get(), rb, 0));
+    }
+    PX_CHECK_OK(node.Close(exec_state.get()));
+  }
+  state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+static void TopKArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t k : {10, 100, 1000, 0}) {
+    for (int64_t order : {0, 1}) {
+      b->Args({k, order});
+    }
+  }
+}
+
+BENCHMARK(BM_TopK)->ArgNames({"k", "worst_case"})->Apply(TopKArgs)->Unit(benchmark::kMillisecond);
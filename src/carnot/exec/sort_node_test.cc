@@ -0,0 +1,238 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/sort_node.h"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <sole.hpp>
+
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/planpb/test_proto.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/base/base.h"
+#include "src/common/testing/testing.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowDescriptor;
+using types::Float64Value;
+using types::Int64Value;
+using types::StringValue;
+
+class SortNodeTest : public ::testing::Test {
+ public:
+  SortNodeTest() {
+    func_registry_ = std::make_unique<udf::Registry>("test_registry");
+    auto table_store = std::make_shared<table_store::TableStore>();
+    exec_state_ = std::make_unique<ExecState>(func_registry_.get(), table_store,
+                                              MockResultSinkStubGenerator, MockMetricsStubGenerator,
+                                              MockTraceStubGenerator, sole::uuid4(), nullptr);
+  }
+
+ protected:
+  RowDescriptor input_rd_{{types::INT64, types::STRING, types::FLOAT64}};
+  RowDescriptor output_rd_{{types::STRING, types::FLOAT64}};
+  std::unique_ptr<ExecState> exec_state_;
+  std::unique_ptr<udf::Registry> func_registry_;
+};
+
+TEST_F(SortNodeTest, sort_across_batches) {
+  auto plan_node = plan::SortOperator::FromProto(planpb::testutils::CreateTestSort1PB(), 1);
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(*plan_node, output_rd_,
+                                                                   {input_rd_}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_, 3, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({1, 2, 3})
+                       .AddColumn<StringValue>({"b", "a", "c"})
+                       .AddColumn<Float64Value>({1.0, 2.0, 1.0})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_, 3, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Int64Value>({4, 5, 6})
+                       .AddColumn<StringValue>({"a", "d", "b"})
+                       .AddColumn<Float64Value>({2.0, 0.5, 1.0})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd_, 6, true, true)
+                          .AddColumn<StringValue>({"a", "a", "b", "b", "c", "d"})
+                          .AddColumn<Float64Value>({2.0, 2.0, 1.0, 1.0, 1.0, 0.5})
+                          .get())
+      .Close();
+}
+
+TEST_F(SortNodeTest, nan_sorts_last) {
+  // Only output the names, since NaNs don't compare equal in the expected batch.
+  planpb::Operator op = planpb::testutils::CreateTestSort1PB();
+  op.mutable_sort_op()->mutable_columns()->RemoveLast();
+  auto plan_node = plan::SortOperator::FromProto(op, 1);
+  RowDescriptor output_rd({types::STRING});
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(*plan_node, output_rd,
+                                                                   {input_rd_}, exec_state_.get());
+  constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_, 3, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({1, 2, 3})
+                       .AddColumn<StringValue>({"nan1", "b", "nan0"})
+                       .AddColumn<Float64Value>({kNaN, 1.0, kNaN})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_, 3, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Int64Value>({4, 5, 6})
+                       .AddColumn<StringValue>({"a", "nan2", "c"})
+                       .AddColumn<Float64Value>({2.0, kNaN, 0.5})
+                       .get(),
+                   0)
+      // The values sort in descending order, but the NaNs still come last, ordered by name.
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 6, true, true)
+                          .AddColumn<StringValue>({"a", "b", "c", "nan0", "nan1", "nan2"})
+                          .get())
+      .Close();
+}
+
+TEST_F(SortNodeTest, top_k_across_batches) {
+  auto plan_node = plan::SortOperator::FromProto(planpb::testutils::CreateTestTopK1PB(3), 1);
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(*plan_node, output_rd_,
+                                                                   {input_rd_}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_, 3, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({1, 2, 3})
+                       .AddColumn<StringValue>({"b", "a", "c"})
+                       .AddColumn<Float64Value>({1.0, 2.0, 1.0})
+                       .get(),
+                   0, 0)
+      // None of these rows make it into the top 3.
+      .ConsumeNext(RowBatchBuilder(input_rd_, 2, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({4, 5})
+                       .AddColumn<StringValue>({"d", "c"})
+                       .AddColumn<Float64Value>({1.0, 0.5})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_, 3, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Int64Value>({6, 7, 8})
+                       .AddColumn<StringValue>({"a", "d", "b"})
+                       .AddColumn<Float64Value>({2.0, 0.5, 1.0})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd_, 3, true, true)
+                          .AddColumn<StringValue>({"a", "a", "b"})
+                          .AddColumn<Float64Value>({2.0, 2.0, 1.0})
+                          .get())
+      .Close();
+}
+
+TEST_F(SortNodeTest, top_k_compacts_retained_batches) {
+  constexpr int64_t kNumBatches = 80;
+  constexpr int64_t kBatchSize = 1024;
+  auto plan_node = plan::SortOperator::FromProto(planpb::testutils::CreateTestTopK1PB(5), 1);
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(*plan_node, output_rd_,
+                                                                   {input_rd_}, exec_state_.get());
+  // Every batch has larger values than the last one, so each of them is retained until the node
+  // compacts them.
+  for (int64_t batch = 0; batch < kNumBatches; ++batch) {
+    std::vector<Int64Value> ids(kBatchSize);
+    std::vector<StringValue> names(kBatchSize);
+    std::vector<Float64Value> values(kBatchSize);
+    for (int64_t i = 0; i < kBatchSize; ++i) {
+      ids[i] = batch * kBatchSize + i;
+      names[i] = absl::StrCat("row", ids[i].val);
+      values[i] = static_cast<double>(ids[i].val);
+    }
+    bool eos = batch == kNumBatches - 1;
+    tester.ConsumeNext(RowBatchBuilder(input_rd_, kBatchSize, eos, eos)
+                           .AddColumn<Int64Value>(ids)
+                           .AddColumn<StringValue>(names)
+                           .AddColumn<Float64Value>(values)
+                           .get(),
+                       0, eos ? 1 : 0);
+  }
+  tester
+      .ExpectRowBatch(
+          RowBatchBuilder(output_rd_, 5, true, true)
+              .AddColumn<StringValue>({"row81919", "row81918", "row81917", "row81916", "row81915"})
+              .AddColumn<Float64Value>({81919, 81918, 81917, 81916, 81915})
+              .get())
+      .Close();
+}
+
+TEST_F(SortNodeTest, sort_splits_output_batches) {
+  constexpr int64_t kNumRows = kDefaultSortRowBatchSize + 10;
+  auto plan_node = plan::SortOperator::FromProto(planpb::testutils::CreateTestSort1PB(), 1);
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(*plan_node, output_rd_,
+                                                                   {input_rd_}, exec_state_.get());
+  std::vector<Int64Value> ids(kNumRows);
+  std::vector<StringValue> names(kNumRows, "a");
+  std::vector<Float64Value> values(kNumRows);
+  for (int64_t i = 0; i < kNumRows; ++i) {
+    ids[i] = i;
+    values[i] = static_cast<double>(i);
+  }
+  std::vector<Float64Value> first_values;
+  for (int64_t i = 0; i < static_cast<int64_t>(kDefaultSortRowBatchSize); ++i) {
+    first_values.push_back(static_cast<double>(kNumRows - 1 - i));
+  }
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_, kNumRows, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Int64Value>(ids)
+                       .AddColumn<StringValue>(names)
+                       .AddColumn<Float64Value>(values)
+                       .get(),
+                   0, 2)
+      .ExpectRowBatch(RowBatchBuilder(output_rd_, kDefaultSortRowBatchSize, false, false)
+                          .AddColumn<StringValue>(std::vector<StringValue>(
+                              kDefaultSortRowBatchSize, "a"))
+                          .AddColumn<Float64Value>(first_values)
+                          .get())
+      .ExpectRowBatch(RowBatchBuilder(output_rd_, 10, true, true)
+                          .AddColumn<StringValue>(std::vector<StringValue>(10, "a"))
+                          .AddColumn<Float64Value>({9, 8, 7, 6, 5, 4, 3, 2, 1, 0})
+                          .get())
+      .Close();
+}
+
+TEST_F(SortNodeTest, empty_input) {
+  auto plan_node = plan::SortOperator::FromProto(planpb::testutils::CreateTestTopK1PB(3), 1);
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(*plan_node, output_rd_,
+                                                                   {input_rd_}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_, 0, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Int64Value>({})
+                       .AddColumn<StringValue>({})
+                       .AddColumn<Float64Value>({})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd_, 0, true, true)
+                          .AddColumn<StringValue>({})
+                          .AddColumn<Float64Value>({})
+                          .get())
+      .Close();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+DEFINE_int32(carnot_exec_pool_threads, gflags::Int32FromEnv("PL_CARNOT_EXEC_POOL_THREADS", 0),
+             "The number of threads that Carnot runs the parallel parts of queries on, shared by "
+             "all queries. 0 means one per core.");
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+struct ThreadPool::ParallelForState {
+  ParallelForState(int n, const std::function<void(int)>* fn) : n(n), fn(fn) {}
+
+  const int n;
+  // Only used while there are indices left, so it never outlives the ParallelFor call.
+  const std::function<void(int)>* fn;
+  std::atomic<int> next_index = 0;
+
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  int num_done = 0;
+};
+
+ThreadPool::ThreadPool(int num_threads) {
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+ThreadPool* ThreadPool::Default() {
+  static ThreadPool* pool =
+      new ThreadPool(FLAGS_carnot_exec_pool_threads > 0
+                         ? FLAGS_carnot_exec_pool_threads
+                         : static_cast<int>(std::thread::hardware_concurrency()));
+  return pool;
+}
+
+void ThreadPool::RunIndices(ParallelForState* state) {
+  int num_run = 0;
+  for (int i = state->next_index++; i < state->n; i = state->next_index++) {
+    (*state->fn)(i);
+    ++num_run;
+  }
+  if (num_run == 0) {
+    return;
+  }
+  bool last = false;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->num_done += num_run;
+    last = state->num_done == state->n;
+  }
+  if (last) {
+    state->done_cv.notify_one();
+  }
+}
+
+void ThreadPool::ParallelFor(int n, const std::function<void(int)>& fn) {
+  if (n <= 0) {
+    return;
+  }
+  // The tasks can start after the call returned, once there is nothing left for them to do, so
+  // they share ownership of the state.
+  auto state = std::make_shared<ParallelForState>(n, &fn);
+  int num_tasks = std::min(n - 1, num_threads());
+  if (num_tasks > 0) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (int i = 0; i < num_tasks; ++i) {
+        tasks_.emplace_back([state] { RunIndices(state.get()); });
+      }
+    }
+    cv_.notify_all();
+  }
+
+  RunIndices(state.get());
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done_cv.wait(lock, [&] { return state->num_done == state->n; });
+}
+
+void ThreadPool::WorkerLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      if (stop_) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * ThreadPool runs the parallel parts of queries on threads that are shared by all the queries of
+ * the process, so that they don't pay for thread creation, and so that concurrent queries don't
+ * add up to more threads than the machine has cores.
+ *
+ * Work is handed out with ParallelFor, whose calling thread also takes part in the work. Since the
+ * caller claims the same indices as the pool's threads, a ParallelFor never waits for a thread of
+ * the pool to become free, even when the pool is busy with other queries.
+ *
+ * Example:
+ *   ThreadPool::Default()->ParallelFor(tablets.size(), [&](int i) { Read(tablets[i]); });
+ */
+class ThreadPool : public NotCopyable {
+ public:
+  explicit ThreadPool(int num_threads);
+  ~ThreadPool();
+
+  /**
+   * The pool shared by the whole process, with --carnot_exec_pool_threads threads.
+   */
+  static ThreadPool* Default();
+
+  int num_threads() const { return static_cast<int>(threads_.size()); }
+
+  /**
+   * Calls fn(i) for every i in [0, n), on up to n threads including the calling one. Returns once
+   * all the calls have returned. Can be called from several threads at once.
+   */
+  void ParallelFor(int n, const std::function<void(int)>& fn);
+
+ private:
+  struct ParallelForState;
+
+  void WorkerLoop();
+  // Claims and runs indices of the state until there are none left.
+  static void RunIndices(ParallelForState* state);
+
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool stop_ = false;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/thread_pool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+TEST(ThreadPoolTest, RunsEveryIndexOnce) {
+  ThreadPool pool(4);
+  std::vector<std::atomic<int>> counts(100);
+  for (int i = 0; i < 10; ++i) {
+    pool.ParallelFor(counts.size(), [&](int idx) { ++counts[idx]; });
+  }
+  for (const auto& count : counts) {
+    EXPECT_EQ(count.load(), 10);
+  }
+}
+
+TEST(ThreadPoolTest, IndicesRunInParallel) {
+  ThreadPool pool(2);
+
+  // Every call waits for all the others, which only completes if they run at the same time.
+  std::atomic<int> num_started = 0;
+  pool.ParallelFor(3, [&](int) {
+    ++num_started;
+    while (num_started.load() < 3) {
+      std::this_thread::yield();
+    }
+  });
+  EXPECT_EQ(num_started.load(), 3);
+}
+
+TEST(ThreadPoolTest, CallerRunsEverythingWhenPoolIsBusy) {
+  ThreadPool pool(1);
+
+  // Keep the only thread of the pool busy until the second ParallelFor is done. Both indices
+  // block, so once both have started, one of them is on the pool's thread.
+  std::atomic<int> num_blocked = 0;
+  std::atomic<bool> release = false;
+  std::thread blocker([&] {
+    pool.ParallelFor(2, [&](int) {
+      ++num_blocked;
+      while (!release.load()) {
+        std::this_thread::yield();
+      }
+    });
+  });
+  while (num_blocked.load() < 2) {
+    std::this_thread::yield();
+  }
+
+  std::vector<std::thread::id> ids(4);
+  pool.ParallelFor(ids.size(), [&](int i) { ids[i] = std::this_thread::get_id(); });
+  EXPECT_THAT(ids, ::testing::Each(std::this_thread::get_id()));
+
+  release = true;
+  blocker.join();
+}
+
+TEST(ThreadPoolTest, ConcurrentCallers) {
+  ThreadPool pool(3);
+  std::atomic<int> total = 0;
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 4; ++i) {
+    callers.emplace_back([&] {
+      for (int j = 0; j < 50; ++j) {
+        pool.ParallelFor(8, [&](int) { ++total; });
+      }
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  EXPECT_EQ(total.load(), 4 * 50 * 8);
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,619 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/vectorized_agg.h"
+
+#include <arrow/builder.h>
+#include <farmhash.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "src/common/base/hash_utils.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/type_utils.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+
+namespace {
+
+constexpr uint64_t kHashSeed = 0x9ae16a3b2f90404fULL;
+constexpr size_t kMinSlots = 1024;
+
+template <types::DataType DT>
+using ArrowArrayType = typename types::DataTypeTraits<DT>::arrow_array_type;
+
+template <types::DataType DT>
+using NativeType = typename types::DataTypeTraits<DT>::native_type;
+
+// Bools are stored as bytes so that the state arrays are plain contiguous memory.
+template <types::DataType DT>
+using StorageType =
+    std::conditional_t<std::is_same_v<NativeType<DT>, bool>, uint8_t, NativeType<DT>>;
+
+template <types::DataType DT>
+inline NativeType<DT> NativeValue(const ArrowArrayType<DT>* arr, int64_t idx) {
+  typename types::DataTypeTraits<DT>::value_type val = arr->Value(idx);
+  return val.val;
+}
+
+inline uint64_t HashNative(bool val) { return static_cast<uint64_t>(val); }
+inline uint64_t HashNative(int64_t val) { return static_cast<uint64_t>(val); }
+inline uint64_t HashNative(double val) {
+  uint64_t bits;
+  std::memcpy(&bits, &val, sizeof(bits));
+  return bits;
+}
+inline uint64_t HashNative(absl::uint128 val) {
+  return HashCombine(absl::Uint128Low64(val), absl::Uint128High64(val));
+}
+
+// Floats are compared bitwise to match the RowTuple based hash map.
+template <typename T>
+inline bool KeyEquals(T a, T b) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+  } else {
+    return a == b;
+  }
+}
+
+template <types::DataType DT, typename TIter>
+Status BuildArrowArray(TIter begin, TIter end, arrow::MemoryPool* mem_pool,
+                       std::shared_ptr<arrow::Array>* out) {
+  using BuilderType = typename types::DataTypeTraits<DT>::arrow_builder_type;
+  auto builder = types::MakeArrowBuilder(DT, mem_pool);
+  auto typed_builder = static_cast<BuilderType*>(builder.get());
+  PX_RETURN_IF_ERROR(typed_builder->Reserve(std::distance(begin, end)));
+  for (auto it = begin; it != end; ++it) {
+    typed_builder->UnsafeAppend(static_cast<NativeType<DT>>(*it));
+  }
+  PX_RETURN_IF_ERROR(typed_builder->Finish(out));
+  return Status::OK();
+}
+
+/**
+ * Group key column for all of the fixed size types.
+ */
+template <types::DataType DT>
+class FixedSizeGroupKeyColumn : public GroupKeyColumn {
+ public:
+  void HashBatch(const arrow::Array* arr, uint64_t* hashes) const override {
+    auto typed_arr = static_cast<const ArrowArrayType<DT>*>(arr);
+    int64_t num_rows = typed_arr->length();
+    for (int64_t i = 0; i < num_rows; ++i) {
+      hashes[i] = HashCombine(hashes[i], HashNative(NativeValue<DT>(typed_arr, i)));
+    }
+  }
+
+  void CompareBatch(const arrow::Array* arr, const uint32_t* group_ids, const uint32_t* rows,
+                    size_t num_rows, uint8_t* matches) const override {
+    auto typed_arr = static_cast<const ArrowArrayType<DT>*>(arr);
+    for (size_t i = 0; i < num_rows; ++i) {
+      uint32_t row = rows[i];
+      matches[i] &= KeyEquals<StorageType<DT>>(values_[group_ids[row]],
+                                               NativeValue<DT>(typed_arr, row));
+    }
+  }
+
+  void Append(const arrow::Array* arr, int64_t row) override {
+    values_.push_back(NativeValue<DT>(static_cast<const ArrowArrayType<DT>*>(arr), row));
+  }
+
+  Status ToArrow(arrow::MemoryPool* mem_pool, std::shared_ptr<arrow::Array>* out) const override {
+    return BuildArrowArray<DT>(values_.begin(), values_.end(), mem_pool, out);
+  }
+
+  void Clear() override { values_.clear(); }
+  size_t Size() const override { return values_.size(); }
+  int64_t Bytes() const override { return values_.capacity() * sizeof(StorageType<DT>); }
+
+ private:
+  std::vector<StorageType<DT>> values_;
+};
+
+/**
+ * Group key column for strings. The values are stored back to back in a single buffer.
+ */
+class StringGroupKeyColumn : public GroupKeyColumn {
+ public:
+  StringGroupKeyColumn() { offsets_.push_back(0); }
+
+  void HashBatch(const arrow::Array* arr, uint64_t* hashes) const override {
+    int64_t num_rows = arr->length();
+    for (int64_t i = 0; i < num_rows; ++i) {
+      auto val = types::GetStringViewFromArrowArray(arr, i);
+      hashes[i] = HashCombine(hashes[i], ::util::Hash64(val.data(), val.size()));
+    }
+  }
+
+  void CompareBatch(const arrow::Array* arr, const uint32_t* group_ids, const uint32_t* rows,
+                    size_t num_rows, uint8_t* matches) const override {
+    for (size_t i = 0; i < num_rows; ++i) {
+      uint32_t row = rows[i];
+      matches[i] &= Get(group_ids[row]) == types::GetStringViewFromArrowArray(arr, row);
+    }
+  }
+
+  void Append(const arrow::Array* arr, int64_t row) override {
+    auto val = types::GetStringViewFromArrowArray(arr, row);
+    data_.append(val.data(), val.size());
+    offsets_.push_back(data_.size());
+  }
+
+  Status ToArrow(arrow::MemoryPool* mem_pool, std::shared_ptr<arrow::Array>* out) const override {
+    arrow::StringBuilder builder(mem_pool);
+    PX_RETURN_IF_ERROR(builder.Reserve(Size()));
+    PX_RETURN_IF_ERROR(builder.ReserveData(data_.size()));
+    for (size_t i = 0; i < Size(); ++i) {
+      auto val = Get(i);
+      builder.UnsafeAppend(val.data(), static_cast<int32_t>(val.size()));
+    }
+    PX_RETURN_IF_ERROR(builder.Finish(out));
+    return Status::OK();
+  }
+
+  void Clear() override {
+    data_.clear();
+    offsets_.resize(1);
+  }
+  size_t Size() const override { return offsets_.size() - 1; }
+  int64_t Bytes() const override {
+    return data_.capacity() + offsets_.capacity() * sizeof(uint64_t);
+  }
+
+ private:
+  std::string_view Get(size_t group_id) const {
+    return std::string_view(data_.data() + offsets_[group_id],
+                            offsets_[group_id + 1] - offsets_[group_id]);
+  }
+
+  std::string data_;
+  std::vector<uint64_t> offsets_;
+};
+
+/**
+ * Vectorized versions of the builtin UDAs (see funcs/builtins/math_ops.h). The results must
+ * match the row based implementations, including their initial values.
+ */
+template <types::DataType TArgType, types::DataType TAggType>
+class SumAggregate : public VectorizedAggregate {
+ public:
+  void Resize(size_t num_groups) override { sums_.resize(num_groups, 0); }
+  void UpdateBatch(const arrow::Array* arg, const uint32_t* group_ids,
+                   int64_t num_rows) override {
+    auto typed_arg = static_cast<const ArrowArrayType<TArgType>*>(arg);
+    NativeType<TAggType>* sums = sums_.data();
+    for (int64_t i = 0; i < num_rows; ++i) {
+      sums[group_ids[i]] += NativeValue<TArgType>(typed_arg, i);
+    }
+  }
+  void MergeBatch(const VectorizedAggregate& other, const uint32_t* group_ids,
+                  int64_t num_groups) override {
+    const auto& other_sums = static_cast<const SumAggregate&>(other).sums_;
+    for (int64_t i = 0; i < num_groups; ++i) {
+      sums_[group_ids[i]] += other_sums[i];
+    }
+  }
+  Status Finalize(arrow::MemoryPool* mem_pool, std::shared_ptr<arrow::Array>* out) override {
+    return BuildArrowArray<TAggType>(sums_.begin(), sums_.end(), mem_pool, out);
+  }
+  void Clear() override { sums_.clear(); }
+
+ private:
+  std::vector<NativeType<TAggType>> sums_;
+};
+
+class CountAggregate : public VectorizedAggregate {
+ public:
+  void Resize(size_t num_groups) override { counts_.resize(num_groups, 0); }
+  void UpdateBatch(const arrow::Array*, const uint32_t* group_ids, int64_t num_rows) override {
+    int64_t* counts = counts_.data();
+    for (int64_t i = 0; i < num_rows; ++i) {
+      ++counts[group_ids[i]];
+    }
+  }
+  void MergeBatch(const VectorizedAggregate& other, const uint32_t* group_ids,
+                  int64_t num_groups) override {
+    const auto& other_counts = static_cast<const CountAggregate&>(other).counts_;
+    for (int64_t i = 0; i < num_groups; ++i) {
+      counts_[group_ids[i]] += other_counts[i];
+    }
+  }
+  Status Finalize(arrow::MemoryPool* mem_pool, std::shared_ptr<arrow::Array>* out) override {
+    return BuildArrowArray<types::INT64>(counts_.begin(), counts_.end(), mem_pool, out);
+  }
+  void Clear() override { counts_.clear(); }
+
+ private:
+  std::vector<int64_t> counts_;
+};
+
+template <types::DataType TArgType>
+class MeanAggregate : public VectorizedAggregate {
+ public:
+  void Resize(size_t num_groups) override {
+    sizes_.resize(num_groups, 0);
+    sums_.resize(num_groups, 0);
+  }
+  void UpdateBatch(const arrow::Array* arg, const uint32_t* group_ids,
+                   int64_t num_rows) override {
+    auto typed_arg = static_cast<const ArrowArrayType<TArgType>*>(arg);
+    uint64_t* sizes = sizes_.data();
+    double* sums = sums_.data();
+    for (int64_t i = 0; i < num_rows; ++i) {
+      ++sizes[group_ids[i]];
+      sums[group_ids[i]] += NativeValue<TArgType>(typed_arg, i);
+    }
+  }
+  void MergeBatch(const VectorizedAggregate& other, const uint32_t* group_ids,
+                  int64_t num_groups) override {
+    const auto& typed_other = static_cast<const MeanAggregate&>(other);
+    for (int64_t i = 0; i < num_groups; ++i) {
+      sizes_[group_ids[i]] += typed_other.sizes_[i];
+      sums_[group_ids[i]] += typed_other.sums_[i];
+    }
+  }
+  Status Finalize(arrow::MemoryPool* mem_pool, std::shared_ptr<arrow::Array>* out) override {
+    std::vector<double> means(sums_.size());
+    for (size_t i = 0; i < sums_.size(); ++i) {
+      means[i] = sums_[i] / sizes_[i];
+    }
+    return BuildArrowArray<types::FLOAT64>(means.begin(), means.end(), mem_pool, out);
+  }
+  void Clear() override {
+    sizes_.clear();
+    sums_.clear();
+  }
+
+ private:
+  std::vector<uint64_t> sizes_;
+  std::vector<double> sums_;
+};
+
+template <types::DataType TArgType, bool TIsMax>
+class MinMaxAggregate : public VectorizedAggregate {
+  using T = NativeType<TArgType>;
+
+ public:
+  void Resize(size_t num_groups) override {
+    // MaxUDA/MinUDA start from numeric_limits min()/max() respectively.
+    values_.resize(num_groups,
+                   TIsMax ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max());
+  }
+  void UpdateBatch(const arrow::Array* arg, const uint32_t* group_ids,
+                   int64_t num_rows) override {
+    auto typed_arg = static_cast<const ArrowArrayType<TArgType>*>(arg);
+    T* values = values_.data();
+    for (int64_t i = 0; i < num_rows; ++i) {
+      T val = NativeValue<TArgType>(typed_arg, i);
+      T* cur = &values[group_ids[i]];
+      if constexpr (TIsMax) {
+        *cur = *cur < val ? val : *cur;
+      } else {
+        *cur = *cur > val ? val : *cur;
+      }
+    }
+  }
+  void MergeBatch(const VectorizedAggregate& other, const uint32_t* group_ids,
+                  int64_t num_groups) override {
+    const auto& other_values = static_cast<const MinMaxAggregate&>(other).values_;
+    for (int64_t i = 0; i < num_groups; ++i) {
+      T* cur = &values_[group_ids[i]];
+      if constexpr (TIsMax) {
+        *cur = *cur < other_values[i] ? other_values[i] : *cur;
+      } else {
+        *cur = *cur > other_values[i] ? other_values[i] : *cur;
+      }
+    }
+  }
+  Status Finalize(arrow::MemoryPool* mem_pool, std::shared_ptr<arrow::Array>* out) override {
+    return BuildArrowArray<TArgType>(values_.begin(), values_.end(), mem_pool, out);
+  }
+  void Clear() override { values_.clear(); }
+
+ private:
+  std::vector<T> values_;
+};
+
+}  // namespace
+
+std::unique_ptr<GroupKeyColumn> GroupKeyColumn::Make(types::DataType data_type) {
+  switch (data_type) {
+    case types::BOOLEAN:
+      return std::make_unique<FixedSizeGroupKeyColumn<types::BOOLEAN>>();
+    case types::INT64:
+      return std::make_unique<FixedSizeGroupKeyColumn<types::INT64>>();
+    case types::UINT128:
+      return std::make_unique<FixedSizeGroupKeyColumn<types::UINT128>>();
+    case types::FLOAT64:
+      return std::make_unique<FixedSizeGroupKeyColumn<types::FLOAT64>>();
+    case types::TIME64NS:
+      return std::make_unique<FixedSizeGroupKeyColumn<types::TIME64NS>>();
+    case types::STRING:
+      return std::make_unique<StringGroupKeyColumn>();
+    default:
+      return nullptr;
+  }
+}
+
+std::unique_ptr<VectorizedAggregate> VectorizedAggregate::Make(udf::VectorizedUDAKind kind,
+                                                               types::DataType arg_type,
+                                                               types::DataType finalize_type) {
+  // The kinds are declared by the UDAs in funcs/builtins/math_ops.h, whose registrations these
+  // mirror. The types are checked as well, since a UDA of a given kind may only be registered
+  // for some of them.
+  switch (kind) {
+    case udf::VectorizedUDAKind::kCount:
+      if (finalize_type == types::INT64) {
+        return std::make_unique<CountAggregate>();
+      }
+      return nullptr;
+    case udf::VectorizedUDAKind::kSum:
+      if (arg_type == types::FLOAT64 && finalize_type == types::FLOAT64) {
+        return std::make_unique<SumAggregate<types::FLOAT64, types::FLOAT64>>();
+      }
+      if (arg_type == types::INT64 && finalize_type == types::INT64) {
+        return std::make_unique<SumAggregate<types::INT64, types::INT64>>();
+      }
+      if (arg_type == types::BOOLEAN && finalize_type == types::INT64) {
+        return std::make_unique<SumAggregate<types::BOOLEAN, types::INT64>>();
+      }
+      return nullptr;
+    case udf::VectorizedUDAKind::kMean:
+      if (finalize_type != types::FLOAT64) {
+        return nullptr;
+      }
+      switch (arg_type) {
+        case types::FLOAT64:
+          return std::make_unique<MeanAggregate<types::FLOAT64>>();
+        case types::INT64:
+          return std::make_unique<MeanAggregate<types::INT64>>();
+        case types::BOOLEAN:
+          return std::make_unique<MeanAggregate<types::BOOLEAN>>();
+        default:
+          return nullptr;
+      }
+    case udf::VectorizedUDAKind::kMax:
+    case udf::VectorizedUDAKind::kMin: {
+      if (finalize_type != arg_type) {
+        return nullptr;
+      }
+      bool is_max = kind == udf::VectorizedUDAKind::kMax;
+      switch (arg_type) {
+        case types::FLOAT64:
+          if (is_max) return std::make_unique<MinMaxAggregate<types::FLOAT64, true>>();
+          return std::make_unique<MinMaxAggregate<types::FLOAT64, false>>();
+        case types::INT64:
+          if (is_max) return std::make_unique<MinMaxAggregate<types::INT64, true>>();
+          return std::make_unique<MinMaxAggregate<types::INT64, false>>();
+        case types::TIME64NS:
+          if (is_max) return std::make_unique<MinMaxAggregate<types::TIME64NS, true>>();
+          return std::make_unique<MinMaxAggregate<types::TIME64NS, false>>();
+        default:
+          return nullptr;
+      }
+    }
+    case udf::VectorizedUDAKind::kNone:
+      return nullptr;
+  }
+  return nullptr;
+}
+
+VectorizedAggHashTable::VectorizedAggHashTable(
+    const std::vector<types::DataType>& group_types,
+    std::vector<std::unique_ptr<VectorizedAggregate>> aggregates)
+    : aggregates_(std::move(aggregates)) {
+  keys_.reserve(group_types.size());
+  for (const auto& dt : group_types) {
+    keys_.push_back(GroupKeyColumn::Make(dt));
+    DCHECK(keys_.back() != nullptr);
+  }
+}
+
+void VectorizedAggHashTable::InsertNoGrow(uint64_t hash, uint32_t group_id) {
+  uint64_t pos = hash & slot_mask_;
+  while (slots_[pos].group_id != kEmptySlot) {
+    pos = (pos + 1) & slot_mask_;
+  }
+  slots_[pos] = {hash, group_id};
+}
+
+void VectorizedAggHashTable::Reserve(size_t num_new_groups) {
+  size_t needed = 2 * (num_groups_ + num_new_groups);
+  if (needed <= slots_.size()) {
+    return;
+  }
+  size_t new_size = std::max(kMinSlots, slots_.size());
+  while (new_size < needed) {
+    new_size *= 2;
+  }
+
+  std::vector<Slot> old_slots(new_size, Slot{0, kEmptySlot});
+  old_slots.swap(slots_);
+  slot_mask_ = new_size - 1;
+  // The hashes are kept in the slots, so growing doesn't need to touch the keys.
+  for (const auto& slot : old_slots) {
+    if (slot.group_id != kEmptySlot) {
+      InsertNoGrow(slot.hash, slot.group_id);
+    }
+  }
+}
+
+void VectorizedAggHashTable::ComputeGroupIds(const std::vector<const arrow::Array*>& group_cols,
+                                             int64_t num_rows) {
+  hashes_.assign(num_rows, kHashSeed);
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    keys_[i]->HashBatch(group_cols[i], hashes_.data());
+  }
+
+  group_ids_.resize(num_rows);
+  probe_pos_.resize(num_rows);
+  pending_.resize(num_rows);
+  for (int64_t row = 0; row < num_rows; ++row) {
+    probe_pos_[row] = hashes_[row] & slot_mask_;
+    pending_[row] = row;
+  }
+
+  while (!pending_.empty()) {
+    to_compare_.clear();
+    for (uint32_t row : pending_) {
+      uint64_t hash = hashes_[row];
+      uint64_t pos = probe_pos_[row];
+      while (true) {
+        Slot& slot = slots_[pos];
+        if (slot.group_id == kEmptySlot) {
+          // The key is not in the table, so it becomes a new group. Later rows in this batch
+          // with the same key will find it through the hash compare below.
+          uint32_t group_id = num_groups_++;
+          for (size_t i = 0; i < keys_.size(); ++i) {
+            keys_[i]->Append(group_cols[i], row);
+          }
+          slot = {hash, group_id};
+          group_ids_[row] = group_id;
+          break;
+        }
+        if (slot.hash == hash) {
+          group_ids_[row] = slot.group_id;
+          probe_pos_[row] = pos;
+          to_compare_.push_back(row);
+          break;
+        }
+        pos = (pos + 1) & slot_mask_;
+      }
+    }
+
+    matches_.assign(to_compare_.size(), 1);
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      keys_[i]->CompareBatch(group_cols[i], group_ids_.data(), to_compare_.data(),
+                             to_compare_.size(), matches_.data());
+    }
+
+    // Rows that had a hash collision continue probing from the next slot.
+    pending_.clear();
+    for (size_t i = 0; i < to_compare_.size(); ++i) {
+      if (!matches_[i]) {
+        uint32_t row = to_compare_[i];
+        probe_pos_[row] = (probe_pos_[row] + 1) & slot_mask_;
+        pending_.push_back(row);
+      }
+    }
+  }
+}
+
+Status VectorizedAggHashTable::ConsumeBatch(const std::vector<const arrow::Array*>& group_cols,
+                                            const std::vector<const arrow::Array*>& agg_args,
+                                            int64_t num_rows) {
+  DCHECK_EQ(group_cols.size(), keys_.size());
+  DCHECK_EQ(agg_args.size(), aggregates_.size());
+  if (num_rows == 0) {
+    return Status::OK();
+  }
+  if (num_groups_ + num_rows >= kEmptySlot) {
+    return error::ResourceUnavailable("Too many groups for the vectorized aggregate: $0",
+                                      num_groups_ + num_rows);
+  }
+
+  Reserve(num_rows);
+  ComputeGroupIds(group_cols, num_rows);
+
+  for (size_t i = 0; i < aggregates_.size(); ++i) {
+    aggregates_[i]->Resize(num_groups_);
+    aggregates_[i]->UpdateBatch(agg_args[i], group_ids_.data(), num_rows);
+  }
+  return Status::OK();
+}
+
+Status VectorizedAggHashTable::ToRowBatch(arrow::MemoryPool* mem_pool, RowBatch* output_rb) {
+  for (const auto& key : keys_) {
+    std::shared_ptr<arrow::Array> arr;
+    PX_RETURN_IF_ERROR(key->ToArrow(mem_pool, &arr));
+    PX_RETURN_IF_ERROR(output_rb->AddColumn(arr));
+  }
+  for (const auto& agg : aggregates_) {
+    // Aggregates only grow when they see rows, so make sure every group has a value.
+    agg->Resize(num_groups_);
+    std::shared_ptr<arrow::Array> arr;
+    PX_RETURN_IF_ERROR(agg->Finalize(mem_pool, &arr));
+    PX_RETURN_IF_ERROR(output_rb->AddColumn(arr));
+  }
+  return Status::OK();
+}
+
+Status VectorizedAggHashTable::MergeFrom(arrow::MemoryPool* mem_pool,
+                                         VectorizedAggHashTable* other) {
+  DCHECK_EQ(keys_.size(), other->keys_.size());
+  DCHECK_EQ(aggregates_.size(), other->aggregates_.size());
+  int64_t num_other_groups = other->num_groups_;
+  if (num_other_groups == 0) {
+    return Status::OK();
+  }
+  if (num_groups_ + num_other_groups >= kEmptySlot) {
+    return error::ResourceUnavailable("Too many groups for the vectorized aggregate: $0",
+                                      num_groups_ + num_other_groups);
+  }
+
+  std::vector<std::shared_ptr<arrow::Array>> other_keys(keys_.size());
+  std::vector<const arrow::Array*> group_cols;
+  group_cols.reserve(keys_.size());
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    PX_RETURN_IF_ERROR(other->keys_[i]->ToArrow(mem_pool, &other_keys[i]));
+    group_cols.push_back(other_keys[i].get());
+  }
+
+  Reserve(num_other_groups);
+  ComputeGroupIds(group_cols, num_other_groups);
+
+  for (size_t i = 0; i < aggregates_.size(); ++i) {
+    other->aggregates_[i]->Resize(num_other_groups);
+    aggregates_[i]->Resize(num_groups_);
+    aggregates_[i]->MergeBatch(*other->aggregates_[i], group_ids_.data(), num_other_groups);
+  }
+  return Status::OK();
+}
+
+void VectorizedAggHashTable::Clear() {
+  for (auto& key : keys_) {
+    key->Clear();
+  }
+  for (auto& agg : aggregates_) {
+    agg->Clear();
+  }
+  std::fill(slots_.begin(), slots_.end(), Slot{0, kEmptySlot});
+  num_groups_ = 0;
+}
+
+int64_t VectorizedAggHashTable::KeyBytes() const {
+  int64_t bytes = slots_.capacity() * sizeof(Slot);
+  for (const auto& key : keys_) {
+    bytes += key->Bytes();
+  }
+  return bytes;
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
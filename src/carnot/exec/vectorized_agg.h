@@ -0,0 +1,176 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <arrow/array.h>
+#include <arrow/memory_pool.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/carnot/udf/udf.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/types.h"
+#include "src/table_store/schema/row_batch.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * GroupKeyColumn stores the distinct values of a single group by column in a contiguous array,
+ * indexed by group id. All the operations work on a whole arrow::Array at a time so that the
+ * type dispatch happens once per batch instead of once per row.
+ */
+class GroupKeyColumn {
+ public:
+  virtual ~GroupKeyColumn() = default;
+
+  static std::unique_ptr<GroupKeyColumn> Make(types::DataType data_type);
+
+  /**
+   * Folds the hash of each value in arr into the matching entry of hashes.
+   */
+  virtual void HashBatch(const arrow::Array* arr, uint64_t* hashes) const = 0;
+
+  /**
+   * For each i in [0, num_rows), clears matches[i] if the stored key of group_ids[rows[i]] is
+   * not equal to arr[rows[i]].
+   */
+  virtual void CompareBatch(const arrow::Array* arr, const uint32_t* group_ids,
+                            const uint32_t* rows, size_t num_rows, uint8_t* matches) const = 0;
+
+  /**
+   * Appends arr[row] as the key of the next group.
+   */
+  virtual void Append(const arrow::Array* arr, int64_t row) = 0;
+
+  virtual Status ToArrow(arrow::MemoryPool* mem_pool, std::shared_ptr<arrow::Array>* out) const = 0;
+  virtual void Clear() = 0;
+  virtual size_t Size() const = 0;
+  virtual int64_t Bytes() const = 0;
+};
+
+/**
+ * VectorizedAggregate is a columnar implementation of one of the builtin UDAs. The state of all
+ * groups is kept in a single array indexed by group id and each update is a tight typed loop over
+ * the input column.
+ */
+class VectorizedAggregate {
+ public:
+  virtual ~VectorizedAggregate() = default;
+
+  /**
+   * Makes the vectorized aggregate of the given kind for a UDA with the given update argument and
+   * finalize types. Returns nullptr if there is no vectorized implementation for them.
+   */
+  static std::unique_ptr<VectorizedAggregate> Make(udf::VectorizedUDAKind kind,
+                                                   types::DataType arg_type,
+                                                   types::DataType finalize_type);
+
+  // Grows the state so that group ids up to num_groups - 1 are valid.
+  virtual void Resize(size_t num_groups) = 0;
+  // Updates the state of group_ids[i] with arg[i] for each row in the batch.
+  virtual void UpdateBatch(const arrow::Array* arg, const uint32_t* group_ids,
+                           int64_t num_rows) = 0;
+  // Merges the state of each group i < num_groups of other, which must be the same kind of
+  // aggregate, into the state of group_ids[i].
+  virtual void MergeBatch(const VectorizedAggregate& other, const uint32_t* group_ids,
+                          int64_t num_groups) = 0;
+  virtual Status Finalize(arrow::MemoryPool* mem_pool, std::shared_ptr<arrow::Array>* out) = 0;
+  virtual void Clear() = 0;
+};
+
+/**
+ * VectorizedAggHashTable is an open addressing hash table that maps group keys to dense group
+ * ids. Keys and the aggregate states are stored column wise and indexed by the group id, so no
+ * per row or per group allocations are made.
+ *
+ * Processing a batch is done in the following steps:
+ * 1. Hash the group columns of the batch one column at a time.
+ * 2. Probe the table, comparing candidate keys one column at a time. Rows that miss get a
+ *    new group id, rows with a hash collision are retried at the next slot.
+ * 3. Update each aggregate with a typed loop over the (group id, value) pairs.
+ */
+class VectorizedAggHashTable {
+ public:
+  VectorizedAggHashTable(const std::vector<types::DataType>& group_types,
+                         std::vector<std::unique_ptr<VectorizedAggregate>> aggregates);
+
+  /**
+   * Consume a batch of rows.
+   * @param group_cols the group by columns, in the same order as the group types.
+   * @param agg_args the argument column of each aggregate.
+   * @param num_rows the number of rows in the batch.
+   */
+  Status ConsumeBatch(const std::vector<const arrow::Array*>& group_cols,
+                      const std::vector<const arrow::Array*>& agg_args, int64_t num_rows);
+
+  /**
+   * Adds the group columns followed by the finalized aggregate columns to the output batch.
+   */
+  Status ToRowBatch(arrow::MemoryPool* mem_pool, table_store::schema::RowBatch* output_rb);
+
+  /**
+   * Merges the groups of other, which must have the same group types and aggregates, into this
+   * table. The groups of other are looked up in one batch, as if they were the rows of an input
+   * batch.
+   */
+  Status MergeFrom(arrow::MemoryPool* mem_pool, VectorizedAggHashTable* other);
+
+  void Clear();
+
+  size_t NumGroups() const { return num_groups_; }
+  int64_t KeyBytes() const;
+
+ private:
+  static constexpr uint32_t kEmptySlot = std::numeric_limits<uint32_t>::max();
+
+  struct Slot {
+    uint64_t hash;
+    uint32_t group_id;
+  };
+
+  // Makes sure that adding num_new_groups groups keeps the load factor under 1/2.
+  void Reserve(size_t num_new_groups);
+  void InsertNoGrow(uint64_t hash, uint32_t group_id);
+  void ComputeGroupIds(const std::vector<const arrow::Array*>& group_cols, int64_t num_rows);
+
+  std::vector<std::unique_ptr<GroupKeyColumn>> keys_;
+  std::vector<std::unique_ptr<VectorizedAggregate>> aggregates_;
+
+  std::vector<Slot> slots_;
+  uint64_t slot_mask_ = 0;
+  size_t num_groups_ = 0;
+
+  // Scratch space reused across batches.
+  std::vector<uint64_t> hashes_;
+  std::vector<uint32_t> group_ids_;
+  std::vector<uint64_t> probe_pos_;
+  std::vector<uint32_t> pending_;
+  std::vector<uint32_t> to_compare_;
+  std::vector<uint8_t> matches_;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,210 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/vectorized_agg.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+using table_store::schema::RowDescriptor;
+
+template <typename TValue>
+std::shared_ptr<arrow::Array> MakeArray(const std::vector<TValue>& vals) {
+  return types::ToArrow(vals, arrow::default_memory_pool());
+}
+
+template <types::DataType DT>
+std::vector<typename types::DataTypeTraits<DT>::native_type> ArrayValues(
+    const std::shared_ptr<arrow::Array>& arr) {
+  std::vector<typename types::DataTypeTraits<DT>::native_type> out;
+  for (int64_t i = 0; i < arr->length(); ++i) {
+    out.push_back(types::GetValueFromArrowArray<DT>(arr.get(), i));
+  }
+  return out;
+}
+
+using udf::VectorizedUDAKind;
+
+std::vector<std::unique_ptr<VectorizedAggregate>> MakeAggregates(
+    const std::vector<VectorizedUDAKind>& kinds, types::DataType arg_type) {
+  std::vector<std::unique_ptr<VectorizedAggregate>> aggs;
+  for (VectorizedUDAKind kind : kinds) {
+    types::DataType finalize_type = arg_type;
+    if (kind == VectorizedUDAKind::kCount) {
+      finalize_type = types::INT64;
+    } else if (kind == VectorizedUDAKind::kMean) {
+      finalize_type = types::FLOAT64;
+    }
+    aggs.push_back(VectorizedAggregate::Make(kind, arg_type, finalize_type));
+    EXPECT_NE(nullptr, aggs.back());
+  }
+  return aggs;
+}
+
+TEST(VectorizedAggregateTest, only_builtins_are_vectorized) {
+  EXPECT_NE(nullptr, VectorizedAggregate::Make(VectorizedUDAKind::kSum, types::BOOLEAN,
+                                               types::INT64));
+  EXPECT_NE(nullptr, VectorizedAggregate::Make(VectorizedUDAKind::kCount, types::STRING,
+                                               types::INT64));
+  EXPECT_NE(nullptr, VectorizedAggregate::Make(VectorizedUDAKind::kMax, types::TIME64NS,
+                                               types::TIME64NS));
+  EXPECT_EQ(nullptr, VectorizedAggregate::Make(VectorizedUDAKind::kSum, types::STRING,
+                                               types::STRING));
+  EXPECT_EQ(nullptr, VectorizedAggregate::Make(VectorizedUDAKind::kSum, types::INT64,
+                                               types::FLOAT64));
+  EXPECT_EQ(nullptr, VectorizedAggregate::Make(VectorizedUDAKind::kNone, types::INT64,
+                                               types::INT64));
+}
+
+TEST(VectorizedAggHashTableTest, int_group_builtin_udas) {
+  auto aggs = MakeAggregates({VectorizedUDAKind::kSum, VectorizedUDAKind::kCount,
+                              VectorizedUDAKind::kMean, VectorizedUDAKind::kMin,
+                              VectorizedUDAKind::kMax},
+                             types::INT64);
+  VectorizedAggHashTable table({types::INT64}, std::move(aggs));
+
+  auto keys1 = MakeArray<types::Int64Value>({1, 2, 1, 3, 2});
+  auto vals1 = MakeArray<types::Int64Value>({10, 20, 30, 40, 50});
+  std::vector<const arrow::Array*> args1(5, vals1.get());
+  ASSERT_OK(table.ConsumeBatch({keys1.get()}, args1, 5));
+
+  auto keys2 = MakeArray<types::Int64Value>({3, 4});
+  auto vals2 = MakeArray<types::Int64Value>({5, 6});
+  std::vector<const arrow::Array*> args2(5, vals2.get());
+  ASSERT_OK(table.ConsumeBatch({keys2.get()}, args2, 2));
+  EXPECT_EQ(4U, table.NumGroups());
+
+  RowDescriptor rd({types::INT64, types::INT64, types::INT64, types::FLOAT64, types::INT64,
+                    types::INT64});
+  RowBatch rb(rd, table.NumGroups());
+  ASSERT_OK(table.ToRowBatch(arrow::default_memory_pool(), &rb));
+
+  // Groups are emitted in the order they were first seen.
+  EXPECT_EQ(std::vector<int64_t>({1, 2, 3, 4}), ArrayValues<types::INT64>(rb.ColumnAt(0)));
+  EXPECT_EQ(std::vector<int64_t>({40, 70, 45, 6}), ArrayValues<types::INT64>(rb.ColumnAt(1)));
+  EXPECT_EQ(std::vector<int64_t>({2, 2, 2, 1}), ArrayValues<types::INT64>(rb.ColumnAt(2)));
+  EXPECT_EQ(std::vector<double>({20, 35, 22.5, 6}), ArrayValues<types::FLOAT64>(rb.ColumnAt(3)));
+  EXPECT_EQ(std::vector<int64_t>({10, 20, 5, 6}), ArrayValues<types::INT64>(rb.ColumnAt(4)));
+  EXPECT_EQ(std::vector<int64_t>({30, 50, 40, 6}), ArrayValues<types::INT64>(rb.ColumnAt(5)));
+}
+
+TEST(VectorizedAggHashTableTest, multi_column_string_group) {
+  VectorizedAggHashTable table({types::STRING, types::INT64},
+                               MakeAggregates({VectorizedUDAKind::kSum}, types::FLOAT64));
+
+  auto svc = MakeArray<types::StringValue>({"a", "b", "a", "a", "ab", ""});
+  auto code = MakeArray<types::Int64Value>({200, 200, 500, 200, 200, 200});
+  auto latency = MakeArray<types::Float64Value>({1.0, 2.0, 3.0, 4.0, 5.0, 6.0});
+  ASSERT_OK(table.ConsumeBatch({svc.get(), code.get()}, {latency.get()}, 6));
+  EXPECT_EQ(5U, table.NumGroups());
+
+  RowDescriptor rd({types::STRING, types::INT64, types::FLOAT64});
+  RowBatch rb(rd, table.NumGroups());
+  ASSERT_OK(table.ToRowBatch(arrow::default_memory_pool(), &rb));
+  EXPECT_EQ(std::vector<std::string>({"a", "b", "a", "ab", ""}),
+            ArrayValues<types::STRING>(rb.ColumnAt(0)));
+  EXPECT_EQ(std::vector<int64_t>({200, 200, 500, 200, 200}),
+            ArrayValues<types::INT64>(rb.ColumnAt(1)));
+  EXPECT_EQ(std::vector<double>({5.0, 2.0, 3.0, 5.0, 6.0}),
+            ArrayValues<types::FLOAT64>(rb.ColumnAt(2)));
+}
+
+TEST(VectorizedAggHashTableTest, grows_with_many_groups) {
+  constexpr int64_t kNumGroups = 50000;
+  VectorizedAggHashTable table({types::INT64},
+                               MakeAggregates({VectorizedUDAKind::kCount}, types::INT64));
+
+  std::vector<types::Int64Value> keys;
+  for (int64_t i = 0; i < kNumGroups; ++i) {
+    keys.emplace_back(i * 7919);
+  }
+  auto keys_arr = MakeArray(keys);
+  ASSERT_OK(table.ConsumeBatch({keys_arr.get()}, {keys_arr.get()}, kNumGroups));
+  ASSERT_OK(table.ConsumeBatch({keys_arr.get()}, {keys_arr.get()}, kNumGroups));
+  EXPECT_EQ(static_cast<size_t>(kNumGroups), table.NumGroups());
+
+  RowDescriptor rd({types::INT64, types::INT64});
+  RowBatch rb(rd, table.NumGroups());
+  ASSERT_OK(table.ToRowBatch(arrow::default_memory_pool(), &rb));
+  EXPECT_EQ(std::vector<int64_t>(kNumGroups, 2), ArrayValues<types::INT64>(rb.ColumnAt(1)));
+}
+
+TEST(VectorizedAggHashTableTest, merge_from) {
+  const std::vector<VectorizedUDAKind> kinds = {VectorizedUDAKind::kSum, VectorizedUDAKind::kCount,
+                                                VectorizedUDAKind::kMean, VectorizedUDAKind::kMin,
+                                                VectorizedUDAKind::kMax};
+  VectorizedAggHashTable table1({types::INT64}, MakeAggregates(kinds, types::INT64));
+  VectorizedAggHashTable table2({types::INT64}, MakeAggregates(kinds, types::INT64));
+
+  auto keys1 = MakeArray<types::Int64Value>({1, 2, 1});
+  auto vals1 = MakeArray<types::Int64Value>({10, 20, 30});
+  ASSERT_OK(table1.ConsumeBatch({keys1.get()}, std::vector<const arrow::Array*>(5, vals1.get()),
+                                3));
+  auto keys2 = MakeArray<types::Int64Value>({3, 1, 2});
+  auto vals2 = MakeArray<types::Int64Value>({5, 2, 50});
+  ASSERT_OK(table2.ConsumeBatch({keys2.get()}, std::vector<const arrow::Array*>(5, vals2.get()),
+                                3));
+
+  ASSERT_OK(table1.MergeFrom(arrow::default_memory_pool(), &table2));
+  EXPECT_EQ(3U, table1.NumGroups());
+
+  RowDescriptor rd({types::INT64, types::INT64, types::INT64, types::FLOAT64, types::INT64,
+                    types::INT64});
+  RowBatch rb(rd, table1.NumGroups());
+  ASSERT_OK(table1.ToRowBatch(arrow::default_memory_pool(), &rb));
+  EXPECT_EQ(std::vector<int64_t>({1, 2, 3}), ArrayValues<types::INT64>(rb.ColumnAt(0)));
+  EXPECT_EQ(std::vector<int64_t>({42, 70, 5}), ArrayValues<types::INT64>(rb.ColumnAt(1)));
+  EXPECT_EQ(std::vector<int64_t>({3, 2, 1}), ArrayValues<types::INT64>(rb.ColumnAt(2)));
+  EXPECT_EQ(std::vector<double>({14, 35, 5}), ArrayValues<types::FLOAT64>(rb.ColumnAt(3)));
+  EXPECT_EQ(std::vector<int64_t>({2, 20, 5}), ArrayValues<types::INT64>(rb.ColumnAt(4)));
+  EXPECT_EQ(std::vector<int64_t>({30, 50, 5}), ArrayValues<types::INT64>(rb.ColumnAt(5)));
+}
+
+TEST(VectorizedAggHashTableTest, clear) {
+  VectorizedAggHashTable table({types::INT64},
+                               MakeAggregates({VectorizedUDAKind::kMax}, types::INT64));
+
+  auto keys = MakeArray<types::Int64Value>({1, 2});
+  auto vals = MakeArray<types::Int64Value>({10, 20});
+  ASSERT_OK(table.ConsumeBatch({keys.get()}, {vals.get()}, 2));
+  table.Clear();
+  EXPECT_EQ(0U, table.NumGroups());
+
+  auto vals2 = MakeArray<types::Int64Value>({1, 2});
+  ASSERT_OK(table.ConsumeBatch({keys.get()}, {vals2.get()}, 2));
+  RowDescriptor rd({types::INT64, types::INT64});
+  RowBatch rb(rd, table.NumGroups());
+  ASSERT_OK(table.ToRowBatch(arrow::default_memory_pool(), &rb));
+  EXPECT_EQ(std::vector<int64_t>({1, 2}), ArrayValues<types::INT64>(rb.ColumnAt(1)));
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
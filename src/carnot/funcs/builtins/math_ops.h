@@ -22,6 +22,7 @@
 #include <limits>
 
 #include "src/carnot/udf/registry.h"
+#include "src/carnot/udf/simd.h"
 #include "src/carnot/udf/type_inference.h"
 #include "src/shared/types/types.h"
 #include "src/shared/types/typespb/types.pb.h"
@@ -35,6 +36,10 @@ template <typename TReturn, typename TArg1 = TReturn, typename TArg2 = TReturn>
 class AddUDF : public udf::ScalarUDF {
  public:
   TReturn Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1.val + b2.val; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, const TArg2* b2, TReturn* out) {
+    udf::BinaryBatch<udf::SIMDNative<TReturn>>(count, b1, b2, out,
+                                               [](auto x, auto y) { return x + y; });
+  }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {
         udf::InheritTypeFromArgs<AddUDF>::Create({types::ST_BYTES, types::ST_THROUGHPUT_PER_NS,
@@ -60,6 +65,10 @@ template <typename TReturn, typename TArg1 = TReturn, typename TArg2 = TReturn>
 class SubtractUDF : public udf::ScalarUDF {
  public:
   TReturn Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1.val - b2.val; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, const TArg2* b2, TReturn* out) {
+    udf::BinaryBatch<udf::SIMDNative<TReturn>>(count, b1, b2, out,
+                                               [](auto x, auto y) { return x - y; });
+  }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {
         udf::InheritTypeFromArgs<SubtractUDF>::Create({types::ST_BYTES, types::ST_THROUGHPUT_PER_NS,
@@ -88,6 +97,10 @@ class DivideUDF : public udf::ScalarUDF {
   types::Float64Value Exec(FunctionContext*, TArg1 b1, TArg2 b2) {
     return static_cast<double>(b1.val) / static_cast<double>(b2.val);
   }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, const TArg2* b2,
+                 types::Float64Value* out) {
+    udf::BinaryBatch<double>(count, b1, b2, out, [](auto x, auto y) { return x / y; });
+  }
 
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<DivideUDF>(types::ST_THROUGHPUT_PER_NS,
@@ -113,6 +126,10 @@ template <typename TReturn, typename TArg1 = TReturn, typename TArg2 = TReturn>
 class MultiplyUDF : public udf::ScalarUDF {
  public:
   TReturn Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1.val * b2.val; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, const TArg2* b2, TReturn* out) {
+    udf::BinaryBatch<udf::SIMDNative<TReturn>>(count, b1, b2, out,
+                                               [](auto x, auto y) { return x * y; });
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Multiplies the arguments.")
         .Details("Multiplies the two values together. Accessible using the `*` operator syntax.")
@@ -266,6 +283,10 @@ template <typename TArg1, typename TArg2 = TArg1>
 class LogicalOrUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1.val || b2.val; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, const TArg2* b2, BoolValue* out) {
+    udf::BinaryBatch<udf::SIMDCompareType<TArg1, TArg2>>(
+        count, b1, b2, out, [](auto x, auto y) { return (x != 0) | (y != 0); });
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Boolean ORs the passed in values.")
         .Example(R"doc(# Implicit call.
@@ -285,6 +306,10 @@ template <typename TArg1, typename TArg2 = TArg1>
 class LogicalAndUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1.val && b2.val; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, const TArg2* b2, BoolValue* out) {
+    udf::BinaryBatch<udf::SIMDCompareType<TArg1, TArg2>>(
+        count, b1, b2, out, [](auto x, auto y) { return (x != 0) & (y != 0); });
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Boolean ANDs the passed in values.")
         .Example(R"doc(# Implicit call.
@@ -302,6 +327,9 @@ template <typename TArg1>
 class LogicalNotUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1) { return !b1.val; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, BoolValue* out) {
+    udf::UnaryBatch<udf::SIMDNative<TArg1>>(count, b1, out, [](auto x) { return x == 0; });
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Boolean NOTs the passed in value.")
         .Example(R"doc(# Implicit call.
@@ -318,6 +346,9 @@ template <typename TArg1>
 class NegateUDF : public udf::ScalarUDF {
  public:
   TArg1 Exec(FunctionContext*, TArg1 b1) { return -b1.val; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, TArg1* out) {
+    udf::UnaryBatch<udf::SIMDNative<TArg1>>(count, b1, out, [](auto x) { return -x; });
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Negates the passed in value.")
         .Example(R"doc(# Implicit call.
@@ -333,6 +364,9 @@ template <typename TArg1>
 class InvertUDF : public udf::ScalarUDF {
  public:
   TArg1 Exec(FunctionContext*, TArg1 b1) { return ~b1.val; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, TArg1* out) {
+    udf::UnaryBatch<udf::SIMDNative<TArg1>>(count, b1, out, [](auto x) { return ~x; });
+  }
 
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Invert the bits of the given value.")
@@ -374,6 +408,10 @@ template <typename TArg1, typename TArg2 = TArg1>
 class EqualUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1 == b2; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, const TArg2* b2, BoolValue* out) {
+    udf::BinaryBatch<udf::SIMDCompareType<TArg1, TArg2>>(count, b1, b2, out,
+                                                         [](auto x, auto y) { return x == y; });
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Returns whether the values are equal.")
         .Details(
@@ -394,6 +432,10 @@ template <typename TArg1, typename TArg2 = TArg1>
 class NotEqualUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1 != b2; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, const TArg2* b2, BoolValue* out) {
+    udf::BinaryBatch<udf::SIMDCompareType<TArg1, TArg2>>(count, b1, b2, out,
+                                                         [](auto x, auto y) { return x != y; });
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Returns whether the values are not equal.")
         .Details(
@@ -439,6 +481,10 @@ template <typename TArg1, typename TArg2 = TArg1>
 class GreaterThanUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1 > b2; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, const TArg2* b2, BoolValue* out) {
+    udf::BinaryBatch<udf::SIMDCompareType<TArg1, TArg2>>(count, b1, b2, out,
+                                                         [](auto x, auto y) { return x > y; });
+  }
 
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
@@ -458,6 +504,10 @@ template <typename TArg1, typename TArg2 = TArg1>
 class GreaterThanEqualUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1 >= b2; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, const TArg2* b2, BoolValue* out) {
+    udf::BinaryBatch<udf::SIMDCompareType<TArg1, TArg2>>(count, b1, b2, out,
+                                                         [](auto x, auto y) { return x >= y; });
+  }
 
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
@@ -478,6 +528,10 @@ template <typename TArg1, typename TArg2 = TArg1>
 class LessThanUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1 < b2; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, const TArg2* b2, BoolValue* out) {
+    udf::BinaryBatch<udf::SIMDCompareType<TArg1, TArg2>>(count, b1, b2, out,
+                                                         [](auto x, auto y) { return x < y; });
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Returns which value is less than the other.")
         .Example(R"doc(# Implict call.
@@ -494,6 +548,10 @@ template <typename TArg1, typename TArg2 = TArg1>
 class LessThanEqualUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1 <= b2; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg1* b1, const TArg2* b2, BoolValue* out) {
+    udf::BinaryBatch<udf::SIMDCompareType<TArg1, TArg2>>(count, b1, b2, out,
+                                                         [](auto x, auto y) { return x <= y; });
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Returns which value is less than or equal to the the other.")
         .Example(R"doc(
@@ -584,6 +642,8 @@ class Int64ToTimeUDF : public udf::ScalarUDF {
 template <typename TArg>
 class MeanUDA : public udf::UDA {
  public:
+  static constexpr udf::VectorizedUDAKind kVectorizedKind = udf::VectorizedUDAKind::kMean;
+
   void Update(FunctionContext*, TArg arg) {
     info_.size++;
     info_.count += arg.val;
@@ -630,6 +690,8 @@ class MeanUDA : public udf::UDA {
 template <typename TArg, typename TAggType = TArg>
 class SumUDA : public udf::UDA {
  public:
+  static constexpr udf::VectorizedUDAKind kVectorizedKind = udf::VectorizedUDAKind::kSum;
+
   void Update(FunctionContext*, TArg arg) { sum_ = sum_.val + arg.val; }
   void Merge(FunctionContext*, const SumUDA& other) { sum_ = sum_.val + other.sum_.val; }
   TAggType Finalize(FunctionContext*) { return sum_; }
@@ -656,6 +718,8 @@ class SumUDA : public udf::UDA {
 template <typename TArg>
 class MaxUDA : public udf::UDA {
  public:
+  static constexpr udf::VectorizedUDAKind kVectorizedKind = udf::VectorizedUDAKind::kMax;
+
   void Update(FunctionContext*, TArg arg) {
     if (max_.val < arg.val) {
       max_ = arg;
@@ -692,6 +756,8 @@ class MaxUDA : public udf::UDA {
 template <typename TArg>
 class MinUDA : public udf::UDA {
  public:
+  static constexpr udf::VectorizedUDAKind kVectorizedKind = udf::VectorizedUDAKind::kMin;
+
   void Update(FunctionContext*, TArg arg) {
     if (min_.val > arg.val) {
       min_ = arg;
@@ -727,6 +793,8 @@ class MinUDA : public udf::UDA {
 template <typename TArg>
 class CountUDA : public udf::UDA {
  public:
+  static constexpr udf::VectorizedUDAKind kVectorizedKind = udf::VectorizedUDAKind::kCount;
+
   void Update(FunctionContext*, TArg) { count_.val++; }
   void Merge(FunctionContext*, const CountUDA& other) { count_.val += other.count_.val; }
   Int64Value Finalize(FunctionContext*) { return count_; }
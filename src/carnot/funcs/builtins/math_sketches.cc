@@ -25,6 +25,9 @@ namespace builtins {
 void RegisterMathSketchesOrDie(udf::Registry* registry) {
   registry->RegisterOrDie<QuantilesUDA<types::Int64Value>>("quantiles");
   registry->RegisterOrDie<QuantilesUDA<types::Float64Value>>("quantiles");
+  registry->RegisterOrDie<NativeQuantilesUDA<types::Int64Value>>("_native_quantiles");
+  registry->RegisterOrDie<NativeQuantilesUDA<types::Float64Value>>("_native_quantiles");
+  registry->RegisterOrDie<PluckQuantileUDF>("_pluck_quantile");
 }
 
 }  // namespace builtins
@@ -21,6 +21,9 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <array>
+#include <cstring>
+
 #include "src/carnot/udf/registry.h"
 #include "src/shared/types/types.h"
 #include "tdigest/tdigest.h"
@@ -29,24 +32,79 @@ namespace px {
 namespace carnot {
 namespace builtins {
 
+struct QuantileKey {
+  const char* key;
+  double quantile;
+};
+
+// The quantiles that px.quantiles computes, in the order that they are serialized in.
+inline constexpr std::array<QuantileKey, 7> kQuantileKeys = {{{"p01", 0.01},
+                                                              {"p10", 0.10},
+                                                              {"p25", 0.25},
+                                                              {"p50", 0.50},
+                                                              {"p75", 0.75},
+                                                              {"p90", 0.90},
+                                                              {"p99", 0.99}}};
+
 // TODO(zasgar): PL-419 Replace this when we add support for structs.
 template <typename TArg>
 class QuantilesUDA : public udf::UDA {
  public:
-  QuantilesUDA() : digest_(1000) {}
+  QuantilesUDA() : digest_(kCompression) {}
   void Update(FunctionContext*, TArg val) { digest_.add(val.val); }
   void Merge(FunctionContext*, const QuantilesUDA& other) { digest_.merge(&other.digest_); }
 
+  // The partial aggregate is the centroids of the compressed digest: their number, followed by the
+  // mean and weight of each of them. The compression bounds the number of centroids, so the size
+  // of the state doesn't grow with the number of aggregated values.
+  StringValue Serialize(FunctionContext*) {
+    digest_.compress();
+    const auto& centroids = digest_.processed();
+    uint64_t num_centroids = centroids.size();
+    StringValue data(sizeof(num_centroids) + num_centroids * kCentroidBytes, '\0');
+    char* out = data.data();
+    std::memcpy(out, &num_centroids, sizeof(num_centroids));
+    out += sizeof(num_centroids);
+    for (const auto& centroid : centroids) {
+      double mean = centroid.mean();
+      double weight = centroid.weight();
+      std::memcpy(out, &mean, sizeof(mean));
+      std::memcpy(out + sizeof(mean), &weight, sizeof(weight));
+      out += kCentroidBytes;
+    }
+    return data;
+  }
+
+  Status Deserialize(FunctionContext*, const StringValue& data) {
+    uint64_t num_centroids = 0;
+    if (data.size() < sizeof(num_centroids)) {
+      return error::InvalidArgument("Quantiles state of $0 bytes is too short", data.size());
+    }
+    std::memcpy(&num_centroids, data.data(), sizeof(num_centroids));
+    if ((data.size() - sizeof(num_centroids)) / kCentroidBytes != num_centroids ||
+        (data.size() - sizeof(num_centroids)) % kCentroidBytes != 0) {
+      return error::InvalidArgument("Quantiles state of $0 bytes doesn't hold $1 centroids",
+                                    data.size(), num_centroids);
+    }
+    const char* in = data.data() + sizeof(num_centroids);
+    for (uint64_t i = 0; i < num_centroids; ++i) {
+      double mean;
+      double weight;
+      std::memcpy(&mean, in, sizeof(mean));
+      std::memcpy(&weight, in + sizeof(mean), sizeof(weight));
+      digest_.add(mean, weight);
+      in += kCentroidBytes;
+    }
+    return Status::OK();
+  }
+
   StringValue Finalize(FunctionContext*) {
     rapidjson::Document d;
     d.SetObject();
-    d.AddMember("p01", digest_.quantile(0.01), d.GetAllocator());
-    d.AddMember("p10", digest_.quantile(0.10), d.GetAllocator());
-    d.AddMember("p25", digest_.quantile(0.25), d.GetAllocator());
-    d.AddMember("p50", digest_.quantile(0.50), d.GetAllocator());
-    d.AddMember("p75", digest_.quantile(0.75), d.GetAllocator());
-    d.AddMember("p90", digest_.quantile(0.90), d.GetAllocator());
-    d.AddMember("p99", digest_.quantile(0.99), d.GetAllocator());
+    for (const auto& quantile : kQuantileKeys) {
+      d.AddMember(rapidjson::StringRef(quantile.key), digest_.quantile(quantile.quantile),
+                  d.GetAllocator());
+    }
     rapidjson::StringBuffer sb;
     rapidjson::Writer<rapidjson::StringBuffer> writer(sb);
     d.Accept(writer);
@@ -78,9 +136,85 @@ class QuantilesUDA : public udf::UDA {
   }
 
  protected:
+  static constexpr double kCompression = 1000;
+  static constexpr size_t kCentroidBytes = 2 * sizeof(double);
+
   tdigest::TDigest digest_;
 };
 
+/**
+ * NativeQuantilesUDA computes the same quantiles as QuantilesUDA, but finalizes to the values as
+ * doubles, in the order of kQuantileKeys, instead of a JSON object. The planner replaces
+ * px.quantiles with it when the result is only ever read by px.pluck_float64, which in turn is
+ * replaced by PluckQuantileUDF, so that no JSON is written or parsed for every group.
+ */
+template <typename TArg>
+class NativeQuantilesUDA : public QuantilesUDA<TArg> {
+ public:
+  void Merge(FunctionContext* ctx, const NativeQuantilesUDA& other) {
+    QuantilesUDA<TArg>::Merge(ctx, other);
+  }
+
+  StringValue Finalize(FunctionContext*) {
+    StringValue data(kQuantileKeys.size() * sizeof(double), '\0');
+    char* out = data.data();
+    for (const auto& quantile : kQuantileKeys) {
+      double val = this->digest_.quantile(quantile.quantile);
+      std::memcpy(out, &val, sizeof(val));
+      out += sizeof(val);
+    }
+    return data;
+  }
+
+  static udf::UDADocBuilder Doc() {
+    return udf::UDADocBuilder("Approximates the distribution of the aggregated data.")
+        .Details(
+            "Internal version of `px.quantiles` that returns the quantiles as packed doubles. "
+            "The compiler uses it when all the quantiles are plucked with `px.pluck_float64`.")
+        .Arg("val", "The data to calculate the quantiles distribution.")
+        .Returns("The quantiles data, as packed doubles.");
+  }
+};
+
+/**
+ * PluckQuantileUDF reads a quantile from the output of NativeQuantilesUDA.
+ */
+class PluckQuantileUDF : public udf::ScalarUDF {
+ public:
+  Status Init(FunctionContext*, StringValue key) {
+    offset_ = -1;
+    for (size_t i = 0; i < kQuantileKeys.size(); ++i) {
+      if (key == kQuantileKeys[i].key) {
+        offset_ = i * sizeof(double);
+      }
+    }
+    return Status::OK();
+  }
+
+  Float64Value Exec(FunctionContext*, StringValue quantiles) {
+    // Return 0.0 for keys that px.quantiles doesn't have, like px.pluck_float64 does.
+    if (offset_ < 0 || quantiles.size() != kQuantileKeys.size() * sizeof(double)) {
+      return 0.0;
+    }
+    double val;
+    std::memcpy(&val, quantiles.data() + offset_, sizeof(val));
+    return val;
+  }
+
+  static udf::ScalarUDFDocBuilder Doc() {
+    return udf::ScalarUDFDocBuilder("Grabs a quantile from the packed output of quantiles.")
+        .Details(
+            "Internal version of `px.pluck_float64` for the quantiles as packed doubles. The "
+            "compiler uses it when all the quantiles are plucked with `px.pluck_float64`.")
+        .Arg("key", "The quantile to grab, one of p01, p10, p25, p50, p75, p90 or p99.")
+        .Arg("quantiles", "The packed quantiles.")
+        .Returns("The value of the quantile, or 0.0 if the key is unknown.");
+  }
+
+ private:
+  int64_t offset_ = -1;
+};
+
 void RegisterMathSketchesOrDie(udf::Registry* registry);
 
 }  // namespace builtins
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "src/carnot/funcs/builtins/math_sketches.h"
+#include "src/common/base/base.h"
+
+namespace px {
+namespace carnot {
+namespace builtins {
+
+// The number of PEMs whose rows are aggregated on a single Kelvin.
+constexpr int kNumPEMs = 100;
+
+// Request latencies (in ns) seen by each PEM.
+std::vector<std::vector<types::Float64Value>> PEMLatencies(int64_t rows_per_pem) {
+  std::mt19937_64 gen(42);
+  std::lognormal_distribution<double> latency(15, 1);
+  std::vector<std::vector<types::Float64Value>> pems(kNumPEMs);
+  for (auto& rows : pems) {
+    rows.reserve(rows_per_pem);
+    for (int64_t i = 0; i < rows_per_pem; ++i) {
+      rows.emplace_back(latency(gen));
+    }
+  }
+  return pems;
+}
+
+// Without partial aggregation, the PEMs ship their rows and the Kelvin aggregates all of them.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_QuantilesFanoutRaw(benchmark::State& state) {
+  auto pems = PEMLatencies(state.range(0));
+  int64_t bytes_shipped = 0;
+  for (auto _ : state) {
+    bytes_shipped = 0;
+    QuantilesUDA<types::Float64Value> kelvin;
+    for (const auto& rows : pems) {
+      // Copy the rows to stand in for sending them to the Kelvin.
+      std::vector<types::Float64Value> shipped(rows);
+      bytes_shipped += shipped.size() * sizeof(double);
+      for (const auto& val : shipped) {
+        kelvin.Update(nullptr, val);
+      }
+    }
+    benchmark::DoNotOptimize(kelvin.Finalize(nullptr));
+  }
+  state.counters["bytes_shipped"] = bytes_shipped;
+}
+
+// With partial aggregation, the PEMs ship the serialized digest of their rows and the Kelvin only
+// merges them. The PEMs run one after the other here, they run in parallel in a real cluster.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_QuantilesFanoutPartial(benchmark::State& state) {
+  auto pems = PEMLatencies(state.range(0));
+  int64_t bytes_shipped = 0;
+  for (auto _ : state) {
+    bytes_shipped = 0;
+    std::vector<types::StringValue> shipped;
+    for (const auto& rows : pems) {
+      QuantilesUDA<types::Float64Value> pem;
+      for (const auto& val : rows) {
+        pem.Update(nullptr, val);
+      }
+      shipped.push_back(pem.Serialize(nullptr));
+      bytes_shipped += shipped.back().size();
+    }
+
+    QuantilesUDA<types::Float64Value> kelvin;
+    for (const auto& data : shipped) {
+      QuantilesUDA<types::Float64Value> partial;
+      PX_CHECK_OK(partial.Deserialize(nullptr, data));
+      kelvin.Merge(nullptr, partial);
+    }
+    benchmark::DoNotOptimize(kelvin.Finalize(nullptr));
+  }
+  state.counters["bytes_shipped"] = bytes_shipped;
+}
+
+// Only the merge of the partial aggregates, which is the part of the query on the Kelvin.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_QuantilesMergePartials(benchmark::State& state) {
+  auto pems = PEMLatencies(state.range(0));
+  std::vector<types::StringValue> shipped;
+  for (const auto& rows : pems) {
+    QuantilesUDA<types::Float64Value> pem;
+    for (const auto& val : rows) {
+      pem.Update(nullptr, val);
+    }
+    shipped.push_back(pem.Serialize(nullptr));
+  }
+
+  for (auto _ : state) {
+    QuantilesUDA<types::Float64Value> kelvin;
+    for (const auto& data : shipped) {
+      QuantilesUDA<types::Float64Value> partial;
+      PX_CHECK_OK(partial.Deserialize(nullptr, data));
+      kelvin.Merge(nullptr, partial);
+    }
+    benchmark::DoNotOptimize(kelvin.Finalize(nullptr));
+  }
+}
+
+BENCHMARK(BM_QuantilesFanoutRaw)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_QuantilesFanoutPartial)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_QuantilesMergePartials)->Arg(1000)->Arg(10000)->Arg(100000);
+
+}  // namespace builtins
+}  // namespace carnot
+}  // namespace px
@@ -19,6 +19,7 @@
 #include <gtest/gtest.h>
 #include <rapidjson/document.h>
 
+#include "src/carnot/funcs/builtins/json_ops.h"
 #include "src/carnot/funcs/builtins/math_sketches.h"
 #include "src/carnot/udf/test_utils.h"
 #include "src/common/base/base.h"
@@ -69,6 +70,87 @@ TEST(MathSketches, quantiles_int64) {
   EXPECT_DOUBLE_EQ(d["p99"].GetDouble(), 6);
 }
 
+TEST(MathSketches, quantiles_partial_agg) {
+  EXPECT_TRUE(udf::UDATraits<QuantilesUDA<types::Float64Value>>::SupportsPartial());
+
+  QuantilesUDA<types::Float64Value> whole;
+  QuantilesUDA<types::Float64Value> left;
+  QuantilesUDA<types::Float64Value> right;
+  for (int i = 0; i < 10000; ++i) {
+    double val = (i * 7919) % 10000;
+    whole.Update(nullptr, val);
+    if (i % 2 == 0) {
+      left.Update(nullptr, val);
+    } else {
+      right.Update(nullptr, val);
+    }
+  }
+
+  // Merge the serialized states, like a Kelvin merging the partial aggregates of the PEMs.
+  QuantilesUDA<types::Float64Value> merged;
+  for (auto* partial : {&left, &right}) {
+    QuantilesUDA<types::Float64Value> deserialized;
+    ASSERT_OK(deserialized.Deserialize(nullptr, partial->Serialize(nullptr)));
+    merged.Merge(nullptr, deserialized);
+  }
+
+  rapidjson::Document expected;
+  rapidjson::Document actual;
+  expected.Parse(whole.Finalize(nullptr).data());
+  actual.Parse(merged.Finalize(nullptr).data());
+  for (const auto& quantile : {"p01", "p10", "p25", "p50", "p75", "p90", "p99"}) {
+    // Both are estimates, within a fraction of a percent of the range of the values.
+    EXPECT_NEAR(expected[quantile].GetDouble(), actual[quantile].GetDouble(), 20) << quantile;
+  }
+}
+
+TEST(MathSketches, quantiles_serialize_roundtrip) {
+  QuantilesUDA<types::Float64Value> uda;
+  for (double val : {1.234, 2.442, 1.04, 5.322, 6.333}) {
+    uda.Update(nullptr, val);
+  }
+  types::StringValue state = uda.Serialize(nullptr);
+  // The number of centroids and a mean and weight for each of the 5 values.
+  EXPECT_EQ(state.size(), sizeof(uint64_t) + 5 * 2 * sizeof(double));
+
+  QuantilesUDA<types::Float64Value> deserialized;
+  ASSERT_OK(deserialized.Deserialize(nullptr, state));
+  EXPECT_EQ(deserialized.Finalize(nullptr), uda.Finalize(nullptr));
+}
+
+TEST(MathSketches, quantiles_deserialize_invalid) {
+  QuantilesUDA<types::Float64Value> uda;
+  EXPECT_NOT_OK(uda.Deserialize(nullptr, types::StringValue("abc")));
+
+  QuantilesUDA<types::Float64Value> other;
+  other.Update(nullptr, 1.0);
+  types::StringValue state = other.Serialize(nullptr);
+  state.pop_back();
+  EXPECT_NOT_OK(uda.Deserialize(nullptr, state));
+}
+
+TEST(MathSketches, native_quantiles_match_json) {
+  QuantilesUDA<types::Float64Value> json_uda;
+  NativeQuantilesUDA<types::Float64Value> native_uda;
+  for (int i = 0; i < 1000; ++i) {
+    json_uda.Update(nullptr, i * 0.5);
+    native_uda.Update(nullptr, i * 0.5);
+  }
+  types::StringValue json = json_uda.Finalize(nullptr);
+  types::StringValue native = native_uda.Finalize(nullptr);
+  EXPECT_EQ(native.size(), kQuantileKeys.size() * sizeof(double));
+
+  auto pluck_json = udf::UDFTester<PluckAsFloat64UDF>();
+  auto pluck_native = udf::UDFTester<PluckQuantileUDF>();
+  for (const auto& quantile : kQuantileKeys) {
+    double expected = pluck_json.ForInput(json, quantile.key).Result().val;
+    pluck_native.Init(quantile.key).ForInput(native).Expect(expected);
+  }
+  // Unknown keys are 0.0, like for px.pluck_float64.
+  pluck_native.Init("p42").ForInput(native).Expect(0.0);
+  pluck_native.Init("p50").ForInput("not quantiles").Expect(0.0);
+}
+
 }  // namespace builtins
 }  // namespace carnot
 }  // namespace px
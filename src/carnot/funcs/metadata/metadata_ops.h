@@ -101,6 +101,8 @@ class UPIDToASIDUDF : public ScalarUDF {
 
 class PodIDToPodNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_id) {
     auto md = GetMetadataState(ctx);
 
@@ -125,6 +127,8 @@ class PodIDToPodNameUDF : public ScalarUDF {
 
 class PodIDToPodLabelsUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_id) {
     auto md = GetMetadataState(ctx);
 
@@ -146,6 +150,8 @@ class PodIDToPodLabelsUDF : public ScalarUDF {
 
 class PodNameToPodIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_name) {
     auto md = GetMetadataState(ctx);
     return GetPodID(md, pod_name);
@@ -169,6 +175,8 @@ class PodNameToPodIDUDF : public ScalarUDF {
 
 class PodNameToPodIPUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_name) {
     auto md = GetMetadataState(ctx);
     StringValue pod_id = PodNameToPodIDUDF::GetPodID(md, pod_name);
@@ -190,6 +198,8 @@ class PodNameToPodIPUDF : public ScalarUDF {
 
 class PodIDToNamespaceUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_id) {
     auto md = GetMetadataState(ctx);
 
@@ -236,6 +246,8 @@ class PodNameToNamespaceUDF : public ScalarUDF {
 
 class UPIDToContainerIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
 
@@ -277,6 +289,8 @@ inline const md::ContainerInfo* UPIDToContainer(const px::md::AgentMetadataState
 
 class UPIDToContainerNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
     auto container_info = UPIDToContainer(md, upid_value);
@@ -319,6 +333,8 @@ inline const px::md::PodInfo* UPIDtoPod(const px::md::AgentMetadataState* md,
 
 class UPIDToNamespaceUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
     auto pod_info = UPIDtoPod(md, upid_value);
@@ -351,6 +367,8 @@ class UPIDToNamespaceUDF : public ScalarUDF {
 
 class UPIDToPodIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
     auto container_info = UPIDToContainer(md, upid_value);
@@ -378,6 +396,8 @@ class UPIDToPodIDUDF : public ScalarUDF {
 
 class UPIDToPodNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
     auto pod_info = UPIDtoPod(md, upid_value);
@@ -409,6 +429,8 @@ class UPIDToPodNameUDF : public ScalarUDF {
 
 class ServiceIDToServiceNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue service_id) {
     auto md = GetMetadataState(ctx);
 
@@ -437,6 +459,8 @@ class ServiceIDToServiceNameUDF : public ScalarUDF {
 
 class ServiceIDToClusterIPUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue service_id) {
     auto md = GetMetadataState(ctx);
     const auto* service_info = md->k8s_metadata_state().ServiceInfoByID(service_id);
@@ -462,6 +486,8 @@ class ServiceIDToClusterIPUDF : public ScalarUDF {
 
 class ServiceIDToExternalIPsUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue service_id) {
     auto md = GetMetadataState(ctx);
     const auto* service_info = md->k8s_metadata_state().ServiceInfoByID(service_id);
@@ -485,6 +511,8 @@ class ServiceIDToExternalIPsUDF : public ScalarUDF {
 
 class ServiceNameToServiceIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue service_name) {
     auto md = GetMetadataState(ctx);
     // This UDF expects the service name to be in the format of "<ns>/<service-name>".
@@ -537,6 +565,8 @@ class ServiceNameToNamespaceUDF : public ScalarUDF {
  */
 class UPIDToServiceIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
     auto pod_info = UPIDtoPod(md, upid_value);
@@ -579,6 +609,8 @@ class UPIDToServiceIDUDF : public ScalarUDF {
  */
 class UPIDToServiceNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
     auto pod_info = UPIDtoPod(md, upid_value);
@@ -625,6 +657,8 @@ class UPIDToServiceNameUDF : public ScalarUDF {
  */
 class UPIDToNodeNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
     auto pod_info = UPIDtoPod(md, upid_value);
@@ -797,6 +831,8 @@ inline types::StringValue DeploymentInfoToStatus(const px::md::DeploymentInfo* d
  */
 class ReplicaSetIDToReplicaSetNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue replica_set_id) {
     auto md = GetMetadataState(ctx);
     auto rs_info = md->k8s_metadata_state().ReplicaSetInfoByID(replica_set_id);
@@ -825,6 +861,8 @@ class ReplicaSetIDToReplicaSetNameUDF : public ScalarUDF {
  */
 class ReplicaSetIDToStartTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue replica_set_id) {
     auto md = GetMetadataState(ctx);
     auto rs_info = md->k8s_metadata_state().ReplicaSetInfoByID(replica_set_id);
@@ -849,6 +887,8 @@ class ReplicaSetIDToStartTimeUDF : public ScalarUDF {
  */
 class ReplicaSetIDToStopTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue replica_set_id) {
     auto md = GetMetadataState(ctx);
     auto rs_info = md->k8s_metadata_state().ReplicaSetInfoByID(replica_set_id);
@@ -873,6 +913,8 @@ class ReplicaSetIDToStopTimeUDF : public ScalarUDF {
  */
 class ReplicaSetIDToNamespaceUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue replica_set_id) {
     auto md = GetMetadataState(ctx);
     auto rs_info = md->k8s_metadata_state().ReplicaSetInfoByID(replica_set_id);
@@ -896,6 +938,8 @@ class ReplicaSetIDToNamespaceUDF : public ScalarUDF {
  */
 class ReplicaSetIDToOwnerReferencesUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue replica_set_id) {
     auto md = GetMetadataState(ctx);
     auto rs_info = md->k8s_metadata_state().ReplicaSetInfoByID(replica_set_id);
@@ -926,6 +970,8 @@ class ReplicaSetIDToOwnerReferencesUDF : public ScalarUDF {
  */
 class ReplicaSetIDToStatusUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue replica_set_id) {
     auto md = GetMetadataState(ctx);
     auto rs_info = md->k8s_metadata_state().ReplicaSetInfoByID(replica_set_id);
@@ -950,6 +996,8 @@ class ReplicaSetIDToStatusUDF : public ScalarUDF {
  */
 class ReplicaSetIDToDeploymentNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue replica_set_id) {
     auto md = GetMetadataState(ctx);
     auto rs_info = md->k8s_metadata_state().ReplicaSetInfoByID(replica_set_id);
@@ -980,6 +1028,8 @@ class ReplicaSetIDToDeploymentNameUDF : public ScalarUDF {
  */
 class ReplicaSetIDToDeploymentIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue replica_set_id) {
     auto md = GetMetadataState(ctx);
     auto rs_info = md->k8s_metadata_state().ReplicaSetInfoByID(replica_set_id);
@@ -1010,6 +1060,8 @@ class ReplicaSetIDToDeploymentIDUDF : public ScalarUDF {
  */
 class ReplicaSetNameToReplicaSetIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue replica_set_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1040,6 +1092,8 @@ class ReplicaSetNameToReplicaSetIDUDF : public ScalarUDF {
  */
 class ReplicaSetNameToStartTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue replica_set_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1071,6 +1125,8 @@ class ReplicaSetNameToStartTimeUDF : public ScalarUDF {
  */
 class ReplicaSetNameToStopTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue replica_set_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1102,6 +1158,8 @@ class ReplicaSetNameToStopTimeUDF : public ScalarUDF {
  */
 class ReplicaSetNameToNamespaceUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue replica_set_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1132,6 +1190,8 @@ class ReplicaSetNameToNamespaceUDF : public ScalarUDF {
  */
 class ReplicaSetNameToOwnerReferencesUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue replica_set_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1168,6 +1228,8 @@ class ReplicaSetNameToOwnerReferencesUDF : public ScalarUDF {
  */
 class ReplicaSetNameToStatusUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue replica_set_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1199,6 +1261,8 @@ class ReplicaSetNameToStatusUDF : public ScalarUDF {
  */
 class ReplicaSetNameToDeploymentNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue replica_set_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1234,6 +1298,8 @@ class ReplicaSetNameToDeploymentNameUDF : public ScalarUDF {
  */
 class ReplicaSetNameToDeploymentIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue replica_set_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1269,6 +1335,8 @@ class ReplicaSetNameToDeploymentIDUDF : public ScalarUDF {
  */
 class DeploymentIDToDeploymentNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue deployment_id) {
     auto md = GetMetadataState(ctx);
     auto dep_info = md->k8s_metadata_state().DeploymentInfoByID(deployment_id);
@@ -1297,6 +1365,8 @@ class DeploymentIDToDeploymentNameUDF : public ScalarUDF {
  */
 class DeploymentIDToStartTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue deployment_id) {
     auto md = GetMetadataState(ctx);
     auto dep_info = md->k8s_metadata_state().DeploymentInfoByID(deployment_id);
@@ -1321,6 +1391,8 @@ class DeploymentIDToStartTimeUDF : public ScalarUDF {
  */
 class DeploymentIDToStopTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue deployment_id) {
     auto md = GetMetadataState(ctx);
     auto dep_info = md->k8s_metadata_state().DeploymentInfoByID(deployment_id);
@@ -1344,6 +1416,8 @@ class DeploymentIDToStopTimeUDF : public ScalarUDF {
  */
 class DeploymentIDToNamespaceUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue deployment_id) {
     auto md = GetMetadataState(ctx);
     auto dep_info = md->k8s_metadata_state().DeploymentInfoByID(deployment_id);
@@ -1367,6 +1441,8 @@ class DeploymentIDToNamespaceUDF : public ScalarUDF {
  */
 class DeploymentIDToStatusUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue deployment_id) {
     auto md = GetMetadataState(ctx);
     auto dep_info = md->k8s_metadata_state().DeploymentInfoByID(deployment_id);
@@ -1391,6 +1467,8 @@ class DeploymentIDToStatusUDF : public ScalarUDF {
  */
 class DeploymentNameToDeploymentIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue deployment_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1421,6 +1499,8 @@ class DeploymentNameToDeploymentIDUDF : public ScalarUDF {
  */
 class DeploymentNameToStartTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue deployment_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1452,6 +1532,8 @@ class DeploymentNameToStartTimeUDF : public ScalarUDF {
  */
 class DeploymentNameToStopTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue deployment_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1483,6 +1565,8 @@ class DeploymentNameToStopTimeUDF : public ScalarUDF {
  */
 class DeploymentNameToNamespaceUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue deployment_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1513,6 +1597,8 @@ class DeploymentNameToNamespaceUDF : public ScalarUDF {
  */
 class DeploymentNameToStatusUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue deployment_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1544,6 +1630,8 @@ class DeploymentNameToStatusUDF : public ScalarUDF {
  */
 class UPIDToReplicaSetNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
     auto pod_info = UPIDtoPod(md, upid_value);
@@ -1585,6 +1673,8 @@ class UPIDToReplicaSetNameUDF : public ScalarUDF {
  */
 class UPIDToReplicaSetIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
     auto pod_info = UPIDtoPod(md, upid_value);
@@ -1625,6 +1715,8 @@ class UPIDToReplicaSetIDUDF : public ScalarUDF {
  */
 class UPIDToReplicaSetStatusUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
     auto pod_info = UPIDtoPod(md, upid_value);
@@ -1663,6 +1755,8 @@ class UPIDToReplicaSetStatusUDF : public ScalarUDF {
  */
 class UPIDToDeploymentNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
     auto pod_info = UPIDtoPod(md, upid_value);
@@ -1709,6 +1803,8 @@ class UPIDToDeploymentNameUDF : public ScalarUDF {
  */
 class UPIDToDeploymentIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
     auto pod_info = UPIDtoPod(md, upid_value);
@@ -1754,6 +1850,8 @@ class UPIDToDeploymentIDUDF : public ScalarUDF {
  */
 class UPIDToHostnameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, UInt128Value upid_value) {
     auto md = GetMetadataState(ctx);
     auto pod_info = UPIDtoPod(md, upid_value);
@@ -1782,6 +1880,8 @@ class UPIDToHostnameUDF : public ScalarUDF {
  */
 class PodIDToServiceNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_id) {
     auto md = GetMetadataState(ctx);
 
@@ -1824,6 +1924,8 @@ class PodIDToServiceNameUDF : public ScalarUDF {
  */
 class PodIDToServiceIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_id) {
     auto md = GetMetadataState(ctx);
 
@@ -1860,6 +1962,8 @@ class PodIDToServiceIDUDF : public ScalarUDF {
  */
 class PodIDToOwnerReferencesUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_id) {
     auto md = GetMetadataState(ctx);
 
@@ -1890,6 +1994,8 @@ class PodIDToOwnerReferencesUDF : public ScalarUDF {
  */
 class PodNameToOwnerReferencesUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_name) {
     auto md = GetMetadataState(ctx);
 
@@ -1921,6 +2027,8 @@ class PodNameToOwnerReferencesUDF : public ScalarUDF {
  */
 class PodIDToNodeNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_id) {
     auto md = GetMetadataState(ctx);
 
@@ -1950,6 +2058,8 @@ class PodIDToNodeNameUDF : public ScalarUDF {
  */
 class PodIDToReplicaSetNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_id) {
     auto md = GetMetadataState(ctx);
 
@@ -1983,6 +2093,8 @@ class PodIDToReplicaSetNameUDF : public ScalarUDF {
  */
 class PodIDToReplicaSetIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_id) {
     auto md = GetMetadataState(ctx);
 
@@ -2016,6 +2128,8 @@ class PodIDToReplicaSetIDUDF : public ScalarUDF {
  */
 class PodIDToDeploymentNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_id) {
     auto md = GetMetadataState(ctx);
 
@@ -2054,6 +2168,8 @@ class PodIDToDeploymentNameUDF : public ScalarUDF {
  */
 class PodIDToDeploymentIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_id) {
     auto md = GetMetadataState(ctx);
 
@@ -2092,6 +2208,8 @@ class PodIDToDeploymentIDUDF : public ScalarUDF {
  */
 class PodNameToReplicaSetNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_name) {
     auto md = GetMetadataState(ctx);
 
@@ -2130,6 +2248,8 @@ class PodNameToReplicaSetNameUDF : public ScalarUDF {
  */
 class PodNameToReplicaSetIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_name) {
     auto md = GetMetadataState(ctx);
 
@@ -2168,6 +2288,8 @@ class PodNameToReplicaSetIDUDF : public ScalarUDF {
  */
 class PodNameToDeploymentNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_name) {
     auto md = GetMetadataState(ctx);
 
@@ -2211,6 +2333,8 @@ class PodNameToDeploymentNameUDF : public ScalarUDF {
  */
 class PodNameToDeploymentIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_name) {
     auto md = GetMetadataState(ctx);
 
@@ -2254,6 +2378,8 @@ class PodNameToDeploymentIDUDF : public ScalarUDF {
  */
 class PodNameToServiceNameUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_name) {
     auto md = GetMetadataState(ctx);
 
@@ -2300,6 +2426,8 @@ class PodNameToServiceNameUDF : public ScalarUDF {
  */
 class PodNameToServiceIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue pod_name) {
     auto md = GetMetadataState(ctx);
 
@@ -2397,6 +2525,8 @@ class UPIDToStartTSUDF : public ScalarUDF {
 
 class PodIDToPodStartTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue pod_id) {
     auto md = GetMetadataState(ctx);
     const px::md::PodInfo* pod_info = md->k8s_metadata_state().PodInfoByID(pod_id);
@@ -2416,6 +2546,8 @@ class PodIDToPodStartTimeUDF : public ScalarUDF {
 
 class PodIDToPodStopTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue pod_id) {
     auto md = GetMetadataState(ctx);
     const px::md::PodInfo* pod_info = md->k8s_metadata_state().PodInfoByID(pod_id);
@@ -2435,6 +2567,8 @@ class PodIDToPodStopTimeUDF : public ScalarUDF {
 
 class PodNameToPodStartTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue pod_name) {
     auto md = GetMetadataState(ctx);
     StringValue pod_id = PodNameToPodIDUDF::GetPodID(md, pod_name);
@@ -2455,6 +2589,8 @@ class PodNameToPodStartTimeUDF : public ScalarUDF {
 
 class PodNameToPodStopTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue pod_name) {
     auto md = GetMetadataState(ctx);
     StringValue pod_id = PodNameToPodIDUDF::GetPodID(md, pod_name);
@@ -2475,6 +2611,8 @@ class PodNameToPodStopTimeUDF : public ScalarUDF {
 
 class ContainerNameToContainerIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue container_name) {
     auto md = GetMetadataState(ctx);
     return md->k8s_metadata_state().ContainerIDByName(container_name);
@@ -2491,6 +2629,8 @@ class ContainerNameToContainerIDUDF : public ScalarUDF {
 
 class ContainerIDToContainerStartTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue container_id) {
     auto md = GetMetadataState(ctx);
     const px::md::ContainerInfo* container_info =
@@ -2513,6 +2653,8 @@ class ContainerIDToContainerStartTimeUDF : public ScalarUDF {
 
 class ContainerIDToContainerStopTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue container_id) {
     auto md = GetMetadataState(ctx);
     const px::md::ContainerInfo* container_info =
@@ -2535,6 +2677,8 @@ class ContainerIDToContainerStopTimeUDF : public ScalarUDF {
 
 class ContainerNameToContainerStartTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue container_name) {
     auto md = GetMetadataState(ctx);
     StringValue container_id = md->k8s_metadata_state().ContainerIDByName(container_name);
@@ -2557,6 +2701,8 @@ class ContainerNameToContainerStartTimeUDF : public ScalarUDF {
 
 class ContainerNameToContainerStopTimeUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   Time64NSValue Exec(FunctionContext* ctx, StringValue container_name) {
     auto md = GetMetadataState(ctx);
     StringValue container_id = md->k8s_metadata_state().ContainerIDByName(container_name);
@@ -2626,6 +2772,8 @@ inline types::StringValue PodInfoToPodStatus(const px::md::PodInfo* pod_info) {
 
 class PodNameToPodStatusUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   /**
    * @brief Gets the Pod status for a passed in pod.
    *
@@ -2662,6 +2810,8 @@ class PodNameToPodStatusUDF : public ScalarUDF {
 
 class PodNameToPodReadyUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   BoolValue Exec(FunctionContext* ctx, StringValue pod_name) {
     auto md = GetMetadataState(ctx);
     StringValue pod_id = PodNameToPodIDUDF::GetPodID(md, pod_name);
@@ -2695,6 +2845,8 @@ class PodNameToPodReadyUDF : public ScalarUDF {
 
 class PodNameToPodStatusMessageUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   /**
    * @brief Gets the Pod status message for a passed in pod.
    *
@@ -2715,6 +2867,8 @@ class PodNameToPodStatusMessageUDF : public ScalarUDF {
 
 class PodNameToPodStatusReasonUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   /**
    * @brief Gets the Pod status reason for a passed in pod.
    *
@@ -2749,6 +2903,8 @@ inline std::string ContainerStateToString(const px::md::ContainerState& containe
 
 class ContainerIDToContainerStatusUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   /**
    * @brief Gets the Container status for a passed in container.
    *
@@ -2799,6 +2955,8 @@ class ContainerIDToContainerStatusUDF : public ScalarUDF {
 
 class UPIDToPodStatusUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   /**
    * @brief Gets the Pod status for a passed in UPID.
    *
@@ -2838,6 +2996,8 @@ class UPIDToPodStatusUDF : public ScalarUDF {
 
 class UPIDToCmdLineUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   /**
    * @brief Gets the cmdline for the upid.
    *
@@ -2879,6 +3039,8 @@ inline std::string PodInfoToPodQoS(const px::md::PodInfo* pod_info) {
 
 class UPIDToPodQoSUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   /**
    * @brief Gets the qos for the upid's pod.
    *
@@ -2946,6 +3108,8 @@ class HostNumCPUsUDF : public ScalarUDF {
 
 class IPToPodIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   /**
    * @brief Gets the pod id of pod with given pod_ip
    */
@@ -2979,6 +3143,8 @@ class IPToPodIDUDF : public ScalarUDF {
 
 class IPToServiceIDUDF : public ScalarUDF {
  public:
+  static constexpr bool MemoizeExec() { return true; }
+
   StringValue Exec(FunctionContext* ctx, StringValue ip) {
     auto md = GetMetadataState(ctx);
     // First, check the list of Service Cluster IPs for this IP.
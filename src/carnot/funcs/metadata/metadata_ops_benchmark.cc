@@ -0,0 +1,145 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <absl/strings/substitute.h>
+
+#include "src/carnot/funcs/metadata/metadata_ops.h"
+#include "src/carnot/udf/udf_wrapper.h"
+#include "src/common/base/base.h"
+#include "src/shared/metadata/metadata_state.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/types.h"
+
+using px::carnot::funcs::metadata::PodIDToPodNameUDF;
+using px::carnot::funcs::metadata::PodNameToPodIPUDF;
+using px::carnot::funcs::metadata::UPIDToPodNameUDF;
+using px::carnot::udf::FunctionContext;
+using px::carnot::udf::ScalarUDFWrapper;
+using px::md::AgentMetadataState;
+using px::md::CID;
+using px::md::K8sMetadataState;
+using px::md::PIDInfo;
+using px::md::UPID;
+using px::types::StringValue;
+using px::types::UInt128Value;
+
+// All benchmarks take whether to memoize the UDFs as their first argument, and the number of
+// distinct values in the input column as their second one.
+
+constexpr int kNumPods = 5000;
+constexpr size_t kBatchSize = 8192;
+
+// A state with kNumPods pods, each with one container running one process.
+std::shared_ptr<const AgentMetadataState> MakeState() {
+  auto md = std::make_shared<AgentMetadataState>(/* asid */ 1, /* pid */ 1);
+  for (int i = 0; i < kNumPods; ++i) {
+    K8sMetadataState::ContainerUpdate container;
+    container.set_cid(absl::Substitute("container$0_uid", i));
+    container.set_name(absl::Substitute("container$0", i));
+    container.set_pod_id(absl::Substitute("pod$0_uid", i));
+    container.set_start_timestamp_ns(1);
+    PX_CHECK_OK(md->k8s_metadata_state()->HandleContainerUpdate(container));
+
+    K8sMetadataState::PodUpdate pod;
+    pod.set_uid(absl::Substitute("pod$0_uid", i));
+    pod.set_name(absl::Substitute("pod$0", i));
+    pod.set_namespace_(absl::Substitute("ns$0", i % 10));
+    pod.add_container_ids(absl::Substitute("container$0_uid", i));
+    pod.add_container_names(absl::Substitute("container$0", i));
+    pod.set_pod_ip(absl::Substitute("10.0.$0.$1", i >> 8, i & 0xff));
+    pod.set_start_timestamp_ns(1);
+    PX_CHECK_OK(md->k8s_metadata_state()->HandlePodUpdate(pod));
+
+    UPID upid(md->asid(), i, i);
+    md->AddUPID(upid, std::make_unique<PIDInfo>(upid, "/usr/bin/server", "server",
+                                                CID(absl::Substitute("container$0_uid", i))));
+  }
+  return md;
+}
+
+// A column of kBatchSize values picked at random among num_distinct of the kNumPods objects.
+// Records of the same process tend to come in runs, like in the tables written by Stirling.
+template <typename TValue, typename TFn>
+std::shared_ptr<arrow::Array> MakeColumn(int num_distinct, TFn value_fn) {
+  std::mt19937 gen(37);
+  std::uniform_int_distribution<int> object_dist(0, num_distinct - 1);
+  std::uniform_int_distribution<int> run_dist(1, 8);
+  std::vector<TValue> values;
+  values.reserve(kBatchSize);
+  while (values.size() < kBatchSize) {
+    TValue value = value_fn(object_dist(gen) * (kNumPods / num_distinct));
+    for (int run = run_dist(gen); run > 0 && values.size() < kBatchSize; --run) {
+      values.push_back(value);
+    }
+  }
+  return px::types::ToArrow(values, arrow::default_memory_pool());
+}
+
+template <typename TUDF>
+void ExecBatch(benchmark::State& state, const std::shared_ptr<arrow::Array>& input) {  // NOLINT
+  FLAGS_carnot_udf_memoize_exec = state.range(0);
+  FunctionContext ctx(MakeState(), nullptr);
+  TUDF udf;
+  for (auto _ : state) {
+    arrow::StringBuilder builder;
+    PX_CHECK_OK(
+        ScalarUDFWrapper<TUDF>::ExecBatchArrow(&udf, &ctx, {input.get()}, &builder, kBatchSize));
+    std::shared_ptr<arrow::Array> out;
+    PX_CHECK_OK(builder.Finish(&out));
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kBatchSize);
+}
+
+UInt128Value UPIDValue(int i) { return UPID(1, i, i).value(); }
+
+// NOLINTNEXTLINE(runtime/references)
+static void BM_UPIDToPodName(benchmark::State& state) {
+  ExecBatch<UPIDToPodNameUDF>(state, MakeColumn<UInt128Value>(state.range(1), UPIDValue));
+}
+
+// NOLINTNEXTLINE(runtime/references)
+static void BM_PodIDToPodName(benchmark::State& state) {
+  ExecBatch<PodIDToPodNameUDF>(state, MakeColumn<StringValue>(state.range(1), [](int i) {
+                                 return StringValue(absl::Substitute("pod$0_uid", i));
+                               }));
+}
+
+// NOLINTNEXTLINE(runtime/references)
+static void BM_PodNameToPodIP(benchmark::State& state) {
+  ExecBatch<PodNameToPodIPUDF>(state, MakeColumn<StringValue>(state.range(1), [](int i) {
+                                 return StringValue(absl::Substitute("ns$0/pod$1", i % 10, i));
+                               }));
+}
+
+BENCHMARK(BM_UPIDToPodName)
+    ->Args({false, 10})
+    ->Args({true, 10})
+    ->Args({false, 500})
+    ->Args({true, 500})
+    ->Args({false, 5000})
+    ->Args({true, 5000});
+BENCHMARK(BM_PodIDToPodName)->Args({false, 500})->Args({true, 500});
+BENCHMARK(BM_PodNameToPodIP)->Args({false, 500})->Args({true, 500});
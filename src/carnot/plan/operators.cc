@@ -26,6 +26,7 @@
 #include <utility>
 #include <vector>
 
+#include <absl/strings/str_cat.h>
 #include <absl/strings/str_join.h>
 #include <absl/strings/substitute.h>
 #include <magic_enum.hpp>
@@ -36,6 +37,7 @@
 #include "src/carnot/udf/udf_definition.h"
 #include "src/carnot/udf/udtf.h"
 #include "src/common/base/base.h"
+#include "src/shared/types/type_utils.h"
 #include "src/table_store/table_store.h"
 
 namespace px {
@@ -78,6 +80,10 @@ std::unique_ptr<Operator> Operator::FromProto(const planpb::Operator& pb, int64_
       return CreateOperator<UnionOperator>(id, pb.union_op());
     case planpb::JOIN_OPERATOR:
       return CreateOperator<JoinOperator>(id, pb.join_op());
+    case planpb::ROLLING_OPERATOR:
+      return CreateOperator<RollingOperator>(id, pb.rolling_op());
+    case planpb::SORT_OPERATOR:
+      return CreateOperator<SortOperator>(id, pb.sort_op());
     case planpb::UDTF_SOURCE_OPERATOR:
       return CreateOperator<UDTFSourceOperator>(id, pb.udtf_source_op());
     case planpb::EMPTY_SOURCE_OPERATOR:
@@ -95,16 +101,82 @@ std::unique_ptr<Operator> Operator::FromProto(const planpb::Operator& pb, int64_
  */
 
 std::string MemorySourceOperator::DebugString() const {
-  return absl::Substitute("Op:MemorySource($0, [$1], start=$2, end=$3, streaming=$4)", TableName(),
-                          absl::StrJoin(Columns(), ","), start_time(), stop_time(), streaming());
+  std::string debug_string =
+      absl::Substitute("Op:MemorySource($0, [$1], start=$2, end=$3, streaming=$4", TableName(),
+                       absl::StrJoin(Columns(), ","), start_time(), stop_time(), streaming());
+  if (!predicates_.empty()) {
+    absl::StrAppend(&debug_string, ", predicates=[",
+                    absl::StrJoin(predicates_, ",",
+                                  [](std::string* out, const table_store::ColumnPredicate& p) {
+                                    absl::StrAppend(out, p.DebugString());
+                                  }),
+                    "]");
+  }
+  if (pb_.tablets_size() > 0) {
+    absl::StrAppend(&debug_string, ", tablets=[", absl::StrJoin(pb_.tablets(), ","), "]");
+  }
+  return debug_string + ")";
+}
+
+namespace {
+
+StatusOr<table_store::ColumnPredicate::Op> ConvertPredicateOp(planpb::ColumnPredicate::Op op) {
+  using Op = table_store::ColumnPredicate::Op;
+  switch (op) {
+    case planpb::ColumnPredicate::EQUAL:
+      return Op::kEqual;
+    case planpb::ColumnPredicate::NOT_EQUAL:
+      return Op::kNotEqual;
+    case planpb::ColumnPredicate::LESS_THAN:
+      return Op::kLessThan;
+    case planpb::ColumnPredicate::LESS_THAN_EQUAL:
+      return Op::kLessThanEqual;
+    case planpb::ColumnPredicate::GREATER_THAN:
+      return Op::kGreaterThan;
+    case planpb::ColumnPredicate::GREATER_THAN_EQUAL:
+      return Op::kGreaterThanEqual;
+    default:
+      return error::InvalidArgument("Unknown column predicate op: $0",
+                                    planpb::ColumnPredicate::Op_Name(op));
+  }
+}
+
+StatusOr<table_store::ZoneMapValue> ConvertPredicateValue(const planpb::ScalarValue& value) {
+  switch (value.value_case()) {
+    case planpb::ScalarValue::kBoolValue:
+      return table_store::ZoneMapValue(value.bool_value());
+    case planpb::ScalarValue::kInt64Value:
+      return table_store::ZoneMapValue(value.int64_value());
+    case planpb::ScalarValue::kTime64NsValue:
+      return table_store::ZoneMapValue(value.time64_ns_value());
+    case planpb::ScalarValue::kFloat64Value:
+      return table_store::ZoneMapValue(value.float64_value());
+    case planpb::ScalarValue::kStringValue:
+      return table_store::ZoneMapValue(value.string_value());
+    case planpb::ScalarValue::kUint128Value:
+      return table_store::ZoneMapValue(
+          absl::MakeUint128(value.uint128_value().high(), value.uint128_value().low()));
+    default:
+      return error::InvalidArgument("Column predicate is missing a value");
+  }
 }
 
+}  // namespace
+
 Status MemorySourceOperator::Init(const planpb::MemorySourceOperator& pb) {
   pb_ = pb;
   column_idxs_.reserve(static_cast<size_t>(pb_.column_idxs_size()));
   for (int i = 0; i < pb_.column_idxs_size(); ++i) {
     column_idxs_.emplace_back(pb_.column_idxs(i));
   }
+  predicates_.reserve(static_cast<size_t>(pb_.predicates_size()));
+  for (const auto& predicate_pb : pb_.predicates()) {
+    table_store::ColumnPredicate predicate;
+    predicate.col_idx = predicate_pb.column_idx();
+    PX_ASSIGN_OR_RETURN(predicate.op, ConvertPredicateOp(predicate_pb.op()));
+    PX_ASSIGN_OR_RETURN(predicate.value, ConvertPredicateValue(predicate_pb.value()));
+    predicates_.push_back(std::move(predicate));
+  }
   is_initialized_ = true;
   return Status::OK();
 }
@@ -324,12 +396,27 @@ std::string GRPCSinkOperator::DebugString() const {
     destination = absl::Substitute("table_name=$0", table_name());
   } else if (has_grpc_source_id()) {
     destination = absl::Substitute("source_id=$0", grpc_source_id());
+  } else if (has_partitions()) {
+    std::vector<std::string> partitions;
+    for (const auto& partition : this->partitions()) {
+      partitions.push_back(
+          absl::Substitute("$0/$1", partition.address(), partition.grpc_source_id()));
+    }
+    destination = absl::Substitute("keys=[$0], partitions=[$1]",
+                                   absl::StrJoin(partition_key_column_indexes(), ","),
+                                   absl::StrJoin(partitions, ","));
   }
   return absl::Substitute("Op:GRPCSink($0, $1)", address(), destination);
 }
 
 Status GRPCSinkOperator::Init(const planpb::GRPCSinkOperator& pb) {
   pb_ = pb;
+  if (has_partitions() && (partitions().empty() || partition_key_column_indexes().empty())) {
+    return error::InvalidArgument(
+        "GRPCSink partitioned on $0 key columns across $1 destinations, expected at least one of "
+        "each",
+        partition_key_column_indexes().size(), partitions().size());
+  }
   is_initialized_ = true;
   return Status::OK();
 }
@@ -649,6 +736,182 @@ planpb::JoinOperator::ParentColumn JoinOperator::time_column() const {
   return output_columns()[pos];
 }
 
+/**
+ * Rolling Operator Implementation.
+ */
+
+std::string RollingOperator::DebugString() const {
+  std::vector<std::string> values;
+  for (const auto& [i, value] : Enumerate(values_)) {
+    values.push_back(absl::Substitute("$0=$1($2)", pb_.value_names(i),
+                                      magic_enum::enum_name(value.function()),
+                                      value.arg().index()));
+  }
+  return absl::Substitute("Op:Rolling(window_col=$0, window_size=$1, values=($2), groups=($3))",
+                          window_col(), window_size(), absl::StrJoin(values, ", "),
+                          absl::StrJoin(pb_.group_names(), ", "));
+}
+
+Status RollingOperator::Init(const planpb::RollingOperator& pb) {
+  pb_ = pb;
+  if (pb_.window_size() <= 0) {
+    return error::InvalidArgument("Rolling window size must be > 0, got $0", pb_.window_size());
+  }
+  if (pb_.groups_size() != pb_.group_names_size()) {
+    return error::InvalidArgument("group names/exp size mismatch");
+  }
+  if (pb_.values_size() != pb_.value_names_size()) {
+    return error::InvalidArgument("values names/exp size mismatch");
+  }
+  groups_.reserve(pb_.groups_size());
+  for (const auto& group : pb_.groups()) {
+    groups_.push_back(group.index());
+  }
+  values_.assign(pb_.values().begin(), pb_.values().end());
+
+  is_initialized_ = true;
+  return Status::OK();
+}
+
+StatusOr<types::DataType> RollingOperator::ValueDataType(
+    planpb::RollingOperator::Function function, types::DataType arg_type) {
+  switch (function) {
+    case planpb::RollingOperator::COUNT:
+      return types::INT64;
+    case planpb::RollingOperator::MEAN:
+      if (arg_type == types::INT64 || arg_type == types::FLOAT64) {
+        return types::FLOAT64;
+      }
+      break;
+    case planpb::RollingOperator::SUM:
+      if (arg_type == types::INT64 || arg_type == types::FLOAT64) {
+        return arg_type;
+      }
+      break;
+    case planpb::RollingOperator::MIN:
+    case planpb::RollingOperator::MAX:
+      if (arg_type == types::INT64 || arg_type == types::FLOAT64 || arg_type == types::TIME64NS) {
+        return arg_type;
+      }
+      break;
+    default:
+      return error::InvalidArgument("Unknown rolling function $0",
+                                    magic_enum::enum_name(function));
+  }
+  return error::InvalidArgument("Rolling function $0 does not support $1 columns",
+                                magic_enum::enum_name(function), types::ToString(arg_type));
+}
+
+StatusOr<table_store::schema::Relation> RollingOperator::OutputRelation(
+    const table_store::schema::Schema& schema, const PlanState& /*state*/,
+    const std::vector<int64_t>& input_ids) const {
+  DCHECK(is_initialized_) << "Not initialized";
+  if (input_ids.size() != 1) {
+    return error::InvalidArgument("Rolling operator must have exactly one input");
+  }
+  if (!schema.HasRelation(input_ids[0])) {
+    return error::NotFound("Missing relation ($0) for input of RollingOperator", input_ids[0]);
+  }
+  PX_ASSIGN_OR_RETURN(const auto& input_relation, schema.GetRelation(input_ids[0]));
+  auto num_columns = static_cast<int64_t>(input_relation.NumColumns());
+  auto check_column = [&](int64_t col_idx) -> Status {
+    if (col_idx < 0 || col_idx >= num_columns) {
+      return error::InvalidArgument("Column index $0 is out of bounds for node $1", col_idx,
+                                    input_ids[0]);
+    }
+    return Status::OK();
+  };
+
+  table_store::schema::Relation output_relation;
+  PX_RETURN_IF_ERROR(check_column(window_col()));
+  auto window_type = input_relation.GetColumnType(window_col());
+  if (window_type != types::TIME64NS && window_type != types::INT64) {
+    return error::InvalidArgument("Rolling window column must be TIME64NS or INT64, got $0",
+                                  types::ToString(window_type));
+  }
+  output_relation.AddColumn(window_type, input_relation.GetColumnName(window_col()));
+
+  for (const auto& [i, col_idx] : Enumerate(groups_)) {
+    PX_RETURN_IF_ERROR(check_column(col_idx));
+    output_relation.AddColumn(input_relation.GetColumnType(col_idx), pb_.group_names(i));
+  }
+  for (const auto& [i, value] : Enumerate(values_)) {
+    types::DataType arg_type = types::INT64;
+    if (value.function() != planpb::RollingOperator::COUNT) {
+      PX_RETURN_IF_ERROR(check_column(value.arg().index()));
+      arg_type = input_relation.GetColumnType(value.arg().index());
+    }
+    PX_ASSIGN_OR_RETURN(auto dt, ValueDataType(value.function(), arg_type));
+    output_relation.AddColumn(dt, pb_.value_names(i));
+  }
+  return output_relation;
+}
+
+/**
+ * Sort Operator Implementation.
+ */
+
+std::string SortOperator::DebugString() const {
+  std::vector<std::string> sort_cols;
+  for (const auto& sort_col : sort_columns_) {
+    sort_cols.push_back(absl::Substitute("$0 $1", sort_col.column().index(),
+                                         sort_col.ascending() ? "asc" : "desc"));
+  }
+  return absl::Substitute("Op:Sort(by=[$0], limit=$1, cols: [$2])", absl::StrJoin(sort_cols, ","),
+                          limit(), absl::StrJoin(selected_cols_, ","));
+}
+
+Status SortOperator::Init(const planpb::SortOperator& pb) {
+  pb_ = pb;
+  if (pb_.sort_columns_size() == 0) {
+    return error::InvalidArgument("Sort operator must have at least one sort column");
+  }
+  if (pb_.limit() < 0) {
+    return error::InvalidArgument("Sort limit must be >= 0, got $0", pb_.limit());
+  }
+  selected_cols_.reserve(pb_.columns_size());
+  for (const auto& col : pb_.columns()) {
+    selected_cols_.push_back(col.index());
+  }
+  sort_columns_.assign(pb_.sort_columns().begin(), pb_.sort_columns().end());
+
+  is_initialized_ = true;
+  return Status::OK();
+}
+
+StatusOr<table_store::schema::Relation> SortOperator::OutputRelation(
+    const table_store::schema::Schema& schema, const PlanState& /*state*/,
+    const std::vector<int64_t>& input_ids) const {
+  DCHECK(is_initialized_) << "Not initialized";
+  if (input_ids.size() != 1) {
+    return error::InvalidArgument("Sort operator must have exactly one input");
+  }
+  if (!schema.HasRelation(input_ids[0])) {
+    return error::NotFound("Missing relation ($0) for input of SortOperator", input_ids[0]);
+  }
+  PX_ASSIGN_OR_RETURN(const auto& input_relation, schema.GetRelation(input_ids[0]));
+  auto num_columns = static_cast<int64_t>(input_relation.NumColumns());
+  auto check_column = [&](int64_t col_idx) -> Status {
+    if (col_idx < 0 || col_idx >= num_columns) {
+      return error::InvalidArgument("Column index $0 is out of bounds for node $1", col_idx,
+                                    input_ids[0]);
+    }
+    return Status::OK();
+  };
+
+  for (const auto& sort_col : sort_columns_) {
+    PX_RETURN_IF_ERROR(check_column(sort_col.column().index()));
+  }
+  table_store::schema::Relation output_relation;
+  for (auto col_idx : selected_cols_) {
+    PX_RETURN_IF_ERROR(check_column(col_idx));
+    output_relation.AddColumn(input_relation.GetColumnType(col_idx),
+                              input_relation.GetColumnName(col_idx),
+                              input_relation.GetColumnDesc(col_idx));
+  }
+  return output_relation;
+}
+
 Status UDTFSourceOperator::Init(const planpb::UDTFSourceOperator& pb) {
   pb_ = pb;
 
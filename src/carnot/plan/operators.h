@@ -96,11 +96,20 @@ class MemorySourceOperator : public Operator {
   int64_t stop_time() const { return pb_.stop_time().value(); }
   std::vector<int64_t> Columns() const { return column_idxs_; }
   const types::TabletID& Tablet() const { return pb_.tablet(); }
+  // The tablets to read, which is just Tablet() unless several tablets are given.
+  std::vector<types::TabletID> Tablets() const {
+    if (pb_.tablets_size() == 0) {
+      return {pb_.tablet()};
+    }
+    return {pb_.tablets().begin(), pb_.tablets().end()};
+  }
   bool streaming() const { return pb_.streaming(); }
+  const std::vector<table_store::ColumnPredicate>& predicates() const { return predicates_; }
 
  private:
   planpb::MemorySourceOperator pb_;
   std::vector<int64_t> column_idxs_;
+  std::vector<table_store::ColumnPredicate> predicates_;
 };
 
 class MapOperator : public Operator {
@@ -144,6 +153,11 @@ class AggregateOperator : public Operator {
   const std::vector<GroupInfo>& groups() const { return groups_; }
   const std::vector<std::shared_ptr<AggregateExpression>>& values() const { return values_; }
   bool windowed() const { return pb_.windowed(); }
+  // Whether the aggregate outputs its partial aggregates, serialized into a single column,
+  // instead of their results.
+  bool partial_agg() const { return pb_.partial_agg() && !pb_.finalize_results(); }
+  // Whether the aggregate merges the serialized partial aggregates of other aggregates.
+  bool finalize_results() const { return pb_.finalize_results() && !pb_.partial_agg(); }
 
  private:
   std::vector<std::shared_ptr<AggregateExpression>> values_;
@@ -215,6 +229,18 @@ class GRPCSinkOperator : public Operator {
   }
   std::string table_name() const { return pb_.output_table().table_name(); }
 
+  // Whether the rows are hash partitioned across several GRPC Sources.
+  bool has_partitions() const {
+    return pb_.destination_case() == planpb::GRPCSinkOperator::kPartitioned;
+  }
+  const google::protobuf::RepeatedField<int64_t>& partition_key_column_indexes() const {
+    return pb_.partitioned().key_column_indexes();
+  }
+  const google::protobuf::RepeatedPtrField<planpb::GRPCSinkOperator::Partition>& partitions()
+      const {
+    return pb_.partitioned().partitions();
+  }
+
  private:
   planpb::GRPCSinkOperator pb_;
 };
@@ -325,6 +351,59 @@ class JoinOperator : public Operator {
   planpb::JoinOperator pb_;
 };
 
+class RollingOperator : public Operator {
+ public:
+  explicit RollingOperator(int64_t id) : Operator(id, planpb::ROLLING_OPERATOR) {}
+  ~RollingOperator() override = default;
+
+  StatusOr<table_store::schema::Relation> OutputRelation(
+      const table_store::schema::Schema& schema, const PlanState& state,
+      const std::vector<int64_t>& input_ids) const override;
+  Status Init(const planpb::RollingOperator& pb);
+  std::string DebugString() const override;
+
+  /**
+   * Returns the output type of the given function applied to a column of arg_type, or an error if
+   * the function doesn't support that type.
+   */
+  static StatusOr<types::DataType> ValueDataType(planpb::RollingOperator::Function function,
+                                                 types::DataType arg_type);
+
+  int64_t window_col() const { return pb_.window_col().index(); }
+  int64_t window_size() const { return pb_.window_size(); }
+  const std::vector<int64_t>& groups() const { return groups_; }
+  const std::vector<planpb::RollingOperator::Value>& values() const { return values_; }
+
+ private:
+  std::vector<int64_t> groups_;
+  std::vector<planpb::RollingOperator::Value> values_;
+  planpb::RollingOperator pb_;
+};
+
+class SortOperator : public Operator {
+ public:
+  explicit SortOperator(int64_t id) : Operator(id, planpb::SORT_OPERATOR) {}
+  ~SortOperator() override = default;
+
+  StatusOr<table_store::schema::Relation> OutputRelation(
+      const table_store::schema::Schema& schema, const PlanState& state,
+      const std::vector<int64_t>& input_ids) const override;
+  Status Init(const planpb::SortOperator& pb);
+  std::string DebugString() const override;
+
+  const std::vector<int64_t>& selected_cols() const { return selected_cols_; }
+  const std::vector<planpb::SortOperator::SortColumn>& sort_columns() const {
+    return sort_columns_;
+  }
+  // The number of rows to output, or 0 to output all of them.
+  int64_t limit() const { return pb_.limit(); }
+
+ private:
+  std::vector<int64_t> selected_cols_;
+  std::vector<planpb::SortOperator::SortColumn> sort_columns_;
+  planpb::SortOperator pb_;
+};
+
 class UDTFSourceOperator : public Operator {
  public:
   explicit UDTFSourceOperator(int64_t id) : Operator(id, planpb::UDTF_SOURCE_OPERATOR) {}
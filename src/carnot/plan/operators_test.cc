@@ -19,6 +19,7 @@
 #include "src/carnot/plan/operators.h"
 
 #include <gmock/gmock.h>
+#include <google/protobuf/text_format.h>
 #include <gtest/gtest.h>
 
 #include "src/carnot/planpb/plan.pb.h"
@@ -131,6 +132,54 @@ TEST_F(OperatorTest, from_proto_streaming_source) {
   EXPECT_TRUE(src_plan_node->streaming());
 }
 
+TEST_F(OperatorTest, from_proto_mem_src_with_predicates) {
+  planpb::MemorySourceOperator src_pb;
+  ASSERT_TRUE(google::protobuf::TextFormat::MergeFromString(R"(
+name: "cpu"
+column_idxs: 1
+column_types: FLOAT64
+column_names: "usage"
+predicates {
+  column_idx: 1
+  op: GREATER_THAN
+  value { data_type: FLOAT64 float64_value: 0.5 }
+}
+predicates {
+  column_idx: 0
+  op: EQUAL
+  value { data_type: TIME64NS time64_ns_value: 10 }
+}
+)",
+                                                            &src_pb));
+  MemorySourceOperator src_op(1);
+  ASSERT_OK(src_op.Init(src_pb));
+
+  ASSERT_EQ(2U, src_op.predicates().size());
+  EXPECT_EQ(1, src_op.predicates()[0].col_idx);
+  EXPECT_EQ(table_store::ColumnPredicate::Op::kGreaterThan, src_op.predicates()[0].op);
+  EXPECT_EQ(table_store::ZoneMapValue(0.5), src_op.predicates()[0].value);
+  EXPECT_EQ(0, src_op.predicates()[1].col_idx);
+  EXPECT_EQ(table_store::ColumnPredicate::Op::kEqual, src_op.predicates()[1].op);
+  EXPECT_EQ(table_store::ZoneMapValue(int64_t{10}), src_op.predicates()[1].value);
+}
+
+TEST_F(OperatorTest, from_proto_mem_src_with_invalid_predicate) {
+  planpb::MemorySourceOperator src_pb;
+  ASSERT_TRUE(google::protobuf::TextFormat::MergeFromString(R"(
+name: "cpu"
+column_idxs: 1
+column_types: FLOAT64
+column_names: "usage"
+predicates {
+  column_idx: 1
+  op: GREATER_THAN
+}
+)",
+                                                            &src_pb));
+  MemorySourceOperator src_op(1);
+  EXPECT_NOT_OK(src_op.Init(src_pb));
+}
+
 TEST_F(OperatorTest, from_proto_mem_sink) {
   auto sink_pb = planpb::testutils::CreateTestSink1PB();
   auto sink_op = Operator::FromProto(sink_pb, 1);
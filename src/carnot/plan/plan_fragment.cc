@@ -80,6 +80,12 @@ Status PlanFragmentWalker::CallWalkFn(const Operator& op) {
     case planpb::OperatorType::JOIN_OPERATOR:
       PX_RETURN_IF_ERROR(CallAs<JoinOperator>(on_join_walk_fn_, op));
       break;
+    case planpb::OperatorType::ROLLING_OPERATOR:
+      PX_RETURN_IF_ERROR(CallAs<RollingOperator>(on_rolling_walk_fn_, op));
+      break;
+    case planpb::OperatorType::SORT_OPERATOR:
+      PX_RETURN_IF_ERROR(CallAs<SortOperator>(on_sort_walk_fn_, op));
+      break;
     case planpb::OperatorType::UNION_OPERATOR:
       PX_RETURN_IF_ERROR(CallAs<UnionOperator>(on_union_walk_fn_, op));
       break;
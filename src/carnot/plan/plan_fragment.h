@@ -71,6 +71,8 @@ class PlanFragmentWalker {
   using LimitWalkFn = std::function<Status(const LimitOperator&)>;
   using UnionWalkFn = std::function<Status(const UnionOperator&)>;
   using JoinWalkFn = std::function<Status(const JoinOperator&)>;
+  using RollingWalkFn = std::function<Status(const RollingOperator&)>;
+  using SortWalkFn = std::function<Status(const SortOperator&)>;
   using GRPCSinkWalkFn = std::function<Status(const GRPCSinkOperator&)>;
   using GRPCSourceWalkFn = std::function<Status(const GRPCSourceOperator&)>;
   using UDTFSourceWalkFn = std::function<Status(const UDTFSourceOperator&)>;
@@ -157,6 +159,26 @@ class PlanFragmentWalker {
     return *this;
   }
 
+  /**
+   * Register callback for when a rolling operator is encountered.
+   * @param fn The function to call when a RollingOperator is encountered.
+   * @return self to allow chaining
+   */
+  PlanFragmentWalker& OnRolling(const RollingWalkFn& fn) {
+    on_rolling_walk_fn_ = fn;
+    return *this;
+  }
+
+  /**
+   * Register callback for when a sort operator is encountered.
+   * @param fn The function to call when a SortOperator is encountered.
+   * @return self to allow chaining
+   */
+  PlanFragmentWalker& OnSort(const SortWalkFn& fn) {
+    on_sort_walk_fn_ = fn;
+    return *this;
+  }
+
   PlanFragmentWalker& OnGRPCSource(const GRPCSourceWalkFn& fn) {
     on_grpc_source_walk_fn_ = fn;
     return *this;
@@ -201,6 +223,8 @@ class PlanFragmentWalker {
   LimitWalkFn on_limit_walk_fn_;
   UnionWalkFn on_union_walk_fn_;
   JoinWalkFn on_join_walk_fn_;
+  RollingWalkFn on_rolling_walk_fn_;
+  SortWalkFn on_sort_walk_fn_;
   GRPCSinkWalkFn on_grpc_sink_walk_fn_;
   GRPCSourceWalkFn on_grpc_source_walk_fn_;
   UDTFSourceWalkFn on_udtf_source_walk_fn_;
@@ -2501,6 +2501,60 @@ TEST_F(CompilerTest, BadDropQuery) {
   EXPECT_THAT(*map->resolved_table_type(), IsTableType(expected_relation));
 }
 
+constexpr char kQuantilesPluckQuery[] = R"pxl(
+import px
+t1 = px.DataFrame(table='http_events', start_time='-300s')
+t1['service'] = t1.ctx['service']
+t1['latency_ms'] = t1['resp_latency_ns'] / 1.0E6
+df = t1.groupby('service').agg(quantiles=('latency_ms', px.quantiles))
+df['p50'] = px.pluck_float64(df['quantiles'], 'p50')
+df['p90'] = px.pluck_float64(df['quantiles'], 'p90')
+df['p99'] = px.pluck_float64(df['quantiles'], 'p99')
+df = df[['service', 'p50', 'p90', 'p99']]
+px.display(df)
+)pxl";
+
+// The quantiles are only plucked, so they are computed natively instead of as JSON.
+TEST_F(CompilerTest, QuantilesPluckedNatively) {
+  auto graph_or_s = compiler_.CompileToIR(kQuantilesPluckQuery, compiler_state_.get());
+  ASSERT_OK(graph_or_s);
+  auto graph = graph_or_s.ConsumeValueOrDie();
+
+  auto aggs = graph->FindNodesThatMatch(BlockingAgg());
+  ASSERT_EQ(aggs.size(), 1);
+  auto agg = static_cast<BlockingAggIR*>(aggs[0]);
+  ASSERT_EQ(agg->aggregate_expressions().size(), 1);
+  EXPECT_MATCH(agg->aggregate_expressions()[0].node, Func("_native_quantiles"));
+  EXPECT_EQ(graph->FindNodesThatMatch(Func("pluck_float64")).size(), 0);
+  EXPECT_EQ(graph->FindNodesThatMatch(Func("_pluck_quantile")).size(), 3);
+}
+
+constexpr char kQuantilesPluckAndDisplayQuery[] = R"pxl(
+import px
+t1 = px.DataFrame(table='http_events', start_time='-300s')
+t1['service'] = t1.ctx['service']
+t1['latency_ms'] = t1['resp_latency_ns'] / 1.0E6
+df = t1.groupby('service').agg(quantiles=('latency_ms', px.quantiles))
+df['p50'] = px.pluck_float64(df['quantiles'], 'p50')
+df = df[['service', 'quantiles', 'p50']]
+px.display(df)
+)pxl";
+
+// The quantiles are displayed as well as plucked, so they keep their JSON form.
+TEST_F(CompilerTest, DisplayedQuantilesKeepJSON) {
+  auto graph_or_s = compiler_.CompileToIR(kQuantilesPluckAndDisplayQuery, compiler_state_.get());
+  ASSERT_OK(graph_or_s);
+  auto graph = graph_or_s.ConsumeValueOrDie();
+
+  auto aggs = graph->FindNodesThatMatch(BlockingAgg());
+  ASSERT_EQ(aggs.size(), 1);
+  auto agg = static_cast<BlockingAggIR*>(aggs[0]);
+  ASSERT_EQ(agg->aggregate_expressions().size(), 1);
+  EXPECT_MATCH(agg->aggregate_expressions()[0].node, Func("quantiles"));
+  EXPECT_EQ(graph->FindNodesThatMatch(Func("pluck_float64")).size(), 1);
+  EXPECT_EQ(graph->FindNodesThatMatch(Func("_pluck_quantile")).size(), 0);
+}
+
 constexpr char kDropWithoutListQuery[] = R"pxl(
 import px
 t1 = px.DataFrame(table='cpu', select=['cpu0', 'cpu1'])
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/planner/compiler/optimizer/fuse_quantiles_pluck_rule.h"
+#include "src/carnot/planner/ir/column_ir.h"
+#include "src/carnot/planner/ir/map_ir.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+bool FuseQuantilesPluckRule::CollectPlucks(ExpressionIR* expr, const std::string& col_name,
+                                           std::vector<FuncIR*>* plucks) {
+  if (Match(expr, ColumnNode(col_name))) {
+    // The column is used as is.
+    return false;
+  }
+  if (!Match(expr, Func())) {
+    return true;
+  }
+  auto func = static_cast<FuncIR*>(expr);
+  const auto& args = func->all_args();
+  if (func->func_name() == kPluckFn && args.size() == 2 && Match(args[0], ColumnNode(col_name)) &&
+      Match(args[1], String())) {
+    plucks->push_back(func);
+    return true;
+  }
+  for (ExpressionIR* arg : args) {
+    if (!CollectPlucks(arg, col_name, plucks)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FuseQuantilesPluckRule::HasNativeFuncs(FuncIR* quantiles) {
+  // Agents that run an older version might not have the native functions yet.
+  auto registry_info = compiler_state_->registry_info();
+  return registry_info->GetUDADataType(kNativeQuantilesFn, quantiles->registry_arg_types()).ok() &&
+         registry_info->GetUDFDataType(kPluckQuantileFn, {types::STRING, types::STRING}).ok();
+}
+
+Status FuseQuantilesPluckRule::ReplacePluck(FuncIR* pluck) {
+  IR* graph = pluck->graph();
+  // The key is an init argument of _pluck_quantile, so it comes first.
+  PX_ASSIGN_OR_RETURN(
+      FuncIR * native_pluck,
+      graph->CreateNode<FuncIR>(
+          pluck->ast(), FuncIR::Op{FuncIR::Opcode::non_op, "", kPluckQuantileFn},
+          std::vector<ExpressionIR*>{pluck->all_args()[1], pluck->all_args()[0]}));
+  std::vector<int64_t> containers = graph->dag().ParentsOf(pluck->id());
+  for (int64_t container_id : containers) {
+    IRNode* container = graph->Get(container_id);
+    if (Match(container, Func())) {
+      PX_RETURN_IF_ERROR(static_cast<FuncIR*>(container)->UpdateArg(pluck, native_pluck));
+    } else if (Match(container, Map())) {
+      PX_RETURN_IF_ERROR(static_cast<MapIR*>(container)->UpdateColExpr(pluck, native_pluck));
+    } else {
+      return error::Internal("Unexpected container for $0: $1", pluck->DebugString(),
+                             container->DebugString());
+    }
+  }
+  return Status::OK();
+}
+
+StatusOr<bool> FuseQuantilesPluckRule::Apply(IRNode* ir_node) {
+  if (!Match(ir_node, BlockingAgg())) {
+    return false;
+  }
+  auto agg = static_cast<BlockingAggIR*>(ir_node);
+  std::vector<OperatorIR*> children = agg->Children();
+  if (children.empty()) {
+    return false;
+  }
+  for (OperatorIR* child : children) {
+    if (!Match(child, Map())) {
+      return false;
+    }
+  }
+
+  ColExpressionVector new_agg_exprs;
+  std::vector<FuncIR*> plucks;
+  for (const auto& agg_expr : agg->aggregate_expressions()) {
+    new_agg_exprs.push_back(agg_expr);
+    if (!Match(agg_expr.node, Func(kQuantilesFn))) {
+      continue;
+    }
+    auto quantiles = static_cast<FuncIR*>(agg_expr.node);
+
+    std::vector<FuncIR*> col_plucks;
+    bool only_plucked = true;
+    for (OperatorIR* child : children) {
+      for (const auto& col_expr : static_cast<MapIR*>(child)->col_exprs()) {
+        only_plucked = only_plucked && CollectPlucks(col_expr.node, agg_expr.name, &col_plucks);
+      }
+    }
+    if (!only_plucked || col_plucks.empty() || !HasNativeFuncs(quantiles)) {
+      continue;
+    }
+
+    PX_ASSIGN_OR_RETURN(
+        FuncIR * native_quantiles,
+        agg->graph()->CreateNode<FuncIR>(
+            quantiles->ast(), FuncIR::Op{FuncIR::Opcode::non_op, "", kNativeQuantilesFn},
+            quantiles->all_args()));
+    new_agg_exprs.back().node = native_quantiles;
+    plucks.insert(plucks.end(), col_plucks.begin(), col_plucks.end());
+  }
+  if (plucks.empty()) {
+    return false;
+  }
+
+  PX_RETURN_IF_ERROR(agg->SetAggExprs(new_agg_exprs));
+  for (FuncIR* pluck : plucks) {
+    PX_RETURN_IF_ERROR(ReplacePluck(pluck));
+  }
+  PX_RETURN_IF_ERROR(PropagateTypeChangesFromNode(agg->graph(), agg, compiler_state_));
+  return true;
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "src/carnot/planner/compiler_state/compiler_state.h"
+#include "src/carnot/planner/ir/blocking_agg_ir.h"
+#include "src/carnot/planner/ir/func_ir.h"
+#include "src/carnot/planner/rules/rules.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+/**
+ * @brief FuseQuantilesPluckRule replaces px.quantiles with _native_quantiles when all the uses of
+ * its result are px.pluck_float64 calls with a constant key, and those calls with
+ * _pluck_quantile.
+ *
+ * px.quantiles serializes the quantiles of every group as JSON, which px.pluck_float64 parses
+ * again for every plucked key. _native_quantiles packs the quantiles as doubles instead, which
+ * _pluck_quantile reads directly. Both return 0.0 for unknown keys, so the results don't change.
+ * The rule only looks at Maps right after the aggregate, so it must run after unused columns are
+ * pruned, when the quantiles column isn't passed through anymore.
+ */
+class FuseQuantilesPluckRule : public Rule {
+ public:
+  explicit FuseQuantilesPluckRule(CompilerState* compiler_state)
+      : Rule(compiler_state, /*use_topo*/ false, /*reverse_topological_execution*/ false) {}
+
+  inline static constexpr char kQuantilesFn[] = "quantiles";
+  inline static constexpr char kPluckFn[] = "pluck_float64";
+  inline static constexpr char kNativeQuantilesFn[] = "_native_quantiles";
+  inline static constexpr char kPluckQuantileFn[] = "_pluck_quantile";
+
+ protected:
+  StatusOr<bool> Apply(IRNode* ir_node) override;
+
+ private:
+  /**
+   * @brief Collects the px.pluck_float64 calls that read the column in the expression. Returns
+   * false if the column is used in any other way.
+   */
+  static bool CollectPlucks(ExpressionIR* expr, const std::string& col_name,
+                            std::vector<FuncIR*>* plucks);
+
+  bool HasNativeFuncs(FuncIR* quantiles);
+  Status ReplacePluck(FuncIR* pluck);
+};
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/carnot/planner/compiler/analyzer/resolve_types_rule.h"
+#include "src/carnot/planner/compiler/optimizer/fuse_quantiles_pluck_rule.h"
+#include "src/carnot/planner/compiler/test_utils.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+using FuseQuantilesPluckRuleTest = RulesTest;
+
+TEST_F(FuseQuantilesPluckRuleTest, plucked_quantiles) {
+  auto mem_src = MakeMemSource("cpu", cpu_relation);
+  auto agg = MakeBlockingAgg(mem_src, {},
+                             {{"quantiles", MakeFunc("quantiles", {MakeColumn("cpu0", 0)})},
+                              {"mean", MakeMeanFunc(MakeColumn("cpu1", 0))}});
+  auto p50 = MakeFunc("pluck_float64", {MakeColumn("quantiles", 0), MakeString("p50")});
+  auto p99 = MakeFunc("pluck_float64", {MakeColumn("quantiles", 0), MakeString("p99")});
+  auto map = MakeMap(agg, {{"p50", p50},
+                           {"p99_plus_mean", MakeAddFunc(p99, MakeColumn("mean", 0))},
+                           {"mean", MakeColumn("mean", 0)}});
+  MakeMemSink(map, "");
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  FuseQuantilesPluckRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ConsumeValueOrDie());
+
+  ASSERT_EQ(agg->aggregate_expressions().size(), 2);
+  EXPECT_MATCH(agg->aggregate_expressions()[0].node,
+               Func(FuseQuantilesPluckRule::kNativeQuantilesFn));
+  EXPECT_MATCH(agg->aggregate_expressions()[1].node, Func("mean"));
+  EXPECT_EQ(agg->resolved_table_type()->ColumnNames(),
+            std::vector<std::string>({"quantiles", "mean"}));
+
+  ASSERT_EQ(map->col_exprs().size(), 3);
+  auto native_p50 = static_cast<FuncIR*>(map->col_exprs()[0].node);
+  EXPECT_MATCH(native_p50, Func(FuseQuantilesPluckRule::kPluckQuantileFn));
+  // The key is an init argument.
+  ASSERT_EQ(native_p50->init_args().size(), 1);
+  EXPECT_MATCH(native_p50->init_args()[0], String("p50"));
+  ASSERT_EQ(native_p50->args().size(), 1);
+  EXPECT_MATCH(native_p50->args()[0], ColumnNode("quantiles", 0));
+  EXPECT_EQ(native_p50->EvaluatedDataType(), types::FLOAT64);
+
+  auto add = static_cast<FuncIR*>(map->col_exprs()[1].node);
+  EXPECT_MATCH(add->all_args()[0], Func(FuseQuantilesPluckRule::kPluckQuantileFn));
+  EXPECT_MATCH(add->all_args()[1], ColumnNode("mean", 0));
+  EXPECT_EQ(add->EvaluatedDataType(), types::FLOAT64);
+
+  // Running it again doesn't change anything.
+  result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ConsumeValueOrDie());
+}
+
+TEST_F(FuseQuantilesPluckRuleTest, quantiles_used_as_is) {
+  auto mem_src = MakeMemSource("cpu", cpu_relation);
+  auto agg =
+      MakeBlockingAgg(mem_src, {}, {{"quantiles", MakeFunc("quantiles", {MakeColumn("cpu0", 0)})}});
+  auto p50 = MakeFunc("pluck_float64", {MakeColumn("quantiles", 0), MakeString("p50")});
+  auto map = MakeMap(agg, {{"p50", p50}, {"quantiles", MakeColumn("quantiles", 0)}});
+  MakeMemSink(map, "");
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  FuseQuantilesPluckRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ConsumeValueOrDie());
+  EXPECT_MATCH(agg->aggregate_expressions()[0].node, Func("quantiles"));
+  EXPECT_MATCH(map->col_exprs()[0].node, Func("pluck_float64"));
+}
+
+TEST_F(FuseQuantilesPluckRuleTest, quantiles_to_sink) {
+  auto mem_src = MakeMemSource("cpu", cpu_relation);
+  auto agg =
+      MakeBlockingAgg(mem_src, {}, {{"quantiles", MakeFunc("quantiles", {MakeColumn("cpu0", 0)})}});
+  MakeMemSink(agg, "");
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  FuseQuantilesPluckRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ConsumeValueOrDie());
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/planner/compiler/optimizer/fuse_sort_limit_rule.h"
+
+#include <algorithm>
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+StatusOr<bool> FuseSortLimitRule::Apply(IRNode* ir_node) {
+  if (!Match(ir_node, Limit())) {
+    return false;
+  }
+  auto limit = static_cast<LimitIR*>(ir_node);
+  if (limit->pem_only() || !limit->limit_value_set()) {
+    return false;
+  }
+  DCHECK_EQ(1U, limit->parents().size());
+  OperatorIR* parent = limit->parents()[0];
+  if (!Match(parent, Sort()) || parent->Children().size() > 1) {
+    return false;
+  }
+
+  auto sort = static_cast<SortIR*>(parent);
+  int64_t new_limit = limit->limit_value();
+  if (sort->limit() > 0) {
+    new_limit = std::min(new_limit, sort->limit());
+  }
+  sort->SetLimit(new_limit);
+
+  for (OperatorIR* child : limit->Children()) {
+    PX_RETURN_IF_ERROR(child->ReplaceParent(limit, sort));
+  }
+  PX_RETURN_IF_ERROR(limit->graph()->DeleteNode(limit->id()));
+  return true;
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/carnot/planner/compiler/analyzer/resolve_types_rule.h"
+#include "src/carnot/planner/compiler/optimizer/fuse_sort_limit_rule.h"
+#include "src/carnot/planner/compiler/test_utils.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+using ::testing::ElementsAre;
+using FuseSortLimitRuleTest = RulesTest;
+
+TEST_F(FuseSortLimitRuleTest, limit_after_sort) {
+  auto mem_src = MakeMemSource("cpu", cpu_relation);
+  auto sort = MakeSort(mem_src, {MakeColumn("cpu0", 0)}, {false});
+  auto limit1 = MakeLimit(sort, 100);
+  auto limit2 = MakeLimit(limit1, 10);
+  auto sink = MakeMemSink(limit2, "");
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  FuseSortLimitRule rule;
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ConsumeValueOrDie());
+
+  EXPECT_EQ(sort->limit(), 10);
+  EXPECT_FALSE(graph->HasNode(limit1->id()));
+  EXPECT_FALSE(graph->HasNode(limit2->id()));
+  EXPECT_THAT(sink->parents(), ElementsAre(sort));
+
+  // Running it again doesn't change anything.
+  result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ConsumeValueOrDie());
+}
+
+TEST_F(FuseSortLimitRuleTest, sort_with_other_children) {
+  auto mem_src = MakeMemSource("cpu", cpu_relation);
+  auto sort = MakeSort(mem_src, {MakeColumn("cpu0", 0)}, {false});
+  auto limit = MakeLimit(sort, 10);
+  MakeMemSink(limit, "top");
+  MakeMemSink(sort, "all");
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  FuseSortLimitRule rule;
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ConsumeValueOrDie());
+  EXPECT_EQ(sort->limit(), 0);
+  EXPECT_TRUE(graph->HasNode(limit->id()));
+}
+
+TEST_F(FuseSortLimitRuleTest, pem_only_limit) {
+  auto mem_src = MakeMemSource("cpu", cpu_relation);
+  auto sort = MakeSort(mem_src, {MakeColumn("cpu0", 0)}, {false});
+  auto limit = MakeLimit(sort, 10, /* pem_only */ true);
+  MakeMemSink(limit, "");
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  FuseSortLimitRule rule;
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ConsumeValueOrDie());
+  EXPECT_EQ(sort->limit(), 0);
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -23,6 +23,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include "src/carnot/planner/compiler/optimizer/fuse_quantiles_pluck_rule.h"
+#include "src/carnot/planner/compiler/optimizer/fuse_sort_limit_rule.h"
 #include "src/carnot/planner/compiler/optimizer/merge_nodes_rule.h"
 #include "src/carnot/planner/compiler/optimizer/prune_unconnected_operators_rule.h"
 #include "src/carnot/planner/compiler/optimizer/prune_unused_columns_rule.h"
@@ -62,10 +64,22 @@ class Optimizer : public RuleExecutor<IR> {
     prune_unused_columns->AddRule<PruneUnusedColumnsRule>();
   }
 
+  void CreateFuseQuantilesPluckBatch() {
+    RuleBatch* fuse_quantiles_pluck = CreateRuleBatch<FailOnMax>("FuseQuantilesPluck", 2);
+    fuse_quantiles_pluck->AddRule<FuseQuantilesPluckRule>(compiler_state_);
+  }
+
+  void CreateFuseSortLimitBatch() {
+    RuleBatch* fuse_sort_limit = CreateRuleBatch<FailOnMax>("FuseSortLimit", 2);
+    fuse_sort_limit->AddRule<FuseSortLimitRule>();
+  }
+
   Status Init() {
     CreatePruneUnconnectedOpsBatch();
     CreateMergeNodesBatch();
     CreatePruneUnusedColumnsBatch();
+    CreateFuseQuantilesPluckBatch();
+    CreateFuseSortLimitBatch();
     return Status::OK();
   }
 
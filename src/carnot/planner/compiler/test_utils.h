@@ -561,6 +561,13 @@ class OperatorTests : public ::testing::Test {
     return limit;
   }
 
+  SortIR* MakeSort(OperatorIR* parent, const std::vector<ColumnIR*>& sort_cols,
+                   const std::vector<bool>& ascending, int64_t limit = 0) {
+    SortIR* sort = graph->CreateNode<SortIR>(ast, parent, sort_cols, ascending).ConsumeValueOrDie();
+    sort->SetLimit(limit);
+    return sort;
+  }
+
   BlockingAggIR* MakeBlockingAgg(OperatorIR* parent, const std::vector<ColumnIR*>& columns,
                                  const ColExpressionVector& col_agg) {
     BlockingAggIR* agg =
@@ -1418,6 +1425,16 @@ void CompareCloneNode(LimitIR* new_ir, LimitIR* old_ir, const std::string& err_s
   EXPECT_EQ(new_ir->limit_value_set(), old_ir->limit_value_set()) << err_string;
 }
 
+template <>
+void CompareCloneNode(SortIR* new_ir, SortIR* old_ir, const std::string& err_string) {
+  ASSERT_EQ(new_ir->sort_cols().size(), old_ir->sort_cols().size()) << err_string;
+  for (size_t i = 0; i < new_ir->sort_cols().size(); ++i) {
+    CompareClone(new_ir->sort_cols()[i], old_ir->sort_cols()[i], err_string);
+  }
+  EXPECT_EQ(new_ir->ascending(), old_ir->ascending()) << err_string;
+  EXPECT_EQ(new_ir->limit(), old_ir->limit()) << err_string;
+}
+
 template <>
 void CompareCloneNode(FuncIR* new_ir, FuncIR* old_ir, const std::string& err_string) {
   EXPECT_TRUE(new_ir->Equals(old_ir)) << err_string;
@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "src/carnot/planner/distributed/coordinator/coordinator.h"
+#include "src/carnot/planner/distributed/coordinator/partition_kelvins.h"
 #include "src/carnot/planner/distributed/coordinator/plan_clusters.h"
 #include "src/carnot/planner/distributed/coordinator/prune_unavailable_sources_rule.h"
 #include "src/carnot/planner/distributed/coordinator/removable_ops_rule.h"
@@ -105,6 +106,46 @@ const distributedpb::CarnotInfo& CoordinatorImpl::GetRemoteProcessor() const {
   return remote_processor_nodes_[0];
 }
 
+Status CoordinatorImpl::PartitionAcrossKelvins(DistributedPlan* distributed_plan,
+                                               CarnotInstance* kelvin,
+                                               const std::vector<int64_t>& pem_ids,
+                                               const std::vector<IR*>& pem_plans) {
+  int64_t num_kelvins = std::min<int64_t>(distributed_state_->max_shuffle_kelvins(),
+                                          remote_processor_nodes_.size());
+  if (num_kelvins <= 1) {
+    return Status::OK();
+  }
+  PartitionKeyMap partition_keys = KelvinPartitionKeys(kelvin->plan());
+  if (partition_keys.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<IR*> kelvin_plans{kelvin->plan()};
+  for (int64_t i = 1; i < num_kelvins; ++i) {
+    PX_ASSIGN_OR_RETURN(int64_t kelvin_id,
+                        distributed_plan->AddCarnot(remote_processor_nodes_[i]));
+    PX_ASSIGN_OR_RETURN(std::unique_ptr<IR> plan_uptr, kelvin->plan()->Clone());
+    CarnotInstance* shuffle_kelvin = distributed_plan->Get(kelvin_id);
+    shuffle_kelvin->AddPlan(plan_uptr.get());
+    kelvin_plans.push_back(plan_uptr.get());
+    distributed_plan->AddPlan(std::move(plan_uptr));
+    distributed_plan->AddShuffleKelvin(shuffle_kelvin);
+
+    for (int64_t pem_id : pem_ids) {
+      if (distributed_plan->HasNode(pem_id)) {
+        distributed_plan->AddEdge(pem_id, kelvin_id);
+      }
+    }
+    distributed_plan->AddEdge(kelvin_id, kelvin->id());
+  }
+
+  PX_RETURN_IF_ERROR(PartitionKelvinPlans(partition_keys, kelvin_plans));
+  for (IR* pem_plan : pem_plans) {
+    PX_RETURN_IF_ERROR(PartitionPEMSinks(partition_keys, num_kelvins, pem_plan));
+  }
+  return Status::OK();
+}
+
 /**
  * A mapping of agent IDs to the corresponding plan.
  */
@@ -178,15 +219,14 @@ StatusOr<SchemaToAgentsMap> LoadSchemaMap(
 }
 
 StatusOr<std::unique_ptr<DistributedPlan>> CoordinatorImpl::CoordinateImpl(const IR* logical_plan) {
-  // TODO(zasgar) set support_partial_agg to true to enable partial aggs.
   PX_ASSIGN_OR_RETURN(std::unique_ptr<Splitter> splitter,
-                      Splitter::Create(compiler_state_, /* support_partial_agg */ false));
+                      Splitter::Create(compiler_state_, /* support_partial_agg */ true));
   PX_ASSIGN_OR_RETURN(std::unique_ptr<BlockingSplitPlan> split_plan,
                       splitter->SplitKelvinAndAgents(logical_plan));
   auto distributed_plan = std::make_unique<DistributedPlan>();
   PX_ASSIGN_OR_RETURN(int64_t remote_node_id, distributed_plan->AddCarnot(GetRemoteProcessor()));
   // TODO(philkuz) Need to update the Blocking Split Plan to better represent what we expect.
-  // TODO(philkuz) (PL-1469) Future support for grabbing data from multiple Kelvin nodes.
+  // More Kelvins are added by PartitionAcrossKelvins() when the plan can be hash partitioned.
 
   PX_ASSIGN_OR_RETURN(std::unique_ptr<IR> remote_plan_uptr, split_plan->original_plan->Clone());
   CarnotInstance* remote_carnot = distributed_plan->Get(remote_node_id);
@@ -227,6 +267,12 @@ StatusOr<std::unique_ptr<DistributedPlan>> CoordinatorImpl::CoordinateImpl(const
   PX_RETURN_IF_ERROR(prune_sources_rule.Apply(remote_carnot));
 
   distributed_plan->SetKelvin(remote_carnot);
+  std::vector<IR*> pem_plans;
+  for (const auto& [pem_plan, agents] : agent_to_plan_map.plan_to_agents) {
+    pem_plans.push_back(pem_plan);
+  }
+  PX_RETURN_IF_ERROR(PartitionAcrossKelvins(distributed_plan.get(), remote_carnot, source_node_ids,
+                                            pem_plans));
   distributed_plan->AddPlanToAgentMap(std::move(agent_to_plan_map.plan_to_agents));
 
   return distributed_plan;
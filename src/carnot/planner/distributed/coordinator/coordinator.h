@@ -93,6 +93,11 @@ class CoordinatorImpl : public Coordinator {
  private:
   const distributedpb::CarnotInfo& GetRemoteProcessor() const;
   bool HasExecutableNodes(const IR* plan);
+  // Hash partitions the operators that read the PEM results across several Kelvins when the
+  // distributed state allows it and the Kelvin plan supports it.
+  Status PartitionAcrossKelvins(DistributedPlan* distributed_plan, CarnotInstance* kelvin,
+                                const std::vector<int64_t>& pem_ids,
+                                const std::vector<IR*>& pem_plans);
 
   // Nodes that have a source of data.
   std::vector<CarnotInfo> data_store_nodes_;
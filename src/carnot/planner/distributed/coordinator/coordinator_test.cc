@@ -169,6 +169,158 @@ TEST_F(CoordinatorTest, one_pem_three_kelvin) {
   }
 }
 
+TEST_F(CoordinatorTest, split_agg_across_pem_and_kelvin) {
+  auto ps = LoadDistributedStatePb(kOnePEMOneKelvinDistributedState);
+  auto coordinator = Coordinator::Create(compiler_state_.get(), ps).ConsumeValueOrDie();
+
+  auto mem_src = MakeMemSource(MakeRelation());
+  compiler_state_->relation_map()->emplace("table", MakeRelation());
+  auto agg = MakeBlockingAgg(mem_src, {MakeColumn("count", 0)},
+                             {{"mean", MakeMeanFunc(MakeColumn("cpu0", 0))}});
+  MakeMemSink(agg, "out");
+  ResolveTypesRule rule(compiler_state_.get());
+  ASSERT_OK(rule.Execute(graph.get()));
+
+  auto physical_plan = coordinator->Coordinate(graph.get()).ConsumeValueOrDie();
+  ASSERT_EQ(physical_plan->dag().nodes().size(), 2UL);
+
+  // Mean supports partial aggregation, so the PEM aggregates its rows and only sends the
+  // serialized partial aggregate of each group to the Kelvin.
+  auto pem_plan = physical_plan->Get(1)->plan();
+  auto pem_sinks = pem_plan->FindNodesThatMatch(InternalGRPCSink());
+  ASSERT_EQ(pem_sinks.size(), 1);
+  auto pem_sink = static_cast<GRPCSinkIR*>(pem_sinks[0]);
+  ASSERT_EQ(pem_sink->parents().size(), 1);
+  ASSERT_MATCH(pem_sink->parents()[0], PartialAgg());
+  auto partial_agg = static_cast<BlockingAggIR*>(pem_sink->parents()[0]);
+  EXPECT_MATCH(partial_agg->parents()[0], MemorySource());
+  EXPECT_THAT(partial_agg->resolved_table_type()->ColumnNames(),
+              ElementsAre("count", "serialized_expressions"));
+
+  // The Kelvin merges the partial aggregates and finalizes them.
+  auto kelvin_plan = physical_plan->Get(0)->plan();
+  auto kelvin_sinks = kelvin_plan->FindNodesThatMatch(MemorySink());
+  ASSERT_EQ(kelvin_sinks.size(), 1);
+  auto kelvin_sink = static_cast<OperatorIR*>(kelvin_sinks[0]);
+  ASSERT_MATCH(kelvin_sink->parents()[0], FinalizeAgg());
+  auto finalize_agg = static_cast<BlockingAggIR*>(kelvin_sink->parents()[0]);
+  EXPECT_MATCH(finalize_agg->parents()[0], GRPCSourceGroup());
+  EXPECT_THAT(finalize_agg->resolved_table_type()->ColumnNames(), ElementsAre("count", "mean"));
+
+  planpb::Operator finalize_pb;
+  ASSERT_OK(finalize_agg->ToProto(&finalize_pb));
+  EXPECT_TRUE(finalize_pb.agg_op().finalize_results());
+  EXPECT_FALSE(finalize_pb.agg_op().partial_agg());
+  ASSERT_EQ(finalize_pb.agg_op().values_size(), 1);
+  EXPECT_EQ(finalize_pb.agg_op().values(0).name(), "mean");
+}
+
+TEST_F(CoordinatorTest, partition_agg_across_kelvins) {
+  auto ps = LoadDistributedStatePb(kOnePEMThreeKelvinsDistributedState);
+  ps.set_max_shuffle_kelvins(2);
+  auto coordinator = Coordinator::Create(compiler_state_.get(), ps).ConsumeValueOrDie();
+
+  auto mem_src = MakeMemSource(MakeRelation());
+  compiler_state_->relation_map()->emplace("table", MakeRelation());
+  auto agg = MakeBlockingAgg(mem_src, {MakeColumn("count", 0)},
+                             {{"mean", MakeMeanFunc(MakeColumn("cpu0", 0))}});
+  MakeMemSink(agg, "out");
+  ResolveTypesRule rule(compiler_state_.get());
+  ASSERT_OK(rule.Execute(graph.get()));
+
+  auto physical_plan = coordinator->Coordinate(graph.get()).ConsumeValueOrDie();
+  ASSERT_EQ(physical_plan->dag().nodes().size(), 3UL);
+  ASSERT_EQ(physical_plan->shuffle_kelvins().size(), 1UL);
+  auto shuffle_kelvin = physical_plan->shuffle_kelvins()[0];
+  EXPECT_THAT(shuffle_kelvin->carnot_info().query_broker_address(), ContainsRegex("kelvin2"));
+  // The PEM sends to both Kelvins and the shuffle Kelvin sends to the gathering Kelvin.
+  EXPECT_THAT(physical_plan->dag().ParentsOf(0), UnorderedElementsAre(1, shuffle_kelvin->id()));
+  EXPECT_THAT(physical_plan->dag().ParentsOf(shuffle_kelvin->id()), ElementsAre(1));
+
+  auto pem_plan = physical_plan->Get(1)->plan();
+  auto pem_sinks = pem_plan->FindNodesThatMatch(InternalGRPCSink());
+  ASSERT_EQ(pem_sinks.size(), 1);
+  auto pem_sink = static_cast<GRPCSinkIR*>(pem_sinks[0]);
+  EXPECT_TRUE(pem_sink->is_partitioned());
+  EXPECT_EQ(pem_sink->num_partitions(), 2);
+  EXPECT_THAT(pem_sink->partition_key_columns(), ElementsAre("count"));
+  // Each Kelvin finalizes the partial aggregates of its partition of the groups.
+  EXPECT_MATCH(pem_sink->parents()[0], PartialAgg());
+
+  // The gathering Kelvin unions its partition of the aggregate with the other Kelvin's.
+  auto gather_plan = physical_plan->Get(0)->plan();
+  auto unions = gather_plan->FindNodesOfType(IRNodeType::kUnion);
+  ASSERT_EQ(unions.size(), 1);
+  auto gather_union = static_cast<UnionIR*>(unions[0]);
+  ASSERT_EQ(gather_union->parents().size(), 2);
+  EXPECT_MATCH(gather_union->parents()[0], BlockingAgg());
+  EXPECT_MATCH(gather_union->parents()[1], GRPCSourceGroup());
+  ASSERT_EQ(gather_union->Children().size(), 1);
+  EXPECT_MATCH(gather_union->Children()[0], MemorySink());
+  auto gather_group = static_cast<GRPCSourceGroupIR*>(gather_union->parents()[1]);
+
+  // The shuffle Kelvin aggregates its partition and sends it to the gathering Kelvin.
+  auto shuffle_plan = shuffle_kelvin->plan();
+  EXPECT_EQ(shuffle_plan->FindNodesThatMatch(MemorySink()).size(), 0);
+  auto shuffle_sinks = shuffle_plan->FindNodesThatMatch(InternalGRPCSink());
+  ASSERT_EQ(shuffle_sinks.size(), 1);
+  auto shuffle_sink = static_cast<GRPCSinkIR*>(shuffle_sinks[0]);
+  EXPECT_FALSE(shuffle_sink->is_partitioned());
+  EXPECT_EQ(shuffle_sink->destination_id(), gather_group->source_id());
+  ASSERT_EQ(shuffle_sink->parents().size(), 1);
+  EXPECT_MATCH(shuffle_sink->parents()[0], BlockingAgg());
+
+  auto gather_groups = gather_plan->FindNodesOfType(IRNodeType::kGRPCSourceGroup);
+  auto shuffle_groups = shuffle_plan->FindNodesOfType(IRNodeType::kGRPCSourceGroup);
+  ASSERT_EQ(gather_groups.size(), 2);
+  ASSERT_EQ(shuffle_groups.size(), 1);
+  EXPECT_EQ(static_cast<GRPCSourceGroupIR*>(shuffle_groups[0])->partition(), 1);
+  for (IRNode* node : gather_groups) {
+    auto group = static_cast<GRPCSourceGroupIR*>(node);
+    EXPECT_EQ(group->partition(), group == gather_group ? -1 : 0);
+  }
+}
+
+TEST_F(CoordinatorTest, no_partition_self_join_on_different_columns) {
+  auto ps = LoadDistributedStatePb(kOnePEMThreeKelvinsDistributedState);
+  ps.set_max_shuffle_kelvins(2);
+  auto coordinator = Coordinator::Create(compiler_state_.get(), ps).ConsumeValueOrDie();
+
+  auto mem_src = MakeMemSource(MakeRelation());
+  compiler_state_->relation_map()->emplace("table", MakeRelation());
+  auto join = graph
+                  ->CreateNode<JoinIR>(ast, std::vector<OperatorIR*>{mem_src, mem_src}, "inner",
+                                       std::vector<ColumnIR*>{MakeColumn("cpu0", 0)},
+                                       std::vector<ColumnIR*>{MakeColumn("cpu1", 1)},
+                                       std::vector<std::string>{"_x", "_y"})
+                  .ConsumeValueOrDie();
+  MakeMemSink(join, "out");
+  ResolveTypesRule rule(compiler_state_.get());
+  ASSERT_OK(rule.Execute(graph.get()));
+
+  // Both sides of the join come from the same source group, which can't be partitioned on cpu0
+  // and on cpu1 at once, so the join runs on a single Kelvin.
+  auto physical_plan = coordinator->Coordinate(graph.get()).ConsumeValueOrDie();
+  ASSERT_EQ(physical_plan->dag().nodes().size(), 2UL);
+  EXPECT_EQ(physical_plan->shuffle_kelvins().size(), 0UL);
+  auto pem_plan = physical_plan->Get(1)->plan();
+  for (IRNode* node : pem_plan->FindNodesThatMatch(InternalGRPCSink())) {
+    EXPECT_FALSE(static_cast<GRPCSinkIR*>(node)->is_partitioned());
+  }
+}
+
+TEST_F(CoordinatorTest, no_partition_without_keys) {
+  auto ps = LoadDistributedStatePb(kOnePEMThreeKelvinsDistributedState);
+  ps.set_max_shuffle_kelvins(3);
+  auto coordinator = Coordinator::Create(compiler_state_.get(), ps).ConsumeValueOrDie();
+
+  MakeGraph();
+  auto physical_plan = coordinator->Coordinate(graph.get()).ConsumeValueOrDie();
+  ASSERT_EQ(physical_plan->dag().nodes().size(), 2UL);
+  EXPECT_EQ(physical_plan->shuffle_kelvins().size(), 0UL);
+  VerifyKelvinMergerPlan(physical_plan->Get(0)->plan());
+}
+
 constexpr char kBadAgentSpecificationState[] = R"proto(
 carnot_info {
   query_broker_address: "pem"
@@ -0,0 +1,201 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/planner/distributed/coordinator/partition_kelvins.h"
+
+#include <algorithm>
+#include <set>
+
+#include "src/carnot/planner/ir/blocking_agg_ir.h"
+#include "src/carnot/planner/ir/grpc_sink_ir.h"
+#include "src/carnot/planner/ir/grpc_source_group_ir.h"
+#include "src/carnot/planner/ir/join_ir.h"
+#include "src/carnot/planner/ir/pattern_match.h"
+#include "src/carnot/planner/ir/union_ir.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+namespace {
+
+std::vector<std::string> ColumnNames(const std::vector<ColumnIR*>& columns) {
+  std::vector<std::string> names;
+  for (ColumnIR* col : columns) {
+    names.push_back(col->col_name());
+  }
+  return names;
+}
+
+// Returns the join keys of the parent of the join.
+std::vector<std::string> JoinKeys(JoinIR* join, OperatorIR* parent) {
+  // When both sides of the join read from the same group, its rows can only be partitioned on
+  // keys that are the same for both sides.
+  if (join->parents()[0] == join->parents()[1]) {
+    std::vector<std::string> left_keys = ColumnNames(join->left_on_columns());
+    if (left_keys != ColumnNames(join->right_on_columns())) {
+      return {};
+    }
+    return left_keys;
+  }
+  std::vector<std::string> keys;
+  for (const auto& on_columns : {join->left_on_columns(), join->right_on_columns()}) {
+    for (ColumnIR* col : on_columns) {
+      if (join->parents()[col->container_op_parent_idx()] == parent) {
+        keys.push_back(col->col_name());
+      }
+    }
+  }
+  return keys;
+}
+
+std::vector<GRPCSourceGroupIR*> SourceGroups(IR* plan) {
+  std::vector<GRPCSourceGroupIR*> groups;
+  for (IRNode* node : plan->FindNodesThatMatch(GRPCSourceGroup())) {
+    groups.push_back(static_cast<GRPCSourceGroupIR*>(node));
+  }
+  return groups;
+}
+
+}  // namespace
+
+PartitionKeyMap KelvinPartitionKeys(IR* kelvin_plan) {
+  PartitionKeyMap partition_keys;
+  for (IRNode* node : kelvin_plan->FindNodesThatMatch(Operator())) {
+    auto op = static_cast<OperatorIR*>(node);
+    // Bridges within the Kelvin plan would have to be partitioned too.
+    if (Match(op, InternalGRPCSink())) {
+      return {};
+    }
+    if (!op->IsSource()) {
+      continue;
+    }
+    // Sources on the Kelvin, such as UDTFs, produce all of their rows on a single Kelvin.
+    if (!Match(op, GRPCSourceGroup())) {
+      return {};
+    }
+    auto group = static_cast<GRPCSourceGroupIR*>(op);
+    std::vector<OperatorIR*> children = group->Children();
+    if (children.size() != 1) {
+      return {};
+    }
+    std::vector<std::string> keys;
+    if (Match(children[0], BlockingAgg())) {
+      keys = ColumnNames(static_cast<BlockingAggIR*>(children[0])->groups());
+    } else if (Match(children[0], Join())) {
+      auto join = static_cast<JoinIR*>(children[0]);
+      for (OperatorIR* parent : join->parents()) {
+        if (!Match(parent, GRPCSourceGroup())) {
+          return {};
+        }
+      }
+      keys = JoinKeys(join, group);
+    }
+    if (keys.empty()) {
+      return {};
+    }
+    partition_keys[group->source_id()] = keys;
+  }
+  return partition_keys;
+}
+
+Status PartitionKelvinPlans(const PartitionKeyMap& partition_keys,
+                            const std::vector<IR*>& kelvin_plans) {
+  DCHECK(!kelvin_plans.empty());
+  IR* gather_plan = kelvin_plans[0];
+
+  // The plans are clones, so the operators that read from the groups have the same ids in all of
+  // them.
+  std::set<int64_t> partitioned_op_ids;
+  int64_t next_source_id = 0;
+  for (GRPCSourceGroupIR* group : SourceGroups(gather_plan)) {
+    if (!partition_keys.contains(group->source_id())) {
+      return group->CreateIRNodeError("$0 has no partition keys", group->DebugString());
+    }
+    partitioned_op_ids.insert(group->Children()[0]->id());
+    next_source_id = std::max(next_source_id, group->source_id() + 1);
+  }
+  for (const auto& [i, plan] : Enumerate(kelvin_plans)) {
+    for (GRPCSourceGroupIR* group : SourceGroups(plan)) {
+      group->SetPartition(i);
+    }
+  }
+
+  // The gathering Kelvin unions the results of its own partition with those of the other Kelvins.
+  absl::flat_hash_map<int64_t, int64_t> op_id_to_gather_source_id;
+  for (int64_t op_id : partitioned_op_ids) {
+    auto op = static_cast<OperatorIR*>(gather_plan->Get(op_id));
+    std::vector<OperatorIR*> children = op->Children();
+    int64_t source_id = next_source_id++;
+    PX_ASSIGN_OR_RETURN(
+        GRPCSourceGroupIR * gather_group,
+        gather_plan->CreateNode<GRPCSourceGroupIR>(op->ast(), source_id, op->resolved_type()));
+    std::vector<OperatorIR*> union_parents{op, gather_group};
+    PX_ASSIGN_OR_RETURN(UnionIR * union_op,
+                        gather_plan->CreateNode<UnionIR>(op->ast(), union_parents));
+    PX_RETURN_IF_ERROR(union_op->SetResolvedType(op->resolved_type()));
+    PX_RETURN_IF_ERROR(union_op->SetDefaultColumnMapping());
+    for (OperatorIR* child : children) {
+      PX_RETURN_IF_ERROR(child->ReplaceParent(op, union_op));
+    }
+    op_id_to_gather_source_id[op_id] = source_id;
+  }
+
+  // The other Kelvins only run the partitioned operators and send their results to the gathering
+  // Kelvin.
+  for (size_t i = 1; i < kelvin_plans.size(); ++i) {
+    IR* plan = kelvin_plans[i];
+    for (int64_t op_id : partitioned_op_ids) {
+      auto op = static_cast<OperatorIR*>(plan->Get(op_id));
+      std::vector<int64_t> child_ids;
+      for (OperatorIR* child : op->Children()) {
+        child_ids.push_back(child->id());
+      }
+      // A child may be shared with another partitioned operator, such as a Join of two aggregates.
+      for (int64_t child_id : child_ids) {
+        if (plan->HasNode(child_id)) {
+          PX_RETURN_IF_ERROR(plan->DeleteSubtree(child_id));
+        }
+      }
+      PX_ASSIGN_OR_RETURN(
+          GRPCSinkIR * sink,
+          plan->CreateNode<GRPCSinkIR>(op->ast(), op, op_id_to_gather_source_id[op_id]));
+      PX_RETURN_IF_ERROR(sink->SetResolvedType(op->resolved_type()));
+    }
+  }
+  return Status::OK();
+}
+
+Status PartitionPEMSinks(const PartitionKeyMap& partition_keys, int64_t num_partitions,
+                         IR* pem_plan) {
+  for (IRNode* node : pem_plan->FindNodesThatMatch(InternalGRPCSink())) {
+    auto sink = static_cast<GRPCSinkIR*>(node);
+    auto keys_it = partition_keys.find(sink->destination_id());
+    if (keys_it == partition_keys.end()) {
+      continue;
+    }
+    sink->SetPartitionKeyColumns(keys_it->second, num_partitions);
+  }
+  return Status::OK();
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "src/carnot/planner/ir/ir.h"
+#include "src/common/base/base.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+// The key columns to hash partition the rows sent to each GRPCSourceGroup on, by source id.
+using PartitionKeyMap = absl::flat_hash_map<int64_t, std::vector<std::string>>;
+
+/**
+ * @brief Returns the columns that the rows sent to each GRPCSourceGroup of the Kelvin plan can be
+ * hash partitioned on, so that the operators reading from the groups run on several Kelvins.
+ *
+ * This is the case when every group feeds a single grouped BlockingAgg or a single side of a Join
+ * and the Kelvin plan reads nothing else: the partition keys are the groups of the aggregate or the
+ * join keys of that side. Returns an empty map when the plan can't be partitioned.
+ */
+PartitionKeyMap KelvinPartitionKeys(IR* kelvin_plan);
+
+/**
+ * @brief Splits the post-PEM plan across the Kelvin plans, which all start as clones of the same
+ * plan. Every Kelvin runs the operators that read from the GRPCSourceGroups on its partition of the
+ * rows and sends their results to the first Kelvin, which unions them and runs the rest of the
+ * plan.
+ *
+ * @param partition_keys the result of KelvinPartitionKeys() on the plan.
+ * @param kelvin_plans the plans of each Kelvin, the first one gathers the results.
+ */
+Status PartitionKelvinPlans(const PartitionKeyMap& partition_keys,
+                            const std::vector<IR*>& kelvin_plans);
+
+/**
+ * @brief Hash partitions the GRPCSinks of the PEM plan that send to the partitioned
+ * GRPCSourceGroups.
+ */
+Status PartitionPEMSinks(const PartitionKeyMap& partition_keys, int64_t num_partitions,
+                         IR* pem_plan);
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -22,6 +22,8 @@
 #include <utility>
 #include <vector>
 
+#include <absl/container/flat_hash_set.h>
+
 namespace px {
 namespace carnot {
 namespace planner {
@@ -44,6 +46,37 @@ StatusOr<OperatorIR*> LimitOperatorMgr::CreateMergeOperator(IR* plan, OperatorIR
   return new_limit;
 }
 
+StatusOr<OperatorIR*> SortOperatorMgr::CreatePrepareOperator(IR* plan, OperatorIR* op) const {
+  DCHECK(Matches(op));
+  SortIR* sort = static_cast<SortIR*>(op);
+  PX_ASSIGN_OR_RETURN(SortIR * new_sort, plan->CopyNode(sort));
+  PX_RETURN_IF_ERROR(new_sort->CopyParentsFrom(sort));
+
+  // The merging sort has to order by the same columns, so they are sent along with the output
+  // columns even if the sort doesn't output them.
+  absl::flat_hash_set<std::string> sort_col_names;
+  for (ColumnIR* col : sort->sort_cols()) {
+    sort_col_names.insert(col->col_name());
+  }
+  auto new_type = TableType::Create();
+  for (const auto& [col_name, col_type] : *sort->parents()[0]->resolved_table_type()) {
+    if (sort->resolved_table_type()->HasColumn(col_name) || sort_col_names.contains(col_name)) {
+      new_type->AddColumn(col_name, col_type->Copy());
+    }
+  }
+  PX_RETURN_IF_ERROR(new_sort->SetResolvedType(new_type));
+  return new_sort;
+}
+
+StatusOr<OperatorIR*> SortOperatorMgr::CreateMergeOperator(IR* plan, OperatorIR* new_parent,
+                                                           OperatorIR* op) const {
+  DCHECK(Matches(op));
+  SortIR* sort = static_cast<SortIR*>(op);
+  PX_ASSIGN_OR_RETURN(SortIR * new_sort, plan->CopyNode(sort));
+  PX_RETURN_IF_ERROR(new_sort->AddParent(new_parent));
+  return new_sort;
+}
+
 StatusOr<OperatorIR*> AggOperatorMgr::CreatePrepareOperator(IR* plan, OperatorIR* op) const {
   DCHECK(Matches(op));
   BlockingAggIR* agg = static_cast<BlockingAggIR*>(op);
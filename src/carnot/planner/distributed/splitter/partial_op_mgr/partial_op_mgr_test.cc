@@ -68,6 +68,44 @@ TEST_F(PartialOpMgrTest, limit_test) {
   EXPECT_NE(merge_limit, limit);
 }
 
+TEST_F(PartialOpMgrTest, sort_test) {
+  auto mem_src = MakeMemSource("source", MakeRelation());
+  compiler_state_->relation_map()->emplace("source", MakeRelation());
+  auto sort = MakeSort(mem_src, {MakeColumn("cpu0", 0)}, {false}, 10);
+  MakeMemSink(sort, "out");
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+  // Only output one column, so that the prepare sort has to keep the sort column around.
+  ASSERT_OK(sort->PruneOutputColumnsTo({"count"}));
+
+  SortOperatorMgr mgr;
+  EXPECT_TRUE(mgr.Matches(sort));
+  auto prepare_sort_or_s = mgr.CreatePrepareOperator(graph.get(), sort);
+  ASSERT_OK(prepare_sort_or_s);
+  OperatorIR* prepare_sort_uncasted = prepare_sort_or_s.ConsumeValueOrDie();
+  ASSERT_MATCH(prepare_sort_uncasted, Sort());
+  SortIR* prepare_sort = static_cast<SortIR*>(prepare_sort_uncasted);
+  EXPECT_EQ(prepare_sort->limit(), 10);
+  EXPECT_EQ(prepare_sort->parents(), sort->parents());
+  EXPECT_NE(prepare_sort, sort);
+  EXPECT_THAT(prepare_sort->resolved_table_type()->ColumnNames(), ElementsAre("count", "cpu0"));
+
+  auto mem_src2 = MakeMemSource(MakeRelation());
+  auto merge_sort_or_s = mgr.CreateMergeOperator(graph.get(), mem_src2, sort);
+  ASSERT_OK(merge_sort_or_s);
+  OperatorIR* merge_sort_uncasted = merge_sort_or_s.ConsumeValueOrDie();
+  ASSERT_MATCH(merge_sort_uncasted, Sort());
+  SortIR* merge_sort = static_cast<SortIR*>(merge_sort_uncasted);
+  EXPECT_EQ(merge_sort->limit(), 10);
+  EXPECT_EQ(merge_sort->parents()[0], mem_src2);
+  EXPECT_THAT(merge_sort->resolved_table_type()->ColumnNames(), ElementsAre("count"));
+
+  // Sorts without a limit need all of the rows, so they aren't split.
+  auto full_sort = MakeSort(mem_src, {MakeColumn("cpu0", 0)}, {true});
+  EXPECT_FALSE(mgr.Matches(full_sort));
+}
+
 TEST_F(PartialOpMgrTest, agg_test) {
   auto relation = MakeRelation();
   relation.AddColumn(types::STRING, "service");
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/predicate_push_down_rule.h"
+#include "src/carnot/planner/ir/ir.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+namespace {
+
+// Maps a comparison opcode to the predicate op. If swap is set the literal is on the left hand
+// side, so the comparison is mirrored.
+std::optional<planpb::ColumnPredicate::Op> PredicateOp(FuncIR::Opcode opcode, bool swap) {
+  switch (opcode) {
+    case FuncIR::Opcode::eq:
+      return planpb::ColumnPredicate::EQUAL;
+    case FuncIR::Opcode::neq:
+      return planpb::ColumnPredicate::NOT_EQUAL;
+    case FuncIR::Opcode::lt:
+      return swap ? planpb::ColumnPredicate::GREATER_THAN : planpb::ColumnPredicate::LESS_THAN;
+    case FuncIR::Opcode::lteq:
+      return swap ? planpb::ColumnPredicate::GREATER_THAN_EQUAL
+                  : planpb::ColumnPredicate::LESS_THAN_EQUAL;
+    case FuncIR::Opcode::gt:
+      return swap ? planpb::ColumnPredicate::LESS_THAN : planpb::ColumnPredicate::GREATER_THAN;
+    case FuncIR::Opcode::gteq:
+      return swap ? planpb::ColumnPredicate::LESS_THAN_EQUAL
+                  : planpb::ColumnPredicate::GREATER_THAN_EQUAL;
+    default:
+      return std::nullopt;
+  }
+}
+
+// Returns whether a literal of literal_type can be compared against the zone map of a column of
+// col_type. Int literals are converted to floats when compared against FLOAT64 columns.
+bool IsComparable(types::DataType col_type, types::DataType literal_type) {
+  switch (col_type) {
+    case types::INT64:
+    case types::TIME64NS:
+      return literal_type == types::INT64 || literal_type == types::TIME64NS;
+    case types::FLOAT64:
+      return literal_type == types::FLOAT64 || literal_type == types::INT64;
+    case types::STRING:
+    case types::BOOLEAN:
+      return literal_type == col_type;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+Status PredicatePushdownRule::MaybeAddComparison(FuncIR* func, MemorySourceIR* src,
+                                                 std::vector<planpb::ColumnPredicate>* predicates) {
+  if (func->all_args().size() != 2) {
+    return Status::OK();
+  }
+  ExpressionIR* lhs = func->all_args()[0];
+  ExpressionIR* rhs = func->all_args()[1];
+  bool swap = false;
+  if (Match(lhs, DataNode()) && Match(rhs, ColumnNode())) {
+    std::swap(lhs, rhs);
+    swap = true;
+  }
+  if (!Match(lhs, ColumnNode()) || !Match(rhs, DataNode())) {
+    return Status::OK();
+  }
+  auto op = PredicateOp(func->opcode(), swap);
+  if (!op.has_value()) {
+    return Status::OK();
+  }
+
+  auto column = static_cast<ColumnIR*>(lhs);
+  auto literal = static_cast<DataIR*>(rhs);
+  auto table_type = src->resolved_table_type();
+  if (!table_type->HasColumn(column->col_name())) {
+    return Status::OK();
+  }
+  PX_ASSIGN_OR_RETURN(auto col_type, table_type->GetColumnType(column->col_name()));
+  auto col_data_type = std::static_pointer_cast<ValueType>(col_type)->data_type();
+  if (!IsComparable(col_data_type, literal->EvaluatedDataType())) {
+    return Status::OK();
+  }
+
+  planpb::ColumnPredicate predicate;
+  const auto& col_names = table_type->ColumnNames();
+  auto col_it = std::find(col_names.begin(), col_names.end(), column->col_name());
+  DCHECK(col_it != col_names.end());
+  predicate.set_column_idx(src->column_index_map()[std::distance(col_names.begin(), col_it)]);
+  predicate.set_op(op.value());
+  if (col_data_type == types::FLOAT64 && Match(literal, Int())) {
+    predicate.mutable_value()->set_data_type(types::FLOAT64);
+    predicate.mutable_value()->set_float64_value(static_cast<IntIR*>(literal)->val());
+  } else {
+    PX_RETURN_IF_ERROR(literal->ToProto(predicate.mutable_value()));
+  }
+  predicates->push_back(std::move(predicate));
+  return Status::OK();
+}
+
+Status PredicatePushdownRule::CollectPredicates(ExpressionIR* expr, MemorySourceIR* src,
+                                                std::vector<planpb::ColumnPredicate>* predicates) {
+  if (!Match(expr, Func())) {
+    return Status::OK();
+  }
+  auto func = static_cast<FuncIR*>(expr);
+  if (func->opcode() == FuncIR::Opcode::logand) {
+    for (ExpressionIR* arg : func->all_args()) {
+      PX_RETURN_IF_ERROR(CollectPredicates(arg, src, predicates));
+    }
+    return Status::OK();
+  }
+  return MaybeAddComparison(func, src, predicates);
+}
+
+StatusOr<bool> PredicatePushdownRule::Apply(IRNode* ir_node) {
+  if (!Match(ir_node, Filter())) {
+    return false;
+  }
+  auto filter = static_cast<FilterIR*>(ir_node);
+  if (filter->parents().size() != 1 || !Match(filter->parents()[0], MemorySource())) {
+    return false;
+  }
+  auto src = static_cast<MemorySourceIR*>(filter->parents()[0]);
+  // The predicates apply to everything that reads from the source, so they can only come from a
+  // filter that is its sole child. A source that already has predicates has been handled.
+  if (src->Children().size() != 1 || !src->predicates().empty()) {
+    return false;
+  }
+  if (!src->is_type_resolved() || !src->column_index_map_set()) {
+    return false;
+  }
+
+  std::vector<planpb::ColumnPredicate> predicates;
+  PX_RETURN_IF_ERROR(CollectPredicates(filter->filter_expr(), src, &predicates));
+  for (const auto& predicate : predicates) {
+    src->AddPredicate(predicate);
+  }
+  return !predicates.empty();
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "src/carnot/planner/ir/filter_ir.h"
+#include "src/carnot/planner/ir/memory_source_ir.h"
+#include "src/carnot/planner/rules/rules.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+/**
+ * @brief This rule copies the comparisons between a column and a literal out of a filter that
+ * directly follows a MemorySource into the MemorySource's predicates, so that the table scan can
+ * skip the batches that can't pass the filter. The filter is left in place.
+ *
+ * It must run after FilterPushdownRule so that filters have already been moved next to their
+ * sources.
+ */
+class PredicatePushdownRule : public Rule {
+ public:
+  explicit PredicatePushdownRule(CompilerState* compiler_state)
+      : Rule(compiler_state, /*use_topo*/ false, /*reverse_topological_execution*/ false) {}
+
+ protected:
+  StatusOr<bool> Apply(IRNode*) override;
+
+ private:
+  // Adds the predicates for the conjuncts of expr that can be checked by the table scan.
+  Status CollectPredicates(ExpressionIR* expr, MemorySourceIR* src,
+                           std::vector<planpb::ColumnPredicate>* predicates);
+  Status MaybeAddComparison(FuncIR* func, MemorySourceIR* src,
+                            std::vector<planpb::ColumnPredicate>* predicates);
+};
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
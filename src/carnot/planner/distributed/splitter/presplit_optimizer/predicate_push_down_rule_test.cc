@@ -0,0 +1,132 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "src/carnot/planner/compiler/analyzer/resolve_types_rule.h"
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/predicate_push_down_rule.h"
+#include "src/carnot/planner/test_utils.h"
+#include "src/common/testing/protobuf.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+using compiler::ResolveTypesRule;
+using ::testing::ElementsAre;
+
+class PredicatePushDownTest : public testutils::DistributedRulesTest {
+ protected:
+  FuncIR* MakeCompareFunc(const std::string& op, ExpressionIR* left, ExpressionIR* right) {
+    return graph
+        ->CreateNode<FuncIR>(ast, FuncIR::op_map.find(op)->second,
+                             std::vector<ExpressionIR*>({left, right}))
+        .ConsumeValueOrDie();
+  }
+};
+
+TEST_F(PredicatePushDownTest, column_literal_comparisons) {
+  Relation relation({types::DataType::TIME64NS, types::DataType::STRING, types::DataType::FLOAT64},
+                    {"time_", "service", "latency"});
+  MemorySourceIR* src = MakeMemSource("source", relation, {"service", "latency"});
+  compiler_state_->relation_map()->emplace("source", relation);
+
+  // latency > 2 and "svc" == service and latency < latency
+  auto filter_expr = MakeAndFunc(
+      MakeAndFunc(MakeCompareFunc(">", MakeColumn("latency", 0), MakeInt(2)),
+                  MakeCompareFunc("==", MakeString("svc"), MakeColumn("service", 0))),
+      MakeCompareFunc("<", MakeColumn("latency", 0), MakeColumn("latency", 0)));
+  FilterIR* filter = MakeFilter(src, filter_expr);
+  MakeMemSink(filter, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  PredicatePushdownRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ValueOrDie());
+
+  EXPECT_THAT(src->predicates(), ElementsAre(testing::proto::EqualsProto(R"(
+column_idx: 2
+op: GREATER_THAN
+value { data_type: FLOAT64 float64_value: 2 }
+)"),
+                                             testing::proto::EqualsProto(R"(
+column_idx: 1
+op: EQUAL
+value { data_type: STRING string_value: "svc" }
+)")));
+  // The filter still applies to the rows of the batches that are read.
+  EXPECT_THAT(src->Children(), ElementsAre(filter));
+
+  // Running the rule again doesn't add the predicates twice.
+  result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ValueOrDie());
+  EXPECT_EQ(2U, src->predicates().size());
+
+  planpb::Operator op;
+  ASSERT_OK(src->ToProto(&op));
+  EXPECT_EQ(2, op.mem_source_op().predicates_size());
+}
+
+TEST_F(PredicatePushDownTest, source_with_multiple_children) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+
+  FilterIR* filter = MakeFilter(src, MakeEqualsFunc(MakeColumn("abc", 0), MakeInt(2)));
+  MakeMemSink(filter, "foo", {});
+  MakeMemSink(src, "bar", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  PredicatePushdownRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ValueOrDie());
+  EXPECT_TRUE(src->predicates().empty());
+}
+
+TEST_F(PredicatePushDownTest, mismatched_literal_type) {
+  Relation relation({types::DataType::INT64, types::DataType::STRING}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+
+  FilterIR* filter = MakeFilter(src, MakeEqualsFunc(MakeColumn("abc", 0), MakeString("2")));
+  MakeMemSink(filter, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  PredicatePushdownRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ValueOrDie());
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
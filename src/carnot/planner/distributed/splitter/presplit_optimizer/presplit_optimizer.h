@@ -22,6 +22,7 @@
 #include "src/carnot/planner/compiler_state/compiler_state.h"
 #include "src/carnot/planner/distributed/splitter/presplit_optimizer/filter_push_down_rule.h"
 #include "src/carnot/planner/distributed/splitter/presplit_optimizer/limit_push_down_rule.h"
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/predicate_push_down_rule.h"
 #include "src/carnot/planner/rules/rule_executor.h"
 
 namespace px {
@@ -60,9 +61,16 @@ class PreSplitOptimizer : public RuleExecutor<IR> {
     filter_pushdown->AddRule<FilterPushdownRule>(compiler_state_);
   }
 
+  void CreatePredicatePushdownBatch() {
+    // Runs after filter pushdown so that filters are already placed right after their sources.
+    RuleBatch* predicate_pushdown = CreateRuleBatch<TryUntilMax>("PredicatePushdown", 1);
+    predicate_pushdown->AddRule<PredicatePushdownRule>(compiler_state_);
+  }
+
   Status Init() {
     CreateLimitPushdownBatch();
     CreateFilterPushdownBatch();
+    CreatePredicatePushdownBatch();
     return Status::OK();
   }
 
@@ -31,6 +31,8 @@ Status GRPCSinkIR::CopyFromNodeImpl(const IRNode* node,
   destination_ssl_targetname_ = grpc_sink->destination_ssl_targetname_;
   name_ = grpc_sink->name_;
   out_columns_ = grpc_sink->out_columns_;
+  partition_key_columns_ = grpc_sink->partition_key_columns_;
+  partitions_.resize(grpc_sink->partitions_.size());
   return Status::OK();
 }
 
@@ -56,6 +58,9 @@ Status GRPCSinkIR::ToProto(planpb::Operator* op) const {
 Status GRPCSinkIR::ToProto(planpb::Operator* op, int64_t agent_id) const {
   auto pb = op->mutable_grpc_sink_op();
   op->set_op_type(planpb::GRPC_SINK_OPERATOR);
+  if (is_partitioned()) {
+    return PartitionedToProto(pb, agent_id);
+  }
   pb->set_address(destination_address());
   pb->mutable_connection_options()->set_ssl_targetname(destination_ssl_targetname());
   if (!agent_id_to_destination_id_.contains(agent_id)) {
@@ -65,6 +70,30 @@ Status GRPCSinkIR::ToProto(planpb::Operator* op, int64_t agent_id) const {
   return Status::OK();
 }
 
+Status GRPCSinkIR::PartitionedToProto(planpb::GRPCSinkOperator* pb, int64_t agent_id) const {
+  DCHECK(is_type_resolved());
+  auto partitioned_pb = pb->mutable_partitioned();
+  std::vector<std::string> col_names = resolved_table_type()->ColumnNames();
+  for (const auto& key : partition_key_columns_) {
+    auto it = std::find(col_names.begin(), col_names.end(), key);
+    if (it == col_names.end()) {
+      return CreateIRNodeError("Partition key column '$0' not found in '$1'", key, DebugString());
+    }
+    partitioned_pb->add_key_column_indexes(std::distance(col_names.begin(), it));
+  }
+  for (const auto& [i, partition] : Enumerate(partitions_)) {
+    if (!partition.agent_id_to_destination_id.contains(agent_id)) {
+      return CreateIRNodeError("No agent ID '$0' found in partition $1 of grpc sink '$2'",
+                               agent_id, i, DebugString());
+    }
+    auto partition_pb = partitioned_pb->add_partitions();
+    partition_pb->set_address(partition.address);
+    partition_pb->set_grpc_source_id(partition.agent_id_to_destination_id.at(agent_id));
+    partition_pb->mutable_connection_options()->set_ssl_targetname(partition.ssl_targetname);
+  }
+  return Status::OK();
+}
+
 Status GRPCSinkIR::ResolveType(CompilerState* /* compiler_state */) {
   DCHECK_EQ(1U, parent_types().size());
   // When out_columns_ is empty, the GRPCSink just copies the parent type.
@@ -114,6 +114,28 @@ class GRPCSinkIR : public OperatorIR {
   bool DestinationAddressSet() const { return destination_address_ != ""; }
   const std::string& destination_ssl_targetname() const { return destination_ssl_targetname_; }
 
+  /**
+   * @brief Hash partitions the rows of an internal sink on the key columns across num_partitions
+   * GRPCSourceGroups, one per receiving Carnot instance. Each group sets the address and
+   * destination ids of its partition.
+   */
+  void SetPartitionKeyColumns(const std::vector<std::string>& key_columns,
+                              int64_t num_partitions) {
+    partition_key_columns_ = key_columns;
+    partitions_.resize(num_partitions);
+  }
+  bool is_partitioned() const { return !partition_key_columns_.empty(); }
+  int64_t num_partitions() const { return partitions_.size(); }
+  const std::vector<std::string>& partition_key_columns() const { return partition_key_columns_; }
+  void SetPartitionAddress(int64_t partition, const std::string& address,
+                           const std::string& ssl_targetname) {
+    partitions_[partition].address = address;
+    partitions_[partition].ssl_targetname = ssl_targetname;
+  }
+  void AddPartitionDestinationIDMap(int64_t partition, int64_t destination_id, int64_t agent_id) {
+    partitions_[partition].agent_id_to_destination_id[agent_id] = destination_id;
+  }
+
   bool has_output_table() const { return sink_type_ == GRPCSinkType::kExternal; }
   std::string name() const { return name_; }
   void set_name(const std::string& name) { name_ = name; }
@@ -147,6 +169,8 @@ class GRPCSinkIR : public OperatorIR {
   }
 
  private:
+  Status PartitionedToProto(planpb::GRPCSinkOperator* pb, int64_t agent_id) const;
+
   std::string destination_address_ = "";
   std::string destination_ssl_targetname_ = "";
   GRPCSinkType sink_type_ = GRPCSinkType::kTypeNotSet;
@@ -156,6 +180,15 @@ class GRPCSinkIR : public OperatorIR {
   std::string name_;
   std::vector<std::string> out_columns_;
   absl::flat_hash_map<int64_t, int64_t> agent_id_to_destination_id_;
+
+  // Used when the rows are hash partitioned across several GRPCSourceGroups.
+  struct Partition {
+    std::string address;
+    std::string ssl_targetname;
+    absl::flat_hash_map<int64_t, int64_t> agent_id_to_destination_id;
+  };
+  std::vector<std::string> partition_key_columns_;
+  std::vector<Partition> partitions_;
 };
 
 }  // namespace planner
@@ -27,6 +27,7 @@ Status GRPCSourceGroupIR::CopyFromNodeImpl(const IRNode* node,
   const GRPCSourceGroupIR* grpc_source_group = static_cast<const GRPCSourceGroupIR*>(node);
   source_id_ = grpc_source_group->source_id_;
   grpc_address_ = grpc_source_group->grpc_address_;
+  partition_ = grpc_source_group->partition_;
   if (grpc_source_group->dependent_sinks_.size()) {
     return error::Unimplemented("Cannot clone GRPCSourceGroupIR with dependent_sinks_");
   }
@@ -58,8 +59,17 @@ Status GRPCSourceGroupIR::AddGRPCSink(GRPCSinkIR* sink_op,
     return DExitOrIRNodeError("$0 doesn't have a physical agent associated with it.",
                               DebugString());
   }
-  sink_op->SetDestinationAddress(grpc_address_);
-  sink_op->SetDestinationSSLTargetName(ssl_targetname_);
+  if (sink_op->is_partitioned()) {
+    if (partition_ < 0 || partition_ >= sink_op->num_partitions()) {
+      return DExitOrIRNodeError("$0 can't receive partition $1 of the $2 partitions of $3.",
+                                DebugString(), partition_, sink_op->num_partitions(),
+                                sink_op->DebugString());
+    }
+    sink_op->SetPartitionAddress(partition_, grpc_address_, ssl_targetname_);
+  } else {
+    sink_op->SetDestinationAddress(grpc_address_);
+    sink_op->SetDestinationSSLTargetName(ssl_targetname_);
+  }
   dependent_sinks_.emplace_back(sink_op, agents);
   return Status::OK();
 }
@@ -74,6 +74,11 @@ class GRPCSourceGroupIR : public OperatorIR {
   bool GRPCAddressSet() const { return grpc_address_ != ""; }
   const std::string& grpc_address() const { return grpc_address_; }
   int64_t source_id() const { return source_id_; }
+
+  // The partition of the rows of partitioned GRPCSinks that this group receives, -1 if the group
+  // receives all of them.
+  int64_t partition() const { return partition_; }
+  void SetPartition(int64_t partition) { partition_ = partition; }
   const std::vector<std::pair<GRPCSinkIR*, absl::flat_hash_set<int64_t>>>& dependent_sinks() {
     return dependent_sinks_;
   }
@@ -97,6 +102,7 @@ class GRPCSourceGroupIR : public OperatorIR {
 
  private:
   int64_t source_id_ = -1;
+  int64_t partition_ = -1;
   std::string grpc_address_ = "";
   std::string ssl_targetname_ = "";
   std::vector<std::pair<GRPCSinkIR*, absl::flat_hash_set<int64_t>>> dependent_sinks_;
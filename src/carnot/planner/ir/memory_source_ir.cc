@@ -64,6 +64,9 @@ Status MemorySourceIR::ToProto(planpb::Operator* op) const {
   }
 
   pb->set_streaming(streaming());
+  for (const auto& predicate : predicates_) {
+    *pb->add_predicates() = predicate;
+  }
   return Status::OK();
 }
 
@@ -106,6 +109,7 @@ Status MemorySourceIR::CopyFromNodeImpl(const IRNode* node,
   column_index_map_set_ = source_ir->column_index_map_set_;
   column_index_map_ = source_ir->column_index_map_;
   streaming_ = source_ir->streaming_;
+  predicates_ = source_ir->predicates_;
 
   return Status::OK();
 }
@@ -102,6 +102,11 @@ class MemorySourceIR : public OperatorIR {
 
   void SetColumnNames(const std::vector<std::string>& col_names) { column_names_ = col_names; }
 
+  // Comparisons on the table columns that hold for every row that the rest of the plan reads.
+  // They only let the MemorySource skip batches, the rows are still filtered downstream.
+  const std::vector<planpb::ColumnPredicate>& predicates() const { return predicates_; }
+  void AddPredicate(const planpb::ColumnPredicate& predicate) { predicates_.push_back(predicate); }
+
   bool IsSource() const override { return true; }
 
   Status ResolveType(CompilerState* compiler_state);
@@ -126,6 +131,8 @@ class MemorySourceIR : public OperatorIR {
 
   types::TabletID tablet_value_;
   bool has_tablet_value_ = false;
+
+  std::vector<planpb::ColumnPredicate> predicates_;
 };
 
 }  // namespace planner
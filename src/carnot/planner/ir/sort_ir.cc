@@ -0,0 +1,111 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/planner/ir/sort_ir.h"
+#include "src/carnot/planner/ir/ir.h"
+#include "src/carnot/planner/ir/pattern_match.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+
+Status SortIR::Init(OperatorIR* parent, const std::vector<ColumnIR*>& sort_cols,
+                    const std::vector<bool>& ascending) {
+  if (sort_cols.empty()) {
+    return CreateIRNodeError("Sort requires at least one column to sort by");
+  }
+  if (sort_cols.size() != ascending.size()) {
+    return CreateIRNodeError("Sort has $0 columns but $1 ascending values", sort_cols.size(),
+                             ascending.size());
+  }
+  PX_RETURN_IF_ERROR(AddParent(parent));
+  PX_RETURN_IF_ERROR(SetSortCols(sort_cols));
+  ascending_ = ascending;
+  return Status::OK();
+}
+
+Status SortIR::SetSortCols(const std::vector<ColumnIR*>& sort_cols) {
+  DCHECK(sort_cols_.empty());
+  sort_cols_.resize(sort_cols.size());
+  for (size_t i = 0; i < sort_cols.size(); ++i) {
+    PX_ASSIGN_OR_RETURN(sort_cols_[i], graph()->OptionallyCloneWithEdge(this, sort_cols[i]));
+  }
+  return Status::OK();
+}
+
+StatusOr<std::vector<absl::flat_hash_set<std::string>>> SortIR::RequiredInputColumns() const {
+  DCHECK(is_type_resolved());
+  absl::flat_hash_set<std::string> required{resolved_table_type()->ColumnNames().begin(),
+                                            resolved_table_type()->ColumnNames().end()};
+  for (ColumnIR* col : sort_cols_) {
+    required.insert(col->col_name());
+  }
+  return std::vector<absl::flat_hash_set<std::string>>{required};
+}
+
+Status SortIR::ResolveType(CompilerState* compiler_state) {
+  DCHECK_EQ(1U, parent_types().size());
+  for (ColumnIR* col : sort_cols_) {
+    PX_RETURN_IF_ERROR(ResolveExpressionType(col, compiler_state, parent_types()));
+  }
+  return SetResolvedType(parent_types()[0]->Copy());
+}
+
+Status SortIR::ToProto(planpb::Operator* op) const {
+  auto pb = op->mutable_sort_op();
+  op->set_op_type(planpb::SORT_OPERATOR);
+  DCHECK_EQ(parents().size(), 1UL);
+
+  for (const auto& [i, col] : Enumerate(sort_cols_)) {
+    auto sort_col_pb = pb->add_sort_columns();
+    PX_RETURN_IF_ERROR(col->ToProto(sort_col_pb->mutable_column()));
+    sort_col_pb->set_ascending(ascending_[i]);
+  }
+
+  DCHECK(parents()[0]->is_type_resolved());
+  auto parent_table_type = parents()[0]->resolved_table_type();
+  auto parent_id = parents()[0]->id();
+
+  DCHECK(is_type_resolved());
+  for (const std::string& col_name : resolved_table_type()->ColumnNames()) {
+    planpb::Column* col_pb = pb->add_columns();
+    col_pb->set_node(parent_id);
+    DCHECK(parent_table_type->HasColumn(col_name));
+    col_pb->set_index(parent_table_type->GetColumnIndex(col_name));
+  }
+  pb->set_limit(limit_);
+  return Status::OK();
+}
+
+Status SortIR::CopyFromNodeImpl(const IRNode* node,
+                                absl::flat_hash_map<const IRNode*, IRNode*>* copied_nodes_map) {
+  const SortIR* sort = static_cast<const SortIR*>(node);
+  std::vector<ColumnIR*> new_sort_cols;
+  for (const ColumnIR* col : sort->sort_cols_) {
+    PX_ASSIGN_OR_RETURN(ColumnIR * new_col, graph()->CopyNode(col, copied_nodes_map));
+    new_sort_cols.push_back(new_col);
+  }
+  PX_RETURN_IF_ERROR(SetSortCols(new_sort_cols));
+  ascending_ = sort->ascending_;
+  limit_ = sort->limit_;
+  return Status::OK();
+}
+
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -270,6 +270,31 @@ StatusOr<QLObjectPtr> LimitHandler(CompilerState* compiler_state, IR* graph, Ope
   return Dataframe::Create(compiler_state, limit_op, visitor);
 }
 
+// Handles the sort() DataFrame method.
+StatusOr<QLObjectPtr> SortHandler(CompilerState* compiler_state, IR* graph, OperatorIR* op,
+                                  const pypa::AstPtr& ast, const ParsedArgs& args,
+                                  ASTVisitor* visitor) {
+  PX_ASSIGN_OR_RETURN(std::vector<std::string> sort_names,
+                      ParseAsListOfStrings(args.GetArg("by"), "by"));
+  PX_ASSIGN_OR_RETURN(std::vector<BoolIR*> ascending_irs,
+                      ParseAsListOf<BoolIR>(args.GetArg("ascending"), "ascending"));
+  if (ascending_irs.size() != 1 && ascending_irs.size() != sort_names.size()) {
+    return CreateAstError(ast, "Expected 1 or $0 values for 'ascending', got $1",
+                          sort_names.size(), ascending_irs.size());
+  }
+
+  std::vector<ColumnIR*> sort_cols;
+  std::vector<bool> ascending;
+  for (const auto& [idx, name] : Enumerate(sort_names)) {
+    PX_ASSIGN_OR_RETURN(ColumnIR * col, graph->CreateNode<ColumnIR>(ast, name, /* parent_idx */ 0));
+    sort_cols.push_back(col);
+    ascending.push_back(ascending_irs[ascending_irs.size() == 1 ? 0 : idx]->val());
+  }
+
+  PX_ASSIGN_OR_RETURN(SortIR * sort_op, graph->CreateNode<SortIR>(ast, op, sort_cols, ascending));
+  return Dataframe::Create(compiler_state, sort_op, visitor);
+}
+
 class SubscriptHandler {
  public:
   /**
@@ -515,6 +540,23 @@ Status Dataframe::Init() {
   PX_RETURN_IF_ERROR(limitfn->SetDocString(kLimitOpDocstring));
   AddMethod(kLimitOpID, limitfn);
 
+  /**
+   * # Equivalent to the python method method syntax:
+   * def sort(self, by, ascending=True):
+   *     ...
+   */
+  PX_ASSIGN_OR_RETURN(
+      std::shared_ptr<FuncObject> sortfn,
+      FuncObject::Create(
+          kSortOpID, {"by", "ascending"}, {{"ascending", "True"}},
+          /* has_variable_len_args */ false,
+          /* has_variable_len_kwargs */ false,
+          std::bind(&SortHandler, compiler_state_, graph(), op(), std::placeholders::_1,
+                    std::placeholders::_2, std::placeholders::_3),
+          ast_visitor()));
+  PX_RETURN_IF_ERROR(sortfn->SetDocString(kSortOpDocstring));
+  AddMethod(kSortOpID, sortfn);
+
   /**
    *
    * # Equivalent to the python method method syntax:
@@ -281,6 +281,34 @@ class Dataframe : public QLObject {
     px.DataFrame: DataFrame with the first n rows.
   )doc";
 
+  inline static constexpr char kSortOpID[] = "sort";
+  inline static constexpr char kSortOpDocstring[] = R"doc(
+  Orders the rows of the DataFrame by the passed in columns.
+
+  Returns a DataFrame ordered by the columns in `by`, from the most to the least
+  significant one. Rows that compare equal keep their input order. Following
+  `sort()` with `head(n)` only keeps the first n rows, which is much cheaper than
+  sorting the whole DataFrame, because each agent only sends its own first n rows.
+
+  :topic: dataframe_ops
+  :opname: Sort
+
+  Examples:
+    df = px.DataFrame('http_events', start_time='-5m')
+    df = df.groupby(['req_path']).agg(latency_max=('latency', px.max))
+    # Keep the 10 slowest endpoints.
+    df = df.sort('latency_max', ascending=False).head(10)
+
+  Args:
+    by (Union[str,List[str]]): DataFrame columns to sort by, either as a string
+      or a list.
+    ascending (Union[bool,List[bool]]): Whether to sort in ascending order. Either a
+      single value for all the columns, or one value per column. Default is True.
+
+  Returns:
+    px.DataFrame: DataFrame with its rows ordered by the columns.
+  )doc";
+
   inline static constexpr char kMergeOpID[] = "merge";
   inline static constexpr char kMergeOpDocstring[] = R"doc(
   Merges the input DataFrame with this one using a database-style join.
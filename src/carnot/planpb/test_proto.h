@@ -289,6 +289,20 @@ output_table {
 }
 )";
 
+constexpr char kGRPCSinkOperatorPartitioned[] = R"(
+partitioned {
+  key_column_indexes: 0
+  partitions {
+    address: "kelvin0:1234"
+    grpc_source_id: 1
+  }
+  partitions {
+    address: "kelvin1:1234"
+    grpc_source_id: 2
+  }
+}
+)";
+
 constexpr char kMapOperator1[] = R"(
 expressions {
   func {
@@ -335,6 +349,84 @@ columns {
   index: 2
 }
 )";
+
+// Rolling sum, count, mean, min and max of column 2 over windows of 10 on column 0, grouped by
+// column 1.
+constexpr char kRollingOperator1[] = R"(
+window_col {
+  node: 1
+  index: 0
+}
+window_size: 10
+groups {
+  node: 1
+  index: 1
+}
+group_names: "group"
+values {
+  function: SUM
+  arg {
+    node: 1
+    index: 2
+  }
+}
+values {
+  function: COUNT
+}
+values {
+  function: MEAN
+  arg {
+    node: 1
+    index: 2
+  }
+}
+values {
+  function: MIN
+  arg {
+    node: 1
+    index: 2
+  }
+}
+values {
+  function: MAX
+  arg {
+    node: 1
+    index: 2
+  }
+}
+value_names: "sum"
+value_names: "count"
+value_names: "mean"
+value_names: "min"
+value_names: "max"
+)";
+
+// Orders by column 2 descending, then column 1 ascending, and outputs columns 1 and 2.
+constexpr char kSortOperator1[] = R"(
+sort_columns {
+  column {
+    node: 1
+    index: 2
+  }
+  ascending: false
+}
+sort_columns {
+  column {
+    node: 1
+    index: 1
+  }
+  ascending: true
+}
+columns {
+  node: 1
+  index: 1
+}
+columns {
+  node: 1
+  index: 2
+}
+)";
+
 // relation 1: [abc, time_]
 // relation 2: [time_, abc]
 // maps to output relation:
@@ -833,6 +925,107 @@ constexpr char kLinearPlanFragment[] = R"(
   }
 )";
 
+// Source -> Map -> blocking Agg -> Sink, with the name of the UDA to sum the values with as $0.
+constexpr char kMapAggPlanFragmentTmpl[] = R"(
+  id: 1,
+  dag {
+    nodes {
+      id: 1
+      sorted_children: 2
+    }
+    nodes {
+      id: 2
+      sorted_children: 3
+      sorted_parents: 1
+    }
+    nodes {
+      id: 3
+      sorted_children: 4
+      sorted_parents: 2
+    }
+    nodes {
+      id: 4
+      sorted_parents: 3
+    }
+  }
+  nodes {
+    id: 1
+    op {
+      op_type: MEMORY_SOURCE_OPERATOR
+      mem_source_op {
+        name: "numbers"
+        column_idxs: 0
+        column_types: INT64
+        column_names: "key"
+        column_idxs: 1
+        column_types: INT64
+        column_names: "val"
+      }
+    }
+  }
+  nodes {
+    id: 2
+    op {
+      op_type: MAP_OPERATOR
+      map_op {
+        expressions {
+          column {
+            node: 1
+            index: 0
+          }
+        }
+        expressions {
+          column {
+            node: 1
+            index: 1
+          }
+        }
+        column_names: "key"
+        column_names: "val"
+      }
+    }
+  }
+  nodes {
+    id: 3
+    op {
+      op_type: AGGREGATE_OPERATOR
+      agg_op {
+        windowed: false
+        values {
+          name: "$0"
+          id: 0
+          args {
+            column {
+              node: 2
+              index: 1
+            }
+          }
+          args_data_types: INT64
+        }
+        groups {
+          node: 2
+          index: 0
+        }
+        group_names: "key"
+        value_names: "sum"
+      }
+    }
+  }
+  nodes {
+    id: 4
+    op {
+      op_type: MEMORY_SINK_OPERATOR
+      mem_sink_op {
+        name: "output"
+        column_types: INT64
+        column_types: INT64
+        column_names: "key"
+        column_names: "sum"
+      }
+    }
+  }
+)";
+
 constexpr char kPlanWithFiveNodes[] = R"(
   dag {
     nodes {
@@ -1406,6 +1599,14 @@ planpb::Operator CreateTestGRPCSink2PB() {
   return op;
 }
 
+planpb::Operator CreateTestGRPCSinkPartitionedPB() {
+  planpb::Operator op;
+  auto op_proto = absl::Substitute(kOperatorProtoTmpl, "GRPC_SINK_OPERATOR", "grpc_sink_op",
+                                   kGRPCSinkOperatorPartitioned);
+  CHECK(google::protobuf::TextFormat::MergeFromString(op_proto, &op)) << "Failed to parse proto";
+  return op;
+}
+
 planpb::Operator CreateTestBlockingAgg1PB() {
   planpb::Operator op;
   auto op_proto =
@@ -1478,6 +1679,27 @@ planpb::Operator CreateTestDropLimit1PB() {
   return op;
 }
 
+planpb::Operator CreateTestRolling1PB() {
+  planpb::Operator op;
+  auto op_proto =
+      absl::Substitute(kOperatorProtoTmpl, "ROLLING_OPERATOR", "rolling_op", kRollingOperator1);
+  CHECK(google::protobuf::TextFormat::MergeFromString(op_proto, &op)) << "Failed to parse proto";
+  return op;
+}
+
+planpb::Operator CreateTestSort1PB() {
+  planpb::Operator op;
+  auto op_proto = absl::Substitute(kOperatorProtoTmpl, "SORT_OPERATOR", "sort_op", kSortOperator1);
+  CHECK(google::protobuf::TextFormat::MergeFromString(op_proto, &op)) << "Failed to parse proto";
+  return op;
+}
+
+planpb::Operator CreateTestTopK1PB(int64_t limit) {
+  planpb::Operator op = CreateTestSort1PB();
+  op.mutable_sort_op()->set_limit(limit);
+  return op;
+}
+
 planpb::Operator CreateTestJoinWithTimePB() {
   planpb::Operator op;
   auto op_proto = absl::Substitute(kOperatorProtoTmpl, "JOIN_OPERATOR", "join_op", kJoinOperator1);
@@ -0,0 +1,259 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <google/protobuf/text_format.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <absl/strings/substitute.h>
+#include <sole.hpp>
+
+#include "src/carnot/exec/agg_node.h"
+#include "src/carnot/exec/map_node.h"
+#include "src/carnot/exec/rolling_node.h"
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/funcs/funcs.h"
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/base/base.h"
+#include "src/common/benchmark/benchmark.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+using table_store::schema::RowDescriptor;
+
+namespace {
+
+constexpr int64_t kBatchSize = 1024;
+// Every refresh of the benchmarks appends one batch to the stream.
+constexpr int64_t kNumRefreshes = 256;
+// One row per millisecond, so a batch covers about a second.
+constexpr int64_t kRowIntervalNS = 1000 * 1000;
+constexpr int64_t kWindowNS = 10LL * 1000 * 1000 * 1000;
+
+// [time_, group, value] -> rolling sum, count, mean, min and max of value by group.
+constexpr char kRollingOp[] = R"(
+op_type: ROLLING_OPERATOR
+rolling_op {
+  window_col { index: 0 }
+  window_size: $0
+  groups { index: 1 }
+  group_names: "group"
+  values { function: SUM arg { index: 2 } }
+  values { function: COUNT }
+  values { function: MEAN arg { index: 2 } }
+  values { function: MIN arg { index: 2 } }
+  values { function: MAX arg { index: 2 } }
+  value_names: "sum"
+  value_names: "count"
+  value_names: "mean"
+  value_names: "min"
+  value_names: "max"
+})";
+
+// [time_, group, value] -> [px.bin(time_, window), group, value].
+constexpr char kBinMapOp[] = R"(
+op_type: MAP_OPERATOR
+map_op {
+  expressions {
+    func {
+      name: "bin"
+      id: 1
+      args { column { index: 0 } }
+      args { constant { data_type: INT64 int64_value: $0 } }
+      args_data_types: TIME64NS
+      args_data_types: INT64
+    }
+  }
+  expressions { column { index: 1 } }
+  expressions { column { index: 2 } }
+  column_names: "time_"
+  column_names: "group"
+  column_names: "value"
+})";
+
+// Groups the binned rows by [time_, group] and computes the same values as kRollingOp.
+constexpr char kBinAggOp[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values { name: "sum" id: 2 args { column { index: 2 } } args_data_types: INT64 }
+  values { name: "count" id: 3 args { column { index: 2 } } args_data_types: INT64 }
+  values { name: "mean" id: 4 args { column { index: 2 } } args_data_types: INT64 }
+  values { name: "min" id: 5 args { column { index: 2 } } args_data_types: INT64 }
+  values { name: "max" id: 6 args { column { index: 2 } } args_data_types: INT64 }
+  groups { index: 0 }
+  groups { index: 1 }
+  group_names: "time_"
+  group_names: "group"
+  value_names: "sum"
+  value_names: "count"
+  value_names: "mean"
+  value_names: "min"
+  value_names: "max"
+})";
+
+const RowDescriptor kInputRD({types::TIME64NS, types::INT64, types::INT64});
+const RowDescriptor kOutputRD({types::TIME64NS, types::INT64, types::INT64, types::INT64,
+                               types::FLOAT64, types::INT64, types::INT64});
+
+std::unique_ptr<plan::Operator> ParseOperator(const std::string& op_str) {
+  planpb::Operator op_pb;
+  CHECK(google::protobuf::TextFormat::MergeFromString(op_str, &op_pb));
+  return plan::Operator::FromProto(op_pb, 1);
+}
+
+std::vector<RowBatch> MakeStream(int64_t num_groups) {
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<int64_t> group_dist(0, num_groups - 1);
+  std::uniform_int_distribution<int64_t> value_dist(0, 1000 * 1000);
+  std::vector<RowBatch> batches;
+  for (int64_t batch = 0; batch < kNumRefreshes; ++batch) {
+    std::vector<types::Time64NSValue> times(kBatchSize);
+    std::vector<types::Int64Value> groups(kBatchSize);
+    std::vector<types::Int64Value> values(kBatchSize);
+    for (int64_t i = 0; i < kBatchSize; ++i) {
+      times[i] = (batch * kBatchSize + i) * kRowIntervalNS;
+      groups[i] = group_dist(rng);
+      values[i] = value_dist(rng);
+    }
+    batches.push_back(RowBatchBuilder(kInputRD, kBatchSize, /*eow*/ false, /*eos*/ false)
+                          .AddColumn<types::Time64NSValue>(times)
+                          .AddColumn<types::Int64Value>(groups)
+                          .AddColumn<types::Int64Value>(values)
+                          .get());
+  }
+  return batches;
+}
+
+std::unique_ptr<ExecState> MakeExecState(udf::Registry* registry) {
+  auto exec_state = std::make_unique<ExecState>(
+      registry, std::make_shared<table_store::TableStore>(), MockResultSinkStubGenerator,
+      MockMetricsStubGenerator, MockTraceStubGenerator, sole::uuid4(), nullptr);
+  PX_CHECK_OK(exec_state->AddScalarUDF(1, "bin", {types::TIME64NS, types::INT64}));
+  int64_t id = 2;
+  for (const auto& uda : {"sum", "count", "mean", "min", "max"}) {
+    PX_CHECK_OK(exec_state->AddUDA(id++, uda, {types::INT64}));
+  }
+  return exec_state;
+}
+
+// Copies the batch with the end of window and stream set, to finish a bin + agg query.
+RowBatch WithEOS(const RowBatch& rb) {
+  RowBatch out(rb.desc(), rb.num_rows());
+  for (int64_t i = 0; i < rb.num_columns(); ++i) {
+    PX_CHECK_OK(out.AddColumn(rb.ColumnAt(i)));
+  }
+  out.set_eow(true);
+  out.set_eos(true);
+  return out;
+}
+
+}  // namespace
+
+// Updates the rolling aggregates with each new batch of the stream. state.range(0) is the number
+// of groups. state.range(1) is the number of batches displayed on each refresh, which the rolling
+// node doesn't depend on.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_RollingRefresh(benchmark::State& state) {
+  auto registry = std::make_unique<udf::Registry>("default_registry");
+  funcs::RegisterFuncsOrDie(registry.get());
+  auto exec_state = MakeExecState(registry.get());
+  auto plan_node = ParseOperator(absl::Substitute(kRollingOp, kWindowNS));
+  auto batches = MakeStream(state.range(0));
+
+  for (auto _ : state) {
+    RollingNode node;
+    PX_CHECK_OK(node.Init(*plan_node, kOutputRD, {kInputRD}));
+    PX_CHECK_OK(node.Prepare(exec_state.get()));
+    PX_CHECK_OK(node.Open(exec_state.get()));
+    for (const auto& rb : batches) {
+      PX_CHECK_OK(node.ConsumeNext(exec_state.get(), rb, 0));
+    }
+    PX_CHECK_OK(node.Close(exec_state.get()));
+  }
+  state.SetItemsProcessed(state.iterations() * kNumRefreshes * kBatchSize);
+}
+
+// Recomputes px.bin + groupby().agg() over the displayed range of the stream on every refresh,
+// which is what a query without a streaming rolling operator has to do.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_BinAggRefresh(benchmark::State& state) {
+  auto registry = std::make_unique<udf::Registry>("default_registry");
+  funcs::RegisterFuncsOrDie(registry.get());
+  auto exec_state = MakeExecState(registry.get());
+  auto map_plan = ParseOperator(absl::Substitute(kBinMapOp, kWindowNS));
+  auto agg_plan = ParseOperator(kBinAggOp);
+  auto batches = MakeStream(state.range(0));
+  int64_t range_batches = state.range(1);
+
+  std::vector<RowBatch> last_batches;
+  for (const auto& rb : batches) {
+    last_batches.push_back(WithEOS(rb));
+  }
+
+  for (auto _ : state) {
+    for (int64_t refresh = 0; refresh < kNumRefreshes; ++refresh) {
+      MapNode map;
+      AggNode agg;
+      PX_CHECK_OK(map.Init(*map_plan, kInputRD, {kInputRD}));
+      PX_CHECK_OK(agg.Init(*agg_plan, kOutputRD, {kInputRD}));
+      map.AddChild(&agg, 0);
+      for (ExecNode* node : std::vector<ExecNode*>{&map, &agg}) {
+        PX_CHECK_OK(node->Prepare(exec_state.get()));
+        PX_CHECK_OK(node->Open(exec_state.get()));
+      }
+      for (int64_t i = std::max<int64_t>(0, refresh - range_batches + 1); i < refresh; ++i) {
+        PX_CHECK_OK(map.ConsumeNext(exec_state.get(), batches[i], 0));
+      }
+      PX_CHECK_OK(map.ConsumeNext(exec_state.get(), last_batches[refresh], 0));
+      PX_CHECK_OK(agg.Close(exec_state.get()));
+      PX_CHECK_OK(map.Close(exec_state.get()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumRefreshes * kBatchSize);
+}
+
+static void RefreshArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t num_groups : {16, 4096}) {
+    for (int64_t range_batches : {16, 256}) {
+      b->Args({num_groups, range_batches});
+    }
+  }
+}
+
+BENCHMARK(BM_RollingRefresh)
+    ->ArgNames({"groups", "range_batches"})
+    ->Apply(RefreshArgs)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BinAggRefresh)
+    ->ArgNames({"groups", "range_batches"})
+    ->Apply(RefreshArgs)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
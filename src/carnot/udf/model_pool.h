@@ -18,7 +18,7 @@
 
 #pragma once
 
-#include <absl/base/internal/spinlock.h>
+#include <absl/synchronization/mutex.h>
 #include <chrono>
 #include <memory>
 #include <thread>
@@ -41,11 +41,8 @@ class ModelPool {
 
   template <typename TExecutor, typename... Args>
   void CreatePool(Args... args) {
-    // TODO(james, PP-2594): currently if you ask for the same type of model with different args the
-    // pool will return the first args asked for.
-    auto pool = std::make_unique<PoolType>();
-    pool->Add(std::make_unique<TExecutor>(args...));
-    pool_map_[TExecutor::Type()] = std::move(pool);
+    absl::MutexLock l(&pool_map_lock_);
+    CreatePoolLocked<TExecutor>(args...);
   }
 
   template <typename TExecutor>
@@ -56,19 +53,39 @@ class ModelPool {
 
   template <typename TExecutor, typename... Args>
   std::unique_ptr<TExecutor, DerivedDeleter<TExecutor>> GetModelExecutor(Args... args) {
-    if (pool_map_.find(TExecutor::Type()) == pool_map_.end()) {
-      CreatePool<TExecutor>(args...);
+    // The UDFs of a query can run on several threads at once (see exec::ParallelPipeline), so the
+    // map is only accessed under the lock. The pools synchronize their own borrowers.
+    PoolType* pool = nullptr;
+    {
+      absl::MutexLock l(&pool_map_lock_);
+      if (pool_map_.find(TExecutor::Type()) == pool_map_.end()) {
+        CreatePoolLocked<TExecutor>(args...);
+      }
+      pool = pool_map_[TExecutor::Type()].get();
     }
-    auto ptr = pool_map_[TExecutor::Type()]->Borrow();
+    auto ptr = pool->Borrow();
     while (ptr == nullptr) {
-      ptr = pool_map_[TExecutor::Type()]->Borrow();
+      ptr = pool->Borrow();
       std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
     return std::unique_ptr<TExecutor, DerivedDeleter<TExecutor>>(
         static_cast<TExecutor*>(ptr.release()), DerivedDeleter<TExecutor>{ptr.get_deleter()});
   }
 
-  std::unordered_map<ModelType, std::unique_ptr<PoolType>> pool_map_;
+ private:
+  template <typename TExecutor, typename... Args>
+  void CreatePoolLocked(Args... args) ABSL_EXCLUSIVE_LOCKS_REQUIRED(pool_map_lock_) {
+    // TODO(james, PP-2594): currently if you ask for the same type of model with different args the
+    // pool will return the first args asked for.
+    auto pool = std::make_unique<PoolType>();
+    pool->Add(std::make_unique<TExecutor>(args...));
+    pool_map_[TExecutor::Type()] = std::move(pool);
+  }
+
+  // A mutex rather than a spinlock, since it is held while a model is loaded.
+  absl::Mutex pool_map_lock_;
+  std::unordered_map<ModelType, std::unique_ptr<PoolType>> pool_map_
+      ABSL_GUARDED_BY(pool_map_lock_);
 };
 
 }  // namespace udf
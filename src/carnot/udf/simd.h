@@ -0,0 +1,181 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace udf {
+
+/**
+ * Helpers to write the ExecBatch function of a ScalarUDF (see udf.h) with explicit SIMD.
+ *
+ * The kernels load kSIMDLanes values of each argument into a vector (using the compiler's
+ * vector extensions, so the same code compiles to SSE/AVX on x86 and NEON on ARM), apply the
+ * operation to all the lanes at once and store the result. The tail of the batch is done one value
+ * at a time. The operation is a generic lambda, which is called with both vectors and scalars:
+ *
+ *   BinaryBatch<double>(count, b1, b2, out, [](auto x, auto y) { return x + y; });
+ *
+ * Both arguments are converted to the compute type (the first template argument) before the
+ * operation is applied. Comparisons return a lane mask for vectors, which is turned into 0/1 when
+ * the output is a BoolValue.
+ */
+
+// Four 64-bit lanes fill an AVX2 register, or two SSE/NEON registers.
+constexpr size_t kSIMDLanes = 4;
+
+// The native type that the value type is stored as in memory. Only the fixed size value types that
+// map onto a native arithmetic type can be used with the batch kernels.
+template <typename TValue>
+struct SIMDNativeType {};
+
+template <>
+struct SIMDNativeType<types::BoolValue> {
+  using type = uint8_t;
+};
+
+template <>
+struct SIMDNativeType<types::Int64Value> {
+  using type = int64_t;
+};
+
+template <>
+struct SIMDNativeType<types::Time64NSValue> {
+  using type = int64_t;
+};
+
+template <>
+struct SIMDNativeType<types::Float64Value> {
+  using type = double;
+};
+
+template <typename TValue>
+using SIMDNative = typename SIMDNativeType<TValue>::type;
+
+static_assert(sizeof(types::BoolValue) == sizeof(uint8_t));
+static_assert(sizeof(types::Int64Value) == sizeof(int64_t));
+static_assert(sizeof(types::Time64NSValue) == sizeof(int64_t));
+static_assert(sizeof(types::Float64Value) == sizeof(double));
+
+/**
+ * Returns whether values of the data type can be passed to the batch kernels.
+ */
+constexpr bool IsSIMDDataType(types::DataType data_type) {
+  return data_type == types::BOOLEAN || data_type == types::INT64 ||
+         data_type == types::FLOAT64 || data_type == types::TIME64NS;
+}
+
+template <typename T>
+struct SIMDVector {
+  typedef T type __attribute__((vector_size(kSIMDLanes * sizeof(T))));
+};
+
+namespace internal {
+
+template <typename TCompute, typename TValue>
+inline auto LoadLanes(const TValue* in) {
+  using TNative = SIMDNative<TValue>;
+  typename SIMDVector<TNative>::type lanes;
+  std::memcpy(&lanes, static_cast<const void*>(in), sizeof(lanes));
+  if constexpr (std::is_same_v<TNative, TCompute>) {
+    return lanes;
+  } else {
+    return __builtin_convertvector(lanes, typename SIMDVector<TCompute>::type);
+  }
+}
+
+template <typename TValue, typename TLanes>
+inline void StoreLanes(const TLanes& lanes, TValue* out) {
+  using TNative = SIMDNative<TValue>;
+  auto native = __builtin_convertvector(lanes, typename SIMDVector<TNative>::type);
+  if constexpr (std::is_same_v<TValue, types::BoolValue>) {
+    // Comparisons set all the bits of a true lane.
+    native &= 1;
+  }
+  std::memcpy(static_cast<void*>(out), &native, sizeof(native));
+}
+
+template <typename TValue, typename TResult>
+inline void StoreValue(TResult result, TValue* out) {
+  auto native = static_cast<SIMDNative<TValue>>(result);
+  std::memcpy(static_cast<void*>(out), &native, sizeof(native));
+}
+
+template <typename TCompute, typename TValue>
+inline TCompute LoadValue(const TValue* in) {
+  SIMDNative<TValue> native;
+  std::memcpy(&native, static_cast<const void*>(in), sizeof(native));
+  return static_cast<TCompute>(native);
+}
+
+}  // namespace internal
+
+/**
+ * Computes out[i] = fn(arg[i]) for count values, with the argument converted to TCompute.
+ */
+template <typename TCompute, typename TOut, typename TArg, typename TFn>
+inline void UnaryBatch(size_t count, const TArg* arg, TOut* out, TFn fn) {
+  size_t idx = 0;
+  for (; idx + kSIMDLanes <= count; idx += kSIMDLanes) {
+    internal::StoreLanes(fn(internal::LoadLanes<TCompute>(arg + idx)), out + idx);
+  }
+  for (; idx < count; ++idx) {
+    internal::StoreValue(fn(internal::LoadValue<TCompute>(arg + idx)), out + idx);
+  }
+}
+
+/**
+ * Computes out[i] = fn(arg1[i], arg2[i]) for count values, with both arguments converted to
+ * TCompute.
+ */
+template <typename TCompute, typename TOut, typename TArg1, typename TArg2, typename TFn>
+inline void BinaryBatch(size_t count, const TArg1* arg1, const TArg2* arg2, TOut* out, TFn fn) {
+  size_t idx = 0;
+  for (; idx + kSIMDLanes <= count; idx += kSIMDLanes) {
+    internal::StoreLanes(
+        fn(internal::LoadLanes<TCompute>(arg1 + idx), internal::LoadLanes<TCompute>(arg2 + idx)),
+        out + idx);
+  }
+  for (; idx < count; ++idx) {
+    internal::StoreValue(
+        fn(internal::LoadValue<TCompute>(arg1 + idx), internal::LoadValue<TCompute>(arg2 + idx)),
+        out + idx);
+  }
+}
+
+/**
+ * The type two arguments are compared in: double if either of them is a Float64Value, otherwise
+ * their common integer type.
+ */
+template <typename TArg1, typename TArg2>
+using SIMDCompareType =
+    std::conditional_t<std::is_same_v<SIMDNative<TArg1>, SIMDNative<TArg2>>, SIMDNative<TArg1>,
+                       std::conditional_t<std::is_same_v<SIMDNative<TArg1>, double> ||
+                                              std::is_same_v<SIMDNative<TArg2>, double>,
+                                          double, int64_t>>;
+
+}  // namespace udf
+}  // namespace carnot
+}  // namespace px
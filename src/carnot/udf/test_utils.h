@@ -24,6 +24,7 @@
 #include <memory>
 #include <random>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -91,6 +92,9 @@ class UDFTester {
   template <typename... Args>
   UDFTester& ForInput(Args... args) {
     res_ = udf_.Exec(function_ctx_.get(), args...);
+    if constexpr (ScalarUDFTraits<TUDF>::HasExecBatch()) {
+      ExpectSameExecBatchResult(std::index_sequence_for<Args...>{}, args...);
+    }
 
     return *this;
   }
@@ -108,6 +112,25 @@ class UDFTester {
   typename types::DataTypeTraits<udf_data_type>::value_type Result() { return res_; }
 
  private:
+  /*
+   * Runs ExecBatch on a batch of copies of the arguments, and checks that every record has the
+   * result of Exec.
+   */
+  template <std::size_t... I, typename... Args>
+  void ExpectSameExecBatchResult(std::index_sequence<I...>, Args... args) {
+    constexpr auto exec_argument_types = ScalarUDFTraits<TUDF>::ExecArguments();
+    // Long enough to go through both the SIMD lanes and the tail of the batch.
+    constexpr size_t kNumRecords = 2 * kSIMDLanes + 1;
+    std::tuple<std::vector<typename types::DataTypeTraits<exec_argument_types[I]>::value_type>...>
+        inputs(std::vector<typename types::DataTypeTraits<exec_argument_types[I]>::value_type>(
+            kNumRecords, args)...);
+    std::vector<typename types::DataTypeTraits<udf_data_type>::value_type> out(kNumRecords);
+    udf_.ExecBatch(function_ctx_.get(), kNumRecords, std::get<I>(inputs).data()..., out.data());
+    for (const auto& val : out) {
+      internal::ExpectEquality(val, res_);
+    }
+  }
+
   TUDF udf_;
   std::unique_ptr<udf::FunctionContext> function_ctx_ = nullptr;
   typename types::DataTypeTraits<udf_data_type>::value_type res_;
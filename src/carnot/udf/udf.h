@@ -31,6 +31,7 @@
 #include <functional>
 
 #include "src/carnot/udf/base.h"
+#include "src/carnot/udf/simd.h"
 #include "src/carnot/udfspb/udfs.pb.h"
 #include "src/common/base/base.h"
 #include "src/shared/metadata/metadata_state.h"
@@ -74,10 +75,25 @@ class AnyUDA : public BaseFunc {
  *      Status Init(FunctionContext *ctx, UDFValue... init_args) {}
  *  This function is called once during initialization of each instance (many instances
  *  may exists in a given query). The arguments are as provided by the query.
+ *
+ * UDFs whose arguments and return value are all BOOLEAN, INT64, FLOAT64 or TIME64NS can also
+ * implement a function that computes a whole batch of records at once:
+ *      void ExecBatch(FunctionContext *ctx, size_t count, const UDFValue*... values,
+ *                     UDFValue* out) {}
+ *  It must compute the same results as Exec, and is used instead of it when it exists
+ *  (see simd.h for helpers to write it).
+ *
+ * UDFs with a single STRING, INT64 or UINT128 argument whose Exec is expensive and only depends
+ * on the argument (for example lookups in the metadata state) can ask for Exec to be called once
+ * per distinct value of a batch by declaring:
+ *      static constexpr bool MemoizeExec() { return true; }
+ *  The result for the other records with the same value is copied from the first one.
  */
 class ScalarUDF : public AnyUDF {
  public:
   ~ScalarUDF() override = default;
+
+  static constexpr bool MemoizeExec() { return false; }
 };
 
 /**
@@ -99,6 +115,10 @@ class ScalarUDF : public AnyUDF {
  *     StringValue Serialize(FunctionContext*) {}
  *     Status DeSerialize(FunctionContext*, const StringValue& data) {}
  *
+ * UDAs with the same semantics as one of the VectorizedUDAKinds can declare it, which lets the
+ * aggregate node run them as columnar loops instead of calling Update for every row:
+ *     static constexpr VectorizedUDAKind kVectorizedKind = VectorizedUDAKind::kSum;
+ *
  * All argument types must me valid UDFValueTypes.
  */
 class UDA : public AnyUDA {
@@ -106,6 +126,28 @@ class UDA : public AnyUDA {
   ~UDA() override = default;
 };
 
+/**
+ * The aggregates that have a vectorized implementation in the aggregate node.
+ */
+enum class VectorizedUDAKind {
+  kNone,
+  kCount,
+  kSum,
+  kMean,
+  kMin,
+  kMax,
+};
+
+// SFINAE test for the vectorized kind.
+template <typename T, typename = void>
+struct has_uda_vectorized_kind : std::false_type {};
+
+template <typename T>
+struct has_uda_vectorized_kind<T, std::void_t<decltype(T::kVectorizedKind)>> : std::true_type {
+  static_assert(std::is_same_v<std::remove_cv_t<decltype(T::kVectorizedKind)>, VectorizedUDAKind>,
+                "kVectorizedKind must be a VectorizedUDAKind");
+};
+
 // SFINAE test for init fn.
 template <typename T, typename = void>
 struct has_udf_init_fn : std::false_type {};
@@ -176,6 +218,44 @@ struct check_executor_fn<T, typename std::enable_if_t<has_udf_executor_fn<T>::va
                 "must have a valid Executor fn, in form: UDFSourceExecutor Executor()");
 };
 
+/**
+ * Checks to see if a valid looking ExecBatch function exists.
+ */
+template <typename ReturnType, typename TUDF, typename... Types>
+static constexpr bool IsValidExecBatchFn(ReturnType (TUDF::*)(Types...)) {
+  return false;
+}
+
+template <typename TUDF, typename... Types>
+static constexpr bool IsValidExecBatchFn(void (TUDF::*)(FunctionContext*, size_t, Types...)) {
+  return true;
+}
+
+/**
+ * Checks whether the arguments and the return value of an Exec function can be passed to the
+ * batch kernels.
+ */
+template <typename ReturnType, typename TUDF, typename... Types>
+static constexpr bool IsSIMDExecFn(ReturnType (TUDF::*)(FunctionContext*, Types...)) {
+  return IsSIMDDataType(types::ValueTypeTraits<ReturnType>::data_type) &&
+         (IsSIMDDataType(types::ValueTypeTraits<Types>::data_type) && ...);
+}
+
+// SFINAE test for ExecBatch fn. ExecBatch is only looked at when the types of Exec are supported
+// by the batch kernels, since template UDFs declare it for instantiations where it can't compile.
+template <typename T, typename = void>
+struct has_udf_exec_batch_fn : std::false_type {};
+
+template <typename T>
+struct has_udf_exec_batch_fn<
+    T, std::enable_if_t<IsSIMDExecFn(&T::Exec), std::void_t<decltype(&T::ExecBatch)>>>
+    : std::true_type {
+  static_assert(IsValidExecBatchFn(&T::ExecBatch),
+                "If an ExecBatch function exists, it must have the form: void "
+                "ExecBatch(FunctionContext*, size_t count, const UDFValue*... args, "
+                "UDFValue* out)");
+};
+
 template <typename ReturnType, typename TUDF, typename... Types>
 static constexpr std::array<types::DataType, sizeof...(Types)> GetArgumentTypesHelper(
     ReturnType (TUDF::*)(FunctionContext*, Types...)) {
@@ -228,6 +308,27 @@ class ScalarUDFTraits {
    */
   static constexpr bool HasExecutor() { return has_udf_executor_fn<T>::value; }
 
+  /**
+   * Checks if the UDF has an ExecBatch function that can be used for its types. Template UDFs
+   * can declare ExecBatch for all of their instantiations, it's only used for the ones where
+   * every argument and the return value are supported by the batch kernels.
+   * @return true if ExecBatch should be used instead of Exec.
+   */
+  static constexpr bool HasExecBatch() { return has_udf_exec_batch_fn<T>::value; }
+
+  /**
+   * Checks if Exec should only be called once per distinct argument value of a batch. Only UDFs
+   * with a single argument that is a STRING, INT64 or UINT128 can be memoized.
+   * @return true if the UDF asks for memoization and its argument supports it.
+   */
+  static constexpr bool HasMemoizedExec() {
+    if (!T::MemoizeExec() || ExecArguments().size() != 1) {
+      return false;
+    }
+    auto arg_type = ExecArguments()[0];
+    return arg_type == types::STRING || arg_type == types::INT64 || arg_type == types::UINT128;
+  }
+
   template <typename Q = T, std::enable_if_t<ScalarUDFTraits<Q>::HasInit(), void>* = nullptr>
   static constexpr auto InitArguments() {
     return GetArgumentTypesHelper(&Q::Init);
@@ -368,6 +469,17 @@ class UDATraits {
     return has_uda_serialize_fn<T>() && has_uda_deserialize_fn<T>();
   }
 
+  /**
+   * @brief The vectorized aggregate with the same semantics as this UDA, if any.
+   */
+  static constexpr VectorizedUDAKind VectorizedKind() {
+    if constexpr (has_uda_vectorized_kind<T>::value) {
+      return T::kVectorizedKind;
+    } else {
+      return VectorizedUDAKind::kNone;
+    }
+  }
+
   template <typename Q = T, std::enable_if_t<UDATraits<Q>::HasInit(), void>* = nullptr>
   static constexpr auto InitArguments() {
     return GetArgumentTypesHelper(&Q::Init);
@@ -95,6 +95,9 @@ class ScalarUDFDefinition : public UDFDefinition {
     exec_arguments_ = {begin(exec_arguments_array), end(exec_arguments_array)};
     exec_wrapper_fn_ = ScalarUDFWrapper<TUDF>::ExecBatch;
     exec_wrapper_arrow_fn_ = ScalarUDFWrapper<TUDF>::ExecBatchArrow;
+    if constexpr (ScalarUDFTraits<TUDF>::HasExecBatch()) {
+      exec_udf_batch_fn_ = ScalarUDFWrapper<TUDF>::ExecUDFBatch;
+    }
     init_wrapper_fn_ = ScalarUDFWrapper<TUDF>::ExecInit;
 
     auto init_arguments_array = ScalarUDFTraits<TUDF>::InitArguments();
@@ -125,6 +128,19 @@ class ScalarUDFDefinition : public UDFDefinition {
     return exec_wrapper_fn_(udf, ctx, inputs, output, count);
   }
 
+  /**
+   * Whether the UDF implements ExecBatch (see ScalarUDF), in which case ExecUDFBatch can be used
+   * instead of ExecBatch.
+   */
+  bool has_exec_udf_batch() const { return exec_udf_batch_fn_ != nullptr; }
+
+  Status ExecUDFBatch(ScalarUDF* udf, FunctionContext* ctx,
+                      const std::vector<const types::ColumnWrapper*>& inputs,
+                      types::ColumnWrapper* output, int count) {
+    DCHECK(has_exec_udf_batch());
+    return exec_udf_batch_fn_(udf, ctx, inputs, output, count);
+  }
+
   Status ExecBatchArrow(ScalarUDF* udf, FunctionContext* ctx,
                         const std::vector<arrow::Array*>& inputs, arrow::ArrayBuilder* output,
                         int count) {
@@ -160,6 +176,11 @@ class ScalarUDFDefinition : public UDFDefinition {
                        const std::vector<const types::ColumnWrapper*>& inputs,
                        types::ColumnWrapper* output, int count)>
       exec_wrapper_fn_;
+  // Only set if the UDF implements ExecBatch.
+  std::function<Status(ScalarUDF*, FunctionContext* ctx,
+                       const std::vector<const types::ColumnWrapper*>& inputs,
+                       types::ColumnWrapper* output, int count)>
+      exec_udf_batch_fn_;
 
   std::function<Status(ScalarUDF* udf, FunctionContext* ctx,
                        const std::vector<arrow::Array*>& inputs, arrow::ArrayBuilder* output,
@@ -207,8 +228,11 @@ class UDADefinition : public UDFDefinition {
     merge_fn_ = UDAWrapper<T>::Merge;
     finalize_arrow_fn_ = UDAWrapper<T>::FinalizeArrow;
     finalize_value_fn = UDAWrapper<T>::FinalizeValue;
+    serialize_fn_ = UDAWrapper<T>::Serialize;
+    deserialize_fn_ = UDAWrapper<T>::Deserialize;
 
     supports_partial_ = UDAWrapper<T>::SupportsPartial;
+    vectorized_kind_ = UDATraits<T>::VectorizedKind();
     return Status::OK();
   }
 
@@ -221,6 +245,7 @@ class UDADefinition : public UDFDefinition {
   types::DataType finalize_return_type() const { return finalize_return_type_; }
 
   bool supports_partial() const { return supports_partial_; }
+  VectorizedUDAKind vectorized_kind() const { return vectorized_kind_; }
 
   std::unique_ptr<UDA> Make() { return make_fn_(); }
 
@@ -246,12 +271,21 @@ class UDADefinition : public UDFDefinition {
     return finalize_arrow_fn_(uda, ctx, output);
   }
 
+  // Only supported when supports_partial() is true.
+  StatusOr<types::StringValue> Serialize(UDA* uda, FunctionContext* ctx) {
+    return serialize_fn_(uda, ctx);
+  }
+  Status Deserialize(UDA* uda, FunctionContext* ctx, const types::StringValue& data) {
+    return deserialize_fn_(uda, ctx, data);
+  }
+
  private:
   std::vector<types::DataType> init_arguments_;
   std::vector<types::DataType> update_arguments_;
   std::vector<types::DataType> registry_arguments_;
   types::DataType finalize_return_type_;
   bool supports_partial_;
+  VectorizedUDAKind vectorized_kind_ = VectorizedUDAKind::kNone;
 
   std::function<std::unique_ptr<UDA>()> make_fn_;
   std::function<Status(UDA* uda, FunctionContext* ctx,
@@ -270,6 +304,9 @@ class UDADefinition : public UDFDefinition {
   std::function<Status(UDA* uda, FunctionContext* ctx,
                        const std::vector<std::shared_ptr<types::BaseValueType>>& inputs)>
       init_wrapper_fn_;
+  std::function<StatusOr<types::StringValue>(UDA* uda, FunctionContext* ctx)> serialize_fn_;
+  std::function<Status(UDA* uda, FunctionContext* ctx, const types::StringValue& data)>
+      deserialize_fn_;
 };
 
 class UDTFDefinition : public UDFDefinition {
@@ -44,6 +44,18 @@ class SubStrUDF : public ScalarUDF {
   types::StringValue Exec(FunctionContext*, types::StringValue str) { return str.substr(1, 2); }
 };
 
+class MemoizedSubStrUDF : public ScalarUDF {
+ public:
+  static constexpr bool MemoizeExec() { return true; }
+
+  types::StringValue Exec(FunctionContext*, types::StringValue str) {
+    ++exec_count;
+    return str.substr(1, 2);
+  }
+
+  int exec_count = 0;
+};
+
 class AddUDF : public ScalarUDF {
  public:
   types::Int64Value Exec(FunctionContext*, types::Int64Value v1, types::Int64Value v2) {
@@ -51,6 +63,17 @@ class AddUDF : public ScalarUDF {
   }
 };
 
+class BatchAddUDF : public ScalarUDF {
+ public:
+  types::Float64Value Exec(FunctionContext*, types::Int64Value v1, types::Float64Value v2) {
+    return v1.val + v2.val;
+  }
+  void ExecBatch(FunctionContext*, size_t count, const types::Int64Value* v1,
+                 const types::Float64Value* v2, types::Float64Value* out) {
+    BinaryBatch<double>(count, v1, v2, out, [](auto x, auto y) { return x + y; });
+  }
+};
+
 class InitArgUDF : public ScalarUDF {
  public:
   Status Init(FunctionContext*, types::StringValue str, types::Int64Value i) {
@@ -99,6 +122,32 @@ TEST(UDFDefinition, two_args) {
   EXPECT_EQ(8, out[2].val);
 }
 
+TEST(UDFDefinition, exec_udf_batch) {
+  auto ctx = FunctionContext(nullptr, nullptr);
+  ScalarUDFDefinition add_def("add");
+  EXPECT_OK(add_def.Init<AddUDF>());
+  EXPECT_FALSE(add_def.has_exec_udf_batch());
+
+  ScalarUDFDefinition def("batch_add");
+  EXPECT_OK(def.Init<BatchAddUDF>());
+  ASSERT_TRUE(def.has_exec_udf_batch());
+
+  // Long enough to go through both the SIMD lanes and the tail of the batch.
+  types::Int64ValueColumnWrapper v1({1, 2, 3, 4, 5, 6, -7});
+  types::Float64ValueColumnWrapper v2({0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5});
+
+  types::Float64ValueColumnWrapper batch_out(v1.Size());
+  types::Float64ValueColumnWrapper out(v1.Size());
+  auto u = def.Make();
+  EXPECT_OK(def.ExecUDFBatch(u.get(), &ctx, {&v1, &v2}, &batch_out, v1.Size()));
+  EXPECT_OK(def.ExecBatch(u.get(), &ctx, {&v1, &v2}, &out, v1.Size()));
+  for (size_t i = 0; i < v1.Size(); ++i) {
+    EXPECT_EQ(out[i].val, batch_out[i].val);
+  }
+  EXPECT_EQ(1.5, batch_out[0].val);
+  EXPECT_EQ(-0.5, batch_out[6].val);
+}
+
 TEST(UDFDefinition, str_args) {
   auto ctx = FunctionContext(nullptr, nullptr);
   ScalarUDFDefinition def("substr");
@@ -115,6 +164,47 @@ TEST(UDFDefinition, str_args) {
   EXPECT_EQ("el", out[2]);
 }
 
+TEST(UDFDefinition, memoized_exec) {
+  auto ctx = FunctionContext(nullptr, nullptr);
+  ScalarUDFDefinition def("memoized_substr");
+  EXPECT_OK(def.Init<MemoizedSubStrUDF>());
+
+  types::StringValueColumnWrapper v1({"abcd", "abcd", "defg", "abcd", "defg", "hello"});
+
+  types::StringValueColumnWrapper out(v1.Size());
+  auto u = def.Make();
+  EXPECT_OK(def.ExecBatch(u.get(), &ctx, {&v1}, &out, v1.Size()));
+
+  EXPECT_EQ(3, static_cast<MemoizedSubStrUDF*>(u.get())->exec_count);
+  EXPECT_EQ("bc", out[0]);
+  EXPECT_EQ("bc", out[1]);
+  EXPECT_EQ("ef", out[2]);
+  EXPECT_EQ("bc", out[3]);
+  EXPECT_EQ("ef", out[4]);
+  EXPECT_EQ("el", out[5]);
+}
+
+TEST(UDFDefinition, memoized_exec_arrow) {
+  auto ctx = FunctionContext(nullptr, nullptr);
+  std::vector<types::StringValue> v1 = {"abcd", "defg", "defg", "abcd", "hello"};
+  auto v1a = ToArrow(v1, arrow::default_memory_pool());
+
+  auto output_builder = std::make_shared<arrow::StringBuilder>();
+  auto u = std::make_shared<MemoizedSubStrUDF>();
+  EXPECT_OK(ScalarUDFWrapper<MemoizedSubStrUDF>::ExecBatchArrow(u.get(), &ctx, {v1a.get()},
+                                                                output_builder.get(), 5));
+  EXPECT_EQ(3, u->exec_count);
+
+  std::shared_ptr<arrow::Array> res;
+  EXPECT_TRUE(output_builder->Finish(&res).ok());
+  auto* res_arr = static_cast<arrow::StringArray*>(res.get());
+  EXPECT_EQ("bc", res_arr->GetString(0));
+  EXPECT_EQ("ef", res_arr->GetString(1));
+  EXPECT_EQ("ef", res_arr->GetString(2));
+  EXPECT_EQ("bc", res_arr->GetString(3));
+  EXPECT_EQ("el", res_arr->GetString(4));
+}
+
 TEST(UDFDefinition, arrow_write) {
   auto ctx = FunctionContext(nullptr, nullptr);
   std::vector<types::Int64Value> v1 = {1, 2, 3};
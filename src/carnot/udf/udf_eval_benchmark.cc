@@ -31,11 +31,14 @@
 #include "src/shared/types/types.h"
 
 using px::Status;
+using px::carnot::udf::BinaryBatch;
 using px::carnot::udf::FunctionContext;
 using px::carnot::udf::ScalarUDF;
 using px::carnot::udf::ScalarUDFDefinition;
 using px::carnot::udf::ScalarUDFWrapper;
 using px::types::BaseValueType;
+using px::types::BoolValue;
+using px::types::BoolValueColumnWrapper;
 using px::types::Int64Value;
 using px::types::Int64ValueColumnWrapper;
 using px::types::StringValue;
@@ -57,6 +60,24 @@ class AddUDF : public ScalarUDF {
   Int64Value Exec(FunctionContext*, Int64Value v1, Int64Value v2) { return v1.val + v2.val; }
 };
 
+class BatchAddUDF : public ScalarUDF {
+ public:
+  Int64Value Exec(FunctionContext*, Int64Value v1, Int64Value v2) { return v1.val + v2.val; }
+  void ExecBatch(FunctionContext*, size_t count, const Int64Value* v1, const Int64Value* v2,
+                 Int64Value* out) {
+    BinaryBatch<int64_t>(count, v1, v2, out, [](auto x, auto y) { return x + y; });
+  }
+};
+
+class BatchGreaterThanUDF : public ScalarUDF {
+ public:
+  BoolValue Exec(FunctionContext*, Int64Value v1, Int64Value v2) { return v1 > v2; }
+  void ExecBatch(FunctionContext*, size_t count, const Int64Value* v1, const Int64Value* v2,
+                 BoolValue* out) {
+    BinaryBatch<int64_t>(count, v1, v2, out, [](auto x, auto y) { return x > y; });
+  }
+};
+
 class SubStrUDF : public ScalarUDF {
  public:
   StringValue Exec(FunctionContext*, StringValue v1) { return v1.substr(1, 2); }
@@ -96,6 +117,44 @@ static void BM_AddInt64Values(benchmark::State& state) {
   state.SetBytesProcessed(int64_t(state.iterations()) * 2 * vec1.size() * sizeof(int64_t));
 }
 
+// Compares calling Exec for every record (state.range(1) == 0) with a single call to ExecBatch
+// (state.range(1) == 1), for a UDF that implements both.
+template <typename TUDF, typename TOutputWrapper>
+// NOLINTNEXTLINE : runtime/references.
+static void BM_ExecBatchVsExec(benchmark::State& state) {
+  auto vec1 = CreateLargeData<Int64Value>(state.range(0));
+  auto vec2 = CreateLargeData<Int64Value>(state.range(0));
+  bool exec_batch = state.range(1);
+  TOutputWrapper out(vec2.size());
+  auto wrapped_vec1 = Int64ValueColumnWrapper(vec1);
+  auto wrapped_vec2 = Int64ValueColumnWrapper(vec2);
+
+  ScalarUDFDefinition def("udf");
+  PX_CHECK_OK(def.template Init<TUDF>());
+  CHECK(def.has_exec_udf_batch());
+  auto u = def.Make();
+
+  // NOLINTNEXTLINE : clang-analyzer-deadcode.DeadStores.
+  for (auto _ : state) {
+    if (exec_batch) {
+      PX_CHECK_OK(
+          def.ExecUDFBatch(u.get(), nullptr, {&wrapped_vec1, &wrapped_vec2}, &out, vec1.size()));
+    } else {
+      PX_CHECK_OK(
+          def.ExecBatch(u.get(), nullptr, {&wrapped_vec1, &wrapped_vec2}, &out, vec1.size()));
+    }
+    benchmark::DoNotOptimize(out);
+  }
+
+  // Check results.
+  TUDF udf;
+  for (size_t idx = 0; idx < vec2.size(); ++idx) {
+    CHECK(udf.Exec(nullptr, vec1[idx], vec2[idx]).val == out[idx].val);
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * 2 * vec1.size() * sizeof(int64_t));
+}
+
 // This benchmark performs a substring on 10 char wide strings,
 // selects two characters.
 // NOLINTNEXTLINE : runtime/references.
@@ -247,6 +306,14 @@ static void BM_SubStrArrow(benchmark::State& state) {
 BENCHMARK(BM_AddInt64ValueToArrow)->RangeMultiplier(2)->Range(1, 1 << 16);
 BENCHMARK(BM_AddTwoInt64sArrow)->RangeMultiplier(2)->Range(1, 1 << 16);
 BENCHMARK(BM_AddInt64Values)->RangeMultiplier(2)->Range(1, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ExecBatchVsExec, BatchAddUDF, Int64ValueColumnWrapper)
+    ->ArgNames({"size", "exec_batch"})
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 1 << 16}, {0, 1}});
+BENCHMARK_TEMPLATE(BM_ExecBatchVsExec, BatchGreaterThanUDF, BoolValueColumnWrapper)
+    ->ArgNames({"size", "exec_batch"})
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 1 << 16}, {0, 1}});
 
 BENCHMARK(BM_ConvertToArrowString)->RangeMultiplier(2)->Range(1, 1 << 16);
 BENCHMARK(BM_ConvertToArrowInt64)->RangeMultiplier(2)->Range(1, 1 << 16);
@@ -51,6 +51,24 @@ TEST(ScalarUDF, basic_tests) {
   EXPECT_TRUE(ScalarUDFTraits<ScalarUDF1WithInit>::HasInit());
 }
 
+template <typename TArg>
+class TemplateBatchUDF : ScalarUDF {
+ public:
+  TArg Exec(FunctionContext*, TArg b1) { return b1; }
+  void ExecBatch(FunctionContext*, size_t count, const TArg* b1, TArg* out) {
+    // Only compiles for the types that the batch kernels support.
+    UnaryBatch<SIMDNative<TArg>>(count, b1, out, [](auto x) { return x; });
+  }
+};
+
+TEST(ScalarUDF, exec_batch_tests) {
+  EXPECT_FALSE(ScalarUDFTraits<ScalarUDF1>::HasExecBatch());
+  EXPECT_TRUE(ScalarUDFTraits<TemplateBatchUDF<types::Int64Value>>::HasExecBatch());
+  EXPECT_TRUE(ScalarUDFTraits<TemplateBatchUDF<types::Float64Value>>::HasExecBatch());
+  EXPECT_FALSE(ScalarUDFTraits<TemplateBatchUDF<types::StringValue>>::HasExecBatch());
+  EXPECT_FALSE(ScalarUDFTraits<TemplateBatchUDF<types::UInt128Value>>::HasExecBatch());
+}
+
 TEST(UDFDataTypes, valid_tests) {
   EXPECT_TRUE((true == types::IsValidValueType<types::BoolValue>::value));
   EXPECT_TRUE((true == types::IsValidValueType<types::Int64Value>::value));
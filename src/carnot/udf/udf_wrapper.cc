@@ -0,0 +1,24 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "src/carnot/udf/udf_wrapper.h"
+
+DEFINE_bool(carnot_udf_memoize_exec, gflags::BoolFromEnv("PL_CARNOT_UDF_MEMOIZE_EXEC", true),
+            "Call Exec only once per distinct argument value of a batch for scalar UDFs that "
+            "declare MemoizeExec().");
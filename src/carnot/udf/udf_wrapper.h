@@ -20,8 +20,10 @@
 
 #include <arrow/array.h>
 
+#include <absl/container/flat_hash_map.h>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "src/carnot/udf/udf.h"
@@ -30,6 +32,8 @@
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/column_wrapper.h"
 
+DECLARE_bool(carnot_udf_memoize_exec);
+
 namespace px {
 namespace carnot {
 namespace udf {
@@ -48,6 +52,68 @@ constexpr auto CastToUDFValueType(const types::BaseValueType* arg) {
   // return static_cast<types::Int64Value*>(arg);
   return static_cast<const typename types::DataTypeTraits<TExecArgType>::value_type*>(arg);
 }
+
+// The key that the results of a memoized UDF are cached by. Strings are referenced in place, so
+// the cache must not outlive the input batch.
+template <types::DataType TArgType>
+struct MemoKey {
+  using type = typename types::DataTypeTraits<TArgType>::native_type;
+
+  static type FromValue(const typename types::DataTypeTraits<TArgType>::value_type& v) {
+    return v.val;
+  }
+  static type FromArrow(const arrow::Array* arr, int64_t idx) {
+    return types::GetValueFromArrowArray<TArgType>(arr, idx);
+  }
+};
+
+template <>
+struct MemoKey<types::STRING> {
+  using type = std::string_view;
+
+  static type FromValue(const types::StringValue& v) { return v; }
+  static type FromArrow(const arrow::Array* arr, int64_t idx) {
+    return types::GetStringViewFromArrowArray(arr, idx);
+  }
+};
+
+/**
+ * Calls a single argument UDF once per distinct argument value in the batch, and calls fn(idx,
+ * result) for every record with the result of its argument. The argument is read from base_arg,
+ * or from arrow_arg if base_arg is null. Runs of equal values are checked first since they are
+ * common in columns like UPIDs, and don't need a hash lookup.
+ */
+template <typename TUDF, typename TFn>
+void MemoizedExecLoop(TUDF* udf, FunctionContext* ctx, size_t count,
+                      const types::BaseValueType* base_arg, const arrow::Array* arrow_arg, TFn fn) {
+  constexpr types::DataType arg_type = ScalarUDFTraits<TUDF>::ExecArguments()[0];
+  using Key = MemoKey<arg_type>;
+  const auto* arg = CastToUDFValueType<arg_type>(base_arg);
+  using ResultType = decltype(udf->Exec(ctx, arg[0]));
+
+  std::vector<ResultType> results;
+  absl::flat_hash_map<typename Key::type, size_t> result_idx_by_key;
+  typename Key::type prev_key{};
+  size_t prev_result_idx = 0;
+  for (size_t idx = 0; idx < count; ++idx) {
+    auto key = arg != nullptr ? Key::FromValue(arg[idx]) : Key::FromArrow(arrow_arg, idx);
+    if (idx == 0 || !(key == prev_key)) {
+      auto [it, inserted] = result_idx_by_key.try_emplace(key, results.size());
+      if (inserted) {
+        if (arg != nullptr) {
+          results.push_back(udf->Exec(ctx, arg[idx]));
+        } else {
+          results.push_back(
+              udf->Exec(ctx, types::GetValueFromArrowArray<arg_type>(arrow_arg, idx)));
+        }
+      }
+      prev_key = key;
+      prev_result_idx = it->second;
+    }
+    fn(idx, results[prev_result_idx]);
+  }
+}
+
 /**
  * This is the inner wrapper which expands the arguments an performs type casts
  * based on the type and arity of the input arguments.
@@ -62,12 +128,34 @@ Status ExecWrapper(TUDF* udf, FunctionContext* ctx, size_t count, TOutput* out,
                    const std::vector<const types::BaseValueType*>& args,
                    std::index_sequence<I...>) {
   [[maybe_unused]] constexpr auto exec_argument_types = ScalarUDFTraits<TUDF>::ExecArguments();
+  if constexpr (ScalarUDFTraits<TUDF>::HasMemoizedExec()) {
+    if (FLAGS_carnot_udf_memoize_exec) {
+      MemoizedExecLoop(udf, ctx, count, args[0], nullptr,
+                       [out](size_t idx, const auto& res) { out[idx] = res; });
+      return Status::OK();
+    }
+  }
   for (size_t idx = 0; idx < count; ++idx) {
     out[idx] = udf->Exec(ctx, CastToUDFValueType<exec_argument_types[I]>(args[I])[idx]...);
   }
   return Status::OK();
 }
 
+/**
+ * This is the inner wrapper for UDFs that implement ExecBatch. It casts the inputs
+ * the same way as ExecWrapper, but makes a single call for the whole batch.
+ *
+ * @return Status of execution.
+ */
+template <typename TUDF, typename TOutput, std::size_t... I>
+Status ExecBatchWrapper(TUDF* udf, FunctionContext* ctx, size_t count, TOutput* out,
+                        const std::vector<const types::BaseValueType*>& args,
+                        std::index_sequence<I...>) {
+  [[maybe_unused]] constexpr auto exec_argument_types = ScalarUDFTraits<TUDF>::ExecArguments();
+  udf->ExecBatch(ctx, count, CastToUDFValueType<exec_argument_types[I]>(args[I])..., out);
+  return Status::OK();
+}
+
 template <typename TUDF, std::size_t... I>
 Status InitWrapper(TUDF* udf, FunctionContext* ctx,
                    const std::vector<std::shared_ptr<types::BaseValueType>>& args,
@@ -113,6 +201,27 @@ Status ExecWrapperArrow(TUDF* udf, FunctionContext* ctx, size_t count, TOutput*
   if constexpr (std::is_same_v<arrow::StringBuilder, TOutput>) {
     CHECK(out->ReserveData(reserved).ok());
   }
+  if constexpr (ScalarUDFTraits<TUDF>::HasMemoizedExec()) {
+    if (FLAGS_carnot_udf_memoize_exec) {
+      // The cached results are appended as is, without copying them for every record.
+      arrow::Status s;
+      MemoizedExecLoop(udf, ctx, count, nullptr, args[0], [&](size_t, const auto& res) {
+        if constexpr (std::is_same_v<arrow::StringBuilder, TOutput>) {
+          total_size += res.size();
+          while (s.ok() && total_size >= reserved) {
+            reserved *= 2;
+            s = out->ReserveData(reserved);
+          }
+          if (s.ok()) {
+            out->UnsafeAppend(res);
+          }
+        } else {
+          out->UnsafeAppend(UnWrap(res));
+        }
+      });
+      return StatusAdapter(s);
+    }
+  }
   for (size_t idx = 0; idx < count; ++idx) {
     auto res = UnWrap(
         udf->Exec(ctx, types::GetValueFromArrowArray<exec_argument_types[I]>(args[I], idx)...));
@@ -246,6 +355,32 @@ struct ScalarUDFWrapper {
                              std::make_index_sequence<exec_argument_types.size()>{});
   }
 
+  /**
+   * Same as ExecBatch, but calls the UDF's ExecBatch function once for the whole batch instead of
+   * calling Exec for every record. Must only be used if ScalarUDFTraits<TUDF>::HasExecBatch().
+   */
+  static Status ExecUDFBatch(ScalarUDF* udf, FunctionContext* ctx,
+                             const std::vector<const types::ColumnWrapper*>& inputs,
+                             types::ColumnWrapper* output, int count) {
+    if constexpr (ScalarUDFTraits<TUDF>::HasExecBatch()) {
+      DCHECK(output != nullptr);
+      DCHECK(inputs.size() == ScalarUDFTraits<TUDF>::ExecArguments().size());
+
+      constexpr types::DataType return_type = ScalarUDFTraits<TUDF>::ReturnType();
+      auto exec_argument_types = ScalarUDFTraits<TUDF>::ExecArguments();
+      DCHECK(CheckTypes(inputs, exec_argument_types));
+      auto input_as_base_value = ConvertToBaseValue(inputs);
+
+      using output_type = typename types::DataTypeTraits<return_type>::value_type;
+      auto* casted_output = static_cast<output_type*>(output->UnsafeRawData());
+      return ExecBatchWrapper<TUDF>(static_cast<TUDF*>(udf), ctx, count, casted_output,
+                                    input_as_base_value,
+                                    std::make_index_sequence<exec_argument_types.size()>{});
+    } else {
+      return error::Unimplemented("UDF does not implement ExecBatch");
+    }
+  }
+
   /**
    * Call the UDF's init method.
    *
@@ -435,6 +570,37 @@ struct UDAWrapper {
     *casted_output = casted_uda->Finalize(ctx);
     return Status::OK();
   }
+
+  /**
+   * Serializes the partial aggregate of the UDA, if it supports partial aggregates.
+   * @return The serialized partial aggregate.
+   */
+  static StatusOr<types::StringValue> Serialize(UDA* uda, FunctionContext* ctx) {
+    if constexpr (SupportsPartial) {
+      return static_cast<TUDA*>(uda)->Serialize(ctx);
+    } else {
+      PX_UNUSED(uda);
+      PX_UNUSED(ctx);
+      return error::Unimplemented("UDA '$0' doesn't support partial aggregates",
+                                  typeid(TUDA).name());
+    }
+  }
+
+  /**
+   * Replaces the state of the UDA with a partial aggregate made by Serialize().
+   * @return Status of the Deserialize.
+   */
+  static Status Deserialize(UDA* uda, FunctionContext* ctx, const types::StringValue& data) {
+    if constexpr (SupportsPartial) {
+      return static_cast<TUDA*>(uda)->Deserialize(ctx, data);
+    } else {
+      PX_UNUSED(uda);
+      PX_UNUSED(ctx);
+      PX_UNUSED(data);
+      return error::Unimplemented("UDA '$0' doesn't support partial aggregates",
+                                  typeid(TUDA).name());
+    }
+  }
 };
 
 /**
@@ -16,8 +16,15 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
 #include <fstream>
-#include <limits>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -32,6 +39,13 @@
 #include "src/common/system/proc_parser.h"
 #include "src/common/system/proc_pid_path.h"
 
+DEFINE_int32(proc_stats_scanner_max_open_pids,
+             gflags::Int32FromEnv("PL_PROC_STATS_SCANNER_MAX_OPEN_PIDS", 1024),
+             "The number of PIDs whose /proc stat, io and net/dev files are kept open between "
+             "scans of the process and network stats, i.e. up to 3 fds per PID. It is capped so "
+             "that these files use at most a quarter of RLIMIT_NOFILE. 0 (or less) opens the "
+             "files on every read.");
+
 namespace px {
 namespace system {
 
@@ -96,8 +110,60 @@ constexpr int kProcStatStartTimeField = 21;
 constexpr int kProcStatVSizeField = 22;
 constexpr int kProcStatRSSField = 23;
 
+namespace {
+
+// Splits the next line off the front of contents, without its newline. Returns false at the end of
+// contents.
+bool NextLine(std::string_view* contents, std::string_view* line) {
+  if (contents->empty()) {
+    return false;
+  }
+  size_t end = contents->find('\n');
+  if (end == std::string_view::npos) {
+    *line = *contents;
+    *contents = {};
+  } else {
+    *line = contents->substr(0, end);
+    contents->remove_prefix(end + 1);
+  }
+  return true;
+}
+
+// Splits line at runs of spaces, like absl::StrSplit(line, " ", absl::SkipWhitespace()) but without
+// allocating. Fields past the end of fields are counted but not stored. Returns the number of
+// fields.
+size_t SplitFields(std::string_view line, absl::Span<std::string_view> fields) {
+  size_t num_fields = 0;
+  size_t pos = 0;
+  while ((pos = line.find_first_not_of(' ', pos)) != std::string_view::npos) {
+    size_t end = std::min(line.find(' ', pos), line.size());
+    if (num_fields < fields.size()) {
+      fields[num_fields] = line.substr(pos, end - pos);
+    }
+    ++num_fields;
+    pos = end;
+  }
+  return num_fields;
+}
+
+// The fields of /proc/<pid>/io that are parsed into ProcessStats.
+const absl::flat_hash_map<std::string_view, size_t>& ProcessIOFieldOffsets() {
+  // Just to be safe when using offsetof, make sure object is standard layout.
+  static_assert(std::is_standard_layout<ProcParser::ProcessStats>::value);
+
+  static const absl::flat_hash_map<std::string_view, size_t> field_name_to_offset_map{
+      {"rchar", offsetof(ProcParser::ProcessStats, rchar_bytes)},
+      {"wchar", offsetof(ProcParser::ProcessStats, wchar_bytes)},
+      {"read_bytes", offsetof(ProcParser::ProcessStats, read_bytes)},
+      {"write_bytes", offsetof(ProcParser::ProcessStats, write_bytes)},
+  };
+  return field_name_to_offset_map;
+}
+
+}  // namespace
+
 Status ProcParser::ParseNetworkStatAccumulateIFaceData(
-    const std::vector<std::string_view>& dev_stat_record, NetworkStats* out) {
+    absl::Span<const std::string_view> dev_stat_record, NetworkStats* out) {
   DCHECK(out != nullptr);
 
   int64_t val;
@@ -161,36 +227,31 @@ Status ProcParser::ParseProcPIDNetDev(int32_t pid, NetworkStats* out) const {
   DCHECK(out != nullptr);
 
   const auto fpath = ProcPidPath(pid, "net", "dev");
-  std::ifstream ifs;
-  ifs.open(fpath);
-  if (!ifs) {
-    return error::Internal("Failed to open file: $0.", fpath.string());
-  }
+  PX_ASSIGN_OR_RETURN(std::string contents, ReadFileToString(fpath));
+  return ParseProcPIDNetDevContents(contents, out);
+}
 
+Status ProcParser::ParseProcPIDNetDevContents(std::string_view contents, NetworkStats* out) {
   // Ignore the first two lines since they are just headers;
   const int kHeaderLines = 2;
+  std::string_view line;
   for (int i = 0; i < kHeaderLines; ++i) {
-    ifs.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    NextLine(&contents, &line);
   }
 
-  std::string line;
-  while (std::getline(ifs, line)) {
-    std::vector<std::string_view> split = absl::StrSplit(line, " ", absl::SkipWhitespace());
+  std::array<std::string_view, kProcNetDevNumFields> fields;
+  while (NextLine(&contents, &line)) {
     // We check less than in case more fields are added later.
-    if (split.size() < kProcNetDevNumFields) {
+    if (SplitFields(line, absl::MakeSpan(fields)) < kProcNetDevNumFields) {
       return error::Internal("failed to parse net dev file, incorrect number of fields");
     }
 
-    if (!ShouldIncludeNetIFace(split[kProcNetDevIFaceField])) {
+    if (!ShouldIncludeNetIFace(fields[kProcNetDevIFaceField])) {
       continue;
     }
 
     // We should track this interface. Accumulate the results.
-    auto s = ParseNetworkStatAccumulateIFaceData(split, out);
-    if (!s.ok()) {
-      // Empty out the stats so we don't leave intermediate results.
-      return s;
-    }
+    PX_RETURN_IF_ERROR(ParseNetworkStatAccumulateIFaceData(fields, out));
   }
 
   return Status::OK();
@@ -215,52 +276,65 @@ Status ProcParser::ParseProcPIDStat(int32_t pid, int64_t page_size_bytes,
   }
 
   std::string line;
-  bool ok = true;
-  if (std::getline(ifs, line)) {
-    std::vector<std::string_view> split = absl::StrSplit(line, " ", absl::SkipWhitespace());
-    // We check less than in case more fields are added later.
-    if (split.size() < kProcStatNumFields) {
-      return error::Unknown("Incorrect number of fields in stat file: $0.", fpath.string());
-    }
+  if (!std::getline(ifs, line)) {
+    return error::Internal("Failed to read proc stat file: $0.", fpath.string());
+  }
 
-    // The name is surrounded by (). We remove it first.
-    size_t open_paren_idx = line.find_first_of('(');
-    size_t close_paren_idx = line.find_last_of(')');
-    if (open_paren_idx == std::string::npos || close_paren_idx == std::string::npos) {
-      return error::Internal("Invalid command name in file $0.", fpath.string());
-    }
-    out->process_name = line.substr(open_paren_idx + 1, close_paren_idx - open_paren_idx - 1);
+  Status s = ParseProcPIDStatContents(line, page_size_bytes, kernel_tick_time_ns, out);
+  if (!s.ok()) {
+    return Status(s.code(), absl::Substitute("$0 File: $1.", s.msg(), fpath.string()));
+  }
+  return Status::OK();
+}
 
-    // When split_size > kProcStatNumFields, there are spaces in the command we need to handle.
-    // command_offset adjusts index for the number of spaces in the command field.
-    int command_offset = std::count(out->process_name.begin(), out->process_name.end(), ' ');
+Status ProcParser::ParseProcPIDStatContents(std::string_view contents, int64_t page_size_bytes,
+                                            int64_t kernel_tick_time_ns, ProcessStats* out) {
+  std::string_view line;
+  NextLine(&contents, &line);
 
-    ok &= absl::SimpleAtoi(split[kProcStatPIDField], &out->pid);
+  // The name is surrounded by (), and may itself contain spaces and parentheses.
+  size_t open_paren_idx = line.find_first_of('(');
+  size_t close_paren_idx = line.find_last_of(')');
+  if (open_paren_idx == std::string_view::npos || close_paren_idx == std::string_view::npos ||
+      close_paren_idx < open_paren_idx) {
+    return error::Internal("Invalid command name in stat file.");
+  }
+  out->process_name.assign(
+      line.substr(open_paren_idx + 1, close_paren_idx - open_paren_idx - 1));
+
+  // The name counts as a single field, whatever it contains.
+  std::array<std::string_view, kProcStatNumFields> fields;
+  fields[kProcStatPIDField] = absl::StripAsciiWhitespace(line.substr(0, open_paren_idx));
+  size_t num_fields = 2 + SplitFields(line.substr(close_paren_idx + 1),
+                                      absl::MakeSpan(fields).subspan(kProcStatPIDField + 2));
+  // We check less than in case more fields are added later.
+  if (num_fields < kProcStatNumFields) {
+    return error::Unknown("Incorrect number of fields in stat file.");
+  }
 
-    ok &= absl::SimpleAtoi(split[kProcStatMinorFaultsField + command_offset], &out->minor_faults);
-    ok &= absl::SimpleAtoi(split[kProcStatMajorFaultsField + command_offset], &out->major_faults);
+  bool ok = true;
+  ok &= absl::SimpleAtoi(fields[kProcStatPIDField], &out->pid);
 
-    ok &= absl::SimpleAtoi(split[kProcStatUTimeField + command_offset], &out->utime_ns);
-    ok &= absl::SimpleAtoi(split[kProcStatKTimeField + command_offset], &out->ktime_ns);
-    // The kernel tracks utime and ktime in kernel ticks.
-    out->utime_ns *= kernel_tick_time_ns;
-    out->ktime_ns *= kernel_tick_time_ns;
+  ok &= absl::SimpleAtoi(fields[kProcStatMinorFaultsField], &out->minor_faults);
+  ok &= absl::SimpleAtoi(fields[kProcStatMajorFaultsField], &out->major_faults);
 
-    ok &= absl::SimpleAtoi(split[kProcStatNumThreadsField + command_offset], &out->num_threads);
-    ok &= absl::SimpleAtoi(split[kProcStatVSizeField + command_offset], &out->vsize_bytes);
-    ok &= absl::SimpleAtoi(std::string(split[kProcStatRSSField + command_offset]), &out->rss_bytes);
+  ok &= absl::SimpleAtoi(fields[kProcStatUTimeField], &out->utime_ns);
+  ok &= absl::SimpleAtoi(fields[kProcStatKTimeField], &out->ktime_ns);
+  // The kernel tracks utime and ktime in kernel ticks.
+  out->utime_ns *= kernel_tick_time_ns;
+  out->ktime_ns *= kernel_tick_time_ns;
 
-    // RSS is in pages.
-    out->rss_bytes *= page_size_bytes;
+  ok &= absl::SimpleAtoi(fields[kProcStatNumThreadsField], &out->num_threads);
+  ok &= absl::SimpleAtoi(fields[kProcStatVSizeField], &out->vsize_bytes);
+  ok &= absl::SimpleAtoi(fields[kProcStatRSSField], &out->rss_bytes);
 
-  } else {
-    return error::Internal("Failed to read proc stat file: $0.", fpath.string());
-  }
+  // RSS is in pages.
+  out->rss_bytes *= page_size_bytes;
 
   if (!ok) {
     // This should never happen since it requires the file to be ill-formed
     // by the kernel.
-    return error::Internal("Failed to parse stat file: $0. ATOI failed.", fpath.string());
+    return error::Internal("Failed to parse stat file. ATOI failed.");
   }
   return Status::OK();
 }
@@ -278,18 +352,7 @@ Status ProcParser::ParseProcPIDStatIO(int32_t pid, ProcessStats* out) const {
    */
   DCHECK(out != nullptr);
   const auto fpath = ProcPidPath(pid, "io");
-
-  // Just to be safe when using offsetof, make sure object is standard layout.
-  static_assert(std::is_standard_layout<ProcessStats>::value);
-
-  static absl::flat_hash_map<std::string_view, size_t> field_name_to_offset_map{
-      {"rchar", offsetof(ProcessStats, rchar_bytes)},
-      {"wchar", offsetof(ProcessStats, wchar_bytes)},
-      {"read_bytes", offsetof(ProcessStats, read_bytes)},
-      {"write_bytes", offsetof(ProcessStats, write_bytes)},
-  };
-
-  return ParseFromKeyValueFile(fpath, field_name_to_offset_map, reinterpret_cast<uint8_t*>(out));
+  return ParseFromKeyValueFile(fpath, ProcessIOFieldOffsets(), reinterpret_cast<uint8_t*>(out));
 }
 
 Status ProcParser::ParseProcStat(SystemStats* out) const {
@@ -536,39 +599,54 @@ Status ProcParser::ParseProcPIDSMaps(int32_t pid, std::vector<ProcessSMaps>* out
 }
 
 void ProcParser::ParseFromKeyValueLine(
-    const std::string& line,
+    std::string_view line,
     const absl::flat_hash_map<std::string_view, size_t>& field_name_to_value_map,
     uint8_t* out_base) {
-  std::vector<std::string_view> split = absl::StrSplit(line, ':', absl::SkipWhitespace());
-  if (split.size() >= 2) {
-    const auto& key = split[0];
-    const auto& val = split[1];
-
-    const auto& it = field_name_to_value_map.find(key);
-    // Key not found in map, we can just go to next iteration of loop.
-    if (it == field_name_to_value_map.end()) {
-      return;
-    }
+  // The same as splitting at ':' and skipping whitespace-only pieces, but without allocating.
+  size_t colon_idx = line.find(':');
+  if (colon_idx == std::string_view::npos) {
+    return;
+  }
+  std::string_view key = line.substr(0, colon_idx);
+  std::string_view val = line.substr(colon_idx + 1);
+  val = val.substr(0, val.find(':'));
+  if (absl::StripAsciiWhitespace(key).empty() || absl::StripAsciiWhitespace(val).empty()) {
+    return;
+  }
 
-    size_t offset = it->second;
-    auto val_ptr = reinterpret_cast<int64_t*>(out_base + offset);
+  const auto& it = field_name_to_value_map.find(key);
+  // Key not found in map, we can just go to next iteration of loop.
+  if (it == field_name_to_value_map.end()) {
+    return;
+  }
 
-    bool ok = false;
-    if (absl::EndsWith(val, " kB")) {
-      // Convert kB to bytes. proc seems to only use kB as the unit if it's present
-      // else there are no units.
-      const std::string_view trimmed_val = absl::StripSuffix(val, " kB");
-      ok = absl::SimpleAtoi(trimmed_val, val_ptr);
-      *val_ptr *= 1024;
-    } else {
-      ok = absl::SimpleAtoi(val, val_ptr);
-    }
+  size_t offset = it->second;
+  auto val_ptr = reinterpret_cast<int64_t*>(out_base + offset);
 
-    if (!ok) {
-      *val_ptr = -1;
-    }
+  bool ok = false;
+  if (absl::EndsWith(val, " kB")) {
+    // Convert kB to bytes. proc seems to only use kB as the unit if it's present
+    // else there are no units.
+    const std::string_view trimmed_val = absl::StripSuffix(val, " kB");
+    ok = absl::SimpleAtoi(trimmed_val, val_ptr);
+    *val_ptr *= 1024;
+  } else {
+    ok = absl::SimpleAtoi(val, val_ptr);
+  }
+
+  if (!ok) {
+    *val_ptr = -1;
+  }
+}
+
+void ProcParser::ParseFromKeyValueContents(
+    std::string_view contents,
+    const absl::flat_hash_map<std::string_view, size_t>& field_name_to_value_map,
+    uint8_t* out_base) {
+  std::string_view line;
+  while (NextLine(&contents, &line)) {
+    ParseFromKeyValueLine(line, field_name_to_value_map, out_base);
   }
-  return;
 }
 
 Status ProcParser::ParseFromKeyValueFile(
@@ -842,5 +920,176 @@ StatusOr<ProcParser::ProcessSMaps> ProcParser::GetExecutableMapEntry(pid_t pid,
   return error::NotFound(absl::Substitute("Could not find maps entry for $0", libpath));
 }
 
+/*************************************************
+ * ProcStatsScanner
+ *************************************************/
+
+namespace {
+
+// The initial size of the buffer that files are read into. It grows to fit the largest file.
+constexpr size_t kInitialReadBufferSize = 4096;
+
+// Reads the whole file with pread() into buf, growing buf as needed. Returns the size of the file,
+// or -1 with errno set. The /proc files are seq_files, which only return fewer bytes than
+// requested at the end of the file, so a file that fits in buf is read with a single call.
+ssize_t PReadAll(int fd, std::string* buf) {
+  if (buf->empty()) {
+    buf->resize(kInitialReadBufferSize);
+  }
+  size_t size = 0;
+  while (true) {
+    ssize_t n = pread(fd, buf->data() + size, buf->size() - size, size);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    size += n;
+    if (size < buf->size()) {
+      return size;
+    }
+    buf->resize(2 * buf->size());
+  }
+}
+
+// The most files a PID keeps open: stat, io and net/dev.
+constexpr size_t kMaxFilesPerPID = 3;
+
+// Caps max_open_pids so that the files kept open for the PIDs take at most a quarter of the fd
+// limit of the process.
+size_t CapMaxOpenPIDs(int32_t max_open_pids) {
+  if (max_open_pids <= 0) {
+    return 0;
+  }
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY) {
+    return max_open_pids;
+  }
+  const size_t fd_budget = limit.rlim_cur / 4;
+  return std::min(static_cast<size_t>(max_open_pids), fd_budget / kMaxFilesPerPID);
+}
+
+}  // namespace
+
+ProcStatsScanner::ProcStatsScanner(int64_t page_size_bytes, int64_t kernel_tick_time_ns,
+                                   int32_t max_open_pids)
+    : page_size_bytes_(page_size_bytes),
+      kernel_tick_time_ns_(kernel_tick_time_ns),
+      max_open_pids_(CapMaxOpenPIDs(max_open_pids)) {}
+
+ProcStatsScanner::~ProcStatsScanner() {
+  for (auto& [pid, files] : pid_files_) {
+    PX_UNUSED(pid);
+    ClosePIDFiles(&files);
+  }
+}
+
+Status ProcStatsScanner::ReadProcessStats(int32_t pid, ProcParser::ProcessStats* out) {
+  DCHECK(out != nullptr);
+  PIDFiles* files = GetPIDFiles(pid);
+  Status s = ReadProcessStatsFiles(pid, files, out);
+  ReleasePIDFiles(files);
+  return s;
+}
+
+Status ProcStatsScanner::ReadProcessStatsFiles(int32_t pid, PIDFiles* files,
+                                               ProcParser::ProcessStats* out) {
+  PX_ASSIGN_OR_RETURN(std::string_view stat_contents, ReadFile(pid, "stat", &files->stat_fd));
+  if (files->has_stat && stat_contents == files->stat_contents) {
+    ++num_unchanged_stat_reads_;
+  } else {
+    files->has_stat = false;
+    PX_RETURN_IF_ERROR(ProcParser::ParseProcPIDStatContents(stat_contents, page_size_bytes_,
+                                                            kernel_tick_time_ns_, &files->stat));
+    files->stat_contents.assign(stat_contents);
+    files->has_stat = true;
+  }
+  *out = files->stat;
+
+  // The io counters can change without the stat file changing, so they are always parsed.
+  PX_ASSIGN_OR_RETURN(std::string_view io_contents, ReadFile(pid, "io", &files->io_fd));
+  ProcParser::ParseFromKeyValueContents(io_contents, ProcessIOFieldOffsets(),
+                                        reinterpret_cast<uint8_t*>(out));
+  return Status::OK();
+}
+
+Status ProcStatsScanner::ReadNetworkStats(int32_t pid, ProcParser::NetworkStats* out) {
+  DCHECK(out != nullptr);
+  PIDFiles* files = GetPIDFiles(pid);
+  StatusOr<std::string_view> contents = ReadFile(pid, "net/dev", &files->net_dev_fd);
+  Status s = contents.ok() ? ProcParser::ParseProcPIDNetDevContents(contents.ValueOrDie(), out)
+                           : contents.status();
+  ReleasePIDFiles(files);
+  return s;
+}
+
+void ProcStatsScanner::EndScan() {
+  for (auto it = pid_files_.begin(); it != pid_files_.end();) {
+    if (it->second.last_scan != scan_) {
+      ClosePIDFiles(&it->second);
+      pid_files_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  ++scan_;
+}
+
+ProcStatsScanner::PIDFiles* ProcStatsScanner::GetPIDFiles(int32_t pid) {
+  auto it = pid_files_.find(pid);
+  if (it == pid_files_.end()) {
+    if (pid_files_.size() >= max_open_pids_) {
+      return &transient_files_;
+    }
+    it = pid_files_.try_emplace(pid).first;
+  }
+  it->second.last_scan = scan_;
+  return &it->second;
+}
+
+void ProcStatsScanner::ReleasePIDFiles(PIDFiles* files) {
+  if (files == &transient_files_) {
+    ClosePIDFiles(files);
+    // The next transient read is probably for a different PID.
+    files->has_stat = false;
+  }
+}
+
+void ProcStatsScanner::ClosePIDFiles(PIDFiles* files) {
+  for (int* fd : {&files->stat_fd, &files->io_fd, &files->net_dev_fd}) {
+    if (*fd >= 0) {
+      close(*fd);
+      *fd = -1;
+    }
+  }
+}
+
+StatusOr<std::string_view> ProcStatsScanner::ReadFile(int32_t pid, const char* name, int* fd) {
+  // A file that was already open is reopened once if reading it fails, since the PID may have been
+  // reused by a new process since it was opened.
+  for (bool was_open = *fd >= 0;; was_open = false) {
+    if (*fd < 0) {
+      const auto fpath = ProcPidPath(pid, name);
+      *fd = open(fpath.c_str(), O_RDONLY | O_CLOEXEC);
+      if (*fd < 0) {
+        return error::Internal("Failed to open file $0: $1.", fpath.string(), std::strerror(errno));
+      }
+    }
+
+    ssize_t size = PReadAll(*fd, &buf_);
+    if (size >= 0) {
+      return std::string_view(buf_.data(), size);
+    }
+    int read_errno = errno;
+    close(*fd);
+    *fd = -1;
+    if (!was_open) {
+      return error::Internal("Failed to read file $0: $1.", ProcPidPath(pid, name).string(),
+                             std::strerror(read_errno));
+    }
+  }
+}
+
 }  // namespace system
 }  // namespace px
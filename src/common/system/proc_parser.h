@@ -28,9 +28,12 @@
 
 #include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
+#include <absl/types/span.h>
 #include "src/common/base/base.h"
 #include "src/common/system/system.h"
 
+DECLARE_int32(proc_stats_scanner_max_open_pids);
+
 namespace px {
 namespace system {
 
@@ -366,11 +369,22 @@ class ProcParser {
   StatusOr<ProcessSMaps> GetExecutableMapEntry(pid_t pid, std::string libpath, uint64_t vmem_start);
 
  private:
+  friend class ProcStatsScanner;
+
   static Status ParseNetworkStatAccumulateIFaceData(
-      const std::vector<std::string_view>& dev_stat_record, NetworkStats* out);
+      absl::Span<const std::string_view> dev_stat_record, NetworkStats* out);
+
+  // Parse the contents of the files without allocating, other than for the process name.
+  static Status ParseProcPIDStatContents(std::string_view contents, int64_t page_size_bytes,
+                                         int64_t kernel_tick_time_ns, ProcessStats* out);
+  static Status ParseProcPIDNetDevContents(std::string_view contents, NetworkStats* out);
+  static void ParseFromKeyValueContents(
+      std::string_view contents,
+      const absl::flat_hash_map<std::string_view, size_t>& field_name_to_value_map,
+      uint8_t* out_base);
 
   static void ParseFromKeyValueLine(
-      const std::string& line,
+      std::string_view line,
       const absl::flat_hash_map<std::string_view, size_t>& field_name_to_value_map,
       uint8_t* out_base);
 
@@ -382,6 +396,95 @@ class ProcParser {
   Status ParseProcMapsFile(int32_t pid, std::string filename, std::vector<ProcessSMaps>* out) const;
 };
 
+/**
+ * ProcStatsScanner reads the /proc files that are sampled for every process on every iteration of
+ * the stats connectors: /proc/<pid>/stat, /proc/<pid>/io and /proc/<pid>/net/dev. The results are
+ * the same as those of the corresponding ProcParser functions.
+ *
+ * Unlike ProcParser, it keeps the files of the PIDs it reads open, re-reads them with pread() into
+ * reused buffers and parses them in place, so that once warmed up a scan does no path lookups or
+ * allocations. If the stat file of a PID hasn't changed since it was last read, its previous parse
+ * is reused.
+ *
+ * A scan is the reads between two calls to EndScan(), which closes the files of the PIDs that
+ * weren't read during the scan. The files of at most max_open_pids PIDs are kept open; the files
+ * of other PIDs are opened and closed on every read. A PID keeps up to 3 fds open, and
+ * max_open_pids is capped so that they take at most a quarter of RLIMIT_NOFILE; 0 or less keeps no
+ * files open. Not thread-safe.
+ */
+class ProcStatsScanner {
+ public:
+  ProcStatsScanner(int64_t page_size_bytes, int64_t kernel_tick_time_ns,
+                   int32_t max_open_pids = FLAGS_proc_stats_scanner_max_open_pids);
+  ~ProcStatsScanner();
+
+  ProcStatsScanner(const ProcStatsScanner&) = delete;
+  ProcStatsScanner& operator=(const ProcStatsScanner&) = delete;
+
+  /**
+   * Reads /proc/<pid>/stat and /proc/<pid>/io, like ProcParser::ParseProcPIDStat() followed by
+   * ProcParser::ParseProcPIDStatIO().
+   */
+  Status ReadProcessStats(int32_t pid, ProcParser::ProcessStats* out);
+
+  /**
+   * Reads /proc/<pid>/net/dev, like ProcParser::ParseProcPIDNetDev().
+   */
+  Status ReadNetworkStats(int32_t pid, ProcParser::NetworkStats* out);
+
+  /**
+   * Closes the files of the PIDs that were not read since the previous call.
+   */
+  void EndScan();
+
+  /**
+   * @return the number of PIDs whose files are kept open.
+   */
+  size_t num_open_pids() const { return pid_files_.size(); }
+
+  /**
+   * @return the number of stat reads that reused the previous parse.
+   */
+  int64_t num_unchanged_stat_reads() const { return num_unchanged_stat_reads_; }
+
+ private:
+  struct PIDFiles {
+    int stat_fd = -1;
+    int io_fd = -1;
+    int net_dev_fd = -1;
+
+    // The contents of the stat file when it was last read, and their parse.
+    bool has_stat = false;
+    std::string stat_contents;
+    ProcParser::ProcessStats stat;
+
+    uint64_t last_scan = 0;
+  };
+
+  // Returns the files of the PID, which are only valid until the next call. If the files can't be
+  // kept open, returns files which must be released with ReleasePIDFiles().
+  PIDFiles* GetPIDFiles(int32_t pid);
+  void ReleasePIDFiles(PIDFiles* files);
+  static void ClosePIDFiles(PIDFiles* files);
+
+  // Reads /proc/<pid>/<name> through *fd into buf_, opening it if *fd isn't open.
+  StatusOr<std::string_view> ReadFile(int32_t pid, const char* name, int* fd);
+
+  Status ReadProcessStatsFiles(int32_t pid, PIDFiles* files, ProcParser::ProcessStats* out);
+
+  const int64_t page_size_bytes_;
+  const int64_t kernel_tick_time_ns_;
+  const size_t max_open_pids_;
+
+  absl::flat_hash_map<int32_t, PIDFiles> pid_files_;
+  // The files of a PID that doesn't fit in pid_files_.
+  PIDFiles transient_files_;
+  std::string buf_;
+
+  uint64_t scan_ = 1;
+  int64_t num_unchanged_stat_reads_ = 0;
+};
+
 // TODO(jps): Change to GetPIDStartTimeTicks(const pid_t pid), i.e. remove the version that
 // uses a filesystem path as an arg.
 StatusOr<int64_t> GetPIDStartTimeTicks(const std::filesystem::path& proc_pid_path);
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <absl/strings/numbers.h>
+
+#include "src/common/base/base.h"
+#include "src/common/system/proc_parser.h"
+#include "src/common/system/proc_pid_path.h"
+#include "src/common/testing/test_environment.h"
+
+using px::system::ProcParser;
+using px::system::ProcStatsScanner;
+
+// All benchmarks take whether to use ProcStatsScanner instead of ProcParser as their first
+// argument, and report the time per PID read.
+
+constexpr int64_t kPageSizeBytes = 4096;
+constexpr int64_t kKernelTickTimeNS = 10'000'000;
+
+// The PIDs in the proc directory.
+std::vector<int32_t> ListPIDs(const std::filesystem::path& proc_path) {
+  std::vector<int32_t> pids;
+  for (const auto& entry : std::filesystem::directory_iterator(proc_path)) {
+    int32_t pid;
+    if (absl::SimpleAtoi(entry.path().filename().string(), &pid)) {
+      pids.push_back(pid);
+    }
+  }
+  return pids;
+}
+
+void ReadProcessStats(benchmark::State& state, const std::vector<int32_t>& pids) {  // NOLINT
+  bool use_scanner = state.range(0);
+  ProcParser parser;
+  ProcStatsScanner scanner(kPageSizeBytes, kKernelTickTimeNS);
+  for (auto _ : state) {
+    for (int32_t pid : pids) {
+      ProcParser::ProcessStats stats;
+      px::Status s;
+      if (use_scanner) {
+        s = scanner.ReadProcessStats(pid, &stats);
+      } else {
+        s = parser.ParseProcPIDStat(pid, kPageSizeBytes, kKernelTickTimeNS, &stats);
+        if (s.ok()) {
+          s = parser.ParseProcPIDStatIO(pid, &stats);
+        }
+      }
+      benchmark::DoNotOptimize(s);
+      benchmark::DoNotOptimize(stats);
+    }
+    scanner.EndScan();
+  }
+  state.counters["time_per_pid"] =
+      benchmark::Counter(pids.size(), benchmark::Counter::kIsIterationInvariantRate |
+                                          benchmark::Counter::kInvert);
+}
+
+// NOLINTNEXTLINE(runtime/references)
+static void BM_FixtureProcessStats(benchmark::State& state) {
+  PX_SET_FOR_SCOPE(FLAGS_proc_path,
+                   px::testing::BazelRunfilePath("src/common/system/testdata/proc").string());
+  ReadProcessStats(state, {123});
+}
+
+// Reads the stats of all the processes on the host, like ProcessStatsConnector does.
+// NOLINTNEXTLINE(runtime/references)
+static void BM_HostProcessStats(benchmark::State& state) {
+  ReadProcessStats(state, ListPIDs(FLAGS_proc_path));
+}
+
+// NOLINTNEXTLINE(runtime/references)
+static void BM_FixtureNetworkStats(benchmark::State& state) {
+  PX_SET_FOR_SCOPE(FLAGS_proc_path,
+                   px::testing::BazelRunfilePath("src/common/system/testdata/proc").string());
+  bool use_scanner = state.range(0);
+  ProcParser parser;
+  ProcStatsScanner scanner(kPageSizeBytes, kKernelTickTimeNS);
+  for (auto _ : state) {
+    ProcParser::NetworkStats stats;
+    if (use_scanner) {
+      PX_CHECK_OK(scanner.ReadNetworkStats(123, &stats));
+    } else {
+      PX_CHECK_OK(parser.ParseProcPIDNetDev(123, &stats));
+    }
+    benchmark::DoNotOptimize(stats);
+    scanner.EndScan();
+  }
+  state.counters["time_per_pid"] = benchmark::Counter(
+      1, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+BENCHMARK(BM_FixtureProcessStats)->Arg(false)->Arg(true);
+BENCHMARK(BM_HostProcessStats)->Arg(false)->Arg(true);
+BENCHMARK(BM_FixtureNetworkStats)->Arg(false)->Arg(true);
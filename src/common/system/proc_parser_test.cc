@@ -26,7 +26,10 @@
 #include <memory>
 #include <sstream>
 
+#include <absl/strings/str_replace.h>
+
 #include "src/common/fs/fs_wrapper.h"
+#include "src/common/testing/temp_dir.h"
 #include "src/common/testing/test_environment.h"
 #include "src/common/testing/testing.h"
 
@@ -391,6 +394,112 @@ TEST_F(ProcParserTest, GetExecutableMapEntry) {
   }
 }
 
+TEST_F(ProcParserTest, ScannerReadProcessStats) {
+  PX_SET_FOR_SCOPE(FLAGS_proc_path, GetPathToTestDataFile("testdata/proc"));
+  ProcStatsScanner scanner(bytes_per_page_, kernel_tick_time_ns_, /*max_open_pids*/ 10);
+
+  ProcParser::ProcessStats expected;
+  ASSERT_OK(parser_->ParseProcPIDStat(123, bytes_per_page_, kernel_tick_time_ns_, &expected));
+  ASSERT_OK(parser_->ParseProcPIDStatIO(123, &expected));
+
+  for (int i = 0; i < 3; ++i) {
+    ProcParser::ProcessStats stats;
+    ASSERT_OK(scanner.ReadProcessStats(123, &stats));
+    EXPECT_EQ(expected.pid, stats.pid);
+    EXPECT_EQ(expected.process_name, stats.process_name);
+    EXPECT_EQ(expected.minor_faults, stats.minor_faults);
+    EXPECT_EQ(expected.major_faults, stats.major_faults);
+    EXPECT_EQ(expected.utime_ns, stats.utime_ns);
+    EXPECT_EQ(expected.ktime_ns, stats.ktime_ns);
+    EXPECT_EQ(expected.num_threads, stats.num_threads);
+    EXPECT_EQ(expected.vsize_bytes, stats.vsize_bytes);
+    EXPECT_EQ(expected.rss_bytes, stats.rss_bytes);
+    EXPECT_EQ(expected.rchar_bytes, stats.rchar_bytes);
+    EXPECT_EQ(expected.wchar_bytes, stats.wchar_bytes);
+    EXPECT_EQ(expected.read_bytes, stats.read_bytes);
+    EXPECT_EQ(expected.write_bytes, stats.write_bytes);
+    scanner.EndScan();
+  }
+  EXPECT_EQ(1U, scanner.num_open_pids());
+  // The stat file doesn't change, so only the first read parses it.
+  EXPECT_EQ(2, scanner.num_unchanged_stat_reads());
+
+  // PIDs that are not read during a scan are closed.
+  scanner.EndScan();
+  EXPECT_EQ(0U, scanner.num_open_pids());
+
+  ProcParser::ProcessStats stats;
+  EXPECT_NOT_OK(scanner.ReadProcessStats(999, &stats));
+}
+
+TEST_F(ProcParserTest, ScannerReadNetworkStats) {
+  PX_SET_FOR_SCOPE(FLAGS_proc_path, GetPathToTestDataFile("testdata/proc"));
+  ProcStatsScanner scanner(bytes_per_page_, kernel_tick_time_ns_, /*max_open_pids*/ 0);
+
+  ProcParser::NetworkStats expected;
+  ASSERT_OK(parser_->ParseProcPIDNetDev(123, &expected));
+
+  for (int i = 0; i < 2; ++i) {
+    ProcParser::NetworkStats stats;
+    ASSERT_OK(scanner.ReadNetworkStats(123, &stats));
+    EXPECT_EQ(expected.rx_bytes, stats.rx_bytes);
+    EXPECT_EQ(expected.rx_packets, stats.rx_packets);
+    EXPECT_EQ(expected.rx_drops, stats.rx_drops);
+    EXPECT_EQ(expected.rx_errs, stats.rx_errs);
+    EXPECT_EQ(expected.tx_bytes, stats.tx_bytes);
+    EXPECT_EQ(expected.tx_packets, stats.tx_packets);
+    EXPECT_EQ(expected.tx_drops, stats.tx_drops);
+    EXPECT_EQ(expected.tx_errs, stats.tx_errs);
+    // With max_open_pids = 0, no files are kept open.
+    EXPECT_EQ(0U, scanner.num_open_pids());
+    scanner.EndScan();
+  }
+}
+
+TEST_F(ProcParserTest, ScannerNegativeMaxOpenPIDs) {
+  PX_SET_FOR_SCOPE(FLAGS_proc_path, GetPathToTestDataFile("testdata/proc"));
+  ProcStatsScanner scanner(bytes_per_page_, kernel_tick_time_ns_, /*max_open_pids*/ -1);
+
+  ProcParser::NetworkStats stats;
+  ASSERT_OK(scanner.ReadNetworkStats(123, &stats));
+  // A negative max_open_pids keeps no files open, like 0.
+  EXPECT_EQ(0U, scanner.num_open_pids());
+}
+
+TEST_F(ProcParserTest, ScannerRereadsChangedFiles) {
+  testing::TempDir proc_dir;
+  PX_SET_FOR_SCOPE(FLAGS_proc_path, proc_dir.path().string());
+  const std::filesystem::path pid_dir = proc_dir.path() / "42";
+  ASSERT_TRUE(std::filesystem::create_directory(pid_dir));
+
+  ASSERT_OK_AND_ASSIGN(std::string stat,
+                       ReadFileToString(GetPathToTestDataFile("testdata/proc/123/stat")));
+  ASSERT_OK(WriteFileFromString(pid_dir / "stat", stat));
+  ASSERT_OK(WriteFileFromString(pid_dir / "io", "rchar: 10\nwchar: 20\n"));
+
+  ProcStatsScanner scanner(bytes_per_page_, kernel_tick_time_ns_, /*max_open_pids*/ 10);
+  ProcParser::ProcessStats stats;
+  ASSERT_OK(scanner.ReadProcessStats(42, &stats));
+  EXPECT_EQ(800, stats.utime_ns);
+  EXPECT_EQ(10, stats.rchar_bytes);
+
+  // Rewrite the files in place, so that the open files see the new contents.
+  ASSERT_OK(
+      WriteFileFromString(pid_dir / "stat", absl::StrReplaceAll(stat, {{" 8 23 ", " 9 23 "}})));
+  ASSERT_OK(WriteFileFromString(pid_dir / "io", "rchar: 11\nwchar: 20\n"));
+  ASSERT_OK(scanner.ReadProcessStats(42, &stats));
+  EXPECT_EQ(900, stats.utime_ns);
+  EXPECT_EQ(11, stats.rchar_bytes);
+  EXPECT_EQ(0, scanner.num_unchanged_stat_reads());
+
+  // Only the io file changed.
+  ASSERT_OK(WriteFileFromString(pid_dir / "io", "rchar: 12\nwchar: 20\n"));
+  ASSERT_OK(scanner.ReadProcessStats(42, &stats));
+  EXPECT_EQ(900, stats.utime_ns);
+  EXPECT_EQ(12, stats.rchar_bytes);
+  EXPECT_EQ(1, scanner.num_unchanged_stat_reads());
+}
+
 // Check ProcParser can detect itself.
 TEST(ProcParserGetExePathTest, CheckTestProcess) {
   // Since bazel prepares test files as symlinks, creating testdata/proc/123/exe symlink would
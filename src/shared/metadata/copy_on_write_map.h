@@ -0,0 +1,246 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include <absl/container/flat_hash_map.h>
+
+namespace px {
+namespace md {
+
+/**
+ * CopyOnWriteMap is a hash map whose copies share their entries until they are modified.
+ *
+ * The entries are spread over kNumShards shards by the top bits of their hash. Copying the map only
+ * copies the shard pointers, and the first write to a shard that is shared with another copy
+ * copies that one shard. Applying an update to a copy of a large map therefore costs a copy of
+ * 1/kNumShards of the map instead of a copy of all of it, while the other copies keep seeing the
+ * entries as they were.
+ *
+ * Values are copied along with their shard, so large values should be held in a shared_ptr and be
+ * copied before being modified (see MutableSharedValue below).
+ *
+ * A map must not be modified concurrently with anything else, but its copies can be read and
+ * destroyed from other threads while it is modified.
+ */
+template <typename K, typename V, typename Hash = typename absl::flat_hash_map<K, V>::hasher,
+          typename Eq = typename absl::flat_hash_map<K, V, Hash>::key_equal>
+class CopyOnWriteMap {
+  using Shard = absl::flat_hash_map<K, V, Hash, Eq>;
+  static constexpr int kShardBits = 6;
+  static constexpr size_t kNumShards = size_t{1} << kShardBits;
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = typename Shard::value_type;
+  using size_type = size_t;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename Shard::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() = default;
+
+    reference operator*() const { return *it_; }
+    pointer operator->() const { return &*it_; }
+
+    const_iterator& operator++() {
+      ++it_;
+      if (it_ == map_->shards_[shard_]->end()) {
+        ++shard_;
+        SeekNonEmptyShard();
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b) {
+      return a.shard_ == b.shard_ && (a.shard_ == kNumShards || a.it_ == b.it_);
+    }
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) { return !(a == b); }
+
+   private:
+    friend class CopyOnWriteMap;
+
+    const_iterator(const CopyOnWriteMap* map, size_t shard) : map_(map), shard_(shard) {}
+    const_iterator(const CopyOnWriteMap* map, size_t shard, typename Shard::const_iterator it)
+        : map_(map), shard_(shard), it_(it) {}
+
+    // Points the iterator at the first entry of the first non-empty shard at or after shard_.
+    void SeekNonEmptyShard() {
+      for (; shard_ < kNumShards; ++shard_) {
+        const auto& shard = map_->shards_[shard_];
+        if (shard != nullptr && !shard->empty()) {
+          it_ = shard->begin();
+          return;
+        }
+      }
+    }
+
+    const CopyOnWriteMap* map_ = nullptr;
+    size_t shard_ = kNumShards;
+    typename Shard::const_iterator it_;
+  };
+  using iterator = const_iterator;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const_iterator begin() const {
+    const_iterator it(this, 0);
+    it.SeekNonEmptyShard();
+    return it;
+  }
+  const_iterator end() const { return const_iterator(this, kNumShards); }
+
+  template <typename KeyArg>
+  const_iterator find(const KeyArg& key) const {
+    size_t idx = ShardIndex(key);
+    const auto& shard = shards_[idx];
+    if (shard == nullptr) {
+      return end();
+    }
+    auto it = shard->find(key);
+    if (it == shard->end()) {
+      return end();
+    }
+    return const_iterator(this, idx, it);
+  }
+
+  template <typename KeyArg>
+  bool contains(const KeyArg& key) const {
+    const auto& shard = shards_[ShardIndex(key)];
+    return shard != nullptr && shard->contains(key);
+  }
+
+  /**
+   * Returns a pointer to the value of the key that can be modified without affecting the copies of
+   * the map, or nullptr if the key is not in the map. The pointer is valid until the next
+   * modification of the map.
+   */
+  template <typename KeyArg>
+  V* FindMutable(const KeyArg& key) {
+    size_t idx = ShardIndex(key);
+    if (shards_[idx] == nullptr || !shards_[idx]->contains(key)) {
+      return nullptr;
+    }
+    return &MutableShard(idx)->find(key)->second;
+  }
+
+  V& operator[](const K& key) { return *try_emplace(key).first; }
+
+  /**
+   * Inserts a value constructed from args for the key if the key is not in the map. Returns a
+   * pointer to the value of the key, valid until the next modification of the map, along with
+   * whether the value was inserted.
+   */
+  template <typename... Args>
+  std::pair<V*, bool> try_emplace(const K& key, Args&&... args) {
+    auto [it, inserted] =
+        MutableShard(ShardIndex(key))->try_emplace(key, std::forward<Args>(args)...);
+    if (inserted) {
+      ++size_;
+    }
+    return {&it->second, inserted};
+  }
+
+  /**
+   * Sets the value of the key. Leaves the shard shared if the key already has that value.
+   */
+  void insert_or_assign(const K& key, V value) {
+    auto it = find(key);
+    if (it != end() && it->second == value) {
+      return;
+    }
+    (*this)[key] = std::move(value);
+  }
+
+  size_t erase(const K& key) {
+    size_t idx = ShardIndex(key);
+    if (shards_[idx] == nullptr || !shards_[idx]->contains(key)) {
+      return 0;
+    }
+    MutableShard(idx)->erase(key);
+    --size_;
+    return 1;
+  }
+
+  void clear() {
+    shards_ = {};
+    size_ = 0;
+  }
+
+ private:
+  template <typename KeyArg>
+  static size_t ShardIndex(const KeyArg& key) {
+    return Hash{}(key) >> (std::numeric_limits<size_t>::digits - kShardBits);
+  }
+
+  Shard* MutableShard(size_t idx) {
+    auto& shard = shards_[idx];
+    if (shard == nullptr) {
+      shard = std::make_shared<Shard>();
+    } else if (shard.use_count() > 1) {
+      shard = std::make_shared<Shard>(*shard);
+    } else {
+      // Other copies may have just released the shard. Make sure that their reads happen before
+      // our writes.
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return shard.get();
+  }
+
+  std::array<std::shared_ptr<Shard>, kNumShards> shards_;
+  size_t size_ = 0;
+};
+
+/**
+ * Returns a pointer through which the value held by the shared_ptr can be modified. The value is
+ * replaced with a clone first if the shared_ptr is shared, for instance with a copy of a
+ * CopyOnWriteMap.
+ */
+template <typename T>
+T* MutableSharedValue(std::shared_ptr<T>* value) {
+  if (value->use_count() > 1) {
+    *value = (*value)->Clone();
+  } else {
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  return value->get();
+}
+
+}  // namespace md
+}  // namespace px
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include <absl/strings/str_cat.h>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/metadata/copy_on_write_map.h"
+
+namespace px {
+namespace md {
+
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+TEST(CopyOnWriteMapTest, Basic) {
+  CopyOnWriteMap<std::string, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+
+  map["a"] = 1;
+  EXPECT_TRUE(map.try_emplace("b", 2).second);
+  EXPECT_FALSE(map.try_emplace("b", 3).second);
+  map.insert_or_assign("c", 3);
+
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_THAT(map, UnorderedElementsAre(Pair("a", 1), Pair("b", 2), Pair("c", 3)));
+
+  // Heterogeneous lookups.
+  std::string_view key = "b";
+  ASSERT_NE(map.find(key), map.end());
+  EXPECT_EQ(map.find(key)->second, 2);
+  EXPECT_TRUE(map.contains(key));
+  EXPECT_EQ(map.find(std::string_view("d")), map.end());
+
+  *map.FindMutable(key) = 4;
+  EXPECT_EQ(map.FindMutable(std::string_view("d")), nullptr);
+
+  EXPECT_EQ(map.erase("a"), 1);
+  EXPECT_EQ(map.erase("a"), 0);
+  EXPECT_THAT(map, UnorderedElementsAre(Pair("b", 4), Pair("c", 3)));
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(CopyOnWriteMapTest, CopiesAreIndependent) {
+  constexpr int kNumEntries = 1000;
+
+  CopyOnWriteMap<std::string, int> map;
+  for (int i = 0; i < kNumEntries; ++i) {
+    map[absl::StrCat("key", i)] = i;
+  }
+
+  CopyOnWriteMap<std::string, int> copy = map;
+  copy["key0"] = -1;
+  copy.erase("key1");
+  copy["new_key"] = 0;
+  map["key2"] = -2;
+
+  EXPECT_EQ(map.size(), kNumEntries);
+  EXPECT_EQ(copy.size(), kNumEntries);
+
+  EXPECT_EQ(map.find("key0")->second, 0);
+  EXPECT_EQ(copy.find("key0")->second, -1);
+  EXPECT_TRUE(map.contains("key1"));
+  EXPECT_FALSE(copy.contains("key1"));
+  EXPECT_FALSE(map.contains("new_key"));
+  EXPECT_TRUE(copy.contains("new_key"));
+  EXPECT_EQ(map.find("key2")->second, -2);
+  EXPECT_EQ(copy.find("key2")->second, 2);
+
+  int num_entries = 0;
+  for (const auto& [k, v] : map) {
+    EXPECT_EQ(copy.contains(k), k != "key1");
+    ++num_entries;
+  }
+  EXPECT_EQ(num_entries, kNumEntries);
+}
+
+struct Value {
+  explicit Value(int v) : v(v) {}
+  std::unique_ptr<Value> Clone() const { return std::make_unique<Value>(v); }
+  int v;
+};
+
+TEST(CopyOnWriteMapTest, MutableSharedValue) {
+  CopyOnWriteMap<int, std::shared_ptr<Value>> map;
+  map[1] = std::make_shared<Value>(1);
+  map[2] = std::make_shared<Value>(2);
+  const Value* value1 = map.find(1)->second.get();
+
+  // Not shared, so modified in place.
+  MutableSharedValue(map.FindMutable(1))->v = 10;
+  EXPECT_EQ(map.find(1)->second.get(), value1);
+
+  auto copy = map;
+  MutableSharedValue(copy.FindMutable(1))->v = 20;
+
+  EXPECT_EQ(map.find(1)->second.get(), value1);
+  EXPECT_EQ(map.find(1)->second->v, 10);
+  EXPECT_NE(copy.find(1)->second.get(), value1);
+  EXPECT_EQ(copy.find(1)->second->v, 20);
+
+  // Values that were not modified are still shared.
+  EXPECT_EQ(map.find(2)->second, copy.find(2)->second);
+}
+
+}  // namespace md
+}  // namespace px
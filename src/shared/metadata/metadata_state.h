@@ -29,6 +29,7 @@
 
 #include "src/common/base/base.h"
 #include "src/shared/k8s/metadatapb/metadata.pb.h"
+#include "src/shared/metadata/copy_on_write_map.h"
 #include "src/shared/metadata/k8s_objects.h"
 #include "src/shared/metadata/pids.h"
 #include "src/shared/upid/upid.h"
@@ -41,8 +42,15 @@ using ContainerInfoUPtr = std::unique_ptr<ContainerInfo>;
 using PIDInfoUPtr = std::unique_ptr<PIDInfo>;
 using AgentID = sole::uuid;
 
+// Objects are shared between the metadata states that were cloned from each other, and are only
+// copied when they are modified (see CopyOnWriteMap).
+using PIDInfoMap = CopyOnWriteMap<UPID, std::shared_ptr<PIDInfo>>;
+
 /**
  * This class contains all kubernetes relate metadata.
+ *
+ * Clones share all of their objects and only copy the parts of the maps and the objects that are
+ * modified afterwards, so that applying an update to a clone of a large state is cheap.
  */
 class K8sMetadataState : NotCopyable {
  public:
@@ -95,16 +103,17 @@ class K8sMetadataState : NotCopyable {
     };
   };
   using K8sEntityByNameMap =
-      absl::flat_hash_map<K8sNameIdent, UID, K8sIdentHashEq::Hash, K8sIdentHashEq::Eq>;
+      CopyOnWriteMap<K8sNameIdent, UID, K8sIdentHashEq::Hash, K8sIdentHashEq::Eq>;
 
   using PodsByNameMap = K8sEntityByNameMap;
   using ServicesByNameMap = K8sEntityByNameMap;
   using ReplicaSetByNameMap = K8sEntityByNameMap;
   using DeploymentByNameMap = K8sEntityByNameMap;
   using NamespacesByNameMap = K8sEntityByNameMap;
-  using ContainersByNameMap = absl::flat_hash_map<std::string, CID>;
-  using PodsByPodIpMap = absl::flat_hash_map<std::string, UID>;
-  using ServicesByServiceIpMap = absl::flat_hash_map<std::string, UID>;
+  using ContainersByNameMap = CopyOnWriteMap<std::string, CID>;
+  using PodsByPodIpMap = CopyOnWriteMap<std::string, UID>;
+  using ServicesByServiceIpMap = CopyOnWriteMap<std::string, UID>;
+  using ContainersByIDMap = CopyOnWriteMap<CID, std::shared_ptr<ContainerInfo>>;
 
   void set_service_cidr(CIDRBlock cidr) {
     if (!service_cidr_.has_value() || service_cidr_.value() != cidr) {
@@ -156,6 +165,14 @@ class K8sMetadataState : NotCopyable {
    */
   const ContainerInfo* ContainerInfoByID(CIDView id) const;
 
+  /**
+   * MutableContainerInfoByID returns the container info by ID, to be modified. The container info
+   * is copied first if it is shared with a clone of this state.
+   * @param id The ID of the container.
+   * @return ContainerInfo or nullptr if not found.
+   */
+  ContainerInfo* MutableContainerInfoByID(CIDView id);
+
   /**
    * ContainerIDByName returns the ContainerID for the container of the given name.
    * @param container_name the container name
@@ -253,11 +270,12 @@ class K8sMetadataState : NotCopyable {
 
   Status CleanupExpiredMetadata(int64_t retention_time_ns);
 
-  absl::flat_hash_map<CID, ContainerInfoUPtr>& containers_by_id() { return containers_by_id_; }
+  const ContainersByIDMap& containers_by_id() const { return containers_by_id_; }
   std::string DebugString(int indent_level = 0) const;
 
  private:
   const K8sMetadataObject* K8sMetadataObjectByID(UIDView id, K8sObjectType type) const;
+  K8sMetadataObject* MutableK8sMetadataObjectByID(UIDView id);
 
   // The CIDR block used for services inside the cluster.
   std::optional<CIDRBlock> service_cidr_;
@@ -266,10 +284,10 @@ class K8sMetadataState : NotCopyable {
   std::vector<CIDRBlock> pod_cidrs_;
 
   // This stores K8s native objects (services, pods, etc).
-  absl::flat_hash_map<UID, K8sMetadataObjectUPtr> k8s_objects_by_id_;
+  CopyOnWriteMap<UID, std::shared_ptr<K8sMetadataObject>> k8s_objects_by_id_;
 
   // This stores container objects, complementing k8s_objects_by_id_.
-  absl::flat_hash_map<CID, ContainerInfoUPtr> containers_by_id_;
+  ContainersByIDMap containers_by_id_;
 
   /**
    * Mapping of pods by name.
@@ -351,7 +369,7 @@ class AgentMetadataState : NotCopyable {
 
   std::shared_ptr<AgentMetadataState> CloneToShared() const;
 
-  PIDInfo* GetPIDByUPID(UPID upid) const {
+  const PIDInfo* GetPIDByUPID(UPID upid) const {
     auto it = pids_by_upid_.find(upid);
     if (it != pids_by_upid_.end()) {
       return it->second.get();
@@ -368,16 +386,16 @@ class AgentMetadataState : NotCopyable {
   }
 
   void MarkUPIDAsStopped(UPID upid, int64_t ts) {
-    auto* pid_info = GetPIDByUPID(upid);
+    auto* pid_info = pids_by_upid_.FindMutable(upid);
     if (pid_info != nullptr) {
-      pid_info->set_stop_time_ns(ts);
+      MutableSharedValue(pid_info)->set_stop_time_ns(ts);
       upids_.erase(upid);
     } else {
       DCHECK(!upids_.contains(upid));
     }
   }
 
-  const absl::flat_hash_map<UPID, PIDInfoUPtr>& pids_by_upid() const { return pids_by_upid_; }
+  const PIDInfoMap& pids_by_upid() const { return pids_by_upid_; }
 
   const absl::flat_hash_set<md::UPID>& upids() const { return upids_; }
 
@@ -411,7 +429,7 @@ class AgentMetadataState : NotCopyable {
   /**
    * Mapping of PIDs by UPID for active pods on the system.
    */
-  absl::flat_hash_map<UPID, PIDInfoUPtr> pids_by_upid_;
+  PIDInfoMap pids_by_upid_;
 
   /**
    * All active UPIDs. Unlike pids_by_upid_, this does not contain stopped pids.
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include <absl/strings/substitute.h>
+
+#include "src/common/base/base.h"
+#include "src/common/system/proc_parser.h"
+#include "src/shared/metadata/metadata_state.h"
+
+using px::md::AgentMetadataState;
+using px::md::CID;
+using px::md::K8sMetadataState;
+using px::md::PIDInfo;
+using px::md::UPID;
+
+// Number of pod updates and of PIDs started and stopped per epoch, ie. between two snapshots.
+constexpr int kUpdatesPerEpoch = 10;
+constexpr int kNumSnapshots = 10;
+
+K8sMetadataState::PodUpdate PodUpdate(int i, int64_t ts) {
+  K8sMetadataState::PodUpdate update;
+  update.set_uid(absl::Substitute("pod$0_uid", i));
+  update.set_name(absl::Substitute("pod$0", i));
+  update.set_namespace_(absl::Substitute("ns$0", i % 100));
+  update.add_container_ids(absl::Substitute("container$0_uid", i));
+  update.add_container_names(absl::Substitute("container$0", i));
+  update.set_pod_ip(absl::Substitute("10.$0.$1.$2", i >> 16, (i >> 8) & 0xff, i & 0xff));
+  update.set_host_ip("192.168.0.1");
+  update.set_start_timestamp_ns(ts);
+  update.set_labels(R"({"app":"benchmark","tier":"backend"})");
+  return update;
+}
+
+K8sMetadataState::ContainerUpdate ContainerUpdate(int i, int64_t ts) {
+  K8sMetadataState::ContainerUpdate update;
+  update.set_cid(absl::Substitute("container$0_uid", i));
+  update.set_name(absl::Substitute("container$0", i));
+  update.set_pod_id(absl::Substitute("pod$0_uid", i));
+  update.set_start_timestamp_ns(ts);
+  return update;
+}
+
+void AddUPID(AgentMetadataState* md, int i) {
+  UPID upid(md->asid(), i, i);
+  md->AddUPID(upid, std::make_unique<PIDInfo>(upid, "/usr/bin/server", "server --port=8080",
+                                              CID(absl::Substitute("container$0_uid", i))));
+}
+
+// A state with num_objects pods, each with one container running one process.
+std::shared_ptr<AgentMetadataState> MakeState(int num_objects) {
+  auto md = std::make_shared<AgentMetadataState>(/* asid */ 1, /* pid */ 1);
+  for (int i = 0; i < num_objects; ++i) {
+    PX_CHECK_OK(md->k8s_metadata_state()->HandleContainerUpdate(ContainerUpdate(i, 1)));
+    PX_CHECK_OK(md->k8s_metadata_state()->HandlePodUpdate(PodUpdate(i, 1)));
+    AddUPID(md.get(), i);
+  }
+  return md;
+}
+
+// Does what AgentMetadataStateManager does for every epoch: clones the current state and applies
+// a few pod updates and process starts/stops to the clone.
+std::shared_ptr<AgentMetadataState> ApplyEpoch(const AgentMetadataState& current, int num_objects,
+                                               int epoch) {
+  auto next = current.CloneToShared();
+  for (int j = 0; j < kUpdatesPerEpoch; ++j) {
+    int i = (epoch * kUpdatesPerEpoch + j) % num_objects;
+    PX_CHECK_OK(next->k8s_metadata_state()->HandlePodUpdate(PodUpdate(i, epoch + 2)));
+    next->MarkUPIDAsStopped(UPID(next->asid(), i, i), epoch + 2);
+    AddUPID(next.get(), num_objects + epoch * kUpdatesPerEpoch + j);
+  }
+  next->set_epoch_id(epoch + 1);
+  return next;
+}
+
+int64_t RssAnonBytes() {
+  const px::system::ProcParser proc_parser;
+  px::system::ProcParser::ProcessStatus status;
+  PX_CHECK_OK(proc_parser.ParseProcPIDStatus(getpid(), &status));
+  return status.rss_anon_bytes;
+}
+
+// Latency of applying an epoch of updates to a state of range(0) objects. The previous state is
+// released once the next one is ready, as the state manager does.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_ApplyUpdate(benchmark::State& state) {
+  const int num_objects = state.range(0);
+  std::shared_ptr<AgentMetadataState> md = MakeState(num_objects);
+
+  int epoch = 0;
+  for (auto _ : state) {
+    md = ApplyEpoch(*md, num_objects, epoch++);
+    benchmark::DoNotOptimize(md);
+  }
+  state.counters["objects"] = num_objects;
+}
+
+// Memory used by each snapshot of a state of range(0) objects, while kNumSnapshots successive
+// snapshots are held, like the states held by queries that run while the metadata is updated.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_SnapshotMemory(benchmark::State& state) {
+  const int num_objects = state.range(0);
+
+  for (auto _ : state) {
+    int64_t rss_start = RssAnonBytes();
+    std::vector<std::shared_ptr<AgentMetadataState>> snapshots = {MakeState(num_objects)};
+    int64_t rss_state = RssAnonBytes();
+    for (int epoch = 0; epoch < kNumSnapshots; ++epoch) {
+      snapshots.push_back(ApplyEpoch(*snapshots.back(), num_objects, epoch));
+    }
+    int64_t rss_snapshots = RssAnonBytes();
+
+    using benchmark::Counter;
+    state.counters["StateRssAnon"] =
+        Counter(rss_state - rss_start, Counter::kAvgIterations, Counter::OneK::kIs1024);
+    state.counters["SnapshotRssAnon"] = Counter((rss_snapshots - rss_state) / kNumSnapshots,
+                                                Counter::kAvgIterations, Counter::OneK::kIs1024);
+  }
+}
+
+BENCHMARK(BM_ApplyUpdate)->Arg(1000)->Arg(10000)->Arg(50000);
+BENCHMARK(BM_SnapshotMemory)->Arg(1000)->Arg(10000)->Arg(50000)->Iterations(1);
@@ -347,6 +347,40 @@ TEST(K8sMetadataStateTest, HandlePodUpdate) {
   EXPECT_EQ("pod0_uid", container_info->pod_id());
 }
 
+TEST(K8sMetadataStateTest, CloneIsNotAffectedByUpdates) {
+  K8sMetadataState state;
+
+  K8sMetadataState::ContainerUpdate container_update;
+  ASSERT_TRUE(TextFormat::MergeFromString(kContainer0UpdatePbTxt, &container_update))
+      << "Failed to parse proto";
+
+  K8sMetadataState::PodUpdate pod_update;
+  ASSERT_TRUE(TextFormat::MergeFromString(kPod0UpdatePbTxt, &pod_update))
+      << "Failed to parse proto";
+
+  EXPECT_OK(state.HandleContainerUpdate(container_update));
+  EXPECT_OK(state.HandlePodUpdate(pod_update));
+
+  auto state_copy = state.Clone();
+  // The clone shares the objects until they are modified.
+  EXPECT_EQ(state.PodInfoByID("pod0_uid"), state_copy->PodInfoByID("pod0_uid"));
+
+  pod_update.set_stop_timestamp_ns(200);
+  pod_update.set_pod_ip("1.2.3.6");
+  EXPECT_OK(state_copy->HandlePodUpdate(pod_update));
+
+  EXPECT_NE(state.PodInfoByID("pod0_uid"), state_copy->PodInfoByID("pod0_uid"));
+  EXPECT_EQ(103, state.PodInfoByID("pod0_uid")->stop_time_ns());
+  EXPECT_EQ(200, state_copy->PodInfoByID("pod0_uid")->stop_time_ns());
+  EXPECT_EQ("", state.PodIDByIP("1.2.3.6"));
+  EXPECT_EQ("pod0_uid", state_copy->PodIDByIP("1.2.3.6"));
+  EXPECT_EQ("pod0_uid", state_copy->PodIDByIP("1.2.3.4"));
+
+  // The update didn't change the container.
+  EXPECT_EQ(state.ContainerInfoByID("container0_uid"),
+            state_copy->ContainerInfoByID("container0_uid"));
+}
+
 TEST(K8sMetadataStateTest, HandleServiceUpdate) {
   // 1 missing PodUpdate (should be skipped).
   // 1 present PodUpdate (should be handled before ServiceUpdate).
@@ -635,5 +669,20 @@ TEST(K8sMetadataStateTest, CleanupExpiredMetadata) {
   }
 }
 
+TEST(AgentMetadataStateTest, CloneToSharedIsNotAffectedByUpdates) {
+  AgentMetadataState state(/* asid */ 1, /* pid */ 2);
+
+  UPID upid(1, 123, 456);
+  state.AddUPID(upid, std::make_unique<PIDInfo>(upid, "/bin/exe", "exe --flag", "container0_uid"));
+
+  auto state_copy = state.CloneToShared();
+  state_copy->MarkUPIDAsStopped(upid, 1000);
+
+  EXPECT_EQ(0, state.GetPIDByUPID(upid)->stop_time_ns());
+  EXPECT_EQ(1000, state_copy->GetPIDByUPID(upid)->stop_time_ns());
+  EXPECT_THAT(state.upids(), UnorderedElementsAre(upid));
+  EXPECT_TRUE(state_copy->upids().empty());
+}
+
 }  // namespace md
 }  // namespace px
@@ -177,6 +177,21 @@ StatusOr<UPID> InitUPID(const system::ProcParser& proc_parser, uint32_t asid, ui
   return UPID(asid, pid, pid_start_time);
 }
 
+// Returns whether ProcessContainerPIDUpdates() would change the UPIDs of the container. The UPIDs
+// of a container have distinct PIDs, so they are unchanged if the cgroup has exactly their PIDs.
+bool ContainerPIDsChanged(const StartTimeOrderedUPIDSet& upids,
+                          const absl::flat_hash_set<uint32_t>& cgroups_pids) {
+  if (upids.size() != cgroups_pids.size()) {
+    return true;
+  }
+  for (const auto& upid : upids) {
+    if (!cgroups_pids.contains(upid.pid())) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace
 
 void ProcessContainerPIDUpdates(
@@ -236,9 +251,17 @@ Status ProcessPIDUpdates(
     int64_t ts, const system::ProcParser& proc_parser, AgentMetadataState* md,
     CGroupMetadataReader* md_reader,
     moodycamel::BlockingConcurrentQueue<std::unique_ptr<PIDStatusEvent>>* pid_updates) {
-  const auto& k8s_md_state = md->k8s_metadata_state();
+  auto* k8s_md_state = md->k8s_metadata_state();
 
+  // Modifying a container can move the entries of the map, so the IDs are collected first.
+  std::vector<CID> cids;
+  cids.reserve(k8s_md_state->containers_by_id().size());
   for (const auto& [cid, cinfo] : k8s_md_state->containers_by_id()) {
+    cids.push_back(cid);
+  }
+
+  for (const CID& cid : cids) {
+    const ContainerInfo* cinfo = k8s_md_state->ContainerInfoByID(cid);
     if (cinfo->stop_time_ns() != 0) {
       // Ignore dead containers.
       // TODO(zasgar): Come up with a cleaner way of doing this. Probably by using active/inactive
@@ -264,7 +287,7 @@ Status ProcessPIDUpdates(
     if (pod_info->stop_time_ns() != 0) {
       VLOG(1) << absl::Substitute("Found a running container in a deleted pod [cid=$0, pod_id=$1]",
                                   cid, pod_id);
-      cinfo->set_stop_time_ns(pod_info->stop_time_ns());
+      k8s_md_state->MutableContainerInfoByID(cid)->set_stop_time_ns(pod_info->stop_time_ns());
       continue;
     }
 
@@ -282,16 +305,24 @@ Status ProcessPIDUpdates(
       // NOTE: Currently, MDS sends pods that do no belong to this Agent, so this is actually
       // required to avoid repeatedly printing out the warning message above.
       if (error::IsNotFound(s)) {
-        cinfo->set_stop_time_ns(ts);
-        for (const auto& upid : cinfo->active_upids()) {
+        ContainerInfo* mutable_cinfo = k8s_md_state->MutableContainerInfoByID(cid);
+        mutable_cinfo->set_stop_time_ns(ts);
+        for (const auto& upid : mutable_cinfo->active_upids()) {
           md->MarkUPIDAsStopped(upid, ts);
         }
-        cinfo->mutable_active_upids()->clear();
+        mutable_cinfo->mutable_active_upids()->clear();
       }
       continue;
     }
 
-    ProcessContainerPIDUpdates(cid, ts, proc_parser, md, cinfo->mutable_active_upids(),
+    // Containers are shared with the previous metadata states, so only copy the ones whose PIDs
+    // changed.
+    if (!ContainerPIDsChanged(cinfo->active_upids(), cgroups_active_pids)) {
+      continue;
+    }
+
+    ProcessContainerPIDUpdates(cid, ts, proc_parser, md,
+                               k8s_md_state->MutableContainerInfoByID(cid)->mutable_active_upids(),
                                &cgroups_active_pids, pid_updates);
   }
 
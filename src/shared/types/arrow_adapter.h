@@ -164,7 +164,7 @@ inline int64_t GetArrowArrayBytes<types::DataType::STRING>(const arrow::Array* a
 
 template <types::DataType T>
 class ArrowArrayIterator
-    : public std::iterator<std::bidirectional_iterator_tag,
+    : public std::iterator<std::random_access_iterator_tag,
                            typename types::ValueTypeTraits<
                                typename types::DataTypeTraits<T>::value_type>::native_type> {
   using ReturnType =
@@ -208,7 +208,7 @@ class ArrowArrayIterator
     ++*this;
     return ret;
   }
-  ArrowArrayIterator<T> operator+(int i) const {
+  ArrowArrayIterator<T> operator+(int64_t i) const {
     auto ret = ArrowArrayIterator<T>(array_, curr_idx_ + i);
     return ret;
   }
@@ -217,11 +217,38 @@ class ArrowArrayIterator
     --*this;
     return ret;
   }
-  ArrowArrayIterator<T> operator-(int i) const {
+  ArrowArrayIterator<T> operator-(int64_t i) const {
     auto ret = ArrowArrayIterator<T>(array_, curr_idx_ - i);
     return ret;
   }
 
+  // Random access, so that std::lower_bound and friends do a binary search in O(log n) steps
+  // instead of stepping through the values one by one.
+  ArrowArrayIterator<T>& operator+=(int64_t i) {
+    curr_idx_ += i;
+    return *this;
+  }
+  ArrowArrayIterator<T>& operator-=(int64_t i) {
+    curr_idx_ -= i;
+    return *this;
+  }
+  int64_t operator-(const ArrowArrayIterator<T>& iterator) const {
+    return curr_idx_ - iterator.curr_idx_;
+  }
+  ReturnType operator[](int64_t i) const { return *(*this + i); }
+  bool operator<(const ArrowArrayIterator<T>& iterator) const {
+    return curr_idx_ < iterator.curr_idx_;
+  }
+  bool operator>(const ArrowArrayIterator<T>& iterator) const {
+    return curr_idx_ > iterator.curr_idx_;
+  }
+  bool operator<=(const ArrowArrayIterator<T>& iterator) const {
+    return curr_idx_ <= iterator.curr_idx_;
+  }
+  bool operator>=(const ArrowArrayIterator<T>& iterator) const {
+    return curr_idx_ >= iterator.curr_idx_;
+  }
+
  private:
   arrow::Array* array_;
   int64_t curr_idx_ = 0;
@@ -22,8 +22,12 @@
 #include <arrow/buffer.h>
 #include <arrow/builder.h>
 
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -73,11 +77,17 @@ class ColumnWrapper {
   // GetView returns an empty string view for all non-string columns.
   virtual std::string_view GetView(size_t idx) const = 0;
 
+  // Get() returns strings by value, because string columns don't necessarily hold StringValues
+  // (see StringArenaColumnWrapper). Use GetView() to read a string without copying it.
+  template <class TValueType>
+  using GetResultType =
+      std::conditional_t<std::is_same_v<TValueType, StringValue>, StringValue, TValueType&>;
+
   template <class TValueType>
   void Append(TValueType val);
 
   template <class TValueType>
-  TValueType& Get(size_t idx);
+  GetResultType<TValueType> Get(size_t idx);
 
   template <class TValueType>
   TValueType Get(size_t idx) const;
@@ -86,7 +96,7 @@ class ColumnWrapper {
   void AppendNoTypeCheck(TValueType val);
 
   template <class TValueType>
-  TValueType& GetNoTypeCheck(size_t idx);
+  GetResultType<TValueType> GetNoTypeCheck(size_t idx);
 
   template <class TValueType>
   TValueType GetNoTypeCheck(size_t idx) const;
@@ -99,8 +109,17 @@ class ColumnWrapper {
   // CopyIndexes leaves the original untouched, while MoveIndexes destroys the moved indexes.
   virtual SharedColumnWrapper CopyIndexes(const std::vector<size_t>& indexes) const = 0;
   virtual SharedColumnWrapper MoveIndexes(const std::vector<size_t>& indexes) = 0;
+
+  // Moves all the values of other, which must have the same data type, to the end of this column.
+  // Other is left empty.
+  virtual void MoveAppend(ColumnWrapper* other) = 0;
+
+  // Whether this is a StringArenaColumnWrapper, rather than a ColumnWrapperTmpl<StringValue>.
+  virtual bool IsStringArena() const { return false; }
 };
 
+class StringArenaColumnWrapper;
+
 /**
  * Implementation of type erased vectors for a specific data type.
  * @tparam T The UDFValueType.
@@ -178,10 +197,210 @@ class ColumnWrapperTmpl : public ColumnWrapper {
     return col;
   }
 
+  void MoveAppend(ColumnWrapper* other) override {
+    DCHECK_EQ(other->data_type(), data_type());
+    if constexpr (std::is_same_v<T, StringValue>) {
+      if (other->IsStringArena()) {
+        for (size_t i = 0; i < other->Size(); ++i) {
+          std::string_view val = other->GetView(i);
+          data_.emplace_back(val.data(), val.size());
+        }
+        other->Clear();
+        return;
+      }
+    }
+    auto& other_data = static_cast<ColumnWrapperTmpl<T>*>(other)->data_;
+    if (data_.empty() && data_.capacity() < other_data.size()) {
+      data_.swap(other_data);
+    } else {
+      data_.insert(data_.end(), std::make_move_iterator(other_data.begin()),
+                   std::make_move_iterator(other_data.end()));
+    }
+    other_data.clear();
+  }
+
  private:
   std::vector<T> data_;
 };
 
+/**
+ * A string column that stores its values back to back in a single data buffer, delimited by an
+ * offsets buffer, which is the memory layout of an arrow::StringArray. Appending a value copies it
+ * into the data buffer instead of allocating a string for it, and ConvertToArrow() wraps the
+ * buffers into an arrow::StringArray without copying them.
+ *
+ * Values can't be modified in place, so ColumnWrapper::Get() returns them by value.
+ * UnsafeRawData() is not supported.
+ */
+class StringArenaColumnWrapper : public ColumnWrapper {
+ public:
+  explicit StringArenaColumnWrapper(size_t size = 0) : arena_(std::make_shared<Arena>()) {
+    arena_->offsets.assign(size + 1, 0);
+  }
+
+  ~StringArenaColumnWrapper() override = default;
+
+  BaseValueType* UnsafeRawData() override { return nullptr; }
+  const BaseValueType* UnsafeRawData() const override { return nullptr; }
+  DataType data_type() const override { return DataType::STRING; }
+  bool IsStringArena() const override { return true; }
+
+  size_t Size() const override { return arena_->offsets.size() - 1; }
+  bool Empty() const override { return Size() == 0; }
+  int64_t Bytes() const override { return arena_->data.size(); }
+
+  std::string_view GetView(size_t idx) const override {
+    DCHECK_LT(idx, Size());
+    const auto& offsets = arena_->offsets;
+    return std::string_view(arena_->data).substr(offsets[idx], offsets[idx + 1] - offsets[idx]);
+  }
+
+  StringValue operator[](size_t idx) const {
+    std::string_view val = GetView(idx);
+    return StringValue(val.data(), val.size());
+  }
+
+  // The offsets are int32_t, like those of the arrow::StringArray that the column is converted
+  // to, so the column can hold at most 2GB of string data.
+  static constexpr size_t kMaxDataBytes = std::numeric_limits<int32_t>::max();
+
+  // Returns false, without appending anything, if val doesn't fit in the column.
+  bool TryAppend(std::string_view val) {
+    if (arena_->data.size() + val.size() > kMaxDataBytes) {
+      return false;
+    }
+    Arena* arena = MutableArena();
+    arena->data.append(val);
+    arena->offsets.push_back(static_cast<int32_t>(arena->data.size()));
+    return true;
+  }
+
+  // A value that doesn't fit in the column is replaced by an empty string, so that the column
+  // keeps the same number of rows as the other columns of its record batch.
+  void Append(std::string_view val) {
+    if (!TryAppend(val)) {
+      LOG_FIRST_N(ERROR, 10) << "StringArenaColumnWrapper can't hold more than " << kMaxDataBytes
+                             << " bytes of string data, replacing a value of " << val.size()
+                             << " bytes with an empty string.";
+      TryAppend("");
+    }
+  }
+
+  void AppendFromVector(const std::vector<StringValue>& value_vector) {
+    for (const auto& value : value_vector) {
+      Append(value);
+    }
+  }
+
+  void Reserve(size_t size) override { MutableArena()->offsets.reserve(size + 1); }
+
+  // Reserves space for bytes of string data.
+  void ReserveData(size_t bytes) { MutableArena()->data.reserve(bytes); }
+
+  void Clear() override {
+    if (shared_) {
+      arena_ = std::make_shared<Arena>();
+      shared_ = false;
+      return;
+    }
+    arena_->offsets.resize(1);
+    arena_->data.clear();
+  }
+
+  void ShrinkToFit() override {
+    Arena* arena = MutableArena();
+    arena->offsets.shrink_to_fit();
+    arena->data.shrink_to_fit();
+  }
+
+  // The returned array shares the arena of the column, which is copied if more values are
+  // appended to the column later. The memory pool is not used.
+  std::shared_ptr<arrow::Array> ConvertToArrow(arrow::MemoryPool* /* mem_pool */) override {
+    shared_ = true;
+    const auto& offsets = arena_->offsets;
+    const auto& data = arena_->data;
+    std::vector<std::shared_ptr<arrow::Buffer>> buffers = {
+        nullptr,
+        std::make_shared<ArenaBuffer>(reinterpret_cast<const uint8_t*>(offsets.data()),
+                                      offsets.size() * sizeof(int32_t), arena_),
+        std::make_shared<ArenaBuffer>(reinterpret_cast<const uint8_t*>(data.data()), data.size(),
+                                      arena_),
+    };
+    return arrow::MakeArray(
+        arrow::ArrayData::Make(arrow::utf8(), Size(), std::move(buffers), /* null_count */ 0));
+  }
+
+  SharedColumnWrapper CopyIndexes(const std::vector<size_t>& indexes) const override {
+    auto copy = std::make_shared<StringArenaColumnWrapper>();
+    copy->Reserve(indexes.size());
+    for (size_t idx : indexes) {
+      copy->Append(GetView(idx));
+    }
+    return copy;
+  }
+
+  // Selecting all the values in order (the common case of records that arrived sorted) hands
+  // over the arena without copying it. Like ColumnWrapperTmpl::MoveIndexes, "this" should be
+  // discarded afterwards.
+  SharedColumnWrapper MoveIndexes(const std::vector<size_t>& indexes) override {
+    bool all_in_order = indexes.size() == Size();
+    for (size_t i = 0; all_in_order && i < indexes.size(); ++i) {
+      all_in_order = indexes[i] == i;
+    }
+    if (!all_in_order) {
+      return CopyIndexes(indexes);
+    }
+    auto col = std::make_shared<StringArenaColumnWrapper>();
+    std::swap(col->arena_, arena_);
+    std::swap(col->shared_, shared_);
+    return col;
+  }
+
+  void MoveAppend(ColumnWrapper* other) override {
+    DCHECK_EQ(other->data_type(), DataType::STRING);
+    if (Empty() && other->IsStringArena()) {
+      auto* other_arena = static_cast<StringArenaColumnWrapper*>(other);
+      std::swap(arena_, other_arena->arena_);
+      std::swap(shared_, other_arena->shared_);
+    } else {
+      for (size_t i = 0; i < other->Size(); ++i) {
+        Append(other->GetView(i));
+      }
+    }
+    other->Clear();
+  }
+
+ private:
+  struct Arena {
+    // Value i is data[offsets[i], offsets[i + 1]).
+    std::vector<int32_t> offsets = {0};
+    std::string data;
+  };
+
+  // An arrow::Buffer over memory of an arena, which it keeps alive.
+  class ArenaBuffer : public arrow::Buffer {
+   public:
+    ArenaBuffer(const uint8_t* data, int64_t size, std::shared_ptr<const Arena> arena)
+        : arrow::Buffer(data, size), arena_(std::move(arena)) {}
+
+   private:
+    std::shared_ptr<const Arena> arena_;
+  };
+
+  // Returns the arena for writing, after copying it if Arrow arrays still point into it.
+  Arena* MutableArena() {
+    if (shared_) {
+      arena_ = std::make_shared<Arena>(*arena_);
+      shared_ = false;
+    }
+    return arena_.get();
+  }
+
+  std::shared_ptr<Arena> arena_;
+  // Whether arrays returned by ConvertToArrow() point into the arena.
+  bool shared_ = false;
+};
+
 template <typename T>
 int64_t ColumnWrapperTmpl<T>::Bytes() const {
   return Size() * sizeof(T);
@@ -275,37 +494,53 @@ inline void ColumnWrapper::Append(TValueType val) {
   CHECK_EQ(data_type(), ValueTypeTraits<TValueType>::data_type)
       << "Expect " << ToString(data_type()) << " got "
       << ToString(ValueTypeTraits<TValueType>::data_type);
-  static_cast<ColumnWrapperTmpl<TValueType>*>(this)->Append(val);
+  AppendNoTypeCheck(std::move(val));
 }
 
 template <class TValueType>
-inline TValueType& ColumnWrapper::Get(size_t idx) {
+inline ColumnWrapper::GetResultType<TValueType> ColumnWrapper::Get(size_t idx) {
   CHECK_EQ(data_type(), ValueTypeTraits<TValueType>::data_type);
-  return static_cast<ColumnWrapperTmpl<TValueType>*>(this)->operator[](idx);
+  return GetNoTypeCheck<TValueType>(idx);
 }
 
 template <class TValueType>
 inline TValueType ColumnWrapper::Get(size_t idx) const {
   CHECK_EQ(data_type(), ValueTypeTraits<TValueType>::data_type);
-  return static_cast<const ColumnWrapperTmpl<TValueType>*>(this)->operator[](idx);
+  return GetNoTypeCheck<TValueType>(idx);
 }
 
 template <class TValueType>
 inline void ColumnWrapper::AppendNoTypeCheck(TValueType val) {
   DCHECK_EQ(data_type(), ValueTypeTraits<TValueType>::data_type);
-  static_cast<ColumnWrapperTmpl<TValueType>*>(this)->Append(val);
+  if constexpr (std::is_same_v<TValueType, StringValue>) {
+    if (IsStringArena()) {
+      static_cast<StringArenaColumnWrapper*>(this)->Append(val);
+      return;
+    }
+  }
+  static_cast<ColumnWrapperTmpl<TValueType>*>(this)->Append(std::move(val));
 }
 
 template <class TValueType>
-inline TValueType& ColumnWrapper::GetNoTypeCheck(size_t idx) {
+inline ColumnWrapper::GetResultType<TValueType> ColumnWrapper::GetNoTypeCheck(size_t idx) {
   DCHECK_EQ(data_type(), ValueTypeTraits<TValueType>::data_type);
+  if constexpr (std::is_same_v<TValueType, StringValue>) {
+    if (IsStringArena()) {
+      return static_cast<StringArenaColumnWrapper*>(this)->operator[](idx);
+    }
+  }
   return static_cast<ColumnWrapperTmpl<TValueType>*>(this)->operator[](idx);
 }
 
 template <class TValueType>
 inline TValueType ColumnWrapper::GetNoTypeCheck(size_t idx) const {
   DCHECK_EQ(data_type(), ValueTypeTraits<TValueType>::data_type);
-  return static_cast<ColumnWrapperTmpl<TValueType>*>(this)->operator[](idx);
+  if constexpr (std::is_same_v<TValueType, StringValue>) {
+    if (IsStringArena()) {
+      return static_cast<const StringArenaColumnWrapper*>(this)->operator[](idx);
+    }
+  }
+  return static_cast<const ColumnWrapperTmpl<TValueType>*>(this)->operator[](idx);
 }
 
 template <class TValueType>
@@ -313,6 +548,12 @@ inline void ColumnWrapper::AppendFromVector(const std::vector<TValueType>& val)
   CHECK_EQ(data_type(), ValueTypeTraits<TValueType>::data_type)
       << "Expect " << ToString(data_type()) << " got "
       << ToString(ValueTypeTraits<TValueType>::data_type);
+  if constexpr (std::is_same_v<TValueType, StringValue>) {
+    if (IsStringArena()) {
+      static_cast<StringArenaColumnWrapper*>(this)->AppendFromVector(val);
+      return;
+    }
+  }
   static_cast<ColumnWrapperTmpl<TValueType>*>(this)->AppendFromVector(val);
 }
 
@@ -356,7 +597,7 @@ void ExtractValueToColumnWrapper(ColumnWrapper* wrapper, arrow::Array* arr, int6
 }
 
 template <types::DataType T>
-class ColumnWrapperIterator : public std::iterator<std::bidirectional_iterator_tag,
+class ColumnWrapperIterator : public std::iterator<std::random_access_iterator_tag,
                                                    typename types::DataTypeTraits<T>::native_type> {
   using ReturnType = typename types::DataTypeTraits<T>::native_type;
   using ValueType = typename types::DataTypeTraits<T>::value_type;
@@ -382,11 +623,9 @@ class ColumnWrapperIterator : public std::iterator<std::bidirectional_iterator_t
   }
 
   ReturnType* operator->() const {
-    if constexpr (std::is_same_v<ValueType, StringValue>) {
-      return &column_->Get<ValueType>(curr_idx_);
-    } else {
-      return &column_->Get<ValueType>(curr_idx_).val;
-    }
+    // Strings are returned by value (see ColumnWrapper::Get()), so there is nothing to point to.
+    static_assert(!std::is_same_v<ValueType, StringValue>);
+    return &column_->Get<ValueType>(curr_idx_).val;
   }
 
   ColumnWrapperIterator<T>& operator++() {
@@ -407,7 +646,7 @@ class ColumnWrapperIterator : public std::iterator<std::bidirectional_iterator_t
     ++*this;
     return ret;
   }
-  ColumnWrapperIterator<T> operator+(int i) const {
+  ColumnWrapperIterator<T> operator+(int64_t i) const {
     auto ret = ColumnWrapperIterator<T>(column_, curr_idx_ + i);
     return ret;
   }
@@ -416,11 +655,38 @@ class ColumnWrapperIterator : public std::iterator<std::bidirectional_iterator_t
     --*this;
     return ret;
   }
-  ColumnWrapperIterator<T> operator-(int i) const {
+  ColumnWrapperIterator<T> operator-(int64_t i) const {
     auto ret = ColumnWrapperIterator<T>(column_, curr_idx_ - i);
     return ret;
   }
 
+  // Random access, so that std::lower_bound and friends do a binary search in O(log n) steps
+  // instead of stepping through the values one by one.
+  ColumnWrapperIterator<T>& operator+=(int64_t i) {
+    curr_idx_ += i;
+    return *this;
+  }
+  ColumnWrapperIterator<T>& operator-=(int64_t i) {
+    curr_idx_ -= i;
+    return *this;
+  }
+  int64_t operator-(const ColumnWrapperIterator<T>& iterator) const {
+    return curr_idx_ - iterator.curr_idx_;
+  }
+  ReturnType operator[](int64_t i) const { return *(*this + i); }
+  bool operator<(const ColumnWrapperIterator<T>& iterator) const {
+    return curr_idx_ < iterator.curr_idx_;
+  }
+  bool operator>(const ColumnWrapperIterator<T>& iterator) const {
+    return curr_idx_ > iterator.curr_idx_;
+  }
+  bool operator<=(const ColumnWrapperIterator<T>& iterator) const {
+    return curr_idx_ <= iterator.curr_idx_;
+  }
+  bool operator>=(const ColumnWrapperIterator<T>& iterator) const {
+    return curr_idx_ >= iterator.curr_idx_;
+  }
+
  private:
   ColumnWrapper* column_;
   int64_t curr_idx_ = 0;
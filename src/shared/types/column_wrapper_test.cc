@@ -24,6 +24,8 @@
 
 #include <iostream>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "src/shared/types/column_wrapper.h"
 #include "src/shared/types/types.h"
@@ -283,5 +285,123 @@ TEST(ColumnWrapperTest, MoveIndexes) {
   }
 }
 
+TEST(ColumnWrapperTest, MoveAppend) {
+  auto col = ColumnWrapper::Make(DataType::STRING, 0);
+  col->AppendFromVector(std::vector<StringValue>{"a", "b"});
+
+  auto other = ColumnWrapper::Make(DataType::STRING, 0);
+  other->AppendFromVector(std::vector<StringValue>{"c", "d", "e"});
+
+  col->MoveAppend(other.get());
+  ASSERT_EQ(col->Size(), 5);
+  EXPECT_EQ(col->Get<StringValue>(0), "a");
+  EXPECT_EQ(col->Get<StringValue>(2), "c");
+  EXPECT_EQ(col->Get<StringValue>(4), "e");
+  EXPECT_TRUE(other->Empty());
+
+  // Moving into an empty column.
+  auto empty = ColumnWrapper::Make(DataType::STRING, 0);
+  empty->MoveAppend(col.get());
+  EXPECT_EQ(empty->Size(), 5);
+  EXPECT_EQ(empty->Get<StringValue>(1), "b");
+  EXPECT_TRUE(col->Empty());
+}
+
+TEST(StringArenaColumnWrapperTest, AppendAndGet) {
+  auto col = std::make_shared<StringArenaColumnWrapper>();
+  col->Append("abc");
+  col->Append("");
+  // Through the type erased interface.
+  SharedColumnWrapper wrapper = col;
+  wrapper->Append<StringValue>("de");
+  col->AppendFromVector(std::vector<StringValue>{"fgh"});
+
+  ASSERT_EQ(col->Size(), 4);
+  EXPECT_EQ(col->data_type(), DataType::STRING);
+  EXPECT_EQ(col->Bytes(), 8);
+  EXPECT_EQ(col->Get<StringValue>(0), "abc");
+  EXPECT_EQ(col->Get<StringValue>(1), "");
+  EXPECT_EQ(col->GetView(2), "de");
+  EXPECT_EQ(std::as_const(*col).Get<StringValue>(3), "fgh");
+
+  col->Clear();
+  EXPECT_TRUE(col->Empty());
+  EXPECT_EQ(col->Bytes(), 0);
+}
+
+TEST(StringArenaColumnWrapperTest, ConvertToArrowDoesNotCopy) {
+  auto col = std::make_shared<StringArenaColumnWrapper>();
+  col->AppendFromVector(std::vector<StringValue>{"abc", "", "de"});
+
+  auto arr = col->ConvertToArrow(arrow::default_memory_pool());
+  ASSERT_EQ(arr->type_id(), arrow::Type::STRING);
+  auto* str_arr = static_cast<arrow::StringArray*>(arr.get());
+  ASSERT_EQ(str_arr->length(), 3);
+  EXPECT_EQ(str_arr->null_count(), 0);
+  EXPECT_EQ(str_arr->GetString(0), "abc");
+  EXPECT_EQ(str_arr->GetString(1), "");
+  EXPECT_EQ(str_arr->GetString(2), "de");
+  EXPECT_EQ(reinterpret_cast<const char*>(str_arr->value_data()->data()), col->GetView(0).data());
+
+  // Appending after the conversion leaves the array intact.
+  col->Append("fg");
+  EXPECT_EQ(str_arr->length(), 3);
+  EXPECT_EQ(str_arr->GetString(2), "de");
+  EXPECT_EQ(col->Get<StringValue>(3), "fg");
+
+  // So does destroying the column.
+  col.reset();
+  EXPECT_EQ(str_arr->GetString(0), "abc");
+}
+
+TEST(StringArenaColumnWrapperTest, MoveAndCopyIndexes) {
+  auto col = std::make_shared<StringArenaColumnWrapper>();
+  col->AppendFromVector(std::vector<StringValue>{"a", "bb", "ccc"});
+
+  auto copy = col->CopyIndexes({2, 0});
+  ASSERT_EQ(copy->Size(), 2);
+  EXPECT_EQ(copy->Get<StringValue>(0), "ccc");
+  EXPECT_EQ(copy->Get<StringValue>(1), "a");
+
+  auto reordered = col->MoveIndexes({1, 2, 0});
+  ASSERT_EQ(reordered->Size(), 3);
+  EXPECT_EQ(reordered->Get<StringValue>(0), "bb");
+  EXPECT_EQ(reordered->Get<StringValue>(2), "a");
+
+  // Moving all the values in order hands over the arena.
+  const char* data = col->GetView(0).data();
+  auto moved = col->MoveIndexes({0, 1, 2});
+  ASSERT_EQ(moved->Size(), 3);
+  EXPECT_EQ(moved->GetView(0).data(), data);
+  EXPECT_EQ(moved->Get<StringValue>(1), "bb");
+}
+
+TEST(StringArenaColumnWrapperTest, MoveAppend) {
+  auto col = std::make_shared<StringArenaColumnWrapper>();
+  col->AppendFromVector(std::vector<StringValue>{"a", "b"});
+
+  auto other = std::make_shared<StringArenaColumnWrapper>();
+  other->AppendFromVector(std::vector<StringValue>{"c", "d"});
+
+  col->MoveAppend(other.get());
+  ASSERT_EQ(col->Size(), 4);
+  EXPECT_EQ(col->Get<StringValue>(2), "c");
+  EXPECT_TRUE(other->Empty());
+
+  // Between arena and vector backed columns.
+  auto vec = ColumnWrapper::Make(DataType::STRING, 0);
+  vec->AppendFromVector(std::vector<StringValue>{"e"});
+  col->MoveAppend(vec.get());
+  ASSERT_EQ(col->Size(), 5);
+  EXPECT_EQ(col->Get<StringValue>(4), "e");
+  EXPECT_TRUE(vec->Empty());
+
+  vec->MoveAppend(col.get());
+  ASSERT_EQ(vec->Size(), 5);
+  EXPECT_EQ(vec->Get<StringValue>(0), "a");
+  EXPECT_EQ(vec->Get<StringValue>(4), "e");
+  EXPECT_TRUE(col->Empty());
+}
+
 }  // namespace types
 }  // namespace px
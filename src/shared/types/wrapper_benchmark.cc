@@ -18,13 +18,20 @@
 
 #include <benchmark/benchmark.h>
 
+#include <memory>
 #include <random>
+#include <string>
 #include <vector>
 #include "src/common/benchmark/benchmark.h"
 #include "src/datagen/datagen.h"
+#include "src/shared/types/column_wrapper.h"
 #include "src/shared/types/types.h"
 
 using px::types::Int64Value;
+using px::types::SharedColumnWrapper;
+using px::types::StringArenaColumnWrapper;
+using px::types::StringValue;
+using px::types::StringValueColumnWrapper;
 
 // This is just a dummy function that does some work so we can use it in the benchmark.
 template <typename T>
@@ -65,3 +72,60 @@ static void BM_Int64Vector(benchmark::State& state) {  // NOLINT
 
 BENCHMARK_TEMPLATE(BM_Int64Vector, int64_t)->Arg(10000);
 BENCHMARK_TEMPLATE(BM_Int64Vector, Int64Value)->Arg(10000);
+
+// Strings of the given length, like the bodies and headers that Stirling records.
+static std::vector<StringValue> MakeStrings(int64_t num_strings, int64_t length) {
+  std::vector<StringValue> strings;
+  strings.reserve(num_strings);
+  for (int64_t i = 0; i < num_strings; ++i) {
+    strings.emplace_back(px::datagen::RandomString(length));
+  }
+  return strings;
+}
+
+template <typename TWrapper>
+static SharedColumnWrapper MakeStringColumn(const std::vector<StringValue>& strings) {
+  SharedColumnWrapper col = std::make_shared<TWrapper>(0);
+  col->Reserve(strings.size());
+  for (const auto& s : strings) {
+    col->Append<StringValue>(s);
+  }
+  return col;
+}
+
+// Appending the strings one at a time, as Stirling's RecordBuilder does.
+template <typename TWrapper>
+// NOLINTNEXTLINE(runtime/references)
+static void BM_StringColumnAppend(benchmark::State& state) {
+  auto strings = MakeStrings(state.range(0), state.range(1));
+  for (auto _ : state) {
+    auto col = MakeStringColumn<TWrapper>(strings);
+    benchmark::DoNotOptimize(col);
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0) * state.range(1));
+}
+
+// Converting a column to Arrow, as the table store does when the column is first read.
+template <typename TWrapper>
+// NOLINTNEXTLINE(runtime/references)
+static void BM_StringColumnToArrow(benchmark::State& state) {
+  auto col = MakeStringColumn<TWrapper>(MakeStrings(state.range(0), state.range(1)));
+  for (auto _ : state) {
+    auto arr = col->ConvertToArrow(arrow::default_memory_pool());
+    benchmark::DoNotOptimize(arr);
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0) * state.range(1));
+}
+
+BENCHMARK_TEMPLATE(BM_StringColumnAppend, StringValueColumnWrapper)
+    ->Args({1024, 16})
+    ->Args({1024, 1024});
+BENCHMARK_TEMPLATE(BM_StringColumnAppend, StringArenaColumnWrapper)
+    ->Args({1024, 16})
+    ->Args({1024, 1024});
+BENCHMARK_TEMPLATE(BM_StringColumnToArrow, StringValueColumnWrapper)
+    ->Args({1024, 16})
+    ->Args({1024, 1024});
+BENCHMARK_TEMPLATE(BM_StringColumnToArrow, StringArenaColumnWrapper)
+    ->Args({1024, 16})
+    ->Args({1024, 1024});
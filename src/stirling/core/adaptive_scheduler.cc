@@ -0,0 +1,176 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/core/adaptive_scheduler.h"
+
+#include <algorithm>
+#include <string>
+
+#include "src/common/metrics/metrics.h"
+
+DEFINE_bool(stirling_adaptive_scheduling,
+            gflags::BoolFromEnv("PL_STIRLING_ADAPTIVE_SCHEDULING", false),
+            "If true, the sampling and push periods of the source connectors adapt to their load.");
+DEFINE_double(stirling_adaptive_scheduling_min_period_ratio,
+              gflags::DoubleFromEnv("PL_STIRLING_ADAPTIVE_SCHEDULING_MIN_PERIOD_RATIO", 0.25),
+              "With adaptive scheduling, the shortest sampling or push period of a source "
+              "connector, as a fraction of its default period.");
+DEFINE_double(stirling_adaptive_scheduling_max_period_ratio,
+              gflags::DoubleFromEnv("PL_STIRLING_ADAPTIVE_SCHEDULING_MAX_PERIOD_RATIO", 4),
+              "With adaptive scheduling, the longest sampling or push period of a source "
+              "connector, as a multiple of its default period.");
+
+namespace px {
+namespace stirling {
+
+using std::chrono::milliseconds;
+
+AdaptivePeriod::AdaptivePeriod(const Config& config, milliseconds initial_period)
+    : config_(config),
+      period_(std::clamp(initial_period, config.min_period, config.max_period)) {
+  DCHECK(config_.min_period <= config_.max_period);
+  DCHECK_LT(config_.low_watermark, config_.high_watermark);
+}
+
+milliseconds AdaptivePeriod::Update(double load, milliseconds floor) {
+  auto scale = [this](double factor) {
+    return milliseconds{static_cast<int64_t>(period_.count() * factor)};
+  };
+
+  milliseconds period = period_;
+  if (load > config_.high_watermark) {
+    period = scale(config_.shrink_factor);
+  } else if (load < config_.low_watermark) {
+    // Round up, so short periods can still grow.
+    period = std::max(scale(config_.grow_factor), period_ + milliseconds{1});
+  }
+
+  const milliseconds min_period = std::min(std::max(config_.min_period, floor), config_.max_period);
+  period_ = std::clamp(period, min_period, config_.max_period);
+  return period_;
+}
+
+namespace {
+
+AdaptivePeriod::Config MakeConfig(milliseconds period) {
+  AdaptivePeriod::Config config;
+  config.min_period = std::max(
+      milliseconds{1},
+      milliseconds{static_cast<int64_t>(period.count() *
+                                        FLAGS_stirling_adaptive_scheduling_min_period_ratio)});
+  config.max_period = std::max(
+      period,
+      milliseconds{static_cast<int64_t>(period.count() *
+                                        FLAGS_stirling_adaptive_scheduling_max_period_ratio)});
+  return config;
+}
+
+prometheus::Gauge& BuildSourceGauge(const std::string& name, const std::string& help,
+                                    std::string_view source_name) {
+  return prometheus::BuildGauge()
+      .Name(name)
+      .Help(help)
+      .Register(GetMetricsRegistry())
+      .Add({{"source", std::string(source_name)}});
+}
+
+prometheus::Counter& BuildSourceCounter(const std::string& name, const std::string& help,
+                                        std::string_view source_name) {
+  return prometheus::BuildCounter()
+      .Name(name)
+      .Help(help)
+      .Register(GetMetricsRegistry())
+      .Add({{"source", std::string(source_name)}});
+}
+
+}  // namespace
+
+AdaptiveScheduler::PeriodMetrics::PeriodMetrics(std::string_view source_name,
+                                                std::string_view period_name)
+    : period_ms(BuildSourceGauge(absl::Substitute("stirling_$0_period_ms", period_name),
+                                 absl::Substitute("Current $0 period of the source connector.",
+                                                  period_name),
+                                 source_name)),
+      load(BuildSourceGauge(
+          absl::Substitute("stirling_$0_load", period_name),
+          absl::Substitute("Load that the last $0 period was adapted to, as a fraction of the "
+                           "buffer capacity.",
+                           period_name),
+          source_name)),
+      shortened(BuildSourceCounter(
+          absl::Substitute("stirling_$0_period_shortened", period_name),
+          absl::Substitute("Number of times the $0 period was shortened because of high load.",
+                           period_name),
+          source_name)),
+      lengthened(BuildSourceCounter(
+          absl::Substitute("stirling_$0_period_lengthened", period_name),
+          absl::Substitute("Number of times the $0 period was lengthened because of low load.",
+                           period_name),
+          source_name)) {}
+
+void AdaptiveScheduler::PeriodMetrics::Update(milliseconds old_period, milliseconds period,
+                                              double load_value) {
+  period_ms.Set(period.count());
+  load.Set(load_value);
+  if (period < old_period) {
+    shortened.Increment();
+  } else if (period > old_period) {
+    lengthened.Increment();
+  }
+}
+
+AdaptiveScheduler::AdaptiveScheduler(std::string_view source_name,
+                                     FrequencyManager* sampling_freq_mgr,
+                                     FrequencyManager* push_freq_mgr)
+    : sampling_freq_mgr_(sampling_freq_mgr),
+      push_freq_mgr_(push_freq_mgr),
+      sampling_period_(MakeConfig(sampling_freq_mgr->period()), sampling_freq_mgr->period()),
+      push_period_(MakeConfig(push_freq_mgr->period()), push_freq_mgr->period()),
+      sampling_metrics_(source_name, "sampling"),
+      push_metrics_(source_name, "push") {
+  sampling_metrics_.period_ms.Set(sampling_period_.period().count());
+  push_metrics_.period_ms.Set(push_period_.period().count());
+}
+
+void AdaptiveScheduler::TransferredData(std::chrono::nanoseconds transfer_time,
+                                        std::optional<double> input_buffer_occupancy) {
+  if (!input_buffer_occupancy.has_value()) {
+    return;
+  }
+  const milliseconds old_period = sampling_period_.period();
+  const auto floor = std::chrono::ceil<milliseconds>(kMinTransferTimeRatio * transfer_time);
+  sampling_period_.Update(input_buffer_occupancy.value(), floor);
+  sampling_freq_mgr_->set_period(sampling_period_.period());
+  sampling_metrics_.Update(old_period, sampling_period_.period(), input_buffer_occupancy.value());
+}
+
+void AdaptiveScheduler::PushingData(const std::vector<DataTable*>& data_tables) {
+  double occupancy = 0;
+  for (const auto* data_table : data_tables) {
+    if (data_table != nullptr) {
+      occupancy = std::max(occupancy, data_table->OccupancyPct());
+    }
+  }
+  const milliseconds old_period = push_period_.period();
+  push_period_.Update(occupancy);
+  push_freq_mgr_->set_period(push_period_.period());
+  push_metrics_.Update(old_period, push_period_.period(), occupancy);
+}
+
+}  // namespace stirling
+}  // namespace px
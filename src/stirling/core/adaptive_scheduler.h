@@ -0,0 +1,139 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <prometheus/counter.h>
+#include <prometheus/gauge.h>
+
+#include "src/common/base/base.h"
+#include "src/stirling/core/data_table.h"
+#include "src/stirling/core/frequency_manager.h"
+
+DECLARE_bool(stirling_adaptive_scheduling);
+
+namespace px {
+namespace stirling {
+
+/**
+ * AdaptivePeriod adjusts a period to the load measured at the end of each period, where the load
+ * is the fraction of some capacity that was used during the period (e.g. how full a buffer was
+ * when it was drained):
+ *  - Above the high watermark, the period is shortened, so less data accumulates per period.
+ *  - Below the low watermark, the period is lengthened, so we wake up less often when idle.
+ * The period always stays within [min_period, max_period].
+ */
+class AdaptivePeriod {
+ public:
+  struct Config {
+    std::chrono::milliseconds min_period;
+    std::chrono::milliseconds max_period;
+    double low_watermark = 0.1;
+    double high_watermark = 0.5;
+    // The period is multiplied by shrink_factor when the load is high, and by grow_factor when it
+    // is low. Shrinking faster than growing reacts quickly to bursts without oscillating.
+    double shrink_factor = 0.5;
+    double grow_factor = 1.25;
+  };
+
+  AdaptivePeriod(const Config& config, std::chrono::milliseconds initial_period);
+
+  /**
+   * Updates the period with the load of the last period. The period is never shortened below
+   * floor, which lets the caller keep it longer than the periodic work takes.
+   *
+   * @return the new period.
+   */
+  std::chrono::milliseconds Update(double load,
+                                   std::chrono::milliseconds floor = std::chrono::milliseconds{0});
+
+  std::chrono::milliseconds period() const { return period_; }
+
+ private:
+  const Config config_;
+  std::chrono::milliseconds period_;
+};
+
+/**
+ * AdaptiveScheduler adapts the sampling and push periods of a source connector to its load.
+ * The periods stay between --stirling_adaptive_scheduling_min_period_ratio and
+ * --stirling_adaptive_scheduling_max_period_ratio times the periods the connector was initialized
+ * with.
+ *
+ *  - The sampling period follows the occupancy of the connector's input buffers (e.g. BPF perf
+ *    buffers) when TransferData() drains them. It is never shorter than kMinTransferTimeRatio times
+ *    the duration of TransferData(), so a busy connector can't take over the Stirling thread.
+ *    Connectors without input buffers keep their sampling period, which sets the resolution of
+ *    their data.
+ *  - The push period follows the occupancy of the connector's data tables when they are pushed.
+ *
+ * The current periods and the adjustments are exported as metrics, labeled with the source name.
+ */
+class AdaptiveScheduler : public NotCopyable {
+ public:
+  AdaptiveScheduler(std::string_view source_name, FrequencyManager* sampling_freq_mgr,
+                    FrequencyManager* push_freq_mgr);
+
+  /**
+   * To be called after TransferData(), with the time it took, and the occupancy of the
+   * connector's input buffers if it has any.
+   */
+  void TransferredData(std::chrono::nanoseconds transfer_time,
+                       std::optional<double> input_buffer_occupancy);
+
+  /**
+   * To be called before PushData(), with the tables about to be pushed.
+   */
+  void PushingData(const std::vector<DataTable*>& data_tables);
+
+  std::chrono::milliseconds sampling_period() const { return sampling_period_.period(); }
+  std::chrono::milliseconds push_period() const { return push_period_.period(); }
+
+  static constexpr int kMinTransferTimeRatio = 4;
+
+ private:
+  struct PeriodMetrics {
+    PeriodMetrics(std::string_view source_name, std::string_view period_name);
+
+    // Records the change from old_period to the current period.
+    void Update(std::chrono::milliseconds old_period, std::chrono::milliseconds period,
+                double load);
+
+    prometheus::Gauge& period_ms;
+    prometheus::Gauge& load;
+    prometheus::Counter& shortened;
+    prometheus::Counter& lengthened;
+  };
+
+  FrequencyManager* sampling_freq_mgr_;
+  FrequencyManager* push_freq_mgr_;
+
+  AdaptivePeriod sampling_period_;
+  AdaptivePeriod push_period_;
+
+  PeriodMetrics sampling_metrics_;
+  PeriodMetrics push_metrics_;
+};
+
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/core/adaptive_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "src/common/metrics/metrics.h"
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace stirling {
+
+using std::chrono::milliseconds;
+
+TEST(AdaptivePeriodTest, ShortensAndLengthensWithinBounds) {
+  AdaptivePeriod::Config config;
+  config.min_period = milliseconds{50};
+  config.max_period = milliseconds{800};
+  AdaptivePeriod period(config, milliseconds{200});
+
+  EXPECT_EQ(period.Update(0.3), milliseconds{200});
+  EXPECT_EQ(period.Update(1.0), milliseconds{100});
+  EXPECT_EQ(period.Update(1.0), milliseconds{50});
+  EXPECT_EQ(period.Update(1.0), milliseconds{50});
+  EXPECT_EQ(period.Update(0.0), milliseconds{62});
+  for (int i = 0; i < 20; ++i) {
+    period.Update(0.0);
+  }
+  EXPECT_EQ(period.period(), milliseconds{800});
+
+  // The floor wins over the high load, but not over the max period.
+  EXPECT_EQ(period.Update(1.0, milliseconds{600}), milliseconds{600});
+  EXPECT_EQ(period.Update(1.0, milliseconds{1000}), milliseconds{800});
+}
+
+// Simulates a source connector that drains a BPF perf buffer every sampling period, fed with a
+// synthetic load that is idle, then bursty, then idle again.
+class AdaptiveSchedulerSimulationTest : public ::testing::Test {
+ protected:
+  static constexpr int64_t kBufferBytes = 1024 * 1024;
+  static constexpr milliseconds kSamplingPeriod{200};
+  static constexpr milliseconds kPushPeriod{1000};
+  // Processing cost of the data, used as the duration of TransferData().
+  static constexpr std::chrono::nanoseconds kCostPerByte{5};
+
+  struct SimulationResult {
+    int64_t lost_bytes = 0;
+    int num_transfers = 0;
+    milliseconds last_period;
+  };
+
+  AdaptiveSchedulerSimulationTest() {
+    sampling_freq_mgr_.set_period(kSamplingPeriod);
+    push_freq_mgr_.set_period(kPushPeriod);
+  }
+
+  // Runs the simulation for duration, with load_fn(t) giving the rate in bytes/ms at time t.
+  // If scheduler is null, the sampling period stays fixed.
+  SimulationResult Simulate(milliseconds duration,
+                            const std::function<int64_t(milliseconds)>& load_fn,
+                            AdaptiveScheduler* scheduler) {
+    SimulationResult result;
+    milliseconds now{0};
+    while (now < duration) {
+      const milliseconds period = sampling_freq_mgr_.period();
+      int64_t bytes = 0;
+      for (milliseconds t = now; t < now + period; ++t) {
+        bytes += load_fn(t);
+      }
+      now += period;
+
+      result.lost_bytes += std::max<int64_t>(0, bytes - kBufferBytes);
+      bytes = std::min(bytes, kBufferBytes);
+      ++result.num_transfers;
+
+      if (scheduler != nullptr) {
+        scheduler->TransferredData(bytes * kCostPerByte, 1.0 * bytes / kBufferBytes);
+      }
+    }
+    result.last_period = sampling_freq_mgr_.period();
+    return result;
+  }
+
+  FrequencyManager sampling_freq_mgr_;
+  FrequencyManager push_freq_mgr_;
+};
+
+constexpr int64_t kIdleRate = 100;
+constexpr int64_t kBurstRate = 10 * 1024;
+
+TEST_F(AdaptiveSchedulerSimulationTest, IdleLengthensSamplingPeriod) {
+  AdaptiveScheduler scheduler("idle_source", &sampling_freq_mgr_, &push_freq_mgr_);
+
+  SimulationResult result =
+      Simulate(milliseconds{60'000}, [](milliseconds) { return kIdleRate; }, &scheduler);
+  EXPECT_EQ(result.lost_bytes, 0);
+  EXPECT_EQ(result.last_period, 4 * kSamplingPeriod);
+  // Waking up at the fixed period would have taken 300 transfers.
+  EXPECT_LT(result.num_transfers, 100);
+}
+
+TEST_F(AdaptiveSchedulerSimulationTest, BurstShortensSamplingPeriod) {
+  // 20s idle, 10s burst, 20s idle.
+  auto load_fn = [](milliseconds t) {
+    return (t >= milliseconds{20'000} && t < milliseconds{30'000}) ? kBurstRate : kIdleRate;
+  };
+
+  SimulationResult fixed = Simulate(milliseconds{50'000}, load_fn, nullptr);
+
+  sampling_freq_mgr_.set_period(kSamplingPeriod);
+  AdaptiveScheduler scheduler("bursty_source", &sampling_freq_mgr_, &push_freq_mgr_);
+  SimulationResult adaptive = Simulate(milliseconds{50'000}, load_fn, &scheduler);
+
+  // The fixed period overflows the buffer every period of the burst. The adaptive period only
+  // loses data during the few periods it takes to shorten.
+  EXPECT_GT(fixed.lost_bytes, 40 * kBufferBytes);
+  EXPECT_LT(adaptive.lost_bytes, 10 * kBufferBytes);
+  EXPECT_LT(adaptive.lost_bytes, fixed.lost_bytes / 4);
+
+  // After the burst, the period goes back up.
+  EXPECT_EQ(adaptive.last_period, 4 * kSamplingPeriod);
+}
+
+TEST_F(AdaptiveSchedulerSimulationTest, TransferTimeBoundsSamplingPeriod) {
+  AdaptiveScheduler scheduler("slow_source", &sampling_freq_mgr_, &push_freq_mgr_);
+
+  // The buffer is always full, but transferring the data takes 40ms.
+  for (int i = 0; i < 10; ++i) {
+    scheduler.TransferredData(milliseconds{40}, 1.0);
+  }
+  EXPECT_EQ(sampling_freq_mgr_.period(),
+            AdaptiveScheduler::kMinTransferTimeRatio * milliseconds{40});
+}
+
+TEST_F(AdaptiveSchedulerSimulationTest, NoInputBuffersKeepsSamplingPeriod) {
+  AdaptiveScheduler scheduler("stats_source", &sampling_freq_mgr_, &push_freq_mgr_);
+  for (int i = 0; i < 10; ++i) {
+    scheduler.TransferredData(milliseconds{1}, std::nullopt);
+  }
+  EXPECT_EQ(sampling_freq_mgr_.period(), kSamplingPeriod);
+}
+
+TEST_F(AdaptiveSchedulerSimulationTest, PushPeriodFollowsTableOccupancy) {
+  static constexpr DataElement kElements[] = {
+      {"time_", "time", types::DataType::TIME64NS, types::SemanticType::ST_NONE,
+       types::PatternType::METRIC_COUNTER},
+  };
+  static constexpr auto kSchema = DataTableSchema("test_table", "description", kElements);
+  DataTable data_table(/*id*/ 0, kSchema);
+  std::vector<DataTable*> data_tables = {&data_table};
+
+  AdaptiveScheduler scheduler("push_source", &sampling_freq_mgr_, &push_freq_mgr_);
+
+  auto push = [&](int num_records) {
+    for (int i = 0; i < num_records; ++i) {
+      DataTable::RecordBuilder<&kSchema> r(&data_table, i);
+      r.Append<r.ColIndex("time_")>(i);
+    }
+    scheduler.PushingData(data_tables);
+    data_table.ConsumeRecords();
+  };
+
+  // Few records per push: push less often.
+  for (int i = 0; i < 10; ++i) {
+    push(10);
+  }
+  EXPECT_EQ(push_freq_mgr_.period(), 4 * kPushPeriod);
+
+  // Tables more than half full at every push: push more often.
+  for (int i = 0; i < 10; ++i) {
+    push(800);
+  }
+  EXPECT_EQ(push_freq_mgr_.period(), kPushPeriod / 4);
+}
+
+TEST_F(AdaptiveSchedulerSimulationTest, ExportsMetrics) {
+  AdaptiveScheduler scheduler("metrics_source", &sampling_freq_mgr_, &push_freq_mgr_);
+  scheduler.TransferredData(milliseconds{1}, 1.0);
+
+  double period_ms = -1;
+  double num_shortened = -1;
+  for (const auto& family : GetMetricsRegistry().Collect()) {
+    for (const auto& metric : family.metric) {
+      if (metric.label.empty() || metric.label[0].value != "metrics_source") {
+        continue;
+      }
+      if (family.name == "stirling_sampling_period_ms") {
+        period_ms = metric.gauge.value;
+      }
+      if (family.name == "stirling_sampling_period_shortened") {
+        num_shortened = metric.counter.value;
+      }
+    }
+  }
+  EXPECT_EQ(period_ms, (kSamplingPeriod / 2).count());
+  EXPECT_EQ(num_shortened, 1);
+}
+
+}  // namespace stirling
+}  // namespace px
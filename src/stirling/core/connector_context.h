@@ -53,7 +53,7 @@ class ConnectorContext {
   /**
    * Return detailed information on UPIDs.
    */
-  virtual const absl::flat_hash_map<md::UPID, md::PIDInfoUPtr>& GetPIDInfoMap() const = 0;
+  virtual const md::PIDInfoMap& GetPIDInfoMap() const = 0;
 
   /**
    * Return K8s information (Pod and container information)
@@ -90,7 +90,7 @@ class AgentContext : public ConnectorContext {
     return agent_metadata_state_->upids();
   }
 
-  const absl::flat_hash_map<md::UPID, md::PIDInfoUPtr>& GetPIDInfoMap() const override {
+  const md::PIDInfoMap& GetPIDInfoMap() const override {
     return agent_metadata_state_->pids_by_upid();
   }
 
@@ -117,7 +117,7 @@ class StandaloneContext : public ConnectorContext {
 
   const absl::flat_hash_set<md::UPID>& GetUPIDs() const override { return upids_; }
 
-  const absl::flat_hash_map<md::UPID, md::PIDInfoUPtr>& GetPIDInfoMap() const override {
+  const md::PIDInfoMap& GetPIDInfoMap() const override {
     return upid_pidinfo_map_;
   }
 
@@ -132,7 +132,7 @@ class StandaloneContext : public ConnectorContext {
 
  protected:
   absl::flat_hash_set<md::UPID> upids_;
-  absl::flat_hash_map<md::UPID, md::PIDInfoUPtr> upid_pidinfo_map_;
+  md::PIDInfoMap upid_pidinfo_map_;
 
  private:
   std::vector<CIDRBlock> cidrs_;
@@ -17,6 +17,7 @@
  */
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -42,6 +43,15 @@ void DataTable::InitBuffers(types::ColumnWrapperRecordBatch* record_batch_ptr) {
   for (const auto& element : table_schema_.elements()) {
     px::types::DataType type = element.type();
 
+    // Strings are copied into an arena per column, which the table store wraps into Arrow arrays
+    // without copying it again.
+    if (type == types::DataType::STRING) {
+      auto col = std::make_shared<types::StringArenaColumnWrapper>();
+      col->Reserve(kTargetCapacity);
+      record_batch_ptr->push_back(col);
+      continue;
+    }
+
 #define TYPE_CASE(_dt_)                           \
   auto col = types::ColumnWrapper::Make(_dt_, 0); \
   col->Reserve(kTargetCapacity);                  \
@@ -59,6 +69,23 @@ Tablet* DataTable::GetTablet(types::TabletIDView tablet_id) {
   return &tablet;
 }
 
+void DataTable::MoveRecordsFrom(DataTable* other) {
+  DCHECK_EQ(&table_schema_, &other->table_schema_);
+
+  for (auto& [tablet_id, other_tablet] : other->tablets_) {
+    if (other_tablet.times.empty()) {
+      continue;
+    }
+    Tablet* tablet = GetTablet(tablet_id);
+    tablet->times.insert(tablet->times.end(), other_tablet.times.begin(),
+                         other_tablet.times.end());
+    other_tablet.times.clear();
+    for (size_t i = 0; i < tablet->records.size(); ++i) {
+      tablet->records[i]->MoveAppend(other_tablet.records[i].get());
+    }
+  }
+}
+
 std::vector<TaggedRecordBatch> DataTable::ConsumeRecords() {
   std::vector<TaggedRecordBatch> tablets_out;
   absl::flat_hash_map<types::TabletID, Tablet> carryover_tablets;
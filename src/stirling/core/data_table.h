@@ -105,6 +105,13 @@ class DataTable : public NotCopyable {
    */
   double OccupancyPct() const { return 1.0 * Occupancy() / kTargetCapacity; }
 
+  /**
+   * Moves all the records buffered in other, which must have the same schema, into this table.
+   * Used to merge records that were built in a separate table, for example by another thread.
+   * Other is left empty, and can be reused to build more records.
+   */
+  void MoveRecordsFrom(DataTable* other);
+
   // Example usage:
   // DataTable::RecordBuilder<&kTable> r(data_table, time);
   // r.Append<r.ColIndex("field0")>(val0);
@@ -162,7 +169,6 @@ class DataTable : public NotCopyable {
           val.resize(max_string_bytes);
           val.append(kTruncatedMsg);
         }
-        val.shrink_to_fit();
       }
 
       tablet_.records[TIndex]->Append(std::move(val));
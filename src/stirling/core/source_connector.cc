@@ -39,6 +39,11 @@ Status SourceConnector::Init() {
   DCHECK_NE(sampling_freq_mgr_.period().count(), 0) << "Sampling period has not been initialized";
   DCHECK_NE(push_freq_mgr_.period().count(), 0) << "Push period has not been initialized";
 
+  if (s.ok() && FLAGS_stirling_adaptive_scheduling) {
+    adaptive_scheduler_ =
+        std::make_unique<AdaptiveScheduler>(name(), &sampling_freq_mgr_, &push_freq_mgr_);
+  }
+
   return s;
 }
 
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,6 +27,7 @@
 #include "src/common/base/base.h"
 #include "src/common/system/system.h"
 #include "src/shared/types/types.h"
+#include "src/stirling/core/adaptive_scheduler.h"
 #include "src/stirling/core/connector_context.h"
 #include "src/stirling/core/data_table.h"
 #include "src/stirling/core/frequency_manager.h"
@@ -122,6 +125,19 @@ class SourceConnector : public NotCopyable {
 
   FrequencyManager& sampling_freq_mgr() { return sampling_freq_mgr_; }
   FrequencyManager& push_freq_mgr() { return push_freq_mgr_; }
+
+  /**
+   * The scheduler that adapts the sampling and push periods to the load of the connector.
+   * Null unless --stirling_adaptive_scheduling is set.
+   */
+  AdaptiveScheduler* adaptive_scheduler() { return adaptive_scheduler_.get(); }
+
+  /**
+   * Returns how full the input buffers of the connector (e.g. BPF perf buffers) were when the last
+   * TransferData() drained them, as a fraction of their capacity. Connectors that don't buffer
+   * their input return nullopt.
+   */
+  virtual std::optional<double> InputBufferOccupancy() const { return std::nullopt; }
   const std::vector<DataTable*>& data_tables() const { return data_tables_; }
 
   void set_data_tables(std::vector<DataTable*> data_tables) {
@@ -159,6 +175,7 @@ class SourceConnector : public NotCopyable {
 
   FrequencyManager sampling_freq_mgr_;
   FrequencyManager push_freq_mgr_;
+  std::unique_ptr<AdaptiveScheduler> adaptive_scheduler_;
 
   std::vector<DataTable*> data_tables_;
 
@@ -54,8 +54,18 @@ uint64_t ElfAddressConverter::BinaryAddrToVirtualAddr(uint64_t binary_addr) cons
  **/
 StatusOr<std::unique_ptr<ElfAddressConverter>> ElfAddressConverter::Create(ElfReader* elf_reader,
                                                                            int64_t pid) {
+  const ELFIO::Elf_Half elf_type = elf_reader->ELFType();
+  uint64_t virtual_addr_at_offset_zero = 0;
+  if (elf_type == ELFIO::ET_DYN) {
+    PX_ASSIGN_OR_RETURN(virtual_addr_at_offset_zero, elf_reader->GetVirtualAddrAtOffsetZero());
+  }
+  return Create(elf_type, virtual_addr_at_offset_zero, pid);
+}
+
+StatusOr<std::unique_ptr<ElfAddressConverter>> ElfAddressConverter::Create(
+    ELFIO::Elf_Half elf_type, uint64_t virtual_addr_at_offset_zero, int64_t pid) {
   // If the binary is not a PIE binary, then we can skip calculating the offset.
-  if (elf_reader->ELFType() != ELFIO::ET_DYN) {
+  if (elf_type != ELFIO::ET_DYN) {
     return std::unique_ptr<ElfAddressConverter>(new ElfAddressConverter(0));
   }
   if (pid <= 0) {
@@ -81,9 +91,7 @@ StatusOr<std::unique_ptr<ElfAddressConverter>> ElfAddressConverter::Create(ElfRe
 
   const uint64_t mapped_segment_start = mapped_virt_addr - mapped_offset;
 
-  PX_ASSIGN_OR_RETURN(auto elf_segment_start, elf_reader->GetVirtualAddrAtOffsetZero());
-
-  const int64_t virtual_to_binary_addr_offset = elf_segment_start - mapped_segment_start;
+  const int64_t virtual_to_binary_addr_offset = virtual_addr_at_offset_zero - mapped_segment_start;
   return std::unique_ptr<ElfAddressConverter>(
       new ElfAddressConverter(virtual_to_binary_addr_offset));
 }
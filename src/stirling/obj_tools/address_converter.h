@@ -30,6 +30,12 @@ namespace obj_tools {
 class ElfAddressConverter {
  public:
   static StatusOr<std::unique_ptr<ElfAddressConverter>> Create(ElfReader* elf_reader, int64_t pid);
+  /**
+   * Creates the converter from what Create() reads from the ELF file, for callers that have
+   * already read it. virtual_addr_at_offset_zero is only used for ET_DYN binaries.
+   */
+  static StatusOr<std::unique_ptr<ElfAddressConverter>> Create(
+      ELFIO::Elf_Half elf_type, uint64_t virtual_addr_at_offset_zero, int64_t pid);
   uint64_t VirtualAddrToBinaryAddr(uint64_t virtual_addr) const;
   uint64_t BinaryAddrToVirtualAddr(uint64_t binary_addr) const;
 
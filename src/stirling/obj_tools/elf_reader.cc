@@ -24,6 +24,7 @@
 #include <llvm/Support/TargetSelect.h>
 
 #include <absl/container/flat_hash_set.h>
+#include <algorithm>
 #include <set>
 #include <utility>
 
@@ -32,6 +33,10 @@
 #include "src/common/fs/fs_wrapper.h"
 #include "src/stirling/obj_tools/init.h"
 
+DEFINE_bool(stirling_elf_reader_mmap, gflags::BoolFromEnv("PL_STIRLING_ELF_READER_MMAP", true),
+            "If true, ELF files are mapped into memory instead of being read, so that only the "
+            "parts that are accessed are loaded.");
+
 namespace px {
 namespace stirling {
 namespace obj_tools {
@@ -52,10 +57,9 @@ Status ElfReader::LocateDebugSymbols(const std::filesystem::path& debug_file_dir
   bool found_symtab = false;
 
   // Scan all sections to find the symbol table (SHT_SYMTAB), or links to debug symbols.
-  ELFIO::Elf_Half sec_num = elf_reader_.sections.size();
-  for (int i = 0; i < sec_num; ++i) {
-    ELFIO::section* psec = elf_reader_.sections[i];
-    if (psec->get_type() == ELFIO::SHT_SYMTAB) {
+  for (size_t i = 0; i < sections_.size(); ++i) {
+    const SectionHeader& section = sections_[i];
+    if (section.type == ELFIO::SHT_SYMTAB) {
       found_symtab = true;
     }
 
@@ -65,33 +69,43 @@ Status ElfReader::LocateDebugSymbols(const std::filesystem::path& debug_file_dir
     // For more details: https://sourceware.org/gdb/onlinedocs/gdb/Separate-Debug-Files.html
 
     // Method 1: build-id.
-    if (psec->get_name() == ".note.gnu.build-id") {
+    if (section.name == ".note.gnu.build-id") {
       // Structure of this section:
       //    namesz :   32-bit, size of "name" field
       //    descsz :   32-bit, size of "desc" field
       //    type   :   32-bit, vendor specific "type"
       //    name   :   "namesz" bytes, null-terminated string
       //    desc   :   "descsz" bytes, binary data
+      PX_ASSIGN_OR_RETURN(std::string_view data, SectionData(i));
+      if (data.size() < 3 * sizeof(int32_t)) {
+        continue;
+      }
       int32_t name_size =
-          utils::LEndianBytesToInt<int32_t>(std::string_view(psec->get_data(), sizeof(int32_t)));
+          utils::LEndianBytesToInt<int32_t>(std::string_view(data.data(), sizeof(int32_t)));
       int32_t desc_size = utils::LEndianBytesToInt<int32_t>(
-          std::string_view(psec->get_data() + sizeof(int32_t), sizeof(int32_t)));
+          std::string_view(data.data() + sizeof(int32_t), sizeof(int32_t)));
 
       int32_t desc_pos = 3 * sizeof(int32_t) + name_size;
-      std::string_view desc = std::string_view(psec->get_data() + desc_pos, desc_size);
+      std::string_view desc = data.substr(std::min<size_t>(desc_pos, data.size()), desc_size);
 
       build_id = BytesToString<LowercaseHex>(desc);
       VLOG(1) << absl::Substitute("Found build-id: $0", build_id);
     }
 
     // Method 2: .gnu_debuglink.
-    if (psec->get_name() == ".gnu_debuglink") {
+    if (section.name == ".gnu_debuglink") {
       constexpr int kCRCBytes = 4;
-      debug_link = std::string(psec->get_data(), psec->get_size() - kCRCBytes);
+      PX_ASSIGN_OR_RETURN(std::string_view data, SectionData(i));
+      if (data.size() < kCRCBytes) {
+        continue;
+      }
+      debug_link = std::string(data.substr(0, data.size() - kCRCBytes));
       VLOG(1) << absl::Substitute("Found debuglink: $0", debug_link);
     }
   }
 
+  build_id_ = build_id;
+
   // In priority order, we try:
   //  1) Accessing included symtab section.
   //  2) Finding debug symbols via build-id.
@@ -167,9 +181,7 @@ StatusOr<std::unique_ptr<ElfReader>> ElfReader::Create(
 
   elf_reader->binary_path_ = binary_path;
 
-  if (!elf_reader->elf_reader_.load_header_and_sections(binary_path)) {
-    return error::Internal("Can't find or process ELF file $0", binary_path);
-  }
+  PX_RETURN_IF_ERROR(elf_reader->Load(binary_path));
 
   // Check for external debug symbols.
   Status s = elf_reader->LocateDebugSymbols(debug_file_dir);
@@ -184,8 +196,13 @@ StatusOr<std::unique_ptr<ElfReader>> ElfReader::Create(
       std::string debug_symbols_path = elf_reader->debug_symbols_path_.string();
       LOG(INFO) << absl::Substitute("Found debug symbols file $0 for binary $1", debug_symbols_path,
                                     binary_path);
-      elf_reader->elf_reader_.load_header_and_sections(debug_symbols_path);
-      return elf_reader;
+      Status load_status = elf_reader->Load(debug_symbols_path);
+      if (load_status.ok()) {
+        return elf_reader;
+      }
+      LOG(WARNING) << absl::Substitute("Failed to load debug symbols file $0 [error=$1]",
+                                       debug_symbols_path, load_status.msg());
+      PX_RETURN_IF_ERROR(elf_reader->Load(binary_path));
     }
   }
 
@@ -194,43 +211,156 @@ StatusOr<std::unique_ptr<ElfReader>> ElfReader::Create(
   return elf_reader;
 }
 
-StatusOr<ELFIO::section*> ElfReader::SymtabSection() {
-  ELFIO::section* symtab_section = nullptr;
+Status ElfReader::Load(const std::string& path) {
+  sections_.clear();
+  segments_.clear();
+  symbol_addr_index_.clear();
+  symbol_addrs_indexed_ = false;
+  mapped_file_.reset();
+
+  if (FLAGS_stirling_elf_reader_mmap) {
+    auto mapped_file_or = MappedElfFile::Create(path);
+    if (mapped_file_or.ok()) {
+      mapped_file_ = mapped_file_or.ConsumeValueOrDie();
+      elf_type_ = mapped_file_->type();
+      machine_ = mapped_file_->machine();
+      for (const auto& section : mapped_file_->sections()) {
+        sections_.push_back({std::string(section.name), section.type, section.address,
+                             section.offset, section.size});
+      }
+      for (const auto& segment : mapped_file_->segments()) {
+        segments_.push_back({segment.type, segment.offset, segment.virtual_address});
+      }
+      return Status::OK();
+    }
+    VLOG(1) << absl::Substitute("Could not map $0, falling back to reading it [error=$1]", path,
+                                mapped_file_or.msg());
+  }
+
+  if (!elf_reader_.load_header_and_sections(path)) {
+    return error::Internal("Can't find or process ELF file $0", path);
+  }
+  elf_type_ = elf_reader_.get_type();
+  machine_ = elf_reader_.get_machine();
   for (int i = 0; i < elf_reader_.sections.size(); ++i) {
     ELFIO::section* psec = elf_reader_.sections[i];
-    if (psec->get_type() == ELFIO::SHT_SYMTAB) {
-      symtab_section = psec;
+    sections_.push_back({psec->get_name(), psec->get_type(), psec->get_address(),
+                         psec->get_offset(), psec->get_size()});
+  }
+  for (int i = 0; i < elf_reader_.segments.size(); ++i) {
+    ELFIO::segment* pseg = elf_reader_.segments[i];
+    segments_.push_back({pseg->get_type(), pseg->get_offset(), pseg->get_virtual_address()});
+  }
+  return Status::OK();
+}
+
+StatusOr<std::string_view> ElfReader::SectionData(size_t section_index) {
+  if (mapped_file_ != nullptr) {
+    return mapped_file_->SectionData(mapped_file_->sections()[section_index]);
+  }
+  ELFIO::section* psec = elf_reader_.sections[section_index];
+  if (psec->get_data() == nullptr) {
+    return std::string_view();
+  }
+  return std::string_view(psec->get_data(), psec->get_size());
+}
+
+StatusOr<size_t> ElfReader::SymtabSection() {
+  std::optional<size_t> symtab_section;
+  for (size_t i = 0; i < sections_.size(); ++i) {
+    if (sections_[i].type == ELFIO::SHT_SYMTAB) {
+      symtab_section = i;
       break;
     }
-    if (psec->get_type() == ELFIO::SHT_DYNSYM) {
-      symtab_section = psec;
+    if (sections_[i].type == ELFIO::SHT_DYNSYM) {
+      symtab_section = i;
       // Dynsym is a fall-back, so don't break. We might still find the symtab section.
     }
   }
-  if (symtab_section == nullptr) {
+  if (!symtab_section.has_value()) {
     return error::NotFound("Could not find symtab section in binary=$0", binary_path_);
   }
 
-  return symtab_section;
+  return symtab_section.value();
+}
+
+template <typename TFn>
+Status ElfReader::ForEachSymbol(TFn fn) {
+  PX_ASSIGN_OR_RETURN(size_t symtab_section, SymtabSection());
+
+  if (mapped_file_ != nullptr) {
+    PX_ASSIGN_OR_RETURN(
+        MappedElfFile::SymbolTable symbols,
+        mapped_file_->GetSymbolTable(mapped_file_->sections()[symtab_section]));
+    for (size_t j = 0; j < symbols.size(); ++j) {
+      const MappedElfFile::Symbol symbol = symbols.at(j);
+      if (!fn(j, SymbolRef{symbol.name, symbol.type, symbol.address, symbol.size})) {
+        break;
+      }
+    }
+    return Status::OK();
+  }
+
+  const ELFIO::symbol_section_accessor symbols(elf_reader_,
+                                               elf_reader_.sections[symtab_section]);
+  for (unsigned int j = 0; j < symbols.get_symbols_num(); ++j) {
+    // Call ELFIO to get symbol by index.
+    // ELFIO looks up the index and then populates name, addr, size, type, etc.
+    // We only care about the name, addr, size and type, but need to declare the other variables
+    // as well.
+    std::string name;
+    ELFIO::Elf64_Addr addr = 0;
+    ELFIO::Elf_Xword size = 0;
+    unsigned char bind = 0;
+    unsigned char type = ELFIO::STT_NOTYPE;
+    ELFIO::Elf_Half section_index;
+    unsigned char other;
+    symbols.get_symbol(j, name, addr, size, bind, type, section_index, other);
+
+    if (!fn(j, SymbolRef{name, type, addr, size})) {
+      break;
+    }
+  }
+  return Status::OK();
+}
+
+Status ElfReader::IndexSymbolAddrs() {
+  if (symbol_addrs_indexed_) {
+    return Status::OK();
+  }
+
+  std::vector<SymbolAddrEntry> index;
+  uint64_t max_symbol_size = 0;
+  PX_RETURN_IF_ERROR(ForEachSymbol([&](size_t j, const SymbolRef& symbol) {
+    index.push_back({symbol.address, symbol.size, static_cast<uint32_t>(j)});
+    max_symbol_size = std::max(max_symbol_size, symbol.size);
+    return true;
+  }));
+  // Symbols at the same address stay in symbol table order.
+  std::stable_sort(index.begin(), index.end(),
+                   [](const SymbolAddrEntry& a, const SymbolAddrEntry& b) {
+                     return a.address < b.address;
+                   });
+
+  symbol_addr_index_ = std::move(index);
+  max_symbol_size_ = max_symbol_size;
+  symbol_addrs_indexed_ = true;
+  return Status::OK();
 }
 
-// TODO(ddelnano): This function only works with sections that exist in LOAD segments.
-// This function should be able to handle any section, but for the time being its is limited
-// in scope.
 StatusOr<int32_t> ElfReader::FindSegmentOffsetOfSection(std::string_view section_name) {
-  PX_ASSIGN_OR_RETURN(ELFIO::section * text_section, SectionWithName(section_name));
-  auto section_offset = text_section->get_offset();
+  PX_ASSIGN_OR_RETURN(const SectionHeader* text_section, SectionWithName(section_name));
+  auto section_offset = text_section->offset;
 
-  for (int i = 0; i < elf_reader_.segments.size() - 1; ++i) {
-    ELFIO::segment* current_segment = elf_reader_.segments[i];
-    ELFIO::segment* next_segment = elf_reader_.segments[i + 1];
+  for (size_t i = 0; i + 1 < segments_.size(); ++i) {
+    const SegmentHeader& current_segment = segments_[i];
+    const SegmentHeader& next_segment = segments_[i + 1];
 
     auto expected_type = ELFIO::PT_LOAD;
-    if (current_segment->get_type() != expected_type || next_segment->get_type() != expected_type)
-      continue;
+    if (current_segment.type != expected_type || next_segment.type != expected_type) continue;
 
-    auto current_segment_offset = current_segment->get_offset();
-    auto next_segment_offset = next_segment->get_offset();
+    auto current_segment_offset = current_segment.offset;
+    auto next_segment_offset = next_segment.offset;
 
     // Check to see if the section we are searching for exists
     // between the two contiguous segments we are looping through.
@@ -248,36 +378,22 @@ static auto NoTextStartAddrError =
 StatusOr<std::vector<ElfReader::SymbolInfo>> ElfReader::SearchSymbols(
     std::string_view search_symbol, SymbolMatchType match_type, std::optional<int> symbol_type,
     bool stop_at_first_match) {
-  PX_ASSIGN_OR_RETURN(ELFIO::section * symtab_section, SymtabSection());
-
   std::vector<SymbolInfo> symbol_infos;
 
   // Scan all symbols inside the symbol table.
-  const ELFIO::symbol_section_accessor symbols(elf_reader_, symtab_section);
-  for (unsigned int j = 0; j < symbols.get_symbols_num(); ++j) {
-    std::string name;
-    ELFIO::Elf64_Addr addr = 0;
-    ELFIO::Elf_Xword size = 0;
-    unsigned char bind = 0;
-    unsigned char type = ELFIO::STT_NOTYPE;
-    ELFIO::Elf_Half section_index;
-    unsigned char other;
-    symbols.get_symbol(j, name, addr, size, bind, type, section_index, other);
-
-    if (symbol_type.has_value() && type != symbol_type.value()) {
-      continue;
+  PX_RETURN_IF_ERROR(ForEachSymbol([&](size_t, const SymbolRef& symbol) {
+    if (symbol_type.has_value() && symbol.type != symbol_type.value()) {
+      return true;
     }
 
-    if (!MatchesSymbol(name, {match_type, search_symbol})) {
-      continue;
+    if (!MatchesSymbol(symbol.name, {match_type, search_symbol})) {
+      return true;
     }
 
-    symbol_infos.push_back({std::move(name), type, addr, size});
+    symbol_infos.push_back({std::string(symbol.name), symbol.type, symbol.address, symbol.size});
 
-    if (stop_at_first_match) {
-      break;
-    }
-  }
+    return !stop_at_first_match;
+  }));
   return symbol_infos;
 }
 
@@ -325,92 +441,115 @@ std::optional<int64_t> ElfReader::SymbolAddress(std::string_view symbol) {
 }
 
 StatusOr<std::optional<std::string>> ElfReader::AddrToSymbol(size_t sym_addr) {
-  PX_ASSIGN_OR_RETURN(ELFIO::section * symtab_section, SymtabSection());
-
-  const ELFIO::symbol_section_accessor symbols(elf_reader_, symtab_section);
-
-  // Call ELFIO to get symbol by address.
-  // ELFIO looks up the symbol and then populates name, size, type, etc.
-  // We only care about the name, but need to declare the other variables as well.
-  const ELFIO::Elf64_Addr addr = sym_addr;
-  std::string name;
-  ELFIO::Elf_Xword size = 0;
-  unsigned char bind = 0;
-  unsigned char type = ELFIO::STT_NOTYPE;
-  ELFIO::Elf_Half section_index;
-  unsigned char other;
-  bool found = symbols.get_symbol(addr, name, size, bind, type, section_index, other);
-
-  if (!found) {
+  PX_RETURN_IF_ERROR(IndexSymbolAddrs());
+
+  // The first symbol of the symbol table at the address. Symbols at the same address are in symbol
+  // table order in the index.
+  auto iter = std::lower_bound(
+      symbol_addr_index_.begin(), symbol_addr_index_.end(), sym_addr,
+      [](const SymbolAddrEntry& entry, uint64_t addr) { return entry.address < addr; });
+  if (iter == symbol_addr_index_.end() || iter->address != sym_addr) {
     return std::optional<std::string>();
   }
 
+  PX_ASSIGN_OR_RETURN(std::string name, SymbolName(iter->symbol_index));
   return std::optional<std::string>(std::move(name));
 }
 
-// TODO(oazizi): Optimize by indexing or switching to binary search if we can guarantee addresses
-//               are ordered.
 StatusOr<std::optional<std::string>> ElfReader::InstrAddrToSymbol(size_t sym_addr) {
-  PX_ASSIGN_OR_RETURN(ELFIO::section * symtab_section, SymtabSection());
+  PX_RETURN_IF_ERROR(IndexSymbolAddrs());
+
+  // Look for the first symbol of the symbol table whose body contains the address, among the
+  // symbols that start at most max_symbol_size_ before the address.
+  std::optional<uint32_t> symbol_index;
+  auto iter = std::upper_bound(
+      symbol_addr_index_.begin(), symbol_addr_index_.end(), sym_addr,
+      [](uint64_t addr, const SymbolAddrEntry& entry) { return addr < entry.address; });
+  while (iter != symbol_addr_index_.begin()) {
+    --iter;
+    if (sym_addr - iter->address >= max_symbol_size_) {
+      break;
+    }
+    if (sym_addr < iter->address + iter->size &&
+        (!symbol_index.has_value() || iter->symbol_index < symbol_index.value())) {
+      symbol_index = iter->symbol_index;
+    }
+  }
 
-  const ELFIO::symbol_section_accessor symbols(elf_reader_, symtab_section);
-  for (unsigned int j = 0; j < symbols.get_symbols_num(); ++j) {
-    // Call ELFIO to get symbol by index.
-    // ELFIO looks up the index and then populates name, addr, size, type, etc.
-    // We only care about the name and addr, but need to declare the other variables as well.
-    std::string name;
-    ELFIO::Elf64_Addr addr = 0;
-    ELFIO::Elf_Xword size = 0;
-    unsigned char bind = 0;
-    unsigned char type = ELFIO::STT_NOTYPE;
-    ELFIO::Elf_Half section_index;
-    unsigned char other;
-    symbols.get_symbol(j, name, addr, size, bind, type, section_index, other);
+  if (!symbol_index.has_value()) {
+    return std::optional<std::string>();
+  }
+  PX_ASSIGN_OR_RETURN(std::string name, SymbolName(symbol_index.value()));
+  return std::optional<std::string>(llvm::demangle(name));
+}
 
-    if (sym_addr >= addr && sym_addr < addr + size) {
-      return std::optional<std::string>(llvm::demangle(name));
-    }
+StatusOr<std::string> ElfReader::SymbolName(size_t symbol_index) {
+  PX_ASSIGN_OR_RETURN(size_t symtab_section, SymtabSection());
+
+  if (mapped_file_ != nullptr) {
+    PX_ASSIGN_OR_RETURN(
+        MappedElfFile::SymbolTable symbols,
+        mapped_file_->GetSymbolTable(mapped_file_->sections()[symtab_section]));
+    return std::string(symbols.at(symbol_index).name);
   }
 
-  return std::optional<std::string>();
+  const ELFIO::symbol_section_accessor symbols(elf_reader_,
+                                               elf_reader_.sections[symtab_section]);
+  std::string name;
+  ELFIO::Elf64_Addr addr = 0;
+  ELFIO::Elf_Xword size = 0;
+  unsigned char bind = 0;
+  unsigned char type = ELFIO::STT_NOTYPE;
+  ELFIO::Elf_Half section_index;
+  unsigned char other;
+  symbols.get_symbol(symbol_index, name, addr, size, bind, type, section_index, other);
+  return name;
 }
 
 StatusOr<std::unique_ptr<ElfReader::Symbolizer>> ElfReader::GetSymbolizer() {
-  PX_ASSIGN_OR_RETURN(ELFIO::section * symtab_section, SymtabSection());
-
   auto symbolizer = std::make_unique<ElfReader::Symbolizer>();
 
-  const ELFIO::symbol_section_accessor symbols(elf_reader_, symtab_section);
-  for (unsigned int j = 0; j < symbols.get_symbols_num(); ++j) {
-    // Call ELFIO to get symbol by index.
-    // ELFIO looks up the index and then populates name, addr, size, type, etc.
-    // We only care about the name and addr, but need to declare the other variables as well.
-    std::string name;
-    ELFIO::Elf64_Addr addr = 0;
-    ELFIO::Elf_Xword size = 0;
-    unsigned char bind = 0;
-    unsigned char type = ELFIO::STT_NOTYPE;
-    ELFIO::Elf_Half section_index;
-    unsigned char other;
-    symbols.get_symbol(j, name, addr, size, bind, type, section_index, other);
-
-    if (type == ELFIO::STT_FUNC) {
-      symbolizer->AddEntry(addr, size, llvm::demangle(name));
+  PX_RETURN_IF_ERROR(ForEachSymbol([&](size_t, const SymbolRef& symbol) {
+    if (symbol.type == ELFIO::STT_FUNC) {
+      symbolizer->AddEntry(symbol.address, symbol.size, llvm::demangle(std::string(symbol.name)));
     }
-  }
+    return true;
+  }));
+  symbolizer->Finalize();
 
   return symbolizer;
 }
 
-void ElfReader::Symbolizer::AddEntry(size_t addr, size_t size, std::string name) {
-  symbols_.emplace(addr, SymbolAddrInfo{size, std::move(name)});
+void ElfReader::Symbolizer::AddEntry(size_t addr, size_t size, std::string_view name) {
+  auto [iter, inserted] =
+      name_offsets_.try_emplace(std::string(name), static_cast<uint32_t>(names_.size()));
+  if (inserted) {
+    names_.append(name);
+  }
+  symbols_.push_back(
+      SymbolAddrInfo{addr, size, iter->second, static_cast<uint32_t>(name.size())});
+}
+
+void ElfReader::Symbolizer::Finalize() {
+  std::stable_sort(
+      symbols_.begin(), symbols_.end(),
+      [](const SymbolAddrInfo& a, const SymbolAddrInfo& b) { return a.addr < b.addr; });
+  auto last = std::unique(
+      symbols_.begin(), symbols_.end(),
+      [](const SymbolAddrInfo& a, const SymbolAddrInfo& b) { return a.addr == b.addr; });
+  symbols_.erase(last, symbols_.end());
+  symbols_.shrink_to_fit();
+  names_.shrink_to_fit();
+  name_offsets_ = {};
 }
 
 std::string_view ElfReader::Symbolizer::Lookup(size_t addr) const {
   static std::string symbol_str;
 
   // Find the first symbol for which the address_range_start > addr.
-  auto iter = symbols_.upper_bound(addr);
+  auto iter = std::upper_bound(
+      symbols_.begin(), symbols_.end(), addr,
+      [](uintptr_t addr, const SymbolAddrInfo& symbol) { return addr < symbol.addr; });
 
   if (iter == symbols_.begin() || symbols_.empty()) {
     symbol_str = absl::StrFormat("0x%016llx", addr);
@@ -420,8 +559,8 @@ std::string_view ElfReader::Symbolizer::Lookup(size_t addr) const {
   // std::upper_bound will make us overshoot our potential match,
   // so go back by one, and check if it is indeed a match.
   --iter;
-  if (addr >= iter->first && addr < iter->first + iter->second.size) {
-    return iter->second.name;
+  if (addr >= iter->addr && addr < iter->addr + iter->size) {
+    return std::string_view(names_).substr(iter->name_offset, iter->name_size);
   }
 
   // Couldn't find the address.
@@ -587,7 +726,7 @@ StatusOr<Arch> GetArchFromELFMachine(ELFIO::Elf_Half machine) {
 StatusOr<std::vector<uint64_t>> ElfReader::FuncRetInstAddrs(const SymbolInfo& func_symbol) {
   constexpr std::string_view kDotText = ".text";
   PX_ASSIGN_OR_RETURN(utils::u8string byte_code, SymbolByteCode(kDotText, func_symbol));
-  PX_ASSIGN_OR_RETURN(auto arch, GetArchFromELFMachine(elf_reader_.get_machine()));
+  PX_ASSIGN_OR_RETURN(auto arch, GetArchFromELFMachine(machine_));
   std::vector<uint64_t> addrs = FindRetInsts(arch, byte_code);
   for (auto& offset : addrs) {
     offset += func_symbol.address;
@@ -595,11 +734,11 @@ StatusOr<std::vector<uint64_t>> ElfReader::FuncRetInstAddrs(const SymbolInfo& fu
   return addrs;
 }
 
-StatusOr<ELFIO::section*> ElfReader::SectionWithName(std::string_view section_name) {
-  for (int i = 0; i < elf_reader_.sections.size(); ++i) {
-    ELFIO::section* psec = elf_reader_.sections[i];
-    if (psec->get_name() == section_name) {
-      return psec;
+StatusOr<const ElfReader::SectionHeader*> ElfReader::SectionWithName(
+    std::string_view section_name) {
+  for (const SectionHeader& section : sections_) {
+    if (section.name == section_name) {
+      return &section;
     }
   }
   return error::NotFound("Could not find section=$0 in binary=$1", section_name, binary_path_);
@@ -607,8 +746,8 @@ StatusOr<ELFIO::section*> ElfReader::SectionWithName(std::string_view section_na
 
 StatusOr<utils::u8string> ElfReader::SymbolByteCode(std::string_view section,
                                                     const SymbolInfo& symbol) {
-  PX_ASSIGN_OR_RETURN(ELFIO::section * text_section, SectionWithName(section));
-  int offset = symbol.address - text_section->get_address() + text_section->get_offset();
+  PX_ASSIGN_OR_RETURN(const SectionHeader* text_section, SectionWithName(section));
+  int offset = symbol.address - text_section->address + text_section->offset;
 
   std::ifstream ifs(binary_path_, std::ios::binary);
   if (!ifs.seekg(offset)) {
@@ -628,11 +767,10 @@ StatusOr<utils::u8string> ElfReader::SymbolByteCode(std::string_view section,
 }
 
 StatusOr<uint64_t> ElfReader::GetVirtualAddrAtOffsetZero() {
-  const ELFIO::segment* first_loadable_segment = nullptr;
-  for (int i = 0; i < elf_reader_.segments.size(); i++) {
-    ELFIO::segment* segment = elf_reader_.segments[i];
-    if (segment->get_type() == ELFIO::PT_LOAD) {
-      first_loadable_segment = segment;
+  const SegmentHeader* first_loadable_segment = nullptr;
+  for (const SegmentHeader& segment : segments_) {
+    if (segment.type == ELFIO::PT_LOAD) {
+      first_loadable_segment = &segment;
       break;
     }
   }
@@ -640,12 +778,12 @@ StatusOr<uint64_t> ElfReader::GetVirtualAddrAtOffsetZero() {
   if (first_loadable_segment == nullptr) {
     return Status(statuspb::INTERNAL, "No loadable segments in ELF file");
   }
-  uint64_t virt_addr = first_loadable_segment->get_virtual_address();
-  uint64_t offset = first_loadable_segment->get_offset();
+  uint64_t virt_addr = first_loadable_segment->virtual_address;
+  uint64_t offset = first_loadable_segment->offset;
   return virt_addr - offset;
 }
 
-ELFIO::Elf_Half ElfReader::ELFType() { return elf_reader_.get_type(); }
+ELFIO::Elf_Half ElfReader::ELFType() { return elf_type_; }
 
 }  // namespace obj_tools
 }  // namespace stirling
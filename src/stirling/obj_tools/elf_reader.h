@@ -21,16 +21,19 @@
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
-#include <absl/container/btree_map.h>
 #include <absl/container/flat_hash_map.h>
 
 #include <elfio/elfio.hpp>
 
 #include "src/common/base/base.h"
+#include "src/stirling/obj_tools/mapped_elf_file.h"
 #include "src/stirling/obj_tools/utils.h"
 
+DECLARE_bool(stirling_elf_reader_mmap);
+
 namespace px {
 namespace stirling {
 namespace obj_tools {
@@ -43,6 +46,10 @@ class ElfReader {
    * return for a symbol), as opposed to virtual addresses. The difference only matters for PIE
    * binaries.
    *
+   * 64-bit little-endian binaries are mapped into memory (unless --stirling_elf_reader_mmap is
+   * false), so that only the parts of the file that are accessed are read. Other binaries are
+   * read into memory.
+   *
    * @param binary_path Path to the binary to read.
    * @param debug_file_dir Location of external debug files.
    * @return error if could not setup elf reader.
@@ -123,27 +130,59 @@ class ElfReader {
    */
   StatusOr<std::optional<std::string>> InstrAddrToSymbol(size_t addr);
 
+  /**
+   * An address to symbol lookup table. The table is built with AddEntry() followed by Finalize(),
+   * and is immutable afterwards, so that it can be shared by all the processes running the same
+   * binary.
+   *
+   * The symbols are kept in a flat array sorted by address, and the names are interned into a
+   * single buffer.
+   */
   class Symbolizer {
    public:
     /**
      * Associate the address range [addr, addr+size] with the provided symbol name.
      * No checking is performed for overlapping regions, which will result in undefined behavior.
+     * If several symbols start at the same address, the first one added is kept.
+     */
+    void AddEntry(uintptr_t addr, size_t size, std::string_view name);
+
+    /**
+     * Sorts the entries and releases the memory only needed while adding them.
+     * Must be called after the last AddEntry() and before Lookup().
      */
-    void AddEntry(uintptr_t addr, size_t size, std::string name);
+    void Finalize();
 
     /**
      * Lookup the symbol for the specified address.
      */
     std::string_view Lookup(uintptr_t addr) const;
 
+    size_t NumSymbols() const { return symbols_.size(); }
+
+    /**
+     * Returns the memory used by the table.
+     */
+    size_t NumBytes() const {
+      return sizeof(*this) + symbols_.capacity() * sizeof(SymbolAddrInfo) + names_.capacity();
+    }
+
    private:
     struct SymbolAddrInfo {
+      uintptr_t addr;
       size_t size;
-      std::string name;
+      uint32_t name_offset;
+      uint32_t name_size;
     };
 
-    // Key is an address.
-    absl::btree_map<uintptr_t, SymbolAddrInfo> symbols_;
+    // Sorted by address once finalized.
+    std::vector<SymbolAddrInfo> symbols_;
+
+    // The names of all the symbols, each stored once.
+    std::string names_;
+
+    // Offsets of the names in names_, only used while adding entries.
+    absl::flat_hash_map<std::string, uint32_t> name_offsets_;
   };
 
   StatusOr<std::unique_ptr<Symbolizer>> GetSymbolizer();
@@ -169,15 +208,77 @@ class ElfReader {
    */
   ELFIO::Elf_Half ELFType();
 
+  /**
+   * Returns the GNU build-id of the binary as a lowercase hex string, or an empty string if the
+   * binary doesn't have one.
+   */
+  const std::string& build_id() const { return build_id_; }
+
  private:
   ElfReader() = default;
 
-  StatusOr<ELFIO::section*> SymtabSection();
+  struct SectionHeader {
+    std::string name;
+    uint32_t type;
+    uint64_t address;
+    uint64_t offset;
+    uint64_t size;
+  };
+
+  struct SegmentHeader {
+    uint32_t type;
+    uint64_t offset;
+    uint64_t virtual_address;
+  };
+
+  // A symbol of the symbol table. The name is only valid during the ForEachSymbol() callback.
+  struct SymbolRef {
+    std::string_view name;
+    unsigned char type;
+    uint64_t address;
+    uint64_t size;
+  };
+
+  // An entry of the address index of the symbol table.
+  struct SymbolAddrEntry {
+    uint64_t address;
+    uint64_t size;
+    uint32_t symbol_index;
+  };
+
+  /**
+   * Loads the headers of the ELF file, either by mapping the file (see MappedElfFile) or with
+   * ELFIO, which reads the sections into memory.
+   */
+  Status Load(const std::string& path);
+
+  StatusOr<size_t> SymtabSection();
+
+  /**
+   * Returns the contents of the section at the index.
+   */
+  StatusOr<std::string_view> SectionData(size_t section_index);
+
+  /**
+   * Calls fn(index, symbol) for the symbols of the symbol table, in order, until it returns false.
+   */
+  template <typename TFn>
+  Status ForEachSymbol(TFn fn);
+
+  /**
+   * Returns the name of the symbol at the index of the symbol table.
+   */
+  StatusOr<std::string> SymbolName(size_t symbol_index);
+
+  /**
+   * Builds symbol_addr_index_, if not already built.
+   */
+  Status IndexSymbolAddrs();
 
   /**
    * Returns the ELF section with the corresponding name
    */
-  StatusOr<ELFIO::section*> SectionWithName(std::string_view section_name);
+  StatusOr<const SectionHeader*> SectionWithName(std::string_view section_name);
 
   /**
    * Locates the debug symbols for the currently loaded ELF object.
@@ -197,7 +298,21 @@ class ElfReader {
 
   std::filesystem::path debug_symbols_path_;
 
-  // Set up an elf reader, so we can extract debug symbols.
+  std::string build_id_;
+
+  ELFIO::Elf_Half elf_type_ = ELFIO::ET_NONE;
+  ELFIO::Elf_Half machine_ = ELFIO::EM_NONE;
+  std::vector<SectionHeader> sections_;
+  std::vector<SegmentHeader> segments_;
+
+  // The symbols of the symbol table sorted by address, built on the first address lookup.
+  std::vector<SymbolAddrEntry> symbol_addr_index_;
+  uint64_t max_symbol_size_ = 0;
+  bool symbol_addrs_indexed_ = false;
+
+  // The loaded file. Exactly one of them is used: mapped_file_ if the file could be mapped,
+  // otherwise elf_reader_.
+  std::unique_ptr<MappedElfFile> mapped_file_;
   ELFIO::elfio elf_reader_;
 };
 
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include "src/common/base/base.h"
+#include "src/common/system/proc_parser.h"
+#include "src/common/testing/test_environment.h"
+#include "src/stirling/obj_tools/elf_reader.h"
+
+using px::stirling::obj_tools::ElfReader;
+using px::testing::BazelRunfilePath;
+
+constexpr std::string_view kBinary =
+    "src/stirling/testing/demo_apps/go_grpc_tls_pl/server/golang_1_19_grpc_tls_server_binary_/"
+    "golang_1_19_grpc_tls_server_binary";
+
+// Symbols looked up when deploying the Go TLS uprobes.
+const std::vector<std::string_view> kSymbols = {
+    "crypto/tls.(*Conn).Write",
+    "crypto/tls.(*Conn).Read",
+    "runtime.casgstatus",
+    "google.golang.org/grpc/internal/transport.(*http2Server).operateHeaders",
+};
+
+struct RSS {
+  int64_t anon_bytes = 0;
+  int64_t file_bytes = 0;
+};
+
+RSS GetRSS() {
+  const px::system::ProcParser proc_parser;
+  px::system::ProcParser::ProcessStatus status;
+  PX_CHECK_OK(proc_parser.ParseProcPIDStatus(getpid(), &status));
+  return {status.rss_anon_bytes, status.rss_file_bytes};
+}
+
+void SetRSSCounters(benchmark::State& state, const RSS& start, const RSS& end) {  // NOLINT
+  using benchmark::Counter;
+  state.counters["RssAnon"] =
+      Counter(end.anon_bytes - start.anon_bytes, Counter::kAvgIterations, Counter::OneK::kIs1024);
+  state.counters["RssFile"] =
+      Counter(end.file_bytes - start.file_bytes, Counter::kAvgIterations, Counter::OneK::kIs1024);
+}
+
+// Opens the binary and looks up a few symbols, like the uprobe deployment does.
+// range(0) selects between reading (0) and mapping (1) the binary.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_CreateAndSearchSymbols(benchmark::State& state) {
+  FLAGS_stirling_elf_reader_mmap = state.range(0);
+  const std::string binary = BazelRunfilePath(kBinary).string();
+
+  RSS start;
+  RSS end;
+  for (auto _ : state) {
+    state.PauseTiming();
+    const RSS iter_start = GetRSS();
+    state.ResumeTiming();
+
+    PX_ASSIGN_OR_EXIT(std::unique_ptr<ElfReader> elf_reader, ElfReader::Create(binary));
+    for (const auto symbol : kSymbols) {
+      benchmark::DoNotOptimize(elf_reader->SymbolAddress(symbol));
+    }
+
+    // Measured while the reader is still open.
+    state.PauseTiming();
+    const RSS iter_end = GetRSS();
+    start.anon_bytes += iter_start.anon_bytes;
+    start.file_bytes += iter_start.file_bytes;
+    end.anon_bytes += iter_end.anon_bytes;
+    end.file_bytes += iter_end.file_bytes;
+    state.ResumeTiming();
+  }
+  SetRSSCounters(state, start, end);
+}
+
+// Builds the symbolizer of the perf profiler.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_GetSymbolizer(benchmark::State& state) {
+  FLAGS_stirling_elf_reader_mmap = state.range(0);
+  const std::string binary = BazelRunfilePath(kBinary).string();
+
+  for (auto _ : state) {
+    PX_ASSIGN_OR_EXIT(std::unique_ptr<ElfReader> elf_reader, ElfReader::Create(binary));
+    PX_ASSIGN_OR_EXIT(auto symbolizer, elf_reader->GetSymbolizer());
+    benchmark::DoNotOptimize(symbolizer);
+  }
+}
+
+// Address to symbol lookups, which use the address index of the symbol table.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_InstrAddrToSymbol(benchmark::State& state) {
+  FLAGS_stirling_elf_reader_mmap = state.range(0);
+  const std::string binary = BazelRunfilePath(kBinary).string();
+  PX_ASSIGN_OR_EXIT(std::unique_ptr<ElfReader> elf_reader, ElfReader::Create(binary));
+
+  std::vector<uint64_t> addrs;
+  for (const auto symbol : kSymbols) {
+    PX_ASSIGN_OR_EXIT(ElfReader::SymbolInfo symbol_info, elf_reader->SearchTheOnlySymbol(symbol));
+    addrs.push_back(symbol_info.address + symbol_info.size / 2);
+  }
+
+  for (auto _ : state) {
+    for (const uint64_t addr : addrs) {
+      PX_ASSIGN_OR_EXIT(std::optional<std::string> symbol, elf_reader->InstrAddrToSymbol(addr));
+      benchmark::DoNotOptimize(symbol);
+    }
+  }
+}
+
+BENCHMARK(BM_CreateAndSearchSymbols)->Arg(false)->Arg(true);
+BENCHMARK(BM_GetSymbolizer)->Arg(false)->Arg(true);
+BENCHMARK(BM_InstrAddrToSymbol)->Arg(false)->Arg(true);
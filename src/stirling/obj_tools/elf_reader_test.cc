@@ -19,6 +19,7 @@
 #include "src/stirling/obj_tools/elf_reader.h"
 
 #include "src/common/exec/exec.h"
+#include "src/common/fs/fs_wrapper.h"
 #include "src/common/testing/test_environment.h"
 #include "src/common/testing/testing.h"
 #include "src/stirling/obj_tools/testdata/cc/test_exe_fixture.h"
@@ -193,6 +194,88 @@ TEST(ElfReaderTest, ExternalDebugSymbolsBuildID) {
 
   EXPECT_OK_AND_THAT(elf_reader->ListFuncSymbols("CanYouFindThis", SymbolMatchType::kExact),
                      ElementsAre(SymbolNameIs("CanYouFindThis")));
+  // The build-id is the one of the binary, and locates the debug symbols file.
+  EXPECT_TRUE(fs::Exists(absl::Substitute("$0/.build-id/$1/$2.debug", debug_dir,
+                                          elf_reader->build_id().substr(0, 2),
+                                          elf_reader->build_id().substr(2))));
+}
+
+TEST(ElfReaderTest, Symbolizer) {
+  ElfReader::Symbolizer symbolizer;
+  // Entries are added out of order, and some of them share a name.
+  symbolizer.AddEntry(300, 10, "baz");
+  symbolizer.AddEntry(100, 50, "foo");
+  symbolizer.AddEntry(200, 10, "foo");
+  symbolizer.AddEntry(100, 10, "bar");
+  symbolizer.Finalize();
+
+  EXPECT_EQ(symbolizer.NumSymbols(), 3);
+  EXPECT_EQ(symbolizer.Lookup(100), "foo");
+  EXPECT_EQ(symbolizer.Lookup(149), "foo");
+  EXPECT_EQ(symbolizer.Lookup(150), "0x0000000000000096");
+  EXPECT_EQ(symbolizer.Lookup(205), "foo");
+  EXPECT_EQ(symbolizer.Lookup(300), "baz");
+  EXPECT_EQ(symbolizer.Lookup(310), "0x0000000000000136");
+  EXPECT_EQ(symbolizer.Lookup(99), "0x0000000000000063");
+
+  // Both "foo" entries point at the same interned name.
+  EXPECT_EQ(symbolizer.Lookup(100).data(), symbolizer.Lookup(200).data());
+}
+
+TEST(ElfReaderTest, GetSymbolizer) {
+  const std::string path = kTestExeFixture.Path().string();
+  ASSERT_OK_AND_ASSIGN(const int64_t symbol_addr, NmSymbolNameToAddr(path, "CanYouFindThis"));
+
+  ASSERT_OK_AND_ASSIGN(std::unique_ptr<ElfReader> elf_reader, ElfReader::Create(path));
+  ASSERT_OK_AND_ASSIGN(std::unique_ptr<ElfReader::Symbolizer> symbolizer,
+                       elf_reader->GetSymbolizer());
+
+  EXPECT_EQ(symbolizer->Lookup(symbol_addr), "CanYouFindThis");
+  EXPECT_GT(symbolizer->NumSymbols(), 0);
+}
+
+// The mapped and the ELFIO backed readers give the same results.
+TEST(ElfReaderTest, MappedAndReadFilesMatch) {
+  const std::string path = kTestExeFixture.Path().string();
+  ASSERT_OK_AND_ASSIGN(const int64_t symbol_addr, NmSymbolNameToAddr(path, "CanYouFindThis"));
+
+  std::unique_ptr<ElfReader> mapped_reader;
+  std::unique_ptr<ElfReader> read_reader;
+  {
+    PX_SET_FOR_SCOPE(FLAGS_stirling_elf_reader_mmap, true);
+    ASSERT_OK_AND_ASSIGN(mapped_reader, ElfReader::Create(path));
+  }
+  {
+    PX_SET_FOR_SCOPE(FLAGS_stirling_elf_reader_mmap, false);
+    ASSERT_OK_AND_ASSIGN(read_reader, ElfReader::Create(path));
+  }
+
+  EXPECT_EQ(mapped_reader->ELFType(), read_reader->ELFType());
+  EXPECT_EQ(mapped_reader->build_id(), read_reader->build_id());
+  ASSERT_OK_AND_ASSIGN(uint64_t mapped_vaddr, mapped_reader->GetVirtualAddrAtOffsetZero());
+  ASSERT_OK_AND_ASSIGN(uint64_t read_vaddr, read_reader->GetVirtualAddrAtOffsetZero());
+  EXPECT_EQ(mapped_vaddr, read_vaddr);
+
+  ASSERT_OK_AND_ASSIGN(auto mapped_symbols,
+                       mapped_reader->ListFuncSymbols("", SymbolMatchType::kSubstr));
+  ASSERT_OK_AND_ASSIGN(auto read_symbols,
+                       read_reader->ListFuncSymbols("", SymbolMatchType::kSubstr));
+  ASSERT_EQ(mapped_symbols.size(), read_symbols.size());
+  for (size_t i = 0; i < mapped_symbols.size(); ++i) {
+    EXPECT_EQ(mapped_symbols[i].ToString(), read_symbols[i].ToString());
+  }
+
+  for (size_t addr : {symbol_addr, symbol_addr + 4}) {
+    EXPECT_OK_AND_EQ(mapped_reader->AddrToSymbol(addr),
+                     read_reader->AddrToSymbol(addr).ValueOrDie());
+    EXPECT_OK_AND_EQ(mapped_reader->InstrAddrToSymbol(addr),
+                     read_reader->InstrAddrToSymbol(addr).ValueOrDie());
+  }
+
+  ASSERT_OK_AND_ASSIGN(ElfReader::SymbolInfo symbol,
+                       mapped_reader->SearchTheOnlySymbol("CanYouFindThis"));
+  EXPECT_OK_AND_EQ(mapped_reader->SymbolByteCode(".text", symbol),
+                   read_reader->SymbolByteCode(".text", symbol).ValueOrDie());
 }
 
 TEST(ElfReaderTest, ExternalDebugSymbolsDebugLink) {
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/obj_tools/mapped_elf_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace px {
+namespace stirling {
+namespace obj_tools {
+
+namespace {
+
+template <typename T>
+T ReadStruct(std::string_view data) {
+  T val;
+  DCHECK_GE(data.size(), sizeof(T));
+  std::memcpy(&val, data.data(), sizeof(T));
+  return val;
+}
+
+// Returns the NUL terminated string at the offset of the string table.
+std::string_view StringAt(std::string_view strtab, uint64_t offset) {
+  if (offset >= strtab.size()) {
+    return {};
+  }
+  const char* str = strtab.data() + offset;
+  return std::string_view(str, strnlen(str, strtab.size() - offset));
+}
+
+}  // namespace
+
+StatusOr<std::unique_ptr<MappedElfFile>> MappedElfFile::Create(const std::string& path) {
+  auto elf_file = std::unique_ptr<MappedElfFile>(new MappedElfFile);
+  elf_file->path_ = path;
+
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return error::Internal("Failed to open $0: $1", path, std::strerror(errno));
+  }
+  DEFER(close(fd));
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    return error::Internal("Failed to stat $0: $1", path, std::strerror(errno));
+  }
+  if (static_cast<size_t>(st.st_size) < sizeof(Elf64_Ehdr)) {
+    return error::InvalidArgument("$0 is too small to be an ELF file", path);
+  }
+
+  void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED) {
+    return error::Internal("Failed to mmap $0: $1", path, std::strerror(errno));
+  }
+  elf_file->data_ = static_cast<const char*>(data);
+  elf_file->size_ = st.st_size;
+
+  PX_RETURN_IF_ERROR(elf_file->ParseHeaders());
+  return elf_file;
+}
+
+MappedElfFile::~MappedElfFile() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+}
+
+StatusOr<std::string_view> MappedElfFile::FileRange(uint64_t offset, uint64_t size) const {
+  if (offset > size_ || size > size_ - offset) {
+    return error::Internal("Range [$0, $0+$1) is out of the bounds of $2 (size=$3)", offset, size,
+                           path_, size_);
+  }
+  return std::string_view(data_ + offset, size);
+}
+
+Status MappedElfFile::ParseHeaders() {
+  const auto ehdr = ReadStruct<Elf64_Ehdr>(std::string_view(data_, size_));
+  if (std::memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0) {
+    return error::InvalidArgument("$0 is not an ELF file", path_);
+  }
+  if (ehdr.e_ident[EI_CLASS] != ELFCLASS64 || ehdr.e_ident[EI_DATA] != ELFDATA2LSB) {
+    return error::InvalidArgument("$0 is not a 64-bit little-endian ELF file", path_);
+  }
+  type_ = ehdr.e_type;
+  machine_ = ehdr.e_machine;
+
+  // Section headers. Large section counts and indexes are stored in the first section header.
+  std::vector<Elf64_Shdr> shdrs;
+  if (ehdr.e_shoff != 0) {
+    if (ehdr.e_shentsize < sizeof(Elf64_Shdr)) {
+      return error::InvalidArgument("Invalid section header size in $0", path_);
+    }
+    PX_ASSIGN_OR_RETURN(std::string_view first, FileRange(ehdr.e_shoff, sizeof(Elf64_Shdr)));
+    const auto shdr0 = ReadStruct<Elf64_Shdr>(first);
+    const uint64_t shnum = ehdr.e_shnum != 0 ? ehdr.e_shnum : shdr0.sh_size;
+    if (shnum > size_ / ehdr.e_shentsize) {
+      return error::InvalidArgument("Invalid number of sections in $0", path_);
+    }
+
+    PX_ASSIGN_OR_RETURN(std::string_view table,
+                        FileRange(ehdr.e_shoff, shnum * ehdr.e_shentsize));
+    shdrs.reserve(shnum);
+    for (uint64_t i = 0; i < shnum; ++i) {
+      shdrs.push_back(ReadStruct<Elf64_Shdr>(table.substr(i * ehdr.e_shentsize)));
+    }
+
+    const uint32_t shstrndx = ehdr.e_shstrndx != SHN_XINDEX ? ehdr.e_shstrndx : shdr0.sh_link;
+    std::string_view shstrtab;
+    if (shstrndx != SHN_UNDEF && shstrndx < shdrs.size()) {
+      PX_ASSIGN_OR_RETURN(shstrtab,
+                          FileRange(shdrs[shstrndx].sh_offset, shdrs[shstrndx].sh_size));
+    }
+
+    sections_.reserve(shdrs.size());
+    for (const Elf64_Shdr& shdr : shdrs) {
+      sections_.push_back(Section{StringAt(shstrtab, shdr.sh_name), shdr.sh_type, shdr.sh_addr,
+                                  shdr.sh_offset, shdr.sh_size, shdr.sh_link, shdr.sh_entsize});
+    }
+  }
+
+  // Program headers.
+  if (ehdr.e_phoff != 0) {
+    if (ehdr.e_phentsize < sizeof(Elf64_Phdr)) {
+      return error::InvalidArgument("Invalid program header size in $0", path_);
+    }
+    const uint64_t phnum =
+        (ehdr.e_phnum != PN_XNUM || shdrs.empty()) ? ehdr.e_phnum : shdrs[0].sh_info;
+    PX_ASSIGN_OR_RETURN(std::string_view table,
+                        FileRange(ehdr.e_phoff, phnum * ehdr.e_phentsize));
+    segments_.reserve(phnum);
+    for (uint64_t i = 0; i < phnum; ++i) {
+      const auto phdr = ReadStruct<Elf64_Phdr>(table.substr(i * ehdr.e_phentsize));
+      segments_.push_back(Segment{phdr.p_type, phdr.p_offset, phdr.p_vaddr});
+    }
+  }
+
+  return Status::OK();
+}
+
+StatusOr<std::string_view> MappedElfFile::SectionData(const Section& section) const {
+  if (section.type == SHT_NOBITS || section.type == SHT_NULL) {
+    return std::string_view();
+  }
+  return FileRange(section.offset, section.size);
+}
+
+StatusOr<MappedElfFile::SymbolTable> MappedElfFile::GetSymbolTable(const Section& section) const {
+  if (section.type != SHT_SYMTAB && section.type != SHT_DYNSYM) {
+    return error::InvalidArgument("Section $0 of $1 is not a symbol table", section.name, path_);
+  }
+  if (section.link >= sections_.size()) {
+    return error::InvalidArgument("Invalid string table index $0 in $1", section.link, path_);
+  }
+  PX_ASSIGN_OR_RETURN(std::string_view symbols, SectionData(section));
+  PX_ASSIGN_OR_RETURN(std::string_view strtab, SectionData(sections_[section.link]));
+
+  const size_t entry_size = std::max<size_t>(section.entry_size, sizeof(Elf64_Sym));
+  return SymbolTable(symbols.data(), entry_size, symbols.size() / entry_size, strtab);
+}
+
+MappedElfFile::Symbol MappedElfFile::SymbolTable::at(size_t i) const {
+  DCHECK_LT(i, num_symbols_);
+  const auto sym =
+      ReadStruct<Elf64_Sym>(std::string_view(symbols_ + i * entry_size_, sizeof(Elf64_Sym)));
+  return Symbol{StringAt(strtab_, sym.st_name), sym.st_value, sym.st_size,
+                static_cast<unsigned char>(ELF64_ST_TYPE(sym.st_info)),
+                static_cast<unsigned char>(ELF64_ST_BIND(sym.st_info))};
+}
+
+}  // namespace obj_tools
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <elf.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace stirling {
+namespace obj_tools {
+
+/**
+ * A read-only view of a 64-bit little-endian ELF file that is mapped into memory.
+ *
+ * Only the ELF, section and program headers are parsed when the file is opened. The contents of
+ * the sections are accessed in place, so only the pages that are actually touched (e.g. those of
+ * the symbol and string tables) are read from disk, and they are backed by the page cache rather
+ * than by the heap.
+ */
+class MappedElfFile : public NotCopyMoveable {
+ public:
+  struct Section {
+    std::string_view name;
+    uint32_t type;
+    uint64_t address;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t link;
+    uint64_t entry_size;
+  };
+
+  struct Segment {
+    uint32_t type;
+    uint64_t offset;
+    uint64_t virtual_address;
+  };
+
+  struct Symbol {
+    std::string_view name;
+    uint64_t address;
+    uint64_t size;
+    unsigned char type;
+    unsigned char bind;
+  };
+
+  /**
+   * A symbol table section (SHT_SYMTAB or SHT_DYNSYM) and its string table.
+   */
+  class SymbolTable {
+   public:
+    // An empty table. StatusOr needs its value type to be default constructible.
+    SymbolTable() = default;
+
+    size_t size() const { return num_symbols_; }
+    Symbol at(size_t i) const;
+
+   private:
+    friend class MappedElfFile;
+    SymbolTable(const char* symbols, size_t entry_size, size_t num_symbols,
+                std::string_view strtab)
+        : symbols_(symbols), entry_size_(entry_size), num_symbols_(num_symbols), strtab_(strtab) {}
+
+    const char* symbols_ = nullptr;
+    size_t entry_size_ = 0;
+    size_t num_symbols_ = 0;
+    std::string_view strtab_;
+  };
+
+  /**
+   * Maps the file and parses its headers. Returns an error if the file is not a 64-bit
+   * little-endian ELF file.
+   */
+  static StatusOr<std::unique_ptr<MappedElfFile>> Create(const std::string& path);
+
+  ~MappedElfFile();
+
+  uint16_t type() const { return type_; }
+  uint16_t machine() const { return machine_; }
+  const std::vector<Section>& sections() const { return sections_; }
+  const std::vector<Segment>& segments() const { return segments_; }
+
+  /**
+   * Returns the contents of the section, in place. Sections without contents in the file (e.g.
+   * SHT_NOBITS) are empty.
+   */
+  StatusOr<std::string_view> SectionData(const Section& section) const;
+
+  /**
+   * Returns the symbols of the symbol table section.
+   */
+  StatusOr<SymbolTable> GetSymbolTable(const Section& section) const;
+
+  /**
+   * Returns the bytes [offset, offset + size) of the file, or an error if they are out of bounds.
+   */
+  StatusOr<std::string_view> FileRange(uint64_t offset, uint64_t size) const;
+
+ private:
+  MappedElfFile() = default;
+
+  Status ParseHeaders();
+
+  std::string path_;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+
+  uint16_t type_ = ET_NONE;
+  uint16_t machine_ = EM_NONE;
+  std::vector<Section> sections_;
+  std::vector<Segment> segments_;
+};
+
+}  // namespace obj_tools
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/obj_tools/mapped_elf_file.h"
+
+#include "src/common/testing/testing.h"
+#include "src/stirling/obj_tools/testdata/cc/test_exe_fixture.h"
+
+namespace px {
+namespace stirling {
+namespace obj_tools {
+
+const TestExeFixture kTestExeFixture;
+
+TEST(MappedElfFileTest, NonExistentPath) { ASSERT_NOT_OK(MappedElfFile::Create("/bogus")); }
+
+TEST(MappedElfFileTest, NotAnElfFile) {
+  ASSERT_NOT_OK(MappedElfFile::Create("/proc/self/cmdline"));
+}
+
+TEST(MappedElfFileTest, Headers) {
+  ASSERT_OK_AND_ASSIGN(std::unique_ptr<MappedElfFile> elf_file,
+                       MappedElfFile::Create(kTestExeFixture.Path().string()));
+
+  EXPECT_THAT(elf_file->type(), ::testing::AnyOf(ET_EXEC, ET_DYN));
+
+  const MappedElfFile::Section* text = nullptr;
+  const MappedElfFile::Section* symtab = nullptr;
+  for (const auto& section : elf_file->sections()) {
+    if (section.name == ".text") {
+      text = &section;
+    }
+    if (section.type == SHT_SYMTAB) {
+      symtab = &section;
+    }
+  }
+  ASSERT_NE(text, nullptr);
+  ASSERT_NE(symtab, nullptr);
+  EXPECT_GT(text->size, 0);
+  ASSERT_OK_AND_ASSIGN(std::string_view text_data, elf_file->SectionData(*text));
+  EXPECT_EQ(text_data.size(), text->size);
+
+  EXPECT_FALSE(elf_file->segments().empty());
+
+  ASSERT_OK_AND_ASSIGN(MappedElfFile::SymbolTable symbols, elf_file->GetSymbolTable(*symtab));
+  bool found = false;
+  for (size_t i = 0; i < symbols.size(); ++i) {
+    const MappedElfFile::Symbol symbol = symbols.at(i);
+    if (symbol.name == "CanYouFindThis") {
+      found = true;
+      EXPECT_EQ(symbol.type, STT_FUNC);
+      EXPECT_GE(symbol.address, text->address);
+      EXPECT_LT(symbol.address, text->address + text->size);
+    }
+  }
+  EXPECT_TRUE(found);
+
+  EXPECT_NOT_OK(elf_file->GetSymbolTable(*text));
+  EXPECT_NOT_OK(elf_file->FileRange(0, std::numeric_limits<uint64_t>::max()));
+}
+
+}  // namespace obj_tools
+}  // namespace stirling
+}  // namespace px
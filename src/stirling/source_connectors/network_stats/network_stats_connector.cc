@@ -64,7 +64,7 @@ void NetworkStatsConnector::TransferNetworkStatsTable(ConnectorContext* ctx,
     }
 
     ProcParser::NetworkStats stats;
-    auto s = GetNetworkStatsForPod(*proc_parser_, *pod_info, k8s_md, &stats);
+    auto s = GetNetworkStatsForPod(proc_stats_scanner_.get(), *pod_info, k8s_md, &stats);
 
     if (!s.ok()) {
       VLOG(1) << absl::StrCat("Failed to get Pod network stats: ", s.msg());
@@ -84,9 +84,12 @@ void NetworkStatsConnector::TransferNetworkStatsTable(ConnectorContext* ctx,
     r.Append<r.ColIndex("tx_errors")>(stats.tx_errs);
     r.Append<r.ColIndex("tx_drops")>(stats.tx_drops);
   }
+
+  // Close the files of the PIDs that were not read.
+  proc_stats_scanner_->EndScan();
 }
 
-Status NetworkStatsConnector::GetNetworkStatsForPod(const system::ProcParser& proc_parser,
+Status NetworkStatsConnector::GetNetworkStatsForPod(system::ProcStatsScanner* proc_stats_scanner,
                                                     const md::PodInfo& pod_info,
                                                     const md::K8sMetadataState& k8s_metadata_state,
                                                     system::ProcParser::NetworkStats* stats) {
@@ -118,7 +121,7 @@ Status NetworkStatsConnector::GetNetworkStatsForPod(const system::ProcParser& pr
                          container_info->active_upids().end(), md::UPIDStartTSCompare()));
 
     for (const auto& upid : container_info->active_upids()) {
-      auto s = proc_parser.ParseProcPIDNetDev(upid.pid(), stats);
+      auto s = proc_stats_scanner->ReadNetworkStats(upid.pid(), stats);
       if (s.ok()) {
         // Since we just need to read one pid, we can bail on the first successful read.
         return s;
@@ -58,18 +58,20 @@ class NetworkStatsConnector : public SourceConnector {
  protected:
   explicit NetworkStatsConnector(std::string_view source_name)
       : SourceConnector(source_name, kTables) {
-    proc_parser_ = std::make_unique<system::ProcParser>();
+    proc_stats_scanner_ = std::make_unique<system::ProcStatsScanner>(
+        system::Config::GetInstance().PageSizeBytes(),
+        system::Config::GetInstance().KernelTickTimeNS());
   }
 
  private:
   void TransferNetworkStatsTable(ConnectorContext* ctx, DataTable* data_table);
 
-  static Status GetNetworkStatsForPod(const system::ProcParser& proc_parser,
+  static Status GetNetworkStatsForPod(system::ProcStatsScanner* proc_stats_scanner,
                                       const md::PodInfo& pod_info,
                                       const md::K8sMetadataState& k8s_metadata_state,
                                       system::ProcParser::NetworkStats* stats);
 
-  std::unique_ptr<system::ProcParser> proc_parser_;
+  std::unique_ptr<system::ProcStatsScanner> proc_stats_scanner_;
 };
 
 }  // namespace stirling
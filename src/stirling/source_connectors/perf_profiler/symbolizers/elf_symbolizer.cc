@@ -16,12 +16,17 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <sys/stat.h>
+
 #include <memory>
+#include <string>
 #include <utility>
 
 #include <absl/functional/bind_front.h>
+#include <prometheus/counter.h>
 
 #include "src/common/base/base.h"
+#include "src/common/metrics/metrics.h"
 #include "src/common/system/proc_pid_path.h"
 #include "src/stirling/obj_tools/address_converter.h"
 #include "src/stirling/obj_tools/elf_reader.h"
@@ -34,26 +39,107 @@ using ::px::system::ProcPidRootPath;
 namespace px {
 namespace stirling {
 
+namespace {
+
+prometheus::Counter& g_symbol_table_hits_counter{
+    BuildCounter("elf_symbolizer_symbol_table_hits",
+                 "Count of the processes that reused the symbol table of another process")};
+
+prometheus::Counter& g_symbol_table_misses_counter{BuildCounter(
+    "elf_symbolizer_symbol_table_misses", "Count of the symbol tables read from ELF files")};
+
+prometheus::Counter& g_symbol_table_bytes_saved_counter{
+    BuildCounter("elf_symbolizer_symbol_table_bytes_saved",
+                 "Bytes of symbol tables that were shared instead of being built again")};
+
+// Identifies the binary, so that the processes running the same binary share what is read from
+// its ELF file. It is computed before the file is parsed. The path is that of the binary in the
+// container of the process, so it is the same for all the replicas of a container image, and the
+// size and modification time (which are preserved by container images) tell versions apart.
+StatusOr<std::string> BinaryKey(const std::filesystem::path& proc_exe,
+                                const std::filesystem::path& host_path) {
+  struct stat st;
+  if (stat(host_path.c_str(), &st) != 0) {
+    return error::Internal("Could not stat $0.", host_path.string());
+  }
+  return absl::Substitute("$0:$1:$2.$3", proc_exe.string(), st.st_size, st.st_mtim.tv_sec,
+                          st.st_mtim.tv_nsec);
+}
+
+}  // namespace
+
 StatusOr<std::unique_ptr<Symbolizer>> ElfSymbolizer::Create() {
   ElfSymbolizer* elf_symbolizer = new ElfSymbolizer();
   auto symbolizer = std::unique_ptr<Symbolizer>(elf_symbolizer);
   return symbolizer;
 }
 
-void ElfSymbolizer::DeleteUPID(const struct upid_t& upid) { symbolizers_.erase(upid); }
+void ElfSymbolizer::DeleteUPID(const struct upid_t& upid) {
+  auto iter = symbolizers_.find(upid);
+  if (iter == symbolizers_.end()) {
+    return;
+  }
+  if (iter->second == nullptr) {
+    // The symbolizer of this UPID could not be created.
+    symbolizers_.erase(iter);
+    return;
+  }
+  const std::string key = iter->second->binary_key();
+  symbolizers_.erase(iter);
+  auto binary_iter = binaries_.find(key);
+  if (binary_iter != binaries_.end() && binary_iter->second.expired()) {
+    binaries_.erase(binary_iter);
+  }
+}
+
+StatusOr<std::shared_ptr<const ElfSymbolizer::Binary>> ElfSymbolizer::ReadBinary(
+    const std::filesystem::path& host_path) {
+  PX_ASSIGN_OR_RETURN(auto elf_reader, ElfReader::Create(host_path.string()));
+  auto binary = std::make_shared<Binary>();
+  binary->elf_type = elf_reader->ELFType();
+  if (binary->elf_type == ELFIO::ET_DYN) {
+    PX_ASSIGN_OR_RETURN(binary->virtual_addr_at_offset_zero,
+                        elf_reader->GetVirtualAddrAtOffsetZero());
+  }
+  PX_ASSIGN_OR_RETURN(binary->symbolizer, elf_reader->GetSymbolizer());
+  return binary;
+}
 
-StatusOr<std::unique_ptr<ElfSymbolizer::SymbolizerWithConverter>> CreateUPIDSymbolizer(
-    const struct upid_t& upid) {
+StatusOr<std::unique_ptr<ElfSymbolizer::SymbolizerWithConverter>>
+ElfSymbolizer::CreateUPIDSymbolizer(const struct upid_t& upid) {
   const pid_t pid = upid.pid;
   const system::ProcParser proc_parser;
   PX_ASSIGN_OR_RETURN(const auto proc_exe, proc_parser.GetExePath(pid));
-  PX_ASSIGN_OR_RETURN(auto elf_reader, ElfReader::Create(ProcPidRootPath(pid, proc_exe.string())));
+  const std::filesystem::path host_path = ProcPidRootPath(pid, proc_exe.string());
+  PX_ASSIGN_OR_RETURN(std::string key, BinaryKey(proc_exe, host_path));
+
+  std::weak_ptr<const Binary>& cached_binary = binaries_[key];
+  std::shared_ptr<const Binary> binary = cached_binary.lock();
+  if (binary != nullptr) {
+    g_symbol_table_hits_counter.Increment();
+    g_symbol_table_bytes_saved_counter.Increment(binary->symbolizer->NumBytes());
+  } else {
+    auto binary_status = ReadBinary(host_path);
+    if (!binary_status.ok()) {
+      binaries_.erase(key);
+      return binary_status.status();
+    }
+    binary = binary_status.ConsumeValueOrDie();
+    cached_binary = binary;
+    g_symbol_table_misses_counter.Increment();
+  }
 
-  PX_ASSIGN_OR_RETURN(auto symbolizer, elf_reader->GetSymbolizer());
-  PX_ASSIGN_OR_RETURN(auto converter,
-                      obj_tools::ElfAddressConverter::Create(elf_reader.get(), pid));
-  return std::make_unique<ElfSymbolizer::SymbolizerWithConverter>(std::move(symbolizer),
-                                                                  std::move(converter));
+  auto converter_status = obj_tools::ElfAddressConverter::Create(
+      binary->elf_type, binary->virtual_addr_at_offset_zero, pid);
+  if (!converter_status.ok()) {
+    binary.reset();
+    if (cached_binary.expired()) {
+      binaries_.erase(key);
+    }
+    return converter_status.status();
+  }
+  return std::make_unique<ElfSymbolizer::SymbolizerWithConverter>(
+      std::move(key), std::move(binary), converter_status.ConsumeValueOrDie());
 }
 
 std::string_view EmptySymbolizerFn(const uintptr_t addr) {
@@ -87,7 +173,7 @@ profiler::SymbolizerFn ElfSymbolizer::GetSymbolizerFn(const struct upid_t& upid)
 
 std::string_view ElfSymbolizer::SymbolizerWithConverter::Lookup(uint64_t virtual_addr) const {
   auto binary_addr = converter_->VirtualAddrToBinaryAddr(virtual_addr);
-  return symbolizer_->Lookup(binary_addr);
+  return binary_->symbolizer->Lookup(binary_addr);
 }
 
 }  // namespace stirling
@@ -18,9 +18,13 @@
 
 #pragma once
 
+#include <filesystem>
 #include <memory>
+#include <string>
 #include <utility>
 
+#include <absl/container/flat_hash_map.h>
+
 #include "src/stirling/obj_tools/address_converter.h"
 #include "src/stirling/source_connectors/perf_profiler/symbolizers/symbolizer.h"
 
@@ -29,6 +33,11 @@ namespace stirling {
 
 /**
  * A Symbolizer using the ElfReader symbolization core.
+ *
+ * Symbol tables are shared by all the UPIDs running the same binary (e.g. the replicas of a
+ * service), which are recognized by the path, size and modification time of the binary before its
+ * ELF file is parsed. Only the address converter, which depends on where the binary is mapped, is
+ * kept per UPID.
  */
 class ElfSymbolizer : public Symbolizer, public NotCopyMoveable {
  public:
@@ -39,23 +48,50 @@ class ElfSymbolizer : public Symbolizer, public NotCopyMoveable {
   void DeleteUPID(const struct upid_t& upid) override;
   bool Uncacheable(const struct upid_t& /*upid*/) override { return false; }
 
+  /**
+   * Returns the number of distinct symbol tables in use.
+   */
+  size_t NumSymbolTables() const { return binaries_.size(); }
+
+  // What is read from the ELF file of a binary.
+  struct Binary {
+    std::unique_ptr<obj_tools::ElfReader::Symbolizer> symbolizer;
+    ELFIO::Elf_Half elf_type = ELFIO::ET_NONE;
+    // Only set for position independent (ET_DYN) binaries.
+    uint64_t virtual_addr_at_offset_zero = 0;
+  };
+
   class SymbolizerWithConverter {
    public:
-    SymbolizerWithConverter(std::unique_ptr<obj_tools::ElfReader::Symbolizer> symbolizer,
+    SymbolizerWithConverter(std::string binary_key, std::shared_ptr<const Binary> binary,
                             std::unique_ptr<obj_tools::ElfAddressConverter> converter)
-        : symbolizer_(std::move(symbolizer)), converter_(std::move(converter)) {}
+        : binary_key_(std::move(binary_key)),
+          binary_(std::move(binary)),
+          converter_(std::move(converter)) {}
     std::string_view Lookup(uintptr_t addr) const;
+    const std::string& binary_key() const { return binary_key_; }
 
    private:
-    std::unique_ptr<obj_tools::ElfReader::Symbolizer> symbolizer_;
+    std::string binary_key_;
+    std::shared_ptr<const Binary> binary_;
     std::unique_ptr<obj_tools::ElfAddressConverter> converter_;
   };
 
  private:
   ElfSymbolizer() = default;
 
-  // A symbolizer per UPID.
+  StatusOr<std::unique_ptr<SymbolizerWithConverter>> CreateUPIDSymbolizer(
+      const struct upid_t& upid);
+  static StatusOr<std::shared_ptr<const Binary>> ReadBinary(
+      const std::filesystem::path& host_path);
+
+  // A symbolizer per UPID. It holds the key of its binary in binaries_, so that deleting a UPID
+  // doesn't scan binaries_.
   absl::flat_hash_map<struct upid_t, std::unique_ptr<SymbolizerWithConverter>> symbolizers_;
+
+  // The binaries of the UPIDs, keyed by binary identity (see BinaryKey()). A binary is dropped
+  // once no UPID uses it anymore.
+  absl::flat_hash_map<std::string, std::weak_ptr<const Binary>> binaries_;
 };
 
 }  // namespace stirling
@@ -82,6 +82,28 @@ TYPED_TEST(SymbolizerTest, UserSymbols) {
   EXPECT_EQ(symbolize(kBarAddr), "test::bar()");
 }
 
+// Processes running the same binary share its symbol table.
+TEST_F(ElfSymbolizerTest, SharedSymbolTables) {
+  auto* elf_symbolizer = static_cast<ElfSymbolizer*>(symbolizer_.get());
+
+  // Two UPIDs for this process, as if it was running twice.
+  const struct upid_t upid0 = {{static_cast<uint32_t>(getpid())}, 0};
+  const struct upid_t upid1 = {{static_cast<uint32_t>(getpid())}, 1};
+
+  auto symbolize0 = symbolizer_->GetSymbolizerFn(upid0);
+  auto symbolize1 = symbolizer_->GetSymbolizerFn(upid1);
+  EXPECT_EQ(elf_symbolizer->NumSymbolTables(), 1);
+  EXPECT_EQ(symbolize0(kFooAddr), "test::foo()");
+  EXPECT_EQ(symbolize1(kFooAddr), "test::foo()");
+
+  // The symbol table stays around as long as one of the UPIDs uses it.
+  symbolizer_->DeleteUPID(upid0);
+  EXPECT_EQ(elf_symbolizer->NumSymbolTables(), 1);
+  EXPECT_EQ(symbolize1(kBarAddr), "test::bar()");
+  symbolizer_->DeleteUPID(upid1);
+  EXPECT_EQ(elf_symbolizer->NumSymbolTables(), 0);
+}
+
 TEST_F(BCCSymbolizerTest, KernelSymbols) {
   ASSERT_OK_AND_ASSIGN(std::unique_ptr<Symbolizer> symbolizer, BCCSymbolizer::Create());
 
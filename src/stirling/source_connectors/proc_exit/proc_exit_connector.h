@@ -67,7 +67,7 @@ class ProcExitConnector : public SourceConnector, public bpf_tools::BCCWrapper {
   // Update counters related to java process.
   void UpdateCrashedJavaProcCounters(
       uint32_t asid, const proc_exit_event_t& event,
-      const absl::flat_hash_map<md::UPID, md::PIDInfoUPtr>& upid_pid_info_map);
+      const md::PIDInfoMap& upid_pid_info_map);
 
   prometheus::Counter& java_proc_crashed_counter_;
   prometheus::Counter& java_proc_crashed_with_profiler_counter_;
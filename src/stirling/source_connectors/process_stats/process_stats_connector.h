@@ -58,13 +58,15 @@ class ProcessStatsConnector : public SourceConnector {
  protected:
   explicit ProcessStatsConnector(std::string_view source_name)
       : SourceConnector(source_name, kTables) {
-    proc_parser_ = std::make_unique<system::ProcParser>();
+    proc_stats_scanner_ = std::make_unique<system::ProcStatsScanner>(
+        system::Config::GetInstance().PageSizeBytes(),
+        system::Config::GetInstance().KernelTickTimeNS());
   }
 
  private:
   void TransferProcessStatsTable(ConnectorContext* ctx, DataTable* data_table);
 
-  std::unique_ptr<system::ProcParser> proc_parser_;
+  std::unique_ptr<system::ProcStatsScanner> proc_stats_scanner_;
 };
 
 }  // namespace stirling
@@ -39,7 +39,7 @@ typename TMapType::const_iterator MapLE(const TMapType& map, size_t key) {
 }  // namespace
 
 void AlwaysContiguousDataStreamBufferImpl::Reset() {
-  buffer_.clear();
+  buffer_->Clear();
   chunks_.clear();
   timestamps_.clear();
   position_ = 0;
@@ -169,7 +169,7 @@ void AlwaysContiguousDataStreamBufferImpl::Add(size_t pos, std::string_view data
     data.remove_prefix(prefix);
     pos += prefix;
     ppos_front = 0;
-  } else if (ppos_back > static_cast<ssize_t>(buffer_.size())) {
+  } else if (ppos_back > static_cast<ssize_t>(buffer_->size())) {
     // Case 3: Data being added extends the buffer. Resize the buffer.
 
     // Subcase: If the data is more than max_gap_size_ ahead of the last chunk in the buffer (or
@@ -217,10 +217,17 @@ void AlwaysContiguousDataStreamBufferImpl::Add(size_t pos, std::string_view data
     DCHECK_LE(new_size, static_cast<ssize_t>(capacity_));
     DCHECK_GE(new_size, 0);
 
-    buffer_.resize(new_size);
+    Status s = buffer_->Resize(new_size);
+    if (!s.ok()) {
+      LOG_FIRST_N(ERROR, 10) << absl::Substitute(
+          "Dropping event, failed to grow the buffer [event pos=$0, size=$1]: $2", pos,
+          data.size(), s.msg());
+      Reset();
+      return;
+    }
 
-    DCHECK_GE(buffer_.size(), 0U);
-    DCHECK_LE(buffer_.size(), capacity_);
+    DCHECK_GE(buffer_->size(), 0U);
+    DCHECK_LE(buffer_->size(), capacity_);
   } else {
     // Case 4: Data being added is completely within the buffer. Write it directly.
 
@@ -233,7 +240,7 @@ void AlwaysContiguousDataStreamBufferImpl::Add(size_t pos, std::string_view data
   }
 
   // Now copy the data into the buffer.
-  memcpy(buffer_.data() + ppos_front, data.data(), data.size());
+  memcpy(buffer_->data() + ppos_front, data.data(), data.size());
 
   // Update the metadata.
   AddNewChunk(pos, data.size());
@@ -277,8 +284,8 @@ std::string_view AlwaysContiguousDataStreamBufferImpl::Get(size_t pos) const {
 
   DCHECK_GE(pos, position_);
   size_t ppos = pos - position_;
-  DCHECK_LT(ppos, buffer_.size());
-  return std::string_view(buffer_.data() + ppos, bytes_available);
+  DCHECK_LT(ppos, buffer_->size());
+  return std::string_view(buffer_->data() + ppos, bytes_available);
 }
 
 StatusOr<uint64_t> AlwaysContiguousDataStreamBufferImpl::GetTimestamp(size_t pos) const {
@@ -339,9 +346,9 @@ void AlwaysContiguousDataStreamBufferImpl::CleanupChunks() {
   }
 
   if (chunks_.empty()) {
-    ECHECK(buffer_.empty()) << "Invalid state in AlwaysContiguousDataStreamBufferImpl. "
-                               "buffer_ is non-empty, but chunks_ is empty.";
-    buffer_.clear();
+    ECHECK(buffer_->size() == 0) << "Invalid state in AlwaysContiguousDataStreamBufferImpl. "
+                                    "buffer_ is non-empty, but chunks_ is empty.";
+    buffer_->Clear();
   }
 }
 
@@ -369,7 +376,7 @@ void AlwaysContiguousDataStreamBufferImpl::RemovePrefix(ssize_t n) {
     return;
   }
 
-  buffer_.erase(0, n);
+  buffer_->RemovePrefix(n);
   position_ += n;
 
   CleanupMetadata();
@@ -384,7 +391,7 @@ void AlwaysContiguousDataStreamBufferImpl::Trim() {
   DCHECK_GE(chunk_pos, position_);
   size_t trim_size = chunk_pos - position_;
 
-  buffer_.erase(0, trim_size);
+  buffer_->RemovePrefix(trim_size);
   position_ += trim_size;
 }
 
@@ -401,7 +408,7 @@ std::string AlwaysContiguousDataStreamBufferImpl::DebugInfo() const {
   std::string s;
 
   absl::StrAppend(&s, absl::Substitute("Position: $0\n", position_));
-  absl::StrAppend(&s, absl::Substitute("BufferSize: $0/$1\n", buffer_.size(), capacity_));
+  absl::StrAppend(&s, absl::Substitute("BufferSize: $0/$1\n", buffer_->size(), capacity_));
   absl::StrAppend(&s, "Chunks:\n");
   for (const auto& [pos, size] : chunks_) {
     absl::StrAppend(&s, absl::Substitute("  position:$0 size:$1\n", pos, size));
@@ -410,7 +417,8 @@ std::string AlwaysContiguousDataStreamBufferImpl::DebugInfo() const {
   for (const auto& [pos, timestamp] : timestamps_) {
     absl::StrAppend(&s, absl::Substitute("  position:$0 timestamp:$1\n", pos, timestamp));
   }
-  absl::StrAppend(&s, absl::Substitute("Buffer: $0\n", buffer_));
+  absl::StrAppend(&s, absl::Substitute("Buffer: $0\n",
+                                       std::string_view(buffer_->data(), buffer_->size())));
 
   return s;
 }
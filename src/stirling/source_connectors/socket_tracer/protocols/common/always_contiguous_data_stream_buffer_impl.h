@@ -19,6 +19,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <string>
 
 #include "src/stirling/source_connectors/socket_tracer/protocols/common/data_stream_buffer.h"
@@ -27,13 +28,52 @@ namespace px {
 namespace stirling {
 namespace protocols {
 
+/**
+ * The memory backing an AlwaysContiguousDataStreamBufferImpl: size() contiguous bytes, which grow
+ * at the back and are removed from the front.
+ */
+class ContiguousBuffer {
+ public:
+  virtual ~ContiguousBuffer() = default;
+
+  // The first byte of the buffer. Valid until the next call that changes the buffer.
+  virtual char* data() = 0;
+  virtual size_t size() const = 0;
+  virtual size_t capacity() const = 0;
+
+  // Changes the size of the buffer. The contents of new bytes are unspecified.
+  virtual Status Resize(size_t size) = 0;
+  virtual void RemovePrefix(size_t n) = 0;
+  virtual void Clear() = 0;
+  virtual void ShrinkToFit() = 0;
+};
+
+/**
+ * A ContiguousBuffer on a std::string. Removing bytes from the front moves the rest of the data.
+ */
+class StringContiguousBuffer : public ContiguousBuffer {
+ public:
+  char* data() override { return buffer_.data(); }
+  size_t size() const override { return buffer_.size(); }
+  size_t capacity() const override { return buffer_.capacity(); }
+  Status Resize(size_t size) override {
+    buffer_.resize(size);
+    return Status::OK();
+  }
+  void RemovePrefix(size_t n) override { buffer_.erase(0, n); }
+  void Clear() override { buffer_.clear(); }
+  void ShrinkToFit() override { buffer_.shrink_to_fit(); }
+
+ private:
+  std::string buffer_;
+};
+
 class AlwaysContiguousDataStreamBufferImpl : public DataStreamBufferImpl {
  public:
   AlwaysContiguousDataStreamBufferImpl(size_t max_capacity, size_t max_gap_size,
                                        size_t allow_before_gap_size)
-      : capacity_(max_capacity),
-        max_gap_size_(max_gap_size),
-        allow_before_gap_size_(allow_before_gap_size) {}
+      : AlwaysContiguousDataStreamBufferImpl(max_capacity, max_gap_size, allow_before_gap_size,
+                                             std::make_unique<StringContiguousBuffer>()) {}
 
   void Add(size_t pos, std::string_view data, uint64_t timestamp) override;
 
@@ -45,11 +85,11 @@ class AlwaysContiguousDataStreamBufferImpl : public DataStreamBufferImpl {
 
   void Trim() override;
 
-  size_t size() const override { return buffer_.size(); }
+  size_t size() const override { return buffer_->size(); }
 
-  size_t capacity() const override { return buffer_.capacity(); }
+  size_t capacity() const override { return buffer_->capacity(); }
 
-  bool empty() const override { return buffer_.empty(); }
+  bool empty() const override { return buffer_->size() == 0; }
 
   size_t position() const override { return position_; }
 
@@ -57,7 +97,16 @@ class AlwaysContiguousDataStreamBufferImpl : public DataStreamBufferImpl {
 
   void Reset() override;
 
-  void ShrinkToFit() override { buffer_.shrink_to_fit(); }
+  void ShrinkToFit() override { buffer_->ShrinkToFit(); }
+
+ protected:
+  AlwaysContiguousDataStreamBufferImpl(size_t max_capacity, size_t max_gap_size,
+                                       size_t allow_before_gap_size,
+                                       std::unique_ptr<ContiguousBuffer> buffer)
+      : capacity_(max_capacity),
+        max_gap_size_(max_gap_size),
+        allow_before_gap_size_(allow_before_gap_size),
+        buffer_(std::move(buffer)) {}
 
  private:
   std::map<size_t, size_t>::const_iterator GetChunkForPos(size_t pos) const;
@@ -89,8 +138,7 @@ class AlwaysContiguousDataStreamBufferImpl : public DataStreamBufferImpl {
   size_t position_ = 0;
 
   // Buffer where all data is stored.
-  // TODO(oazizi): Investigate buffer that is better suited to the rolling buffer (slinky) model.
-  std::string buffer_;
+  std::unique_ptr<ContiguousBuffer> buffer_;
 
   // Map of chunk start positions to chunk sizes.
   // A chunk is a contiguous sequence of bytes.
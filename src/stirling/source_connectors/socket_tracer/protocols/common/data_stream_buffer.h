@@ -27,6 +27,7 @@
 #include "src/common/base/base.h"
 
 DECLARE_bool(stirling_data_stream_buffer_always_contiguous_buffer);
+DECLARE_bool(stirling_data_stream_buffer_ring_buffer);
 
 namespace px {
 namespace stirling {
@@ -64,8 +65,9 @@ class DataStreamBufferImpl {
  * DataStreamBuffer supports data arriving out-of-order such that they are slotted into the middle
  * of the buffer.
  *
- * The underlying implementation is currently a simple string buffer, but this could be changed
- * in the future, as long as the data is maintained in a contiguous buffer.
+ * The underlying implementation is a simple string buffer by default. With
+ * --stirling_data_stream_buffer_ring_buffer, the data is kept in a double-mapped ring buffer
+ * instead, which presents the same contiguous views without moving data when it is consumed.
  */
 class DataStreamBuffer {
  public:
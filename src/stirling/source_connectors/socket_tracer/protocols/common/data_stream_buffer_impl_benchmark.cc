@@ -19,11 +19,15 @@
 #include <benchmark/benchmark.h>
 
 #include <random>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "src/common/base/base.h"
 
 #include "src/stirling/source_connectors/socket_tracer/protocols/common/always_contiguous_data_stream_buffer_impl.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/common/lazy_contiguous_data_stream_buffer_impl.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/ring_data_stream_buffer_impl.h"
 
 template <typename TDataStreamBufferImpl>
 // NOLINTNEXTLINE : runtime/references.
@@ -229,8 +233,93 @@ static void BM_RemovePrefix(benchmark::State& state) {
   }
 }
 
+struct TraceEvent {
+  size_t pos;
+  size_t size;
+  uint64_t ts;
+};
+
+// Generates the events of a busy connection: a steady stream of messages of state.range(0) bytes,
+// where every so often an event is lost (leaving a gap), neighbouring events arrive swapped, and a
+// spike of 64 back to back messages arrives in one poll.
+std::vector<std::vector<TraceEvent>> GenerateGapsAndSpikesTrace(size_t msg_size) {
+  constexpr int kNumPolls = 2000;
+  constexpr int kMsgsPerPoll = 4;
+  constexpr int kSpikeMsgs = 64;
+  std::minstd_rand0 gen(0);
+  std::uniform_int_distribution<int> dist(0, 99);
+
+  std::vector<std::vector<TraceEvent>> polls(kNumPolls);
+  size_t pos = 0;
+  uint64_t ts = 0;
+  for (auto& poll : polls) {
+    int num_msgs = dist(gen) < 2 ? kSpikeMsgs : kMsgsPerPoll;
+    for (int i = 0; i < num_msgs; ++i) {
+      // Events are split at a random point, like a message written with two syscalls.
+      size_t split = 1 + dist(gen) * (msg_size - 1) / 100;
+      for (size_t size : {split, msg_size - split}) {
+        // 1% of the events are lost.
+        if (dist(gen) != 0) {
+          poll.push_back({pos, size, ts});
+        }
+        pos += size;
+        ++ts;
+      }
+    }
+    // 5% of the polls have two events out of order.
+    if (poll.size() > 1 && dist(gen) < 5) {
+      std::swap(poll[0], poll[1]);
+    }
+  }
+  return polls;
+}
+
+template <typename TDataStreamBufferImpl>
+// NOLINTNEXTLINE : runtime/references.
+static void BM_GapsAndSpikes(benchmark::State& state) {
+  size_t capacity = 1024 * 1024;
+  size_t max_gap_size = 1024 * 1024;
+  size_t allow_before_gap_size = 1024;
+
+  const size_t msg_size = state.range(0);
+  std::string data(msg_size, '0');
+  auto polls = GenerateGapsAndSpikesTrace(msg_size);
+
+  size_t num_bytes = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    TDataStreamBufferImpl stream_buffer(capacity, max_gap_size, allow_before_gap_size);
+    state.ResumeTiming();
+
+    for (const auto& poll : polls) {
+      for (const auto& event : poll) {
+        stream_buffer.Add(event.pos, std::string_view(data).substr(0, event.size), event.ts);
+        num_bytes += event.size;
+      }
+      // Consume all the whole messages at the head, like a parser would, and skip over a gap at
+      // the head.
+      size_t head_size = stream_buffer.Head().size();
+      if (head_size == 0) {
+        stream_buffer.Trim();
+        head_size = stream_buffer.Head().size();
+      }
+      size_t msg_offset = stream_buffer.position() % msg_size;
+      size_t consumed = msg_offset == 0 ? 0 : msg_size - msg_offset;
+      if (consumed > head_size) {
+        stream_buffer.RemovePrefix(head_size);
+        continue;
+      }
+      consumed += (head_size - consumed) / msg_size * msg_size;
+      stream_buffer.RemovePrefix(consumed);
+    }
+    benchmark::DoNotOptimize(stream_buffer.Head());
+  }
+  state.SetBytesProcessed(num_bytes);
+}
+
 using px::stirling::protocols::AlwaysContiguousDataStreamBufferImpl;
 using px::stirling::protocols::LazyContiguousDataStreamBufferImpl;
+using px::stirling::protocols::RingDataStreamBufferImpl;
 
 BENCHMARK_TEMPLATE(BM_ContiguousBytes, LazyContiguousDataStreamBufferImpl)
     ->Range(1024, 32 * 1024)
@@ -238,9 +327,13 @@ BENCHMARK_TEMPLATE(BM_ContiguousBytes, LazyContiguousDataStreamBufferImpl)
 BENCHMARK_TEMPLATE(BM_ContiguousBytes, AlwaysContiguousDataStreamBufferImpl)
     ->Range(1024, 32 * 1024)
     ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ContiguousBytes, RingDataStreamBufferImpl)
+    ->Range(1024, 32 * 1024)
+    ->Unit(benchmark::kMillisecond);
 
 BENCHMARK_TEMPLATE(BM_SingleAdd, LazyContiguousDataStreamBufferImpl)->Range(1024, 32 * 1024);
 BENCHMARK_TEMPLATE(BM_SingleAdd, AlwaysContiguousDataStreamBufferImpl)->Range(1024, 32 * 1024);
+BENCHMARK_TEMPLATE(BM_SingleAdd, RingDataStreamBufferImpl)->Range(1024, 32 * 1024);
 
 BENCHMARK_TEMPLATE(BM_OoOBytes, LazyContiguousDataStreamBufferImpl)
     ->Range(1024, 32 * 1024)
@@ -248,6 +341,9 @@ BENCHMARK_TEMPLATE(BM_OoOBytes, LazyContiguousDataStreamBufferImpl)
 BENCHMARK_TEMPLATE(BM_OoOBytes, AlwaysContiguousDataStreamBufferImpl)
     ->Range(1024, 32 * 1024)
     ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_OoOBytes, RingDataStreamBufferImpl)
+    ->Range(1024, 32 * 1024)
+    ->Unit(benchmark::kMillisecond);
 
 BENCHMARK_TEMPLATE(BM_OverrunCapacity, LazyContiguousDataStreamBufferImpl)
     ->Range(1024, 32 * 1024)
@@ -255,6 +351,9 @@ BENCHMARK_TEMPLATE(BM_OverrunCapacity, LazyContiguousDataStreamBufferImpl)
 BENCHMARK_TEMPLATE(BM_OverrunCapacity, AlwaysContiguousDataStreamBufferImpl)
     ->Range(32 * 1024, 32 * 1024)
     ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_OverrunCapacity, RingDataStreamBufferImpl)
+    ->Range(32 * 1024, 32 * 1024)
+    ->Unit(benchmark::kMillisecond);
 
 BENCHMARK_TEMPLATE(BM_LargeGap, LazyContiguousDataStreamBufferImpl)
     ->Range(1024, 32 * 1024)
@@ -262,6 +361,9 @@ BENCHMARK_TEMPLATE(BM_LargeGap, LazyContiguousDataStreamBufferImpl)
 BENCHMARK_TEMPLATE(BM_LargeGap, AlwaysContiguousDataStreamBufferImpl)
     ->Range(32 * 1024, 32 * 1024)
     ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_LargeGap, RingDataStreamBufferImpl)
+    ->Range(32 * 1024, 32 * 1024)
+    ->Unit(benchmark::kMillisecond);
 
 BENCHMARK_TEMPLATE(BM_RemovePrefix, LazyContiguousDataStreamBufferImpl)
     ->Range(1024, 32 * 1024)
@@ -269,3 +371,16 @@ BENCHMARK_TEMPLATE(BM_RemovePrefix, LazyContiguousDataStreamBufferImpl)
 BENCHMARK_TEMPLATE(BM_RemovePrefix, AlwaysContiguousDataStreamBufferImpl)
     ->Range(1024, 32 * 1024)
     ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_RemovePrefix, RingDataStreamBufferImpl)
+    ->Range(1024, 32 * 1024)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_GapsAndSpikes, LazyContiguousDataStreamBufferImpl)
+    ->Range(128, 16 * 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GapsAndSpikes, AlwaysContiguousDataStreamBufferImpl)
+    ->Range(128, 16 * 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GapsAndSpikes, RingDataStreamBufferImpl)
+    ->Range(128, 16 * 1024)
+    ->Unit(benchmark::kMillisecond);
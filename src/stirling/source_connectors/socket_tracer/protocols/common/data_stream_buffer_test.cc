@@ -18,24 +18,35 @@
 
 #include "src/stirling/source_connectors/socket_tracer/protocols/common/data_stream_buffer.h"
 
+#include <string>
+
 #include "src/common/testing/testing.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/ring_data_stream_buffer_impl.h"
 
 namespace px {
 namespace stirling {
 namespace protocols {
 
-class DataStreamBufferTest : public ::testing::TestWithParam<bool> {
+enum class BufferImpl { kAlwaysContiguous, kLazyContiguous, kRing };
+
+class DataStreamBufferTest : public ::testing::TestWithParam<BufferImpl> {
  protected:
   void SetUp() override {
-    old_flag_val_ = FLAGS_stirling_data_stream_buffer_always_contiguous_buffer;
-    FLAGS_stirling_data_stream_buffer_always_contiguous_buffer = GetParam();
+    old_always_contiguous_flag_val_ = FLAGS_stirling_data_stream_buffer_always_contiguous_buffer;
+    old_ring_flag_val_ = FLAGS_stirling_data_stream_buffer_ring_buffer;
+    // The ring buffer implementation behaves like the always contiguous one.
+    FLAGS_stirling_data_stream_buffer_always_contiguous_buffer =
+        GetParam() != BufferImpl::kLazyContiguous;
+    FLAGS_stirling_data_stream_buffer_ring_buffer = GetParam() == BufferImpl::kRing;
   }
   void TearDown() override {
-    FLAGS_stirling_data_stream_buffer_always_contiguous_buffer = old_flag_val_;
+    FLAGS_stirling_data_stream_buffer_always_contiguous_buffer = old_always_contiguous_flag_val_;
+    FLAGS_stirling_data_stream_buffer_ring_buffer = old_ring_flag_val_;
   }
 
  private:
-  bool old_flag_val_;
+  bool old_always_contiguous_flag_val_;
+  bool old_ring_flag_val_;
 };
 
 TEST_P(DataStreamBufferTest, AddAndGet) {
@@ -268,16 +279,69 @@ TEST_P(DataStreamBufferTest, LargeGap) {
   }
 }
 
+TEST_P(DataStreamBufferTest, WrapAround) {
+  // Enough data to go around a page sized ring several times.
+  DataStreamBuffer stream_buffer(4096, 4096, 4096);
+
+  size_t pos = 0;
+  for (int i = 0; i < 100; ++i) {
+    std::string data(300, 'a' + i % 26);
+    stream_buffer.Add(pos, data, pos);
+    pos += data.size();
+    EXPECT_EQ(stream_buffer.Head().substr(stream_buffer.size() - data.size()), data);
+    if (stream_buffer.size() > 3000) {
+      stream_buffer.RemovePrefix(1000);
+    }
+  }
+  EXPECT_EQ(stream_buffer.position() + stream_buffer.size(), pos);
+  EXPECT_EQ(stream_buffer.Head().size(), stream_buffer.size());
+
+  stream_buffer.ShrinkToFit();
+  EXPECT_EQ(stream_buffer.Head().substr(stream_buffer.size() - 300), std::string(300, 'v'));
+}
+
 INSTANTIATE_TEST_SUITE_P(DataStreamBufferImplTest, DataStreamBufferTest,
-                         ::testing::Values(true, false),
+                         ::testing::Values(BufferImpl::kAlwaysContiguous,
+                                           BufferImpl::kLazyContiguous, BufferImpl::kRing),
                          [](const ::testing::TestParamInfo<DataStreamBufferTest::ParamType>& info) {
-                           if (info.param) {
-                             return "AlwaysContiguousImpl";
-                           } else {
-                             return "LazyContiguousImpl";
+                           switch (info.param) {
+                             case BufferImpl::kAlwaysContiguous:
+                               return "AlwaysContiguousImpl";
+                             case BufferImpl::kLazyContiguous:
+                               return "LazyContiguousImpl";
+                             case BufferImpl::kRing:
+                               return "RingImpl";
                            }
+                           return "";
                          });
 
+TEST(DoubleMappedRingBufferTest, ContiguousAcrossTheEnd) {
+  DoubleMappedRingBuffer buffer(100);
+  EXPECT_EQ(buffer.capacity(), 0);
+  ASSERT_OK(buffer.Resize(100));
+  const size_t ring_size = buffer.capacity();
+  ASSERT_GE(ring_size, 100);
+
+  // Move the head close to the end of the ring, then write past the end.
+  ASSERT_OK(buffer.Resize(ring_size - 10));
+  buffer.RemovePrefix(ring_size - 10);
+  ASSERT_OK(buffer.Resize(20));
+  std::string data = "0123456789abcdefghij";
+  memcpy(buffer.data(), data.data(), data.size());
+  EXPECT_EQ(std::string_view(buffer.data(), buffer.size()), data);
+
+  buffer.RemovePrefix(15);
+  EXPECT_EQ(std::string_view(buffer.data(), buffer.size()), "fghij");
+  buffer.ShrinkToFit();
+  EXPECT_EQ(std::string_view(buffer.data(), buffer.size()), "fghij");
+
+  // Removing more than the size empties the buffer, and an empty buffer is unmapped.
+  buffer.RemovePrefix(100);
+  EXPECT_EQ(buffer.size(), 0);
+  buffer.ShrinkToFit();
+  EXPECT_EQ(buffer.capacity(), 0);
+}
+
 }  // namespace protocols
 }  // namespace stirling
 }  // namespace px
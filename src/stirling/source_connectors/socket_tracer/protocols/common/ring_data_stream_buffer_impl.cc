@@ -0,0 +1,132 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/ring_data_stream_buffer_impl.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "src/common/base/defer.h"
+#include "src/common/system/config.h"
+
+namespace px {
+namespace stirling {
+namespace protocols {
+
+namespace {
+
+size_t RingSize(size_t min_capacity) {
+  const size_t page_size = system::Config::GetInstance().PageSizeBytes();
+  return std::max<size_t>(1, (min_capacity + page_size - 1) / page_size) * page_size;
+}
+
+}  // namespace
+
+DoubleMappedRingBuffer::DoubleMappedRingBuffer(size_t min_capacity)
+    : ring_size_(RingSize(min_capacity)) {}
+
+DoubleMappedRingBuffer::~DoubleMappedRingBuffer() { Unmap(); }
+
+Status DoubleMappedRingBuffer::Map() {
+  int fd = memfd_create("data_stream_buffer", MFD_CLOEXEC);
+  if (fd < 0) {
+    return error::Internal("memfd_create failed: $0", std::strerror(errno));
+  }
+  // The mappings keep the memory alive, the file descriptor isn't needed once they exist.
+  DEFER(close(fd));
+  if (ftruncate(fd, ring_size_) != 0) {
+    return error::Internal("ftruncate of ring buffer to $0 bytes failed: $1", ring_size_,
+                           std::strerror(errno));
+  }
+
+  // Reserve the address range of both mappings, then map the ring over each half of it.
+  void* addr =
+      mmap(nullptr, 2 * ring_size_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (addr == MAP_FAILED) {
+    return error::Internal("Failed to reserve $0 bytes for ring buffer: $1", 2 * ring_size_,
+                           std::strerror(errno));
+  }
+  char* base = static_cast<char*>(addr);
+  for (char* half : {base, base + ring_size_}) {
+    if (mmap(half, ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) ==
+        MAP_FAILED) {
+      int err = errno;
+      munmap(base, 2 * ring_size_);
+      return error::Internal("Failed to map ring buffer: $0", std::strerror(err));
+    }
+  }
+  base_ = base;
+  return Status::OK();
+}
+
+void DoubleMappedRingBuffer::Unmap() {
+  if (base_ != nullptr) {
+    munmap(base_, 2 * ring_size_);
+    base_ = nullptr;
+  }
+  head_ = 0;
+  size_ = 0;
+}
+
+Status DoubleMappedRingBuffer::Resize(size_t size) {
+  DCHECK_LE(size, ring_size_);
+  if (base_ == nullptr) {
+    PX_RETURN_IF_ERROR(Map());
+  }
+  size_ = size;
+  return Status::OK();
+}
+
+void DoubleMappedRingBuffer::RemovePrefix(size_t n) {
+  // Like std::string::erase(), removing more than size() empties the buffer.
+  n = std::min(n, size_);
+  head_ = (head_ + n) % ring_size_;
+  size_ -= n;
+}
+
+void DoubleMappedRingBuffer::Clear() {
+  head_ = 0;
+  size_ = 0;
+}
+
+void DoubleMappedRingBuffer::ShrinkToFit() {
+  if (base_ == nullptr) {
+    return;
+  }
+  if (size_ == 0) {
+    Unmap();
+    return;
+  }
+  // The free part of the ring starts right after the data and wraps around to the head. It is
+  // contiguous in the second mapping, and the pages that it fully covers can be released.
+  const size_t page_size = system::Config::GetInstance().PageSizeBytes();
+  size_t free_begin = (head_ + size_ + page_size - 1) / page_size * page_size;
+  size_t free_end = (head_ + ring_size_) / page_size * page_size;
+  if (free_begin < free_end) {
+    // MADV_REMOVE frees the backing memory of the shared mapping; both mappings see zeros after.
+    madvise(base_ + free_begin, free_end - free_begin, MADV_REMOVE);
+  }
+}
+
+}  // namespace protocols
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/always_contiguous_data_stream_buffer_impl.h"
+
+namespace px {
+namespace stirling {
+namespace protocols {
+
+/**
+ * A ContiguousBuffer on a ring of memory that is mapped twice, back to back, in the virtual address
+ * space. Bytes that wrap around the end of the ring are also visible right after it, so any range
+ * of up to capacity() bytes can be read and written as one contiguous region. Removing bytes from
+ * the front only advances the head of the ring; the data is never moved.
+ *
+ * The ring is mapped on the first Resize(), so that idle connections don't hold any mappings.
+ */
+class DoubleMappedRingBuffer : public ContiguousBuffer {
+ public:
+  // The ring is min_capacity rounded up to a multiple of the page size.
+  explicit DoubleMappedRingBuffer(size_t min_capacity);
+  ~DoubleMappedRingBuffer() override;
+
+  char* data() override { return base_ == nullptr ? nullptr : base_ + head_; }
+  size_t size() const override { return size_; }
+  size_t capacity() const override { return base_ == nullptr ? 0 : ring_size_; }
+  Status Resize(size_t size) override;
+  void RemovePrefix(size_t n) override;
+  void Clear() override;
+
+  // Releases the pages of the ring that don't hold any data. Unmaps the ring when it is empty.
+  void ShrinkToFit() override;
+
+ private:
+  Status Map();
+  void Unmap();
+
+  const size_t ring_size_;
+  // Start of the first of the two mappings of the ring.
+  char* base_ = nullptr;
+  // Offset of the first byte of the buffer in the ring.
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
+
+/**
+ * The AlwaysContiguousDataStreamBufferImpl on a DoubleMappedRingBuffer. Parsers see the same
+ * contiguous views, but consuming data doesn't copy the rest of the buffer.
+ */
+class RingDataStreamBufferImpl : public AlwaysContiguousDataStreamBufferImpl {
+ public:
+  RingDataStreamBufferImpl(size_t max_capacity, size_t max_gap_size, size_t allow_before_gap_size)
+      : AlwaysContiguousDataStreamBufferImpl(
+            max_capacity, max_gap_size, allow_before_gap_size,
+            std::make_unique<DoubleMappedRingBuffer>(max_capacity)) {}
+};
+
+}  // namespace protocols
+}  // namespace stirling
+}  // namespace px
@@ -17,6 +17,7 @@
  */
 
 #include "src/stirling/source_connectors/socket_tracer/protocols/http/body_decoder.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/http/simd_search.h"
 
 #include <picohttpparser.h>
 
@@ -62,7 +63,7 @@ ParseState ExtractChunkLength(std::string_view* data, size_t* out) {
   // (e.g. Apache sets an 8K limit for headers).
   constexpr int kSearchWindow = 2048;
 
-  size_t delimiter_pos = data->substr(0, kSearchWindow).find("\r\n");
+  size_t delimiter_pos = SIMDFind(data->substr(0, kSearchWindow), "\r\n");
   if (delimiter_pos == data->npos) {
     return data->length() > kSearchWindow ? ParseState::kInvalid : ParseState::kNeedsMoreData;
   }
@@ -177,7 +178,7 @@ ParseState CustomParseChunked(std::string_view* buf, size_t body_size_limit_byte
     // so use that as a proxy of the maximum trailer size we can expect.
     constexpr int kSearchWindow = 8192;
 
-    size_t pos = data.substr(0, kSearchWindow).find("\r\n\r\n");
+    size_t pos = SIMDFind(data.substr(0, kSearchWindow), "\r\n\r\n");
     if (pos == data.npos) {
       return data.length() > kSearchWindow ? ParseState::kInvalid : ParseState::kNeedsMoreData;
     }
@@ -18,6 +18,7 @@
 
 #include "src/stirling/source_connectors/socket_tracer/protocols/http/parse.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/http/body_decoder.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/http/simd_search.h"
 
 #include <picohttpparser.h>
 
@@ -297,16 +298,23 @@ size_t FindFrameBoundary(message_type_t type, std::string_view buf, size_t start
   static constexpr ArrayView<std::string_view> kHTTPRespStartPatterns =
       ArrayView<std::string_view>(kHTTPRespStartPatternArray);
 
+  // The first characters of the patterns above.
+  static constexpr std::string_view kHTTPReqStartChars = "GHPDCOT";
+  static constexpr std::string_view kHTTPRespStartChars = "H";
+
   static constexpr std::string_view kBoundaryMarker = "\r\n\r\n";
 
   // Choose the right set of patterns for request vs response.
   const ArrayView<std::string_view>* start_patterns = nullptr;
+  std::string_view start_chars;
   switch (type) {
     case message_type_t::kRequest:
       start_patterns = &kHTTPReqStartPatterns;
+      start_chars = kHTTPReqStartChars;
       break;
     case message_type_t::kResponse:
       start_patterns = &kHTTPRespStartPatterns;
+      start_chars = kHTTPRespStartChars;
       break;
     case message_type_t::kUnknown:
       return std::string::npos;
@@ -324,7 +332,7 @@ size_t FindFrameBoundary(message_type_t type, std::string_view buf, size_t start
   // Note that we don't search forwards for HTTP/1.1 directly, because it could result in matches
   // inside the request/response body.
   while (true) {
-    size_t marker_pos = buf.find(kBoundaryMarker, start_pos);
+    size_t marker_pos = SIMDFind(buf, kBoundaryMarker, start_pos);
 
     if (marker_pos == std::string::npos) {
       return std::string::npos;
@@ -332,20 +340,21 @@ size_t FindFrameBoundary(message_type_t type, std::string_view buf, size_t start
 
     std::string_view buf_substr = buf.substr(start_pos, marker_pos - start_pos);
 
-    size_t substr_pos = std::string::npos;
-    for (auto& start_pattern : *start_patterns) {
-      size_t current_substr_pos = buf_substr.rfind(start_pattern);
-      if (current_substr_pos != std::string::npos) {
-        // Found a match. Check if it is closer to the marker than our previous match.
-        // We want to return the match that is closest to the marker, so we aren't
-        // matching to something in a previous message's body.
-        substr_pos = (substr_pos == std::string::npos) ? current_substr_pos
-                                                       : std::max(substr_pos, current_substr_pos);
+    // We want the match that is closest to the marker, so we aren't matching to something in a
+    // previous message's body. So walk backwards over the characters that can start a pattern,
+    // and stop at the first one that does.
+    for (size_t end = buf_substr.size(); end > 0;) {
+      size_t candidate_pos = SIMDFindLastOf(buf_substr.substr(0, end), start_chars);
+      if (candidate_pos == std::string::npos) {
+        break;
       }
-    }
-
-    if (substr_pos != std::string::npos) {
-      return start_pos + substr_pos;
+      std::string_view candidate = buf_substr.substr(candidate_pos);
+      for (auto& start_pattern : *start_patterns) {
+        if (absl::StartsWith(candidate, start_pattern)) {
+          return start_pos + candidate_pos;
+        }
+      }
+      end = candidate_pos;
     }
 
     // Couldn't find a start position. Move to the marker, and search for another marker.
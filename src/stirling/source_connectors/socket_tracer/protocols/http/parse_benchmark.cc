@@ -0,0 +1,142 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <string>
+
+#include <absl/strings/substitute.h>
+
+#include "src/common/base/base.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/event_parser.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/http/parse.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/http/simd_search.h"
+
+using px::stirling::protocols::ParseResult;
+using px::stirling::ParseState;
+using px::stirling::protocols::FindFrameBoundary;
+using px::stirling::protocols::ParseFramesLoop;
+using px::stirling::protocols::http::Message;
+using px::stirling::protocols::http::StateWrapper;
+
+// All benchmarks take whether to use the SIMD searches as their first argument.
+
+// Many small requests back to back, like a keep-alive connection of a busy client.
+std::string PipelinedRequests(int num_requests) {
+  std::string s;
+  for (int i = 0; i < num_requests; ++i) {
+    absl::StrAppend(&s, absl::Substitute("GET /api/v1/items/$0 HTTP/1.1\r\n"
+                                         "Host: service.namespace.svc.cluster.local\r\n"
+                                         "Accept: application/json\r\n"
+                                         "\r\n",
+                                         i));
+  }
+  return s;
+}
+
+// Requests with num_headers long headers each (cookies, tracing, auth tokens). Pico accepts at
+// most 50 headers.
+std::string LargeHeaderRequests(int num_requests, int num_headers) {
+  std::string headers;
+  for (int i = 0; i < num_headers; ++i) {
+    absl::StrAppend(&headers, absl::Substitute("X-Header-$0: $1\r\n", i, std::string(120, 'v')));
+  }
+  std::string s;
+  for (int i = 0; i < num_requests; ++i) {
+    absl::StrAppend(&s, "POST /upload HTTP/1.1\r\n", headers, "Content-Length: 4\r\n\r\nbody");
+  }
+  return s;
+}
+
+// Responses with a chunked body of num_chunks chunks each.
+std::string ChunkedResponses(int num_responses, int num_chunks) {
+  std::string body;
+  for (int i = 0; i < num_chunks; ++i) {
+    size_t chunk_size = 1 + (i * 37) % 500;
+    absl::StrAppend(&body, absl::Substitute("$0\r\n", absl::Hex(chunk_size)),
+                    std::string(chunk_size, 'x'), "\r\n");
+  }
+  absl::StrAppend(&body, "0\r\n\r\n");
+  std::string s;
+  for (int i = 0; i < num_responses; ++i) {
+    absl::StrAppend(&s, "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n", body);
+  }
+  return s;
+}
+
+void ParseAll(benchmark::State& state, message_type_t type,  // NOLINT
+              const std::string& buf) {
+  FLAGS_stirling_http_simd_search = state.range(0);
+  for (auto _ : state) {
+    std::deque<Message> frames;
+    StateWrapper parse_state{};
+    ParseResult result = ParseFramesLoop(type, buf, &frames, &parse_state);
+    CHECK(result.state == ParseState::kSuccess);
+    benchmark::DoNotOptimize(frames);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * buf.size());
+}
+
+// NOLINTNEXTLINE(runtime/references)
+static void BM_PipelinedRequests(benchmark::State& state) {
+  ParseAll(state, message_type_t::kRequest, PipelinedRequests(1000));
+}
+
+// NOLINTNEXTLINE(runtime/references)
+static void BM_LargeHeaders(benchmark::State& state) {
+  ParseAll(state, message_type_t::kRequest,
+           LargeHeaderRequests(100, state.range(1)));
+}
+
+// NOLINTNEXTLINE(runtime/references)
+static void BM_ChunkedBodies(benchmark::State& state) {
+  ParseAll(state, message_type_t::kResponse, ChunkedResponses(100, state.range(1)));
+}
+
+// Recovering the message boundary after losing data in the middle of a large response body.
+// NOLINTNEXTLINE(runtime/references)
+static void BM_FindFrameBoundary(benchmark::State& state) {
+  FLAGS_stirling_http_simd_search = state.range(0);
+  std::string buf = std::string(state.range(1), 'b') + PipelinedRequests(1);
+  StateWrapper parse_state{};
+  for (auto _ : state) {
+    size_t pos = FindFrameBoundary<Message>(message_type_t::kRequest, buf, 0,
+                                            &parse_state);
+    CHECK_EQ(pos, static_cast<size_t>(state.range(1)));
+    benchmark::DoNotOptimize(pos);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * buf.size());
+}
+
+BENCHMARK(BM_PipelinedRequests)->Arg(false)->Arg(true);
+BENCHMARK(BM_LargeHeaders)
+    ->Args({false, 10})
+    ->Args({true, 10})
+    ->Args({false, 40})
+    ->Args({true, 40});
+BENCHMARK(BM_ChunkedBodies)
+    ->Args({false, 10})
+    ->Args({true, 10})
+    ->Args({false, 100})
+    ->Args({true, 100});
+BENCHMARK(BM_FindFrameBoundary)
+    ->Args({false, 1024})
+    ->Args({true, 1024})
+    ->Args({false, 1024 * 1024})
+    ->Args({true, 1024 * 1024});
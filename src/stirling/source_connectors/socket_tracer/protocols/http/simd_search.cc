@@ -0,0 +1,208 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/source_connectors/socket_tracer/protocols/http/simd_search.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <cstring>
+
+#include "src/common/base/base.h"
+
+DEFINE_bool(stirling_http_simd_search,
+            gflags::BoolFromEnv("PL_STIRLING_HTTP_SIMD_SEARCH", true),
+            "Use SIMD instructions, when the CPU supports them, to search for HTTP message and "
+            "chunk boundaries.");
+
+namespace px {
+namespace stirling {
+namespace protocols {
+namespace http {
+
+namespace {
+
+#if defined(__x86_64__)
+
+// The searches are written once for both vector widths. For a needle of length k, candidates are
+// the positions where both the first and the last byte of the needle match; only those are
+// compared in full. See http://0x80.pl/articles/simd-strfind.html.
+//
+// The vector types never leave the target-specific VecOps functions, which only exchange bit
+// masks with the width-agnostic code below, so no function without AVX enabled passes a __m256i.
+template <size_t TWidth>
+struct VecOps;
+
+template <>
+struct VecOps<16> {
+  static constexpr size_t kWidth = 16;
+  // Returns a mask with bit i set if p[i] == c.
+  __attribute__((target("sse2"))) static uint32_t MatchMask(char c, const char* p) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(c), block));
+  }
+  // Returns a mask with bit i set if p[i] is any of chars.
+  __attribute__((target("sse2"))) static uint32_t MatchAnyMask(std::string_view chars,
+                                                               const char* p) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    uint32_t mask = 0;
+    for (char c : chars) {
+      mask |= _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(c), block));
+    }
+    return mask;
+  }
+};
+
+template <>
+struct VecOps<32> {
+  static constexpr size_t kWidth = 32;
+  __attribute__((target("avx2"))) static uint32_t MatchMask(char c, const char* p) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(c), block));
+  }
+  __attribute__((target("avx2"))) static uint32_t MatchAnyMask(std::string_view chars,
+                                                               const char* p) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    uint32_t mask = 0;
+    for (char c : chars) {
+      mask |= _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(c), block));
+    }
+    return mask;
+  }
+};
+
+template <size_t TWidth>
+inline __attribute__((always_inline)) size_t VecFind(std::string_view haystack,
+                                                     std::string_view needle, size_t pos) {
+  using Ops = VecOps<TWidth>;
+  const size_t k = needle.size();
+  if (k == 0 || pos >= haystack.size() || k > haystack.size() - pos) {
+    return haystack.find(needle, pos);
+  }
+  const char* h = haystack.data();
+  size_t i = pos;
+  for (; i + k - 1 + Ops::kWidth <= haystack.size(); i += Ops::kWidth) {
+    uint32_t mask =
+        Ops::MatchMask(needle.front(), h + i) & Ops::MatchMask(needle.back(), h + i + k - 1);
+    while (mask != 0) {
+      size_t candidate = i + __builtin_ctz(mask);
+      if (k <= 2 || std::memcmp(h + candidate + 1, needle.data() + 1, k - 2) == 0) {
+        return candidate;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return haystack.find(needle, i);
+}
+
+template <size_t TWidth>
+inline __attribute__((always_inline)) size_t VecFindLastOf(std::string_view haystack,
+                                                           std::string_view chars) {
+  using Ops = VecOps<TWidth>;
+  const char* h = haystack.data();
+  size_t end = haystack.size();
+  for (; end >= Ops::kWidth; end -= Ops::kWidth) {
+    uint32_t mask = Ops::MatchAnyMask(chars, h + end - Ops::kWidth);
+    if (mask != 0) {
+      return end - 1 - (__builtin_clz(mask) - (32 - Ops::kWidth));
+    }
+  }
+  return haystack.substr(0, end).find_last_of(chars);
+}
+
+__attribute__((target("sse2"))) size_t FindSSE2(std::string_view haystack,
+                                                std::string_view needle, size_t pos) {
+  return VecFind<16>(haystack, needle, pos);
+}
+
+__attribute__((target("avx2"))) size_t FindAVX2(std::string_view haystack,
+                                                std::string_view needle, size_t pos) {
+  return VecFind<32>(haystack, needle, pos);
+}
+
+__attribute__((target("sse2"))) size_t FindLastOfSSE2(std::string_view haystack,
+                                                      std::string_view chars) {
+  return VecFindLastOf<16>(haystack, chars);
+}
+
+__attribute__((target("avx2"))) size_t FindLastOfAVX2(std::string_view haystack,
+                                                      std::string_view chars) {
+  return VecFindLastOf<32>(haystack, chars);
+}
+
+#endif
+
+SIMDSearchImpl SelectedImpl() {
+  static const SIMDSearchImpl kBestImpl = BestSIMDSearchImpl();
+  return FLAGS_stirling_http_simd_search ? kBestImpl : SIMDSearchImpl::kScalar;
+}
+
+}  // namespace
+
+SIMDSearchImpl BestSIMDSearchImpl() {
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return SIMDSearchImpl::kAVX2;
+  }
+  return SIMDSearchImpl::kSSE2;
+#else
+  return SIMDSearchImpl::kScalar;
+#endif
+}
+
+size_t SIMDFind(SIMDSearchImpl impl, std::string_view haystack, std::string_view needle,
+                size_t pos) {
+  switch (impl) {
+#if defined(__x86_64__)
+    case SIMDSearchImpl::kAVX2:
+      return FindAVX2(haystack, needle, pos);
+    case SIMDSearchImpl::kSSE2:
+      return FindSSE2(haystack, needle, pos);
+#endif
+    default:
+      return haystack.find(needle, pos);
+  }
+}
+
+size_t SIMDFind(std::string_view haystack, std::string_view needle, size_t pos) {
+  return SIMDFind(SelectedImpl(), haystack, needle, pos);
+}
+
+size_t SIMDFindLastOf(SIMDSearchImpl impl, std::string_view haystack, std::string_view chars) {
+  switch (impl) {
+#if defined(__x86_64__)
+    case SIMDSearchImpl::kAVX2:
+      return FindLastOfAVX2(haystack, chars);
+    case SIMDSearchImpl::kSSE2:
+      return FindLastOfSSE2(haystack, chars);
+#endif
+    default:
+      return haystack.find_last_of(chars);
+  }
+}
+
+size_t SIMDFindLastOf(std::string_view haystack, std::string_view chars) {
+  return SIMDFindLastOf(SelectedImpl(), haystack, chars);
+}
+
+}  // namespace http
+}  // namespace protocols
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <gflags/gflags.h>
+
+#include <string_view>
+
+DECLARE_bool(stirling_http_simd_search);
+
+namespace px {
+namespace stirling {
+namespace protocols {
+namespace http {
+
+/**
+ * Byte searches used to find HTTP message and chunk boundaries, with SIMD implementations.
+ *
+ * The implementation is picked at runtime from what the CPU supports: AVX2 (32 bytes at a time),
+ * SSE2 (16 bytes at a time, always available on x86-64), or a scalar fallback on other
+ * architectures and when --stirling_http_simd_search is false.
+ */
+enum class SIMDSearchImpl {
+  kScalar,
+  kSSE2,
+  kAVX2,
+};
+
+/**
+ * The fastest implementation supported by the CPU.
+ */
+SIMDSearchImpl BestSIMDSearchImpl();
+
+/**
+ * Same as haystack.find(needle, pos).
+ */
+size_t SIMDFind(std::string_view haystack, std::string_view needle, size_t pos = 0);
+size_t SIMDFind(SIMDSearchImpl impl, std::string_view haystack, std::string_view needle,
+                size_t pos = 0);
+
+/**
+ * Same as haystack.find_last_of(chars). Meant for a handful of chars.
+ */
+size_t SIMDFindLastOf(std::string_view haystack, std::string_view chars);
+size_t SIMDFindLastOf(SIMDSearchImpl impl, std::string_view haystack, std::string_view chars);
+
+}  // namespace http
+}  // namespace protocols
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/source_connectors/socket_tracer/protocols/http/simd_search.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace stirling {
+namespace protocols {
+namespace http {
+
+class SIMDSearchTest : public ::testing::TestWithParam<SIMDSearchImpl> {
+ protected:
+  void SetUp() override {
+    if (GetParam() == SIMDSearchImpl::kAVX2 && BestSIMDSearchImpl() != SIMDSearchImpl::kAVX2) {
+      GTEST_SKIP() << "AVX2 is not supported by this CPU.";
+    }
+    if (GetParam() == SIMDSearchImpl::kSSE2 && BestSIMDSearchImpl() == SIMDSearchImpl::kScalar) {
+      GTEST_SKIP() << "SSE2 is not supported by this CPU.";
+    }
+  }
+};
+
+TEST_P(SIMDSearchTest, Find) {
+  const std::string_view haystack =
+      "GET / HTTP/1.1\r\nHost: a\r\n\r\nGET /index.html HTTP/1.1\r\nAccept: */*\r\n\r\n";
+  EXPECT_EQ(SIMDFind(GetParam(), haystack, "\r\n\r\n"), 23);
+  EXPECT_EQ(SIMDFind(GetParam(), haystack, "\r\n\r\n", 24), 64);
+  EXPECT_EQ(SIMDFind(GetParam(), haystack, "\r\n\r\n", 65), std::string_view::npos);
+  EXPECT_EQ(SIMDFind(GetParam(), haystack, "HTTP/1.1", 10), 43);
+  EXPECT_EQ(SIMDFind(GetParam(), haystack, "POST"), std::string_view::npos);
+  EXPECT_EQ(SIMDFind(GetParam(), haystack, ""), 0);
+  EXPECT_EQ(SIMDFind(GetParam(), "", "\r\n"), std::string_view::npos);
+}
+
+TEST_P(SIMDSearchTest, FindLastOf) {
+  const std::string_view haystack =
+      "xxHTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\nbody of the message";
+  EXPECT_EQ(SIMDFindLastOf(GetParam(), haystack, "H"), 2);
+  EXPECT_EQ(SIMDFindLastOf(GetParam(), haystack, "GHPDCOT"), 19);
+  EXPECT_EQ(SIMDFindLastOf(GetParam(), haystack, "Z"), std::string_view::npos);
+  EXPECT_EQ(SIMDFindLastOf(GetParam(), "", "H"), std::string_view::npos);
+}
+
+// Compares against std::string_view on random inputs, which have lots of partial matches and
+// matches across the vector boundaries.
+TEST_P(SIMDSearchTest, MatchesStringView) {
+  std::mt19937 rng(37);
+  const std::vector<std::string_view> needles = {"\r\n\r\n", "\r\n", "\r", "HTTP/1.1 ", "GET "};
+  const std::vector<std::string_view> char_sets = {"H", "GHPDCOT", "\n"};
+  for (int i = 0; i < 2000; ++i) {
+    std::string haystack(rng() % 300, ' ');
+    for (char& c : haystack) {
+      c = "\r\nHTTP/1.1 GET"[rng() % 14];
+    }
+    const size_t pos = rng() % (haystack.size() + 2);
+    for (std::string_view needle : needles) {
+      EXPECT_EQ(SIMDFind(GetParam(), haystack, needle, pos),
+                std::string_view(haystack).find(needle, pos));
+    }
+    for (std::string_view chars : char_sets) {
+      EXPECT_EQ(SIMDFindLastOf(GetParam(), haystack, chars),
+                std::string_view(haystack).find_last_of(chars));
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllImpls, SIMDSearchTest,
+                         ::testing::Values(SIMDSearchImpl::kScalar, SIMDSearchImpl::kSSE2,
+                                           SIMDSearchImpl::kAVX2));
+
+}  // namespace http
+}  // namespace protocols
+}  // namespace stirling
+}  // namespace px
@@ -24,9 +24,11 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <tuple>
 #include <utility>
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/hash/hash.h>
 #include <absl/strings/match.h>
 #include <google/protobuf/text_format.h>
 #include <google/protobuf/util/delimited_message_util.h>
@@ -144,6 +146,12 @@ DEFINE_uint32(datastream_buffer_retention_size,
               gflags::Uint32FromEnv("PL_DATASTREAM_BUFFER_SIZE", 1024 * 1024),
               "The maximum size of a data stream buffer retained between cycles.");
 
+DEFINE_int32(stirling_socket_tracer_num_parse_threads,
+             gflags::Int32FromEnv("PL_STIRLING_SOCKET_TRACER_NUM_PARSE_THREADS", 1),
+             "Number of threads that parse and stitch the data of the traced connections. "
+             "Connections are sharded across the threads by their connection ID. "
+             "A value of 1 parses all connections on the Stirling thread.");
+
 DEFINE_uint64(max_body_bytes, gflags::Uint64FromEnv("PL_STIRLING_MAX_BODY_BYTES", 512),
               "The maximum number of bytes in the body of protocols like HTTP");
 
@@ -411,6 +419,9 @@ Status SocketTraceConnector::InitBPF() {
 
   const auto kPerfBufferSpecs = InitPerfBufferSpecs();
   PX_RETURN_IF_ERROR(OpenPerfBuffers(kPerfBufferSpecs, this));
+  // The first perf buffer is the one for data events.
+  data_perf_buffer_bytes_ =
+      static_cast<int64_t>(kPerfBufferSpecs[0].size_bytes) * get_nprocs_conf();
   LOG(INFO) << absl::Substitute("Number of perf buffers opened = $0", kPerfBufferSpecs.size());
 
   // Set trace role to BPF probes.
@@ -580,8 +591,20 @@ void SocketTraceConnector::UpdateCommonState(ConnectorContext* ctx) {
   // so raw data will be pushed to connection trackers more aggressively.
   // No data is lost, but this is a side-effect of sorts that affects timing of transfers.
   // It may be worth noting during debug.
+  const int64_t data_bytes_before_poll = stats_.Get(StatKey::kPollSocketDataEventSize);
+  const int64_t data_losses_before_poll = stats_.Get(StatKey::kLossSocketDataEvent);
   PollPerfBuffers();
 
+  // The perf buffers are per-CPU, so traffic on a single CPU can fill its buffer while the average
+  // occupancy stays low. Any loss means that at least one of them was full.
+  if (stats_.Get(StatKey::kLossSocketDataEvent) > data_losses_before_poll) {
+    perf_buffer_occupancy_ = 1;
+  } else if (data_perf_buffer_bytes_ > 0) {
+    perf_buffer_occupancy_ =
+        1.0 * (stats_.Get(StatKey::kPollSocketDataEventSize) - data_bytes_before_poll) /
+        data_perf_buffer_bytes_;
+  }
+
   // Set-up current state for connection inference purposes.
   if (socket_info_mgr_ != nullptr) {
     socket_info_mgr_->Flush();
@@ -655,14 +678,10 @@ void SocketTraceConnector::TransferDataImpl(ConnectorContext* ctx) {
     }
   }
 
-  for (const auto& conn_tracker : conn_trackers_mgr_.active_trackers()) {
-    const auto& transfer_spec = protocol_transfer_specs_[conn_tracker->protocol()];
-
-    DataTable* data_table = nullptr;
-    if (transfer_spec.enabled) {
-      data_table = data_tables_[transfer_spec.table_num];
-    }
+  const bool sharded = FLAGS_stirling_socket_tracer_num_parse_threads > 1;
+  std::vector<ConnTracker*> sharded_trackers;
 
+  for (const auto& conn_tracker : conn_trackers_mgr_.active_trackers()) {
     UpdateTrackerTraceLevel(conn_tracker);
 
     // Once a known UPID, always a known UPID.
@@ -677,23 +696,95 @@ void SocketTraceConnector::TransferDataImpl(ConnectorContext* ctx) {
     conn_tracker->IterationPreTick(iteration_time_, cluster_cidrs, proc_parser_.get(),
                                    socket_info_mgr_.get());
 
-    if (transfer_spec.transfer_fn != nullptr) {
-      transfer_spec.transfer_fn(*this, ctx, conn_tracker, data_table);
-    } else {
-      // If there's no transfer function, then the tracker should not be holding any data.
-      // http::ProtocolTraits is used as a placeholder; the frames deque is expected to be
-      // std::monotstate.
-      ECHECK(conn_tracker->send_data().Empty<protocols::http::Message>());
-      ECHECK(conn_tracker->recv_data().Empty<protocols::http::Message>());
+    // The pre and post ticks share the socket info manager and the BPF maps, so they always run
+    // on this thread. Only the parsing and stitching is handed to the parse workers.
+    if (sharded) {
+      sharded_trackers.push_back(conn_tracker);
+      continue;
     }
 
+    TransferConnTracker(ctx, conn_tracker, data_tables_);
+
     conn_tracker->IterationPostTick();
   }
 
+  if (sharded) {
+    TransferConnTrackersSharded(ctx, sharded_trackers);
+    for (ConnTracker* conn_tracker : sharded_trackers) {
+      conn_tracker->IterationPostTick();
+    }
+  }
+
   // Once we've cleared all the debug trace levels for this pid, we can remove it from the list.
   pids_to_trace_disable_.clear();
 }
 
+void SocketTraceConnector::TransferConnTracker(ConnectorContext* ctx, ConnTracker* conn_tracker,
+                                               const std::vector<DataTable*>& data_tables) {
+  const auto& transfer_spec = protocol_transfer_specs_[conn_tracker->protocol()];
+
+  DataTable* data_table = nullptr;
+  if (transfer_spec.enabled) {
+    data_table = data_tables[transfer_spec.table_num];
+  }
+
+  if (transfer_spec.transfer_fn != nullptr) {
+    transfer_spec.transfer_fn(*this, ctx, conn_tracker, data_table);
+  } else {
+    // If there's no transfer function, then the tracker should not be holding any data.
+    // http::ProtocolTraits is used as a placeholder; the frames deque is expected to be
+    // std::monotstate.
+    ECHECK(conn_tracker->send_data().Empty<protocols::http::Message>());
+    ECHECK(conn_tracker->recv_data().Empty<protocols::http::Message>());
+  }
+}
+
+void SocketTraceConnector::TransferConnTrackersSharded(
+    ConnectorContext* ctx, const std::vector<ConnTracker*>& conn_trackers) {
+  const int num_shards = FLAGS_stirling_socket_tracer_num_parse_threads;
+  if (parse_workers_ == nullptr || parse_workers_->num_shards() != num_shards) {
+    parse_workers_ = std::make_unique<WorkerPool>(num_shards);
+    parse_worker_tables_.clear();
+    parse_worker_data_tables_.clear();
+    parse_worker_data_tables_.push_back(data_tables_);
+    for (int shard = 1; shard < num_shards; ++shard) {
+      std::vector<DataTable*> shard_tables(data_tables_.size(), nullptr);
+      for (size_t i = 0; i < data_tables_.size(); ++i) {
+        if (data_tables_[i] != nullptr) {
+          parse_worker_tables_.push_back(
+              std::make_unique<DataTable>(data_tables_[i]->id(), kTables[i]));
+          shard_tables[i] = parse_worker_tables_.back().get();
+        }
+      }
+      parse_worker_data_tables_.push_back(std::move(shard_tables));
+    }
+  }
+
+  // All the data of a connection is always parsed by the same shard, which keeps the parse state
+  // of a tracker on one thread at a time, and the order of its records.
+  std::vector<std::vector<ConnTracker*>> shards(num_shards);
+  for (ConnTracker* conn_tracker : conn_trackers) {
+    const struct conn_id_t& conn_id = conn_tracker->conn_id();
+    size_t hash = absl::Hash<std::tuple<uint32_t, int32_t, uint64_t>>{}(
+        std::make_tuple(conn_id.upid.pid, conn_id.fd, conn_id.tsid));
+    shards[hash % num_shards].push_back(conn_tracker);
+  }
+
+  parse_workers_->Run([&](int shard) {
+    for (ConnTracker* conn_tracker : shards[shard]) {
+      TransferConnTracker(ctx, conn_tracker, parse_worker_data_tables_[shard]);
+    }
+  });
+
+  for (int shard = 1; shard < num_shards; ++shard) {
+    for (size_t i = 0; i < data_tables_.size(); ++i) {
+      if (data_tables_[i] != nullptr) {
+        data_tables_[i]->MoveRecordsFrom(parse_worker_data_tables_[shard][i]);
+      }
+    }
+  }
+}
+
 Status SocketTraceConnector::UpdateBPFProtocolTraceRole(traffic_protocol_t protocol,
                                                         uint64_t role_mask) {
   auto control_map_handle = GetPerCPUArrayTable<uint64_t>(kControlMapName);
@@ -22,6 +22,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -48,6 +49,7 @@
 #include "src/stirling/utils/linux_headers.h"
 #include "src/stirling/utils/proc_path_tools.h"
 #include "src/stirling/utils/proc_tracker.h"
+#include "src/stirling/utils/worker_pool.h"
 
 DECLARE_uint32(stirling_conn_stats_sampling_ratio);
 DECLARE_bool(stirling_enable_periodic_bpf_map_cleanup);
@@ -118,6 +120,8 @@ class SocketTraceConnector : public SourceConnector, public bpf_tools::BCCWrappe
   void InitContextImpl(ConnectorContext* ctx) override;
   void TransferDataImpl(ConnectorContext* ctx) override;
 
+  std::optional<double> InputBufferOccupancy() const override { return perf_buffer_occupancy_; }
+
   // Perform actions that are not specifically targeting a table.
   // For example, drain perf buffers, deploy new uprobes, and update socket info manager.
   // If these were performed on every TransferData(), they would occur too frequently,
@@ -204,6 +208,16 @@ class SocketTraceConnector : public SourceConnector, public bpf_tools::BCCWrappe
   void TransferStream(ConnectorContext* ctx, ConnTracker* tracker, DataTable* data_table);
   void TransferConnStats(ConnectorContext* ctx, DataTable* data_table);
 
+  // Runs the transfer function of the tracker's protocol, appending the records to the table of
+  // the protocol in data_tables.
+  void TransferConnTracker(ConnectorContext* ctx, ConnTracker* conn_tracker,
+                           const std::vector<DataTable*>& data_tables);
+
+  // Transfers the data of the trackers on the parse workers, each worker handling the trackers
+  // of its shard of connections. The records of the workers are merged into data_tables_.
+  void TransferConnTrackersSharded(ConnectorContext* ctx,
+                                   const std::vector<ConnTracker*>& conn_trackers);
+
   void set_iteration_time(std::chrono::time_point<std::chrono::steady_clock> time) {
     DCHECK(time >= iteration_time_);
     iteration_time_ = time;
@@ -265,6 +279,11 @@ class SocketTraceConnector : public SourceConnector, public bpf_tools::BCCWrappe
   //   Example: data_table->SetConsumeRecordsCutoffTime(perf_buffer_drain_time_);
   uint64_t perf_buffer_drain_time_ = 0;
 
+  // Total size of the socket data perf buffers, across all CPUs, and the fraction of it that was
+  // filled when the perf buffers were last drained. Reported to the adaptive scheduler.
+  int64_t data_perf_buffer_bytes_ = 0;
+  double perf_buffer_occupancy_ = 0;
+
   // If not a nullptr, writes the events received from perf buffers to this stream.
   std::unique_ptr<std::ofstream> perf_buffer_events_output_stream_;
   enum class OutputFormat {
@@ -282,6 +301,14 @@ class SocketTraceConnector : public SourceConnector, public bpf_tools::BCCWrappe
 
   UProbeManager uprobe_mgr_;
 
+  // Only used when --stirling_socket_tracer_num_parse_threads is greater than 1.
+  std::unique_ptr<WorkerPool> parse_workers_;
+  // The tables that each parse worker appends records to, indexed like data_tables_. Shard 0 is
+  // run by the Stirling thread and uses data_tables_ directly, the other shards own their tables
+  // (see parse_worker_tables_) and are merged into data_tables_ after each transfer.
+  std::vector<std::vector<DataTable*>> parse_worker_data_tables_;
+  std::vector<std::unique_ptr<DataTable>> parse_worker_tables_;
+
   enum class StatKey {
     kLossSocketDataEvent,
     kLossSocketControlEvent,
@@ -824,16 +824,24 @@ void StirlingImpl::RunCore() {
       for (auto& source : sources_) {
         // Phase 1: Probe each source for its data.
         if (source->sampling_freq_mgr().Expired(now_plus_run_window)) {
+          const auto transfer_start = now;
           source->TransferData(ctx.get());
 
           // TransferData() is normally a significant amount of work: update "time now".
           now = std::chrono::steady_clock::now();
+          if (source->adaptive_scheduler() != nullptr) {
+            source->adaptive_scheduler()->TransferredData(now - transfer_start,
+                                                          source->InputBufferOccupancy());
+          }
           source->sampling_freq_mgr().Reset(now);
           run_core_stats_.IncrementTransferDataCount();
         }
         // Phase 2: Push Data upstream.
         if (source->push_freq_mgr().Expired(now_plus_run_window) ||
             DataExceedsThreshold(source->data_tables())) {
+          if (source->adaptive_scheduler() != nullptr) {
+            source->adaptive_scheduler()->PushingData(source->data_tables());
+          }
           source->PushData(data_push_callback_);
 
           // PushData() is normally a significant amount of work: update "time now".
@@ -142,14 +142,15 @@ inline types::ColumnWrapperRecordBatch FindRecordsMatchingPID(
 }
 
 // Note the index is column major, so it comes before row_idx.
+// Values are returned by value, because string columns don't necessarily store StringValues.
 template <typename TValueType>
-inline const TValueType& AccessRecordBatch(const types::ColumnWrapperRecordBatch& record_batch,
-                                           int column_idx, int row_idx) {
+inline TValueType AccessRecordBatch(const types::ColumnWrapperRecordBatch& record_batch,
+                                    int column_idx, int row_idx) {
   return record_batch[column_idx]->Get<TValueType>(row_idx);
 }
 
 template <>
-inline const std::string& AccessRecordBatch<std::string>(
+inline std::string AccessRecordBatch<std::string>(
     const types::ColumnWrapperRecordBatch& record_batch, int column_idx, int row_idx) {
   return record_batch[column_idx]->Get<types::StringValue>(row_idx);
 }
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/utils/worker_pool.h"
+
+#include <algorithm>
+
+namespace px {
+namespace stirling {
+
+WorkerPool::WorkerPool(int num_shards) : num_shards_(std::max(num_shards, 1)) {
+  for (int shard = 1; shard < num_shards_; ++shard) {
+    threads_.emplace_back(&WorkerPool::WorkerLoop, this, shard);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  run_cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::Run(const std::function<void(int)>& fn) {
+  if (threads_.empty()) {
+    fn(0);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fn_ = &fn;
+    num_pending_ = static_cast<int>(threads_.size());
+    ++run_id_;
+  }
+  run_cv_.notify_all();
+
+  fn(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return num_pending_ == 0; });
+  fn_ = nullptr;
+}
+
+void WorkerPool::WorkerLoop(int shard) {
+  uint64_t last_run_id = 0;
+  while (true) {
+    const std::function<void(int)>* fn = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      run_cv_.wait(lock, [&] { return stop_ || run_id_ != last_run_id; });
+      if (stop_) {
+        return;
+      }
+      last_run_id = run_id_;
+      fn = fn_;
+    }
+
+    (*fn)(shard);
+
+    bool last = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      last = (--num_pending_ == 0);
+    }
+    if (last) {
+      done_cv_.notify_one();
+    }
+  }
+}
+
+}  // namespace stirling
+}  // namespace px
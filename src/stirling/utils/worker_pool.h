@@ -0,0 +1,76 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace stirling {
+
+/**
+ * WorkerPool runs a function on a fixed number of shards in parallel, using threads that are kept
+ * alive between runs, so that work can be spread across threads every iteration without paying
+ * for thread creation.
+ *
+ * Shard 0 is run by the calling thread, so a pool of one shard creates no threads and is
+ * equivalent to calling the function directly.
+ *
+ * Example:
+ *   WorkerPool pool(4);
+ *   pool.Run([&](int shard) { Process(shards[shard]); });
+ */
+class WorkerPool : public NotCopyable {
+ public:
+  explicit WorkerPool(int num_shards);
+  ~WorkerPool();
+
+  int num_shards() const { return num_shards_; }
+
+  /**
+   * Calls fn(shard) for every shard in [0, num_shards), in parallel.
+   * Returns once all the calls have returned. Run() must not be called concurrently.
+   */
+  void Run(const std::function<void(int)>& fn);
+
+ private:
+  void WorkerLoop(int shard);
+
+  const int num_shards_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  // Signals the workers that a new run has started, or that they should stop.
+  std::condition_variable run_cv_;
+  // Signals Run() that the last worker of the run has finished.
+  std::condition_variable done_cv_;
+  const std::function<void(int)>* fn_ = nullptr;
+  // Incremented for every run, so that the workers can tell a new run from a spurious wakeup.
+  uint64_t run_id_ = 0;
+  int num_pending_ = 0;
+  bool stop_ = false;
+};
+
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/stirling/utils/worker_pool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace stirling {
+
+TEST(WorkerPoolTest, RunsEveryShard) {
+  WorkerPool pool(4);
+  ASSERT_EQ(pool.num_shards(), 4);
+
+  std::vector<int> counts(pool.num_shards(), 0);
+  for (int i = 0; i < 100; ++i) {
+    pool.Run([&](int shard) { ++counts[shard]; });
+  }
+  EXPECT_THAT(counts, ::testing::Each(100));
+}
+
+TEST(WorkerPoolTest, ShardsRunInParallel) {
+  WorkerPool pool(3);
+
+  // Every shard waits for all the others, which only completes if they run at the same time.
+  std::atomic<int> num_started = 0;
+  pool.Run([&](int) {
+    ++num_started;
+    while (num_started.load() < 3) {
+      std::this_thread::yield();
+    }
+  });
+  EXPECT_EQ(num_started.load(), 3);
+}
+
+TEST(WorkerPoolTest, SingleShardRunsOnCaller) {
+  WorkerPool pool(1);
+  std::thread::id id;
+  pool.Run([&](int shard) {
+    EXPECT_EQ(shard, 0);
+    id = std::this_thread::get_id();
+  });
+  EXPECT_EQ(id, std::this_thread::get_id());
+}
+
+}  // namespace stirling
+}  // namespace px
@@ -17,12 +17,16 @@
  */
 
 #include <arrow/array.h>
+#include <arrow/buffer.h>
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <absl/strings/str_format.h>
+#include <absl/strings/str_join.h>
 #include "src/common/base/base.h"
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/type_utils.h"
@@ -51,6 +55,56 @@ Status RowBatch::AddColumn(const std::shared_ptr<arrow::Array>& col) {
   return Status::OK();
 }
 
+Status RowBatch::SetSelection(std::shared_ptr<const std::vector<int64_t>> selection) {
+  if (selection != nullptr) {
+    for (const auto& [i, row] : Enumerate(*selection)) {
+      if (row < 0 || row >= num_rows_ || (i > 0 && row <= selection->at(i - 1))) {
+        return error::InvalidArgument(
+            "Selection must be sorted and within the $0 rows of the columns, got $1 at $2",
+            num_rows_, row, i);
+      }
+    }
+  }
+  selection_ = std::move(selection);
+  return Status::OK();
+}
+
+namespace {
+
+template <DataType T>
+Status GatherValues(const arrow::Array* input_col, const std::vector<int64_t>& selection,
+                    arrow::MemoryPool* mem_pool, std::shared_ptr<arrow::Array>* output_col) {
+  auto builder = types::MakeArrowBuilder(T, mem_pool);
+  PX_RETURN_IF_ERROR(builder->Reserve(selection.size()));
+  for (int64_t row : selection) {
+    PX_RETURN_IF_ERROR(
+        CopyValue<T>(builder.get(), types::GetValueFromArrowArray<T>(input_col, row)));
+  }
+  PX_RETURN_IF_ERROR(builder->Finish(output_col));
+  return Status::OK();
+}
+
+}  // namespace
+
+StatusOr<std::unique_ptr<RowBatch>> RowBatch::Compact(arrow::MemoryPool* mem_pool) const {
+  auto output_rb = std::make_unique<RowBatch>(desc_, num_rows());
+  output_rb->set_eow(eow_);
+  output_rb->set_eos(eos_);
+  for (const auto& [col_idx, col] : Enumerate(columns_)) {
+    if (selection_ == nullptr) {
+      PX_RETURN_IF_ERROR(output_rb->AddColumn(col));
+      continue;
+    }
+    std::shared_ptr<arrow::Array> output_col;
+#define TYPE_CASE(_dt_) \
+  PX_RETURN_IF_ERROR(GatherValues<_dt_>(col.get(), *selection_, mem_pool, &output_col));
+    PX_SWITCH_FOREACH_DATATYPE(desc_.type(col_idx), TYPE_CASE);
+#undef TYPE_CASE
+    PX_RETURN_IF_ERROR(output_rb->AddColumn(output_col));
+  }
+  return output_rb;
+}
+
 bool RowBatch::HasColumn(int64_t i) const { return columns_.size() > static_cast<size_t>(i); }
 
 std::string RowBatch::DebugString() const {
@@ -58,6 +112,9 @@ std::string RowBatch::DebugString() const {
     return "RowBatch: <empty>";
   }
   std::string debug_string = absl::StrFormat("RowBatch(eow=%d, eos=%d):\n", eow_, eos_);
+  if (selection_ != nullptr) {
+    debug_string += absl::StrFormat("  selection: [%s]\n", absl::StrJoin(*selection_, ", "));
+  }
   for (const auto& col : columns_) {
     debug_string += absl::StrFormat("  %s\n", col->ToString());
   }
@@ -75,6 +132,10 @@ int64_t RowBatch::NumBytes() const {
     PX_SWITCH_FOREACH_DATATYPE(types::ArrowToDataType(col->type_id()), TYPE_CASE);
 #undef TYPE_CASE
   }
+  if (selection_ != nullptr) {
+    // Estimate the bytes of the selected rows from the size of the columns.
+    total_bytes = total_bytes * num_rows() / num_rows_;
+  }
   return total_bytes;
 }
 
@@ -159,6 +220,10 @@ Status CopyFromInputPB(std::shared_ptr<arrow::Array>* output_column,
 }
 
 Status RowBatch::ToProto(table_store::schemapb::RowBatchData* proto) const {
+  if (selection_ != nullptr) {
+    PX_ASSIGN_OR_RETURN(auto compacted_rb, Compact());
+    return compacted_rb->ToProto(proto);
+  }
   proto->set_num_rows(num_rows_);
   proto->set_eow(eow_);
   proto->set_eos(eos_);
@@ -223,6 +288,235 @@ StatusOr<std::unique_ptr<RowBatch>> RowBatch::FromProto(
   return output_rb;
 }
 
+namespace {
+
+// The buffers of a ColumnarRowBatchData start at multiples of this many bytes, so that the values
+// of the decoded columns are aligned.
+constexpr size_t kColumnarBufferAlignment = 8;
+
+size_t AlignColumnarBuffer(size_t size) {
+  return (size + kColumnarBufferAlignment - 1) & ~(kColumnarBufferAlignment - 1);
+}
+
+size_t BitmapBytes(int64_t num_rows) { return (num_rows + 7) / 8; }
+
+template <DataType T>
+constexpr size_t FixedValueBytes() {
+  return sizeof(typename types::DataTypeTraits<T>::native_type);
+}
+
+// Appends the sizes of the buffers that the column is encoded as.
+template <DataType T>
+void AddColumnarBufferSizes(const arrow::Array* col,
+                            table_store::schemapb::ColumnarRowBatchData* proto) {
+  if constexpr (T == DataType::STRING) {
+    const auto* str_col = static_cast<const arrow::StringArray*>(col);
+    proto->add_buffer_sizes((col->length() + 1) * sizeof(int32_t));
+    proto->add_buffer_sizes(str_col->value_offset(col->length()) - str_col->value_offset(0));
+  } else if constexpr (T == DataType::BOOLEAN) {
+    proto->add_buffer_sizes(BitmapBytes(col->length()));
+  } else {
+    proto->add_buffer_sizes(col->length() * FixedValueBytes<T>());
+  }
+}
+
+// Writes the buffers of the column at dst, and returns the position after them.
+template <DataType T>
+uint8_t* WriteColumnarBuffers(const arrow::Array* col, uint8_t* dst) {
+  const int64_t num_rows = col->length();
+  if constexpr (T == DataType::STRING) {
+    // The offsets are rebased so that they start at 0 for sliced columns.
+    const auto* str_col = static_cast<const arrow::StringArray*>(col);
+    const int32_t first_offset = str_col->value_offset(0);
+    auto* offsets = reinterpret_cast<int32_t*>(dst);
+    for (int64_t i = 0; i <= num_rows; ++i) {
+      offsets[i] = str_col->value_offset(i) - first_offset;
+    }
+    dst += AlignColumnarBuffer((num_rows + 1) * sizeof(int32_t));
+    size_t data_bytes = str_col->value_offset(num_rows) - first_offset;
+    if (data_bytes > 0) {
+      std::memcpy(dst, str_col->value_data()->data() + first_offset, data_bytes);
+    }
+    return dst + AlignColumnarBuffer(data_bytes);
+  } else if constexpr (T == DataType::BOOLEAN) {
+    const auto* bool_col = static_cast<const arrow::BooleanArray*>(col);
+    for (int64_t i = 0; i < num_rows; ++i) {
+      if (bool_col->Value(i)) {
+        dst[i >> 3] |= static_cast<uint8_t>(1 << (i & 7));
+      }
+    }
+    return dst + AlignColumnarBuffer(BitmapBytes(num_rows));
+  } else {
+    size_t bytes = num_rows * FixedValueBytes<T>();
+    if (bytes > 0) {
+      std::memcpy(dst, col->data()->buffers[1]->data() + col->offset() * FixedValueBytes<T>(),
+                  bytes);
+    }
+    return dst + AlignColumnarBuffer(bytes);
+  }
+}
+
+template <DataType T>
+std::shared_ptr<arrow::DataType> ArrowDataType() {
+  using arrow_type = typename types::DataTypeTraits<T>::arrow_type;
+  if constexpr (arrow::TypeTraits<arrow_type>::is_parameter_free) {
+    return arrow::TypeTraits<arrow_type>::type_singleton();
+  } else {
+    return types::DataTypeTraits<T>::default_value();
+  }
+}
+
+// An arrow::Buffer over memory that is owned by something else, usually the proto that the data
+// was received in.
+class OwnedBuffer : public arrow::Buffer {
+ public:
+  OwnedBuffer(const uint8_t* data, int64_t size, std::shared_ptr<const void> owner)
+      : arrow::Buffer(data, size), owner_(std::move(owner)) {}
+
+ private:
+  std::shared_ptr<const void> owner_;
+};
+
+// Reads the buffers of a column of a ColumnarRowBatchData, and checks that their sizes match the
+// number of rows.
+class ColumnarBufferReader {
+ public:
+  ColumnarBufferReader(const table_store::schemapb::ColumnarRowBatchData& proto,
+                       std::shared_ptr<arrow::Buffer> data)
+      : proto_(proto), data_(std::move(data)) {}
+
+  StatusOr<std::shared_ptr<arrow::Buffer>> Next(int64_t expected_size) {
+    if (buffer_idx_ >= proto_.buffer_sizes_size()) {
+      return error::InvalidArgument("ColumnarRowBatchData has too few buffers");
+    }
+    int64_t size = proto_.buffer_sizes(buffer_idx_++);
+    // Written as a subtraction so that a corrupt size can't overflow the position.
+    if (size < 0 || (expected_size >= 0 && size != expected_size) ||
+        size > data_->size() - pos_) {
+      return error::InvalidArgument("ColumnarRowBatchData buffer $0 has invalid size $1",
+                                    buffer_idx_ - 1, size);
+    }
+    auto buffer = arrow::SliceBuffer(data_, pos_, size);
+    pos_ += AlignColumnarBuffer(size);
+    return buffer;
+  }
+
+ private:
+  const table_store::schemapb::ColumnarRowBatchData& proto_;
+  std::shared_ptr<arrow::Buffer> data_;
+  int buffer_idx_ = 0;
+  int64_t pos_ = 0;
+};
+
+template <DataType T>
+Status ReadColumnarColumn(int64_t num_rows, ColumnarBufferReader* reader,
+                          std::shared_ptr<arrow::Array>* out) {
+  std::vector<std::shared_ptr<arrow::Buffer>> buffers = {nullptr};
+  if constexpr (T == DataType::STRING) {
+    PX_ASSIGN_OR_RETURN(auto offsets_buffer, reader->Next((num_rows + 1) * sizeof(int32_t)));
+    PX_ASSIGN_OR_RETURN(auto data_buffer, reader->Next(-1));
+    // Check the offsets so that a corrupt message can't make us read outside of the data.
+    const auto* offsets = reinterpret_cast<const int32_t*>(offsets_buffer->data());
+    for (int64_t i = 0; i < num_rows; ++i) {
+      if (offsets[i] < 0 || offsets[i] > offsets[i + 1]) {
+        return error::InvalidArgument("ColumnarRowBatchData has invalid string offsets");
+      }
+    }
+    if (offsets[0] != 0 || offsets[num_rows] != data_buffer->size()) {
+      return error::InvalidArgument("ColumnarRowBatchData has invalid string offsets");
+    }
+    buffers.push_back(std::move(offsets_buffer));
+    buffers.push_back(std::move(data_buffer));
+  } else if constexpr (T == DataType::BOOLEAN) {
+    PX_ASSIGN_OR_RETURN(auto bitmap, reader->Next(BitmapBytes(num_rows)));
+    buffers.push_back(std::move(bitmap));
+  } else {
+    PX_ASSIGN_OR_RETURN(auto values, reader->Next(num_rows * FixedValueBytes<T>()));
+    buffers.push_back(std::move(values));
+  }
+  *out = arrow::MakeArray(
+      arrow::ArrayData::Make(ArrowDataType<T>(), num_rows, std::move(buffers), /* null_count */ 0));
+  return Status::OK();
+}
+
+}  // namespace
+
+Status RowBatch::ToColumnarProto(table_store::schemapb::ColumnarRowBatchData* proto) const {
+  if (selection_ != nullptr) {
+    PX_ASSIGN_OR_RETURN(auto compacted_rb, Compact());
+    return compacted_rb->ToColumnarProto(proto);
+  }
+  proto->set_num_rows(num_rows_);
+  proto->set_eow(eow_);
+  proto->set_eos(eos_);
+
+  for (auto col_idx = 0; col_idx < num_columns(); ++col_idx) {
+    auto dt = desc_.type(col_idx);
+    proto->add_column_types(dt);
+#define TYPE_CASE(_dt_) AddColumnarBufferSizes<_dt_>(columns_[col_idx].get(), proto);
+    PX_SWITCH_FOREACH_DATATYPE(dt, TYPE_CASE);
+#undef TYPE_CASE
+  }
+
+  size_t total_bytes = 0;
+  for (int64_t size : proto->buffer_sizes()) {
+    total_bytes += AlignColumnarBuffer(size);
+  }
+  // The padding and the bitmaps are expected to be zeroed.
+  auto* data = proto->mutable_data();
+  data->assign(total_bytes, '\0');
+  auto* dst = reinterpret_cast<uint8_t*>(data->data());
+  for (auto col_idx = 0; col_idx < num_columns(); ++col_idx) {
+#define TYPE_CASE(_dt_) dst = WriteColumnarBuffers<_dt_>(columns_[col_idx].get(), dst);
+    PX_SWITCH_FOREACH_DATATYPE(desc_.type(col_idx), TYPE_CASE);
+#undef TYPE_CASE
+  }
+  return Status::OK();
+}
+
+StatusOr<std::unique_ptr<RowBatch>> RowBatch::FromColumnarProto(
+    const table_store::schemapb::ColumnarRowBatchData& proto, std::shared_ptr<const void> owner) {
+  // Every column takes at least one bit per row, so this bounds the number of rows before it is
+  // multiplied into the expected buffer sizes.
+  if (proto.num_rows() < 0 ||
+      (proto.column_types_size() > 0 &&
+       static_cast<uint64_t>(proto.num_rows()) > proto.data().size() * 8)) {
+    return error::InvalidArgument("ColumnarRowBatchData has $0 rows", proto.num_rows());
+  }
+  const std::string* data = &proto.data();
+  if (owner == nullptr) {
+    auto data_copy = std::make_shared<const std::string>(proto.data());
+    data = data_copy.get();
+    owner = std::move(data_copy);
+  }
+  auto data_buffer = std::make_shared<OwnedBuffer>(reinterpret_cast<const uint8_t*>(data->data()),
+                                                   data->size(), std::move(owner));
+  ColumnarBufferReader reader(proto, std::move(data_buffer));
+
+  std::vector<DataType> types;
+  std::vector<std::shared_ptr<arrow::Array>> columns(proto.column_types_size());
+  for (const auto& [i, type] : Enumerate(proto.column_types())) {
+    // PX_CARNOT_UPDATE_FOR_NEW_TYPES.
+    if (type != DataType::BOOLEAN && type != DataType::INT64 && type != DataType::UINT128 &&
+        type != DataType::TIME64NS && type != DataType::FLOAT64 && type != DataType::STRING) {
+      return error::InvalidArgument("ColumnarRowBatchData has invalid column type $0", type);
+    }
+    types.push_back(static_cast<DataType>(type));
+#define TYPE_CASE(_dt_) \
+  PX_RETURN_IF_ERROR(ReadColumnarColumn<_dt_>(proto.num_rows(), &reader, &columns[i]));
+    PX_SWITCH_FOREACH_DATATYPE(types.back(), TYPE_CASE);
+#undef TYPE_CASE
+  }
+
+  auto output_rb = std::make_unique<RowBatch>(RowDescriptor(types), proto.num_rows());
+  output_rb->set_eow(proto.eow());
+  output_rb->set_eos(proto.eos());
+  for (const auto& col : columns) {
+    PX_RETURN_IF_ERROR(output_rb->AddColumn(col));
+  }
+  return output_rb;
+}
+
 StatusOr<std::unique_ptr<RowBatch>> RowBatch::FromColumnBuilders(
     const RowDescriptor& desc, bool eow, bool eos,
     std::vector<std::unique_ptr<arrow::ArrayBuilder>>* builders) {
@@ -257,6 +551,14 @@ StatusOr<std::unique_ptr<RowBatch>> RowBatch::Slice(int64_t offset, int64_t leng
     return error::InvalidArgument("Slice(offset=$0, length=$1) on rowbatch of length $2 is invalid",
                                   offset, length, num_rows());
   }
+  if (selection_ != nullptr) {
+    auto output_rb = std::make_unique<RowBatch>(*this);
+    output_rb->set_eow(false);
+    output_rb->set_eos(false);
+    PX_RETURN_IF_ERROR(output_rb->SetSelection(std::make_shared<const std::vector<int64_t>>(
+        selection_->begin() + offset, selection_->begin() + offset + length)));
+    return output_rb;
+  }
   std::unique_ptr<RowBatch> output_rb = std::make_unique<RowBatch>(desc(), length);
   for (int64_t input_col_idx = 0; input_col_idx < num_columns(); ++input_col_idx) {
     auto col = ColumnAt(input_col_idx);
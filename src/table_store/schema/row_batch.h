@@ -19,6 +19,7 @@
 #pragma once
 
 #include <arrow/array.h>
+#include <arrow/memory_pool.h>
 #include <arrow/type.h>
 #include <map>
 #include <memory>
@@ -36,6 +37,11 @@ namespace schema {
 /**
  * A RowBatch is a table-like structure which consists of equal-length arrays
  * that match the schema described by the RowDescriptor.
+ *
+ * A RowBatch can optionally carry a selection vector: the sorted indices of the rows of the
+ * columns that are part of the batch. Filters use it to drop rows without copying the columns, so
+ * that chained filters only intersect their selections. Nodes that don't understand selections
+ * get a compacted copy of the batch (see Compact()).
  */
 class RowBatch {
  public:
@@ -53,6 +59,21 @@ class RowBatch {
   static StatusOr<std::unique_ptr<RowBatch>> FromProto(
       const table_store::schemapb::RowBatchData& row_batch_proto);
 
+  /**
+   * Serializes the row batch as the Arrow buffers of its columns. This only copies each column
+   * once, instead of adding its values one by one to a repeated field like ToProto.
+   */
+  Status ToColumnarProto(table_store::schemapb::ColumnarRowBatchData* row_batch_proto) const;
+
+  /**
+   * Creates a row batch from a ColumnarRowBatchData. The columns point into the data of the proto
+   * without copying it, and keep owner alive, which must own the proto. If owner is null, the data
+   * is copied instead.
+   */
+  static StatusOr<std::unique_ptr<RowBatch>> FromColumnarProto(
+      const table_store::schemapb::ColumnarRowBatchData& row_batch_proto,
+      std::shared_ptr<const void> owner);
+
   static StatusOr<std::unique_ptr<RowBatch>> FromColumnBuilders(
       const RowDescriptor& desc, bool eow, bool eos,
       std::vector<std::unique_ptr<arrow::ArrayBuilder>>* builders);
@@ -67,7 +88,8 @@ class RowBatch {
    * @brief Returns a slice of the specified `length` starting at the `offset` from the RowBatch.
    *
    * RowBatch Slice has the same columns as this rowbatch, just of length `length` and starting at
-   * `offset`. Does not set eow and eos.
+   * `offset`. Does not set eow and eos. If the row batch has a selection vector, the selection is
+   * sliced instead and the columns are shared.
    *
    *
    * @param offset The starting position of the slice.
@@ -82,6 +104,33 @@ class RowBatch {
    */
   Status AddColumn(const std::shared_ptr<arrow::Array>& col);
 
+  /**
+   * Sets the selection vector of the row batch. The indices must be sorted and refer to rows of the
+   * columns, ie. be less than num_column_rows().
+   * @param selection the rows of the columns that are part of the row batch.
+   */
+  Status SetSelection(std::shared_ptr<const std::vector<int64_t>> selection);
+
+  /**
+   * @ return whether the row batch has a selection vector.
+   */
+  bool has_selection() const { return selection_ != nullptr; }
+
+  /**
+   * @ return the selection vector of the row batch, nullptr if all the rows are selected.
+   */
+  const std::shared_ptr<const std::vector<int64_t>>& selection() const { return selection_; }
+
+  /**
+   * Materializes the selected rows into a new row batch without a selection vector. Columns are
+   * shared with this row batch when there is no selection. Keeps eow and eos.
+   *
+   * @param mem_pool the memory pool to allocate the compacted columns in.
+   * @return StatusOr<std::unique_ptr<RowBatch>>
+   */
+  StatusOr<std::unique_ptr<RowBatch>> Compact(
+      arrow::MemoryPool* mem_pool = arrow::default_memory_pool()) const;
+
   /**
    * @ param i the index of the column to be accessed.
    * @ returns the Arrow array for the column at the given index.
@@ -95,9 +144,17 @@ class RowBatch {
   bool HasColumn(int64_t i) const;
 
   /**
-   * @ return the number of rows that each row batch should contain.
+   * @ return the number of rows in the row batch, which is the number of selected rows if the row
+   * batch has a selection vector.
+   */
+  int64_t num_rows() const {
+    return selection_ == nullptr ? num_rows_ : static_cast<int64_t>(selection_->size());
+  }
+
+  /**
+   * @ return the length of the columns of the row batch.
    */
-  int64_t num_rows() const { return num_rows_; }
+  int64_t num_column_rows() const { return num_rows_; }
 
   /**
    * @ return the number of columns which the row batch should contain.
@@ -126,6 +183,7 @@ class RowBatch {
   bool eow_ = false;
   bool eos_ = false;
   std::vector<std::shared_ptr<arrow::Array>> columns_;
+  std::shared_ptr<const std::vector<int64_t>> selection_;
 };
 
 // Append a scalar value to an arrow::Array.
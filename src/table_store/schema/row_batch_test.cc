@@ -19,6 +19,7 @@
 #include <arrow/array.h>
 #include <google/protobuf/text_format.h>
 #include <google/protobuf/util/message_differencer.h>
+#include <limits>
 #include <vector>
 
 #include "src/common/testing/testing.h"
@@ -179,6 +180,100 @@ TEST_F(RowBatchTest, to_from_proto) {
   EXPECT_TRUE(differ.Compare(input_proto, output_proto));
 }
 
+TEST_F(RowBatchTest, to_from_columnar_proto) {
+  table_store::schemapb::RowBatchData input_proto;
+  ASSERT_TRUE(google::protobuf::TextFormat::MergeFromString(kTestRowBatchProto, &input_proto));
+  auto rb = RowBatch::FromProto(input_proto).ConsumeValueOrDie();
+
+  auto columnar_proto = std::make_shared<table_store::schemapb::ColumnarRowBatchData>();
+  EXPECT_OK(rb->ToColumnarProto(columnar_proto.get()));
+  EXPECT_EQ(3, columnar_proto->num_rows());
+  EXPECT_TRUE(columnar_proto->eow());
+  EXPECT_FALSE(columnar_proto->eos());
+
+  google::protobuf::util::MessageDifferencer differ;
+  ASSERT_OK_AND_ASSIGN(auto zero_copy_rb,
+                       RowBatch::FromColumnarProto(*columnar_proto, columnar_proto));
+  ASSERT_OK_AND_ASSIGN(auto copied_rb, RowBatch::FromColumnarProto(*columnar_proto, nullptr));
+  // The zero copy columns point into the proto, and keep it alive.
+  const auto* data = reinterpret_cast<const uint8_t*>(columnar_proto->data().data());
+  EXPECT_EQ(data, zero_copy_rb->ColumnAt(0)->data()->buffers[1]->data());
+  columnar_proto.reset();
+
+  for (const auto& output_rb : {zero_copy_rb.get(), copied_rb.get()}) {
+    EXPECT_EQ(rb->desc(), output_rb->desc());
+    EXPECT_TRUE(output_rb->eow());
+    EXPECT_FALSE(output_rb->eos());
+    table_store::schemapb::RowBatchData output_proto;
+    EXPECT_OK(output_rb->ToProto(&output_proto));
+    EXPECT_TRUE(differ.Compare(input_proto, output_proto));
+  }
+}
+
+TEST_F(RowBatchTest, columnar_proto_slice) {
+  table_store::schemapb::RowBatchData input_proto;
+  ASSERT_TRUE(google::protobuf::TextFormat::MergeFromString(kTestRowBatchProto, &input_proto));
+  auto string_rb = RowBatch::FromProto(input_proto).ConsumeValueOrDie();
+
+  // Sliced columns, including booleans that don't start on a byte boundary, are written from
+  // their offset.
+  for (const auto& rb : {rb_.get(), string_rb.get()}) {
+    ASSERT_OK_AND_ASSIGN(auto sliced_rb, rb->Slice(1, 2));
+    table_store::schemapb::ColumnarRowBatchData columnar_proto;
+    EXPECT_OK(sliced_rb->ToColumnarProto(&columnar_proto));
+    ASSERT_OK_AND_ASSIGN(auto output_rb, RowBatch::FromColumnarProto(columnar_proto, nullptr));
+    EXPECT_EQ(sliced_rb->DebugString(), output_rb->DebugString());
+  }
+
+  // Selections are compacted.
+  EXPECT_OK(rb_->SetSelection(std::make_shared<const std::vector<int64_t>>(
+      std::vector<int64_t>{0, 2})));
+  ASSERT_OK_AND_ASSIGN(auto compacted_rb, rb_->Compact());
+  table_store::schemapb::ColumnarRowBatchData columnar_proto;
+  EXPECT_OK(rb_->ToColumnarProto(&columnar_proto));
+  ASSERT_OK_AND_ASSIGN(auto output_rb, RowBatch::FromColumnarProto(columnar_proto, nullptr));
+  EXPECT_EQ(compacted_rb->DebugString(), output_rb->DebugString());
+}
+
+TEST_F(RowBatchTest, invalid_columnar_proto) {
+  table_store::schemapb::RowBatchData input_proto;
+  ASSERT_TRUE(google::protobuf::TextFormat::MergeFromString(kTestRowBatchProto, &input_proto));
+  auto rb = RowBatch::FromProto(input_proto).ConsumeValueOrDie();
+  table_store::schemapb::ColumnarRowBatchData columnar_proto;
+  EXPECT_OK(rb->ToColumnarProto(&columnar_proto));
+
+  auto too_many_rows = columnar_proto;
+  too_many_rows.set_num_rows(4);
+  EXPECT_NOT_OK(RowBatch::FromColumnarProto(too_many_rows, nullptr));
+
+  // 16 * num_rows wraps around to the size of the uint128 buffer.
+  auto overflowing_rows = columnar_proto;
+  overflowing_rows.set_num_rows((int64_t{1} << 60) + 3);
+  EXPECT_NOT_OK(RowBatch::FromColumnarProto(overflowing_rows, nullptr));
+
+  // The string data is the only buffer whose size isn't implied by the number of rows.
+  auto overflowing_size = columnar_proto;
+  overflowing_size.set_buffer_sizes(3, std::numeric_limits<int64_t>::max());
+  EXPECT_NOT_OK(RowBatch::FromColumnarProto(overflowing_size, nullptr));
+
+  auto truncated_data = columnar_proto;
+  truncated_data.mutable_data()->resize(columnar_proto.data().size() - 8);
+  EXPECT_NOT_OK(RowBatch::FromColumnarProto(truncated_data, nullptr));
+
+  auto missing_buffer = columnar_proto;
+  missing_buffer.mutable_buffer_sizes()->RemoveLast();
+  EXPECT_NOT_OK(RowBatch::FromColumnarProto(missing_buffer, nullptr));
+
+  auto invalid_type = columnar_proto;
+  invalid_type.set_column_types(0, static_cast<types::DataType>(1000));
+  EXPECT_NOT_OK(RowBatch::FromColumnarProto(invalid_type, nullptr));
+
+  // The string offsets come after the uint128 (48 bytes) and int64 (24 bytes) columns.
+  auto invalid_offsets = columnar_proto;
+  reinterpret_cast<int32_t*>(invalid_offsets.mutable_data()->data() + 72)[1] = 100;
+  EXPECT_NOT_OK(RowBatch::FromColumnarProto(invalid_offsets, nullptr));
+}
+
 TEST_F(RowBatchTest, with_zero_rows) {
   bool eow = true;
   bool eos = false;
@@ -231,6 +326,50 @@ TEST_F(RowBatchTest, slice) {
   ASSERT_EQ(status2.msg(), "Slice(offset=-1, length=3) on rowbatch of length 3 is invalid");
 }
 
+TEST_F(RowBatchTest, selection) {
+  EXPECT_FALSE(rb_->has_selection());
+  EXPECT_OK(rb_->SetSelection(std::make_shared<const std::vector<int64_t>>(
+      std::vector<int64_t>{0, 2})));
+  EXPECT_TRUE(rb_->has_selection());
+  EXPECT_EQ(2, rb_->num_rows());
+  EXPECT_EQ(3, rb_->num_column_rows());
+  rb_->set_eow(true);
+
+  ASSERT_OK_AND_ASSIGN(auto compacted_rb, rb_->Compact());
+  EXPECT_FALSE(compacted_rb->has_selection());
+  EXPECT_EQ(2, compacted_rb->num_rows());
+  EXPECT_EQ(2, compacted_rb->num_column_rows());
+  EXPECT_TRUE(compacted_rb->eow());
+  EXPECT_FALSE(compacted_rb->eos());
+  EXPECT_EQ(
+      "RowBatch(eow=1, eos=0):\n  [\n  true,\n  true\n]\n  [\n  3,\n  5\n]\n  [\n  "
+      "3.3,\n  5.6\n]\n",
+      compacted_rb->DebugString());
+
+  // Slicing a selection shares the columns.
+  ASSERT_OK_AND_ASSIGN(auto sliced_rb, rb_->Slice(1, 1));
+  EXPECT_EQ(1, sliced_rb->num_rows());
+  EXPECT_EQ(rb_->ColumnAt(1), sliced_rb->ColumnAt(1));
+  ASSERT_OK_AND_ASSIGN(auto compacted_slice_rb, sliced_rb->Compact());
+  EXPECT_EQ("RowBatch(eow=0, eos=0):\n  [\n  true\n]\n  [\n  5\n]\n  [\n  5.6\n]\n",
+            compacted_slice_rb->DebugString());
+
+  table_store::schemapb::RowBatchData selected_proto;
+  EXPECT_OK(rb_->ToProto(&selected_proto));
+  table_store::schemapb::RowBatchData compacted_proto;
+  EXPECT_OK(compacted_rb->ToProto(&compacted_proto));
+  google::protobuf::util::MessageDifferencer differ;
+  EXPECT_TRUE(differ.Compare(compacted_proto, selected_proto));
+}
+
+TEST_F(RowBatchTest, invalid_selection) {
+  EXPECT_NOT_OK(rb_->SetSelection(std::make_shared<const std::vector<int64_t>>(
+      std::vector<int64_t>{0, 3})));
+  EXPECT_NOT_OK(rb_->SetSelection(std::make_shared<const std::vector<int64_t>>(
+      std::vector<int64_t>{2, 1})));
+  EXPECT_FALSE(rb_->has_selection());
+}
+
 }  // namespace schema
 }  // namespace table_store
 }  // namespace px
@@ -15,17 +15,24 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <utility>
 #include <vector>
 
 #include "src/table_store/table/internal/arrow_array_compactor.h"
+#include "src/table_store/table/internal/dictionary_encoding.h"
 #include "src/table_store/table/internal/record_or_row_batch.h"
 
+DEFINE_bool(table_store_dictionary_encoding,
+            gflags::BoolFromEnv("PL_TABLE_STORE_DICTIONARY_ENCODING", true),
+            "Whether to dictionary encode low cardinality string columns when compacting hot "
+            "batches into cold batches.");
+
 namespace px {
 namespace table_store {
 namespace internal {
 
 ArrowArrayCompactor::ArrowArrayCompactor(const schema::Relation& rel, arrow::MemoryPool* mem_pool)
-    : rel_(rel) {
+    : rel_(rel), mem_pool_(mem_pool) {
   for (const auto& type : rel_.col_types()) {
     builders_.push_back(types::MakeTypeErasedArrowBuilder(type, mem_pool));
   }
@@ -52,9 +59,16 @@ void ArrowArrayCompactor::UnsafeAppendBatchSlice(const RecordOrRowBatch& batch,
 
 StatusOr<std::vector<ArrowArrayPtr>> ArrowArrayCompactor::Finish() {
   std::vector<ArrowArrayPtr> out_columns;
+  last_batch_bytes_saved_ = 0;
   for (const auto& [col_idx, builder] : Enumerate(builders_)) {
     out_columns.emplace_back();
     PX_RETURN_IF_ERROR(builder->Finish(&out_columns.back()));
+    if (FLAGS_table_store_dictionary_encoding &&
+        rel_.col_types()[col_idx] == types::DataType::STRING) {
+      PX_ASSIGN_OR_RETURN(auto encoded, MaybeDictionaryEncode(out_columns.back(), mem_pool_));
+      out_columns.back() = std::move(encoded.array);
+      last_batch_bytes_saved_ += encoded.bytes_saved;
+    }
   }
   return out_columns;
 }
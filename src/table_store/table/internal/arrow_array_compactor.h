@@ -22,10 +22,13 @@
 #include <utility>
 #include <vector>
 
+#include "src/common/base/base.h"
 #include "src/table_store/schema/relation.h"
 #include "src/table_store/table/internal/record_or_row_batch.h"
 #include "src/table_store/table/internal/types.h"
 
+DECLARE_bool(table_store_dictionary_encoding);
+
 namespace px {
 namespace table_store {
 namespace internal {
@@ -42,6 +45,9 @@ namespace internal {
  *    compactor.UnsafeAppendBatchSlice(record_or_row_batch, 0, NumRows(record_or_row_batch));
  *  }
  *  auto output_arrow_arrays = compactor.Finish();
+ *
+ * String columns with few distinct values are dictionary encoded by Finish (see
+ * dictionary_encoding.h), unless --table_store_dictionary_encoding is false.
  */
 class ArrowArrayCompactor {
  public:
@@ -74,10 +80,17 @@ class ArrowArrayCompactor {
    * @return compacted arrow::Array's per column in the batch.
    */
   StatusOr<std::vector<ArrowArrayPtr>> Finish();
+  /**
+   * @return the number of bytes that dictionary encoding saved on the batch returned by the last
+   * call to Finish.
+   */
+  uint64_t LastBatchBytesSaved() const { return last_batch_bytes_saved_; }
 
  private:
   const schema::Relation& rel_;
+  arrow::MemoryPool* mem_pool_;
   std::vector<std::unique_ptr<types::TypeErasedArrowBuilder>> builders_;
+  uint64_t last_batch_bytes_saved_ = 0;
 };
 
 }  // namespace internal
@@ -16,6 +16,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <memory>
+#include <algorithm>
 #include <numeric>
 #include <utility>
 
@@ -154,7 +155,8 @@ void BatchSizeAccountant::ExpireHotBatch() {
 }
 
 void BatchSizeAccountant::ExpireColdBatch() {
-  cold_bytes_ -= cold_batch_bytes_.front();
+  cold_bytes_ -= cold_batch_bytes_.front().bytes;
+  cold_uncompressed_bytes_ -= cold_batch_bytes_.front().uncompressed_bytes;
   cold_batch_bytes_.pop_front();
 }
 
@@ -169,14 +171,17 @@ const BatchSizeAccountant::CompactedBatchSpec& BatchSizeAccountant::GetNextCompa
   return compacted_batch_specs_.front();
 }
 
-uint64_t BatchSizeAccountant::FinishCompactedBatch() {
+uint64_t BatchSizeAccountant::FinishCompactedBatch(uint64_t encoding_bytes_saved) {
   DCHECK(CompactedBatchReady());
   auto spec = std::move(compacted_batch_specs_.front());
   compacted_batch_specs_.pop_front();
 
+  DCHECK_LE(encoding_bytes_saved, spec.bytes);
+  auto cold_batch_bytes = spec.bytes - std::min(encoding_bytes_saved, spec.bytes);
   hot_bytes_ -= spec.bytes;
-  cold_bytes_ += spec.bytes;
-  cold_batch_bytes_.push_back(spec.bytes);
+  cold_bytes_ += cold_batch_bytes;
+  cold_uncompressed_bytes_ += spec.bytes;
+  cold_batch_bytes_.push_back(ColdBatchBytes{cold_batch_bytes, spec.bytes});
 
   if (spec.hot_slices.back().last_slice_for_batch) {
     // If the last slice in the compacted batch was the last slice for the corresponding hot batch,
@@ -216,6 +221,8 @@ uint64_t BatchSizeAccountant::HotBytes() const { return hot_bytes_; }
 
 uint64_t BatchSizeAccountant::ColdBytes() const { return cold_bytes_; }
 
+uint64_t BatchSizeAccountant::ColdUncompressedBytes() const { return cold_uncompressed_bytes_; }
+
 const BatchSizeAccountantNonMutableState& BatchSizeAccountant::NonMutableState() const {
   return non_mutable_state_;
 }
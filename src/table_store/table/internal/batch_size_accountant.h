@@ -130,10 +130,12 @@ class BatchSizeAccountant {
    * update hot_bytes_ and cold_bytes_ accordingly. It returns the number of rows that need to be
    * removed from start of the first hot batch in order to prevent duplicated data between the hot
    * and cold stores.
+   * @param encoding_bytes_saved the number of bytes the compacted batch saved by encoding its
+   * columns (see ArrowArrayCompactor::LastBatchBytesSaved), which aren't counted as cold bytes.
    * @return Number of rows to remove from the front of the hot store, since those rows were moved
    * into the cold store via CompactedBatchSpec.
    */
-  uint64_t FinishCompactedBatch();
+  uint64_t FinishCompactedBatch(uint64_t encoding_bytes_saved = 0);
   /**
    * @return the number of bytes stored in the hot store.
    */
@@ -142,6 +144,10 @@ class BatchSizeAccountant {
    * @return the number of bytes stored in the cold store.
    */
   uint64_t ColdBytes() const;
+  /**
+   * @return the number of bytes the cold store would use if none of its batches were encoded.
+   */
+  uint64_t ColdUncompressedBytes() const;
 
   const BatchSizeAccountantNonMutableState& NonMutableState() const;
 
@@ -149,9 +155,14 @@ class BatchSizeAccountant {
   const BatchSizeAccountantNonMutableState non_mutable_state_;
 
   std::deque<CompactedBatchSpec> compacted_batch_specs_;
-  std::deque<uint64_t> cold_batch_bytes_;
+  struct ColdBatchBytes {
+    uint64_t bytes;
+    uint64_t uncompressed_bytes;
+  };
+  std::deque<ColdBatchBytes> cold_batch_bytes_;
   uint64_t hot_bytes_ = 0;
   uint64_t cold_bytes_ = 0;
+  uint64_t cold_uncompressed_bytes_ = 0;
 
   static BatchSizeAccountantNonMutableState CreateNonMutableState(const schema::Relation& rel,
                                                                   size_t compacted_size);
@@ -0,0 +1,264 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/table_store/table/internal/bit_packing.h"
+
+#include <absl/numeric/int128.h>
+#include <arrow/builder.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/type_utils.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+namespace {
+
+constexpr uint64_t kSignBit = uint64_t{1} << 63;
+
+uint8_t BitWidth(uint64_t max_value) {
+  return max_value == 0 ? 0 : 64 - __builtin_clzll(max_value);
+}
+
+uint64_t WidthMask(uint8_t bit_width) {
+  return bit_width == 64 ? std::numeric_limits<uint64_t>::max()
+                         : (uint64_t{1} << bit_width) - 1;
+}
+
+}  // namespace
+
+PackedUInt64s PackedUInt64s::Pack(const uint64_t* values, int64_t num_values, bool is_signed) {
+  PackedUInt64s packed;
+  packed.size_ = num_values;
+  // Flipping the sign bit maps the order of signed values onto the order of unsigned ones.
+  const uint64_t order_flip = is_signed ? kSignBit : 0;
+  std::array<uint64_t, kBlockSize> slots;
+
+  for (int64_t start = 0; start < num_values; start += kBlockSize) {
+    const uint64_t* block = values + start;
+    const int64_t block_size = std::min(kBlockSize, num_values - start);
+
+    uint64_t min_key = block[0] ^ order_flip;
+    uint64_t max_key = min_key;
+    uint64_t min_delta = std::numeric_limits<uint64_t>::max();
+    for (int64_t i = 1; i < block_size; ++i) {
+      uint64_t key = block[i] ^ order_flip;
+      min_key = std::min(min_key, key);
+      max_key = std::max(max_key, key);
+      min_delta = std::min(min_delta, block[i] - block[i - 1]);
+    }
+    uint8_t for_width = BitWidth(max_key - min_key);
+    // The offsets from the line through the first value with a slope of min_delta. They are the
+    // running sums of how far each delta exceeds min_delta.
+    uint64_t max_offset = 0;
+    for (int64_t i = 1; i < block_size; ++i) {
+      max_offset = std::max(max_offset, block[i] - block[0] - i * min_delta);
+    }
+    uint8_t delta_width = block_size > 1 ? BitWidth(max_offset) : 64;
+
+    BlockHeader header;
+    header.first_word = static_cast<uint32_t>(packed.words_.size());
+    if (delta_width < for_width) {
+      header.encoding = BlockEncoding::kDelta;
+      header.reference = block[0];
+      header.min_delta = min_delta;
+      header.bit_width = delta_width;
+      for (int64_t i = 0; i < block_size; ++i) {
+        slots[i] = block[i] - block[0] - i * min_delta;
+      }
+    } else {
+      header.encoding = BlockEncoding::kFrameOfReference;
+      header.reference = min_key ^ order_flip;
+      header.min_delta = 0;
+      header.bit_width = for_width;
+      for (int64_t i = 0; i < block_size; ++i) {
+        slots[i] = block[i] - header.reference;
+      }
+    }
+
+    // kBlockSize slots of bit_width bits take exactly 2 * bit_width words.
+    const uint8_t width = header.bit_width;
+    packed.words_.resize(header.first_word + 2 * width, 0);
+    uint64_t* words = packed.words_.data() + header.first_word;
+    for (int64_t i = 0; width > 0 && i < block_size; ++i) {
+      uint64_t bit_pos = i * width;
+      uint64_t word = bit_pos / 64;
+      uint64_t shift = bit_pos % 64;
+      words[word] |= slots[i] << shift;
+      if (shift + width > 64) {
+        words[word + 1] |= slots[i] >> (64 - shift);
+      }
+    }
+    packed.headers_.push_back(header);
+  }
+  // Padding, so that reading a slot can always load the word after the one it starts in.
+  packed.words_.push_back(0);
+  return packed;
+}
+
+int64_t PackedUInt64s::Bytes() const {
+  return headers_.size() * sizeof(BlockHeader) + words_.size() * sizeof(uint64_t);
+}
+
+uint64_t PackedUInt64s::Slot(const BlockHeader& header, int64_t slot) const {
+  uint64_t bit_pos = slot * header.bit_width;
+  uint64_t word = header.first_word + bit_pos / 64;
+  absl::uint128 two_words = absl::MakeUint128(words_[word + 1], words_[word]);
+  return absl::Uint128Low64(two_words >> (bit_pos % 64)) & WidthMask(header.bit_width);
+}
+
+uint64_t PackedUInt64s::Get(int64_t idx) const {
+  DCHECK_LT(idx, size_);
+  const auto& header = headers_[idx / kBlockSize];
+  const int64_t slot = idx % kBlockSize;
+  const uint64_t base = header.reference + slot * header.min_delta;
+  return header.bit_width == 0 ? base : base + Slot(header, slot);
+}
+
+void PackedUInt64s::UnpackBlock(int64_t block_idx, int64_t first_slot, int64_t num_slots,
+                                uint64_t* out) const {
+  const auto& header = headers_[block_idx];
+  if (header.bit_width == 0) {
+    std::fill(out, out + num_slots, 0);
+  } else {
+    for (int64_t i = 0; i < num_slots; ++i) {
+      out[i] = Slot(header, first_slot + i);
+    }
+  }
+  // min_delta is zero for frame of reference blocks.
+  for (int64_t i = 0; i < num_slots; ++i) {
+    out[i] += header.reference + (first_slot + i) * header.min_delta;
+  }
+}
+
+void PackedUInt64s::Unpack(int64_t offset, int64_t num_values, uint64_t* out) const {
+  DCHECK_LE(offset + num_values, size_);
+  const int64_t end = offset + num_values;
+  for (int64_t idx = offset; idx < end;) {
+    const int64_t slot = idx % kBlockSize;
+    const int64_t count = std::min(end - idx, kBlockSize - slot);
+    UnpackBlock(idx / kBlockSize, slot, count, out);
+    out += count;
+    idx += count;
+  }
+}
+
+namespace {
+
+template <types::DataType DT>
+StatusOr<std::shared_ptr<arrow::Array>> BuildInt64Array(const std::vector<uint64_t>& values,
+                                                         arrow::MemoryPool* mem_pool) {
+  auto builder = types::MakeArrowBuilder(DT, mem_pool);
+  auto typed_builder =
+      static_cast<typename types::DataTypeTraits<DT>::arrow_builder_type*>(builder.get());
+  PX_RETURN_IF_ERROR(typed_builder->AppendValues(reinterpret_cast<const int64_t*>(values.data()),
+                                                 values.size()));
+  std::shared_ptr<arrow::Array> out;
+  PX_RETURN_IF_ERROR(typed_builder->Finish(&out));
+  return out;
+}
+
+template <types::DataType DT>
+PackedUInt64s PackInt64Array(const arrow::Array* arr) {
+  auto typed_arr = static_cast<const typename types::DataTypeTraits<DT>::arrow_array_type*>(arr);
+  return PackedUInt64s::Pack(reinterpret_cast<const uint64_t*>(typed_arr->raw_values()),
+                             arr->length(), /*is_signed*/ true);
+}
+
+}  // namespace
+
+std::unique_ptr<BitPackedColumn> BitPackedColumn::Pack(types::DataType data_type,
+                                                       const arrow::Array* arr) {
+  // The block headers and the column itself don't pay off for columns shorter than a block.
+  if (arr->length() < PackedUInt64s::kBlockSize || arr->null_count() > 0) {
+    return nullptr;
+  }
+  std::unique_ptr<BitPackedColumn> column;
+  switch (data_type) {
+    case types::DataType::INT64:
+      column.reset(new BitPackedColumn(data_type, PackInt64Array<types::DataType::INT64>(arr),
+                                       PackedUInt64s()));
+      break;
+    case types::DataType::TIME64NS:
+      column.reset(new BitPackedColumn(data_type, PackInt64Array<types::DataType::TIME64NS>(arr),
+                                       PackedUInt64s()));
+      break;
+    case types::DataType::UINT128: {
+      std::vector<uint64_t> high(arr->length());
+      std::vector<uint64_t> low(arr->length());
+      for (int64_t i = 0; i < arr->length(); ++i) {
+        auto val = types::GetValueFromArrowArray<types::DataType::UINT128>(arr, i);
+        high[i] = absl::Uint128High64(val);
+        low[i] = absl::Uint128Low64(val);
+      }
+      column.reset(new BitPackedColumn(
+          data_type, PackedUInt64s::Pack(high.data(), high.size(), /*is_signed*/ false),
+          PackedUInt64s::Pack(low.data(), low.size(), /*is_signed*/ false)));
+      break;
+    }
+    default:
+      return nullptr;
+  }
+  if (column->Bytes() >= column->PlainBytes()) {
+    return nullptr;
+  }
+  return column;
+}
+
+int64_t BitPackedColumn::Bytes() const { return values_.Bytes() + low_values_.Bytes(); }
+
+int64_t BitPackedColumn::PlainBytes() const {
+  return length() * (data_type_ == types::DataType::UINT128 ? sizeof(absl::uint128)
+                                                            : sizeof(int64_t));
+}
+
+StatusOr<std::shared_ptr<arrow::Array>> BitPackedColumn::Unpack(int64_t offset, int64_t num_rows,
+                                                                arrow::MemoryPool* mem_pool) const {
+  std::vector<uint64_t> values(num_rows);
+  values_.Unpack(offset, num_rows, values.data());
+  switch (data_type_) {
+    case types::DataType::INT64:
+      return BuildInt64Array<types::DataType::INT64>(values, mem_pool);
+    case types::DataType::TIME64NS:
+      return BuildInt64Array<types::DataType::TIME64NS>(values, mem_pool);
+    case types::DataType::UINT128: {
+      std::vector<uint64_t> low(num_rows);
+      low_values_.Unpack(offset, num_rows, low.data());
+      arrow::UInt128Builder builder(mem_pool);
+      PX_RETURN_IF_ERROR(builder.Reserve(num_rows));
+      for (int64_t i = 0; i < num_rows; ++i) {
+        builder.UnsafeAppend(absl::MakeUint128(values[i], low[i]));
+      }
+      std::shared_ptr<arrow::Array> out;
+      PX_RETURN_IF_ERROR(builder.Finish(&out));
+      return out;
+    }
+    default:
+      return error::Internal("Unexpected bit-packed column type: $0",
+                             types::ToString(data_type_));
+  }
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
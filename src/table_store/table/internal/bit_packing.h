@@ -0,0 +1,135 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <arrow/array.h>
+#include <arrow/memory_pool.h>
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "src/common/base/base.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+/**
+ * PackedUInt64s stores a sequence of 64-bit values in blocks of kBlockSize values. Each block is
+ * encoded in one of two ways, whichever needs fewer bits per value:
+ *  - Frame of reference: the offset of each value from the minimum of the block.
+ *  - Delta: the offset of each value from the line that starts at the first value of the block
+ *    and grows by the smallest difference between consecutive values. Monotonic columns such as
+ *    timestamps only pay for the jitter of their deltas.
+ * The offsets are bit-packed with the smallest width that fits the largest of them. Every slot
+ * is decoded on its own from its block header, so random access is O(1). Every block takes a
+ * whole number of 64-bit words, so blocks are unpacked independently with a branch-free loop over
+ * fixed width slots that the compiler can vectorize.
+ *
+ * Values are unsigned, signed values are stored as their two's complement bits. `is_signed`
+ * only controls the order used to find the minimum of a block.
+ */
+class PackedUInt64s {
+ public:
+  static constexpr int64_t kBlockSize = 128;
+
+  static PackedUInt64s Pack(const uint64_t* values, int64_t num_values, bool is_signed);
+
+  int64_t size() const { return size_; }
+  int64_t Bytes() const;
+
+  // Returns the value at idx.
+  uint64_t Get(int64_t idx) const;
+  // Unpacks the values [offset, offset + num_values) into out.
+  void Unpack(int64_t offset, int64_t num_values, uint64_t* out) const;
+
+ private:
+  enum class BlockEncoding : uint8_t {
+    kFrameOfReference,
+    kDelta,
+  };
+  struct BlockHeader {
+    // The minimum value of a frame of reference block, or the first value of a delta block.
+    uint64_t reference;
+    // The smallest difference between consecutive values of a delta block, zero for a frame of
+    // reference block.
+    uint64_t min_delta;
+    // Index in words_ of the first word of the block.
+    uint32_t first_word;
+    uint8_t bit_width;
+    BlockEncoding encoding;
+  };
+
+  uint64_t Slot(const BlockHeader& header, int64_t slot) const;
+  // Unpacks the slots [first_slot, first_slot + num_slots) of block_idx into out.
+  void UnpackBlock(int64_t block_idx, int64_t first_slot, int64_t num_slots, uint64_t* out) const;
+
+  int64_t size_ = 0;
+  std::vector<BlockHeader> headers_;
+  std::vector<uint64_t> words_;
+};
+
+/**
+ * BitPackedColumn is the packed form of an INT64, TIME64NS or UINT128 cold column without nulls.
+ * UINT128 columns pack their high and low halves separately, since the high half of a UPID rarely
+ * changes within a batch.
+ */
+class BitPackedColumn {
+ public:
+  /**
+   * Packs the column, or returns nullptr if the column can't be packed or if packing it doesn't
+   * save any memory.
+   */
+  static std::unique_ptr<BitPackedColumn> Pack(types::DataType data_type, const arrow::Array* arr);
+
+  types::DataType data_type() const { return data_type_; }
+  int64_t length() const { return values_.size(); }
+  int64_t Bytes() const;
+  // The number of bytes the column takes up as a plain arrow::Array.
+  int64_t PlainBytes() const;
+
+  // Returns the value at idx of an INT64 or TIME64NS column.
+  int64_t GetInt64(int64_t idx) const {
+    DCHECK_NE(data_type_, types::DataType::UINT128);
+    return static_cast<int64_t>(values_.Get(idx));
+  }
+
+  /**
+   * Unpacks the rows [offset, offset + num_rows) into a plain arrow::Array.
+   */
+  StatusOr<std::shared_ptr<arrow::Array>> Unpack(int64_t offset, int64_t num_rows,
+                                                 arrow::MemoryPool* mem_pool) const;
+
+ private:
+  BitPackedColumn(types::DataType data_type, PackedUInt64s values, PackedUInt64s low_values)
+      : data_type_(data_type), values_(std::move(values)), low_values_(std::move(low_values)) {}
+
+  types::DataType data_type_;
+  // The values of INT64 and TIME64NS columns, or the high halves of UINT128 values.
+  PackedUInt64s values_;
+  // The low halves of UINT128 values.
+  PackedUInt64s low_values_;
+};
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arrow/builder.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/table/internal/bit_packing.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+void ExpectRoundTrip(const std::vector<uint64_t>& values, bool is_signed) {
+  auto packed = PackedUInt64s::Pack(values.data(), values.size(), is_signed);
+  ASSERT_EQ(static_cast<int64_t>(values.size()), packed.size());
+
+  std::vector<uint64_t> out(values.size());
+  packed.Unpack(0, values.size(), out.data());
+  EXPECT_EQ(values, out);
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], packed.Get(i));
+  }
+  // Unpack a range that starts and ends in the middle of blocks.
+  if (values.size() > 10) {
+    std::vector<uint64_t> range(values.size() - 10);
+    packed.Unpack(5, range.size(), range.data());
+    EXPECT_EQ(std::vector<uint64_t>(values.begin() + 5, values.end() - 5), range);
+  }
+}
+
+TEST(PackedUInt64sTest, timestamps_use_delta_encoding) {
+  std::vector<uint64_t> values;
+  uint64_t ts = 1634000000000000000;
+  for (int64_t i = 0; i < 1000; ++i) {
+    ts += 1000 + (i * 7919) % 64;
+    values.push_back(ts);
+  }
+  ExpectRoundTrip(values, /*is_signed*/ true);
+
+  // The offsets from the smallest delta fit in 12 bits, frame of reference would need 17 to 18
+  // bits.
+  auto packed = PackedUInt64s::Pack(values.data(), values.size(), /*is_signed*/ true);
+  EXPECT_LT(packed.Bytes(), static_cast<int64_t>(values.size() * sizeof(uint64_t)) / 4);
+}
+
+TEST(PackedUInt64sTest, unordered_values_use_frame_of_reference) {
+  std::vector<uint64_t> values;
+  for (int64_t i = 0; i < 300; ++i) {
+    values.push_back(500 + (i * 7919) % 1000);
+  }
+  ExpectRoundTrip(values, /*is_signed*/ false);
+}
+
+TEST(PackedUInt64sTest, constant_values) {
+  ExpectRoundTrip(std::vector<uint64_t>(257, 42), /*is_signed*/ false);
+  // Constant deltas pack to zero bits as well.
+  std::vector<uint64_t> values;
+  for (uint64_t i = 0; i < 200; ++i) {
+    values.push_back(i * 10);
+  }
+  ExpectRoundTrip(values, /*is_signed*/ false);
+  auto packed = PackedUInt64s::Pack(values.data(), values.size(), /*is_signed*/ false);
+  EXPECT_EQ(10U, packed.Get(1));
+}
+
+TEST(PackedUInt64sTest, signed_and_full_width_values) {
+  std::vector<int64_t> signed_values = {-5, 3, -1000000, 7, 0, -1, 1000000};
+  std::vector<uint64_t> values(signed_values.begin(), signed_values.end());
+  ExpectRoundTrip(values, /*is_signed*/ true);
+
+  ExpectRoundTrip({0, std::numeric_limits<uint64_t>::max(), 1, 1234567890123}, false);
+  ExpectRoundTrip({7}, false);
+}
+
+TEST(BitPackedColumnTest, int64_and_time_columns) {
+  std::vector<types::Int64Value> vals;
+  std::vector<types::Time64NSValue> times;
+  for (int64_t i = 0; i < 500; ++i) {
+    vals.emplace_back(-100 + i % 17);
+    times.emplace_back(1000000 + i * 1000);
+  }
+  auto arr = types::ToArrow(vals, arrow::default_memory_pool());
+  auto time_arr = types::ToArrow(times, arrow::default_memory_pool());
+
+  auto packed = BitPackedColumn::Pack(types::DataType::INT64, arr.get());
+  ASSERT_NE(nullptr, packed);
+  EXPECT_EQ(500, packed->length());
+  EXPECT_EQ(500 * 8, packed->PlainBytes());
+  EXPECT_LT(packed->Bytes(), packed->PlainBytes());
+  EXPECT_EQ(-100 + 20 % 17, packed->GetInt64(20));
+  ASSERT_OK_AND_ASSIGN(auto unpacked, packed->Unpack(0, 500, arrow::default_memory_pool()));
+  EXPECT_TRUE(unpacked->Equals(arr));
+
+  auto packed_time = BitPackedColumn::Pack(types::DataType::TIME64NS, time_arr.get());
+  ASSERT_NE(nullptr, packed_time);
+  ASSERT_OK_AND_ASSIGN(auto time_slice,
+                       packed_time->Unpack(130, 100, arrow::default_memory_pool()));
+  EXPECT_EQ(arrow::Type::TIME64, time_slice->type_id());
+  EXPECT_TRUE(time_slice->Equals(time_arr->Slice(130, 100)));
+}
+
+TEST(BitPackedColumnTest, uint128_column) {
+  std::vector<types::UInt128Value> vals;
+  for (uint64_t i = 0; i < 300; ++i) {
+    vals.emplace_back(absl::MakeUint128(0x1234567800000000 + i % 3, 123456789 + i * 11));
+  }
+  auto arr = types::ToArrow(vals, arrow::default_memory_pool());
+
+  auto packed = BitPackedColumn::Pack(types::DataType::UINT128, arr.get());
+  ASSERT_NE(nullptr, packed);
+  EXPECT_EQ(300 * 16, packed->PlainBytes());
+  EXPECT_LT(packed->Bytes(), packed->PlainBytes());
+  ASSERT_OK_AND_ASSIGN(auto unpacked, packed->Unpack(0, 300, arrow::default_memory_pool()));
+  EXPECT_TRUE(unpacked->Equals(arr));
+}
+
+TEST(BitPackedColumnTest, unpackable_columns) {
+  // Fewer rows than a block.
+  auto small = types::ToArrow(std::vector<types::Int64Value>{1, 5, 3},
+                              arrow::default_memory_pool());
+  EXPECT_EQ(nullptr, BitPackedColumn::Pack(types::DataType::INT64, small.get()));
+
+  arrow::Int64Builder builder;
+  ASSERT_TRUE(builder.AppendValues(std::vector<int64_t>(200, 1)).ok());
+  ASSERT_TRUE(builder.AppendNull().ok());
+  std::shared_ptr<arrow::Array> with_nulls;
+  ASSERT_TRUE(builder.Finish(&with_nulls).ok());
+  EXPECT_EQ(nullptr, BitPackedColumn::Pack(types::DataType::INT64, with_nulls.get()));
+
+  auto strings = types::ToArrow(std::vector<types::StringValue>(200, "abc"),
+                                arrow::default_memory_pool());
+  EXPECT_EQ(nullptr, BitPackedColumn::Pack(types::DataType::STRING, strings.get()));
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/table_store/table/internal/cold_batch.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/table/internal/dictionary_encoding.h"
+
+DEFINE_bool(table_store_bit_packing, gflags::BoolFromEnv("PL_TABLE_STORE_BIT_PACKING", true),
+            "Whether to bit-pack INT64, TIME64NS and UINT128 columns when compacting hot batches "
+            "into cold batches.");
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+Time ColdColumn::GetTime(int64_t idx) const {
+  if (packed_ != nullptr) {
+    return packed_->GetInt64(idx);
+  }
+  return types::GetValueFromArrowArray<types::DataType::TIME64NS>(array_.get(), idx);
+}
+
+int64_t ColdColumn::FindTimeFirstGreaterThanOrEqual(Time time) const {
+  if (packed_ == nullptr) {
+    return types::SearchArrowArrayGreaterThanOrEqual<types::DataType::TIME64NS>(array_.get(),
+                                                                                time);
+  }
+  int64_t lo = 0;
+  int64_t hi = length();
+  while (lo < hi) {
+    int64_t mid = lo + (hi - lo) / 2;
+    if (packed_->GetInt64(mid) < time) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo == length() ? -1 : lo;
+}
+
+int64_t ColdColumn::FindTimeLastLessThanOrEqual(Time time) const {
+  if (packed_ == nullptr) {
+    return types::SearchArrowArrayLessThanOrEqual<types::DataType::TIME64NS>(array_.get(), time);
+  }
+  int64_t lo = 0;
+  int64_t hi = length();
+  while (lo < hi) {
+    int64_t mid = lo + (hi - lo) / 2;
+    if (packed_->GetInt64(mid) <= time) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo - 1;
+}
+
+StatusOr<ArrowArrayPtr> ColdColumn::Slice(int64_t offset, int64_t num_rows,
+                                          arrow::MemoryPool* mem_pool) const {
+  if (packed_ != nullptr) {
+    return packed_->Unpack(offset, num_rows, mem_pool);
+  }
+  auto arr = array_->Slice(offset, num_rows);
+  if (IsDictionaryEncoded(arr.get())) {
+    return DictionaryDecode(arr.get(), mem_pool);
+  }
+  return arr;
+}
+
+StatusOr<std::unique_ptr<schema::RowBatch>> ColdBatchSlice::Decode(
+    const schema::RowDescriptor& desc, arrow::MemoryPool* mem_pool) const {
+  auto output_rb = std::make_unique<schema::RowBatch>(desc, num_rows);
+  for (const auto& col : columns) {
+    // Encoded columns are only decoded for the rows being read.
+    PX_ASSIGN_OR_RETURN(auto arr, col.Slice(offset, num_rows, mem_pool));
+    PX_RETURN_IF_ERROR(output_rb->AddColumn(arr));
+  }
+  return output_rb;
+}
+
+ColdBatchSlice ColdBatch::Slice(int64_t offset, int64_t num_rows,
+                                const std::vector<int64_t>& cols) const {
+  ColdBatchSlice slice;
+  slice.columns.reserve(cols.size());
+  for (auto col_idx : cols) {
+    slice.columns.push_back(columns_[col_idx]);
+  }
+  slice.offset = offset;
+  slice.num_rows = num_rows;
+  return slice;
+}
+
+ColdBatch::ColdBatch(const std::vector<ArrowArrayPtr>& columns) {
+  columns_.reserve(columns.size());
+  for (const auto& col : columns) {
+    columns_.emplace_back(col);
+  }
+}
+
+ColdBatch PackColdBatch(const schema::Relation& rel, const std::vector<ArrowArrayPtr>& columns,
+                        uint64_t* bytes_saved) {
+  std::vector<ColdColumn> cold_columns;
+  cold_columns.reserve(columns.size());
+  for (const auto& [col_idx, col] : Enumerate(columns)) {
+    if (FLAGS_table_store_bit_packing) {
+      auto packed = BitPackedColumn::Pack(rel.col_types()[col_idx], col.get());
+      if (packed != nullptr) {
+        *bytes_saved += packed->PlainBytes() - packed->Bytes();
+        cold_columns.emplace_back(std::move(packed));
+        continue;
+      }
+    }
+    cold_columns.emplace_back(col);
+  }
+  return ColdBatch(std::move(cold_columns));
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
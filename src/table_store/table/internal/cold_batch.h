@@ -0,0 +1,116 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <arrow/array.h>
+#include <arrow/memory_pool.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "src/common/base/base.h"
+#include "src/table_store/schema/relation.h"
+#include "src/table_store/schema/row_batch.h"
+#include "src/table_store/schema/row_descriptor.h"
+#include "src/table_store/table/internal/bit_packing.h"
+#include "src/table_store/table/internal/types.h"
+
+DECLARE_bool(table_store_bit_packing);
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+/**
+ * ColdColumn is a single column of a cold batch. It either holds an arrow::Array, which can be
+ * dictionary encoded (see dictionary_encoding.h), or a BitPackedColumn. Readers only ever see plain
+ * arrow arrays, through Slice.
+ */
+class ColdColumn {
+ public:
+  explicit ColdColumn(ArrowArrayPtr array) : array_(std::move(array)) {}
+  explicit ColdColumn(std::unique_ptr<BitPackedColumn> packed) : packed_(std::move(packed)) {}
+
+  int64_t length() const { return packed_ != nullptr ? packed_->length() : array_->length(); }
+  bool is_packed() const { return packed_ != nullptr; }
+
+  // Returns the value at idx of a TIME64NS column.
+  Time GetTime(int64_t idx) const;
+  // Returns the index of the first value >= time, or -1 if there is none. The column must be
+  // sorted.
+  int64_t FindTimeFirstGreaterThanOrEqual(Time time) const;
+  // Returns the index of the last value <= time, or -1 if there is none. The column must be sorted.
+  int64_t FindTimeLastLessThanOrEqual(Time time) const;
+
+  /**
+   * Returns the rows [offset, offset + num_rows) of the column as a plain arrow::Array, decoding
+   * only those rows if the column is encoded.
+   */
+  StatusOr<ArrowArrayPtr> Slice(int64_t offset, int64_t num_rows,
+                                arrow::MemoryPool* mem_pool) const;
+
+ private:
+  // Both are shared, so that a ColdBatchSlice can keep the column alive while it is decoded.
+  ArrowArrayPtr array_;
+  std::shared_ptr<const BitPackedColumn> packed_;
+};
+
+/**
+ * ColdBatchSlice holds the rows [offset, offset + num_rows) of some of the columns of a ColdBatch,
+ * without decoding them. It shares the columns with the batch, so readers can find the slice under
+ * the table's locks, and decode it after releasing them, even if the batch expires in between.
+ */
+struct ColdBatchSlice {
+  std::vector<ColdColumn> columns;
+  int64_t offset = 0;
+  int64_t num_rows = 0;
+
+  // Decodes the slice into a RowBatch whose descriptor has the types of the columns.
+  StatusOr<std::unique_ptr<schema::RowBatch>> Decode(const schema::RowDescriptor& desc,
+                                                      arrow::MemoryPool* mem_pool) const;
+};
+
+class ColdBatch {
+ public:
+  explicit ColdBatch(std::vector<ColdColumn> columns) : columns_(std::move(columns)) {}
+  explicit ColdBatch(const std::vector<ArrowArrayPtr>& columns);
+
+  size_t num_columns() const { return columns_.size(); }
+  int64_t num_rows() const { return columns_[0].length(); }
+  const ColdColumn& operator[](size_t col_idx) const { return columns_[col_idx]; }
+
+  // Returns the given rows of the columns with the given indices.
+  ColdBatchSlice Slice(int64_t offset, int64_t num_rows, const std::vector<int64_t>& cols) const;
+
+ private:
+  std::vector<ColdColumn> columns_;
+};
+
+/**
+ * Makes the cold batch for the output of an ArrowArrayCompactor, bit-packing the INT64, TIME64NS
+ * and UINT128 columns for which that saves memory (unless --table_store_bit_packing is false).
+ * @param bytes_saved incremented by the number of bytes saved by packing.
+ */
+ColdBatch PackColdBatch(const schema::Relation& rel, const std::vector<ArrowArrayPtr>& columns,
+                        uint64_t* bytes_saved);
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
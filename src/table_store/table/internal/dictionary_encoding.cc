@@ -0,0 +1,158 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/table_store/table/internal/dictionary_encoding.h"
+
+#include <arrow/builder.h>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "src/shared/types/arrow_adapter.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+namespace {
+
+uint64_t PlainStringColumnBytes(const arrow::StringArray* arr) {
+  auto data_bytes = arr->value_offset(arr->length()) - arr->value_offset(0);
+  return static_cast<uint64_t>(data_bytes) + sizeof(int32_t) * arr->length();
+}
+
+}  // namespace
+
+uint64_t StringColumnBytes(const arrow::Array* arr) {
+  if (IsDictionaryEncoded(arr)) {
+    auto dict_arr = static_cast<const arrow::DictionaryArray*>(arr);
+    return sizeof(int32_t) * arr->length() +
+           PlainStringColumnBytes(
+               static_cast<const arrow::StringArray*>(dict_arr->dictionary().get()));
+  }
+  DCHECK(arr->type_id() == arrow::Type::STRING);
+  return PlainStringColumnBytes(static_cast<const arrow::StringArray*>(arr));
+}
+
+StatusOr<DictionaryEncodingResult> MaybeDictionaryEncode(const ArrowArrayPtr& arr,
+                                                         arrow::MemoryPool* mem_pool) {
+  DictionaryEncodingResult result;
+  result.array = arr;
+  if (arr->type_id() != arrow::Type::STRING || arr->length() == 0) {
+    return result;
+  }
+  auto str_arr = static_cast<const arrow::StringArray*>(arr.get());
+  const int64_t num_rows = arr->length();
+  const auto max_distinct = static_cast<size_t>(num_rows * kMaxDictionaryDistinctRatio);
+
+  // Assign each distinct value an index in the order the values first appear. Stop as soon as the
+  // column has too many distinct values, so high cardinality columns are rejected cheaply.
+  absl::flat_hash_map<std::string_view, int32_t> value_to_index;
+  std::vector<int32_t> indices(num_rows);
+  uint64_t dict_data_bytes = 0;
+  for (int64_t i = 0; i < num_rows; ++i) {
+    if (arr->IsNull(i)) {
+      indices[i] = -1;
+      continue;
+    }
+    auto val = types::GetStringViewFromArrowArray(str_arr, i);
+    auto [it, inserted] =
+        value_to_index.try_emplace(val, static_cast<int32_t>(value_to_index.size()));
+    if (inserted) {
+      if (value_to_index.size() > max_distinct) {
+        return result;
+      }
+      dict_data_bytes += val.size();
+    }
+    indices[i] = it->second;
+  }
+
+  uint64_t plain_bytes = PlainStringColumnBytes(str_arr);
+  uint64_t encoded_bytes =
+      sizeof(int32_t) * num_rows + dict_data_bytes + sizeof(int32_t) * value_to_index.size();
+  if (encoded_bytes >= plain_bytes) {
+    return result;
+  }
+
+  std::vector<std::string_view> dict_values(value_to_index.size());
+  for (const auto& [val, idx] : value_to_index) {
+    dict_values[idx] = val;
+  }
+  arrow::StringBuilder dict_builder(mem_pool);
+  PX_RETURN_IF_ERROR(dict_builder.Reserve(dict_values.size()));
+  PX_RETURN_IF_ERROR(dict_builder.ReserveData(dict_data_bytes));
+  for (const auto& val : dict_values) {
+    dict_builder.UnsafeAppend(val.data(), static_cast<int32_t>(val.size()));
+  }
+  std::shared_ptr<arrow::Array> dictionary;
+  PX_RETURN_IF_ERROR(dict_builder.Finish(&dictionary));
+
+  arrow::Int32Builder indices_builder(mem_pool);
+  PX_RETURN_IF_ERROR(indices_builder.Reserve(num_rows));
+  for (int64_t i = 0; i < num_rows; ++i) {
+    if (indices[i] < 0) {
+      indices_builder.UnsafeAppendNull();
+    } else {
+      indices_builder.UnsafeAppend(indices[i]);
+    }
+  }
+  std::shared_ptr<arrow::Array> indices_arr;
+  PX_RETURN_IF_ERROR(indices_builder.Finish(&indices_arr));
+
+  result.array = std::make_shared<arrow::DictionaryArray>(
+      arrow::dictionary(arrow::int32(), arrow::utf8()), indices_arr, dictionary);
+  result.bytes_saved = plain_bytes - encoded_bytes;
+  return result;
+}
+
+StatusOr<ArrowArrayPtr> DictionaryDecode(const arrow::Array* arr, arrow::MemoryPool* mem_pool) {
+  DCHECK(IsDictionaryEncoded(arr));
+  auto dict_arr = static_cast<const arrow::DictionaryArray*>(arr);
+  auto indices = static_cast<const arrow::Int32Array*>(dict_arr->indices().get());
+  auto dictionary = static_cast<const arrow::StringArray*>(dict_arr->dictionary().get());
+  const int64_t num_rows = arr->length();
+
+  uint64_t data_bytes = 0;
+  for (int64_t i = 0; i < num_rows; ++i) {
+    if (!indices->IsNull(i)) {
+      data_bytes += dictionary->value_length(indices->Value(i));
+    }
+  }
+
+  arrow::StringBuilder builder(mem_pool);
+  PX_RETURN_IF_ERROR(builder.Reserve(num_rows));
+  PX_RETURN_IF_ERROR(builder.ReserveData(data_bytes));
+  for (int64_t i = 0; i < num_rows; ++i) {
+    if (indices->IsNull(i)) {
+      builder.UnsafeAppendNull();
+      continue;
+    }
+    auto val = dictionary->GetView(indices->Value(i));
+    builder.UnsafeAppend(val.data(), static_cast<int32_t>(val.size()));
+  }
+  std::shared_ptr<arrow::Array> out;
+  PX_RETURN_IF_ERROR(builder.Finish(&out));
+  return out;
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <arrow/array.h>
+#include <arrow/memory_pool.h>
+
+#include <cstdint>
+
+#include "src/common/base/base.h"
+#include "src/table_store/table/internal/types.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+/**
+ * Dictionary encoding of cold string columns. Most string columns in the table store (request
+ * methods, paths, service and pod names, ...) only take a handful of values, so storing each
+ * distinct string once along with an int32 index per row takes a fraction of the memory of a
+ * plain arrow::StringArray.
+ *
+ * Encoded columns are arrow::DictionaryArray's with int32 indices and a string dictionary that
+ * holds each distinct value once.
+ */
+struct DictionaryEncodingResult {
+  // Either the dictionary encoded column, or the input column if encoding it didn't pay off.
+  ArrowArrayPtr array;
+  // Bytes of the plain string column minus bytes of the encoded column. 0 if not encoded.
+  uint64_t bytes_saved = 0;
+};
+
+// A column is only encoded if it has at most this many distinct values per row.
+constexpr double kMaxDictionaryDistinctRatio = 0.5;
+
+/**
+ * Dictionary encodes a string column if it has few enough distinct values and the encoded column
+ * is smaller than the plain one.
+ */
+StatusOr<DictionaryEncodingResult> MaybeDictionaryEncode(const ArrowArrayPtr& arr,
+                                                         arrow::MemoryPool* mem_pool);
+
+inline bool IsDictionaryEncoded(const arrow::Array* arr) {
+  return arr->type_id() == arrow::Type::DICTIONARY;
+}
+
+/**
+ * Decodes a dictionary encoded column (or a slice of one) into a plain arrow::StringArray.
+ */
+StatusOr<ArrowArrayPtr> DictionaryDecode(const arrow::Array* arr, arrow::MemoryPool* mem_pool);
+
+/**
+ * Returns the number of bytes used by a string column, plain or dictionary encoded, counting the
+ * string data and 4 bytes per offset or index, like the BatchSizeAccountant does.
+ */
+uint64_t StringColumnBytes(const arrow::Array* arr);
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
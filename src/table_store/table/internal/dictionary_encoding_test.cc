@@ -0,0 +1,92 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arrow/builder.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/table/internal/dictionary_encoding.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+TEST(DictionaryEncodingTest, low_cardinality_column_is_encoded) {
+  std::vector<types::StringValue> vals = {"GET", "POST", "GET", "GET", "GET", "POST", "GET", "GET"};
+  auto arr = types::ToArrow(vals, arrow::default_memory_pool());
+
+  ASSERT_OK_AND_ASSIGN(auto encoded, MaybeDictionaryEncode(arr, arrow::default_memory_pool()));
+  ASSERT_TRUE(IsDictionaryEncoded(encoded.array.get()));
+  auto dict_arr = static_cast<const arrow::DictionaryArray*>(encoded.array.get());
+  EXPECT_TRUE(dict_arr->dictionary()->Equals(types::ToArrow(
+      std::vector<types::StringValue>{"GET", "POST"}, arrow::default_memory_pool())));
+
+  // 8 offsets and 26 bytes of strings vs. 8 indices, 2 offsets and 7 bytes of strings.
+  EXPECT_EQ(58U, StringColumnBytes(arr.get()));
+  EXPECT_EQ(47U, StringColumnBytes(encoded.array.get()));
+  EXPECT_EQ(11U, encoded.bytes_saved);
+
+  ASSERT_OK_AND_ASSIGN(auto decoded,
+                       DictionaryDecode(encoded.array.get(), arrow::default_memory_pool()));
+  EXPECT_TRUE(decoded->Equals(arr));
+}
+
+TEST(DictionaryEncodingTest, high_cardinality_column_is_not_encoded) {
+  std::vector<types::StringValue> vals = {"a", "b", "c", "d", "a"};
+  auto arr = types::ToArrow(vals, arrow::default_memory_pool());
+
+  ASSERT_OK_AND_ASSIGN(auto encoded, MaybeDictionaryEncode(arr, arrow::default_memory_pool()));
+  EXPECT_EQ(arr, encoded.array);
+  EXPECT_EQ(0U, encoded.bytes_saved);
+}
+
+TEST(DictionaryEncodingTest, short_strings_are_not_encoded) {
+  // Each value only takes a single byte, so the indices would take more space than the strings.
+  std::vector<types::StringValue> vals = {"a", "b", "a", "a", "b", "a"};
+  auto arr = types::ToArrow(vals, arrow::default_memory_pool());
+
+  ASSERT_OK_AND_ASSIGN(auto encoded, MaybeDictionaryEncode(arr, arrow::default_memory_pool()));
+  EXPECT_FALSE(IsDictionaryEncoded(encoded.array.get()));
+}
+
+TEST(DictionaryEncodingTest, decode_slice_with_nulls) {
+  arrow::StringBuilder builder;
+  for (const auto& val : {"service-a", "service-b", "service-a", "", "service-a", "service-b"}) {
+    ASSERT_TRUE(builder.Append(val).ok());
+  }
+  ASSERT_TRUE(builder.AppendNull().ok());
+  ASSERT_TRUE(builder.Append("service-a").ok());
+  std::shared_ptr<arrow::Array> arr;
+  ASSERT_TRUE(builder.Finish(&arr).ok());
+
+  ASSERT_OK_AND_ASSIGN(auto encoded, MaybeDictionaryEncode(arr, arrow::default_memory_pool()));
+  ASSERT_TRUE(IsDictionaryEncoded(encoded.array.get()));
+
+  auto slice = encoded.array->Slice(2, 5);
+  ASSERT_OK_AND_ASSIGN(auto decoded, DictionaryDecode(slice.get(), arrow::default_memory_pool()));
+  EXPECT_TRUE(decoded->Equals(arr->Slice(2, 5)));
+  EXPECT_EQ(1, decoded->null_count());
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <deque>
 #include <memory>
 #include <optional>
@@ -28,6 +29,7 @@
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/column_wrapper.h"
 #include "src/table_store/schema/relation.h"
+#include "src/table_store/table/internal/cold_batch.h"
 #include "src/table_store/table/internal/types.h"
 
 namespace px {
@@ -93,30 +95,10 @@ class StoreWithRowTimeAccounting {
   StatusOr<std::unique_ptr<schema::RowBatch>> GetNextRowBatch(
       RowID* last_read_row_id, BatchHints* hints, std::optional<RowID> stop_row_id,
       const std::vector<int64_t>& cols) const {
-    auto start_row_id = *last_read_row_id + 1;
-    if (batches_.empty() || start_row_id < FirstRowID() || start_row_id > LastRowID()) {
+    auto next = NextSlice(last_read_row_id, hints, stop_row_id);
+    if (!next.has_value()) {
       return std::unique_ptr<schema::RowBatch>(nullptr);
     }
-    if (DCHECK_IS_ON() && stop_row_id.has_value()) {
-      DCHECK_LT(start_row_id, stop_row_id.value());
-    }
-
-    BatchID batch_id;
-    if (hints != nullptr && BatchHintValid(*hints, start_row_id)) {
-      batch_id = hints->batch_id;
-    } else {
-      batch_id = FindBatchIDFromRowID(start_row_id);
-    }
-
-    const auto& batch = GetBatchFromBatchID(batch_id);
-    RowID batch_first_row_id = BatchFirstRowID(batch_id);
-    RowID batch_last_row_id = BatchLastRowID(batch_id);
-    size_t row_offset = start_row_id - batch_first_row_id;
-    size_t batch_size = batch_last_row_id - start_row_id + 1;
-    if (stop_row_id.has_value() && batch_last_row_id >= stop_row_id.value()) {
-      // Reduce batch size if the batch extends past the given stop row.
-      batch_size -= (batch_last_row_id - stop_row_id.value()) + 1;
-    }
 
     // Get column types for row descriptor.
     std::vector<types::DataType> col_types;
@@ -125,18 +107,63 @@ class StoreWithRowTimeAccounting {
       col_types.push_back(rel_.col_types()[col_idx]);
     }
     auto output_rb =
-        std::make_unique<schema::RowBatch>(schema::RowDescriptor(col_types), batch_size);
-    PX_RETURN_IF_ERROR(
-        AddBatchSliceToRowBatch(batch, row_offset, batch_size, cols, output_rb.get()));
+        std::make_unique<schema::RowBatch>(schema::RowDescriptor(col_types), next->batch_size);
+    PX_RETURN_IF_ERROR(AddBatchSliceToRowBatch(GetBatchFromBatchID(next->batch_id),
+                                               next->row_offset, next->batch_size, cols,
+                                               output_rb.get()));
+    return output_rb;
+  }
 
-    // Update the ptr to the last read row.
-    *last_read_row_id = start_row_id + batch_size - 1;
+  /**
+   * GetNextColdBatchSlice is GetNextRowBatch for the cold store, except that the rows are only
+   * decoded by ColdBatchSlice::Decode, which doesn't need the store anymore. This lets readers
+   * decode outside of the table's locks.
+   * @return the slice, or std::nullopt if there are no more rows in this store that match the
+   * parameters.
+   */
+  std::optional<ColdBatchSlice> GetNextColdBatchSlice(RowID* last_read_row_id, BatchHints* hints,
+                                                      std::optional<RowID> stop_row_id,
+                                                      const std::vector<int64_t>& cols) const {
+    static_assert(TStoreType == StoreType::Cold);
+    auto next = NextSlice(last_read_row_id, hints, stop_row_id);
+    if (!next.has_value()) {
+      return std::nullopt;
+    }
+    return GetBatchFromBatchID(next->batch_id).Slice(next->row_offset, next->batch_size, cols);
+  }
 
-    // Set hints to point to the next batch in the current store. It's fine if that batch doesn't
-    // exist, as the next call will ignore the hints if that's the case.
-    hints->batch_id = batch_id + 1;
-    hints->hint_type = TStoreType;
-    return output_rb;
+  /**
+   * SkipBatches moves last_read_row_id past the batches that skip_batch returns true for,
+   * starting at the batch with the next row to read and stopping at the first batch that isn't
+   * skipped.
+   * @param last_read_row_id, pointer to the unique RowID of the last read row.
+   * @param stop_row_id, an optional unique RowID to stop at. last_read_row_id is never moved past
+   * `stop_row_id.value() - 1`.
+   * @param skip_batch, called with the index of a batch in this store (0 is the front batch).
+   * @return the number of skipped batches.
+   */
+  template <typename TSkipFn>
+  int64_t SkipBatches(RowID* last_read_row_id, std::optional<RowID> stop_row_id,
+                      TSkipFn skip_batch) const {
+    int64_t num_skipped = 0;
+    while (true) {
+      auto start_row_id = *last_read_row_id + 1;
+      if (batches_.empty() || start_row_id < FirstRowID() || start_row_id > LastRowID()) {
+        return num_skipped;
+      }
+      if (stop_row_id.has_value() && start_row_id >= stop_row_id.value()) {
+        return num_skipped;
+      }
+      BatchID batch_id = FindBatchIDFromRowID(start_row_id);
+      if (!skip_batch(batch_id - first_batch_id_)) {
+        return num_skipped;
+      }
+      *last_read_row_id = BatchLastRowID(batch_id);
+      if (stop_row_id.has_value()) {
+        *last_read_row_id = std::min(*last_read_row_id, stop_row_id.value() - 1);
+      }
+      ++num_skipped;
+    }
   }
 
   /**
@@ -342,7 +369,7 @@ class StoreWithRowTimeAccounting {
 
   size_t BatchLength(const TBatch& batch) const {
     if constexpr (std::is_same_v<ColdBatch, TBatch>) {
-      return batch[0]->length();
+      return batch.num_rows();
     } else if constexpr (std::is_same_v<HotBatch, TBatch>) {
       return batch.Length();
     } else {
@@ -352,8 +379,7 @@ class StoreWithRowTimeAccounting {
 
   size_t FindTimeFirstGreaterThanOrEqual(const TBatch& batch, Time time) const {
     if constexpr (std::is_same_v<TBatch, ColdBatch>) {
-      return types::SearchArrowArrayGreaterThanOrEqual<types::DataType::TIME64NS>(
-          batch[time_col_idx_].get(), time);
+      return batch[time_col_idx_].FindTimeFirstGreaterThanOrEqual(time);
     } else if constexpr (std::is_same_v<TBatch, HotBatch>) {
       return batch.FindTimeFirstGreaterThanOrEqual(time_col_idx_, time);
     } else {
@@ -363,9 +389,7 @@ class StoreWithRowTimeAccounting {
 
   size_t FindTimeFirstGreaterThan(const TBatch& batch, Time time) const {
     if constexpr (std::is_same_v<TBatch, ColdBatch>) {
-      return types::SearchArrowArrayLessThanOrEqual<types::DataType::TIME64NS>(
-                 batch[time_col_idx_].get(), time) +
-             1;
+      return batch[time_col_idx_].FindTimeLastLessThanOrEqual(time) + 1;
     } else if constexpr (std::is_same_v<TBatch, HotBatch>) {
       return batch.FindTimeFirstGreaterThan(time_col_idx_, time);
     } else {
@@ -375,8 +399,7 @@ class StoreWithRowTimeAccounting {
 
   Time GetTimeValue(const TBatch& batch, int64_t row_idx) const {
     if constexpr (std::is_same_v<TBatch, ColdBatch>) {
-      return types::GetValueFromArrowArray<types::DataType::TIME64NS>(batch[time_col_idx_].get(),
-                                                                      row_idx);
+      return batch[time_col_idx_].GetTime(row_idx);
     } else if constexpr (std::is_same_v<TBatch, HotBatch>) {
       return batch.GetTimeValue(time_col_idx_, row_idx);
     } else {
@@ -384,12 +407,59 @@ class StoreWithRowTimeAccounting {
     }
   }
 
+  // The rows of a batch that GetNextRowBatch returns.
+  struct BatchSlice {
+    BatchID batch_id;
+    size_t row_offset;
+    size_t batch_size;
+  };
+
+  // Finds the rows that the next GetNextRowBatch returns, and moves last_read_row_id and hints past
+  // them.
+  std::optional<BatchSlice> NextSlice(RowID* last_read_row_id, BatchHints* hints,
+                                      std::optional<RowID> stop_row_id) const {
+    auto start_row_id = *last_read_row_id + 1;
+    if (batches_.empty() || start_row_id < FirstRowID() || start_row_id > LastRowID()) {
+      return std::nullopt;
+    }
+    if (DCHECK_IS_ON() && stop_row_id.has_value()) {
+      DCHECK_LT(start_row_id, stop_row_id.value());
+    }
+
+    BatchID batch_id;
+    if (hints != nullptr && BatchHintValid(*hints, start_row_id)) {
+      batch_id = hints->batch_id;
+    } else {
+      batch_id = FindBatchIDFromRowID(start_row_id);
+    }
+
+    RowID batch_first_row_id = BatchFirstRowID(batch_id);
+    RowID batch_last_row_id = BatchLastRowID(batch_id);
+    size_t row_offset = start_row_id - batch_first_row_id;
+    size_t batch_size = batch_last_row_id - start_row_id + 1;
+    if (stop_row_id.has_value() && batch_last_row_id >= stop_row_id.value()) {
+      // Reduce batch size if the batch extends past the given stop row.
+      batch_size -= (batch_last_row_id - stop_row_id.value()) + 1;
+    }
+
+    // Update the ptr to the last read row.
+    *last_read_row_id = start_row_id + batch_size - 1;
+
+    // Set hints to point to the next batch in the current store. It's fine if that batch doesn't
+    // exist, as the next call will ignore the hints if that's the case.
+    hints->batch_id = batch_id + 1;
+    hints->hint_type = TStoreType;
+    return BatchSlice{batch_id, row_offset, batch_size};
+  }
+
   Status AddBatchSliceToRowBatch(const TBatch& batch, size_t row_offset, size_t batch_size,
                                  const std::vector<int64_t>& cols,
                                  schema::RowBatch* output_rb) const {
     if constexpr (std::is_same_v<TBatch, ColdBatch>) {
       for (auto col_idx : cols) {
-        auto arr = batch[col_idx]->Slice(row_offset, batch_size);
+        // Encoded columns are only decoded for the rows being read.
+        PX_ASSIGN_OR_RETURN(auto arr, batch[col_idx].Slice(row_offset, batch_size,
+                                                           arrow::default_memory_pool()));
         PX_RETURN_IF_ERROR(output_rb->AddColumn(arr));
       }
       return Status::OK();
@@ -61,8 +61,7 @@ struct BatchHints {
 };
 
 class RecordOrRowBatch;
-
-using ColdBatch = std::vector<ArrowArrayPtr>;
+class ColdBatch;
 
 template <StoreType type>
 struct StoreTypeTraits {};
@@ -48,8 +48,9 @@ DEFINE_int32(table_store_table_size_limit,
 namespace px {
 namespace table_store {
 
-Table::Cursor::Cursor(const Table* table, StartSpec start, StopSpec stop)
-    : table_(table), hints_(internal::BatchHints{}) {
+Table::Cursor::Cursor(const Table* table, StartSpec start, StopSpec stop,
+                      std::vector<ColumnPredicate> predicates)
+    : table_(table), hints_(internal::BatchHints{}), predicates_(std::move(predicates)) {
   AdvanceToStart(start);
   StopStateFromSpec(std::move(stop));
 }
@@ -167,6 +168,11 @@ StatusOr<std::unique_ptr<schema::RowBatch>> Table::Cursor::GetNextRowBatch(
   return table_->GetNextRowBatch(this, cols);
 }
 
+StatusOr<std::vector<std::unique_ptr<schema::RowBatch>>> Table::Cursor::GetNextRowBatches(
+    const std::vector<int64_t>& cols, int64_t max_batches) {
+  return table_->GetNextRowBatches(this, cols, max_batches);
+}
+
 Table::Table(std::string_view table_name, const schema::Relation& relation, size_t max_table_size,
              size_t compacted_batch_size)
     : metrics_(&(GetMetricsRegistry()), std::string(table_name)),
@@ -209,15 +215,53 @@ Status Table::ToProto(table_store::schemapb::Table* table_proto) const {
   return Status::OK();
 }
 
+int64_t Table::SkipColdBatchesUnlocked(Cursor* cursor) const {
+  auto num_skipped = cold_store_->SkipBatches(
+      cursor->LastReadRowID(), cursor->StopRowID(), [&](size_t batch_idx) {
+        return !cold_zone_maps_[batch_idx].MayMatch(cursor->predicates_);
+      });
+  if (num_skipped > 0) {
+    cursor->batches_skipped_ += num_skipped;
+    absl::base_internal::SpinLockHolder lock(&stats_lock_);
+    batches_skipped_ += num_skipped;
+    metrics_.batches_skipped_counter.Increment(num_skipped);
+  }
+  return num_skipped;
+}
+
 StatusOr<std::unique_ptr<schema::RowBatch>> Table::GetNextRowBatch(
     Cursor* cursor, const std::vector<int64_t>& cols) const {
   DCHECK(!cursor->Done()) << "Calling GetNextRowBatch on an exhausted Cursor";
   absl::base_internal::SpinLockHolder cold_lock(&cold_lock_);
+
+  // If the cursor skipped all the rows it had left, there is nothing to read.
+  auto zero_row_batch = [&]() {
+    std::vector<types::DataType> col_types;
+    for (auto col_idx : cols) {
+      col_types.push_back(rel_.GetColumnType(col_idx));
+    }
+    return schema::RowBatch::WithZeroRows(schema::RowDescriptor(col_types), /* eow */ false,
+                                          /* eos */ false);
+  };
+  int64_t num_skipped = 0;
+  if (!cursor->predicates_.empty()) {
+    num_skipped = SkipColdBatchesUnlocked(cursor);
+    auto stop_row_id = cursor->StopRowID();
+    if (num_skipped > 0 && stop_row_id.has_value() &&
+        *cursor->LastReadRowID() + 1 >= stop_row_id.value()) {
+      return zero_row_batch();
+    }
+  }
+
   PX_ASSIGN_OR_RETURN(auto rb,
                       cold_store_->GetNextRowBatch(cursor->LastReadRowID(), cursor->Hints(),
                                                    cursor->StopRowID(), cols));
   if (rb == nullptr) {
     absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
+    if (num_skipped > 0 &&
+        (hot_store_->Size() == 0 || *cursor->LastReadRowID() >= hot_store_->LastRowID())) {
+      return zero_row_batch();
+    }
     PX_ASSIGN_OR_RETURN(rb, hot_store_->GetNextRowBatch(cursor->LastReadRowID(), cursor->Hints(),
                                                         cursor->StopRowID(), cols));
     if (rb == nullptr && hot_store_->Size() > 0) {
@@ -237,6 +281,85 @@ StatusOr<std::unique_ptr<schema::RowBatch>> Table::GetNextRowBatch(
   return rb;
 }
 
+StatusOr<std::vector<std::unique_ptr<schema::RowBatch>>> Table::GetNextRowBatches(
+    Cursor* cursor, const std::vector<int64_t>& cols, int64_t max_batches) const {
+  DCHECK_GT(max_batches, 0);
+  std::vector<std::unique_ptr<schema::RowBatch>> batches;
+  // Cursor::Done() can take the table locks, so the stop row is checked directly.
+  auto stop_row_id = cursor->StopRowID();
+  auto exhausted = [&]() {
+    return stop_row_id.has_value() && *cursor->LastReadRowID() + 1 >= stop_row_id.value();
+  };
+  if (exhausted()) {
+    return batches;
+  }
+
+  // The cold batches are only found under the locks, and decoded after they are released, since
+  // decoding is most of the work of a read and would otherwise block the writers. The hot batches
+  // are sliced under the locks, which doesn't decode or copy them.
+  std::vector<std::variant<internal::ColdBatchSlice, std::unique_ptr<schema::RowBatch>>> reads;
+  {
+    absl::base_internal::SpinLockHolder cold_lock(&cold_lock_);
+    absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
+
+    // If the rows after the cursor were expired, continue from the start of the table.
+    RowID first_row_id = -1;
+    if (cold_store_->Size() > 0) {
+      first_row_id = cold_store_->FirstRowID();
+    } else if (hot_store_->Size() > 0) {
+      first_row_id = hot_store_->FirstRowID();
+    }
+    if (first_row_id != -1 && *cursor->LastReadRowID() + 1 < first_row_id) {
+      *cursor->LastReadRowID() = first_row_id - 1;
+    }
+
+    while (static_cast<int64_t>(reads.size()) < max_batches && !exhausted()) {
+      if (!cursor->predicates_.empty() && SkipColdBatchesUnlocked(cursor) > 0 && exhausted()) {
+        break;
+      }
+      auto cold_slice = cold_store_->GetNextColdBatchSlice(cursor->LastReadRowID(),
+                                                           cursor->Hints(), cursor->StopRowID(),
+                                                           cols);
+      if (cold_slice.has_value()) {
+        reads.emplace_back(std::move(cold_slice.value()));
+        continue;
+      }
+      PX_ASSIGN_OR_RETURN(auto rb, hot_store_->GetNextRowBatch(cursor->LastReadRowID(),
+                                                               cursor->Hints(),
+                                                               cursor->StopRowID(), cols));
+      if (rb == nullptr) {
+        break;
+      }
+      reads.emplace_back(std::move(rb));
+    }
+  }
+
+  // Cursors that stop at the end of the table can't wait for more data to be written.
+  auto stop_type = cursor->stop_.spec.type;
+  bool stops_in_table = stop_type == Cursor::StopSpec::StopType::CurrentEndOfTable ||
+                        stop_type == Cursor::StopSpec::StopType::StopAtTimeOrEndOfTable;
+  if (reads.empty() && !exhausted() && stops_in_table) {
+    return error::InvalidArgument("Data after Cursor is not in the table.");
+  }
+
+  std::vector<types::DataType> col_types;
+  for (auto col_idx : cols) {
+    col_types.push_back(rel_.GetColumnType(col_idx));
+  }
+  schema::RowDescriptor desc(col_types);
+  batches.reserve(reads.size());
+  for (auto& read : reads) {
+    if (auto* rb = std::get_if<std::unique_ptr<schema::RowBatch>>(&read)) {
+      batches.push_back(std::move(*rb));
+      continue;
+    }
+    PX_ASSIGN_OR_RETURN(auto rb, std::get<internal::ColdBatchSlice>(read).Decode(
+                                     desc, arrow::default_memory_pool()));
+    batches.push_back(std::move(rb));
+  }
+  return batches;
+}
+
 Status Table::ExpireRowBatches(int64_t row_batch_size) {
   if (row_batch_size > max_table_size_) {
     return error::InvalidArgument("RowBatch size ($0) is bigger than maximum table size ($1).",
@@ -393,6 +516,7 @@ TableStats Table::GetTableStats() const {
   int64_t num_batches = 0;
   int64_t hot_bytes = 0;
   int64_t cold_bytes = 0;
+  int64_t cold_uncompressed_bytes = 0;
   {
     absl::base_internal::SpinLockHolder cold_lock(&cold_lock_);
     min_time = cold_store_->MinTime();
@@ -401,6 +525,7 @@ TableStats Table::GetTableStats() const {
     num_batches += hot_store_->Size();
     hot_bytes = batch_size_accountant_->HotBytes();
     cold_bytes = batch_size_accountant_->ColdBytes();
+    cold_uncompressed_bytes = batch_size_accountant_->ColdUncompressedBytes();
     if (min_time == -1) {
       min_time = hot_store_->MinTime();
     }
@@ -414,7 +539,11 @@ TableStats Table::GetTableStats() const {
   info.bytes = hot_bytes + cold_bytes;
   info.hot_bytes = hot_bytes;
   info.cold_bytes = cold_bytes;
+  info.cold_uncompressed_bytes = cold_uncompressed_bytes;
+  info.cold_compression_ratio =
+      cold_bytes > 0 ? static_cast<double>(cold_uncompressed_bytes) / cold_bytes : 1.0;
   info.compacted_batches = compacted_batches_;
+  info.batches_skipped = batches_skipped_;
   info.max_table_size = max_table_size_;
   info.min_time = min_time;
 
@@ -441,9 +570,12 @@ Status Table::CompactSingleBatchUnlocked(arrow::MemoryPool*) {
 
   PX_ASSIGN_OR_RETURN(std::vector<ArrowArrayPtr> out_columns, compactor_.Finish());
 
-  cold_store_->EmplaceBack(first_row_id, out_columns);
+  cold_zone_maps_.push_back(ZoneMap::Compute(rel_, out_columns));
+  uint64_t bytes_saved = compactor_.LastBatchBytesSaved();
+  cold_store_->EmplaceBack(first_row_id,
+                           internal::PackColdBatch(rel_, out_columns, &bytes_saved));
 
-  auto num_rows_to_remove = batch_size_accountant_->FinishCompactedBatch();
+  auto num_rows_to_remove = batch_size_accountant_->FinishCompactedBatch(bytes_saved);
   if (num_rows_to_remove > 0) {
     hot_store_->RemovePrefix(num_rows_to_remove);
   }
@@ -482,6 +614,7 @@ StatusOr<bool> Table::ExpireCold() {
     return false;
   }
   cold_store_->PopFront();
+  cold_zone_maps_.pop_front();
   absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
   batch_size_accountant_->ExpireColdBatch();
   return true;
@@ -512,6 +645,7 @@ Status Table::UpdateTableMetricGauges() {
   auto stats = GetTableStats();
   // Set gauge values
   metrics_.cold_bytes_gauge.Set(stats.cold_bytes);
+  metrics_.cold_compression_ratio_gauge.Set(stats.cold_compression_ratio);
   metrics_.hot_bytes_gauge.Set(stats.hot_bytes);
   metrics_.num_batches_gauge.Set(stats.num_batches);
   metrics_.max_table_size_gauge.Set(stats.max_table_size);
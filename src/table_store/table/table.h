@@ -47,6 +47,7 @@
 #include "src/table_store/table/internal/store_with_row_accounting.h"
 #include "src/table_store/table/internal/types.h"
 #include "src/table_store/table/table_metrics.h"
+#include "src/table_store/table/zone_map.h"
 
 DECLARE_int32(table_store_table_size_limit);
 
@@ -59,11 +60,16 @@ struct TableStats {
   int64_t bytes;
   int64_t hot_bytes;
   int64_t cold_bytes;
+  // The bytes the cold data would take up without dictionary encoding or bit-packing.
+  int64_t cold_uncompressed_bytes;
+  // cold_uncompressed_bytes / cold_bytes, or 1 if there is no cold data.
+  double cold_compression_ratio;
   int64_t num_batches;
   int64_t batches_added;
   int64_t batches_expired;
   int64_t bytes_added;
   int64_t compacted_batches;
+  int64_t batches_skipped;
   int64_t max_table_size;
   int64_t min_time;
 };
@@ -100,6 +106,17 @@ struct TableStats {
  * Cursor stores the unique row identifier of the last read row, so
  * that when GetNextRowBatch is called on the cursor it can work out that it needs to return a slice
  * of the batch with the original "second" batch's data.
+ *
+ * Zone Maps:
+ * Each cold batch has a ZoneMap with the min, max and null count of every column, computed when
+ * the batch is compacted. Cursors created with a set of ColumnPredicates skip the cold batches
+ * whose zone map shows that no row can satisfy all of the predicates.
+ *
+ * Cold Column Encodings:
+ * String columns with few distinct values are dictionary encoded when they are compacted into the
+ * cold store, and INT64, TIME64NS and UINT128 columns are bit-packed (see internal/cold_batch.h).
+ * The bytes saved are not counted towards the table size. Cursors decode only the rows they read,
+ * so readers always get plain arrow arrays.
  */
 class Table : public NotCopyable {
   using RecordBatchPtr = internal::RecordBatchPtr;
@@ -174,7 +191,15 @@ class Table : public NotCopyable {
     };
 
     explicit Cursor(const Table* table) : Cursor(table, StartSpec{}, StopSpec{}) {}
-    Cursor(const Table* table, StartSpec start, StopSpec stop);
+    Cursor(const Table* table, StartSpec start, StopSpec stop)
+        : Cursor(table, start, stop, std::vector<ColumnPredicate>{}) {}
+    /**
+     * Creates a cursor that skips the cold batches that can't contain a row for which all of the
+     * predicates hold. The returned batches are not filtered, so they can still contain rows that
+     * don't satisfy the predicates.
+     */
+    Cursor(const Table* table, StartSpec start, StopSpec stop,
+           std::vector<ColumnPredicate> predicates);
 
     // In the case of StopType == Infinite or StopType == StopAtTime, this returns whether the table
     // has the next batch ready. In the case of StopType == CurrentEndOfTable, this returns !Done().
@@ -184,10 +209,15 @@ class Table : public NotCopyable {
     // is past the stopping condition. In this case `GetNextRowBatch(...)` will return an error.
     bool NextBatchReady();
     StatusOr<std::unique_ptr<schema::RowBatch>> GetNextRowBatch(const std::vector<int64_t>& cols);
+    // Returns up to max_batches of the next batches, see Table::GetNextRowBatches.
+    StatusOr<std::vector<std::unique_ptr<schema::RowBatch>>> GetNextRowBatches(
+        const std::vector<int64_t>& cols, int64_t max_batches);
     // In the case of StopType == Infinite, this function always returns false.
     bool Done();
     // Change the StopSpec of the cursor.
     void UpdateStopSpec(StopSpec stop);
+    // The number of cold batches that this cursor skipped because of their zone maps.
+    int64_t batches_skipped() const { return batches_skipped_; }
 
    private:
     void AdvanceToStart(const StartSpec& start);
@@ -210,6 +240,8 @@ class Table : public NotCopyable {
     internal::BatchHints hints_;
     RowID last_read_row_id_;
     StopState stop_;
+    std::vector<ColumnPredicate> predicates_;
+    int64_t batches_skipped_ = 0;
 
     friend class Table;
   };
@@ -238,6 +270,20 @@ class Table : public NotCopyable {
   StatusOr<std::unique_ptr<schema::RowBatch>> GetNextRowBatch(
       Cursor* cursor, const std::vector<int64_t>& cols) const;
 
+  /**
+   * Get up to max_batches RowBatches of the data after the given cursor. Unlike calling
+   * GetNextRowBatch repeatedly, the table locks are only taken once for all the batches. The
+   * returned batches are slices of the batches of the table, in order, and can be empty if there
+   * is no data after the cursor yet (e.g. for an Infinite cursor), or if the cursor skipped all the
+   * rows it had left because of its predicates.
+   * @param cursor the Table::Cursor to get the row batches after.
+   * @param cols a vector of column indices to get data for.
+   * @param max_batches the maximum number of row batches to return.
+   * @return the row batches with the requested data.
+   */
+  StatusOr<std::vector<std::unique_ptr<schema::RowBatch>>> GetNextRowBatches(
+      Cursor* cursor, const std::vector<int64_t>& cols, int64_t max_batches) const;
+
   /**
    * Get the unique identifier of the first row in the table.
    * If all the data is expired from the table, this returns the last row id that was in the table.
@@ -311,6 +357,7 @@ class Table : public NotCopyable {
   int64_t batches_added_ ABSL_GUARDED_BY(stats_lock_) = 0;
   int64_t bytes_added_ ABSL_GUARDED_BY(stats_lock_) = 0;
   int64_t compacted_batches_ ABSL_GUARDED_BY(stats_lock_) = 0;
+  mutable int64_t batches_skipped_ ABSL_GUARDED_BY(stats_lock_) = 0;
   int64_t max_table_size_ = 0;
   const int64_t compacted_batch_size_;
   mutable absl::base_internal::SpinLock hot_lock_;
@@ -321,6 +368,8 @@ class Table : public NotCopyable {
   std::unique_ptr<internal::StoreWithRowTimeAccounting<internal::StoreType::Cold>> cold_store_
       ABSL_GUARDED_BY(cold_lock_);
   std::deque<int64_t> cold_batch_bytes_ ABSL_GUARDED_BY(cold_lock_);
+  // The zone map of each batch in cold_store_, in the same order.
+  std::deque<ZoneMap> cold_zone_maps_ ABSL_GUARDED_BY(cold_lock_);
 
   // Counter to assign a unique row ID to each row. Synchronized by hot_lock_ since its only
   // accessed on a hot write.
@@ -335,6 +384,9 @@ class Table : public NotCopyable {
   Status ExpireRowBatches(int64_t row_batch_size);
   Status CompactSingleBatchUnlocked(arrow::MemoryPool* mem_pool)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(cold_lock_) ABSL_EXCLUSIVE_LOCKS_REQUIRED(hot_lock_);
+  // Advances the cursor past the cold batches that its predicates rule out. Returns the number
+  // of skipped batches.
+  int64_t SkipColdBatchesUnlocked(Cursor* cursor) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(cold_lock_);
   Status UpdateTableMetricGauges();
 
   Time MaxTime() const;
@@ -23,9 +23,13 @@
 #include <deque>
 #include <numeric>
 #include <random>
+#include <string>
 #include <thread>
 
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/column_wrapper.h"
 #include "src/shared/types/types.h"
+#include "src/table_store/table/internal/bit_packing.h"
 #include "src/table_store/table/table.h"
 
 namespace px::table_store {
@@ -82,6 +86,12 @@ static inline int64_t FillTableCold(Table* table, int64_t table_size, int64_t ba
   return time_counter;
 }
 
+// The size of the table's data before cold batches are encoded.
+static inline int64_t UncompressedBytes(Table* table) {
+  auto stats = table->GetTableStats();
+  return stats.hot_bytes + stats.cold_uncompressed_bytes;
+}
+
 static inline void ReadFullTable(Table::Cursor* cursor) {
   while (!cursor->Done()) {
     benchmark::DoNotOptimize(cursor->GetNextRowBatch({0, 1}));
@@ -112,14 +122,42 @@ static void BM_TableReadAllHot(benchmark::State& state) {
   state.SetBytesProcessed(state.iterations() * table_size);
 }
 
+// Reads the whole table with GetNextRowBatches, which takes the table locks once per call
+// instead of once per batch.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_TableReadAllHotBatched(benchmark::State& state) {
+  int64_t table_size = 4 * 1024 * 1024;
+  int64_t compaction_size = 64 * 1024;
+  int64_t batch_length = 256;
+  int64_t max_batches = state.range(0);
+  auto table = MakeTable(table_size, compaction_size);
+  FillTableHot(table.get(), table_size, batch_length);
+
+  Table::Cursor cursor(table.get());
+
+  for (auto _ : state) {
+    while (!cursor.Done()) {
+      benchmark::DoNotOptimize(cursor.GetNextRowBatches({0, 1}, max_batches));
+    }
+    state.PauseTiming();
+    table = MakeTable(table_size, compaction_size);
+    FillTableHot(table.get(), table_size, batch_length);
+    cursor = Table::Cursor(table.get());
+    state.ResumeTiming();
+  }
+
+  state.SetBytesProcessed(state.iterations() * table_size);
+}
+
 // NOLINTNEXTLINE : runtime/references.
 static void BM_TableReadAllCold(benchmark::State& state) {
   int64_t table_size = 4 * 1024 * 1024;
   int64_t compaction_size = 64 * 1024;
   int64_t batch_length = 256;
+  FLAGS_table_store_bit_packing = state.range(0);
   auto table = MakeTable(table_size, compaction_size);
   FillTableCold(table.get(), table_size, batch_length);
-  CHECK_EQ(table->GetTableStats().bytes, table_size);
+  CHECK_EQ(UncompressedBytes(table.get()), table_size);
   Table::Cursor cursor(table.get());
 
   for (auto _ : state) {
@@ -131,6 +169,8 @@ static void BM_TableReadAllCold(benchmark::State& state) {
   }
 
   state.SetBytesProcessed(state.iterations() * table_size);
+  state.counters["cold_bytes"] = table->GetTableStats().cold_bytes;
+  FLAGS_table_store_bit_packing = true;
 }
 
 Table::Cursor GetLastBatchCursor(Table* table, int64_t last_time, int64_t batch_length,
@@ -176,7 +216,7 @@ static void BM_TableReadLastBatchAllCold(benchmark::State& state) {
   int64_t batch_length = 256;
   auto table = MakeTable(table_size, compaction_size);
   auto last_time = FillTableCold(table.get(), table_size, batch_length);
-  CHECK_EQ(table->GetTableStats().bytes, table_size);
+  CHECK_EQ(UncompressedBytes(table.get()), table_size);
 
   auto last_batch_cursor = GetLastBatchCursor(table.get(), last_time, batch_length, {0, 1});
 
@@ -191,6 +231,57 @@ static void BM_TableReadLastBatchAllCold(benchmark::State& state) {
   state.SetBytesProcessed(state.iterations() * batch_size);
 }
 
+template <typename TStringWrapper>
+static inline std::unique_ptr<types::ColumnWrapperRecordBatch> MakeStringBatch(
+    int64_t batch_length, int64_t string_length, int64_t* time_counter) {
+  auto times = std::make_shared<types::Time64NSValueColumnWrapper>(0);
+  auto strings = std::make_shared<TStringWrapper>(0);
+  types::StringValue val(string_length, 'x');
+  for (int64_t i = 0; i < batch_length; ++i) {
+    times->Append((*time_counter)++);
+    strings->Append(val);
+  }
+  auto batch = std::make_unique<types::ColumnWrapperRecordBatch>();
+  batch->push_back(times);
+  batch->push_back(strings);
+  return batch;
+}
+
+// Transfers batches with a string column, like the ones Stirling pushes, and reads them back,
+// which converts them to Arrow.
+template <typename TStringWrapper>
+// NOLINTNEXTLINE : runtime/references.
+static void BM_TableWriteReadStrings(benchmark::State& state) {
+  int64_t batch_length = 256;
+  int64_t string_length = state.range(0);
+  int64_t num_batches = 64;
+  schema::Relation rel(
+      std::vector<types::DataType>({types::DataType::TIME64NS, types::DataType::STRING}),
+      std::vector<std::string>({"time_", "string"}));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    // Large enough that nothing is expired or compacted.
+    Table table("test_table", rel, 1024 * 1024 * 1024, 1024 * 1024 * 1024);
+    int64_t time_counter = 0;
+    std::vector<std::unique_ptr<types::ColumnWrapperRecordBatch>> batches;
+    for (int64_t i = 0; i < num_batches; ++i) {
+      batches.push_back(
+          MakeStringBatch<TStringWrapper>(batch_length, string_length, &time_counter));
+    }
+    state.ResumeTiming();
+
+    for (auto& batch : batches) {
+      PX_CHECK_OK(table.TransferRecordBatch(std::move(batch)));
+    }
+    Table::Cursor cursor(&table);
+    ReadFullTable(&cursor);
+  }
+
+  state.SetBytesProcessed(state.iterations() * num_batches * batch_length *
+                          (string_length + sizeof(int64_t)));
+}
+
 // NOLINTNEXTLINE : runtime/references.
 static void BM_TableWriteEmpty(benchmark::State& state) {
   int64_t table_size = 4 * 1024 * 1024;
@@ -257,6 +348,48 @@ static void BM_TableCompaction(benchmark::State& state) {
                           Table::kMaxBatchesPerCompactionCall);
 }
 
+static inline std::shared_ptr<arrow::Array> MakeTimeColumn(int64_t num_rows) {
+  std::default_random_engine gen(42);
+  std::uniform_int_distribution<int64_t> jitter(0, 1000);
+  std::vector<types::Time64NSValue> times;
+  times.reserve(num_rows);
+  int64_t time = 1634000000000000000;
+  for (int64_t i = 0; i < num_rows; ++i) {
+    time += 10000 + jitter(gen);
+    times.emplace_back(time);
+  }
+  return types::ToArrow(times, arrow::default_memory_pool());
+}
+
+// NOLINTNEXTLINE : runtime/references.
+static void BM_BitPackEncode(benchmark::State& state) {
+  auto arr = MakeTimeColumn(state.range(0));
+  std::unique_ptr<internal::BitPackedColumn> packed;
+
+  for (auto _ : state) {
+    packed = internal::BitPackedColumn::Pack(types::DataType::TIME64NS, arr.get());
+    benchmark::DoNotOptimize(packed);
+  }
+
+  CHECK(packed != nullptr);
+  state.SetBytesProcessed(state.iterations() * packed->PlainBytes());
+  state.counters["bytes_saved"] = packed->PlainBytes() - packed->Bytes();
+}
+
+// NOLINTNEXTLINE : runtime/references.
+static void BM_BitPackDecode(benchmark::State& state) {
+  auto arr = MakeTimeColumn(state.range(0));
+  auto packed = internal::BitPackedColumn::Pack(types::DataType::TIME64NS, arr.get());
+  CHECK(packed != nullptr);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(packed->Unpack(0, arr->length(), arrow::default_memory_pool()));
+  }
+
+  state.SetBytesProcessed(state.iterations() * packed->PlainBytes());
+  state.counters["bytes_saved"] = packed->PlainBytes() - packed->Bytes();
+}
+
 // NOLINTNEXTLINE : runtime/references.
 static void BM_TableThreaded(benchmark::State& state) {
   schema::Relation rel({types::DataType::TIME64NS}, {"time_"});
@@ -361,12 +494,20 @@ static void BM_TableThreaded(benchmark::State& state) {
 }
 
 BENCHMARK(BM_TableReadAllHot);
-BENCHMARK(BM_TableReadAllCold);
+// The argument is the number of batches read per call.
+BENCHMARK(BM_TableReadAllHotBatched)->Arg(1)->Arg(16)->Arg(256);
+// The argument turns bit-packing of cold batches on or off.
+BENCHMARK(BM_TableReadAllCold)->Arg(false)->Arg(true);
 BENCHMARK(BM_TableReadLastBatchAllHot)->Iterations(1000);
 BENCHMARK(BM_TableReadLastBatchAllCold)->Iterations(1000);
 BENCHMARK(BM_TableWriteEmpty);
 BENCHMARK(BM_TableWriteFull);
 BENCHMARK(BM_TableCompaction);
+// The argument is the length of the strings.
+BENCHMARK_TEMPLATE(BM_TableWriteReadStrings, types::StringValueColumnWrapper)->Arg(16)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_TableWriteReadStrings, types::StringArenaColumnWrapper)->Arg(16)->Arg(1024);
+BENCHMARK(BM_BitPackEncode)->RangeMultiplier(16)->Range(256, 64 * 1024);
+BENCHMARK(BM_BitPackDecode)->RangeMultiplier(16)->Range(256, 64 * 1024);
 BENCHMARK(BM_TableThreaded)->UseManualTime()->Iterations(1);
 
 }  // namespace px::table_store
@@ -31,6 +31,12 @@ TableMetrics::TableMetrics(prometheus::Registry* registry, std::string table_nam
                            .Help("Current cold data bytes in the table")
                            .Register(*registry)
                            .Add({{"name", table_name}})),
+      cold_compression_ratio_gauge(
+          prometheus::BuildGauge()
+              .Name("table_cold_compression_ratio")
+              .Help("Ratio of the unencoded size of the cold data to its current size")
+              .Register(*registry)
+              .Add({{"name", table_name}})),
       hot_bytes_gauge(prometheus::BuildGauge()
                           .Name("table_hot_bytes")
                           .Help("Current hot data bytes in the table")
@@ -58,6 +64,12 @@ TableMetrics::TableMetrics(prometheus::Registry* registry, std::string table_nam
               .Help("Total batches compacted in the table in the table's lifetime")
               .Register(*registry)
               .Add({{"name", table_name}})),
+      batches_skipped_counter(
+          prometheus::BuildCounter()
+              .Name("table_batches_skipped")
+              .Help("Total cold batches that scans skipped because of their zone maps")
+              .Register(*registry)
+              .Add({{"name", table_name}})),
       max_table_size_gauge(prometheus::BuildGauge()
                                .Name("table_max_table_size")
                                .Help("The cap on the table size")
@@ -939,6 +939,169 @@ TEST(TableTest, GetNextRowBatch_after_expiry) {
   EXPECT_TRUE(rb1->ColumnAt(1)->Equals(types::ToArrow(col2_in2, arrow::default_memory_pool())));
 }
 
+TEST(TableTest, cursor_skips_cold_batches_with_predicates) {
+  schema::Relation rel({types::DataType::INT64}, {"col1"});
+  int64_t batch_size = 3 * sizeof(int64_t);
+  Table table("test_table", rel, 128 * 1024, batch_size);
+
+  for (const auto& values : std::vector<std::vector<types::Int64Value>>{
+           {1, 2, 3}, {10, 11, 12}, {20, 21, 22}, {30, 31, 32}}) {
+    schema::RowBatch rb(schema::RowDescriptor(rel.col_types()), 3);
+    EXPECT_OK(rb.AddColumn(types::ToArrow(values, arrow::default_memory_pool())));
+    EXPECT_OK(table.WriteRowBatch(rb));
+  }
+  EXPECT_OK(table.CompactHotToCold(arrow::default_memory_pool()));
+  ASSERT_EQ(4, table.GetTableStats().compacted_batches);
+
+  std::vector<ColumnPredicate> predicates{
+      {0, ColumnPredicate::Op::kGreaterThanEqual, int64_t{11}},
+      {0, ColumnPredicate::Op::kLessThan, int64_t{21}},
+  };
+  Table::Cursor cursor(&table, Table::Cursor::StartSpec{}, Table::Cursor::StopSpec{},
+                       predicates);
+
+  std::vector<int64_t> values;
+  while (!cursor.Done()) {
+    auto rb = cursor.GetNextRowBatch({0}).ConsumeValueOrDie();
+    auto it = types::ArrowArrayIterator<types::INT64>(rb->ColumnAt(0).get());
+    values.insert(values.end(), it.begin(), it.end());
+  }
+  // The batches that were read aren't filtered, the others are skipped.
+  EXPECT_EQ(std::vector<int64_t>({10, 11, 12, 20, 21, 22}), values);
+  EXPECT_EQ(2, cursor.batches_skipped());
+  EXPECT_EQ(2, table.GetTableStats().batches_skipped);
+}
+
+TEST(TableTest, GetNextRowBatches) {
+  schema::Relation rel({types::DataType::INT64}, {"col1"});
+  int64_t batch_size = 2 * sizeof(int64_t);
+  Table table("test_table", rel, 128 * 1024, batch_size);
+
+  auto write = [&](std::vector<types::Int64Value> values) {
+    schema::RowBatch rb(schema::RowDescriptor(rel.col_types()), values.size());
+    EXPECT_OK(rb.AddColumn(types::ToArrow(values, arrow::default_memory_pool())));
+    EXPECT_OK(table.WriteRowBatch(rb));
+  };
+  write({1, 2});
+  write({3, 4});
+  EXPECT_OK(table.CompactHotToCold(arrow::default_memory_pool()));
+  write({5, 6});
+  write({7, 8});
+
+  auto batch_values = [](const std::vector<std::unique_ptr<schema::RowBatch>>& batches) {
+    std::vector<std::vector<int64_t>> values;
+    for (const auto& rb : batches) {
+      auto it = types::ArrowArrayIterator<types::INT64>(rb->ColumnAt(0).get());
+      values.emplace_back(it.begin(), it.end());
+    }
+    return values;
+  };
+
+  // The batches continue from the cold store into the hot store.
+  Table::Cursor cursor(&table);
+  auto batches = cursor.GetNextRowBatches({0}, 3).ConsumeValueOrDie();
+  EXPECT_EQ(std::vector<std::vector<int64_t>>({{1, 2}, {3, 4}, {5, 6}}), batch_values(batches));
+  EXPECT_FALSE(cursor.Done());
+  batches = cursor.GetNextRowBatches({0}, 3).ConsumeValueOrDie();
+  EXPECT_EQ(std::vector<std::vector<int64_t>>({{7, 8}}), batch_values(batches));
+  EXPECT_TRUE(cursor.Done());
+  EXPECT_TRUE(cursor.GetNextRowBatches({0}, 3).ConsumeValueOrDie().empty());
+
+  // An infinite cursor that caught up with the table returns no batches until more are written.
+  Table::Cursor::StopSpec infinite;
+  infinite.type = Table::Cursor::StopSpec::StopType::Infinite;
+  Table::Cursor infinite_cursor(&table, Table::Cursor::StartSpec{}, infinite);
+  EXPECT_EQ(4, infinite_cursor.GetNextRowBatches({0}, 10).ConsumeValueOrDie().size());
+  EXPECT_TRUE(infinite_cursor.GetNextRowBatches({0}, 10).ConsumeValueOrDie().empty());
+  write({9});
+  batches = infinite_cursor.GetNextRowBatches({0}, 10).ConsumeValueOrDie();
+  EXPECT_EQ(std::vector<std::vector<int64_t>>({{9}}), batch_values(batches));
+}
+
+TEST(TableTest, dictionary_encoded_cold_batches) {
+  schema::Relation rel({types::DataType::INT64, types::DataType::STRING}, {"col1", "req_path"});
+  std::vector<types::Int64Value> col1 = {1, 2, 3, 4, 5, 6, 7, 8};
+  std::vector<types::StringValue> paths = {"/api/v1/users", "/api/v1/users", "/healthz",
+                                           "/api/v1/users", "/api/v1/users", "/healthz",
+                                           "/api/v1/users", "/api/v1/users"};
+  // 8 int64s, 8 string offsets and 6 * 13 + 2 * 8 bytes of strings.
+  int64_t plain_bytes = 8 * sizeof(int64_t) + 8 * sizeof(uint32_t) + 94;
+  // The dictionary only holds "/api/v1/users" and "/healthz", plus an index per row.
+  int64_t encoded_bytes = 8 * sizeof(int64_t) + 8 * sizeof(int32_t) + 21 + 2 * sizeof(uint32_t);
+  Table table("test_table", rel, 128 * 1024, plain_bytes);
+
+  schema::RowBatch rb(schema::RowDescriptor(rel.col_types()), 8);
+  EXPECT_OK(rb.AddColumn(types::ToArrow(col1, arrow::default_memory_pool())));
+  EXPECT_OK(rb.AddColumn(types::ToArrow(paths, arrow::default_memory_pool())));
+  EXPECT_OK(table.WriteRowBatch(rb));
+  EXPECT_OK(table.CompactHotToCold(arrow::default_memory_pool()));
+
+  auto stats = table.GetTableStats();
+  ASSERT_EQ(1, stats.compacted_batches);
+  EXPECT_EQ(encoded_bytes, stats.cold_bytes);
+  EXPECT_EQ(plain_bytes, stats.cold_uncompressed_bytes);
+  EXPECT_DOUBLE_EQ(static_cast<double>(plain_bytes) / encoded_bytes, stats.cold_compression_ratio);
+
+  // Readers get plain string columns back.
+  Table::Cursor cursor(&table);
+  auto out_rb = cursor.GetNextRowBatch({0, 1}).ConsumeValueOrDie();
+  ASSERT_EQ(arrow::Type::STRING, out_rb->ColumnAt(1)->type_id());
+  EXPECT_TRUE(out_rb->ColumnAt(1)->Equals(types::ToArrow(paths, arrow::default_memory_pool())));
+
+  // The zone map of an encoded column is still usable.
+  Table::Cursor skip_cursor(&table, Table::Cursor::StartSpec{}, Table::Cursor::StopSpec{},
+                            {{1, ColumnPredicate::Op::kEqual, std::string("/metrics")}});
+  while (!skip_cursor.Done()) {
+    auto skipped_rb = skip_cursor.GetNextRowBatch({0, 1}).ConsumeValueOrDie();
+    EXPECT_EQ(0, skipped_rb->num_rows());
+  }
+  EXPECT_EQ(1, skip_cursor.batches_skipped());
+}
+
+TEST(TableTest, bit_packed_cold_batches) {
+  schema::Relation rel({types::DataType::TIME64NS, types::DataType::INT64}, {"time_", "count"});
+  constexpr int64_t kNumRows = 1000;
+  std::vector<types::Time64NSValue> times;
+  std::vector<types::Int64Value> counts;
+  for (int64_t i = 0; i < kNumRows; ++i) {
+    times.emplace_back(1000000 + i * 1000);
+    counts.emplace_back(i % 10);
+  }
+  int64_t plain_bytes = 2 * kNumRows * sizeof(int64_t);
+  Table table("test_table", rel, 128 * 1024, plain_bytes);
+
+  schema::RowBatch rb(schema::RowDescriptor(rel.col_types()), kNumRows);
+  EXPECT_OK(rb.AddColumn(types::ToArrow(times, arrow::default_memory_pool())));
+  EXPECT_OK(rb.AddColumn(types::ToArrow(counts, arrow::default_memory_pool())));
+  EXPECT_OK(table.WriteRowBatch(rb));
+  EXPECT_OK(table.CompactHotToCold(arrow::default_memory_pool()));
+
+  auto stats = table.GetTableStats();
+  ASSERT_EQ(1, stats.compacted_batches);
+  EXPECT_EQ(plain_bytes, stats.cold_uncompressed_bytes);
+  EXPECT_LT(stats.cold_bytes, plain_bytes / 4);
+
+  // Time based cursors search the packed time column.
+  Table::Cursor cursor(
+      &table, Table::Cursor::StartSpec{Table::Cursor::StartSpec::StartAtTime, 1000000 + 199500},
+      Table::Cursor::StopSpec{Table::Cursor::StopSpec::StopAtTimeOrEndOfTable, 1000000 + 500000});
+  auto out_rb = cursor.GetNextRowBatch({0, 1}).ConsumeValueOrDie();
+  EXPECT_TRUE(cursor.Done());
+  ASSERT_EQ(arrow::Type::TIME64, out_rb->ColumnAt(0)->type_id());
+  EXPECT_TRUE(out_rb->ColumnAt(0)->Equals(
+      types::ToArrow(times, arrow::default_memory_pool())->Slice(200, 301)));
+  EXPECT_TRUE(out_rb->ColumnAt(1)->Equals(
+      types::ToArrow(counts, arrow::default_memory_pool())->Slice(200, 301)));
+
+  // GetNextRowBatches unpacks the columns after it releases the table's locks.
+  Table::Cursor batches_cursor(&table);
+  auto batches = batches_cursor.GetNextRowBatches({1, 0}, 4).ConsumeValueOrDie();
+  ASSERT_EQ(1, batches.size());
+  EXPECT_TRUE(batches[0]->ColumnAt(0)->Equals(
+      types::ToArrow(counts, arrow::default_memory_pool())));
+  EXPECT_TRUE(batches[0]->ColumnAt(1)->Equals(types::ToArrow(times, arrow::default_memory_pool())));
+}
+
 struct CursorTestCase {
   std::string name;
   std::vector<std::vector<int64_t>> initial_time_batches;
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/table_store/table/zone_map.h"
+
+#include <cmath>
+#include <string_view>
+#include <type_traits>
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/substitute.h>
+
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/type_utils.h"
+#include "src/table_store/table/internal/dictionary_encoding.h"
+
+namespace px {
+namespace table_store {
+
+namespace {
+
+template <types::DataType DT>
+ColumnZoneMap ComputeColumnZoneMap(const arrow::Array* arr) {
+  using NativeType = typename types::DataTypeTraits<DT>::native_type;
+  ColumnZoneMap zone_map;
+  zone_map.null_count = arr->null_count();
+  bool has_nulls = zone_map.null_count > 0;
+
+  if constexpr (DT == types::DataType::STRING) {
+    // The dictionary of an encoded column only holds the values that appear in the column, so its
+    // range is the range of the column.
+    if (internal::IsDictionaryEncoded(arr)) {
+      arr = static_cast<const arrow::DictionaryArray*>(arr)->dictionary().get();
+      has_nulls = false;
+    }
+    std::optional<std::string_view> min;
+    std::optional<std::string_view> max;
+    for (int64_t i = 0; i < arr->length(); ++i) {
+      if (has_nulls && arr->IsNull(i)) {
+        continue;
+      }
+      auto val = types::GetStringViewFromArrowArray(arr, i);
+      if (val.size() > ColumnZoneMap::kMaxStringBytes) {
+        return zone_map;
+      }
+      if (!min.has_value() || val < *min) {
+        min = val;
+      }
+      if (!max.has_value() || val > *max) {
+        max = val;
+      }
+    }
+    if (min.has_value()) {
+      zone_map.min = std::string(*min);
+      zone_map.max = std::string(*max);
+    }
+  } else {
+    std::optional<NativeType> min;
+    std::optional<NativeType> max;
+    for (int64_t i = 0; i < arr->length(); ++i) {
+      if (has_nulls && arr->IsNull(i)) {
+        continue;
+      }
+      NativeType val = types::GetValueFromArrowArray<DT>(arr, i);
+      if constexpr (std::is_floating_point_v<NativeType>) {
+        // NaNs don't compare, so don't keep a range for columns that have them.
+        if (std::isnan(val)) {
+          return zone_map;
+        }
+      }
+      if (!min.has_value() || val < *min) {
+        min = val;
+      }
+      if (!max.has_value() || val > *max) {
+        max = val;
+      }
+    }
+    if (min.has_value()) {
+      zone_map.min = *min;
+      zone_map.max = *max;
+    }
+  }
+  return zone_map;
+}
+
+template <typename T>
+bool RangeMayMatch(const T& min, const T& max, ColumnPredicate::Op op, const T& value) {
+  switch (op) {
+    case ColumnPredicate::Op::kEqual:
+      return !(value < min) && !(max < value);
+    case ColumnPredicate::Op::kNotEqual:
+      return !(min == value && max == value);
+    case ColumnPredicate::Op::kLessThan:
+      return min < value;
+    case ColumnPredicate::Op::kLessThanEqual:
+      return !(value < min);
+    case ColumnPredicate::Op::kGreaterThan:
+      return value < max;
+    case ColumnPredicate::Op::kGreaterThanEqual:
+      return !(max < value);
+  }
+  return true;
+}
+
+std::string OpToString(ColumnPredicate::Op op) {
+  switch (op) {
+    case ColumnPredicate::Op::kEqual:
+      return "==";
+    case ColumnPredicate::Op::kNotEqual:
+      return "!=";
+    case ColumnPredicate::Op::kLessThan:
+      return "<";
+    case ColumnPredicate::Op::kLessThanEqual:
+      return "<=";
+    case ColumnPredicate::Op::kGreaterThan:
+      return ">";
+    case ColumnPredicate::Op::kGreaterThanEqual:
+      return ">=";
+  }
+  return "?";
+}
+
+}  // namespace
+
+std::string ColumnPredicate::DebugString() const {
+  auto value_str = std::visit(
+      [](const auto& val) -> std::string {
+        using T = std::decay_t<decltype(val)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+          return absl::Substitute("\"$0\"", val);
+        } else if constexpr (std::is_same_v<T, absl::uint128>) {
+          return absl::Substitute("$0:$1", absl::Uint128High64(val), absl::Uint128Low64(val));
+        } else {
+          return absl::StrCat(val);
+        }
+      },
+      value);
+  return absl::Substitute("col[$0] $1 $2", col_idx, OpToString(op), value_str);
+}
+
+bool ColumnZoneMap::MayMatch(ColumnPredicate::Op op, const ZoneMapValue& value) const {
+  // Without a range, or if the predicate has the wrong type, nothing can be ruled out.
+  if (!min.has_value() || min->index() != value.index()) {
+    return true;
+  }
+  return std::visit(
+      [&](const auto& val) {
+        using T = std::decay_t<decltype(val)>;
+        return RangeMayMatch(std::get<T>(*min), std::get<T>(*max), op, val);
+      },
+      value);
+}
+
+ZoneMap ZoneMap::Compute(const schema::Relation& rel,
+                         const std::vector<std::shared_ptr<arrow::Array>>& columns) {
+  DCHECK_EQ(rel.NumColumns(), columns.size());
+  ZoneMap zone_map;
+  zone_map.columns_.reserve(columns.size());
+  for (size_t i = 0; i < columns.size(); ++i) {
+#define TYPE_CASE(_dt_) \
+  zone_map.columns_.push_back(ComputeColumnZoneMap<_dt_>(columns[i].get()));
+    PX_SWITCH_FOREACH_DATATYPE(rel.GetColumnType(i), TYPE_CASE);
+#undef TYPE_CASE
+  }
+  return zone_map;
+}
+
+bool ZoneMap::MayMatch(const std::vector<ColumnPredicate>& predicates) const {
+  for (const auto& predicate : predicates) {
+    if (predicate.col_idx < 0 || predicate.col_idx >= static_cast<int64_t>(columns_.size())) {
+      continue;
+    }
+    if (!columns_[predicate.col_idx].MayMatch(predicate.op, predicate.value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t ZoneMap::Bytes() const {
+  int64_t bytes = columns_.capacity() * sizeof(ColumnZoneMap);
+  for (const auto& col : columns_) {
+    if (col.min.has_value() && std::holds_alternative<std::string>(*col.min)) {
+      bytes += std::get<std::string>(*col.min).capacity();
+      bytes += std::get<std::string>(*col.max).capacity();
+    }
+  }
+  return bytes;
+}
+
+}  // namespace table_store
+}  // namespace px
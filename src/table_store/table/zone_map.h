@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <absl/numeric/int128.h>
+#include <arrow/array.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "src/common/base/base.h"
+#include "src/shared/types/types.h"
+#include "src/table_store/schema/relation.h"
+
+namespace px {
+namespace table_store {
+
+// Holds a value of the native type of a column. INT64 and TIME64NS columns both use int64_t.
+using ZoneMapValue = std::variant<bool, int64_t, double, absl::uint128, std::string>;
+
+/**
+ * ColumnPredicate is a comparison between a table column and a constant. Scans use a set of
+ * predicates, which must all hold for a row to be needed, to skip the batches that can't contain
+ * any such row. The rows of the batches that are read are not filtered.
+ */
+struct ColumnPredicate {
+  enum class Op {
+    kEqual,
+    kNotEqual,
+    kLessThan,
+    kLessThanEqual,
+    kGreaterThan,
+    kGreaterThanEqual,
+  };
+
+  // Index of the column in the table relation.
+  int64_t col_idx;
+  Op op;
+  ZoneMapValue value;
+
+  std::string DebugString() const;
+};
+
+/**
+ * ColumnZoneMap holds the min, max and null count of a column in a single batch.
+ */
+struct ColumnZoneMap {
+  // Unset if the column has no non null values, if it has a NaN, or if it is a string column with
+  // a value longer than kMaxStringBytes.
+  std::optional<ZoneMapValue> min;
+  std::optional<ZoneMapValue> max;
+  int64_t null_count = 0;
+
+  static constexpr size_t kMaxStringBytes = 128;
+
+  // Returns false only if no value in the column can satisfy the comparison.
+  bool MayMatch(ColumnPredicate::Op op, const ZoneMapValue& value) const;
+};
+
+/**
+ * ZoneMap holds the ColumnZoneMap of every column of a cold batch.
+ */
+class ZoneMap {
+ public:
+  static ZoneMap Compute(const schema::Relation& rel,
+                         const std::vector<std::shared_ptr<arrow::Array>>& columns);
+
+  /**
+   * Returns false if the batch is guaranteed to have no row for which all the predicates hold.
+   */
+  bool MayMatch(const std::vector<ColumnPredicate>& predicates) const;
+
+  const ColumnZoneMap& column(size_t col_idx) const { return columns_[col_idx]; }
+  int64_t Bytes() const;
+
+ private:
+  std::vector<ColumnZoneMap> columns_;
+};
+
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/table_store/table/zone_map.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+
+namespace px {
+namespace table_store {
+
+using Op = ColumnPredicate::Op;
+
+TEST(ZoneMapTest, int_column) {
+  schema::Relation rel({types::DataType::INT64}, {"col1"});
+  std::vector<types::Int64Value> col = {5, -3, 12, 7};
+  auto zone_map = ZoneMap::Compute(rel, {types::ToArrow(col, arrow::default_memory_pool())});
+
+  EXPECT_EQ(ZoneMapValue(int64_t{-3}), zone_map.column(0).min.value());
+  EXPECT_EQ(ZoneMapValue(int64_t{12}), zone_map.column(0).max.value());
+  EXPECT_EQ(0, zone_map.column(0).null_count);
+
+  EXPECT_TRUE(zone_map.MayMatch({{0, Op::kEqual, int64_t{7}}}));
+  EXPECT_TRUE(zone_map.MayMatch({{0, Op::kEqual, int64_t{6}}}));
+  EXPECT_FALSE(zone_map.MayMatch({{0, Op::kEqual, int64_t{13}}}));
+  EXPECT_FALSE(zone_map.MayMatch({{0, Op::kLessThan, int64_t{-3}}}));
+  EXPECT_TRUE(zone_map.MayMatch({{0, Op::kLessThanEqual, int64_t{-3}}}));
+  EXPECT_FALSE(zone_map.MayMatch({{0, Op::kGreaterThan, int64_t{12}}}));
+  EXPECT_TRUE(zone_map.MayMatch({{0, Op::kGreaterThanEqual, int64_t{12}}}));
+  EXPECT_TRUE(zone_map.MayMatch({{0, Op::kNotEqual, int64_t{12}}}));
+  // Every predicate has to be satisfiable.
+  EXPECT_FALSE(
+      zone_map.MayMatch({{0, Op::kGreaterThan, int64_t{0}}, {0, Op::kEqual, int64_t{100}}}));
+  // Predicates with a mismatched type can't rule anything out.
+  EXPECT_TRUE(zone_map.MayMatch({{0, Op::kEqual, 100.0}}));
+}
+
+TEST(ZoneMapTest, constant_column_not_equal) {
+  schema::Relation rel({types::DataType::STRING}, {"col1"});
+  std::vector<types::StringValue> col = {"abc", "abc"};
+  auto zone_map = ZoneMap::Compute(rel, {types::ToArrow(col, arrow::default_memory_pool())});
+
+  EXPECT_FALSE(zone_map.MayMatch({{0, Op::kNotEqual, std::string("abc")}}));
+  EXPECT_TRUE(zone_map.MayMatch({{0, Op::kNotEqual, std::string("abd")}}));
+  EXPECT_FALSE(zone_map.MayMatch({{0, Op::kGreaterThan, std::string("abc")}}));
+}
+
+TEST(ZoneMapTest, no_range_for_long_strings_and_nans) {
+  schema::Relation rel({types::DataType::STRING, types::DataType::FLOAT64}, {"col1", "col2"});
+  std::vector<types::StringValue> strs = {"a",
+                                          std::string(ColumnZoneMap::kMaxStringBytes + 1, 'z')};
+  std::vector<types::Float64Value> floats = {1.0, std::numeric_limits<double>::quiet_NaN()};
+  auto zone_map = ZoneMap::Compute(rel, {types::ToArrow(strs, arrow::default_memory_pool()),
+                                         types::ToArrow(floats, arrow::default_memory_pool())});
+
+  EXPECT_FALSE(zone_map.column(0).min.has_value());
+  EXPECT_FALSE(zone_map.column(1).min.has_value());
+  EXPECT_TRUE(zone_map.MayMatch({{0, Op::kEqual, std::string("b")}}));
+  EXPECT_TRUE(zone_map.MayMatch({{1, Op::kGreaterThan, 10.0}}));
+}
+
+}  // namespace table_store
+}  // namespace px